@@ -1558,6 +1558,22 @@ TAUL_APP_ERR_TYPE initTaulApp (
 	/* Set Ladder Config */
 	ladderConfig.ownIpAddr = ownIpAddress;
 
+	/* Isolate the communication thread from the application load */
+	ladderConfig.pdMainThreadAttr.cpuMask = TAUL_APP_COM_CPU_MASK;
+	if (TAUL_APP_COM_PRIORITY != 0)
+	{
+		ladderConfig.pdMainThreadAttr.policy = VOS_THREAD_POLICY_FIFO;
+		ladderConfig.pdMainThreadAttr.priority = TAUL_APP_COM_PRIORITY;
+	}
+	ladderConfig.pdMainThreadAttr.prefaultStack = TAUL_APP_COM_PREFAULT_STACK;
+	if (TAUL_APP_LOCK_MEMORY != 0)
+	{
+		if (vos_memLockAll() != VOS_NO_ERR)
+		{
+			printf("initTaulApp(): memory could not be locked\n");
+		}
+	}
+
 	/* Initialize TAUL */
 	err = tau_ldInit(dbgOut, &ladderConfig);
 	if (err != TRDP_NO_ERR)
@@ -77,6 +77,19 @@ extern "C" {
 #define DEFAULT_PD_SEND_CYCLE_NUMBER				0				/* Publish Send Cycle Number */
 #define DEFAULT_PD_RECEIVE_CYCLE_NUMBER			0				/* Subscribe Receive Cycle Number */
 #define DEFAULT_WRITE_TRAFFIC_STORE_SUBNET		0				/* Traffic Store Using Subnet */
+/* Real-time settings of the TAUL communication thread (TAULpdMainThread) */
+#ifndef TAUL_APP_COM_CPU_MASK
+#define TAUL_APP_COM_CPU_MASK					0				/* CPUs to pin the communication thread to, 0: no pinning */
+#endif
+#ifndef TAUL_APP_COM_PRIORITY
+#define TAUL_APP_COM_PRIORITY					0				/* SCHED_FIFO priority of the communication thread, 0: default policy */
+#endif
+#ifndef TAUL_APP_COM_PREFAULT_STACK
+#define TAUL_APP_COM_PREFAULT_STACK				0				/* Stack bytes to prefault in the communication thread */
+#endif
+#ifndef TAUL_APP_LOCK_MEMORY
+#define TAUL_APP_LOCK_MEMORY					0				/* 1: lock all pages into RAM (mlockall) */
+#endif
 /* Default MD Application Parameter */
 /* for MD Notify/Request Destination Parameter */
 /* Point to Multi point */
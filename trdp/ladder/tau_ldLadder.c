@@ -44,6 +44,7 @@
 #include "tau_ladder.h"
 #include "tau_ldLadder.h"
 #include "tau_ldLadder_config.h"
+#include "tau_cfg_index.h"
 
 static void forceSocketClose (TRDP_APP_SESSION_T);
 /*******************************************************************************
@@ -87,6 +88,7 @@ TRDP_URI_HOST_T         nothingUriHost = {""};          /* Nothing URI Host (IP
 TRDP_URI_HOST_T         IP_ADDRESS_ZERO = {"0.0.0.0"};  /* IP Address 0.0.0.0 */
 const TRDP_DEST_T       defaultDestination = {0};       /* Destination Parameter (id, SDT, URI) */
 static INT32 ts_buffer[2048/sizeof(INT32)];
+static TAU_CFG_INDEX_T  configIndex = NULL;             /* Hashed access to the configuration */
 
 /**********************************************************************************************************************/
 /** TAUL Local Function */
@@ -1056,6 +1058,41 @@ TRDP_ERR_T setConfigParameterFromInternalConfig (
 }
 #endif /* #ifndef XML_CONFIG_ENABLE */
 
+/******************************************************************************/
+/** Index the configuration (datasets and telegrams of all interfaces),
+ *  so the telegram set-up does not search the configuration arrays.
+ *
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_MEM_ERR
+ */
+TRDP_ERR_T indexConfiguration (
+        void)
+{
+    TRDP_XML_CONFIG_T       config;
+    TRDP_XML_IF_SETTINGS_T  ifSettings[LADDER_IF_NUMBER];
+    UINT32                  ifIndex = 0;
+
+    memset(&config, 0, sizeof(config));
+    memset(ifSettings, 0, sizeof(ifSettings));
+    /* Only the arrays are referenced by the index, the structures may be local */
+    config.numIfConfig = (numIfConfig < LADDER_IF_NUMBER) ? numIfConfig : LADDER_IF_NUMBER;
+    config.pIfConfig = pIfConfig;
+    config.pIfSettings = ifSettings;
+    for (ifIndex = 0; ifIndex < config.numIfConfig; ifIndex++)
+    {
+        ifSettings[ifIndex].numExchgPar = numExchgPar;
+        ifSettings[ifIndex].pExchgPar = arrayExchgPar[ifIndex];
+    }
+    config.numComId = numComId;
+    config.pComIdDsIdMap = pComIdDsIdMap;
+    config.numDataset = numDataset;
+    config.apDataset = apDataset;
+
+    tau_freeConfigIndex(configIndex);
+    configIndex = NULL;
+    return tau_initConfigIndex(&config, &configIndex);
+}
+
 /******************************************************************************/
 /** PD/MD Telegrams configured for one interface.
  * PD: Publisher, Subscriber, Requester
@@ -1237,7 +1274,6 @@ TRDP_ERR_T publishTelegram (
         UINT32              ifIndex,
         TRDP_EXCHG_PAR_T    *pExchgPar)
 {
-    UINT32                  i = 0;
     TRDP_IP_ADDR_T      networkByteIpAddr = 0;              /* for convert URI to IP Address */
     PUBLISH_TELEGRAM_T  *pPublishTelegram = NULL;
     UINT32                  *pPublishDataset = NULL;
@@ -1257,16 +1293,7 @@ TRDP_ERR_T publishTelegram (
     }
 
     /* Find ExchgPar Dataset for the dataset config */
-    for (i = 0; i < numDataset; i++)
-    {
-        /* DatasetId in dataSet config ? */
-        if (pExchgPar->datasetId == apDataset[i]->id)
-        {
-            /* Set Dataset Descriptor */
-            pPublishTelegram->pDatasetDescriptor = apDataset[i];
-            break;
-        }
-    }
+    pPublishTelegram->pDatasetDescriptor = tau_findDataset(configIndex, pExchgPar->datasetId);
     /* DataSetId effective ? */
     if (pPublishTelegram->pDatasetDescriptor == 0)
     {
@@ -1494,7 +1521,6 @@ TRDP_ERR_T subscribeTelegram (
         TRDP_EXCHG_PAR_T    *pExchgPar)
 {
     UINT32                      i = 0;
-    UINT32                      datasetIndex = 0;
     TRDP_IP_ADDR_T          networkByteIpAddr = 0;              /* for convert URI to IP Address */
     SUBSCRIBE_TELEGRAM_T        *pSubscribeTelegram = NULL;
     UINT32                      *pSubscribeDataset = NULL;
@@ -1528,16 +1554,7 @@ TRDP_ERR_T subscribeTelegram (
             if (i == 0)
             {
                 /* Find ExchgPar Dataset for the dataset config */
-                for (datasetIndex = 0; datasetIndex < numDataset; datasetIndex++)
-                {
-                    /* DatasetId in dataSet config ? */
-                    if (pExchgPar->datasetId == apDataset[datasetIndex]->id)
-                    {
-                        /* Set Dataset Descriptor */
-                        pSubscribeTelegram->pDatasetDescriptor = apDataset[datasetIndex];
-                        break;
-                    }
-                }
+                pSubscribeTelegram->pDatasetDescriptor = tau_findDataset(configIndex, pExchgPar->datasetId);
                 /* DataSetId effective ? */
                 if (pSubscribeTelegram->pDatasetDescriptor == 0)
                 {
@@ -1800,7 +1817,6 @@ TRDP_ERR_T pdRequestTelegram (
         UINT32              ifIndex,
         TRDP_EXCHG_PAR_T    *pExchgPar)
 {
-    UINT32                      i = 0;
     TRDP_IP_ADDR_T          networkByteIpAddr = 0;              /* for convert URI to IP Address */
     PD_REQUEST_TELEGRAM_T   *pPdRequestTelegram = NULL;
     UINT32                      *pPdRequestDataset = NULL;
@@ -1829,16 +1845,7 @@ TRDP_ERR_T pdRequestTelegram (
         }
 
         /* Find ExchgPar Dataset for the dataset config */
-        for (i = 0; i < numDataset; i++)
-        {
-            /* DatasetId in dataSet config ? */
-            if (pExchgPar->datasetId == apDataset[i]->id)
-            {
-                /* Set Dataset Descriptor */
-                pPdRequestTelegram->pDatasetDescriptor = apDataset[i];
-                break;
-            }
-        }
+        pPdRequestTelegram->pDatasetDescriptor = tau_findDataset(configIndex, pExchgPar->datasetId);
         /* DataSetId effective ? */
         if (pPdRequestTelegram->pDatasetDescriptor == 0)
         {
@@ -2189,6 +2196,17 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
     TRDP_TIME_T             tv_interval = {0};                              /* interval Time :timeval type */
     TRDP_TIME_T             trdp_time_tv_interval = {0};                    /* interval Time :TRDP_TIME_T type for TRDP function */
 
+    /* Pin the communication thread / set real-time scheduling if configured */
+    if ((taulConfig.pdMainThreadAttr.cpuMask != 0)
+        || (taulConfig.pdMainThreadAttr.policy != VOS_THREAD_POLICY_OTHER)
+        || (taulConfig.pdMainThreadAttr.prefaultStack != 0))
+    {
+        if (vos_threadSetAttr(&taulConfig.pdMainThreadAttr) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_WARNING, "TAULpdMainThread: real-time attributes not applied\n");
+        }
+    }
+
     /* Check appHandle */
     while (1)
     {
@@ -2301,7 +2319,7 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
             if (iterPD->pFrame->frameHead.msgType == msgTypePrNetworkByteOder)
             {
                 /* Is Now Time send Timing ? */
-                if (vos_cmpTime((TRDP_TIME_T *)&iterPD->timeToGo, (TRDP_TIME_T *)&nowTime) < 0)
+                if (iterPD->timeToGo < VOS_TIME_TO_NS(&nowTime))
                 {
                     /* PD Pull (request) ? */
                     if (iterPD->addr.comId != TRDP_GLOBAL_STATISTICS_COMID)
@@ -2379,7 +2397,7 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
             else
             {
                 /* Is Now Time send Timing ? */
-                if (vos_cmpTime((TRDP_TIME_T *)&iterPD->timeToGo, (TRDP_TIME_T *)&nowTime) < 0)
+                if (iterPD->timeToGo < VOS_TIME_TO_NS(&nowTime))
                 {
                     /* Check comId which Publish our statistics packet */
                     if (iterPD->addr.comId != TRDP_GLOBAL_STATISTICS_COMID)
@@ -2493,7 +2511,7 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
                 else
                 {
                     /* Is Now Time send Timing ? */
-                    if (vos_cmpTime((TRDP_TIME_T *)&iterPD->timeToGo, (TRDP_TIME_T *)&nowTime) < 0)
+                    if (iterPD->timeToGo < VOS_TIME_TO_NS(&nowTime))
                     {
                         /* Check comId which Publish our statistics packet */
                         if (iterPD->addr.comId != TRDP_GLOBAL_STATISTICS_COMID)
@@ -2809,6 +2827,13 @@ TRDP_ERR_T tau_ldInit (
         vos_printLog(VOS_LOG_ERROR, "tau_ldInit() failed. TRDP Ladder Support Initialize failed\n");
         return err;
     }
+    /* Index Configuration */
+    err = indexConfiguration();
+    if (err != TRDP_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "tau_ldInit() failed. indexConfiguration() error = %d\n", err);
+        return err;
+    }
     /* Get Telegram Loop */
     for (ifIndex = 0; ifIndex < numIfConfig; ifIndex++)
     {
@@ -2966,6 +2991,9 @@ TRDP_ERR_T tau_ldTerminate (
         pIfConfig = NULL;
         numIfConfig = 0;
     }
+    /* Free Configuration Index */
+    tau_freeConfigIndex(configIndex);
+    configIndex = NULL;
     /* Free ComId-DatasetId Map */
     if (pComIdDsIdMap)
     {
@@ -112,6 +112,7 @@ typedef enum
 typedef struct
 {
 	TRDP_IP_ADDR_T	ownIpAddr;				/**< own IP Address  										*/
+	VOS_THREAD_ATTR_T	pdMainThreadAttr;	/**< real-time attributes of TAULpdMainThread (all zero: none)	*/
 } TAU_LD_CONFIG_T;
 
 typedef struct
@@ -321,6 +322,16 @@ extern VOS_THREAD_T 					taulPdMainThreadHandle;						/* TAUL Main Thread handle
 /** Local Function
  */
 /******************************************************************************/
+/** Index the configuration (datasets and telegrams of all interfaces),
+ *  so the telegram set-up does not search the configuration arrays.
+ *
+ *	@retval			TRDP_NO_ERR
+ *	@retval			TRDP_MEM_ERR
+ */
+TRDP_ERR_T indexConfiguration (
+		void);
+
+/******************************************************************************/
 /** PD/MD Telegrams configured for one interface.
  * PD: Publisher, Subscriber, Requester
  * MD: Caller, Replier
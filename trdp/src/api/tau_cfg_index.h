@@ -0,0 +1,187 @@
+/**********************************************************************************************************************/
+/**
+ * @file            tau_cfg_index.h
+ *
+ * @brief           Indexed access to a parsed configuration
+ *
+ * @details         This module provides the interface to the following utilities
+ *                  - hashed lookup of telegrams (exchange parameters), destinations and sources
+ *                    by interface name and comId
+ *                  - hashed lookup of datasets by datasetId and by comId
+ *
+ *                  The index is built once after the configuration was read, in time linear to its size.
+ *                  It refers to the configuration and does not copy it.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef TAU_CFG_INDEX_H
+#define TAU_CFG_INDEX_H
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include "tau_xml_cache.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Handle of a configuration index */
+typedef struct TAU_CFG_INDEX *TAU_CFG_INDEX_T;
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+
+/**********************************************************************************************************************/
+/**    Build the index of a configuration.
+ *
+ *  Interfaces, telegrams, the ComId DatasetId mapping and the datasets of the configuration are hashed.
+ *  Only the arrays the configuration points to are referenced, they must stay valid as long as the index is used;
+ *  the TRDP_XML_CONFIG_T structure itself may be temporary. pIfSettings may be NULL (datasets only).
+ *
+ *  @param[in]      pConfig           Configuration, e.g. from tau_readXmlConfig or tau_loadConfig
+ *  @param[out]     pIndex            Index, to be released by tau_freeConfigIndex
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    parameter error
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_initConfigIndex (
+    const TRDP_XML_CONFIG_T *pConfig,
+    TAU_CFG_INDEX_T         *pIndex);
+
+/**********************************************************************************************************************/
+/**    Release an index built by tau_initConfigIndex
+ *
+ *  @param[in]      index             Index, NULL: nothing to do
+ *
+ */
+EXT_DECL void tau_freeConfigIndex (
+    TAU_CFG_INDEX_T index);
+
+/**********************************************************************************************************************/
+/**    Find an interface by its name.
+ *
+ *  @param[in]      index             Index
+ *  @param[in]      pIfName           Interface name
+ *  @param[out]     pIfIndex          Position of the interface in pIfConfig
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    interface not configured
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_findInterface (
+    TAU_CFG_INDEX_T index,
+    const CHAR8     *pIfName,
+    UINT32          *pIfIndex);
+
+/**********************************************************************************************************************/
+/**    Find the exchange parameters of a telegram.
+ *
+ *  A comId may be configured more than once on an interface, the telegrams are returned in the order of the
+ *  configuration: pass NULL to get the first one and the previous result to get the next one.
+ *
+ *  @param[in]      index             Index
+ *  @param[in]      pIfName           Interface name
+ *  @param[in]      comId             ComId of the telegram
+ *  @param[in]      pPrev             Previous result or NULL
+ *
+ *  @retval         pointer to the exchange parameters, NULL if there are no (more)
+ *
+ */
+EXT_DECL TRDP_EXCHG_PAR_T *tau_findExchgPar (
+    TAU_CFG_INDEX_T         index,
+    const CHAR8             *pIfName,
+    UINT32                  comId,
+    const TRDP_EXCHG_PAR_T  *pPrev);
+
+/**********************************************************************************************************************/
+/**    Find the destinations of a telegram (of its first configuration on the interface).
+ *
+ *  @param[in]      index             Index
+ *  @param[in]      pIfName           Interface name
+ *  @param[in]      comId             ComId of the telegram
+ *  @param[out]     pDestCnt          Number of destinations
+ *  @param[out]     ppDest            Array of destinations
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    parameter error or interface not configured
+ *  @retval         TRDP_COMID_ERR    comId not configured on this interface
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_findDestinations (
+    TAU_CFG_INDEX_T index,
+    const CHAR8     *pIfName,
+    UINT32          comId,
+    UINT32          *pDestCnt,
+    TRDP_DEST_T     * *ppDest);
+
+/**********************************************************************************************************************/
+/**    Find the sources of a telegram (of its first configuration on the interface).
+ *
+ *  @param[in]      index             Index
+ *  @param[in]      pIfName           Interface name
+ *  @param[in]      comId             ComId of the telegram
+ *  @param[out]     pSrcCnt           Number of sources
+ *  @param[out]     ppSrc             Array of sources
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    parameter error or interface not configured
+ *  @retval         TRDP_COMID_ERR    comId not configured on this interface
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_findSources (
+    TAU_CFG_INDEX_T index,
+    const CHAR8     *pIfName,
+    UINT32          comId,
+    UINT32          *pSrcCnt,
+    TRDP_SRC_T      * *ppSrc);
+
+/**********************************************************************************************************************/
+/**    Find a dataset by its id.
+ *
+ *  @param[in]      index             Index
+ *  @param[in]      datasetId         Dataset Id
+ *
+ *  @retval         pointer to the dataset, NULL if not configured
+ *
+ */
+EXT_DECL TRDP_DATASET_T *tau_findDataset (
+    TAU_CFG_INDEX_T index,
+    UINT32          datasetId);
+
+/**********************************************************************************************************************/
+/**    Find the dataset of a comId through the ComId DatasetId mapping.
+ *
+ *  @param[in]      index             Index
+ *  @param[in]      comId             ComId
+ *
+ *  @retval         pointer to the dataset, NULL if comId or its dataset are not configured
+ *
+ */
+EXT_DECL TRDP_DATASET_T *tau_findComIdDataset (
+    TAU_CFG_INDEX_T index,
+    UINT32          comId);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAU_CFG_INDEX_H */
@@ -0,0 +1,214 @@
+/**********************************************************************************************************************/
+/**
+ * @file            tau_cfg_session.h
+ *
+ * @brief           Telegrams of a configuration, reloadable while the sessions are running
+ *
+ * @details         This module provides the interface to the following utilities
+ *                  - publish, subscribe and listen to the telegrams of a configuration at once
+ *                  - apply a changed configuration by its difference only (hot reload)
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef TAU_CFG_SESSION_H
+#define TAU_CFG_SESSION_H
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include "tau_xml_cache.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Handle of a configured set of telegrams */
+typedef struct TAU_CFG_SESSION *TAU_CFG_SESSION_T;
+
+/** Changes of one kind of objects */
+typedef struct
+{
+    UINT32  added;                  /**< new in the configuration                               */
+    UINT32  removed;                /**< no longer in the configuration                         */
+    UINT32  modified;               /**< parameters changed, re-created                         */
+    UINT32  kept;                   /**< unchanged, not touched                                 */
+} TAU_CFG_CHANGES_T;
+
+/** Difference between two configurations, as applied by tau_applyConfig */
+typedef struct
+{
+    TAU_CFG_CHANGES_T   pub;        /**< publishers                                             */
+    TAU_CFG_CHANGES_T   sub;        /**< subscribers                                            */
+    TAU_CFG_CHANGES_T   lis;        /**< MD listeners                                           */
+    TAU_CFG_CHANGES_T   dataset;    /**< datasets, modified: other element types or sizes       */
+    UINT32              failed;     /**< publishers, subscribers and listeners not created      */
+} TAU_CFG_DIFF_T;
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+
+/**********************************************************************************************************************/
+/**    Create the publishers, subscribers and MD listeners of a configuration.
+ *
+ *  Telegrams with destinations are published, telegrams with sources are subscribed, one publisher per destination
+ *  and one subscriber per source; the type attribute restricts this to one direction. Telegrams with MD parameters
+ *  only get a listener per source instead (one for any source if there are none). The first multicast destination
+ *  is joined by subscribers and listeners. Publishers start sending with the first tlp_put().
+ *  The marshalling tables (tau_initMarshall) are set to the datasets of the configuration.
+ *
+ *  @param[out]     pCfgSession       Handle, to be released by tau_closeCfgSession
+ *  @param[in]      pConfig           Configuration, taken over in any case (released by tau_closeCfgSession)
+ *  @param[in]      numAppHandle      Number of session handles
+ *  @param[in]      pAppHandle        Session handles, one per interface of the configuration (pIfConfig order),
+ *                                    NULL if the interface is not used
+ *  @param[in]      pUserRef          User reference of the publishers, subscribers and listeners
+ *  @param[in]      pfPdCallback      PD callback, NULL to use the default function of the session
+ *  @param[in]      pfMdCallback      MD callback, NULL to use the default function of the session
+ *  @param[in]      createAll         TRUE: all telegrams, FALSE: only telegrams with create="on"
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    parameter error
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *  @retval         other             first error of a publisher, subscriber or listener, the handle is valid
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_openCfgSession (
+    TAU_CFG_SESSION_T           *pCfgSession,
+    TRDP_XML_CONFIG_T           *pConfig,
+    UINT32                      numAppHandle,
+    const TRDP_APP_SESSION_T    *pAppHandle,
+    const void                  *pUserRef,
+    TRDP_PD_CALLBACK_T          pfPdCallback,
+    TRDP_MD_CALLBACK_T          pfMdCallback,
+    BOOL8                       createAll);
+
+/**********************************************************************************************************************/
+/**    Apply a changed configuration.
+ *
+ *  The telegrams of the new configuration are compared with the running ones. Publishers are identified by
+ *  interface, comId and destination, subscribers and listeners by interface, comId, sources and multicast group.
+ *  Only the difference is applied: new telegrams are created, modified ones (other parameters, or for publishers
+ *  another dataset layout) are re-created with new handles and removed ones are deleted. Unchanged telegrams keep
+ *  their handles, sockets, sequence counters and timing. Modified ones are deleted before the marshalling switch,
+ *  they still refer to their old datasets. New ones are created before removed ones are deleted, so a multicast
+ *  group still in use is not left.
+ *  Interfaces are matched by name, the sessions are those given to tau_openCfgSession.
+ *  The marshalling tables are switched to the new datasets: they are sorted first, then the switch and the reset of
+ *  the cached datasets are done with all sessions of the interfaces locked, so marshalling in tlp_put, tlp_get,
+ *  tlc_process and the MD calls of other threads waits for it. Marshalling called directly (tau_marshall,
+ *  tau_unmarshall) or by other sessions is not serialised, it must not run during the call.
+ *
+ *  @param[in]      cfgSession        Handle from tau_openCfgSession
+ *  @param[in]      pConfig           New configuration, taken over in any case
+ *  @param[out]     pDiff             Applied difference, NULL if not needed
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    parameter error
+ *  @retval         TRDP_MEM_ERR      out of memory, the running configuration is unchanged
+ *  @retval         other             first error of a publisher, subscriber or listener, the new configuration
+ *                                    is applied without it
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_applyConfig (
+    TAU_CFG_SESSION_T   cfgSession,
+    TRDP_XML_CONFIG_T   *pConfig,
+    TAU_CFG_DIFF_T      *pDiff);
+
+/**********************************************************************************************************************/
+/**    Load a changed configuration (tau_loadConfig) and apply it (tau_applyConfig).
+ *
+ *  @param[in]      cfgSession        Handle from tau_openCfgSession
+ *  @param[in]      pXmlFileName      Path and filename of the xml configuration file, NULL: use the image
+ *  @param[in]      pImageFileName    Path and filename of the binary image, NULL: read XML
+ *  @param[out]     pDiff             Applied difference, NULL if not needed
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    parameter error or configuration not readable
+ *  @retval         TRDP_MEM_ERR      out of memory, the running configuration is unchanged
+ *  @retval         other             see tau_applyConfig
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_reloadConfig (
+    TAU_CFG_SESSION_T   cfgSession,
+    const CHAR8         *pXmlFileName,
+    const CHAR8         *pImageFileName,
+    TAU_CFG_DIFF_T      *pDiff);
+
+/**********************************************************************************************************************/
+/**    Delete all publishers, subscribers and listeners of the configuration and release it.
+ *
+ *  The marshalling tables still refer to the released datasets, tau_initMarshall must be called before marshalled
+ *  telegrams are used again.
+ *
+ *  @param[in]      cfgSession        Handle from tau_openCfgSession, NULL: nothing to do
+ *
+ */
+EXT_DECL void tau_closeCfgSession (
+    TAU_CFG_SESSION_T cfgSession);
+
+/**********************************************************************************************************************/
+/**    Get the running configuration.
+ *
+ *  @param[in]      cfgSession        Handle from tau_openCfgSession
+ *
+ *  @retval         pointer to the configuration, valid until the next tau_applyConfig
+ *
+ */
+EXT_DECL const TRDP_XML_CONFIG_T *tau_getCfgConfig (
+    TAU_CFG_SESSION_T cfgSession);
+
+/**********************************************************************************************************************/
+/**    Get the handle of a configured publisher. The handle changes if the telegram is modified by a reload.
+ *
+ *  @param[in]      cfgSession        Handle from tau_openCfgSession
+ *  @param[in]      appHandle         Session of the interface
+ *  @param[in]      comId             ComId of the telegram
+ *  @param[in]      destIpAddr        Destination of the publisher
+ *
+ *  @retval         publisher handle, NULL if not configured or not created
+ *
+ */
+EXT_DECL TRDP_PUB_T tau_getCfgPubHandle (
+    TAU_CFG_SESSION_T   cfgSession,
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              comId,
+    TRDP_IP_ADDR_T      destIpAddr);
+
+/**********************************************************************************************************************/
+/**    Get the handle of a configured subscriber. The handle changes if the telegram is modified by a reload.
+ *
+ *  @param[in]      cfgSession        Handle from tau_openCfgSession
+ *  @param[in]      appHandle         Session of the interface
+ *  @param[in]      comId             ComId of the telegram
+ *  @param[in]      srcIpAddr         Source (first address of the source), 0: first subscriber of the comId
+ *
+ *  @retval         subscriber handle, NULL if not configured or not created
+ *
+ */
+EXT_DECL TRDP_SUB_T tau_getCfgSubHandle (
+    TAU_CFG_SESSION_T   cfgSession,
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              comId,
+    TRDP_IP_ADDR_T      srcIpAddr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAU_CFG_SESSION_H */
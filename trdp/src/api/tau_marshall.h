@@ -18,6 +18,7 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: tau_prepareMarshall() added
  *      BL 2015-12-14: Ticket #33: source size check for marshalling
  */
 
@@ -60,8 +61,30 @@ extern "C" {
 /**********************************************************************************************************************/
 
 /**********************************************************************************************************************/
-/**    Function to initialise the marshalling/unmarshalling.
+/**    Prepare tables for the marshalling/unmarshalling.
+ *    Sorts the tables in place and invalidates the dataset caches of their elements, without touching the
+ *    marshalling in use. Call it before tau_initMarshall() to keep a switch of running sessions short.
+ *
+ *  @param[in]      numComId         Number of datasets found in the configuration
+ *  @param[in]      pComIdDsIdMap    Pointer to an array of structures of type TRDP_DATASET_T
+ *  @param[in]      numDataSet       Number of datasets found in the configuration
+ *  @param[in]      pDataset         Pointer to an array of pointers to structures of type TRDP_DATASET_T
+ *
+ *  @retval         TRDP_NO_ERR      no error
+ *  @retval         TRDP_PARAM_ERR   Parameter error
  *
+ */
+
+EXT_DECL TRDP_ERR_T tau_prepareMarshall(
+    UINT32 numComId,
+    TRDP_COMID_DSID_MAP_T  * pComIdDsIdMap,
+    UINT32 numDataSet,
+    TRDP_DATASET_T         * pDataset[]);
+
+/**********************************************************************************************************************/
+/**    Function to initialise the marshalling/unmarshalling.
+ *    Sorts the tables (tau_prepareMarshall) and switches the marshalling to them. The switch is not atomic:
+ *    sessions using the marshalling must be locked meanwhile (see tau_applyConfig).
  *
  *  @param[in,out]  ppRefCon         Returns a pointer to be used for the reference context of marshalling/unmarshalling
  *  @param[in]      numComId         Number of datasets found in the configuration
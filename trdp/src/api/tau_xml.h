@@ -18,6 +18,8 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: TRDP_PD_PAR_T.phased, set if the attribute "phase" is given (0 included)
+ *      BL 2026-10-17: TRDP_PD_PAR_T.phase (pd-parameter attribute "phase")
  *      BL 2017-05-08: Compiler warnings, flag enums -> defines
  *      BL 2016-02-11: Ticket #102: Custom XML parser, libxml2 not needed anymore
  */
@@ -82,6 +84,8 @@ typedef struct
     TRDP_TO_BEHAVIOR_T  toBehav;   /**< Behavior when received process data is invalid/timed out. */
     TRDP_FLAGS_T        flags;     /**< TRDP_FLAGS_MARSHALL, TRDP_FLAGS_REDUNDANT */
     UINT16              offset;    /**< Offset-address for PD in traffic store for ladder topology */
+    UINT32              phase;     /**< Send offset in us after the session cycle epoch */
+    BOOL8               phased;    /**< TRUE if the phase attribute is given, FALSE = unphased */
 } TRDP_PD_PAR_T;
 
 typedef struct
@@ -0,0 +1,150 @@
+/**********************************************************************************************************************/
+/**
+ * @file            tau_xml_cache.h
+ *
+ * @brief           Complete XML configuration and its binary image
+ *
+ * @details         This module provides the interface to the following utilities
+ *                  - read the complete xml configuration of a device at once
+ *                  - binary image of a parsed configuration for fast startup
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef TAU_XML_CACHE_H
+#define TAU_XML_CACHE_H
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include "tau_xml.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Interface part of a complete configuration
+ */
+typedef struct
+{
+    TRDP_PROCESS_CONFIG_T   processConfig;  /**< TRDP process (session) configuration   */
+    TRDP_PD_CONFIG_T        pdConfig;       /**< PD default configuration               */
+    TRDP_MD_CONFIG_T        mdConfig;       /**< MD default configuration               */
+    UINT32                  numExchgPar;    /**< Number of configured telegrams         */
+    TRDP_EXCHG_PAR_T        *pExchgPar;     /**< Array of telegram configurations       */
+} TRDP_XML_IF_SETTINGS_T;
+
+/** Complete configuration of a device, as read by tau_readXmlConfig or tau_loadConfig
+ */
+typedef struct
+{
+    TRDP_MEM_CONFIG_T       memConfig;      /**< Memory configuration                               */
+    TRDP_DBG_CONFIG_T       dbgConfig;      /**< Debug printout configuration                       */
+    UINT32                  numComPar;      /**< Number of com parameters                           */
+    TRDP_COM_PAR_T          *pComPar;       /**< Array of com parameters                            */
+    UINT32                  numIfConfig;    /**< Number of interfaces                               */
+    TRDP_IF_CONFIG_T        *pIfConfig;     /**< Array of interface parameter sets                  */
+    TRDP_XML_IF_SETTINGS_T  *pIfSettings;   /**< Array of interface settings, same order as pIfConfig */
+    UINT32                  numComId;       /**< Number of entries in the ComId DatasetId mapping   */
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap; /**< Array of ComId DatasetId mappings                  */
+    UINT32                  numDataset;     /**< Number of datasets                                 */
+    apTRDP_DATASET_T        apDataset;      /**< Array of pointers to the datasets                  */
+    void                    *pImage;        /**< Binary image holding the configuration, NULL if it
+                                                 was read from XML                                  */
+    UINT32                  imageSize;      /**< Size of the binary image                           */
+} TRDP_XML_CONFIG_T;
+
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+
+/**********************************************************************************************************************/
+/**    Read the complete configuration (device, datasets and all interfaces) out of the XML configuration file.
+ *
+ *  @param[in]      pFileName         Path and filename of the xml configuration file
+ *  @param[out]     pConfig           Configuration, to be released by tau_freeConfig
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *  @retval         TRDP_PARAM_ERR    File not existing
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_readXmlConfig (
+    const CHAR8         *pFileName,
+    TRDP_XML_CONFIG_T   *pConfig);
+
+/**********************************************************************************************************************/
+/**    Write a configuration into a binary image file.
+ *
+ *  The image is versioned and checksummed, pointers are stored as offsets into the image.
+ *  It is only valid for the platform (byte order, pointer and structure sizes) and TRDP version that wrote it.
+ *  Size, modification time (ns) and CRC of the XML file are stored to detect a stale image.
+ *
+ *  @param[in]      pConfig           Configuration, from tau_readXmlConfig
+ *  @param[in]      pXmlFileName      XML file the configuration was read from
+ *  @param[in]      pImageFileName    Path and filename of the image to be written
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    parameter error
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *  @retval         TRDP_IO_ERR       XML file not existing or image not writable
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_writeConfigImage (
+    const TRDP_XML_CONFIG_T *pConfig,
+    const CHAR8             *pXmlFileName,
+    const CHAR8             *pImageFileName);
+
+/**********************************************************************************************************************/
+/**    Load the complete configuration, from the binary image if it is valid and up to date, else from XML.
+ *
+ *  The image is mapped into memory once, the configuration is used in place without further allocations.
+ *  If the image is missing, damaged, written by another platform or TRDP version, or does not match the XML file
+ *  (size, modification time or CRC), the XML file is parsed instead (the image is not rewritten).
+ *  Size and modification time are checked first; only if they match, the XML file is read once for its CRC.
+ *
+ *  @param[in]      pXmlFileName      Path and filename of the xml configuration file, NULL: use the image
+ *                                    without checking it against the XML file
+ *  @param[in]      pImageFileName    Path and filename of the binary image, NULL: read XML
+ *  @param[out]     pConfig           Configuration, to be released by tau_freeConfig,
+ *                                    pConfig->pImage != NULL if it was loaded from the image
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *  @retval         TRDP_PARAM_ERR    no usable image and XML file not existing
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_loadConfig (
+    const CHAR8         *pXmlFileName,
+    const CHAR8         *pImageFileName,
+    TRDP_XML_CONFIG_T   *pConfig);
+
+/**********************************************************************************************************************/
+/**    Release a configuration read by tau_readXmlConfig or tau_loadConfig
+ *
+ *  @param[in]      pConfig           Configuration
+ *
+ */
+EXT_DECL void tau_freeConfig (
+    TRDP_XML_CONFIG_T *pConfig);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAU_XML_CACHE_H */
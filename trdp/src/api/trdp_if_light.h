@@ -16,6 +16,26 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: Phase documented: pSendParam->phased, unphased publishers are not moved by tlc_setCycleEpoch
+ *      BL 2026-10-17: tlc_publishListStatistics() added, the lists are no longer published by every session
+ *      BL 2026-10-17: Metrics endpoint renders in slices and continues partial sends (documented)
+ *      BL 2026-10-17: tlc_dumpTraceFd() added, async-signal-safe trace dump
+ *      BL 2026-10-17: tlc_resetDatasetCache() added
+ *      BL 2026-10-17: tlp_publishBatch(), tlp_subscribeBatch() added
+ *      BL 2026-10-17: tlc_openHistory(), tlc_closeHistory() added
+ *      BL 2026-10-17: tlc_getSourceStatistics() added
+ *      BL 2026-10-17: tlc_setCallbackThreshold(), tlc_getCallbackStatistics() added
+ *      BL 2026-10-17: tlc_setProcessTiming(), tlc_getProcessStatistics() added
+ *      BL 2026-10-17: Callback accounting needs TRDP_OPTION_CALLBACK_STATS
+ *      BL 2026-10-17: tlc_resetStatistics() keeps numJoin, numSubs, numPub and numList (documented)
+ *      BL 2026-10-17: tlc_getStatisticsSnapshot() added
+ *      BL 2026-10-17: tlc_getMetrics(), tlc_setMetricsPort() added
+ *      BL 2026-10-17: tlc_setTrace(), tlc_dumpTrace(), tlc_requestTraceDump() added
+ *      BL 2026-10-17: tlc_getLatencyStatistics(), tlc_getLatencyPercentile() added
+ *      BL 2026-10-17: tlc_setBandwidthLimit(), tlc_getCommittedBitRate(), tlc_setMdRateLimit() added
+ *      BL 2026-10-17: tlc_setSendBudget() added
+ *      BL 2026-10-17: tlc_setCycleEpoch() added, publisher phase
+ *      BL 2026-10-17: tlc_getShapingStatistics() added
  *      BL 2018-03-06: Ticket #101 Optional callback function on PD send
  *      BL 2018-02-03: Ticket #190 Source filtering (IP-range) for PD subscribe
  *      BL 2017-11-28: Ticket #180 Filtering rules for DestinationURI does not follow the standard
@@ -205,6 +225,131 @@ EXT_DECL TRDP_ERR_T tlc_setOpTrainTopoCount (
 EXT_DECL UINT32     tlc_getOpTrainTopoCount (
     TRDP_APP_SESSION_T  appHandle);
 
+/**********************************************************************************************************************/
+/** Set the cycle epoch of the session.
+ *
+ *    Phased cyclic publishers are released at epoch + phase + k * interval. The epoch defaults to the
+ *    time the session was opened; set it e.g. to a common (synchronised) second boundary to get
+ *    reproducible send instants across devices. Running phased and shaped publishers are re-aligned,
+ *    unphased ones keep their send times.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *  @param[in]      pEpoch              New epoch (vos_getTime() time base)
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_setCycleEpoch (
+    TRDP_APP_SESSION_T  appHandle,
+    const TRDP_TIME_T   *pEpoch);
+
+/**********************************************************************************************************************/
+/** Limit the PD bytes sent per time window.
+ *
+ *    Due PDs are sent by QoS (pSendParam->qos, highest first) and, within the same QoS, earliest deadline
+ *    first. With a budget set, PDs with a QoS below minQos are deferred to the next window once the bytes
+ *    of the current window are used up; PDs with minQos or higher are always sent, but use up the budget.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *  @param[in]      bytes               Bytes (gross packet size) per window, 0 switches the budget off
+ *  @param[in]      window              Window length in us, windows are aligned to the cycle epoch
+ *  @param[in]      minQos              PDs with this QoS or higher are never deferred (0...8)
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_setSendBudget (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              bytes,
+    UINT32              window,
+    UINT8               minQos);
+
+/**********************************************************************************************************************/
+/** Limit the committed PD bit rate per interface (admission control).
+ *
+ *    The committed bit rate of an interface is the sum of (gross size + Ethernet/IP/UDP overhead) / interval
+ *    over its cyclic publishers. tlp_publish() checks each new publisher against the limit.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *  @param[in]      bitRate             Max. bit/s per interface, 0 switches the admission control off
+ *  @param[in]      reject              TRUE: tlp_publish() fails with TRDP_QUEUE_FULL_ERR, FALSE: warning only
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_setBandwidthLimit (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              bitRate,
+    BOOL8               reject);
+
+/**********************************************************************************************************************/
+/** Get the committed PD bit rate of an interface.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *  @param[in]      ifAddr              Interface (source IP of the publishers), 0 for the session's own IP
+ *  @param[out]     pBitRate            Committed bit/s of the cyclic publishers
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_getCommittedBitRate (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_IP_ADDR_T      ifAddr,
+    UINT32              *pBitRate);
+
+#if MD_SUPPORT
+/**********************************************************************************************************************/
+/** Limit the MD send rate with a token bucket.
+ *
+ *    Messages exceeding the available tokens stay queued and are sent by a later tlc_process() call;
+ *    tlc_getInterval() returns the time the bucket allows the next one.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *  @param[in]      rate                Bytes per second, 0 switches the rate limit off
+ *  @param[in]      burst               Bucket depth in bytes (max. burst), 0 for one second worth of bytes
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_setMdRateLimit (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              rate,
+    UINT32              burst);
+#endif
+
+/**********************************************************************************************************************/
+/** Forget the datasets cached by the marshalling of publishers and MD messages.
+ *
+ *    Must be called after the dataset tables of the marshalling were replaced (e.g. by tau_initMarshall with a
+ *    reloaded configuration) and before the old tables are released.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_resetDatasetCache (
+    TRDP_APP_SESSION_T appHandle);
+
+/**********************************************************************************************************************/
+/** Answer statistics pulls for the subscription and publisher lists.
+ *
+ *    Publishes TRDP_SUBS_LIST_COMID and TRDP_PUB_LIST_COMID as pull-only telegrams. A statistics pull
+ *    (TRDP_STATISTICS_PULL_COMID) with one of them as reply ComId is then answered with the list
+ *    (TRDP_STATISTICS_LIST_T). Both telegrams count as publishers of the session. Calling it again has no effect.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+EXT_DECL TRDP_ERR_T tlc_publishListStatistics (
+    TRDP_APP_SESSION_T appHandle);
+
 /**********************************************************************************************************************/
 /** Frees the buffer reserved by the TRDP layer.
  *
@@ -225,6 +370,8 @@ EXT_DECL TRDP_ERR_T tlc_freeBuf (
  *  Return the maximum time interval suitable for 'select()' so that we
  *    can send due PD packets in time.
  *    If the PD send queue is empty, return zero time
+ *    With TRDP_OPTION_PRECISE_WAIT the interval is shortened by a guard band,
+ *    tlc_process then busy-waits until the packets are due.
  *
  *  @param[in]      appHandle           The handle returned by tlc_openSession
  *  @param[out]     pInterval           pointer to needed interval
@@ -290,12 +437,16 @@ EXT_DECL TRDP_IP_ADDR_T tlc_getOwnIpAddress (TRDP_APP_SESSION_T     appHandle);
  *  @param[in]      pktFlags            OPTION:
  *                                      TRDP_FLAGS_DEFAULT, TRDP_FLAGS_NONE, TRDP_FLAGS_MARSHALL, TRDP_FLAGS_CALLBACK
  *  @param[in]      pSendParam          optional pointer to send parameter, NULL - default parameters are used
+ *                                      pSendParam->phase: send offset within the interval, relative to the
+ *                                      session cycle epoch (see tlc_setCycleEpoch), used if pSendParam->phased
+ *                                      is set. Unphased publishers are first sent one interval after publishing
  *  @param[in]      pData               pointer to data packet / dataset, NULL if sending starts later with tlp_put()
  *  @param[in]      dataSize            size of data packet >= 0 and <= TRDP_MAX_PD_DATA_SIZE
  *
  *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_PARAM_ERR      parameter error
  *  @retval         TRDP_MEM_ERR        could not insert (out of memory)
+ *  @retval         TRDP_QUEUE_FULL_ERR bit rate limit of the interface exceeded (tlc_setBandwidthLimit)
  *  @retval         TRDP_NOINIT_ERR     handle invalid
  */
 EXT_DECL TRDP_ERR_T tlp_publish (
@@ -315,6 +466,28 @@ EXT_DECL TRDP_ERR_T tlp_publish (
     const UINT8             *pData,
     UINT32                  dataSize);
 
+/**********************************************************************************************************************/
+/** Prepare for sending a batch of PD messages.
+ *  Equivalent to one tlp_publish per descriptor, but the session is locked once, consecutive publishers with
+ *  equal addressing share a socket request and traffic shaping places the whole batch in one pass.
+ *  A failing descriptor does not stop the batch, its handle is set to NULL.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      count               number of descriptors
+ *  @param[in]      pDesc               array of publisher descriptors
+ *  @param[out]     pPubHandle          array of count returned handles, NULL for failed entries
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         other               error of the first failed descriptor (see tlp_publish)
+ */
+EXT_DECL TRDP_ERR_T tlp_publishBatch (
+    TRDP_APP_SESSION_T      appHandle,
+    UINT32                  count,
+    const TRDP_PUB_DESC_T   *pDesc,
+    TRDP_PUB_T              *pPubHandle);
+
 /**********************************************************************************************************************/
 /** Prepare for sending PD messages.
  *  Reinitialize and queue a PD message, it will be send when tlc_publish has been called
@@ -494,6 +667,28 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
     UINT32              timeout,
     TRDP_TO_BEHAVIOR_T  toBehavior);
 
+/**********************************************************************************************************************/
+/** Prepare for receiving a batch of PD messages.
+ *  Equivalent to one tlp_subscribe per descriptor, but the session is locked once and consecutive subscriptions
+ *  to the same destination share a socket request and multicast join.
+ *  A failing descriptor does not stop the batch, its handle is set to NULL.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      count               number of descriptors
+ *  @param[in]      pDesc               array of subscriber descriptors
+ *  @param[out]     pSubHandle          array of count returned handles, NULL for failed entries
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         other               error of the first failed descriptor (see tlp_subscribe)
+ */
+EXT_DECL TRDP_ERR_T tlp_subscribeBatch (
+    TRDP_APP_SESSION_T      appHandle,
+    UINT32                  count,
+    const TRDP_SUB_DESC_T   *pDesc,
+    TRDP_SUB_T              *pSubHandle);
+
 
 /**********************************************************************************************************************/
 /** Reprepare for receiving PD messages.
@@ -883,6 +1078,139 @@ EXT_DECL TRDP_ERR_T tlc_getStatistics (
     TRDP_STATISTICS_T   *pStatistics);
 
 
+/**********************************************************************************************************************/
+/** Return a consistent snapshot of the session, subscription and publisher statistics.
+ *  All values are copied in one pass while the session is locked.
+ *  Memory for statistics information must be provided by the user.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pStatistics         Pointer to statistics for this application session
+ *  @param[in,out]  pNumSubs            In: The number of subscriptions requested, NULL: none
+ *                                      Out: Number of subscriptions returned
+ *  @param[out]     pSubsStatistics     Pointer to an array with the subscription statistics information
+ *  @param[in,out]  pNumPub             In: The number of publishers requested, NULL: none
+ *                                      Out: Number of publishers returned
+ *  @param[out]     pPubStatistics      Pointer to an array with the publish statistics information
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        there are more subscriptions or publishers than requested
+ */
+EXT_DECL TRDP_ERR_T tlc_getStatisticsSnapshot (
+    TRDP_APP_SESSION_T      appHandle,
+    TRDP_STATISTICS_T       *pStatistics,
+    UINT16                  *pNumSubs,
+    TRDP_SUBS_STATISTICS_T  *pSubsStatistics,
+    UINT16                  *pNumPub,
+    TRDP_PUB_STATISTICS_T   *pPubStatistics);
+
+
+/**********************************************************************************************************************/
+/** Switch the stage timing of tlc_process() on or off and set the budgets supervised.
+ *  A pass exceeding passBudget records the stage that took the most time,
+ *  a callback exceeding callbackBudget records its ComId and the calling stage.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      enable              TRUE: time the stages, FALSE: switch off and discard the values
+ *  @param[in]      passBudget          budget of a pass in us, 0 = not supervised
+ *  @param[in]      callbackBudget      budget of a callback in us, 0 = not supervised
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      stage timing is not compiled in
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+EXT_DECL TRDP_ERR_T tlc_setProcessTiming (
+    TRDP_APP_SESSION_T  appHandle,
+    BOOL8               enable,
+    UINT32              passBudget,
+    UINT32              callbackBudget);
+
+
+/**********************************************************************************************************************/
+/** Return the stage timing of tlc_process() and the budget overruns.
+ *  Percentiles of the stage histograms can be computed with tlc_getLatencyPercentile().
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pStatistics         Pointer to the timing statistics
+ *  @param[in]      reset               TRUE: clear histograms and overruns after copying
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error or stage timing is off
+ */
+EXT_DECL TRDP_ERR_T tlc_getProcessStatistics (
+    TRDP_APP_SESSION_T          appHandle,
+    TRDP_PROCESS_STATISTICS_T   *pStatistics,
+    BOOL8                       reset);
+
+
+/**********************************************************************************************************************/
+/** Set the threshold above which a PD or MD callback is counted as slow and logged.
+ *  Only timed callbacks are checked, see tlc_getCallbackStatistics().
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      threshold           threshold in us, 0 = no slow callback detection
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_setCallbackThreshold (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              threshold);
+
+
+/**********************************************************************************************************************/
+/** Return the callback execution times of publishers, subscriptions and MD listeners.
+ *  The list holds the publishers, the subscriptions, the listeners and one entry for the callbacks of
+ *  MD sessions started by the application (TRDP_CB_CALLER), in this order.
+ *  Callbacks are only timed if the session was opened with TRDP_OPTION_CALLBACK_STATS (or
+ *  TRDP_OPTION_LATENCY_STATS) or while the stage timing is on (tlc_setProcessTiming()), else all values are 0.
+ *  Memory for statistics information must be provided by the user.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  pNum                In: number of entries provided, Out: number of entries returned
+ *  @param[out]     pStatistics         Pointer to a list with the callback statistics
+ *  @param[in]      reset               TRUE: clear the returned values
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        there are more entries than requested
+ */
+EXT_DECL TRDP_ERR_T tlc_getCallbackStatistics (
+    TRDP_APP_SESSION_T          appHandle,
+    UINT16                      *pNum,
+    TRDP_CALLBACK_STATISTICS_T  *pStatistics,
+    BOOL8                       reset);
+
+
+/**********************************************************************************************************************/
+/** Return the sequence counter analysis of each sender of a subscription:
+ *  loss rate, loss bursts, reordered and duplicated packets.
+ *  Memory for statistics information must be provided by the user.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           the handle returned by tlp_subscribe
+ *  @param[in,out]  pNumSrc             In: number of entries provided, Out: number of senders returned
+ *  @param[out]     pStatistics         Pointer to a list with the statistics per sender
+ *  @param[in]      reset               TRUE: clear the returned counters
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_NOSUB_ERR      subscription handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        there are more senders than requested
+ */
+EXT_DECL TRDP_ERR_T tlc_getSourceStatistics (
+    TRDP_APP_SESSION_T          appHandle,
+    TRDP_SUB_T                  subHandle,
+    UINT16                      *pNumSrc,
+    TRDP_SOURCE_STATISTICS_T    *pStatistics,
+    BOOL8                       reset);
+
+
 /**********************************************************************************************************************/
 /** Return PD subscription statistics.
  *  Memory for statistics information must be provided by the user.
@@ -923,6 +1251,189 @@ EXT_DECL TRDP_ERR_T tlc_getPubStatistics (
     UINT16                  *pNumPub,
     TRDP_PUB_STATISTICS_T   *pStatistics);
 
+/**********************************************************************************************************************/
+/** Return traffic shaping information per interface.
+ *  Memory for statistics information must be provided by the user.
+ *  The reserved length is given via pNumIf implicitely.
+ *  Entries are only available if the session was opened with TRDP_OPTION_TRAFFIC_SHAPING.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  pNumIf              Pointer to the number of interfaces
+ *  @param[out]     pStatistics         pointer to a list with the traffic shaping information
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        there are more interfaces than requested
+ */
+EXT_DECL TRDP_ERR_T tlc_getShapingStatistics (
+    TRDP_APP_SESSION_T          appHandle,
+    UINT16                      *pNumIf,
+    TRDP_SHAPING_STATISTICS_T   *pStatistics);
+
+/**********************************************************************************************************************/
+/** Return latency histograms of publishers and subscriptions.
+ *  Memory for statistics information must be provided by the user.
+ *  The reserved length is given via pNum implicitely. Publishers are returned first, then subscriptions.
+ *  Histograms are only recorded if the session was opened with TRDP_OPTION_LATENCY_STATS.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  pNum                Pointer to the number of entries
+ *  @param[out]     pStatistics         pointer to a list with the latency statistics
+ *  @param[in]      reset               TRUE: clear the returned histograms (reset on read)
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        there are more entries than requested
+ */
+EXT_DECL TRDP_ERR_T tlc_getLatencyStatistics (
+    TRDP_APP_SESSION_T          appHandle,
+    UINT16                      *pNum,
+    TRDP_LATENCY_STATISTICS_T   *pStatistics,
+    BOOL8                       reset);
+
+/**********************************************************************************************************************/
+/** Approximate percentile of a latency histogram.
+ *
+ *  @param[in]      pHist               histogram
+ *  @param[in]      permille            percentile in 1/1000 (e.g. 990 for p99)
+ *
+ *  @retval         upper bound in ns of the bucket containing the percentile, 0 if the histogram is empty
+ */
+EXT_DECL UINT32 tlc_getLatencyPercentile (
+    const TRDP_LAT_HIST_T   *pHist,
+    UINT32                  permille);
+
+/**********************************************************************************************************************/
+/** Switch event tracing on or off.
+ *  Packet rx/tx, timeouts, MD state changes, socket open/close and tlc_process() passes are recorded
+ *  into a preallocated ring, the oldest events are overwritten.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      noOfEvents          size of the ring in records (24 bytes each), 0 switches tracing off
+ *  @param[in]      pDumpFileName       file for dumps requested by tlc_requestTraceDump(), NULL: default
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      tracing is not compiled in
+ *  @retval         TRDP_MEM_ERR        ring could not be allocated
+ */
+EXT_DECL TRDP_ERR_T tlc_setTrace (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              noOfEvents,
+    const CHAR8         *pDumpFileName);
+
+/**********************************************************************************************************************/
+/** Dump the recorded events to a file (TRDP_TRACE_HEADER_T followed by the records, oldest first).
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pFileName           name of the dump file, NULL: file given to tlc_setTrace()
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      tracing is off
+ *  @retval         TRDP_IO_ERR         file could not be written
+ */
+EXT_DECL TRDP_ERR_T tlc_dumpTrace (
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pFileName);
+
+/**********************************************************************************************************************/
+/** Dump the recorded events to a file descriptor opened in advance (same layout as tlc_dumpTrace()).
+ *  Async-signal-safe: only write() is used, no lock is taken. The ring is kept until the dump is done
+ *  if tlc_setTrace() is called concurrently. Records being written concurrently may be torn.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession, must stay open
+ *  @param[in]      fd                  file descriptor open for writing
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      handle NULL or tracing is off
+ *  @retval         TRDP_IO_ERR         write failed
+ */
+EXT_DECL TRDP_ERR_T tlc_dumpTraceFd (
+    TRDP_APP_SESSION_T  appHandle,
+    INT32               fd);
+
+/**********************************************************************************************************************/
+/** Request a dump of the recorded events at the end of the next tlc_process() pass.
+ *  May be called from a signal handler.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ */
+EXT_DECL void tlc_requestTraceDump (
+    TRDP_APP_SESSION_T appHandle);
+
+/**********************************************************************************************************************/
+/** Render the session statistics in OpenMetrics text format.
+ *  Counters, memory pool usage, per publisher / subscription counters and latency histograms are included.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pBuf                buffer for the text (zero terminated)
+ *  @param[in,out]  pSize               In: size of the buffer, Out: length of the text;
+ *                                      if the buffer is too small: needed buffer size
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        buffer too small, text is truncated
+ */
+EXT_DECL TRDP_ERR_T tlc_getMetrics (
+    TRDP_APP_SESSION_T  appHandle,
+    CHAR8               *pBuf,
+    UINT32              *pSize);
+
+/**********************************************************************************************************************/
+/** Open or close the HTTP endpoint for the metrics (GET /metrics).
+ *  The endpoint is part of the descriptor set returned by tlc_getInterval() and is served by tlc_process().
+ *  A response is rendered in slices over several tlc_process() passes and sent as far as the client takes it,
+ *  tlc_getInterval() returns 0 while a response is rendered.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      bindAddr            address to listen on, 0 = any
+ *  @param[in]      port                TCP port, 0 closes the endpoint
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_SOCK_ERR       socket could not be opened, bound or set to listen
+ */
+EXT_DECL TRDP_ERR_T tlc_setMetricsPort (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_IP_ADDR_T      bindAddr,
+    UINT16              port);
+
+/**********************************************************************************************************************/
+/** Start recording the statistics history into a shared memory area.
+ *  Once per second tlc_process() writes the PD, MD and memory counters, the cycle timing (tlc_setProcessTiming())
+ *  and the latency sums (TRDP_OPTION_LATENCY_STATS) into a ring of TRDP_HISTORY_SAMPLE_T, which external
+ *  processes can map and read. An existing area with the same layout is continued.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pKey                name of the shared memory area (POSIX: "/name")
+ *  @param[in]      noOfSamples         size of the ring in samples (e.g. 3600 for one hour)
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error, the area exists with a different size
+ *  @retval         TRDP_MEM_ERR        area could not be created or mapped
+ */
+EXT_DECL TRDP_ERR_T tlc_openHistory (
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pKey,
+    UINT32              noOfSamples);
+
+/**********************************************************************************************************************/
+/** Stop recording the statistics history.
+ *  The area is removed if it was created by this session. Closing the session closes the history, too.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_closeHistory (
+    TRDP_APP_SESSION_T appHandle);
+
 #if MD_SUPPORT
 /**********************************************************************************************************************/
 /** Return UDP MD listener statistics.
@@ -1007,6 +1518,9 @@ EXT_DECL TRDP_ERR_T tlc_getJoinStatistics (
 
 /**********************************************************************************************************************/
 /** Reset statistics.
+ *  The traffic and error counters are cleared. The uptime and the numbers that describe the current
+ *  configuration are kept: numJoin, pd.numSubs, pd.numPub and the MD listener counts (numList).
+ *  Before 2026-10-17 these were cleared as well and recounted by the next tlc_getStatistics().
  *
  *  @param[in]      appHandle           the handle returned by tlc_openSession
  *
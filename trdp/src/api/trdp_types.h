@@ -15,6 +15,21 @@
  *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2015. All rights reserved.
  *
  *
+ *      BL 2026-10-17: TRDP_SUBS_LIST_COMID, TRDP_PUB_LIST_COMID: lists moved off the standard ComIds 36, 37
+ *      BL 2026-10-17: TRDP_PUB_DESC_T, TRDP_SUB_DESC_T added (batch publish/subscribe)
+ *      BL 2026-10-17: TRDP_SEND_PARAM_T.phased, a phase of 0 is a valid phase
+ *      BL 2026-10-17: Statistics history types (TRDP_HISTORY_HEADER_T, TRDP_HISTORY_SAMPLE_T) added
+ *      BL 2026-10-17: TRDP_STATISTICS_LIST_T added (subscription and publisher lists on statistics pull)
+ *      BL 2026-10-17: TRDP_SOURCE_STATISTICS_T.numReordered counts late packets counted as lost only
+ *      BL 2026-10-17: TRDP_SOURCE_STATISTICS_T added
+ *      BL 2026-10-17: TRDP_CALLBACK_STATISTICS_T added
+ *      BL 2026-10-17: TRDP_PROC_STAGE_T, TRDP_PROCESS_STATISTICS_T added
+ *      BL 2026-10-17: Event trace types (TRDP_TRACE_EVENT_T, TRDP_TRACE_REC_T, TRDP_TRACE_HEADER_T) added
+ *      BL 2026-10-17: TRDP_OPTION_CALLBACK_STATS added
+ *      BL 2026-10-17: TRDP_OPTION_LATENCY_STATS, TRDP_LAT_HIST_T, TRDP_LATENCY_STATISTICS_T added
+ *      BL 2026-10-17: TRDP_SEND_PARAM_T.phase added
+ *      BL 2026-10-17: TRDP_OPTION_PRECISE_WAIT added
+ *      BL 2026-10-17: TRDP_SHAPING_STATISTICS_T added
  *      BL 2018-09-05: Ticket #211 XML handling: Dataset Name should be stored in TRDP_DATASET_ELEMENT_T
  *      BL 2018-05-02: Ticket #188 Typo in the TRDP_VAR_SIZE definition
  *      BL 2017-11-13: Ticket #176 TRDP_LABEL_T breaks field alignment -> TRDP_NET_LABEL_T
@@ -283,6 +298,10 @@ typedef struct
     UINT8   qos;       /**< Quality of service (default should be 5 for PD and 3 for MD)  */
     UINT8   ttl;       /**< Time to live (default should be 64)  */
     UINT8   retries;   /**< Retries from XML file */
+    BOOL8   phased;    /**< PD only: TRUE if phase is given (0 included), FALSE = unphased (first sent one
+                            interval after publishing, placed by traffic shaping, if enabled)  */
+    UINT32  phase;     /**< PD only: send offset in us after the session cycle epoch (modulo interval),
+                            only used if phased is set  */
 } TRDP_SEND_PARAM_T;
 
 
@@ -475,6 +494,121 @@ typedef struct
     UINT32          numSend;    /**< Number of packets sent out */
 } TRDP_PUB_STATISTICS_T;
 
+/** Non-standard ComIds of the subscription and publisher lists (layout TRDP_STATISTICS_LIST_T, not the
+ *  IEC 61375-2-3 datasets of ComId 36 and 37). Published on request only, see tlc_publishListStatistics(). */
+#define TRDP_SUBS_LIST_COMID    0xFFFF0024u
+#define TRDP_PUB_LIST_COMID     0xFFFF0025u
+
+/** Head of the subscription list (TRDP_SUBS_LIST_COMID) and the publisher list (TRDP_PUB_LIST_COMID)
+ *  returned on a statistics pull (TRDP_STATISTICS_PULL_COMID with the list's ComId as reply ComId).
+ *  It is followed by numEntries TRDP_SUBS_STATISTICS_T or TRDP_PUB_STATISTICS_T and by numEntries UINT32
+ *  dataset sizes, all in network byte order. */
+typedef struct
+{
+    UINT16  numTotal;           /**< Number of subscriptions or publishers of the device    */
+    UINT16  numEntries;         /**< Number of entries in this telegram (limited by the PD size) */
+} TRDP_STATISTICS_LIST_T;
+
+/** Traffic shaping information of one interface. */
+typedef struct
+{
+    TRDP_IP_ADDR_T  ifAddr;     /**< IP address of the interface */
+    UINT32          slotTime;   /**< Width of one send slot in us */
+    UINT32          noOfSlots;  /**< Hyperperiod of all publishers in slots */
+    UINT32          numPub;     /**< Number of cyclic publishers on this interface */
+    UINT32          maxBurst;   /**< Worst case number of bytes sent within one slot */
+} TRDP_SHAPING_STATISTICS_T;
+
+/** Number of buckets of a latency histogram */
+#define TRDP_LAT_BUCKETS    124u
+
+/** Latency histogram (fixed memory, log-linear with four buckets per power of two, values in ns).
+ *  A value v < 4 is counted in bucket[v], a value v >= 4 whose highest set bit is bit m is counted in
+ *  bucket[4 * (m - 1) + ((v >> (m - 2)) & 3)]. Values above 2^32 - 1 ns are counted in the last bucket. */
+typedef struct
+{
+    UINT32          count;      /**< Number of samples */
+    UINT32          min;        /**< Smallest sample in ns */
+    UINT32          max;        /**< Largest sample in ns */
+    UINT64          sum;        /**< Sum of all samples in ns (for the mean) */
+    UINT32          bucket[TRDP_LAT_BUCKETS];   /**< Sample counts */
+} TRDP_LAT_HIST_T;
+
+/** Latency statistics of a publisher or a subscription (TRDP_OPTION_LATENCY_STATS). */
+typedef struct
+{
+    UINT32          comId;      /**< ComId */
+    TRDP_IP_ADDR_T  addr;       /**< Publisher: destination, subscription: joined address or 0 */
+    BOOL8           publisher;  /**< TRUE for a publisher, FALSE for a subscription */
+    TRDP_LAT_HIST_T stack;      /**< Publisher: tlp_put() until sent, subscription: socket ready until callback */
+    TRDP_LAT_HIST_T callback;   /**< Execution time of the callback (publisher: pre-send callback) */
+} TRDP_LATENCY_STATISTICS_T;
+
+/** Stages of a tlc_process() pass (TRDP_PROCESS_TIMING) */
+typedef enum
+{
+    TRDP_STAGE_PD_SEND      = 0u,   /**< trdp_pdSendQueued()                            */
+    TRDP_STAGE_PD_TIMEOUT   = 1u,   /**< trdp_pdHandleTimeOuts()                        */
+    TRDP_STAGE_MD_SEND      = 2u,   /**< trdp_mdSend()                                  */
+    TRDP_STAGE_PD_RECEIVE   = 3u,   /**< trdp_pdCheckListenSocks()                      */
+    TRDP_STAGE_MD_RECEIVE   = 4u,   /**< trdp_mdCheckListenSocks()                      */
+    TRDP_STAGE_MD_TIMEOUT   = 5u,   /**< trdp_mdCheckTimeouts()                         */
+    TRDP_STAGE_OTHER        = 6u,   /**< metrics endpoint, history, requested trace dump */
+    TRDP_STAGE_PASS         = 7u    /**< the whole pass (lock held)                     */
+} TRDP_PROC_STAGE_T;
+
+/** Number of stages timed */
+#define TRDP_PROC_STAGES    8u
+
+/** Timing of the tlc_process() stages and overruns of the configured budgets (tlc_setProcessTiming()) */
+typedef struct
+{
+    UINT32          passBudget;             /**< Budget of a pass in us, 0 = not supervised                 */
+    UINT32          callbackBudget;         /**< Budget of a callback in us, 0 = not supervised             */
+    UINT32          numPassOverruns;        /**< Number of passes exceeding passBudget                      */
+    UINT32          numCallbackOverruns;    /**< Number of callbacks exceeding callbackBudget               */
+    UINT32          overrunTime;            /**< Last pass over budget: duration in ns                      */
+    UINT32          overrunStage;           /**< Last pass over budget: stage taking the most time          */
+    UINT32          overrunStageTime;       /**< Last pass over budget: time of that stage in ns            */
+    UINT32          callbackComId;          /**< Last callback over budget: ComId                           */
+    UINT32          callbackStage;          /**< Last callback over budget: stage calling it                */
+    UINT32          callbackTime;           /**< Last callback over budget: execution time in ns            */
+    TRDP_LAT_HIST_T stage[TRDP_PROC_STAGES]; /**< Execution time per stage (TRDP_PROC_STAGE_T)              */
+} TRDP_PROCESS_STATISTICS_T;
+
+/** Owner of the callbacks accounted in TRDP_CALLBACK_STATISTICS_T */
+#define TRDP_CB_PUBLISHER       0u      /**< pre-send callback of a publisher                       */
+#define TRDP_CB_SUBSCRIPTION    1u      /**< receive and time-out callback of a subscription        */
+#define TRDP_CB_LISTENER        2u      /**< callbacks of MD sessions accepted by a listener        */
+#define TRDP_CB_CALLER          3u      /**< callbacks of MD sessions started by the application    */
+
+/** Execution time of the callbacks of a publisher, subscription or listener */
+typedef struct
+{
+    UINT32          comId;      /**< ComId, 0 for TRDP_CB_CALLER                                            */
+    TRDP_IP_ADDR_T  addr;       /**< Publisher: destination, subscription and listener: joined address or 0 */
+    UINT32          owner;      /**< TRDP_CB_PUBLISHER, TRDP_CB_SUBSCRIPTION, TRDP_CB_LISTENER, TRDP_CB_CALLER */
+    UINT32          numCalls;   /**< Number of callbacks                                                    */
+    UINT32          numSlow;    /**< Number of callbacks exceeding the threshold (tlc_setCallbackThreshold) */
+    UINT32          maxTime;    /**< Longest execution time in ns                                           */
+    UINT64          totalTime;  /**< Sum of all execution times in ns                                       */
+} TRDP_CALLBACK_STATISTICS_T;
+
+/** Sequence counter analysis of one sender of a subscription */
+typedef struct
+{
+    TRDP_IP_ADDR_T  srcIpAddr;      /**< Source IP address                                                  */
+    TRDP_MSG_T      msgType;        /**< Message type (Pd or Pp)                                            */
+    UINT32          lastSeqCnt;     /**< Highest sequence counter received                                  */
+    UINT32          numRcv;         /**< Number of accepted packets                                         */
+    UINT32          numLost;        /**< Number of missing sequence counters (late packets are deducted)    */
+    UINT32          lossRate;       /**< numLost / (numRcv + numLost) in ppm                                */
+    UINT32          numBursts;      /**< Number of gaps of one or more missing packets                      */
+    UINT32          maxBurst;       /**< Longest gap in packets                                             */
+    UINT32          numReordered;   /**< Late packets counted as lost before (ignored by the stack)         */
+    UINT32          numDuplicate;   /**< Packets received twice (ignored by the stack)                      */
+} TRDP_SOURCE_STATISTICS_T;
+
 
 /** Information about a particular MD listener */
 typedef struct
@@ -496,6 +630,107 @@ typedef struct
 } TRDP_RED_STATISTICS_T;
 
 
+/**********************************************************************************************************************/
+/**                          TRDP event trace definitions.                                                            */
+/**********************************************************************************************************************/
+
+#define TRDP_TRACE_MAGIC        "TRDPTRC"   /**< Start of a trace dump file (incl. terminating zero)              */
+#define TRDP_TRACE_VERSION      1u          /**< Version of the trace dump file layout                            */
+
+/** Events recorded by the trace ring    */
+typedef enum
+{
+    TRDP_TRACE_NONE             = 0u,   /**< unused record                                              */
+    TRDP_TRACE_PD_RX            = 1u,   /**< PD received: comId, seqCnt, arg = source IP                */
+    TRDP_TRACE_PD_TX            = 2u,   /**< PD sent: comId, seqCnt, arg = destination IP               */
+    TRDP_TRACE_PD_TIMEOUT       = 3u,   /**< PD subscription timed out: comId, arg = source IP          */
+    TRDP_TRACE_MD_RX            = 4u,   /**< MD received: comId, seqCnt, arg = message type             */
+    TRDP_TRACE_MD_TX            = 5u,   /**< MD sent: comId, seqCnt, arg = new state                    */
+    TRDP_TRACE_MD_STATE         = 6u,   /**< MD element armed: comId, arg = state (TRDP_MD_ELE_ST_T)    */
+    TRDP_TRACE_SOCK_OPEN        = 7u,   /**< Socket opened: seqCnt = socket index, arg = socket         */
+    TRDP_TRACE_SOCK_CLOSE       = 8u,   /**< Socket closed: seqCnt = socket index, arg = socket         */
+    TRDP_TRACE_PROCESS_ENTER    = 9u,   /**< tlc_process() entered                                      */
+    TRDP_TRACE_PROCESS_EXIT     = 10u   /**< tlc_process() left: arg = result                           */
+} TRDP_TRACE_EVENT_T;
+
+/** One trace record (24 bytes, host byte order)    */
+typedef struct
+{
+    INT64   time;               /**< time stamp in ns (vos_getTimeNs)   */
+    UINT32  comId;              /**< ComId or 0                         */
+    UINT32  seqCnt;             /**< sequence counter / socket index    */
+    UINT32  arg;                /**< event specific argument            */
+    UINT16  event;              /**< TRDP_TRACE_EVENT_T                 */
+    UINT16  reserved;           /**< 0                                  */
+} TRDP_TRACE_REC_T;
+
+/** Header of a trace dump file, followed by noOfRecs records, oldest first  */
+typedef struct
+{
+    CHAR8           magic[8];   /**< TRDP_TRACE_MAGIC                                   */
+    UINT32          version;    /**< TRDP_TRACE_VERSION                                 */
+    UINT32          recSize;    /**< sizeof(TRDP_TRACE_REC_T)                           */
+    UINT32          noOfRecs;   /**< number of records following                        */
+    UINT32          numLost;    /**< number of older records overwritten in the ring    */
+    TRDP_IP_ADDR_T  ownIpAddr;  /**< IP address of the session                          */
+    UINT32          reserved;   /**< 0                                                  */
+} TRDP_TRACE_HEADER_T;
+
+#define TRDP_HISTORY_MAGIC      "TRDPHST"   /**< Start of a statistics history area (incl. terminating zero)      */
+#define TRDP_HISTORY_VERSION    1u          /**< Version of the statistics history layout                         */
+
+/** Header of a statistics history area (tlc_openHistory()), followed by noOfSamples samples.
+ *  The newest sample is at index (numWritten - 1) % noOfSamples. All values in host byte order. */
+typedef struct
+{
+    CHAR8           magic[8];       /**< TRDP_HISTORY_MAGIC                                         */
+    UINT32          version;        /**< TRDP_HISTORY_VERSION                                       */
+    UINT32          headerSize;     /**< sizeof(TRDP_HISTORY_HEADER_T), offset of the first sample  */
+    UINT32          sampleSize;     /**< sizeof(TRDP_HISTORY_SAMPLE_T)                              */
+    UINT32          noOfSamples;    /**< size of the ring in samples                                */
+    UINT32          interval;       /**< sample interval in ms                                      */
+    UINT32          numWritten;     /**< number of samples written since the area was created       */
+    TRDP_IP_ADDR_T  ownIpAddr;      /**< IP address of the session                                  */
+    UINT32          reserved;       /**< 0                                                          */
+} TRDP_HISTORY_HEADER_T;
+
+/** One sample of the session counters. Counters are running totals, rates are the difference of two samples.
+ *  'seq' is 0 while the sample is written, a reader copies a sample and checks 'seq' did not change. */
+typedef struct
+{
+    UINT32  seq;                    /**< number of the sample (numWritten after writing it)         */
+    UINT32  timeSec;                /**< time stamp, seconds (vos_getTime, for the rates)           */
+    UINT32  timeUsec;               /**< time stamp, microseconds                                   */
+    UINT32  wallTime;               /**< calendar time in seconds since 1970 (time())               */
+    UINT32  upTime;                 /**< time in sec since session opened                           */
+    UINT32  pdNumRcv;               /**< received PD packets                                        */
+    UINT32  pdNumSend;              /**< sent PD packets                                            */
+    UINT32  pdNumMissed;            /**< PD packets skipped (sequence gaps)                         */
+    UINT32  pdNumTimeout;           /**< PD timeouts                                                */
+    UINT32  pdNumCrcErr;            /**< received PD packets with CRC error                         */
+    UINT32  pdNumProtErr;           /**< received PD packets with protocol error                    */
+    UINT32  pdNumTopoErr;           /**< received PD packets with wrong topo count                  */
+    UINT32  pdNumNoSubs;            /**< received PD packets without subscription                   */
+    UINT32  mdNumRcv;               /**< received MD packets (UDP and TCP)                          */
+    UINT32  mdNumSend;              /**< sent MD packets (UDP and TCP)                              */
+    UINT32  mdNumErr;               /**< received MD packets with CRC, protocol or topo count error */
+    UINT32  mdNumNoListener;        /**< received MD packets without listener                       */
+    UINT32  mdNumReplyTimeout;      /**< MD reply timeouts                                          */
+    UINT32  mdNumConfirmTimeout;    /**< MD confirm timeouts                                        */
+    UINT32  memFree;                /**< free memory                                                */
+    UINT32  memMinFree;             /**< minimal free memory in statistics interval                 */
+    UINT32  memNumAllocErr;         /**< allocation errors                                          */
+    UINT32  numPasses;              /**< tlc_process() passes timed (tlc_setProcessTiming())        */
+    UINT32  passMax;                /**< longest pass in ns since the previous sample               */
+    UINT32  numPassOverruns;        /**< passes exceeding the pass budget                           */
+    UINT32  numCallbackOverruns;    /**< callbacks exceeding the callback budget                    */
+    UINT32  numSlowCallbacks;       /**< callbacks above the threshold (tlc_setCallbackThreshold()) */
+    UINT32  numLatency;             /**< subscription latencies recorded (TRDP_OPTION_LATENCY_STATS) */
+    UINT64  passTime;               /**< sum of the pass times in ns                                */
+    UINT64  latencySum;             /**< sum of the subscription latencies in ns                    */
+} TRDP_HISTORY_SAMPLE_T;
+
+
 typedef struct TRDP_SESSION *TRDP_APP_SESSION_T;
 typedef struct PD_ELE *TRDP_PUB_T;
 typedef struct PD_ELE *TRDP_SUB_T;
@@ -620,6 +855,44 @@ typedef struct
 } TRDP_PD_CONFIG_T;
 
 
+/**********************************************************************************************************************/
+/** Publisher descriptor for tlp_publishBatch, the members correspond to the parameters of tlp_publish  */
+typedef struct
+{
+    const void              *pUserRef;          /**< user supplied value returned within the info structure */
+    TRDP_PD_CALLBACK_T      pfCbFunction;       /**< pre-send callback function, NULL if not used           */
+    UINT32                  comId;              /**< comId of packet to send                                */
+    UINT32                  etbTopoCnt;         /**< ETB topocount to use, 0 if consist local communication */
+    UINT32                  opTrnTopoCnt;       /**< operational topocount                                  */
+    TRDP_IP_ADDR_T          srcIpAddr;          /**< own IP address, 0 - srcIP will be set by the stack     */
+    TRDP_IP_ADDR_T          destIpAddr;         /**< where to send the packet to                            */
+    UINT32                  interval;           /**< frequency of PD packet (>= 10ms) in usec, 0 - PULL     */
+    UINT32                  redId;              /**< 0 - Non-redundant, > 0 valid redundancy group          */
+    TRDP_FLAGS_T            pktFlags;           /**< packet flags                                           */
+    const TRDP_SEND_PARAM_T *pSendParam;        /**< send parameters, NULL - default parameters are used    */
+    const UINT8             *pData;             /**< initial data, NULL if sending starts with tlp_put()    */
+    UINT32                  dataSize;           /**< size of initial data                                   */
+} TRDP_PUB_DESC_T;
+
+
+/**********************************************************************************************************************/
+/** Subscriber descriptor for tlp_subscribeBatch, the members correspond to the parameters of tlp_subscribe  */
+typedef struct
+{
+    const void              *pUserRef;          /**< user supplied value returned within the info structure */
+    TRDP_PD_CALLBACK_T      pfCbFunction;       /**< callback function, NULL to use default function        */
+    UINT32                  comId;              /**< comId of packet to receive                             */
+    UINT32                  etbTopoCnt;         /**< ETB topocount to use, 0 if consist local communication */
+    UINT32                  opTrnTopoCnt;       /**< operational topocount                                  */
+    TRDP_IP_ADDR_T          srcIpAddr1;         /**< source IP address, lower address of a range, or 0      */
+    TRDP_IP_ADDR_T          srcIpAddr2;         /**< upper address of a range, or 0                         */
+    TRDP_IP_ADDR_T          destIpAddr;         /**< IP address to join                                     */
+    TRDP_FLAGS_T            pktFlags;           /**< packet flags                                           */
+    UINT32                  timeout;            /**< timeout (>= 10ms) in usec, 0 - default timeout         */
+    TRDP_TO_BEHAVIOR_T      toBehavior;         /**< timeout behavior                                       */
+} TRDP_SUB_DESC_T;
+
+
 /**********************************************************************************************************************/
 /**    Callback for receiving indications, timeouts, releases, responses.
  *
@@ -686,6 +959,15 @@ typedef struct
                                                   Default: Allow                                            */
 #define TRDP_OPTION_NO_UDP_CHK          0x10u   /**< Suppress UDP CRC generation
                                                   Default: Compute UDP CRC                                  */
+#define TRDP_OPTION_PRECISE_WAIT        0x20u   /**< tlc_getInterval returns the interval shortened by a guard
+                                                  band, tlc_process spins until the due time
+                                                  Default: OFF                                              */
+#define TRDP_OPTION_LATENCY_STATS       0x40u   /**< Record latency histograms per publisher and subscription
+                                                  (tlc_getLatencyStatistics)
+                                                  Default: OFF                                              */
+#define TRDP_OPTION_CALLBACK_STATS      0x80u   /**< Measure the execution time of every callback
+                                                  (tlc_getCallbackStatistics, tlc_setCallbackThreshold)
+                                                  Default: OFF                                              */
 typedef UINT8 TRDP_OPTION_T;
 
 /**********************************************************************************************************************/
@@ -0,0 +1,644 @@
+/******************************************************************************/
+/**
+ * @file            tau_cfg_index.c
+ *
+ * @brief           Indexed access to a parsed configuration
+ *
+ * @details         The configuration read from XML is a set of flat arrays in document order. The index hashes
+ *                  interfaces by name, telegrams by interface and comId, datasets by datasetId and the
+ *                  ComId DatasetId mapping by comId into open addressing tables (linear probing, at most half
+ *                  filled), so every lookup is done in constant time instead of a search through the arrays.
+ *                  All tables and entries are held in one block, allocated once when the index is built.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/*******************************************************************************
+ * INCLUDES
+ */
+#include <string.h>
+#include <stdlib.h>
+
+#include "trdp_types.h"
+#include "trdp_utils.h"
+#include "tau_cfg_index.h"
+
+/*******************************************************************************
+ * DEFINES
+ */
+
+#define TAU_CFG_EMPTY       0u      /**< Unused slot, slots hold the entry number + 1   */
+#define TAU_CFG_MIN_SLOTS   4u      /**< Minimal size of a hash table                   */
+
+/*******************************************************************************
+ * TYPEDEFS
+ */
+
+/** Hash table, the size is a power of two */
+typedef struct
+{
+    UINT32  mask;                   /**< number of slots - 1                            */
+    UINT32  *pSlot;                 /**< entry number + 1, TAU_CFG_EMPTY if unused      */
+} TAU_CFG_TABLE_T;
+
+/** Indexed interface */
+typedef struct
+{
+    TRDP_LABEL_T        ifName;     /**< interface name                                 */
+    UINT32              hash;       /**< hash of the name                               */
+    UINT32              numExchgPar;    /**< number of telegrams of the interface       */
+    TRDP_EXCHG_PAR_T    *pExchgPar; /**< telegrams of the interface                     */
+    UINT32              firstTlg;   /**< number of the first telegram in the index      */
+} TAU_CFG_IF_T;
+
+/** Indexed telegram */
+typedef struct
+{
+    UINT32              comId;      /**< comId                                          */
+    UINT32              ifIndex;    /**< interface                                      */
+    UINT32              next;       /**< next telegram with same comId on the interface
+                                         (number + 1), TAU_CFG_EMPTY if none            */
+    TRDP_EXCHG_PAR_T    *pExchgPar; /**< exchange parameters                            */
+} TAU_CFG_TLG_T;
+
+/** Indexed dataset, by datasetId or by comId */
+typedef struct
+{
+    UINT32              key;        /**< datasetId or comId                             */
+    TRDP_DATASET_T      *pDataset;  /**< dataset, NULL if a comId maps to an unknown one */
+} TAU_CFG_DS_T;
+
+/** Configuration index */
+struct TAU_CFG_INDEX
+{
+    UINT32              numIf;      /**< number of interfaces                           */
+    TAU_CFG_IF_T        *pIf;       /**< interfaces                                     */
+    TAU_CFG_TABLE_T     ifTable;    /**< interfaces by name                             */
+    UINT32              numTlg;     /**< number of telegrams                            */
+    TAU_CFG_TLG_T       *pTlg;      /**< telegrams of all interfaces                    */
+    TAU_CFG_TABLE_T     tlgTable;   /**< telegrams by interface and comId               */
+    UINT32              numDataset; /**< number of datasets                             */
+    TAU_CFG_DS_T        *pDataset;  /**< datasets                                       */
+    TAU_CFG_TABLE_T     dsTable;    /**< datasets by datasetId                          */
+    UINT32              numComId;   /**< number of comId mappings                       */
+    TAU_CFG_DS_T        *pComId;    /**< datasets by comId                              */
+    TAU_CFG_TABLE_T     comIdTable; /**< comId mappings by comId                        */
+};
+
+/******************************************************************************
+ *   Locals
+ */
+
+/**********************************************************************************************************************/
+/** Hash of a number, mixes all bits into the low ones used as table position.
+ *
+ *  @param[in]      key             number
+ *
+ *  @retval         hash
+ */
+static UINT32 cfgHash (
+    UINT32 key)
+{
+    key ^= key >> 16u;
+    key *= 0x7FEB352Du;
+    key ^= key >> 15u;
+    key *= 0x846CA68Bu;
+    key ^= key >> 16u;
+    return key;
+}
+
+/**********************************************************************************************************************/
+/** Hash of an interface name (FNV-1a).
+ *
+ *  @param[in]      pName           name
+ *
+ *  @retval         hash
+ */
+static UINT32 cfgNameHash (
+    const CHAR8 *pName)
+{
+    UINT32 hash = 2166136261u;
+    UINT32 i;
+
+    for (i = 0u; (i < TRDP_MAX_LABEL_LEN) && (pName[i] != 0); i++)
+    {
+        hash ^= (UINT8) pName[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**********************************************************************************************************************/
+/** Hash of a telegram key.
+ *
+ *  @param[in]      ifIndex         interface
+ *  @param[in]      comId           comId
+ *
+ *  @retval         hash
+ */
+static UINT32 cfgTlgHash (
+    UINT32  ifIndex,
+    UINT32  comId)
+{
+    return cfgHash(comId ^ (ifIndex * 0x9E3779B9u));
+}
+
+/**********************************************************************************************************************/
+/** Number of slots of a table for a number of entries: power of two, at most half filled.
+ *
+ *  @param[in]      count           number of entries
+ *
+ *  @retval         number of slots
+ */
+static UINT32 cfgTableSize (
+    UINT32 count)
+{
+    UINT32 size = TAU_CFG_MIN_SLOTS;
+
+    while (size < 2u * count)
+    {
+        size <<= 1u;
+    }
+    return size;
+}
+
+/**********************************************************************************************************************/
+/** Find the slot of an interface name, or the free slot it goes into.
+ *
+ *  @param[in]      pIndex          index
+ *  @param[in]      pIfName         name
+ *  @param[in]      hash            hash of the name
+ *
+ *  @retval         pointer to the slot
+ */
+static UINT32 *cfgIfSlot (
+    const struct TAU_CFG_INDEX  *pIndex,
+    const CHAR8                 *pIfName,
+    UINT32                      hash)
+{
+    UINT32 pos = hash & pIndex->ifTable.mask;
+
+    while (pIndex->ifTable.pSlot[pos] != TAU_CFG_EMPTY)
+    {
+        const TAU_CFG_IF_T *pIf = &pIndex->pIf[pIndex->ifTable.pSlot[pos] - 1u];
+
+        if ((pIf->hash == hash) && (strncmp(pIf->ifName, pIfName, TRDP_MAX_LABEL_LEN) == 0))
+        {
+            break;
+        }
+        pos = (pos + 1u) & pIndex->ifTable.mask;
+    }
+    return &pIndex->ifTable.pSlot[pos];
+}
+
+/**********************************************************************************************************************/
+/** Find the slot of a telegram, or the free slot it goes into.
+ *
+ *  @param[in]      pIndex          index
+ *  @param[in]      ifIndex         interface
+ *  @param[in]      comId           comId
+ *
+ *  @retval         pointer to the slot
+ */
+static UINT32 *cfgTlgSlot (
+    const struct TAU_CFG_INDEX  *pIndex,
+    UINT32                      ifIndex,
+    UINT32                      comId)
+{
+    UINT32 pos = cfgTlgHash(ifIndex, comId) & pIndex->tlgTable.mask;
+
+    while (pIndex->tlgTable.pSlot[pos] != TAU_CFG_EMPTY)
+    {
+        const TAU_CFG_TLG_T *pTlg = &pIndex->pTlg[pIndex->tlgTable.pSlot[pos] - 1u];
+
+        if ((pTlg->comId == comId) && (pTlg->ifIndex == ifIndex))
+        {
+            break;
+        }
+        pos = (pos + 1u) & pIndex->tlgTable.mask;
+    }
+    return &pIndex->tlgTable.pSlot[pos];
+}
+
+/**********************************************************************************************************************/
+/** Find the slot of a dataset or comId mapping, or the free slot it goes into.
+ *
+ *  @param[in]      pTable          table
+ *  @param[in]      pEntry          entries of the table
+ *  @param[in]      key             datasetId or comId
+ *
+ *  @retval         pointer to the slot
+ */
+static UINT32 *cfgDsSlot (
+    const TAU_CFG_TABLE_T   *pTable,
+    const TAU_CFG_DS_T      *pEntry,
+    UINT32                  key)
+{
+    UINT32 pos = cfgHash(key) & pTable->mask;
+
+    while ((pTable->pSlot[pos] != TAU_CFG_EMPTY) &&
+           (pEntry[pTable->pSlot[pos] - 1u].key != key))
+    {
+        pos = (pos + 1u) & pTable->mask;
+    }
+    return &pTable->pSlot[pos];
+}
+
+/**********************************************************************************************************************/
+/** Find the first telegram entry of a comId on an interface.
+ *
+ *  @param[in]      pIndex          index
+ *  @param[in]      pIfName         interface name
+ *  @param[in]      comId           comId
+ *
+ *  @retval         telegram entry, NULL if not configured
+ */
+static const TAU_CFG_TLG_T *cfgFindTlg (
+    const struct TAU_CFG_INDEX  *pIndex,
+    const CHAR8                 *pIfName,
+    UINT32                      comId)
+{
+    UINT32 ifIndex;
+    UINT32 slot;
+
+    if (tau_findInterface((TAU_CFG_INDEX_T) pIndex, pIfName, &ifIndex) != TRDP_NO_ERR)
+    {
+        return NULL;
+    }
+    slot = *cfgTlgSlot(pIndex, ifIndex, comId);
+    return (slot == TAU_CFG_EMPTY) ? NULL : &pIndex->pTlg[slot - 1u];
+}
+
+/******************************************************************************
+ *   Globals
+ */
+
+/**********************************************************************************************************************/
+/**    Build the index of a configuration.
+ *
+ *  @param[in]      pConfig           Configuration, e.g. from tau_readXmlConfig or tau_loadConfig
+ *  @param[out]     pIndex            Index, to be released by tau_freeConfigIndex
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    parameter error
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_initConfigIndex (
+    const TRDP_XML_CONFIG_T *pConfig,
+    TAU_CFG_INDEX_T         *pIndex)
+{
+    struct TAU_CFG_INDEX    *pIdx;
+    UINT32  numIf   = 0u;
+    UINT32  numTlg  = 0u;
+    UINT32  numDataset;
+    UINT32  numComId;
+    UINT32  ifSlots, tlgSlots, dsSlots, comIdSlots;
+    size_t  size;
+    UINT32  i, j;
+    UINT32  *pSlot;
+
+    if ((pConfig == NULL) || (pIndex == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    *pIndex = NULL;
+
+    if ((pConfig->pIfConfig != NULL) && (pConfig->pIfSettings != NULL))
+    {
+        numIf = pConfig->numIfConfig;
+        for (i = 0u; i < numIf; i++)
+        {
+            if (pConfig->pIfSettings[i].pExchgPar != NULL)
+            {
+                numTlg += pConfig->pIfSettings[i].numExchgPar;
+            }
+        }
+    }
+    numDataset  = (pConfig->apDataset != NULL) ? pConfig->numDataset : 0u;
+    numComId    = (pConfig->pComIdDsIdMap != NULL) ? pConfig->numComId : 0u;
+
+    ifSlots     = cfgTableSize(numIf);
+    tlgSlots    = cfgTableSize(numTlg);
+    dsSlots     = cfgTableSize(numDataset);
+    comIdSlots  = cfgTableSize(numComId);
+
+    /*  Entries first (they hold pointers), the slot arrays behind. The index grows with the configuration and
+        may exceed the largest block of the VOS memory pool, it is held on the heap  */
+    size = sizeof(struct TAU_CFG_INDEX) +
+        numIf * sizeof(TAU_CFG_IF_T) +
+        numTlg * sizeof(TAU_CFG_TLG_T) +
+        (numDataset + numComId) * sizeof(TAU_CFG_DS_T) +
+        ((size_t) ifSlots + tlgSlots + dsSlots + comIdSlots) * sizeof(UINT32);
+    pIdx = (struct TAU_CFG_INDEX *) calloc(1u, size);
+    if (pIdx == NULL)
+    {
+        vos_printLog(VOS_LOG_ERROR, "tau_initConfigIndex: out of memory (%lu bytes)\n", (unsigned long) size);
+        return TRDP_MEM_ERR;
+    }
+    pIdx->pIf               = (TAU_CFG_IF_T *) (pIdx + 1);
+    pIdx->pTlg              = (TAU_CFG_TLG_T *) (pIdx->pIf + numIf);
+    pIdx->pDataset          = (TAU_CFG_DS_T *) (pIdx->pTlg + numTlg);
+    pIdx->pComId            = pIdx->pDataset + numDataset;
+    pIdx->ifTable.pSlot     = (UINT32 *) (pIdx->pComId + numComId);
+    pIdx->ifTable.mask      = ifSlots - 1u;
+    pIdx->tlgTable.pSlot    = pIdx->ifTable.pSlot + ifSlots;
+    pIdx->tlgTable.mask     = tlgSlots - 1u;
+    pIdx->dsTable.pSlot     = pIdx->tlgTable.pSlot + tlgSlots;
+    pIdx->dsTable.mask      = dsSlots - 1u;
+    pIdx->comIdTable.pSlot  = pIdx->dsTable.pSlot + dsSlots;
+    pIdx->comIdTable.mask   = comIdSlots - 1u;
+
+    /*  Interfaces, the first one of a name is found  */
+    for (i = 0u; i < numIf; i++)
+    {
+        TAU_CFG_IF_T *pIf = &pIdx->pIf[i];
+
+        vos_strncpy(pIf->ifName, pConfig->pIfConfig[i].ifName, TRDP_MAX_LABEL_LEN - 1u);
+        pIf->hash       = cfgNameHash(pIf->ifName);
+        pIf->firstTlg   = pIdx->numTlg;
+        if (pConfig->pIfSettings[i].pExchgPar != NULL)
+        {
+            pIf->numExchgPar    = pConfig->pIfSettings[i].numExchgPar;
+            pIf->pExchgPar      = pConfig->pIfSettings[i].pExchgPar;
+        }
+        for (j = 0u; j < pIf->numExchgPar; j++)
+        {
+            pIdx->pTlg[pIdx->numTlg + j].comId      = pIf->pExchgPar[j].comId;
+            pIdx->pTlg[pIdx->numTlg + j].ifIndex    = i;
+            pIdx->pTlg[pIdx->numTlg + j].pExchgPar  = &pIf->pExchgPar[j];
+        }
+        pIdx->numTlg += pIf->numExchgPar;
+
+        pSlot = cfgIfSlot(pIdx, pIf->ifName, pIf->hash);
+        if (*pSlot == TAU_CFG_EMPTY)
+        {
+            *pSlot = i + 1u;
+        }
+    }
+    pIdx->numIf = numIf;
+
+    /*  Telegrams, inserted backwards so the chain of a comId follows the configuration order  */
+    for (i = pIdx->numTlg; i > 0u; i--)
+    {
+        TAU_CFG_TLG_T *pTlg = &pIdx->pTlg[i - 1u];
+
+        pSlot       = cfgTlgSlot(pIdx, pTlg->ifIndex, pTlg->comId);
+        pTlg->next  = *pSlot;
+        *pSlot      = i;
+    }
+
+    /*  Datasets, the first one of an id is found  */
+    for (i = 0u; i < numDataset; i++)
+    {
+        if (pConfig->apDataset[i] == NULL)
+        {
+            continue;
+        }
+        pSlot = cfgDsSlot(&pIdx->dsTable, pIdx->pDataset, pConfig->apDataset[i]->id);
+        if (*pSlot == TAU_CFG_EMPTY)
+        {
+            pIdx->pDataset[pIdx->numDataset].key        = pConfig->apDataset[i]->id;
+            pIdx->pDataset[pIdx->numDataset].pDataset   = pConfig->apDataset[i];
+            pIdx->numDataset++;
+            *pSlot = pIdx->numDataset;
+        }
+    }
+
+    /*  ComId mapping, resolved to the dataset now  */
+    for (i = 0u; i < numComId; i++)
+    {
+        pSlot = cfgDsSlot(&pIdx->comIdTable, pIdx->pComId, pConfig->pComIdDsIdMap[i].comId);
+        if (*pSlot == TAU_CFG_EMPTY)
+        {
+            pIdx->pComId[pIdx->numComId].key        = pConfig->pComIdDsIdMap[i].comId;
+            pIdx->pComId[pIdx->numComId].pDataset   = tau_findDataset(pIdx, pConfig->pComIdDsIdMap[i].datasetId);
+            pIdx->numComId++;
+            *pSlot = pIdx->numComId;
+        }
+    }
+
+    *pIndex = pIdx;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Release an index built by tau_initConfigIndex
+ *
+ *  @param[in]      index             Index, NULL: nothing to do
+ *
+ */
+EXT_DECL void tau_freeConfigIndex (
+    TAU_CFG_INDEX_T index)
+{
+    free(index);
+}
+
+/**********************************************************************************************************************/
+/**    Find an interface by its name.
+ *
+ *  @param[in]      index             Index
+ *  @param[in]      pIfName           Interface name
+ *  @param[out]     pIfIndex          Position of the interface in pIfConfig
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    interface not configured
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_findInterface (
+    TAU_CFG_INDEX_T index,
+    const CHAR8     *pIfName,
+    UINT32          *pIfIndex)
+{
+    UINT32 slot;
+
+    if ((index == NULL) || (pIfName == NULL) || (pIfIndex == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    slot = *cfgIfSlot(index, pIfName, cfgNameHash(pIfName));
+    if (slot == TAU_CFG_EMPTY)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    *pIfIndex = slot - 1u;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Find the exchange parameters of a telegram.
+ *
+ *  @param[in]      index             Index
+ *  @param[in]      pIfName           Interface name
+ *  @param[in]      comId             ComId of the telegram
+ *  @param[in]      pPrev             Previous result or NULL
+ *
+ *  @retval         pointer to the exchange parameters, NULL if there are no (more)
+ *
+ */
+EXT_DECL TRDP_EXCHG_PAR_T *tau_findExchgPar (
+    TAU_CFG_INDEX_T         index,
+    const CHAR8             *pIfName,
+    UINT32                  comId,
+    const TRDP_EXCHG_PAR_T  *pPrev)
+{
+    const TAU_CFG_TLG_T *pTlg;
+    const TAU_CFG_IF_T  *pIf;
+    UINT32              ifIndex;
+
+    if (pPrev == NULL)
+    {
+        pTlg = cfgFindTlg(index, pIfName, comId);
+        return (pTlg == NULL) ? NULL : pTlg->pExchgPar;
+    }
+    if (tau_findInterface(index, pIfName, &ifIndex) != TRDP_NO_ERR)
+    {
+        return NULL;
+    }
+
+    /*  The position of the previous result in the interface's array gives its entry  */
+    pIf = &index->pIf[ifIndex];
+    if ((pPrev < pIf->pExchgPar) || (pPrev >= pIf->pExchgPar + pIf->numExchgPar))
+    {
+        return NULL;
+    }
+    pTlg = &index->pTlg[pIf->firstTlg + (UINT32) (pPrev - pIf->pExchgPar)];
+    if ((pTlg->comId != comId) || (pTlg->next == TAU_CFG_EMPTY))
+    {
+        return NULL;
+    }
+    return index->pTlg[pTlg->next - 1u].pExchgPar;
+}
+
+/**********************************************************************************************************************/
+/**    Find the destinations of a telegram (of its first configuration on the interface).
+ *
+ *  @param[in]      index             Index
+ *  @param[in]      pIfName           Interface name
+ *  @param[in]      comId             ComId of the telegram
+ *  @param[out]     pDestCnt          Number of destinations
+ *  @param[out]     ppDest            Array of destinations
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    parameter error or interface not configured
+ *  @retval         TRDP_COMID_ERR    comId not configured on this interface
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_findDestinations (
+    TAU_CFG_INDEX_T index,
+    const CHAR8     *pIfName,
+    UINT32          comId,
+    UINT32          *pDestCnt,
+    TRDP_DEST_T     * *ppDest)
+{
+    const TAU_CFG_TLG_T *pTlg;
+    UINT32              ifIndex;
+
+    if ((pDestCnt == NULL) || (ppDest == NULL) ||
+        (tau_findInterface(index, pIfName, &ifIndex) != TRDP_NO_ERR))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    pTlg = cfgFindTlg(index, pIfName, comId);
+    if (pTlg == NULL)
+    {
+        return TRDP_COMID_ERR;
+    }
+    *pDestCnt   = pTlg->pExchgPar->destCnt;
+    *ppDest     = pTlg->pExchgPar->pDest;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Find the sources of a telegram (of its first configuration on the interface).
+ *
+ *  @param[in]      index             Index
+ *  @param[in]      pIfName           Interface name
+ *  @param[in]      comId             ComId of the telegram
+ *  @param[out]     pSrcCnt           Number of sources
+ *  @param[out]     ppSrc             Array of sources
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    parameter error or interface not configured
+ *  @retval         TRDP_COMID_ERR    comId not configured on this interface
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_findSources (
+    TAU_CFG_INDEX_T index,
+    const CHAR8     *pIfName,
+    UINT32          comId,
+    UINT32          *pSrcCnt,
+    TRDP_SRC_T      * *ppSrc)
+{
+    const TAU_CFG_TLG_T *pTlg;
+    UINT32              ifIndex;
+
+    if ((pSrcCnt == NULL) || (ppSrc == NULL) ||
+        (tau_findInterface(index, pIfName, &ifIndex) != TRDP_NO_ERR))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    pTlg = cfgFindTlg(index, pIfName, comId);
+    if (pTlg == NULL)
+    {
+        return TRDP_COMID_ERR;
+    }
+    *pSrcCnt    = pTlg->pExchgPar->srcCnt;
+    *ppSrc      = pTlg->pExchgPar->pSrc;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Find a dataset by its id.
+ *
+ *  @param[in]      index             Index
+ *  @param[in]      datasetId         Dataset Id
+ *
+ *  @retval         pointer to the dataset, NULL if not configured
+ *
+ */
+EXT_DECL TRDP_DATASET_T *tau_findDataset (
+    TAU_CFG_INDEX_T index,
+    UINT32          datasetId)
+{
+    UINT32 slot;
+
+    if (index == NULL)
+    {
+        return NULL;
+    }
+    slot = *cfgDsSlot(&index->dsTable, index->pDataset, datasetId);
+    return (slot == TAU_CFG_EMPTY) ? NULL : index->pDataset[slot - 1u].pDataset;
+}
+
+/**********************************************************************************************************************/
+/**    Find the dataset of a comId through the ComId DatasetId mapping.
+ *
+ *  @param[in]      index             Index
+ *  @param[in]      comId             ComId
+ *
+ *  @retval         pointer to the dataset, NULL if comId or its dataset are not configured
+ *
+ */
+EXT_DECL TRDP_DATASET_T *tau_findComIdDataset (
+    TAU_CFG_INDEX_T index,
+    UINT32          comId)
+{
+    UINT32 slot;
+
+    if (index == NULL)
+    {
+        return NULL;
+    }
+    slot = *cfgDsSlot(&index->comIdTable, index->pComId, comId);
+    return (slot == TAU_CFG_EMPTY) ? NULL : index->pComId[slot - 1u].pDataset;
+}
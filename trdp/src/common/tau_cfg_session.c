@@ -0,0 +1,1280 @@
+/******************************************************************************/
+/**
+ * @file            tau_cfg_session.c
+ *
+ * @brief           Telegrams of a configuration, reloadable while the sessions are running
+ *
+ * @details         The publishers, subscribers and listeners of a configuration are kept in a list sorted by their
+ *                  identity (kind, interface, comId, addresses). A reload builds the list of the new configuration
+ *                  the same way and walks both lists side by side: equal entries keep their handles, the rest is
+ *                  created or deleted. Creation uses tlp_publishBatch and tlp_subscribeBatch per interface, so the
+ *                  sockets are requested and the traffic shaping is computed once for all new telegrams.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/*******************************************************************************
+ * INCLUDES
+ */
+#include <string.h>
+#include <stdlib.h>
+
+#include "trdp_types.h"
+#include "trdp_if_light.h"
+#include "trdp_utils.h"
+#include "tau_marshall.h"
+#include "tau_cfg_index.h"
+#include "tau_cfg_session.h"
+
+/*******************************************************************************
+ * DEFINES
+ */
+
+#define TAU_CFG_NO_IF   0xFFFFFFFFu     /**< Interface without session                          */
+
+/*******************************************************************************
+ * TYPEDEFS
+ */
+
+/** Kind of a configured object, the primary sort key */
+typedef enum
+{
+    TAU_CFG_PUB = 0,                    /**< publisher                                          */
+    TAU_CFG_SUB = 1,                    /**< subscriber                                         */
+    TAU_CFG_LIS = 2                     /**< MD listener                                        */
+} TAU_CFG_KIND_T;
+
+/** Action of a reload on an object */
+typedef enum
+{
+    TAU_CFG_KEEP    = 0,                /**< unchanged                                          */
+    TAU_CFG_CREATE  = 1,                /**< new or modified (new list)                         */
+    TAU_CFG_DELETE  = 2,                /**< removed (old list)                                 */
+    TAU_CFG_REPLACE = 3                 /**< modified, deleted before the new one is created (old list) */
+} TAU_CFG_ACTION_T;
+
+/** Parameters of an object, compared on reload. Unused members stay zero */
+typedef struct
+{
+    UINT32              interval;       /**< publisher: cycle time                              */
+    UINT32              redId;          /**< publisher: redundancy group                        */
+    UINT32              datasetId;      /**< publisher: dataset                                 */
+    TRDP_SEND_PARAM_T   sendParam;      /**< publisher: send parameters                         */
+    UINT32              timeout;        /**< subscriber: timeout                                */
+    TRDP_TO_BEHAVIOR_T  toBehavior;     /**< subscriber: timeout behavior                       */
+    TRDP_FLAGS_T        flags;          /**< packet flags                                       */
+} TAU_CFG_PAR_T;
+
+/** Configured object */
+typedef struct
+{
+    TAU_CFG_KIND_T      kind;           /**< publisher, subscriber or listener                  */
+    UINT32              ifIndex;        /**< interface (position in the handle table)           */
+    UINT32              comId;          /**< comId                                              */
+    TRDP_IP_ADDR_T      addr[3];        /**< publisher: destination, 0, 0;
+                                             subscriber, listener: sources, multicast group     */
+    TAU_CFG_PAR_T       par;            /**< parameters                                         */
+    TAU_CFG_ACTION_T    action;         /**< action of the current reload                       */
+    union
+    {
+        TRDP_PUB_T      pub;
+        TRDP_SUB_T      sub;
+        TRDP_LIS_T      lis;
+        void            *any;
+    } handle;                           /**< handle, NULL if not created                        */
+} TAU_CFG_TLG_T;
+
+/** Descriptors and handles of the batches of cfgCreate */
+typedef struct
+{
+    TRDP_PUB_DESC_T     *pPubDesc;      /**< publisher descriptors                              */
+    TRDP_SUB_DESC_T     *pSubDesc;      /**< subscriber descriptors                             */
+    TAU_CFG_TLG_T       * *ppTlg;       /**< objects of the batch                               */
+    TRDP_PUB_T          *pPubHandle;    /**< returned publisher handles                         */
+    TRDP_SUB_T          *pSubHandle;    /**< returned subscriber handles                        */
+} TAU_CFG_BATCH_T;
+
+/** Configured set of telegrams */
+struct TAU_CFG_SESSION
+{
+    UINT32              numIf;          /**< number of interfaces                               */
+    TRDP_APP_SESSION_T  *pAppHandle;    /**< sessions of the interfaces                         */
+    TRDP_LABEL_T        *pIfName;       /**< names of the interfaces                            */
+    const void          *pUserRef;      /**< user reference of all objects                      */
+    TRDP_PD_CALLBACK_T  pfPdCallback;   /**< PD callback                                        */
+    TRDP_MD_CALLBACK_T  pfMdCallback;   /**< MD callback                                        */
+    BOOL8               createAll;      /**< ignore the create attribute                        */
+    TRDP_XML_CONFIG_T   config;         /**< running configuration                              */
+    TAU_CFG_INDEX_T     index;          /**< index of the running configuration, NULL if none   */
+    UINT32              numTlg;         /**< number of objects                                  */
+    TAU_CFG_TLG_T       *pTlg;          /**< objects, sorted by cfgCompare                      */
+};
+
+/******************************************************************************
+ *   Locals
+ */
+
+/**********************************************************************************************************************/
+/** Order of the objects: kind, interface, comId, addresses
+ *
+ *  @param[in]      pArg1       object
+ *  @param[in]      pArg2       object
+ *
+ *  @retval         -1 / 0 / 1
+ */
+static int cfgCompare (
+    const void  *pArg1,
+    const void  *pArg2)
+{
+    const TAU_CFG_TLG_T *p1 = (const TAU_CFG_TLG_T *) pArg1;
+    const TAU_CFG_TLG_T *p2 = (const TAU_CFG_TLG_T *) pArg2;
+    UINT32              i;
+
+    if (p1->kind != p2->kind)
+    {
+        return (p1->kind < p2->kind) ? -1 : 1;
+    }
+    if (p1->ifIndex != p2->ifIndex)
+    {
+        return (p1->ifIndex < p2->ifIndex) ? -1 : 1;
+    }
+    if (p1->comId != p2->comId)
+    {
+        return (p1->comId < p2->comId) ? -1 : 1;
+    }
+    for (i = 0u; i < 3u; i++)
+    {
+        if (p1->addr[i] != p2->addr[i])
+        {
+            return (p1->addr[i] < p2->addr[i]) ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/**********************************************************************************************************************/
+/** Compare the parameters of two objects (member by member, the structures have padding)
+ *
+ *  @param[in]      pPar1       parameters
+ *  @param[in]      pPar2       parameters
+ *
+ *  @retval         TRUE        equal
+ *  @retval         FALSE       different
+ */
+static BOOL8 cfgParEqual (
+    const TAU_CFG_PAR_T *pPar1,
+    const TAU_CFG_PAR_T *pPar2)
+{
+    return ((pPar1->interval == pPar2->interval) &&
+            (pPar1->redId == pPar2->redId) &&
+            (pPar1->datasetId == pPar2->datasetId) &&
+            (pPar1->sendParam.qos == pPar2->sendParam.qos) &&
+            (pPar1->sendParam.ttl == pPar2->sendParam.ttl) &&
+            (pPar1->sendParam.retries == pPar2->sendParam.retries) &&
+            (pPar1->sendParam.phased == pPar2->sendParam.phased) &&
+            (pPar1->sendParam.phase == pPar2->sendParam.phase) &&
+            (pPar1->timeout == pPar2->timeout) &&
+            (pPar1->toBehavior == pPar2->toBehavior) &&
+            (pPar1->flags == pPar2->flags)) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Compare the layout of a dataset in two configurations (element types and sizes, nested datasets included)
+ *
+ *  @param[in]      oldIndex    index of the running configuration
+ *  @param[in]      newIndex    index of the new configuration
+ *  @param[in]      datasetId   dataset
+ *  @param[in]      level       nesting level
+ *
+ *  @retval         TRUE        equal or unknown in both
+ *  @retval         FALSE       different
+ */
+static BOOL8 cfgDatasetEqual (
+    TAU_CFG_INDEX_T oldIndex,
+    TAU_CFG_INDEX_T newIndex,
+    UINT32          datasetId,
+    UINT32          level)
+{
+    const TRDP_DATASET_T    *pOld   = tau_findDataset(oldIndex, datasetId);
+    const TRDP_DATASET_T    *pNew   = tau_findDataset(newIndex, datasetId);
+    UINT32                  i;
+
+    if ((pOld == NULL) || (pNew == NULL))
+    {
+        return (pOld == pNew) ? TRUE : FALSE;
+    }
+    if ((level > TAU_MAX_DS_LEVEL) || (pOld->numElement != pNew->numElement))
+    {
+        return FALSE;
+    }
+    for (i = 0u; i < pOld->numElement; i++)
+    {
+        if ((pOld->pElement[i].type != pNew->pElement[i].type) ||
+            (pOld->pElement[i].size != pNew->pElement[i].size))
+        {
+            return FALSE;
+        }
+        if ((pOld->pElement[i].type > TRDP_TYPE_MAX) &&
+            !cfgDatasetEqual(oldIndex, newIndex, pOld->pElement[i].type, level + 1u))
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Count the added, removed, modified and kept datasets
+ *
+ *  @param[in]      oldIndex    index of the running configuration, NULL if none
+ *  @param[in]      pOld        running configuration
+ *  @param[in]      newIndex    index of the new configuration
+ *  @param[in]      pNew        new configuration
+ *  @param[out]     pChanges    counts
+ */
+static void cfgDiffDatasets (
+    TAU_CFG_INDEX_T         oldIndex,
+    const TRDP_XML_CONFIG_T *pOld,
+    TAU_CFG_INDEX_T         newIndex,
+    const TRDP_XML_CONFIG_T *pNew,
+    TAU_CFG_CHANGES_T       *pChanges)
+{
+    UINT32 i;
+
+    for (i = 0u; (pNew->apDataset != NULL) && (i < pNew->numDataset); i++)
+    {
+        /*  Only the first dataset of an id counts, like in the index  */
+        if ((pNew->apDataset[i] == NULL) ||
+            (tau_findDataset(newIndex, pNew->apDataset[i]->id) != pNew->apDataset[i]))
+        {
+            continue;
+        }
+        if (tau_findDataset(oldIndex, pNew->apDataset[i]->id) == NULL)
+        {
+            pChanges->added++;
+        }
+        else if (cfgDatasetEqual(oldIndex, newIndex, pNew->apDataset[i]->id, 0u))
+        {
+            pChanges->kept++;
+        }
+        else
+        {
+            pChanges->modified++;
+        }
+    }
+    for (i = 0u; (oldIndex != NULL) && (pOld->apDataset != NULL) && (i < pOld->numDataset); i++)
+    {
+        if ((pOld->apDataset[i] != NULL) &&
+            (tau_findDataset(oldIndex, pOld->apDataset[i]->id) == pOld->apDataset[i]) &&
+            (tau_findDataset(newIndex, pOld->apDataset[i]->id) == NULL))
+        {
+            pChanges->removed++;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Convert a host URI into an IP address
+ *
+ *  @param[in]      pUriHost    URI, NULL if not configured
+ *
+ *  @retval         IP address, 0 if not configured or not a dotted IP address
+ */
+static TRDP_IP_ADDR_T cfgHostAddr (
+    const TRDP_URI_HOST_T *pUriHost)
+{
+    TRDP_IP_ADDR_T ipAddr;
+
+    if (pUriHost == NULL)
+    {
+        return VOS_INADDR_ANY;
+    }
+    ipAddr = vos_dottedIP(*pUriHost);
+    if (ipAddr == 0xFFFFFFFFu)
+    {
+        vos_printLog(VOS_LOG_WARNING, "tau_cfg: %s is not an IP address\n", (const char *) *pUriHost);
+        return VOS_INADDR_ANY;
+    }
+    return ipAddr;
+}
+
+/**********************************************************************************************************************/
+/** Get the send parameters of a telegram
+ *
+ *  @param[in]      pConfig     configuration
+ *  @param[in]      pIfSettings settings of the interface
+ *  @param[in]      comParId    com parameter id
+ *
+ *  @retval         send parameters, NULL if the id is not configured
+ */
+static const TRDP_SEND_PARAM_T *cfgSendParam (
+    const TRDP_XML_CONFIG_T         *pConfig,
+    const TRDP_XML_IF_SETTINGS_T    *pIfSettings,
+    UINT32                          comParId)
+{
+    UINT32 i;
+
+    if (comParId == 1u)
+    {
+        return &pIfSettings->pdConfig.sendParam;
+    }
+    if (comParId == 2u)
+    {
+        return &pIfSettings->mdConfig.sendParam;
+    }
+    for (i = 0u; (pConfig->pComPar != NULL) && (i < pConfig->numComPar); i++)
+    {
+        if (pConfig->pComPar[i].id == comParId)
+        {
+            return &pConfig->pComPar[i].sendParam;
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Build the sorted list of the objects of a configuration
+ *
+ *  @param[in]      pSession    configured set of telegrams (interfaces, options)
+ *  @param[in]      pConfig     configuration
+ *  @param[out]     ppTlg       list, to be released by free()
+ *  @param[out]     pNumTlg     number of objects
+ *
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_MEM_ERR
+ */
+static TRDP_ERR_T cfgBuildList (
+    const struct TAU_CFG_SESSION    *pSession,
+    const TRDP_XML_CONFIG_T         *pConfig,
+    TAU_CFG_TLG_T                   * *ppTlg,
+    UINT32                          *pNumTlg)
+{
+    UINT32          i, j, k, sessIdx;
+    UINT32          maxTlg  = 0u;
+    UINT32          numTlg  = 0u;
+    TAU_CFG_TLG_T   *pTlg;
+    TRDP_IP_ADDR_T  mcGroup;
+
+    for (i = 0u; (pConfig->pIfSettings != NULL) && (i < pConfig->numIfConfig); i++)
+    {
+        for (j = 0u; (pConfig->pIfSettings[i].pExchgPar != NULL) && (j < pConfig->pIfSettings[i].numExchgPar); j++)
+        {
+            maxTlg += pConfig->pIfSettings[i].pExchgPar[j].destCnt + pConfig->pIfSettings[i].pExchgPar[j].srcCnt + 1u;
+        }
+    }
+    pTlg = (TAU_CFG_TLG_T *) calloc((maxTlg != 0u) ? maxTlg : 1u, sizeof(TAU_CFG_TLG_T));
+    if (pTlg == NULL)
+    {
+        vos_printLog(VOS_LOG_ERROR, "tau_cfg: out of memory (%u telegrams)\n", maxTlg);
+        return TRDP_MEM_ERR;
+    }
+
+    for (i = 0u; (pConfig->pIfSettings != NULL) && (i < pConfig->numIfConfig); i++)
+    {
+        const TRDP_XML_IF_SETTINGS_T *pIfSettings = &pConfig->pIfSettings[i];
+
+        /*  Interfaces are known by name, those without a session are not used  */
+        for (sessIdx = 0u; sessIdx < pSession->numIf; sessIdx++)
+        {
+            if ((pSession->pAppHandle[sessIdx] != NULL) &&
+                (vos_strnicmp(pSession->pIfName[sessIdx], pConfig->pIfConfig[i].ifName, TRDP_MAX_LABEL_LEN) == 0))
+            {
+                break;
+            }
+        }
+        if (sessIdx == pSession->numIf)
+        {
+            if (pIfSettings->numExchgPar != 0u)
+            {
+                vos_printLog(VOS_LOG_WARNING, "tau_cfg: no session for interface %s, telegrams ignored\n",
+                             pConfig->pIfConfig[i].ifName);
+            }
+            continue;
+        }
+
+        for (j = 0u; (pIfSettings->pExchgPar != NULL) && (j < pIfSettings->numExchgPar); j++)
+        {
+            const TRDP_EXCHG_PAR_T  *pExchgPar  = &pIfSettings->pExchgPar[j];
+            const TRDP_SEND_PARAM_T *pSendParam = cfgSendParam(pConfig, pIfSettings, pExchgPar->comParId);
+            BOOL8                   isMd        = (pExchgPar->pMdPar != NULL) && (pExchgPar->pPdPar == NULL);
+            BOOL8                   isSink      = (pExchgPar->type == TRDP_EXCHG_SINK) ||
+                                                  (pExchgPar->type == TRDP_EXCHG_SOURCESINK);
+            UINT32                  numSrc;
+
+            if (!pSession->createAll && !pExchgPar->create)
+            {
+                continue;
+            }
+
+            /*  Publisher per destination  */
+            if (!isMd && (pExchgPar->type != TRDP_EXCHG_SINK) && (pExchgPar->pDest != NULL))
+            {
+                if (pSendParam == NULL)
+                {
+                    vos_printLog(VOS_LOG_WARNING, "tau_cfg: unknown comParId %u of comId %u\n",
+                                 pExchgPar->comParId, pExchgPar->comId);
+                }
+                for (k = 0u; (pSendParam != NULL) && (k < pExchgPar->destCnt); k++)
+                {
+                    TAU_CFG_TLG_T *pNew = &pTlg[numTlg];
+
+                    pNew->addr[0] = cfgHostAddr(pExchgPar->pDest[k].pUriHost);
+                    if (pNew->addr[0] == VOS_INADDR_ANY)
+                    {
+                        continue;
+                    }
+                    pNew->kind      = TAU_CFG_PUB;
+                    pNew->ifIndex   = sessIdx;
+                    pNew->comId     = pExchgPar->comId;
+                    pNew->par.datasetId = pExchgPar->datasetId;
+                    pNew->par.sendParam = *pSendParam;
+                    if (pExchgPar->pPdPar != NULL)
+                    {
+                        pNew->par.interval  = pExchgPar->pPdPar->cycle;
+                        pNew->par.redId     = pExchgPar->pPdPar->redundant;
+                        pNew->par.flags     = pExchgPar->pPdPar->flags;
+                        pNew->par.sendParam.phase  = pExchgPar->pPdPar->phase;
+                        pNew->par.sendParam.phased = pExchgPar->pPdPar->phased;
+                    }
+                    else
+                    {
+                        pNew->par.interval  = pIfSettings->processConfig.cycleTime;
+                        pNew->par.flags     = pIfSettings->pdConfig.flags;
+                    }
+                    numTlg++;
+                }
+            }
+
+            if ((pExchgPar->type == TRDP_EXCHG_SOURCE) || ((pExchgPar->srcCnt == 0u) && !isSink))
+            {
+                continue;
+            }
+#if MD_SUPPORT == 0
+            if (isMd)
+            {
+                continue;
+            }
+#endif
+
+            /*  Subscriber or listener per source (any source if there is none), joining the first MC destination */
+            mcGroup = VOS_INADDR_ANY;
+            for (k = 0u; (pExchgPar->pDest != NULL) && (k < pExchgPar->destCnt); k++)
+            {
+                mcGroup = cfgHostAddr(pExchgPar->pDest[k].pUriHost);
+                if (vos_isMulticast(mcGroup))
+                {
+                    break;
+                }
+                mcGroup = VOS_INADDR_ANY;
+            }
+            numSrc = (pExchgPar->pSrc != NULL) ? pExchgPar->srcCnt : 0u;
+            for (k = 0u; k < ((numSrc != 0u) ? numSrc : 1u); k++)
+            {
+                TAU_CFG_TLG_T *pNew = &pTlg[numTlg];
+
+                pNew->kind      = isMd ? TAU_CFG_LIS : TAU_CFG_SUB;
+                pNew->ifIndex   = sessIdx;
+                pNew->comId     = pExchgPar->comId;
+                if (numSrc != 0u)
+                {
+                    pNew->addr[0]   = cfgHostAddr(pExchgPar->pSrc[k].pUriHost1);
+                    pNew->addr[1]   = cfgHostAddr(pExchgPar->pSrc[k].pUriHost2);
+                }
+                pNew->addr[2] = mcGroup;
+                if (isMd)
+                {
+                    pNew->par.flags = pExchgPar->pMdPar->flags;
+                }
+                else if (pExchgPar->pPdPar != NULL)
+                {
+                    pNew->par.timeout       = pExchgPar->pPdPar->timeout;
+                    pNew->par.toBehavior    = pExchgPar->pPdPar->toBehav;
+                    pNew->par.flags         = pExchgPar->pPdPar->flags;
+                }
+                else
+                {
+                    pNew->par.timeout       = pIfSettings->pdConfig.timeout;
+                    pNew->par.toBehavior    = pIfSettings->pdConfig.toBehavior;
+                    pNew->par.flags         = pIfSettings->pdConfig.flags;
+                }
+                numTlg++;
+            }
+        }
+    }
+
+    vos_qsort(pTlg, numTlg, sizeof(TAU_CFG_TLG_T), cfgCompare);
+    *ppTlg      = pTlg;
+    *pNumTlg    = numTlg;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Delete the objects of a list with the given action
+ *
+ *  @param[in]      pSession    configured set of telegrams
+ *  @param[in]      pTlg        list
+ *  @param[in]      numTlg      number of objects
+ *  @param[in]      action      objects to delete
+ */
+static void cfgDelete (
+    struct TAU_CFG_SESSION  *pSession,
+    TAU_CFG_TLG_T           *pTlg,
+    UINT32                  numTlg,
+    TAU_CFG_ACTION_T        action)
+{
+    UINT32      i;
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+
+    for (i = 0u; i < numTlg; i++)
+    {
+        if ((pTlg[i].action != action) || (pTlg[i].handle.any == NULL))
+        {
+            continue;
+        }
+        switch (pTlg[i].kind)
+        {
+            case TAU_CFG_PUB:
+                err = tlp_unpublish(pSession->pAppHandle[pTlg[i].ifIndex], pTlg[i].handle.pub);
+                break;
+            case TAU_CFG_SUB:
+                err = tlp_unsubscribe(pSession->pAppHandle[pTlg[i].ifIndex], pTlg[i].handle.sub);
+                break;
+#if MD_SUPPORT
+            case TAU_CFG_LIS:
+                err = tlm_delListener(pSession->pAppHandle[pTlg[i].ifIndex], pTlg[i].handle.lis);
+                break;
+#endif
+            default:
+                break;
+        }
+        if (err != TRDP_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_WARNING, "tau_cfg: deleting comId %u failed (err = %d)\n", pTlg[i].comId, err);
+        }
+        pTlg[i].handle.any = NULL;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Lock or unlock the sessions of the interfaces, e.g. while the marshalling tables are switched
+ *
+ *  @param[in]      pSession    configured set of telegrams
+ *  @param[in]      lock        TRUE: lock, FALSE: unlock
+ */
+static void cfgLockSessions (
+    struct TAU_CFG_SESSION  *pSession,
+    BOOL8                   lock)
+{
+    UINT32 i;
+
+    for (i = 0u; i < pSession->numIf; i++)
+    {
+        TRDP_SESSION_PT appHandle = (TRDP_SESSION_PT) pSession->pAppHandle[i];
+
+        if (appHandle == NULL)
+        {
+            continue;
+        }
+        if (lock == TRUE)
+        {
+            if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+            {
+                vos_printLogStr(VOS_LOG_ERROR, "tau_cfg: vos_mutexLock() failed\n");
+            }
+        }
+        else if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Allocate the descriptors and handles for cfgCreate
+ *
+ *  @param[in]      pTlg        list
+ *  @param[in]      numTlg      number of objects
+ *  @param[out]     pBatch      descriptors and handles, to be released by free(pBatch->pPubDesc)
+ *
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_MEM_ERR
+ */
+static TRDP_ERR_T cfgAllocBatch (
+    const TAU_CFG_TLG_T *pTlg,
+    UINT32              numTlg,
+    TAU_CFG_BATCH_T     *pBatch)
+{
+    UINT32  i;
+    UINT32  num = 0u;
+
+    for (i = 0u; i < numTlg; i++)
+    {
+        if (pTlg[i].action == TAU_CFG_CREATE)
+        {
+            num++;
+        }
+    }
+    memset(pBatch, 0, sizeof(TAU_CFG_BATCH_T));
+    if (num == 0u)
+    {
+        return TRDP_NO_ERR;
+    }
+
+    /*  One block, the descriptors (holding pointers) first  */
+    pBatch->pPubDesc = (TRDP_PUB_DESC_T *) calloc(num, sizeof(TRDP_PUB_DESC_T) + sizeof(TRDP_SUB_DESC_T) +
+                                                  sizeof(TAU_CFG_TLG_T *) + sizeof(TRDP_PUB_T) + sizeof(TRDP_SUB_T));
+    if (pBatch->pPubDesc == NULL)
+    {
+        vos_printLog(VOS_LOG_ERROR, "tau_cfg: out of memory (%u telegrams)\n", num);
+        return TRDP_MEM_ERR;
+    }
+    pBatch->pSubDesc    = (TRDP_SUB_DESC_T *) (pBatch->pPubDesc + num);
+    pBatch->ppTlg       = (TAU_CFG_TLG_T * *) (pBatch->pSubDesc + num);
+    pBatch->pPubHandle  = (TRDP_PUB_T *) (pBatch->ppTlg + num);
+    pBatch->pSubHandle  = (TRDP_SUB_T *) (pBatch->pPubHandle + num);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Create the objects of a list marked TAU_CFG_CREATE, publishers and subscribers in one batch per interface
+ *
+ *  @param[in]      pSession    configured set of telegrams
+ *  @param[in]      pTlg        list
+ *  @param[in]      numTlg      number of objects
+ *  @param[in]      pBatch      descriptors and handles from cfgAllocBatch
+ *  @param[out]     pFailed     number of objects not created
+ *
+ *  @retval         first error
+ */
+static TRDP_ERR_T cfgCreate (
+    struct TAU_CFG_SESSION  *pSession,
+    TAU_CFG_TLG_T           *pTlg,
+    UINT32                  numTlg,
+    const TAU_CFG_BATCH_T   *pBatch,
+    UINT32                  *pFailed)
+{
+    TRDP_ERR_T  result  = TRDP_NO_ERR;
+    TRDP_ERR_T  err;
+    UINT32      first, last, i, num;
+
+    /*  The list is sorted by kind and interface, each run of equal ones is one batch  */
+    for (first = 0u; first < numTlg; first = last)
+    {
+        TRDP_APP_SESSION_T appHandle = pSession->pAppHandle[pTlg[first].ifIndex];
+
+        for (last = first, num = 0u;
+             (last < numTlg) && (pTlg[last].kind == pTlg[first].kind) && (pTlg[last].ifIndex == pTlg[first].ifIndex);
+             last++)
+        {
+            TAU_CFG_TLG_T *pCur = &pTlg[last];
+
+            if (pCur->action != TAU_CFG_CREATE)
+            {
+                continue;
+            }
+            pBatch->ppTlg[num] = pCur;
+            if (pCur->kind == TAU_CFG_PUB)
+            {
+                memset(&pBatch->pPubDesc[num], 0, sizeof(TRDP_PUB_DESC_T));
+                pBatch->pPubDesc[num].pUserRef      = pSession->pUserRef;
+                pBatch->pPubDesc[num].pfCbFunction  = pSession->pfPdCallback;
+                pBatch->pPubDesc[num].comId         = pCur->comId;
+                pBatch->pPubDesc[num].destIpAddr    = pCur->addr[0];
+                pBatch->pPubDesc[num].interval      = pCur->par.interval;
+                pBatch->pPubDesc[num].redId         = pCur->par.redId;
+                pBatch->pPubDesc[num].pktFlags      = pCur->par.flags;
+                pBatch->pPubDesc[num].pSendParam    = &pCur->par.sendParam;
+            }
+            else if (pCur->kind == TAU_CFG_SUB)
+            {
+                memset(&pBatch->pSubDesc[num], 0, sizeof(TRDP_SUB_DESC_T));
+                pBatch->pSubDesc[num].pUserRef      = pSession->pUserRef;
+                pBatch->pSubDesc[num].pfCbFunction  = pSession->pfPdCallback;
+                pBatch->pSubDesc[num].comId         = pCur->comId;
+                pBatch->pSubDesc[num].srcIpAddr1    = pCur->addr[0];
+                pBatch->pSubDesc[num].srcIpAddr2    = pCur->addr[1];
+                pBatch->pSubDesc[num].destIpAddr    = pCur->addr[2];
+                pBatch->pSubDesc[num].pktFlags      = pCur->par.flags;
+                pBatch->pSubDesc[num].timeout       = pCur->par.timeout;
+                pBatch->pSubDesc[num].toBehavior    = pCur->par.toBehavior;
+            }
+            num++;
+        }
+        if (num == 0u)
+        {
+            continue;
+        }
+
+        err = TRDP_NO_ERR;
+        switch (pTlg[first].kind)
+        {
+            case TAU_CFG_PUB:
+                err = tlp_publishBatch(appHandle, num, pBatch->pPubDesc, pBatch->pPubHandle);
+                for (i = 0u; i < num; i++)
+                {
+                    pBatch->ppTlg[i]->handle.pub = pBatch->pPubHandle[i];
+                }
+                break;
+            case TAU_CFG_SUB:
+                err = tlp_subscribeBatch(appHandle, num, pBatch->pSubDesc, pBatch->pSubHandle);
+                for (i = 0u; i < num; i++)
+                {
+                    pBatch->ppTlg[i]->handle.sub = pBatch->pSubHandle[i];
+                }
+                break;
+            default:
+#if MD_SUPPORT
+                for (i = 0u; i < num; i++)
+                {
+                    TAU_CFG_TLG_T   *pCur   = pBatch->ppTlg[i];
+                    TRDP_ERR_T      lisErr  = tlm_addListener(appHandle, &pCur->handle.lis, pSession->pUserRef,
+                                                              pSession->pfMdCallback, TRUE, pCur->comId, 0u, 0u,
+                                                              pCur->addr[0], pCur->addr[1], pCur->addr[2],
+                                                              pCur->par.flags, NULL, NULL);
+                    if (lisErr != TRDP_NO_ERR)
+                    {
+                        pCur->handle.lis = NULL;
+                        err = (err == TRDP_NO_ERR) ? lisErr : err;
+                    }
+                }
+#endif
+                break;
+        }
+
+        for (i = 0u; i < num; i++)
+        {
+            if (pBatch->ppTlg[i]->handle.any == NULL)
+            {
+                (*pFailed)++;
+                vos_printLog(VOS_LOG_WARNING, "tau_cfg: creating comId %u failed\n", pBatch->ppTlg[i]->comId);
+            }
+        }
+        if (result == TRDP_NO_ERR)
+        {
+            result = err;
+        }
+    }
+    return result;
+}
+
+/**********************************************************************************************************************/
+/** Compare the running and a new list and mark the actions
+ *
+ *  @param[in]      pSession    configured set of telegrams (running list and index)
+ *  @param[in]      newIndex    index of the new configuration
+ *  @param[in,out]  pNewTlg     new list
+ *  @param[in]      numNewTlg   number of new objects
+ *  @param[out]     pDiff       counts
+ */
+static void cfgDiff (
+    struct TAU_CFG_SESSION  *pSession,
+    TAU_CFG_INDEX_T         newIndex,
+    TAU_CFG_TLG_T           *pNewTlg,
+    UINT32                  numNewTlg,
+    TAU_CFG_DIFF_T          *pDiff)
+{
+    UINT32  iOld    = 0u;
+    UINT32  iNew    = 0u;
+
+    while ((iOld < pSession->numTlg) || (iNew < numNewTlg))
+    {
+        TAU_CFG_TLG_T       *pOld = (iOld < pSession->numTlg) ? &pSession->pTlg[iOld] : NULL;
+        TAU_CFG_TLG_T       *pNew = (iNew < numNewTlg) ? &pNewTlg[iNew] : NULL;
+        TAU_CFG_CHANGES_T   *pChanges;
+        int                 order;
+
+        if (pOld == NULL)
+        {
+            order = 1;
+        }
+        else if (pNew == NULL)
+        {
+            order = -1;
+        }
+        else
+        {
+            order = cfgCompare(pOld, pNew);
+        }
+        pChanges = &pDiff->pub;
+        switch ((order < 0) ? pOld->kind : pNew->kind)
+        {
+            case TAU_CFG_SUB:
+                pChanges = &pDiff->sub;
+                break;
+            case TAU_CFG_LIS:
+                pChanges = &pDiff->lis;
+                break;
+            default:
+                break;
+        }
+
+        if (order < 0)
+        {
+            pOld->action = TAU_CFG_DELETE;
+            pChanges->removed++;
+            iOld++;
+        }
+        else if (order > 0)
+        {
+            pNew->action = TAU_CFG_CREATE;
+            pChanges->added++;
+            iNew++;
+        }
+        else
+        {
+            /*  Same telegram: a publisher also changes with the layout of its dataset. One not created before
+                is tried again  */
+            if ((pOld->handle.any != NULL) &&
+                cfgParEqual(&pOld->par, &pNew->par) &&
+                ((pNew->kind != TAU_CFG_PUB) ||
+                 cfgDatasetEqual(pSession->index, newIndex, pNew->par.datasetId, 0u)))
+            {
+                pOld->action        = TAU_CFG_KEEP;
+                pNew->action        = TAU_CFG_KEEP;
+                pNew->handle.any    = pOld->handle.any;
+                pChanges->kept++;
+            }
+            else
+            {
+                pOld->action    = TAU_CFG_REPLACE;
+                pNew->action    = TAU_CFG_CREATE;
+                pChanges->modified++;
+            }
+            iOld++;
+            iNew++;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Find the first object of a kind, session and comId.
+ *
+ *  @param[in]      cfgSession  configured set of telegrams
+ *  @param[in]      kind        publisher, subscriber or listener
+ *  @param[in]      appHandle   session of the interface
+ *  @param[in]      comId       comId of the telegram
+ *
+ *  @retval         position of the first object, cfgSession->numTlg if there is none
+ */
+static UINT32 cfgFind (
+    TAU_CFG_SESSION_T   cfgSession,
+    TAU_CFG_KIND_T      kind,
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              comId)
+{
+    TAU_CFG_TLG_T   key;
+    UINT32          low, high, mid;
+
+    memset(&key, 0, sizeof(key));
+    key.kind    = kind;
+    key.ifIndex = TAU_CFG_NO_IF;
+    key.comId   = comId;
+    for (low = 0u; (cfgSession != NULL) && (low < cfgSession->numIf); low++)
+    {
+        if ((appHandle != NULL) && (cfgSession->pAppHandle[low] == appHandle))
+        {
+            key.ifIndex = low;
+            break;
+        }
+    }
+    if (key.ifIndex == TAU_CFG_NO_IF)
+    {
+        return (cfgSession != NULL) ? cfgSession->numTlg : 0u;
+    }
+
+    /*  Lower bound: the key has the lowest addresses  */
+    low     = 0u;
+    high    = cfgSession->numTlg;
+    while (low < high)
+    {
+        mid = low + (high - low) / 2u;
+        if (cfgCompare(&cfgSession->pTlg[mid], &key) < 0)
+        {
+            low = mid + 1u;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    if ((low < cfgSession->numTlg) &&
+        ((cfgSession->pTlg[low].kind != kind) || (cfgSession->pTlg[low].ifIndex != key.ifIndex) ||
+         (cfgSession->pTlg[low].comId != comId)))
+    {
+        low = cfgSession->numTlg;
+    }
+    return low;
+}
+
+/******************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/**    Create the publishers, subscribers and MD listeners of a configuration.
+ *
+ *  @param[out]     pCfgSession       Handle, to be released by tau_closeCfgSession
+ *  @param[in]      pConfig           Configuration, taken over in any case
+ *  @param[in]      numAppHandle      Number of session handles
+ *  @param[in]      pAppHandle        Session handles, one per interface of the configuration (pIfConfig order),
+ *                                    NULL if the interface is not used
+ *  @param[in]      pUserRef          User reference of the publishers, subscribers and listeners
+ *  @param[in]      pfPdCallback      PD callback, NULL to use the default function of the session
+ *  @param[in]      pfMdCallback      MD callback, NULL to use the default function of the session
+ *  @param[in]      createAll         TRUE: all telegrams, FALSE: only telegrams with create="on"
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    parameter error
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *  @retval         other             first error of a publisher, subscriber or listener, the handle is valid
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_openCfgSession (
+    TAU_CFG_SESSION_T           *pCfgSession,
+    TRDP_XML_CONFIG_T           *pConfig,
+    UINT32                      numAppHandle,
+    const TRDP_APP_SESSION_T    *pAppHandle,
+    const void                  *pUserRef,
+    TRDP_PD_CALLBACK_T          pfPdCallback,
+    TRDP_MD_CALLBACK_T          pfMdCallback,
+    BOOL8                       createAll)
+{
+    struct TAU_CFG_SESSION  *pSession;
+    TRDP_ERR_T              result;
+    UINT32                  i;
+
+    if ((pCfgSession == NULL) || (pConfig == NULL) || (pAppHandle == NULL) || (numAppHandle == 0u) ||
+        (numAppHandle > pConfig->numIfConfig))
+    {
+        if (pConfig != NULL)
+        {
+            tau_freeConfig(pConfig);
+        }
+        return TRDP_PARAM_ERR;
+    }
+
+    pSession = (struct TAU_CFG_SESSION *) calloc(1u,
+                                                 sizeof(struct TAU_CFG_SESSION) +
+                                                 numAppHandle * (sizeof(TRDP_APP_SESSION_T) + sizeof(TRDP_LABEL_T)));
+    if (pSession == NULL)
+    {
+        tau_freeConfig(pConfig);
+        return TRDP_MEM_ERR;
+    }
+    pSession->numIf         = numAppHandle;
+    pSession->pAppHandle    = (TRDP_APP_SESSION_T *) (pSession + 1);
+    pSession->pIfName       = (TRDP_LABEL_T *) (pSession->pAppHandle + numAppHandle);
+    pSession->pUserRef      = pUserRef;
+    pSession->pfPdCallback  = pfPdCallback;
+    pSession->pfMdCallback  = pfMdCallback;
+    pSession->createAll     = createAll;
+    for (i = 0u; i < numAppHandle; i++)
+    {
+        pSession->pAppHandle[i] = pAppHandle[i];
+        vos_strncpy(pSession->pIfName[i], pConfig->pIfConfig[i].ifName, TRDP_MAX_LABEL_LEN - 1u);
+    }
+
+    /*  Opening is applying to an empty configuration  */
+    result = tau_applyConfig(pSession, pConfig, NULL);
+    if (result == TRDP_MEM_ERR)
+    {
+        free(pSession);
+        return result;
+    }
+    *pCfgSession = pSession;
+    return result;
+}
+
+/**********************************************************************************************************************/
+/**    Apply a changed configuration.
+ *
+ *  @param[in]      cfgSession        Handle from tau_openCfgSession
+ *  @param[in]      pConfig           New configuration, taken over in any case
+ *  @param[out]     pDiff             Applied difference, NULL if not needed
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    parameter error
+ *  @retval         TRDP_MEM_ERR      out of memory, the running configuration is unchanged
+ *  @retval         other             first error of a publisher, subscriber or listener, the new configuration
+ *                                    is applied without it
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_applyConfig (
+    TAU_CFG_SESSION_T   cfgSession,
+    TRDP_XML_CONFIG_T   *pConfig,
+    TAU_CFG_DIFF_T      *pDiff)
+{
+    TRDP_ERR_T      result;
+    TAU_CFG_INDEX_T newIndex    = NULL;
+    TAU_CFG_TLG_T   *pNewTlg    = NULL;
+    UINT32          numNewTlg   = 0u;
+    TAU_CFG_DIFF_T  diff;
+    TAU_CFG_BATCH_T batch;
+    UINT32          i;
+    void            *pRefCon    = NULL;
+
+    if (pConfig == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (cfgSession == NULL)
+    {
+        tau_freeConfig(pConfig);
+        return TRDP_PARAM_ERR;
+    }
+
+    /*  The marshalling cannot be reset to no datasets at all  */
+    if ((cfgSession->config.numDataset != 0u) && (cfgSession->config.numComId != 0u) &&
+        ((pConfig->numDataset == 0u) || (pConfig->numComId == 0u)))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "tau_applyConfig: configuration without datasets\n");
+        tau_freeConfig(pConfig);
+        return TRDP_PARAM_ERR;
+    }
+
+    result = tau_initConfigIndex(pConfig, &newIndex);
+    if (result == TRDP_NO_ERR)
+    {
+        result = cfgBuildList(cfgSession, pConfig, &pNewTlg, &numNewTlg);
+    }
+    if (result != TRDP_NO_ERR)
+    {
+        tau_freeConfigIndex(newIndex);
+        tau_freeConfig(pConfig);
+        return result;
+    }
+
+    memset(&diff, 0, sizeof(diff));
+    cfgDiffDatasets(cfgSession->index, &cfgSession->config, newIndex, pConfig, &diff.dataset);
+    cfgDiff(cfgSession, newIndex, pNewTlg, numNewTlg, &diff);
+    if (cfgAllocBatch(pNewTlg, numNewTlg, &batch) != TRDP_NO_ERR)
+    {
+        free(pNewTlg);
+        tau_freeConfigIndex(newIndex);
+        tau_freeConfig(pConfig);
+        return TRDP_MEM_ERR;
+    }
+
+    /*  Modified ones are deleted first, before the switch: they are still marshalled with their old datasets.
+        A duplicate would be rejected on creation as well  */
+    cfgDelete(cfgSession, cfgSession->pTlg, cfgSession->numTlg, TAU_CFG_REPLACE);
+
+    /*  Switch the marshalling to the new datasets, nothing may refer to the old ones any more.
+        The new tables are sorted before, the sessions are locked for the switch only  */
+    if ((pConfig->numDataset != 0u) && (pConfig->numComId != 0u))
+    {
+        (void) tau_prepareMarshall(pConfig->numComId, pConfig->pComIdDsIdMap, pConfig->numDataset,
+                                   pConfig->apDataset);
+    }
+    cfgLockSessions(cfgSession, TRUE);
+    if ((pConfig->numDataset != 0u) && (pConfig->numComId != 0u))
+    {
+        if (tau_initMarshall(&pRefCon, pConfig->numComId, pConfig->pComIdDsIdMap, pConfig->numDataset,
+                             pConfig->apDataset) != TRDP_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_WARNING, "tau_applyConfig: marshalling not initialized\n");
+        }
+    }
+    for (i = 0u; i < cfgSession->numIf; i++)
+    {
+        if (cfgSession->pAppHandle[i] != NULL)
+        {
+            (void) tlc_resetDatasetCache(cfgSession->pAppHandle[i]);
+        }
+    }
+    cfgLockSessions(cfgSession, FALSE);
+
+    /*  Then all new ones are created; removed ones are deleted last, so a multicast group taken over by a new
+        subscriber is not left in between  */
+    result = cfgCreate(cfgSession, pNewTlg, numNewTlg, &batch, &diff.failed);
+    cfgDelete(cfgSession, cfgSession->pTlg, cfgSession->numTlg, TAU_CFG_DELETE);
+    free(batch.pPubDesc);
+
+    vos_printLog(VOS_LOG_INFO,
+                 "tau_applyConfig: publishers +%u -%u ~%u =%u, subscribers +%u -%u ~%u =%u, "
+                 "listeners +%u -%u ~%u =%u, datasets +%u -%u ~%u, %u failed\n",
+                 diff.pub.added, diff.pub.removed, diff.pub.modified, diff.pub.kept,
+                 diff.sub.added, diff.sub.removed, diff.sub.modified, diff.sub.kept,
+                 diff.lis.added, diff.lis.removed, diff.lis.modified, diff.lis.kept,
+                 diff.dataset.added, diff.dataset.removed, diff.dataset.modified, diff.failed);
+
+    /*  The new configuration is running now  */
+    free(cfgSession->pTlg);
+    tau_freeConfigIndex(cfgSession->index);
+    if (cfgSession->index != NULL)
+    {
+        tau_freeConfig(&cfgSession->config);
+    }
+    cfgSession->pTlg    = pNewTlg;
+    cfgSession->numTlg  = numNewTlg;
+    cfgSession->index   = newIndex;
+    cfgSession->config  = *pConfig;
+
+    if (pDiff != NULL)
+    {
+        *pDiff = diff;
+    }
+    return result;
+}
+
+/**********************************************************************************************************************/
+/**    Load a changed configuration (tau_loadConfig) and apply it (tau_applyConfig).
+ *
+ *  @param[in]      cfgSession        Handle from tau_openCfgSession
+ *  @param[in]      pXmlFileName      Path and filename of the xml configuration file, NULL: use the image
+ *  @param[in]      pImageFileName    Path and filename of the binary image, NULL: read XML
+ *  @param[out]     pDiff             Applied difference, NULL if not needed
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    parameter error or configuration not readable
+ *  @retval         TRDP_MEM_ERR      out of memory, the running configuration is unchanged
+ *  @retval         other             see tau_applyConfig
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_reloadConfig (
+    TAU_CFG_SESSION_T   cfgSession,
+    const CHAR8         *pXmlFileName,
+    const CHAR8         *pImageFileName,
+    TAU_CFG_DIFF_T      *pDiff)
+{
+    TRDP_XML_CONFIG_T   config;
+    TRDP_ERR_T          result;
+
+    if (cfgSession == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    result = tau_loadConfig(pXmlFileName, pImageFileName, &config);
+    if (result != TRDP_NO_ERR)
+    {
+        return result;
+    }
+    return tau_applyConfig(cfgSession, &config, pDiff);
+}
+
+/**********************************************************************************************************************/
+/**    Delete all publishers, subscribers and listeners of the configuration and release it.
+ *
+ *  @param[in]      cfgSession        Handle from tau_openCfgSession, NULL: nothing to do
+ *
+ */
+EXT_DECL void tau_closeCfgSession (
+    TAU_CFG_SESSION_T cfgSession)
+{
+    UINT32 i;
+
+    if (cfgSession == NULL)
+    {
+        return;
+    }
+    for (i = 0u; i < cfgSession->numTlg; i++)
+    {
+        cfgSession->pTlg[i].action = TAU_CFG_DELETE;
+    }
+    cfgDelete(cfgSession, cfgSession->pTlg, cfgSession->numTlg, TAU_CFG_DELETE);
+    for (i = 0u; i < cfgSession->numIf; i++)
+    {
+        if (cfgSession->pAppHandle[i] != NULL)
+        {
+            (void) tlc_resetDatasetCache(cfgSession->pAppHandle[i]);
+        }
+    }
+    free(cfgSession->pTlg);
+    tau_freeConfigIndex(cfgSession->index);
+    tau_freeConfig(&cfgSession->config);
+    free(cfgSession);
+}
+
+/**********************************************************************************************************************/
+/**    Get the running configuration.
+ *
+ *  @param[in]      cfgSession        Handle from tau_openCfgSession
+ *
+ *  @retval         pointer to the configuration, valid until the next tau_applyConfig
+ *
+ */
+EXT_DECL const TRDP_XML_CONFIG_T *tau_getCfgConfig (
+    TAU_CFG_SESSION_T cfgSession)
+{
+    return (cfgSession != NULL) ? &cfgSession->config : NULL;
+}
+
+/**********************************************************************************************************************/
+/**    Get the handle of a configured publisher.
+ *
+ *  @param[in]      cfgSession        Handle from tau_openCfgSession
+ *  @param[in]      appHandle         Session of the interface
+ *  @param[in]      comId             ComId of the telegram
+ *  @param[in]      destIpAddr        Destination of the publisher
+ *
+ *  @retval         publisher handle, NULL if not configured or not created
+ *
+ */
+EXT_DECL TRDP_PUB_T tau_getCfgPubHandle (
+    TAU_CFG_SESSION_T   cfgSession,
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              comId,
+    TRDP_IP_ADDR_T      destIpAddr)
+{
+    UINT32 i = cfgFind(cfgSession, TAU_CFG_PUB, appHandle, comId);
+
+    for (; (cfgSession != NULL) && (i < cfgSession->numTlg); i++)
+    {
+        const TAU_CFG_TLG_T *pTlg = &cfgSession->pTlg[i];
+
+        if ((pTlg->kind != TAU_CFG_PUB) || (pTlg->comId != comId) || (pTlg->addr[0] > destIpAddr))
+        {
+            break;
+        }
+        if (pTlg->addr[0] == destIpAddr)
+        {
+            return pTlg->handle.pub;
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/**    Get the handle of a configured subscriber.
+ *
+ *  @param[in]      cfgSession        Handle from tau_openCfgSession
+ *  @param[in]      appHandle         Session of the interface
+ *  @param[in]      comId             ComId of the telegram
+ *  @param[in]      srcIpAddr         Source (first address of the source), 0: first subscriber of the comId
+ *
+ *  @retval         subscriber handle, NULL if not configured or not created
+ *
+ */
+EXT_DECL TRDP_SUB_T tau_getCfgSubHandle (
+    TAU_CFG_SESSION_T   cfgSession,
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              comId,
+    TRDP_IP_ADDR_T      srcIpAddr)
+{
+    UINT32 i = cfgFind(cfgSession, TAU_CFG_SUB, appHandle, comId);
+
+    for (; (cfgSession != NULL) && (i < cfgSession->numTlg); i++)
+    {
+        const TAU_CFG_TLG_T *pTlg = &cfgSession->pTlg[i];
+
+        if ((pTlg->kind != TAU_CFG_SUB) || (pTlg->comId != comId) ||
+            ((srcIpAddr != VOS_INADDR_ANY) && (pTlg->addr[0] > srcIpAddr)))
+        {
+            break;
+        }
+        if ((srcIpAddr == VOS_INADDR_ANY) || (pTlg->addr[0] == srcIpAddr))
+        {
+            return pTlg->handle.sub;
+        }
+    }
+    return NULL;
+}
@@ -16,6 +16,7 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: tau_prepareMarshall(): tables sorted before tau_initMarshall() switches to them
  *      BL 2018-11-08: Use B_ENDIAN from vos_utils.h in unpackedCopy64()
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
  *      SW 2018-06-12: Ticket #203 Incorrect unmarshalling of datasets containing TIMEDATE64 array
@@ -1040,24 +1041,21 @@ static TRDP_ERR_T size_unmarshall (
  */
 
 /**********************************************************************************************************************/
-/**    Function to initialise the marshalling/unmarshalling.
- *    The supplied array must be sorted by ComIds. The array must exist during the use of the marshalling
- *    functions (until tlc_terminate()).
+/**    Prepare tables for the marshalling/unmarshalling.
+ *    Sorts the tables in place and invalidates the dataset caches of their elements. The marshalling in use is
+ *    not touched, tau_initMarshall() then only checks the order and switches to the tables.
  *
- *  @param[in,out]  ppRefCon         Returns a pointer to be used for the reference context of marshalling/unmarshalling
  *  @param[in]      numComId         Number of datasets found in the configuration
  *  @param[in]      pComIdDsIdMap    Pointer to an array of structures of type TRDP_DATASET_T
  *  @param[in]      numDataSet       Number of datasets found in the configuration
  *  @param[in]      pDataset         Pointer to an array of pointers to structures of type TRDP_DATASET_T
  *
  *  @retval         TRDP_NO_ERR      no error
- *  @retval         TRDP_MEM_ERR     provided buffer to small
  *  @retval         TRDP_PARAM_ERR   Parameter error
  *
  */
 
-EXT_DECL TRDP_ERR_T tau_initMarshall (
-    void                    * *ppRefCon,
+EXT_DECL TRDP_ERR_T tau_prepareMarshall (
     UINT32                  numComId,
     TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap,
     UINT32                  numDataSet,
@@ -1065,23 +1063,28 @@ EXT_DECL TRDP_ERR_T tau_initMarshall (
 {
     UINT32 i, j;
 
-    ppRefCon = ppRefCon;
-
     if ((pDataset == NULL) || (numDataSet == 0u) || (numComId == 0u) || (pComIdDsIdMap == 0u))
     {
         return TRDP_PARAM_ERR;
     }
 
-    /*    Save the pointer to the comId mapping table    */
-    sComIdDsIdMap   = pComIdDsIdMap;
-    sNumComId       = numComId;
-
-    /* sort the table    */
-    vos_qsort(pComIdDsIdMap, numComId, sizeof(TRDP_COMID_DSID_MAP_T), compareComId);
-
-    /*    Save the pointer to the table    */
-    sDataSets   = pDataset;
-    sNumEntries = numDataSet;
+    /* sort the tables, unless they are sorted already    */
+    for (i = 1u; i < numComId; i++)
+    {
+        if (compareComId(&pComIdDsIdMap[i - 1u], &pComIdDsIdMap[i]) > 0)
+        {
+            vos_qsort(pComIdDsIdMap, numComId, sizeof(TRDP_COMID_DSID_MAP_T), compareComId);
+            break;
+        }
+    }
+    for (i = 1u; i < numDataSet; i++)
+    {
+        if (compareDataset(&pDataset[i - 1u], &pDataset[i]) > 0)
+        {
+            vos_qsort(pDataset, numDataSet, sizeof(TRDP_DATASET_T *), compareDataset);
+            break;
+        }
+    }
 
     /* invalidate the cache */
     for (i = 0u; i < numDataSet; i++)
@@ -1091,8 +1094,51 @@ EXT_DECL TRDP_ERR_T tau_initMarshall (
             pDataset[i]->pElement[j].pCachedDS = NULL;
         }
     }
-    /* sort the table    */
-    vos_qsort(pDataset, numDataSet, sizeof(TRDP_DATASET_T *), compareDataset);
+
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Function to initialise the marshalling/unmarshalling.
+ *    The tables are sorted (see tau_prepareMarshall) before the marshalling switches to them. The arrays must exist
+ *    during the use of the marshalling functions (until tlc_terminate()).
+ *    The switch is not atomic: while the marshalling is in use, the sessions calling it must be locked, see
+ *    tau_applyConfig().
+ *
+ *  @param[in,out]  ppRefCon         Returns a pointer to be used for the reference context of marshalling/unmarshalling
+ *  @param[in]      numComId         Number of datasets found in the configuration
+ *  @param[in]      pComIdDsIdMap    Pointer to an array of structures of type TRDP_DATASET_T
+ *  @param[in]      numDataSet       Number of datasets found in the configuration
+ *  @param[in]      pDataset         Pointer to an array of pointers to structures of type TRDP_DATASET_T
+ *
+ *  @retval         TRDP_NO_ERR      no error
+ *  @retval         TRDP_MEM_ERR     provided buffer to small
+ *  @retval         TRDP_PARAM_ERR   Parameter error
+ *
+ */
+
+EXT_DECL TRDP_ERR_T tau_initMarshall (
+    void                    * *ppRefCon,
+    UINT32                  numComId,
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap,
+    UINT32                  numDataSet,
+    TRDP_DATASET_T          *pDataset[])
+{
+    TRDP_ERR_T err;
+
+    ppRefCon = ppRefCon;
+
+    err = tau_prepareMarshall(numComId, pComIdDsIdMap, numDataSet, pDataset);
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+
+    /*    Save the pointers to the sorted tables    */
+    sComIdDsIdMap   = pComIdDsIdMap;
+    sNumComId       = numComId;
+    sDataSets       = pDataset;
+    sNumEntries     = numDataSet;
 
     return TRDP_NO_ERR;
 }
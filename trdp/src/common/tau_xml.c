@@ -16,6 +16,8 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: pd-parameter: phased set if the phase attribute is given
+ *      BL 2026-10-17: pd-parameter: phase attribute
  *      SB 2018-10-29: Ticket #214 Incorrect parsing of <source> and <destination> elements
  *      BL 2018-10-01: Some default attribute values for com-parameter tag were missing
  *      BL 2018-09-05: Ticket #211 XML handling: Dataset Name should be stored in TRDP_DATASET_ELEMENT_T
@@ -219,9 +221,10 @@ static void dbgPrint (UINT32 num, TRDP_EXCHG_PAR_T *pArray)
 
         if (pArray[i].pPdPar != NULL)
         {
-            printf( "PD flags: %u cycle: %u timeout: %u\n",
+            printf( "PD flags: %u cycle: %u phase: %u timeout: %u\n",
                     (unsigned int)pArray[i].pPdPar->flags,
                     (unsigned int)pArray[i].pPdPar->cycle,
+                    (unsigned int)pArray[i].pPdPar->phase,
                     (unsigned int)pArray[i].pPdPar->timeout);
         }
         for (j = 0u; j < pArray[i].destCnt; ++j)
@@ -374,6 +377,11 @@ static TRDP_ERR_T readTelegramDef (
                     {
                         pExchgParam->pPdPar->cycle = valueInt;
                     }
+                    else if (vos_strnicmp(attribute, "phase", MAX_TOK_LEN) == 0)
+                    {
+                        pExchgParam->pPdPar->phase  = valueInt;
+                        pExchgParam->pPdPar->phased = TRUE;
+                    }
                     else if (vos_strnicmp(attribute, "timeout", MAX_TOK_LEN) == 0)
                     {
                         pExchgParam->pPdPar->timeout = valueInt;
@@ -0,0 +1,1062 @@
+/******************************************************************************/
+/**
+ * @file            tau_xml_cache.c
+ *
+ * @brief           Complete XML configuration and its binary image
+ *
+ * @details         tau_readXmlConfig() reads all parts of a device configuration at once.
+ *                  tau_writeConfigImage() serialises it into one block: a header followed by the configuration,
+ *                  in which all pointers are stored as offsets from the start of the image.
+ *                  tau_loadConfig() maps that image, checks header, checksum and the XML file stamp (size,
+ *                  modification time in ns and CRC of the XML text), turns the
+ *                  offsets back into pointers in place and hands out the configuration without any further
+ *                  allocation. A missing, damaged or stale image makes it read the XML file instead.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ *      BL 2026-10-17: XML file read for the CRC only if size and modification time match the image
+ *      BL 2026-10-17: XML stamp with ns modification time and CRC of the file, layout covers all field offsets
+ *
+ */
+
+/*******************************************************************************
+ * INCLUDES
+ */
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#include "trdp_types.h"
+#include "trdp_utils.h"
+#include "tau_xml_cache.h"
+#include "vos_utils.h"
+
+/*******************************************************************************
+ * DEFINES
+ */
+
+#define TAU_CONFIG_IMAGE_MAGIC      "TRDPCFG"   /**< Identifies a configuration image           */
+#define TAU_CONFIG_IMAGE_VERSION    2u          /**< Version of the image format (header, stamp) */
+#define TAU_CONFIG_IMAGE_ORDER      0x01020304u /**< Written in host byte order                 */
+#define TAU_CONFIG_IMAGE_ALIGN      8u          /**< Alignment of all blocks in the image       */
+
+#define TAU_CONFIG_LIB_VERSION      ((TRDP_VERSION << 24u) | (TRDP_RELEASE << 16u) | (TRDP_UPDATE << 8u) | \
+                                     TRDP_EVOLUTION)
+
+#define TAU_CONFIG_XML_CHUNK        4096u       /**< Read size for the CRC of the XML file      */
+
+/** Offset of a field of a stored structure, for the layout checksum */
+#define CACHE_FIELD(type, field)    ((UINT32) offsetof(type, field))
+
+/*******************************************************************************
+ * TYPEDEFS
+ */
+
+/** Header of a configuration image */
+typedef struct
+{
+    CHAR8   magic[8];           /**< TAU_CONFIG_IMAGE_MAGIC                                 */
+    UINT32  version;            /**< TAU_CONFIG_IMAGE_VERSION                               */
+    UINT32  byteOrder;          /**< TAU_CONFIG_IMAGE_ORDER                                 */
+    UINT32  libVersion;         /**< TRDP version of the writer                             */
+    UINT32  layout;             /**< checksum over sizes and field offsets of the stored structures */
+    UINT32  headerSize;         /**< size of this header                                    */
+    UINT32  imageSize;          /**< size of the whole image                                */
+    UINT32  crc;                /**< CRC of the image behind the header                     */
+    UINT32  configOffset;       /**< offset of the TRDP_XML_CONFIG_T                        */
+    UINT64  xmlSize;            /**< size of the XML file                                   */
+    INT64   xmlTime;            /**< modification time of the XML file in ns                */
+    UINT32  xmlCrc;             /**< CRC of the XML file                                    */
+    UINT32  reserved;           /**< 0                                                      */
+} TAU_CONFIG_IMAGE_HEADER_T;
+
+/** Image under construction, pBuf == NULL while only the size is computed */
+typedef struct
+{
+    UINT8   *pBuf;
+    UINT32  size;
+} TAU_CONFIG_WRITER_T;
+
+/******************************************************************************
+ *   Locals
+ */
+
+/**********************************************************************************************************************/
+/** Checksum over the sizes and the field offsets of all structures stored in an image, an image of other layout
+ *  is not usable. A field added to, moved in or removed from a stored structure changes it; a field changing its
+ *  meaning at the same offset and size still needs a new TAU_CONFIG_IMAGE_VERSION.
+ *
+ *  @retval         layout checksum
+ */
+static UINT32 cacheLayout (void)
+{
+    const UINT32 layout[] =
+    {
+        (UINT32) sizeof(void *),
+        (UINT32) sizeof(TRDP_XML_CONFIG_T),
+        (UINT32) sizeof(TRDP_XML_IF_SETTINGS_T),
+        (UINT32) sizeof(TRDP_MEM_CONFIG_T),
+        (UINT32) sizeof(TRDP_DBG_CONFIG_T),
+        (UINT32) sizeof(TRDP_COM_PAR_T),
+        (UINT32) sizeof(TRDP_IF_CONFIG_T),
+        (UINT32) sizeof(TRDP_PROCESS_CONFIG_T),
+        (UINT32) sizeof(TRDP_PD_CONFIG_T),
+        (UINT32) sizeof(TRDP_MD_CONFIG_T),
+        (UINT32) sizeof(TRDP_EXCHG_PAR_T),
+        (UINT32) sizeof(TRDP_PD_PAR_T),
+        (UINT32) sizeof(TRDP_MD_PAR_T),
+        (UINT32) sizeof(TRDP_DEST_T),
+        (UINT32) sizeof(TRDP_SRC_T),
+        (UINT32) sizeof(TRDP_SDT_PAR_T),
+        (UINT32) sizeof(TRDP_URI_USER_T),
+        (UINT32) sizeof(TRDP_COMID_DSID_MAP_T),
+        (UINT32) sizeof(TRDP_DATASET_T),
+        (UINT32) sizeof(TRDP_DATASET_ELEMENT_T),
+        (UINT32) sizeof(TRDP_SEND_PARAM_T),
+
+        CACHE_FIELD(TRDP_XML_CONFIG_T, memConfig),
+        CACHE_FIELD(TRDP_XML_CONFIG_T, dbgConfig),
+        CACHE_FIELD(TRDP_XML_CONFIG_T, numComPar),
+        CACHE_FIELD(TRDP_XML_CONFIG_T, pComPar),
+        CACHE_FIELD(TRDP_XML_CONFIG_T, numIfConfig),
+        CACHE_FIELD(TRDP_XML_CONFIG_T, pIfConfig),
+        CACHE_FIELD(TRDP_XML_CONFIG_T, pIfSettings),
+        CACHE_FIELD(TRDP_XML_CONFIG_T, numComId),
+        CACHE_FIELD(TRDP_XML_CONFIG_T, pComIdDsIdMap),
+        CACHE_FIELD(TRDP_XML_CONFIG_T, numDataset),
+        CACHE_FIELD(TRDP_XML_CONFIG_T, apDataset),
+        CACHE_FIELD(TRDP_XML_CONFIG_T, pImage),
+        CACHE_FIELD(TRDP_XML_CONFIG_T, imageSize),
+
+        CACHE_FIELD(TRDP_XML_IF_SETTINGS_T, processConfig),
+        CACHE_FIELD(TRDP_XML_IF_SETTINGS_T, pdConfig),
+        CACHE_FIELD(TRDP_XML_IF_SETTINGS_T, mdConfig),
+        CACHE_FIELD(TRDP_XML_IF_SETTINGS_T, numExchgPar),
+        CACHE_FIELD(TRDP_XML_IF_SETTINGS_T, pExchgPar),
+
+        CACHE_FIELD(TRDP_MEM_CONFIG_T, p),
+        CACHE_FIELD(TRDP_MEM_CONFIG_T, size),
+        CACHE_FIELD(TRDP_MEM_CONFIG_T, prealloc),
+
+        CACHE_FIELD(TRDP_DBG_CONFIG_T, option),
+        CACHE_FIELD(TRDP_DBG_CONFIG_T, maxFileSize),
+        CACHE_FIELD(TRDP_DBG_CONFIG_T, fileName),
+
+        CACHE_FIELD(TRDP_SEND_PARAM_T, qos),
+        CACHE_FIELD(TRDP_SEND_PARAM_T, ttl),
+        CACHE_FIELD(TRDP_SEND_PARAM_T, retries),
+        CACHE_FIELD(TRDP_SEND_PARAM_T, phased),
+        CACHE_FIELD(TRDP_SEND_PARAM_T, phase),
+
+        CACHE_FIELD(TRDP_COM_PAR_T, id),
+        CACHE_FIELD(TRDP_COM_PAR_T, sendParam),
+
+        CACHE_FIELD(TRDP_IF_CONFIG_T, ifName),
+        CACHE_FIELD(TRDP_IF_CONFIG_T, networkId),
+        CACHE_FIELD(TRDP_IF_CONFIG_T, hostIp),
+        CACHE_FIELD(TRDP_IF_CONFIG_T, leaderIp),
+
+        CACHE_FIELD(TRDP_PROCESS_CONFIG_T, hostName),
+        CACHE_FIELD(TRDP_PROCESS_CONFIG_T, leaderName),
+        CACHE_FIELD(TRDP_PROCESS_CONFIG_T, cycleTime),
+        CACHE_FIELD(TRDP_PROCESS_CONFIG_T, priority),
+        CACHE_FIELD(TRDP_PROCESS_CONFIG_T, options),
+
+        CACHE_FIELD(TRDP_PD_CONFIG_T, pfCbFunction),
+        CACHE_FIELD(TRDP_PD_CONFIG_T, pRefCon),
+        CACHE_FIELD(TRDP_PD_CONFIG_T, sendParam),
+        CACHE_FIELD(TRDP_PD_CONFIG_T, flags),
+        CACHE_FIELD(TRDP_PD_CONFIG_T, timeout),
+        CACHE_FIELD(TRDP_PD_CONFIG_T, toBehavior),
+        CACHE_FIELD(TRDP_PD_CONFIG_T, port),
+
+        CACHE_FIELD(TRDP_MD_CONFIG_T, pfCbFunction),
+        CACHE_FIELD(TRDP_MD_CONFIG_T, pRefCon),
+        CACHE_FIELD(TRDP_MD_CONFIG_T, sendParam),
+        CACHE_FIELD(TRDP_MD_CONFIG_T, flags),
+        CACHE_FIELD(TRDP_MD_CONFIG_T, replyTimeout),
+        CACHE_FIELD(TRDP_MD_CONFIG_T, confirmTimeout),
+        CACHE_FIELD(TRDP_MD_CONFIG_T, connectTimeout),
+        CACHE_FIELD(TRDP_MD_CONFIG_T, sendingTimeout),
+        CACHE_FIELD(TRDP_MD_CONFIG_T, udpPort),
+        CACHE_FIELD(TRDP_MD_CONFIG_T, tcpPort),
+        CACHE_FIELD(TRDP_MD_CONFIG_T, maxNumSessions),
+
+        CACHE_FIELD(TRDP_EXCHG_PAR_T, comId),
+        CACHE_FIELD(TRDP_EXCHG_PAR_T, datasetId),
+        CACHE_FIELD(TRDP_EXCHG_PAR_T, comParId),
+        CACHE_FIELD(TRDP_EXCHG_PAR_T, pMdPar),
+        CACHE_FIELD(TRDP_EXCHG_PAR_T, pPdPar),
+        CACHE_FIELD(TRDP_EXCHG_PAR_T, destCnt),
+        CACHE_FIELD(TRDP_EXCHG_PAR_T, pDest),
+        CACHE_FIELD(TRDP_EXCHG_PAR_T, srcCnt),
+        CACHE_FIELD(TRDP_EXCHG_PAR_T, pSrc),
+        CACHE_FIELD(TRDP_EXCHG_PAR_T, type),
+        CACHE_FIELD(TRDP_EXCHG_PAR_T, create),
+
+        CACHE_FIELD(TRDP_PD_PAR_T, cycle),
+        CACHE_FIELD(TRDP_PD_PAR_T, redundant),
+        CACHE_FIELD(TRDP_PD_PAR_T, timeout),
+        CACHE_FIELD(TRDP_PD_PAR_T, toBehav),
+        CACHE_FIELD(TRDP_PD_PAR_T, flags),
+        CACHE_FIELD(TRDP_PD_PAR_T, offset),
+        CACHE_FIELD(TRDP_PD_PAR_T, phase),
+        CACHE_FIELD(TRDP_PD_PAR_T, phased),
+
+        CACHE_FIELD(TRDP_MD_PAR_T, confirmTimeout),
+        CACHE_FIELD(TRDP_MD_PAR_T, replyTimeout),
+        CACHE_FIELD(TRDP_MD_PAR_T, flags),
+
+        CACHE_FIELD(TRDP_DEST_T, id),
+        CACHE_FIELD(TRDP_DEST_T, pSdtPar),
+        CACHE_FIELD(TRDP_DEST_T, pUriUser),
+        CACHE_FIELD(TRDP_DEST_T, pUriHost),
+
+        CACHE_FIELD(TRDP_SRC_T, id),
+        CACHE_FIELD(TRDP_SRC_T, pSdtPar),
+        CACHE_FIELD(TRDP_SRC_T, pUriUser),
+        CACHE_FIELD(TRDP_SRC_T, pUriHost1),
+        CACHE_FIELD(TRDP_SRC_T, pUriHost2),
+
+        CACHE_FIELD(TRDP_SDT_PAR_T, smi1),
+        CACHE_FIELD(TRDP_SDT_PAR_T, smi2),
+        CACHE_FIELD(TRDP_SDT_PAR_T, cmThr),
+        CACHE_FIELD(TRDP_SDT_PAR_T, udv),
+        CACHE_FIELD(TRDP_SDT_PAR_T, rxPeriod),
+        CACHE_FIELD(TRDP_SDT_PAR_T, txPeriod),
+        CACHE_FIELD(TRDP_SDT_PAR_T, nGuard),
+        CACHE_FIELD(TRDP_SDT_PAR_T, nrxSafe),
+        CACHE_FIELD(TRDP_SDT_PAR_T, reserved1),
+        CACHE_FIELD(TRDP_SDT_PAR_T, reserved2),
+
+        CACHE_FIELD(TRDP_COMID_DSID_MAP_T, comId),
+        CACHE_FIELD(TRDP_COMID_DSID_MAP_T, datasetId),
+
+        CACHE_FIELD(TRDP_DATASET_T, id),
+        CACHE_FIELD(TRDP_DATASET_T, reserved1),
+        CACHE_FIELD(TRDP_DATASET_T, numElement),
+        CACHE_FIELD(TRDP_DATASET_T, pElement),
+
+        CACHE_FIELD(TRDP_DATASET_ELEMENT_T, type),
+        CACHE_FIELD(TRDP_DATASET_ELEMENT_T, size),
+        CACHE_FIELD(TRDP_DATASET_ELEMENT_T, name),
+        CACHE_FIELD(TRDP_DATASET_ELEMENT_T, unit),
+        CACHE_FIELD(TRDP_DATASET_ELEMENT_T, scale),
+        CACHE_FIELD(TRDP_DATASET_ELEMENT_T, offset),
+        CACHE_FIELD(TRDP_DATASET_ELEMENT_T, pCachedDS)
+    };
+
+    return vos_crc32(0xFFFFFFFFu, (const UINT8 *) layout, (UINT32) sizeof(layout));
+}
+
+/**********************************************************************************************************************/
+/** Get size and modification time of the XML file.
+ *
+ *  @param[in]      pXmlFileName    XML file
+ *  @param[out]     pSize           file size
+ *  @param[out]     pTime           modification time in ns (s on platforms without sub-second time stamps)
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_IO_ERR     file not existing
+ */
+static TRDP_ERR_T cacheXmlStat (
+    const CHAR8 *pXmlFileName,
+    UINT64      *pSize,
+    INT64       *pTime)
+{
+    struct stat fileStat;
+
+    if (stat(pXmlFileName, &fileStat) != 0)
+    {
+        return TRDP_IO_ERR;
+    }
+    *pSize  = (UINT64) fileStat.st_size;
+#if defined (__APPLE__)
+    *pTime  = (INT64) fileStat.st_mtimespec.tv_sec * 1000000000 + (INT64) fileStat.st_mtimespec.tv_nsec;
+#elif defined (POSIX)
+    *pTime  = (INT64) fileStat.st_mtim.tv_sec * 1000000000 + (INT64) fileStat.st_mtim.tv_nsec;
+#else
+    *pTime  = (INT64) fileStat.st_mtime * 1000000000;
+#endif
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the CRC of the XML file.
+ *  The time alone misses edits within its resolution and files restored with their old time, the CRC does not.
+ *  The whole file is read, this is more than half of the load time of an up to date image (1 MB XML file: 3 ms of
+ *  5.5 ms, parsing it takes 8 ms); call it only if size and modification time match.
+ *
+ *  @param[in]      pXmlFileName    XML file
+ *  @param[out]     pCrc            CRC of the file
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_IO_ERR     file not existing or not readable
+ */
+static TRDP_ERR_T cacheXmlCrc (
+    const CHAR8 *pXmlFileName,
+    UINT32      *pCrc)
+{
+    FILE        *pFile;
+    UINT8       buf[TAU_CONFIG_XML_CHUNK];
+    UINT32      crc = 0xFFFFFFFFu;
+    size_t      len;
+    TRDP_ERR_T  err;
+
+    pFile = fopen(pXmlFileName, "rb");
+    if (pFile == NULL)
+    {
+        return TRDP_IO_ERR;
+    }
+    while ((len = fread(buf, 1u, sizeof(buf), pFile)) > 0u)
+    {
+        crc = ~vos_crc32(crc, buf, (UINT32) len);     /* vos_crc32 returns the final (inverted) value */
+    }
+    err = (ferror(pFile) == 0) ? TRDP_NO_ERR : TRDP_IO_ERR;
+    (void) fclose(pFile);
+    *pCrc = ~crc;
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Append a block to the image.
+ *
+ *  @param[in]      pWriter         image under construction
+ *  @param[in]      pData           data to copy, NULL: nothing
+ *  @param[in]      size            size of data
+ *
+ *  @retval         offset of the block in the image, 0 for none
+ */
+static UINT32 cacheAdd (
+    TAU_CONFIG_WRITER_T *pWriter,
+    const void          *pData,
+    UINT32              size)
+{
+    UINT32 offset;
+
+    if ((pData == NULL) || (size == 0u))
+    {
+        return 0u;
+    }
+    offset = (pWriter->size + TAU_CONFIG_IMAGE_ALIGN - 1u) & ~(TAU_CONFIG_IMAGE_ALIGN - 1u);
+    if (pWriter->pBuf != NULL)
+    {
+        memcpy(pWriter->pBuf + offset, pData, size);
+    }
+    pWriter->size = offset + size;
+    return offset;
+}
+
+/**********************************************************************************************************************/
+/** Append a string to the image.
+ *
+ *  @param[in]      pWriter         image under construction
+ *  @param[in]      pStr            string, NULL: nothing
+ *  @param[in]      minSize         minimal size of the block (size of the buffer the string was read into)
+ *
+ *  @retval         offset of the string in the image, 0 for none
+ */
+static UINT32 cacheAddString (
+    TAU_CONFIG_WRITER_T *pWriter,
+    const CHAR8         *pStr,
+    UINT32              minSize)
+{
+    UINT32  len;
+    UINT32  offset;
+
+    if (pStr == NULL)
+    {
+        return 0u;
+    }
+    len     = (UINT32) strlen(pStr) + 1u;
+    offset  = cacheAdd(pWriter, pStr, len);
+    if (len < minSize)
+    {
+        if (pWriter->pBuf != NULL)
+        {
+            memset(pWriter->pBuf + offset + len, 0, minSize - len);
+        }
+        pWriter->size = offset + minSize;
+    }
+    return offset;
+}
+
+/**********************************************************************************************************************/
+/** Store the offset of a block into a pointer field of the image.
+ *
+ *  @param[in]      pWriter         image under construction
+ *  @param[in]      fieldOffset     offset of the pointer field in the image
+ *  @param[in]      target          offset of the block pointed to, 0 for NULL
+ */
+static void cacheLink (
+    TAU_CONFIG_WRITER_T *pWriter,
+    UINT32              fieldOffset,
+    UINT32              target)
+{
+    if (pWriter->pBuf != NULL)
+    {
+        void *p = (void *) (size_t) target;
+        memcpy(pWriter->pBuf + fieldOffset, &p, sizeof(p));
+    }
+}
+
+/**********************************************************************************************************************/
+/** Serialise a configuration, same sequence for computing the size and for writing.
+ *
+ *  @param[in]      pWriter         image under construction
+ *  @param[in]      pConfig         configuration
+ *
+ *  @retval         offset of the TRDP_XML_CONFIG_T in the image
+ */
+static UINT32 cacheSerialise (
+    TAU_CONFIG_WRITER_T     *pWriter,
+    const TRDP_XML_CONFIG_T *pConfig)
+{
+    UINT32  cfg, ifs, ex, dest, src, ap, ds;
+    UINT32  i, j, k;
+
+    cfg = cacheAdd(pWriter, pConfig, sizeof(TRDP_XML_CONFIG_T));
+    cacheLink(pWriter, cfg + offsetof(TRDP_XML_CONFIG_T, memConfig.p), 0u);
+    cacheLink(pWriter, cfg + offsetof(TRDP_XML_CONFIG_T, pImage), 0u);
+    cacheLink(pWriter, cfg + offsetof(TRDP_XML_CONFIG_T, pComPar),
+              cacheAdd(pWriter, pConfig->pComPar, pConfig->numComPar * sizeof(TRDP_COM_PAR_T)));
+    cacheLink(pWriter, cfg + offsetof(TRDP_XML_CONFIG_T, pIfConfig),
+              cacheAdd(pWriter, pConfig->pIfConfig, pConfig->numIfConfig * sizeof(TRDP_IF_CONFIG_T)));
+    cacheLink(pWriter, cfg + offsetof(TRDP_XML_CONFIG_T, pComIdDsIdMap),
+              cacheAdd(pWriter, pConfig->pComIdDsIdMap, pConfig->numComId * sizeof(TRDP_COMID_DSID_MAP_T)));
+
+    /*  Interfaces and their telegrams  */
+    ifs = cacheAdd(pWriter, pConfig->pIfSettings, pConfig->numIfConfig * sizeof(TRDP_XML_IF_SETTINGS_T));
+    cacheLink(pWriter, cfg + offsetof(TRDP_XML_CONFIG_T, pIfSettings), ifs);
+    for (i = 0u; (pConfig->pIfSettings != NULL) && (i < pConfig->numIfConfig); i++)
+    {
+        const TRDP_XML_IF_SETTINGS_T    *pIf    = &pConfig->pIfSettings[i];
+        const UINT32                    ifOff   = ifs + i * sizeof(TRDP_XML_IF_SETTINGS_T);
+
+        cacheLink(pWriter, ifOff + offsetof(TRDP_XML_IF_SETTINGS_T, pdConfig.pfCbFunction), 0u);
+        cacheLink(pWriter, ifOff + offsetof(TRDP_XML_IF_SETTINGS_T, pdConfig.pRefCon), 0u);
+        cacheLink(pWriter, ifOff + offsetof(TRDP_XML_IF_SETTINGS_T, mdConfig.pfCbFunction), 0u);
+        cacheLink(pWriter, ifOff + offsetof(TRDP_XML_IF_SETTINGS_T, mdConfig.pRefCon), 0u);
+
+        ex = cacheAdd(pWriter, pIf->pExchgPar, pIf->numExchgPar * sizeof(TRDP_EXCHG_PAR_T));
+        cacheLink(pWriter, ifOff + offsetof(TRDP_XML_IF_SETTINGS_T, pExchgPar), ex);
+        for (j = 0u; (pIf->pExchgPar != NULL) && (j < pIf->numExchgPar); j++)
+        {
+            const TRDP_EXCHG_PAR_T  *pEx    = &pIf->pExchgPar[j];
+            const UINT32            exOff   = ex + j * sizeof(TRDP_EXCHG_PAR_T);
+
+            cacheLink(pWriter, exOff + offsetof(TRDP_EXCHG_PAR_T, pMdPar),
+                      cacheAdd(pWriter, pEx->pMdPar, sizeof(TRDP_MD_PAR_T)));
+            cacheLink(pWriter, exOff + offsetof(TRDP_EXCHG_PAR_T, pPdPar),
+                      cacheAdd(pWriter, pEx->pPdPar, sizeof(TRDP_PD_PAR_T)));
+
+            dest = cacheAdd(pWriter, pEx->pDest, pEx->destCnt * sizeof(TRDP_DEST_T));
+            cacheLink(pWriter, exOff + offsetof(TRDP_EXCHG_PAR_T, pDest), dest);
+            for (k = 0u; (pEx->pDest != NULL) && (k < pEx->destCnt); k++)
+            {
+                const TRDP_DEST_T   *pDest  = &pEx->pDest[k];
+                const UINT32        dOff    = dest + k * sizeof(TRDP_DEST_T);
+
+                cacheLink(pWriter, dOff + offsetof(TRDP_DEST_T, pSdtPar),
+                          cacheAdd(pWriter, pDest->pSdtPar, sizeof(TRDP_SDT_PAR_T)));
+                cacheLink(pWriter, dOff + offsetof(TRDP_DEST_T, pUriUser),
+                          cacheAddString(pWriter, (const CHAR8 *) pDest->pUriUser, sizeof(TRDP_URI_USER_T)));
+                cacheLink(pWriter, dOff + offsetof(TRDP_DEST_T, pUriHost),
+                          cacheAddString(pWriter, (const CHAR8 *) pDest->pUriHost, 0u));
+            }
+
+            src = cacheAdd(pWriter, pEx->pSrc, pEx->srcCnt * sizeof(TRDP_SRC_T));
+            cacheLink(pWriter, exOff + offsetof(TRDP_EXCHG_PAR_T, pSrc), src);
+            for (k = 0u; (pEx->pSrc != NULL) && (k < pEx->srcCnt); k++)
+            {
+                const TRDP_SRC_T    *pSrc   = &pEx->pSrc[k];
+                const UINT32        sOff    = src + k * sizeof(TRDP_SRC_T);
+
+                cacheLink(pWriter, sOff + offsetof(TRDP_SRC_T, pSdtPar),
+                          cacheAdd(pWriter, pSrc->pSdtPar, sizeof(TRDP_SDT_PAR_T)));
+                cacheLink(pWriter, sOff + offsetof(TRDP_SRC_T, pUriUser),
+                          cacheAddString(pWriter, (const CHAR8 *) pSrc->pUriUser, sizeof(TRDP_URI_USER_T)));
+                cacheLink(pWriter, sOff + offsetof(TRDP_SRC_T, pUriHost1),
+                          cacheAddString(pWriter, (const CHAR8 *) pSrc->pUriHost1, 0u));
+                cacheLink(pWriter, sOff + offsetof(TRDP_SRC_T, pUriHost2),
+                          cacheAddString(pWriter, (const CHAR8 *) pSrc->pUriHost2, 0u));
+            }
+        }
+    }
+
+    /*  Datasets    */
+    ap = cacheAdd(pWriter, pConfig->apDataset, pConfig->numDataset * sizeof(pTRDP_DATASET_T));
+    cacheLink(pWriter, cfg + offsetof(TRDP_XML_CONFIG_T, apDataset), ap);
+    for (i = 0u; (pConfig->apDataset != NULL) && (i < pConfig->numDataset); i++)
+    {
+        const TRDP_DATASET_T *pDataset = pConfig->apDataset[i];
+
+        ds = cacheAdd(pWriter, pDataset,
+                      (pDataset == NULL) ? 0u :
+                      sizeof(TRDP_DATASET_T) + pDataset->numElement * sizeof(TRDP_DATASET_ELEMENT_T));
+        cacheLink(pWriter, ap + i * sizeof(pTRDP_DATASET_T), ds);
+        for (j = 0u; (pDataset != NULL) && (j < pDataset->numElement); j++)
+        {
+            const UINT32 elOff = ds + sizeof(TRDP_DATASET_T) + j * sizeof(TRDP_DATASET_ELEMENT_T);
+
+            cacheLink(pWriter, elOff + offsetof(TRDP_DATASET_ELEMENT_T, name),
+                      cacheAddString(pWriter, pDataset->pElement[j].name, 0u));
+            cacheLink(pWriter, elOff + offsetof(TRDP_DATASET_ELEMENT_T, unit),
+                      cacheAddString(pWriter, pDataset->pElement[j].unit, 0u));
+            cacheLink(pWriter, elOff + offsetof(TRDP_DATASET_ELEMENT_T, pCachedDS), 0u);
+        }
+    }
+    return cfg;
+}
+
+/**********************************************************************************************************************/
+/** Turn the offset in a pointer field of the image into a pointer.
+ *
+ *  @param[in]      pBase           start of the image
+ *  @param[in]      size            size of the image
+ *  @param[in,out]  pField          pointer field
+ *  @param[in]      count           number of elements pointed to
+ *  @param[in]      elemSize        size of one element
+ *
+ *  @retval         TRUE            relocated (or NULL)
+ *  @retval         FALSE           target outside of the image
+ */
+static BOOL8 cacheReloc (
+    UINT8   *pBase,
+    UINT32  size,
+    void    *pField,
+    UINT32  count,
+    UINT32  elemSize)
+{
+    void    *p;
+    size_t  offset;
+
+    memcpy(&p, pField, sizeof(p));
+    offset = (size_t) p;
+    if (offset == 0u)
+    {
+        return TRUE;
+    }
+    if ((offset >= size) || ((UINT64) count * elemSize > (UINT64) (size - offset)))
+    {
+        return FALSE;
+    }
+    p = pBase + offset;
+    memcpy(pField, &p, sizeof(p));
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Relocate a string in the image, it must be terminated inside the image.
+ *
+ *  @param[in]      pBase           start of the image
+ *  @param[in]      size            size of the image
+ *  @param[in,out]  pField          pointer field
+ *
+ *  @retval         TRUE            relocated (or NULL)
+ *  @retval         FALSE           string outside of the image
+ */
+static BOOL8 cacheRelocString (
+    UINT8   *pBase,
+    UINT32  size,
+    void    *pField)
+{
+    CHAR8 *pStr;
+
+    if (cacheReloc(pBase, size, pField, 1u, 1u) == FALSE)
+    {
+        return FALSE;
+    }
+    memcpy(&pStr, pField, sizeof(pStr));
+    return ((pStr == NULL) || (memchr(pStr, 0, (size_t) (pBase + size - (UINT8 *) pStr)) != NULL)) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Relocate all pointers of the configuration in the image.
+ *
+ *  @param[in]      pBase           start of the image
+ *  @param[in]      size            size of the image
+ *  @param[in]      pConfig         configuration inside the image
+ *
+ *  @retval         TRUE            relocated
+ *  @retval         FALSE           image damaged
+ */
+static BOOL8 cacheRelocate (
+    UINT8               *pBase,
+    UINT32              size,
+    TRDP_XML_CONFIG_T   *pConfig)
+{
+    UINT32  i, j, k;
+    BOOL8   ok;
+
+    ok = cacheReloc(pBase, size, &pConfig->pComPar, pConfig->numComPar, sizeof(TRDP_COM_PAR_T)) &&
+         cacheReloc(pBase, size, &pConfig->pIfConfig, pConfig->numIfConfig, sizeof(TRDP_IF_CONFIG_T)) &&
+         cacheReloc(pBase, size, &pConfig->pIfSettings, pConfig->numIfConfig, sizeof(TRDP_XML_IF_SETTINGS_T)) &&
+         cacheReloc(pBase, size, &pConfig->pComIdDsIdMap, pConfig->numComId, sizeof(TRDP_COMID_DSID_MAP_T)) &&
+         cacheReloc(pBase, size, &pConfig->apDataset, pConfig->numDataset, sizeof(pTRDP_DATASET_T));
+
+    for (i = 0u; ok && (pConfig->pIfSettings != NULL) && (i < pConfig->numIfConfig); i++)
+    {
+        TRDP_XML_IF_SETTINGS_T *pIf = &pConfig->pIfSettings[i];
+
+        ok = cacheReloc(pBase, size, &pIf->pExchgPar, pIf->numExchgPar, sizeof(TRDP_EXCHG_PAR_T));
+        for (j = 0u; ok && (pIf->pExchgPar != NULL) && (j < pIf->numExchgPar); j++)
+        {
+            TRDP_EXCHG_PAR_T *pEx = &pIf->pExchgPar[j];
+
+            ok = cacheReloc(pBase, size, &pEx->pMdPar, 1u, sizeof(TRDP_MD_PAR_T)) &&
+                 cacheReloc(pBase, size, &pEx->pPdPar, 1u, sizeof(TRDP_PD_PAR_T)) &&
+                 cacheReloc(pBase, size, &pEx->pDest, pEx->destCnt, sizeof(TRDP_DEST_T)) &&
+                 cacheReloc(pBase, size, &pEx->pSrc, pEx->srcCnt, sizeof(TRDP_SRC_T));
+            for (k = 0u; ok && (pEx->pDest != NULL) && (k < pEx->destCnt); k++)
+            {
+                ok = cacheReloc(pBase, size, &pEx->pDest[k].pSdtPar, 1u, sizeof(TRDP_SDT_PAR_T)) &&
+                     cacheRelocString(pBase, size, &pEx->pDest[k].pUriUser) &&
+                     cacheRelocString(pBase, size, &pEx->pDest[k].pUriHost);
+            }
+            for (k = 0u; ok && (pEx->pSrc != NULL) && (k < pEx->srcCnt); k++)
+            {
+                ok = cacheReloc(pBase, size, &pEx->pSrc[k].pSdtPar, 1u, sizeof(TRDP_SDT_PAR_T)) &&
+                     cacheRelocString(pBase, size, &pEx->pSrc[k].pUriUser) &&
+                     cacheRelocString(pBase, size, &pEx->pSrc[k].pUriHost1) &&
+                     cacheRelocString(pBase, size, &pEx->pSrc[k].pUriHost2);
+            }
+        }
+    }
+
+    for (i = 0u; ok && (pConfig->apDataset != NULL) && (i < pConfig->numDataset); i++)
+    {
+        TRDP_DATASET_T *pDataset;
+
+        ok = cacheReloc(pBase, size, &pConfig->apDataset[i], 1u, sizeof(TRDP_DATASET_T));
+        pDataset = pConfig->apDataset[i];
+        if (ok && (pDataset != NULL))
+        {
+            /*  The elements follow the dataset header, check they are inside, too   */
+            ok = ((UINT64) ((UINT8 *) pDataset - pBase) + sizeof(TRDP_DATASET_T) +
+                  (UINT64) pDataset->numElement * sizeof(TRDP_DATASET_ELEMENT_T) <= size) ? TRUE : FALSE;
+        }
+        for (j = 0u; ok && (pDataset != NULL) && (j < pDataset->numElement); j++)
+        {
+            ok = cacheRelocString(pBase, size, &pDataset->pElement[j].name) &&
+                 cacheRelocString(pBase, size, &pDataset->pElement[j].unit);
+        }
+    }
+    return ok;
+}
+
+/**********************************************************************************************************************/
+/** Release the memory of an image.
+ *
+ *  @param[in]      pImage          image
+ *  @param[in]      size            size of the image
+ */
+static void cacheUnmap (
+    void    *pImage,
+    UINT32  size)
+{
+#ifdef POSIX
+    (void) munmap(pImage, size);
+#else
+    (void) size;
+    free(pImage);
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Load, check and relocate an image.
+ *
+ *  @param[in]      pXmlFileName    XML file the image must be up to date with, NULL: no check
+ *  @param[in]      pImageFileName  image file
+ *  @param[out]     pConfig         configuration
+ *
+ *  @retval         TRDP_NO_ERR     image loaded
+ *  @retval         TRDP_IO_ERR     image not readable
+ *  @retval         TRDP_PARAM_ERR  image of other version or platform, or stale
+ *  @retval         TRDP_CRC_ERR    image damaged
+ */
+static TRDP_ERR_T cacheLoadImage (
+    const CHAR8         *pXmlFileName,
+    const CHAR8         *pImageFileName,
+    TRDP_XML_CONFIG_T   *pConfig)
+{
+    const TAU_CONFIG_IMAGE_HEADER_T *pHeader;
+    UINT8                           *pImage = NULL;
+    UINT32                          size;
+    UINT64                          xmlSize = 0u;
+    INT64                           xmlTime = 0;
+    UINT32                          xmlCrc  = 0u;
+    TRDP_ERR_T                      err;
+
+    if ((pXmlFileName != NULL) && (cacheXmlStat(pXmlFileName, &xmlSize, &xmlTime) != TRDP_NO_ERR))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+#ifdef POSIX
+    {
+        struct stat fileStat;
+        int         fd = open(pImageFileName, O_RDONLY);
+
+        if (fd == -1)
+        {
+            return TRDP_IO_ERR;
+        }
+        if ((fstat(fd, &fileStat) == -1) || (fileStat.st_size < (off_t) sizeof(TAU_CONFIG_IMAGE_HEADER_T)) ||
+            (fileStat.st_size > (off_t) 0x7FFFFFFF))
+        {
+            (void) close(fd);
+            return TRDP_IO_ERR;
+        }
+        size = (UINT32) fileStat.st_size;
+
+        /*  Private, writable mapping: the pointers are relocated in place, the file is not changed  */
+        pImage = (UINT8 *) mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        (void) close(fd);
+        if ((void *) pImage == MAP_FAILED)
+        {
+            return TRDP_IO_ERR;
+        }
+    }
+#else
+    {
+        FILE    *pFile = fopen(pImageFileName, "rb");
+        long    fileSize;
+
+        if (pFile == NULL)
+        {
+            return TRDP_IO_ERR;
+        }
+        if ((fseek(pFile, 0, SEEK_END) != 0) || ((fileSize = ftell(pFile)) < (long) sizeof(TAU_CONFIG_IMAGE_HEADER_T)) ||
+            (fseek(pFile, 0, SEEK_SET) != 0))
+        {
+            (void) fclose(pFile);
+            return TRDP_IO_ERR;
+        }
+        size = (UINT32) fileSize;
+
+        /*  The image may exceed the largest block of the VOS memory pool, it is held on the heap  */
+        pImage = (UINT8 *) malloc(size);
+        if ((pImage == NULL) || (fread(pImage, 1u, size, pFile) != size))
+        {
+            free(pImage);
+            (void) fclose(pFile);
+            return TRDP_IO_ERR;
+        }
+        (void) fclose(pFile);
+    }
+#endif
+
+    pHeader = (const TAU_CONFIG_IMAGE_HEADER_T *) pImage;
+    if ((memcmp(pHeader->magic, TAU_CONFIG_IMAGE_MAGIC, sizeof(TAU_CONFIG_IMAGE_MAGIC)) != 0) ||
+        (pHeader->version != TAU_CONFIG_IMAGE_VERSION) ||
+        (pHeader->byteOrder != TAU_CONFIG_IMAGE_ORDER) ||
+        (pHeader->libVersion != TAU_CONFIG_LIB_VERSION) ||
+        (pHeader->layout != cacheLayout()) ||
+        (pHeader->headerSize != sizeof(TAU_CONFIG_IMAGE_HEADER_T)) ||
+        (pHeader->imageSize != size) ||
+        (pHeader->configOffset < pHeader->headerSize) ||
+        (pHeader->configOffset > size - sizeof(TRDP_XML_CONFIG_T)))
+    {
+        err = TRDP_PARAM_ERR;
+    }
+    else if ((pXmlFileName != NULL) &&
+             ((pHeader->xmlSize != xmlSize) || (pHeader->xmlTime != xmlTime) ||
+              (cacheXmlCrc(pXmlFileName, &xmlCrc) != TRDP_NO_ERR) || (pHeader->xmlCrc != xmlCrc)))
+    {
+        err = TRDP_PARAM_ERR;   /* stale, the file is read for the CRC only if size and time match */
+    }
+    else if (vos_crc32(0xFFFFFFFFu, pImage + pHeader->headerSize, size - pHeader->headerSize) != pHeader->crc)
+    {
+        err = TRDP_CRC_ERR;
+    }
+    else
+    {
+        TRDP_XML_CONFIG_T *pImageConfig = (TRDP_XML_CONFIG_T *) (pImage + pHeader->configOffset);
+
+        err = (cacheRelocate(pImage, size, pImageConfig) == TRUE) ? TRDP_NO_ERR : TRDP_CRC_ERR;
+        if (err == TRDP_NO_ERR)
+        {
+            *pConfig            = *pImageConfig;
+            pConfig->pImage     = pImage;
+            pConfig->imageSize  = size;
+        }
+    }
+
+    if (err != TRDP_NO_ERR)
+    {
+        cacheUnmap(pImage, size);
+    }
+    return err;
+}
+
+/******************************************************************************
+ *   Globals
+ */
+
+/**********************************************************************************************************************/
+/**    Read the complete configuration (device, datasets and all interfaces) out of the XML configuration file.
+ *
+ *  @param[in]      pFileName         Path and filename of the xml configuration file
+ *  @param[out]     pConfig           Configuration, to be released by tau_freeConfig
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *  @retval         TRDP_PARAM_ERR    File not existing
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_readXmlConfig (
+    const CHAR8         *pFileName,
+    TRDP_XML_CONFIG_T   *pConfig)
+{
+    TRDP_XML_DOC_HANDLE_T   docHnd;
+    TRDP_ERR_T              err;
+    UINT32                  i;
+
+    if (pConfig == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    memset(pConfig, 0, sizeof(TRDP_XML_CONFIG_T));
+
+    err = tau_prepareXmlDoc(pFileName, &docHnd);
+    if (err != TRDP_NO_ERR)
+    {
+        return err;
+    }
+
+    err = tau_readXmlDeviceConfig(&docHnd, &pConfig->memConfig, &pConfig->dbgConfig,
+                                  &pConfig->numComPar, &pConfig->pComPar,
+                                  &pConfig->numIfConfig, &pConfig->pIfConfig);
+    if (err == TRDP_NO_ERR)
+    {
+        err = tau_readXmlDatasetConfig(&docHnd, &pConfig->numComId, &pConfig->pComIdDsIdMap,
+                                       &pConfig->numDataset, &pConfig->apDataset);
+    }
+    if ((err == TRDP_NO_ERR) && (pConfig->numIfConfig > 0u))
+    {
+        pConfig->pIfSettings = (TRDP_XML_IF_SETTINGS_T *) vos_memAlloc(pConfig->numIfConfig *
+                                                                       sizeof(TRDP_XML_IF_SETTINGS_T));
+        if (pConfig->pIfSettings == NULL)
+        {
+            err = TRDP_MEM_ERR;
+        }
+    }
+    for (i = 0u; (err == TRDP_NO_ERR) && (i < pConfig->numIfConfig); i++)
+    {
+        TRDP_XML_IF_SETTINGS_T *pIf = &pConfig->pIfSettings[i];
+
+        err = tau_readXmlInterfaceConfig(&docHnd, pConfig->pIfConfig[i].ifName, &pIf->processConfig,
+                                         &pIf->pdConfig, &pIf->mdConfig, &pIf->numExchgPar, &pIf->pExchgPar);
+    }
+
+    tau_freeXmlDoc(&docHnd);
+    if (err != TRDP_NO_ERR)
+    {
+        tau_freeConfig(pConfig);
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    Write a configuration into a binary image file.
+ *
+ *  @param[in]      pConfig           Configuration, from tau_readXmlConfig
+ *  @param[in]      pXmlFileName      XML file the configuration was read from
+ *  @param[in]      pImageFileName    Path and filename of the image to be written
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    parameter error
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *  @retval         TRDP_IO_ERR       XML file not existing or image not writable
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_writeConfigImage (
+    const TRDP_XML_CONFIG_T *pConfig,
+    const CHAR8             *pXmlFileName,
+    const CHAR8             *pImageFileName)
+{
+    TAU_CONFIG_WRITER_T         writer;
+    TAU_CONFIG_IMAGE_HEADER_T   header;
+    UINT32                      configOffset;
+    CHAR8                       tmpName[TRDP_MAX_FILE_NAME_LEN + 8u];
+    FILE                        *pFile;
+    TRDP_ERR_T                  err = TRDP_NO_ERR;
+
+    if ((pConfig == NULL) || (pXmlFileName == NULL) || (pImageFileName == NULL) ||
+        (strlen(pImageFileName) > TRDP_MAX_FILE_NAME_LEN))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    memset(&header, 0, sizeof(header));
+    if ((cacheXmlStat(pXmlFileName, &header.xmlSize, &header.xmlTime) != TRDP_NO_ERR) ||
+        (cacheXmlCrc(pXmlFileName, &header.xmlCrc) != TRDP_NO_ERR))
+    {
+        return TRDP_IO_ERR;
+    }
+
+    /*  First pass computes the size, second pass writes    */
+    writer.pBuf = NULL;
+    writer.size = sizeof(TAU_CONFIG_IMAGE_HEADER_T);
+    (void) cacheSerialise(&writer, pConfig);
+
+    /*  Written offline or once after a configuration change, the image is held on the heap  */
+    writer.pBuf = (UINT8 *) calloc(1u, writer.size);
+    if (writer.pBuf == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    writer.size     = sizeof(TAU_CONFIG_IMAGE_HEADER_T);
+    configOffset    = cacheSerialise(&writer, pConfig);
+
+    memcpy(header.magic, TAU_CONFIG_IMAGE_MAGIC, sizeof(TAU_CONFIG_IMAGE_MAGIC));
+    header.version      = TAU_CONFIG_IMAGE_VERSION;
+    header.byteOrder    = TAU_CONFIG_IMAGE_ORDER;
+    header.libVersion   = TAU_CONFIG_LIB_VERSION;
+    header.layout       = cacheLayout();
+    header.headerSize   = sizeof(TAU_CONFIG_IMAGE_HEADER_T);
+    header.imageSize    = writer.size;
+    header.configOffset = configOffset;
+    header.crc          = vos_crc32(0xFFFFFFFFu, writer.pBuf + header.headerSize, writer.size - header.headerSize);
+    memcpy(writer.pBuf, &header, sizeof(header));
+
+    /*  Write a temporary file and rename it, a reader never sees a half written image */
+    (void) snprintf(tmpName, sizeof(tmpName), "%s.tmp", pImageFileName);
+    pFile = fopen(tmpName, "wb");
+    if (pFile == NULL)
+    {
+        err = TRDP_IO_ERR;
+    }
+    else
+    {
+        if (fwrite(writer.pBuf, 1u, writer.size, pFile) != writer.size)
+        {
+            err = TRDP_IO_ERR;
+        }
+        if (fclose(pFile) != 0)
+        {
+            err = TRDP_IO_ERR;
+        }
+#ifndef POSIX
+        if (err == TRDP_NO_ERR)
+        {
+            (void) remove(pImageFileName);
+        }
+#endif
+        if ((err != TRDP_NO_ERR) || (rename(tmpName, pImageFileName) != 0))
+        {
+            (void) remove(tmpName);
+            err = TRDP_IO_ERR;
+        }
+    }
+
+    free(writer.pBuf);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    Load the complete configuration, from the binary image if it is valid and up to date, else from XML.
+ *
+ *  @param[in]      pXmlFileName      Path and filename of the xml configuration file, NULL: use the image
+ *                                    without checking it against the XML file
+ *  @param[in]      pImageFileName    Path and filename of the binary image, NULL: read XML
+ *  @param[out]     pConfig           Configuration, to be released by tau_freeConfig
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *  @retval         TRDP_PARAM_ERR    no usable image and XML file not existing
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_loadConfig (
+    const CHAR8         *pXmlFileName,
+    const CHAR8         *pImageFileName,
+    TRDP_XML_CONFIG_T   *pConfig)
+{
+    TRDP_ERR_T err;
+
+    if ((pConfig == NULL) || ((pXmlFileName == NULL) && (pImageFileName == NULL)))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    memset(pConfig, 0, sizeof(TRDP_XML_CONFIG_T));
+
+    if (pImageFileName != NULL)
+    {
+        err = cacheLoadImage(pXmlFileName, pImageFileName, pConfig);
+        if (err == TRDP_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_INFO, "Configuration loaded from image %s\n", pImageFileName);
+            return TRDP_NO_ERR;
+        }
+        if (pXmlFileName == NULL)
+        {
+            return TRDP_PARAM_ERR;
+        }
+        vos_printLog(VOS_LOG_WARNING, "Configuration image %s not usable (%d), reading %s\n",
+                     pImageFileName, err, pXmlFileName);
+    }
+    return tau_readXmlConfig(pXmlFileName, pConfig);
+}
+
+/**********************************************************************************************************************/
+/**    Release a configuration read by tau_readXmlConfig or tau_loadConfig
+ *
+ *  @param[in]      pConfig           Configuration
+ *
+ */
+EXT_DECL void tau_freeConfig (
+    TRDP_XML_CONFIG_T *pConfig)
+{
+    UINT32 i;
+
+    if (pConfig == NULL)
+    {
+        return;
+    }
+    if (pConfig->pImage != NULL)
+    {
+        cacheUnmap(pConfig->pImage, pConfig->imageSize);
+    }
+    else
+    {
+        for (i = 0u; (pConfig->pIfSettings != NULL) && (i < pConfig->numIfConfig); i++)
+        {
+            if (pConfig->pIfSettings[i].pExchgPar != NULL)
+            {
+                tau_freeTelegrams(pConfig->pIfSettings[i].numExchgPar, pConfig->pIfSettings[i].pExchgPar);
+            }
+        }
+        if (pConfig->pIfSettings != NULL)
+        {
+            vos_memFree(pConfig->pIfSettings);
+        }
+        if (pConfig->pComPar != NULL)
+        {
+            vos_memFree(pConfig->pComPar);
+        }
+        if (pConfig->pIfConfig != NULL)
+        {
+            vos_memFree(pConfig->pIfConfig);
+        }
+        tau_freeXmlDatasetConfig(pConfig->numComId, pConfig->pComIdDsIdMap, pConfig->numDataset, pConfig->apDataset);
+    }
+    memset(pConfig, 0, sizeof(TRDP_XML_CONFIG_T));
+}
@@ -0,0 +1,376 @@
+/******************************************************************************/
+/**
+ * @file            trdp_history.c
+ *
+ * @brief           Statistics history of a session in shared memory
+ *
+ * @details         tlc_openHistory() maps a shared memory area (TRDP_HISTORY_HEADER_T followed by a ring of
+ *                  TRDP_HISTORY_SAMPLE_T). tlc_process() writes a sample of the PD, MD and memory counters, the
+ *                  cycle timing and the latency sums once per TRDP_HISTORY_INTERVAL. Readers map the same area,
+ *                  nothing is copied or locked for them. The area outlives a crashed process; opening it again
+ *                  with the same layout continues the ring.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ *      BL 2026-10-17: Sequence numbers of the ring stored with release semantics instead of volatile
+ *
+ */
+
+/*******************************************************************************
+ * INCLUDES
+ */
+
+#include <string.h>
+#include <time.h>
+
+#include "trdp_history.h"
+#include "trdp_if_light.h"
+#include "trdp_if.h"
+#include "trdp_private.h"
+#include "trdp_stats.h"
+#include "vos_mem.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+
+/*******************************************************************************
+ * DEFINES
+ */
+
+/** Access to the sequence numbers shared with the readers (seqlock). The interlocked functions of Windows are full
+ *  barriers, the fences are needed for GCC/Clang only. */
+#if (defined (WIN32) || defined (WIN64))
+#include <intrin.h>
+#define HISTORY_STORE(p, v)         ((void) _InterlockedExchange((volatile long *) (p), (long) (v)))
+#define HISTORY_FENCE_RELEASE()     ((void) 0)
+#else
+#define HISTORY_STORE(p, v)         __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define HISTORY_FENCE_RELEASE()     __atomic_thread_fence(__ATOMIC_RELEASE)
+#endif
+
+/******************************************************************************
+ *   Locals
+ */
+
+static void trdp_historySample (TRDP_SESSION_PT appHandle, TRDP_HISTORY_SAMPLE_T *pSample);
+static void trdp_historyWrite (TRDP_SESSION_PT appHandle);
+
+/**********************************************************************************************************************/
+/** Collect the counters of the session.
+ *  Must be called with the session locked.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[out]     pSample             sample to fill (except seq)
+ */
+static void trdp_historySample (
+    TRDP_SESSION_PT         appHandle,
+    TRDP_HISTORY_SAMPLE_T   *pSample)
+{
+    const TRDP_STATISTICS_T *pStats = &appHandle->stats;
+    PD_ELE_T                *iterPD;
+    VOS_TIMEVAL_T           now;
+    UINT32                  numSlow = 0u;
+
+    trdp_UpdateStats(appHandle);
+    vos_getTime(&now);
+
+    pSample->timeSec        = (UINT32) now.tv_sec;
+    pSample->timeUsec       = (UINT32) now.tv_usec;
+    pSample->wallTime       = (UINT32) time(NULL);
+    pSample->upTime         = pStats->upTime;
+    pSample->pdNumRcv       = pStats->pd.numRcv;
+    pSample->pdNumSend      = pStats->pd.numSend;
+    pSample->pdNumMissed    = pStats->pd.numMissed;
+    pSample->pdNumTimeout   = pStats->pd.numTimeout;
+    pSample->pdNumCrcErr    = pStats->pd.numCrcErr;
+    pSample->pdNumProtErr   = pStats->pd.numProtErr;
+    pSample->pdNumTopoErr   = pStats->pd.numTopoErr;
+    pSample->pdNumNoSubs    = pStats->pd.numNoSubs;
+    pSample->mdNumRcv       = pStats->udpMd.numRcv + pStats->tcpMd.numRcv;
+    pSample->mdNumSend      = pStats->udpMd.numSend + pStats->tcpMd.numSend;
+    pSample->mdNumErr       = pStats->udpMd.numCrcErr + pStats->udpMd.numProtErr + pStats->udpMd.numTopoErr +
+                              pStats->tcpMd.numCrcErr + pStats->tcpMd.numProtErr + pStats->tcpMd.numTopoErr;
+    pSample->mdNumNoListener        = pStats->udpMd.numNoListener + pStats->tcpMd.numNoListener;
+    pSample->mdNumReplyTimeout      = pStats->udpMd.numReplyTimeout + pStats->tcpMd.numReplyTimeout;
+    pSample->mdNumConfirmTimeout    = pStats->udpMd.numConfirmTimeout + pStats->tcpMd.numConfirmTimeout;
+    pSample->memFree        = pStats->mem.free;
+    pSample->memMinFree     = pStats->mem.minFree;
+    pSample->memNumAllocErr = pStats->mem.numAllocErr;
+
+    /*  Cycle timing, if switched on    */
+    if (appHandle->pTiming != NULL)
+    {
+        const TRDP_PROCESS_STATISTICS_T *pProc = &appHandle->pTiming->stats;
+
+        pSample->numPasses              = pProc->stage[TRDP_STAGE_PASS].count;
+        pSample->passTime               = pProc->stage[TRDP_STAGE_PASS].sum;
+        pSample->passMax                = appHandle->pTiming->passMax;
+        pSample->numPassOverruns        = pProc->numPassOverruns;
+        pSample->numCallbackOverruns    = pProc->numCallbackOverruns;
+        appHandle->pTiming->passMax     = 0u;
+    }
+
+    /*  Slow callbacks and receive latencies of the elements    */
+    pSample->numLatency = 0u;
+    pSample->latencySum = 0u;
+    for (iterPD = appHandle->pSndQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        numSlow += iterPD->cbStats.numSlow;
+    }
+    for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        numSlow += iterPD->cbStats.numSlow;
+        if (iterPD->pLatency != NULL)
+        {
+            pSample->numLatency += iterPD->pLatency->stack.count;
+            pSample->latencySum += iterPD->pLatency->stack.sum;
+        }
+    }
+#if MD_SUPPORT
+    {
+        MD_LIS_ELE_T *iterLis;
+
+        for (iterLis = appHandle->pMDListenQueue; iterLis != NULL; iterLis = iterLis->pNext)
+        {
+            numSlow += iterLis->cbStats.numSlow;
+        }
+        numSlow += appHandle->mdCallerCb.numSlow;
+    }
+#endif
+    pSample->numSlowCallbacks = numSlow;
+}
+
+/**********************************************************************************************************************/
+/** Write the next sample into the ring.
+ *  The sequence number is cleared before the sample is written and set after it (release), a reader seeing it
+ *  unchanged before and after copying a sample (acquire) got a consistent one.
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+static void trdp_historyWrite (
+    TRDP_SESSION_PT appHandle)
+{
+    TRDP_HISTORY_T          *pHistory   = appHandle->pHistory;
+    TRDP_HISTORY_HEADER_T   *pHeader    = pHistory->pHeader;
+    UINT32                  seq         = pHeader->numWritten + 1u;     /* only written here */
+    TRDP_HISTORY_SAMPLE_T   *pSample    = &pHistory->pSample[pHeader->numWritten % pHeader->noOfSamples];
+    TRDP_HISTORY_SAMPLE_T   sample;
+
+    memset(&sample, 0, sizeof(sample));
+    trdp_historySample(appHandle, &sample);
+
+    /*  Invalidate the slot before any of its data is overwritten   */
+    HISTORY_STORE(&pSample->seq, 0u);
+    HISTORY_FENCE_RELEASE();
+    memcpy((UINT8 *) pSample + sizeof(sample.seq), (UINT8 *) &sample + sizeof(sample.seq),
+           sizeof(sample) - sizeof(sample.seq));
+    /*  Publish the data with the sequence number, then the new end of the ring   */
+    HISTORY_STORE(&pSample->seq, seq);
+    HISTORY_STORE(&pHeader->numWritten, seq);
+}
+
+/******************************************************************************
+ *   Globals
+ */
+
+/**********************************************************************************************************************/
+/** Limit the select timeout to the next sample.
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_historyCheckPending (
+    TRDP_SESSION_PT appHandle)
+{
+    if ((appHandle->pHistory != NULL) &&
+        ((appHandle->nextJob == 0) || (appHandle->pHistory->nextSample < appHandle->nextJob)))
+    {
+        appHandle->nextJob = appHandle->pHistory->nextSample;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Write a sample if it is due.
+ *  Called once per processing pass with the session locked.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      now                 current time (of this processing pass)
+ */
+void trdp_historyCheck (
+    TRDP_SESSION_PT appHandle,
+    VOS_TIME_NS_T   now)
+{
+    TRDP_HISTORY_T *pHistory = appHandle->pHistory;
+
+    if ((pHistory == NULL) || (now < pHistory->nextSample))
+    {
+        return;
+    }
+    trdp_historyWrite(appHandle);
+
+    /*  Keep the interval; after a stall start again from now instead of catching up   */
+    pHistory->nextSample += (VOS_TIME_NS_T) TRDP_HISTORY_INTERVAL * 1000000;
+    if (pHistory->nextSample <= now)
+    {
+        pHistory->nextSample = now + (VOS_TIME_NS_T) TRDP_HISTORY_INTERVAL * 1000000;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Unmap the history of a session.
+ *  The area is removed if it was created by this session.
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_historyClose (
+    TRDP_SESSION_PT appHandle)
+{
+    if (appHandle->pHistory != NULL)
+    {
+        if (vos_sharedClose(appHandle->pHistory->handle, (UINT8 *) appHandle->pHistory->pHeader) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_WARNING, "Closing the statistics history failed\n");
+        }
+        vos_memFree(appHandle->pHistory);
+        appHandle->pHistory = NULL;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Start recording the statistics history into a shared memory area.
+ *  A sample is taken at the next tlc_process() and then every TRDP_HISTORY_INTERVAL ms. If the area exists
+ *  with the same layout (e.g. left behind by a crashed process), the ring is continued, otherwise it is
+ *  initialized. Calling it again closes the previous area.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pKey                name of the shared memory area (POSIX: "/name")
+ *  @param[in]      noOfSamples         size of the ring in samples (e.g. 3600 for one hour)
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error, the area exists with a different size
+ *  @retval         TRDP_MEM_ERR        area could not be created or mapped
+ */
+EXT_DECL TRDP_ERR_T tlc_openHistory (
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pKey,
+    UINT32              noOfSamples)
+{
+    TRDP_ERR_T              err     = TRDP_NO_ERR;
+    UINT32                  size    = (UINT32) sizeof(TRDP_HISTORY_HEADER_T) +
+                                      noOfSamples * (UINT32) sizeof(TRDP_HISTORY_SAMPLE_T);
+    TRDP_HISTORY_T          *pHistory;
+    TRDP_HISTORY_HEADER_T   *pHeader;
+    UINT8                   *pArea  = NULL;
+    VOS_SHRD_T              handle  = NULL;
+
+    if ((pKey == NULL) || (noOfSamples == 0u) ||
+        (noOfSamples > (0xFFFFFFFFu - sizeof(TRDP_HISTORY_HEADER_T)) / sizeof(TRDP_HISTORY_SAMPLE_T)))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    trdp_historyClose(appHandle);
+
+    pHistory = (TRDP_HISTORY_T *) vos_memAlloc(sizeof(TRDP_HISTORY_T));
+    if (pHistory == NULL)
+    {
+        err = TRDP_MEM_ERR;
+    }
+    else if (vos_sharedOpen(pKey, &handle, &pArea, &size) != VOS_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "Cannot open statistics history %s\n", pKey);
+        vos_memFree(pHistory);
+        err = TRDP_MEM_ERR;
+    }
+    else if (size != (UINT32) sizeof(TRDP_HISTORY_HEADER_T) + noOfSamples * (UINT32) sizeof(TRDP_HISTORY_SAMPLE_T))
+    {
+        vos_printLog(VOS_LOG_ERROR, "Statistics history %s exists with %u bytes\n", pKey, (unsigned int) size);
+        (void) vos_sharedClose(handle, pArea);
+        vos_memFree(pHistory);
+        err = TRDP_PARAM_ERR;
+    }
+    else
+    {
+        pHeader = (TRDP_HISTORY_HEADER_T *) pArea;
+        if ((memcmp(pHeader->magic, TRDP_HISTORY_MAGIC, sizeof(TRDP_HISTORY_MAGIC)) == 0) &&
+            (pHeader->version == TRDP_HISTORY_VERSION) &&
+            (pHeader->headerSize == sizeof(TRDP_HISTORY_HEADER_T)) &&
+            (pHeader->sampleSize == sizeof(TRDP_HISTORY_SAMPLE_T)) &&
+            (pHeader->noOfSamples == noOfSamples) &&
+            (pHeader->interval == TRDP_HISTORY_INTERVAL))
+        {
+            vos_printLog(VOS_LOG_INFO, "Statistics history %s continued after %u samples\n",
+                         pKey, (unsigned int) pHeader->numWritten);
+        }
+        else
+        {
+            memset(pArea, 0, size);
+            memcpy(pHeader->magic, TRDP_HISTORY_MAGIC, sizeof(TRDP_HISTORY_MAGIC));
+            pHeader->version        = TRDP_HISTORY_VERSION;
+            pHeader->headerSize     = (UINT32) sizeof(TRDP_HISTORY_HEADER_T);
+            pHeader->sampleSize     = (UINT32) sizeof(TRDP_HISTORY_SAMPLE_T);
+            pHeader->noOfSamples    = noOfSamples;
+            pHeader->interval       = TRDP_HISTORY_INTERVAL;
+        }
+        pHeader->ownIpAddr      = appHandle->realIP;
+
+        pHistory->handle        = handle;
+        pHistory->pHeader       = pHeader;
+        pHistory->pSample       = (TRDP_HISTORY_SAMPLE_T *) (pArea + sizeof(TRDP_HISTORY_HEADER_T));
+        pHistory->nextSample    = vos_getTimeNs();
+        appHandle->pHistory     = pHistory;
+    }
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Stop recording the statistics history.
+ *  The shared memory area is unmapped; it is removed if it was created by this session.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_closeHistory (
+    TRDP_APP_SESSION_T appHandle)
+{
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    trdp_historyClose(appHandle);
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    return TRDP_NO_ERR;
+}
@@ -0,0 +1,55 @@
+/******************************************************************************/
+/**
+ * @file            trdp_history.h
+ *
+ * @brief           Statistics history of a session in shared memory
+ *
+ * @details         The key counters of a session are sampled once per TRDP_HISTORY_INTERVAL into a ring
+ *                  in a shared memory area, where an external process can read them.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+
+#ifndef TRDP_HISTORY_H
+#define TRDP_HISTORY_H
+
+/*******************************************************************************
+ * INCLUDES
+ */
+
+#include "trdp_if_light.h"
+#include "trdp_private.h"
+#include "vos_shared_mem.h"
+
+/*******************************************************************************
+ * TYPEDEFS
+ */
+
+/** Statistics history of a session */
+typedef struct TRDP_HISTORY
+{
+    VOS_SHRD_T              handle;         /**< shared memory handle                               */
+    TRDP_HISTORY_HEADER_T   *pHeader;       /**< start of the shared memory area                    */
+    TRDP_HISTORY_SAMPLE_T   *pSample;       /**< the ring, pHeader->noOfSamples samples             */
+    VOS_TIME_NS_T           nextSample;     /**< due time of the next sample                        */
+} TRDP_HISTORY_T;
+
+/*******************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+void    trdp_historyCheckPending (TRDP_SESSION_PT appHandle);
+void    trdp_historyCheck (TRDP_SESSION_PT appHandle, VOS_TIME_NS_T now);
+void    trdp_historyClose (TRDP_SESSION_PT appHandle);
+
+#endif
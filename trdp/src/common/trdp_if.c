@@ -16,6 +16,27 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: Unphased publishers start one interval after publishing and keep their timing on a new epoch
+ *      BL 2026-10-17: tlp_publishBatch(): publishers indexed by comId and committed rates summed once per batch
+ *      BL 2026-10-17: tlc_publishListStatistics(): subscription and publisher lists published on request only
+ *      BL 2026-10-17: Publishers account their committed bit rate in publish, put and unpublish
+ *      BL 2026-10-17: tlc_process() takes the precise wait deadline under the session lock
+ *      BL 2026-10-17: tlc_resetDatasetCache() for reloaded marshalling tables
+ *      BL 2026-10-17: tlp_publishBatch(), tlp_subscribeBatch(): one lock, shared socket requests, one shaping pass
+ *      BL 2026-10-17: Statistics history: sampled from tlc_process(), closed with the session
+ *      BL 2026-10-17: Subscription and publisher lists published for statistics pulls
+ *      BL 2026-10-17: tlm_delListener() detaches open MD sessions from the deleted listener (callback accounting)
+ *      BL 2026-10-17: Stage timing of tlc_process() (TRDP_PROC_STAGE), timing freed with the session
+ *      BL 2026-10-17: Session counters numPub, numSubs maintained on (un)publish / (un)subscribe
+ *      BL 2026-10-17: Metrics endpoint: served from tlc_process(), closed with the session
+ *      BL 2026-10-17: Event trace: tlc_process() entry/exit, requested dumps, ring freed with the session
+ *      BL 2026-10-17: Latency statistics: put time of publishers, histograms freed with the element
+ *      BL 2026-10-17: Admission control for publishers (tlc_setBandwidthLimit), MD rate limit (tlc_setMdRateLimit)
+ *      BL 2026-10-17: tlc_setSendBudget(), QoS class of publishers kept for the send order
+ *      BL 2026-10-17: One clock read per tlc_process pass, PD scheduler times in ns (VOS_TIME_NS_T)
+ *      BL 2026-10-17: Phased publishing: tlc_setCycleEpoch(), pSendParam->phase
+ *      BL 2026-10-17: TRDP_OPTION_PRECISE_WAIT: early wake-up in tlc_getInterval, spin in tlc_process
+ *      BL 2026-10-17: Traffic shaping: publishers are placed incrementally, no redistribution on (un)publish
  *      BL 2018-10-09: Ticket #213 ComId 31 subscription removed (<-- undone!)
  *      BL 2018-06-29: Default settings handling / compiler warnings
  *      SW 2018-06-26: Ticket #205 tlm_addListener() does not acknowledge TRDP_FLAGS_DEFAULT flag
@@ -78,6 +99,9 @@
 #include "trdp_utils.h"
 #include "trdp_pdcom.h"
 #include "trdp_stats.h"
+#include "trdp_trace.h"
+#include "trdp_metrics.h"
+#include "trdp_history.h"
 #include "vos_sock.h"
 #include "vos_mem.h"
 #include "vos_utils.h"
@@ -94,6 +118,25 @@ extern "C" {
  * TYPEDEFS
  */
 
+/** Socket of the previous publisher or subscriber of a batch  */
+typedef struct
+{
+    TRDP_IP_ADDR_T  srcIpAddr;                  /**< bind address the socket was requested for  */
+    TRDP_IP_ADDR_T  mcGroup;                    /**< joined multicast group, 0 if none          */
+    UINT8           qos;                        /**< send parameters the socket was opened with */
+    UINT8           ttl;
+    INT32           socketIdx;                  /**< TRDP_INVALID_SOCKET_INDEX: none            */
+} TRDP_BATCH_SOCK_T;
+
+/** State of a publisher batch, gathered once instead of for each publisher */
+typedef struct
+{
+    TRDP_BATCH_SOCK_T   sock;                   /**< socket of the previous publisher           */
+    TRDP_PUB_INDEX_T    index;                  /**< publishers of all sessions by comId        */
+    BOOL8               indexed;                /**< FALSE: no index (memory), queues searched  */
+    TRDP_IF_RATES_T     rates;                  /**< committed bit rates per interface          */
+} TRDP_PUB_BATCH_T;
+
 /***********************************************************************************************************************
  * LOCALS
  */
@@ -344,6 +387,8 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
 
 #endif
 
+    trdp_metricsInit(pSession);
+
     ret = tlc_configSession(pSession, pMarshall, pPdDefault, pMdDefault, pProcessConfig);
     if (ret != TRDP_NO_ERR)
     {
@@ -360,8 +405,9 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
         return ret;
     }
 
-    vos_clearTime(&pSession->nextJob);
+    pSession->nextJob = 0;
     vos_getTime(&pSession->initTime);
+    pSession->cycleEpoch = VOS_TIME_TO_NS(&pSession->initTime);
 
     /*    Clear the socket pool    */
     trdp_initSockets(pSession->iface);
@@ -731,6 +777,7 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
 
                 /*    Release all allocated sockets and memory    */
                 vos_memFree(pSession->pNewFrame);
+                trdp_pdShapingFree(pSession);
 
                 while (pSession->pSndQueue != NULL)
                 {
@@ -743,6 +790,10 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                     {
                         vos_memFree(pSession->pSndQueue->pSeqCntList);
                     }
+                    if (pSession->pSndQueue->pLatency != NULL)
+                    {
+                        vos_memFree(pSession->pSndQueue->pLatency);
+                    }
                     vos_memFree(pSession->pSndQueue->pFrame);
 
                     /*    Only close socket if not used anymore    */
@@ -763,6 +814,10 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                     {
                         vos_memFree(pSession->pRcvQueue->pSeqCntList);
                     }
+                    if (pSession->pRcvQueue->pLatency != NULL)
+                    {
+                        vos_memFree(pSession->pRcvQueue->pLatency);
+                    }
                     if (pSession->pRcvQueue->pFrame != NULL)
                     {
                         vos_memFree(pSession->pRcvQueue->pFrame);
@@ -839,6 +894,13 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                     vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
                 }
 
+                trdp_metricsClose(pSession);
+                trdp_traceFree(pSession);
+                trdp_historyClose(pSession);
+                if (pSession->pTiming != NULL)
+                {
+                    vos_memFree(pSession->pTiming);
+                }
                 vos_mutexDelete(pSession->mutex);
                 vos_memFree(pSession);
             }
@@ -1226,6 +1288,618 @@ EXT_DECL UINT32 tlc_getOpTrainTopoCount (
     return 0u;
 }
 
+/**********************************************************************************************************************/
+/** Set the cycle epoch of the session.
+ *
+ *    Phased cyclic publishers are released at epoch + phase + k * interval. The epoch defaults to the
+ *    time the session was opened; set it e.g. to a common (synchronised) second boundary to get
+ *    reproducible send instants across devices. Running phased and shaped publishers are re-aligned,
+ *    unphased ones keep their send times.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *  @param[in]      pEpoch              New epoch (vos_getTime() time base)
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_setCycleEpoch (
+    TRDP_APP_SESSION_T  appHandle,
+    const TRDP_TIME_T   *pEpoch)
+{
+    PD_ELE_T        *iterPD;
+    VOS_TIME_NS_T   now;
+    TRDP_ERR_T      ret;
+
+    if (pEpoch == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+    if (ret == TRDP_NO_ERR)
+    {
+        appHandle->cycleEpoch = VOS_TIME_TO_NS(pEpoch);
+
+        now = vos_getTimeNs();
+        for (iterPD = appHandle->pSndQueue; iterPD != NULL; iterPD = iterPD->pNext)
+        {
+            /*  Phased and shaped publishers follow the epoch, the others keep their send times  */
+            if ((iterPD->interval != 0) &&
+                (((iterPD->privFlags & TRDP_PHASED) != 0u) || (iterPD->shapingPeriod != 0u)))
+            {
+                trdp_pdAlignToEpoch(appHandle, iterPD, now);
+            }
+            else
+            {
+                trdp_pdPhaseOf(appHandle, iterPD);
+            }
+        }
+
+        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Limit the PD bytes sent per time window.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *  @param[in]      bytes               Bytes (gross packet size) per window, 0 switches the budget off
+ *  @param[in]      window              Window length in us, windows are aligned to the cycle epoch
+ *  @param[in]      minQos              Packets with this QoS or higher are never deferred
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_setSendBudget (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              bytes,
+    UINT32              window,
+    UINT8               minQos)
+{
+    TRDP_ERR_T ret;
+
+    if ((bytes != 0u) &&
+        ((window == 0u) || (minQos > TRDP_QOS_CLASSES)))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+    if (ret == TRDP_NO_ERR)
+    {
+        appHandle->sendBudget.bytes     = bytes;
+        appHandle->sendBudget.window    = window;
+        appHandle->sendBudget.minQos    = minQos;
+        appHandle->sendBudget.used      = 0u;
+        appHandle->sendBudget.windowEnd = 0;
+        appHandle->sendBudget.exhausted = FALSE;
+
+        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Limit the committed PD bit rate per interface.
+ *  The bit rate of the cyclic publishers is computed from their intervals and gross sizes plus the
+ *  Ethernet/IP/UDP overhead. tlp_publish() checks a new publisher against this limit.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *  @param[in]      bitRate             Max. bit/s per interface, 0 switches the admission control off
+ *  @param[in]      reject              TRUE: tlp_publish() fails with TRDP_QUEUE_FULL_ERR, FALSE: warning only
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_setBandwidthLimit (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              bitRate,
+    BOOL8               reject)
+{
+    TRDP_ERR_T ret;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+    if (ret == TRDP_NO_ERR)
+    {
+        appHandle->admission.pdLimit    = bitRate;
+        appHandle->admission.pdReject   = reject;
+
+        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Get the committed PD bit rate of an interface.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *  @param[in]      ifAddr              Interface (source IP of the publishers), 0 for the session's own IP
+ *  @param[out]     pBitRate            Committed bit/s of the cyclic publishers
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_getCommittedBitRate (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_IP_ADDR_T      ifAddr,
+    UINT32              *pBitRate)
+{
+    TRDP_ERR_T  ret;
+    UINT64      rate;
+
+    if (pBitRate == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+    if (ret == TRDP_NO_ERR)
+    {
+        rate        = trdp_pdCommittedRate(appHandle, (ifAddr == VOS_INADDR_ANY) ? appHandle->realIP : ifAddr);
+        *pBitRate   = (rate > 0xFFFFFFFFu) ? 0xFFFFFFFFu : (UINT32) rate;
+
+        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+    return ret;
+}
+
+#if MD_SUPPORT
+/**********************************************************************************************************************/
+/** Limit the MD send rate with a token bucket.
+ *  MD messages are sent as long as the bucket holds their gross size, else they stay queued and
+ *  are sent in a later tlc_process() call. Bursts of MD can thus not starve the cyclic PD.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *  @param[in]      rate                Bytes per second, 0 switches the rate limit off
+ *  @param[in]      burst               Bucket depth in bytes (max. burst), 0 for one second worth of bytes
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_setMdRateLimit (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              rate,
+    UINT32              burst)
+{
+    TRDP_ERR_T ret;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+    if (ret == TRDP_NO_ERR)
+    {
+        appHandle->admission.mdRate     = rate;
+        appHandle->admission.mdDepth    = (burst != 0u) ? burst : rate;
+        appHandle->admission.mdCredit   = (INT64) appHandle->admission.mdDepth;
+        appHandle->admission.mdLastFill = 0;
+        appHandle->admission.mdWakeUp   = 0;
+
+        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+    return ret;
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Answer statistics pulls for the subscription and publisher lists.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+EXT_DECL TRDP_ERR_T tlc_publishListStatistics (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TRDP_ERR_T  ret;
+    TRDP_PUB_T  dummyPubHndl;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+    if (ret == TRDP_NO_ERR)
+    {
+        /*  Pull-only telegrams, the buffer must hold the longest list   */
+        if (trdp_queueFindComId(appHandle->pSndQueue, TRDP_SUBS_LIST_COMID) == NULL)
+        {
+            ret = tlp_publish(appHandle, &dummyPubHndl, NULL, NULL, TRDP_SUBS_LIST_COMID,
+                              0u, 0u, 0u, 0u, 0u, 0u, TRDP_FLAGS_NONE, NULL, NULL, TRDP_MAX_PD_DATA_SIZE);
+        }
+        if ((ret == TRDP_NO_ERR) &&
+            (trdp_queueFindComId(appHandle->pSndQueue, TRDP_PUB_LIST_COMID) == NULL))
+        {
+            ret = tlp_publish(appHandle, &dummyPubHndl, NULL, NULL, TRDP_PUB_LIST_COMID,
+                              0u, 0u, 0u, 0u, 0u, 0u, TRDP_FLAGS_NONE, NULL, NULL, TRDP_MAX_PD_DATA_SIZE);
+        }
+
+        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Forget the datasets cached by the marshalling of publishers and MD messages.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_resetDatasetCache (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TRDP_ERR_T  ret;
+    PD_ELE_T    *iterPD;
+#if MD_SUPPORT
+    MD_ELE_T    *iterMD;
+#endif
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
+    if (ret == TRDP_NO_ERR)
+    {
+        for (iterPD = appHandle->pSndQueue; iterPD != NULL; iterPD = iterPD->pNext)
+        {
+            iterPD->pCachedDS = NULL;
+        }
+        for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
+        {
+            iterPD->pCachedDS = NULL;
+        }
+#if MD_SUPPORT
+        for (iterMD = appHandle->pMDSndQueue; iterMD != NULL; iterMD = iterMD->pNext)
+        {
+            iterMD->pCachedDS = NULL;
+        }
+        for (iterMD = appHandle->pMDRcvQueue; iterMD != NULL; iterMD = iterMD->pNext)
+        {
+            iterMD->pCachedDS = NULL;
+        }
+#endif
+
+        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Get a socket for a publisher or subscriber of a batch.
+ *  The socket of the previous request is taken again if the addressing is equal, saving the search of the socket pool
+ *  and the socket option calls of trdp_requestSocket.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in,out]  pCache              socket of the previous request, NULL: no batch
+ *  @param[in]      pSendParam          send parameters
+ *  @param[in]      srcIpAddr           IP to bind to
+ *  @param[in]      mcGroup             MC group to join (0 = do not join)
+ *  @param[in]      rcvMostly           TRUE for subscribers
+ *  @param[out]     pIndex              returned index of socket pool
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        socket pool exhausted
+ */
+static TRDP_ERR_T trdp_batchSocket (
+    TRDP_SESSION_PT         appHandle,
+    TRDP_BATCH_SOCK_T       *pCache,
+    const TRDP_SEND_PARAM_T *pSendParam,
+    TRDP_IP_ADDR_T          srcIpAddr,
+    TRDP_IP_ADDR_T          mcGroup,
+    BOOL8                   rcvMostly,
+    INT32                   *pIndex)
+{
+    TRDP_ERR_T ret;
+
+    if ((pCache != NULL)
+        && (pCache->socketIdx != TRDP_INVALID_SOCKET_INDEX)
+        && (pCache->srcIpAddr == srcIpAddr)
+        && (pCache->mcGroup == mcGroup)
+        && (pCache->qos == pSendParam->qos)
+        && (pCache->ttl == pSendParam->ttl)
+        && (appHandle->iface[pCache->socketIdx].sock != VOS_INVALID_SOCKET))
+    {
+        appHandle->iface[pCache->socketIdx].usage++;
+        *pIndex = pCache->socketIdx;
+        return TRDP_NO_ERR;
+    }
+
+    ret = trdp_requestSocket(appHandle->iface,
+                             appHandle->pdDefault.port,
+                             pSendParam,
+                             srcIpAddr,
+                             mcGroup,
+                             TRDP_SOCK_PD,
+                             appHandle->option,
+                             rcvMostly,
+                             -1,
+                             pIndex,
+                             0u);
+
+    if ((ret == TRDP_NO_ERR) && (pCache != NULL))
+    {
+        pCache->srcIpAddr   = srcIpAddr;
+        pCache->mcGroup     = mcGroup;
+        pCache->qos         = pSendParam->qos;
+        pCache->ttl         = pSendParam->ttl;
+        pCache->socketIdx   = *pIndex;
+    }
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Queue a publisher, the session must be locked.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pDesc               publisher parameters
+ *  @param[in,out]  pBatch              state of a publisher batch, NULL: no batch
+ *  @param[in]      shape               TRUE: place the publisher into the traffic shaping table now
+ *  @param[out]     pPubHandle          returned handle, set if the publisher was queued
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        could not insert (out of memory)
+ *  @retval         TRDP_NOPUB_ERR      already published
+ *  @retval         TRDP_QUEUE_FULL_ERR bit rate limit of the interface exceeded (tlc_setBandwidthLimit)
+ */
+static TRDP_ERR_T trdp_pdPublish (
+    TRDP_SESSION_PT         appHandle,
+    const TRDP_PUB_DESC_T   *pDesc,
+    TRDP_PUB_BATCH_T        *pBatch,
+    BOOL8                   shape,
+    TRDP_PUB_T              *pPubHandle)
+{
+    PD_ELE_T                *pNewElement    = NULL;
+    TRDP_ERR_T              ret             = TRDP_NO_ERR;
+    TRDP_ADDRESSES_T        pubHandle;
+    TRDP_IP_ADDR_T          srcIpAddr       = pDesc->srcIpAddr;
+    UINT32                  interval        = pDesc->interval;
+    const TRDP_SEND_PARAM_T *pSendParam     =
+        (pDesc->pSendParam != NULL) ? pDesc->pSendParam : &appHandle->pdDefault.sendParam;
+
+    if (interval != 0u && interval < TRDP_TIMER_GRANULARITY)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    /* Ticket #171: srcIP should be set if there are more than one interface */
+    if (srcIpAddr == VOS_INADDR_ANY)
+    {
+        srcIpAddr = appHandle->realIP;
+    }
+
+    /* initialize pubHandle */
+    pubHandle.comId         = pDesc->comId;
+    pubHandle.destIpAddr    = pDesc->destIpAddr;
+    pubHandle.mcGroup       = vos_isMulticast(pDesc->destIpAddr) ? pDesc->destIpAddr : 0u;
+    pubHandle.srcIpAddr     = srcIpAddr;
+
+    /*    Look for existing element    */
+    if (((pBatch != NULL) && (pBatch->indexed == TRUE)) ?
+        (trdp_pubIndexFindAddr(&pBatch->index, &pubHandle) != NULL) :
+        (trdp_queueFindPubAddr(appHandle->pSndQueue, &pubHandle) != NULL))
+    {
+        /*  Already published! */
+        ret = TRDP_NOPUB_ERR;
+    }
+    else if (trdp_pdAdmit(appHandle, (pBatch != NULL) ? &pBatch->rates : NULL, srcIpAddr,
+                          trdp_packetSizePD(pDesc->dataSize), interval) != TRDP_NO_ERR)
+    {
+        /*  The committed bit rate of the interface would exceed the limit  */
+        ret = TRDP_QUEUE_FULL_ERR;
+    }
+    else
+    {
+        pNewElement = (PD_ELE_T *) vos_memAlloc(sizeof(PD_ELE_T));
+        if (pNewElement == NULL)
+        {
+            ret = TRDP_MEM_ERR;
+        }
+        else
+        {
+            /*
+             Compute the overal packet size
+             */
+
+            /* mark data as invalid, data will be set valid with tlp_put */
+            pNewElement->privFlags |= TRDP_INVALID_DATA;
+
+            pNewElement->dataSize   = pDesc->dataSize;
+            pNewElement->grossSize  = trdp_packetSizePD(pDesc->dataSize);
+
+            /*    Get a socket    */
+            ret = trdp_batchSocket(appHandle, (pBatch != NULL) ? &pBatch->sock : NULL, pSendParam, srcIpAddr, 0u,
+                                   FALSE, &pNewElement->socketIdx);
+
+            if (ret != TRDP_NO_ERR)
+            {
+                vos_memFree(pNewElement);
+                pNewElement = NULL;
+            }
+            else
+            {
+                /*  Alloc the corresponding data buffer  */
+                pNewElement->pFrame = (PD_PACKET_T *) vos_memAlloc(pNewElement->grossSize);
+                if (pNewElement->pFrame == NULL)
+                {
+                    vos_memFree(pNewElement);
+                    pNewElement = NULL;
+                }
+            }
+        }
+    }
+
+    /*    Get the current time and compute the next time this packet should be sent.    */
+    if ((ret == TRDP_NO_ERR)
+        && (pNewElement != NULL))
+    {
+        /* PD PULL?    Packet will be sent on request only    */
+        if (0 == interval)
+        {
+            pNewElement->interval   = 0;
+            pNewElement->timeToGo   = 0;
+        }
+        else if (pSendParam->phased == TRUE)
+        {
+            /*  First release on the cycle raster: epoch + phase + k * interval  */
+            pNewElement->interval   = (VOS_TIME_NS_T) interval * 1000;
+            pNewElement->phase      = pSendParam->phase % interval;
+            pNewElement->privFlags  |= TRDP_PHASED;
+            trdp_pdAlignToEpoch(appHandle, pNewElement, vos_getTimeNs());
+        }
+        else
+        {
+            /*  Unphased: first release one interval after publishing, its phase follows from that  */
+            pNewElement->interval   = (VOS_TIME_NS_T) interval * 1000;
+            pNewElement->timeToGo   = vos_getTimeNs() + pNewElement->interval;
+            trdp_pdPhaseOf(appHandle, pNewElement);
+        }
+
+        /*    Update the internal data */
+        pNewElement->addr       = pubHandle;
+        pNewElement->pktFlags   =
+            (pDesc->pktFlags == TRDP_FLAGS_DEFAULT) ? appHandle->pdDefault.flags : pDesc->pktFlags;
+        /* pNewElement->privFlags      = TRDP_PRIV_NONE; */
+        pNewElement->pullIpAddress  = 0u;
+        pNewElement->redId          = pDesc->redId;
+        pNewElement->pCachedDS      = NULL;
+        pNewElement->magic          = TRDP_MAGIC_PUB_HNDL_VALUE;
+        pNewElement->pUserRef       = pDesc->pUserRef;
+        pNewElement->qos            = pSendParam->qos;
+        if (pNewElement->qos >= TRDP_QOS_CLASSES)
+        {
+            pNewElement->qos = TRDP_QOS_CLASSES - 1u;
+        }
+
+        /* if default flags supplied and no callback func supplied, take default one */
+        if ((pDesc->pktFlags == TRDP_FLAGS_DEFAULT) &&
+            (pDesc->pfCbFunction == NULL))
+        {
+            pNewElement->pfCbFunction = appHandle->pdDefault.pfCbFunction;
+        }
+        else
+        {
+            pNewElement->pfCbFunction = pDesc->pfCbFunction;
+        }
+
+        /*  Find a possible redundant entry in one of the other sessions and sync the sequence counter!
+         curSeqCnt holds the last sent sequence counter, therefore set the value initially to -1,
+         it will be incremented when sending...    */
+
+        if ((pBatch != NULL) && (pBatch->indexed == TRUE))
+        {
+            pNewElement->curSeqCnt = trdp_pubIndexSeqCnt(&pBatch->index, pNewElement->addr.comId,
+                                                         pNewElement->addr.srcIpAddr) - 1;
+        }
+        else
+        {
+            pNewElement->curSeqCnt = trdp_getSeqCnt(pNewElement->addr.comId, TRDP_MSG_PD,
+                                                    pNewElement->addr.srcIpAddr) - 1;
+        }
+
+        /*  Get a second sequence counter in case this packet is requested as PULL. This way we will not
+         disturb the monotonic sequence for PDs. trdp_getSeqCnt searches the same send queues for PD and PP,
+         the search is not repeated  */
+        pNewElement->curSeqCnt4Pull = pNewElement->curSeqCnt;
+
+        /*    Check if the redundancy group is already set as follower; if set, we need to mark this one also!
+         This will only happen, if publish() is called while we are in redundant mode */
+        if (0 != pDesc->redId)
+        {
+            BOOL8 isLeader = TRUE;
+
+            ret = tlp_getRedundant(appHandle, pDesc->redId, &isLeader);
+            if (ret == TRDP_NO_ERR && FALSE == isLeader)
+            {
+                pNewElement->privFlags |= TRDP_REDUNDANT;
+            }
+        }
+
+        /*    Compute the header fields */
+        trdp_pdInit(pNewElement, TRDP_MSG_PD, pDesc->etbTopoCnt, pDesc->opTrnTopoCnt, 0u, 0u);
+
+        /*    Insert at front    */
+        trdp_queueInsFirst(&appHandle->pSndQueue, pNewElement);
+        appHandle->stats.pd.numPub++;
+        trdp_pdRateAccount(appHandle, pNewElement, TRUE);
+
+        *pPubHandle = (TRDP_PUB_T) pNewElement;
+
+        if (pDesc->dataSize != 0u)
+        {
+            ret = tlp_put(appHandle, *pPubHandle, pDesc->pData, pDesc->dataSize);
+        }
+        if (pBatch != NULL)
+        {
+            /*  Keep the batch state in step with the queue and the accounted rate  */
+            if (pBatch->indexed == TRUE)
+            {
+                trdp_pubIndexAdd(&pBatch->index, pNewElement);
+            }
+            trdp_pdRatesAdd(appHandle, &pBatch->rates, pNewElement);
+        }
+        if ((ret == TRDP_NO_ERR) && (shape == TRUE) && (appHandle->option & TRDP_OPTION_TRAFFIC_SHAPING))
+        {
+            /* Place the new packet into the slot table, the others keep their send times */
+            ret = trdp_pdShapingAdd(appHandle, pNewElement);
+        }
+    }
+
+    return ret;
+}
+
 /**********************************************************************************************************************/
 /** Prepare for sending PD messages.
  *  Queue a PD message, it will be send when tlc_publish has been called
@@ -1244,12 +1918,16 @@ EXT_DECL UINT32 tlc_getOpTrainTopoCount (
  *  @param[in]      pktFlags            OPTION:
  *                                      TRDP_FLAGS_DEFAULT, TRDP_FLAGS_NONE, TRDP_FLAGS_MARSHALL, TRDP_FLAGS_CALLBACK
  *  @param[in]      pSendParam          optional pointer to send parameter, NULL - default parameters are used
+ *                                      pSendParam->phase: send offset within the interval, relative to the
+ *                                      session cycle epoch (see tlc_setCycleEpoch), used if pSendParam->phased
+ *                                      is set. Unphased publishers are first sent one interval after publishing
  *  @param[in]      pData               pointer to data packet / dataset, NULL if sending starts later with tlp_put()
  *  @param[in]      dataSize            size of data packet >= 0 and <= TRDP_MAX_PD_DATA_SIZE
  *
  *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_PARAM_ERR      parameter error
  *  @retval         TRDP_MEM_ERR        could not insert (out of memory)
+ *  @retval         TRDP_QUEUE_FULL_ERR bit rate limit of the interface exceeded (tlc_setBandwidthLimit)
  *  @retval         TRDP_NOINIT_ERR     handle invalid
  */
 EXT_DECL TRDP_ERR_T tlp_publish (
@@ -1269,10 +1947,8 @@ EXT_DECL TRDP_ERR_T tlp_publish (
     const UINT8             *pData,
     UINT32                  dataSize)
 {
-    PD_ELE_T    *pNewElement = NULL;
-    TRDP_TIME_T nextTime;
-    TRDP_TIME_T tv_interval;
-    TRDP_ERR_T  ret = TRDP_NO_ERR;
+    TRDP_PUB_DESC_T desc;
+    TRDP_ERR_T      ret = TRDP_NO_ERR;
 
     /*    Check params    */
     if ((interval != 0u && interval < TRDP_TIMER_GRANULARITY)
@@ -1286,171 +1962,119 @@ EXT_DECL TRDP_ERR_T tlp_publish (
         return TRDP_NOINIT_ERR;
     }
 
+    desc.pUserRef       = pUserRef;
+    desc.pfCbFunction   = pfCbFunction;
+    desc.comId          = comId;
+    desc.etbTopoCnt     = etbTopoCnt;
+    desc.opTrnTopoCnt   = opTrnTopoCnt;
+    desc.srcIpAddr      = srcIpAddr;
+    desc.destIpAddr     = destIpAddr;
+    desc.interval       = interval;
+    desc.redId          = redId;
+    desc.pktFlags       = pktFlags;
+    desc.pSendParam     = pSendParam;
+    desc.pData          = pData;
+    desc.dataSize       = dataSize;
+
     /*    Reserve mutual access    */
     ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
     if (ret == TRDP_NO_ERR)
     {
-        TRDP_ADDRESSES_T pubHandle;
+        ret = trdp_pdPublish(appHandle, &desc, NULL, TRUE, pPubHandle);
 
-        /* Ticket #171: srcIP should be set if there are more than one interface */
-        if (srcIpAddr == VOS_INADDR_ANY)
-        {
-            srcIpAddr = appHandle->realIP;
-        }
-
-        /* initialize pubHandle */
-        pubHandle.comId         = comId;
-        pubHandle.destIpAddr    = destIpAddr;
-        pubHandle.mcGroup       = vos_isMulticast(destIpAddr) ? destIpAddr : 0u;
-        pubHandle.srcIpAddr     = srcIpAddr;
-
-        /*    Look for existing element    */
-        if (trdp_queueFindPubAddr(appHandle->pSndQueue, &pubHandle) != NULL)
-        {
-            /*  Already published! */
-            ret = TRDP_NOPUB_ERR;
-        }
-        else
+        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
         {
-            pNewElement = (PD_ELE_T *) vos_memAlloc(sizeof(PD_ELE_T));
-            if (pNewElement == NULL)
-            {
-                ret = TRDP_MEM_ERR;
-            }
-            else
-            {
-                /*
-                 Compute the overal packet size
-                 */
-
-                /* mark data as invalid, data will be set valid with tlp_put */
-                pNewElement->privFlags |= TRDP_INVALID_DATA;
-
-                pNewElement->dataSize   = dataSize;
-                pNewElement->grossSize  = trdp_packetSizePD(dataSize);
-
-                /*    Get a socket    */
-                ret = trdp_requestSocket(
-                        appHandle->iface,
-                        appHandle->pdDefault.port,
-                        (pSendParam != NULL) ? pSendParam : &appHandle->pdDefault.sendParam,
-                        srcIpAddr,
-                        0u,
-                        TRDP_SOCK_PD,
-                        appHandle->option,
-                        FALSE,
-                        -1,
-                        &pNewElement->socketIdx,
-                        0u);
-
-                if (ret != TRDP_NO_ERR)
-                {
-                    vos_memFree(pNewElement);
-                    pNewElement = NULL;
-                }
-                else
-                {
-                    /*  Alloc the corresponding data buffer  */
-                    pNewElement->pFrame = (PD_PACKET_T *) vos_memAlloc(pNewElement->grossSize);
-                    if (pNewElement->pFrame == NULL)
-                    {
-                        vos_memFree(pNewElement);
-                        pNewElement = NULL;
-                    }
-                }
-            }
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
         }
+    }
 
-        /*    Get the current time and compute the next time this packet should be sent.    */
-        if ((ret == TRDP_NO_ERR)
-            && (pNewElement != NULL))
-        {
-            /* PD PULL?    Packet will be sent on request only    */
-            if (0 == interval)
-            {
-                vos_clearTime(&pNewElement->interval);
-                vos_clearTime(&pNewElement->timeToGo);
-            }
-            else
-            {
-                vos_getTime(&nextTime);
-                tv_interval.tv_sec  = interval / 1000000u;
-                tv_interval.tv_usec = interval % 1000000;
-                vos_addTime(&nextTime, &tv_interval);
-                pNewElement->interval   = tv_interval;
-                pNewElement->timeToGo   = nextTime;
-            }
-
-            /*    Update the internal data */
-            pNewElement->addr       = pubHandle;
-            pNewElement->pktFlags   = (pktFlags == TRDP_FLAGS_DEFAULT) ? appHandle->pdDefault.flags : pktFlags;
-            /* pNewElement->privFlags      = TRDP_PRIV_NONE; */
-            pNewElement->pullIpAddress  = 0u;
-            pNewElement->redId          = redId;
-            pNewElement->pCachedDS      = NULL;
-            pNewElement->magic          = TRDP_MAGIC_PUB_HNDL_VALUE;
-            pNewElement->pUserRef       = pUserRef;
-
-            /* if default flags supplied and no callback func supplied, take default one */
-            if ((pktFlags == TRDP_FLAGS_DEFAULT) &&
-                (pfCbFunction == NULL))
-            {
-                pNewElement->pfCbFunction = appHandle->pdDefault.pfCbFunction;
-            }
-            else
-            {
-                pNewElement->pfCbFunction = pfCbFunction;
-            }
-
-            /*  Find a possible redundant entry in one of the other sessions and sync the sequence counter!
-             curSeqCnt holds the last sent sequence counter, therefore set the value initially to -1,
-             it will be incremented when sending...    */
-
-            pNewElement->curSeqCnt = trdp_getSeqCnt(pNewElement->addr.comId, TRDP_MSG_PD,
-                                                    pNewElement->addr.srcIpAddr) - 1;
+    return ret;
+}
 
-            /*  Get a second sequence counter in case this packet is requested as PULL. This way we will not
-             disturb the monotonic sequence for PDs  */
-            pNewElement->curSeqCnt4Pull = trdp_getSeqCnt(pNewElement->addr.comId, TRDP_MSG_PP,
-                                                         pNewElement->addr.srcIpAddr) - 1;
+/**********************************************************************************************************************/
+/** Prepare for sending a batch of PD messages.
+ *  Equivalent to one tlp_publish per descriptor, but the session is locked once, consecutive publishers with
+ *  equal addressing share a socket request and traffic shaping places the whole batch in one pass.
+ *  The existing publishers of all sessions are indexed by comId and the committed rates of the interfaces
+ *  are summed once for the batch, not searched again for each descriptor.
+ *  A failing descriptor does not stop the batch, its handle is set to NULL.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      count               number of descriptors
+ *  @param[in]      pDesc               array of publisher descriptors
+ *  @param[out]     pPubHandle          array of count returned handles, NULL for failed entries
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         other               error of the first failed descriptor (see tlp_publish)
+ */
+EXT_DECL TRDP_ERR_T tlp_publishBatch (
+    TRDP_APP_SESSION_T      appHandle,
+    UINT32                  count,
+    const TRDP_PUB_DESC_T   *pDesc,
+    TRDP_PUB_T              *pPubHandle)
+{
+    TRDP_PUB_BATCH_T    batch;
+    TRDP_ERR_T          ret = TRDP_NO_ERR;
+    TRDP_ERR_T          err;
+    UINT32              idx;
 
-            /*    Check if the redundancy group is already set as follower; if set, we need to mark this one also!
-             This will only happen, if publish() is called while we are in redundant mode */
-            if (0 != redId)
-            {
-                BOOL8 isLeader = TRUE;
+    if ((count != 0u) && ((pDesc == NULL) || (pPubHandle == NULL)))
+    {
+        return TRDP_PARAM_ERR;
+    }
 
-                ret = tlp_getRedundant(appHandle, redId, &isLeader);
-                if (ret == TRDP_NO_ERR && FALSE == isLeader)
-                {
-                    pNewElement->privFlags |= TRDP_REDUNDANT;
-                }
-            }
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
 
-            /*    Compute the header fields */
-            trdp_pdInit(pNewElement, TRDP_MSG_PD, etbTopoCnt, opTrnTopoCnt, 0u, 0u);
+    memset(&batch.sock, 0, sizeof(batch.sock));
+    batch.sock.socketIdx = TRDP_INVALID_SOCKET_INDEX;
 
-            /*    Insert at front    */
-            trdp_queueInsFirst(&appHandle->pSndQueue, pNewElement);
+    /*    Reserve mutual access    */
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
 
-            *pPubHandle = (TRDP_PUB_T) pNewElement;
+    /*    One pass over the send queues and the sockets for the whole batch    */
+    batch.indexed = (trdp_pubIndexInit(&batch.index, appHandle, count) == TRDP_NO_ERR) ? TRUE : FALSE;
+    trdp_pdRatesInit(appHandle, &batch.rates);
 
-            if (dataSize != 0u)
-            {
-                ret = tlp_put(appHandle, *pPubHandle, pData, dataSize);
-            }
-            if ((ret == TRDP_NO_ERR) && (appHandle->option & TRDP_OPTION_TRAFFIC_SHAPING))
+    for (idx = 0u; idx < count; idx++)
+    {
+        pPubHandle[idx] = NULL;
+        err = trdp_pdPublish(appHandle, &pDesc[idx], &batch, FALSE, &pPubHandle[idx]);
+        if (err != TRDP_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_WARNING, "tlp_publishBatch: comId %u to %s failed (Err: %d)\n",
+                         (unsigned int) pDesc[idx].comId, vos_ipDotted(pDesc[idx].destIpAddr), err);
+            if (ret == TRDP_NO_ERR)
             {
-                ret = trdp_pdDistribute(appHandle->pSndQueue);
+                ret = err;
             }
         }
+    }
 
-        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    if (appHandle->option & TRDP_OPTION_TRAFFIC_SHAPING)
+    {
+        /* Place the new packets into the slot tables, the others keep their send times */
+        err = trdp_pdShapingAddBatch(appHandle, pPubHandle, count);
+        if (ret == TRDP_NO_ERR)
         {
-            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+            ret = err;
         }
     }
 
+    trdp_pubIndexFree(&batch.index);
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
     return ret;
 }
 
@@ -1561,22 +2185,29 @@ TRDP_ERR_T  tlp_unpublish (
     ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
     if (ret == TRDP_NO_ERR)
     {
+        /*    Release its traffic shaping slots, the element is removed in any case    */
+        if (trdp_pdShapingRemove(appHandle, pElement) != TRDP_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_WARNING, "tlp_unpublish: traffic shaping hyperperiod not reduced\n");
+        }
+
+        trdp_pdRateAccount(appHandle, pElement, FALSE);
+
         /*    Remove from queue?    */
         trdp_queueDelElement(&appHandle->pSndQueue, pElement);
+        appHandle->stats.pd.numPub--;
         trdp_releaseSocket(appHandle->iface, pElement->socketIdx, 0u, FALSE, VOS_INADDR_ANY);
         pElement->magic = 0u;
         if (pElement->pSeqCntList != NULL)
         {
             vos_memFree(pElement->pSeqCntList);
         }
-        vos_memFree(pElement->pFrame);
-        vos_memFree(pElement);
-
-        /* Re-compute distribution times */
-        if (appHandle->option & TRDP_OPTION_TRAFFIC_SHAPING)
+        if (pElement->pLatency != NULL)
         {
-            ret = trdp_pdDistribute(appHandle->pSndQueue);
+            vos_memFree(pElement->pLatency);
         }
+        vos_memFree(pElement->pFrame);
+        vos_memFree(pElement);
 
         if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
         {
@@ -1637,6 +2268,18 @@ TRDP_ERR_T tlp_put (
                          pData,
                          dataSize);
 
+        /*    Remember the put time for the put -> sent latency (first put since the last send)    */
+        if ((ret == TRDP_NO_ERR) &&
+            ((appHandle->option & TRDP_OPTION_LATENCY_STATS) != 0) &&
+            (pElement->putTime == 0))
+        {
+            pElement->putTime = vos_getTimeNs();
+        }
+
+        /*    The packet size is known after the first put with data    */
+        trdp_pdShapingResize(appHandle, pElement);
+        trdp_pdRateAccount(appHandle, pElement, TRUE);
+
         if ( vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR )
         {
             vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
@@ -1651,6 +2294,8 @@ TRDP_ERR_T tlp_put (
  *  Return the maximum time interval suitable for 'select()' so that we
  *    can send due PD packets in time.
  *    If the PD send queue is empty, return zero time
+ *    With TRDP_OPTION_PRECISE_WAIT the interval is shortened by a guard band,
+ *    tlc_process then busy-waits until the packets are due.
  *
  *  @param[in]      appHandle          The handle returned by tlc_openSession
  *  @param[out]     pInterval          pointer to needed interval
@@ -1666,8 +2311,8 @@ EXT_DECL TRDP_ERR_T tlc_getInterval (
     TRDP_FDS_T          *pFileDesc,
     INT32               *pNoDesc)
 {
-    TRDP_TIME_T now;
-    TRDP_ERR_T  ret = TRDP_NOINIT_ERR;
+    VOS_TIME_NS_T   now;
+    TRDP_ERR_T      ret = TRDP_NOINIT_ERR;
 
     if (trdp_isValidSession(appHandle))
     {
@@ -1688,23 +2333,36 @@ EXT_DECL TRDP_ERR_T tlc_getInterval (
             else
             {
                 /*    Get the current time    */
-                vos_getTime(&now);
-                vos_clearTime(&appHandle->nextJob);
+                now = vos_getTimeNs();
+                appHandle->nextJob = 0;
 
-                trdp_pdCheckPending(appHandle, pFileDesc, pNoDesc);
+                trdp_pdCheckPending(appHandle, pFileDesc, pNoDesc, now);
 
 #if MD_SUPPORT
                 trdp_mdCheckPending(appHandle, pFileDesc, pNoDesc);
 #endif
 
+                trdp_metricsCheckPending(appHandle, pFileDesc, pNoDesc);
+                trdp_historyCheckPending(appHandle);
+
+                /*    Remember the absolute due time, tlc_process will spin on it    */
+                appHandle->preciseDeadline = appHandle->nextJob;
+
                 /*    if next job time is known, return the time-out value to the caller   */
-                if (timerisset(&appHandle->nextJob) &&
-                    timercmp(&now, &appHandle->nextJob, <))
+                if ((appHandle->nextJob != 0) &&
+                    (now < appHandle->nextJob))
                 {
-                    vos_subTime(&appHandle->nextJob, &now);
-                    *pInterval = appHandle->nextJob;
+                    VOS_TIME_NS_T remaining = appHandle->nextJob - now;
+
+                    /*    Wake up a guard band early, the rest is busy-waited in tlc_process    */
+                    if ((appHandle->option & TRDP_OPTION_PRECISE_WAIT) != 0)
+                    {
+                        remaining = (remaining > (VOS_TIME_NS_T) TRDP_PRECISE_WAIT_GUARD * 1000) ?
+                            (remaining - (VOS_TIME_NS_T) TRDP_PRECISE_WAIT_GUARD * 1000) : 0;
+                    }
+                    VOS_NS_TO_TIME(remaining, pInterval);
                 }
-                else if (timerisset(&appHandle->nextJob))
+                else if (appHandle->nextJob != 0)
                 {
                     pInterval->tv_sec   = 0u;                               /* 0ms if time is over (were we delayed?) */
                     pInterval->tv_usec  = 0;                                /* Application should limit this    */
@@ -1743,27 +2401,63 @@ EXT_DECL TRDP_ERR_T tlc_process (
     TRDP_FDS_T          *pRfds,
     INT32               *pCount)
 {
-    TRDP_ERR_T  result = TRDP_NO_ERR;
-    TRDP_ERR_T  err;
+    TRDP_ERR_T      result = TRDP_NO_ERR;
+    TRDP_ERR_T      err;
+    VOS_TIME_NS_T   now;
+    VOS_TIME_NS_T   preciseDeadline = 0;
 
     if (!trdp_isValidSession(appHandle))
     {
         return TRDP_NOINIT_ERR;
     }
 
+    /*    Woken up within the guard band before the next job? Spin until it is due.
+          The due time is taken under the lock (tlc_getInterval sets it), the spin runs without it.    */
+    if ((appHandle->option & TRDP_OPTION_PRECISE_WAIT) != 0)
+    {
+        if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+        {
+            return TRDP_NOINIT_ERR;
+        }
+        preciseDeadline = appHandle->preciseDeadline;
+        appHandle->preciseDeadline = 0;
+        if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+        }
+    }
+    if (preciseDeadline != 0)
+    {
+        now = vos_getTimeNs();
+        if ((now < preciseDeadline) &&
+            (preciseDeadline - now <= (VOS_TIME_NS_T) TRDP_PRECISE_WAIT_GUARD * 1000))
+        {
+            TRDP_TIME_T deadline;
+
+            VOS_NS_TO_TIME(preciseDeadline, &deadline);
+            (void) vos_threadDelayUntil(&deadline, TRDP_PRECISE_WAIT_GUARD);
+        }
+    }
+
     if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
     {
         return TRDP_NOINIT_ERR;
     }
     else
     {
-        vos_clearTime(&appHandle->nextJob);
+        TRDP_TRACE(appHandle, TRDP_TRACE_PROCESS_ENTER, 0u, 0u, 0u);
+
+        appHandle->nextJob = 0;
+
+        /*    One clock read for the whole pass    */
+        now = vos_getTimeNs();
 
         /******************************************************
          Find and send the packets which have to be sent next:
          ******************************************************/
 
-        err = trdp_pdSendQueued(appHandle);
+        TRDP_PROC_STAGE(appHandle, TRDP_STAGE_PD_SEND);
+        err = trdp_pdSendQueued(appHandle, now);
 
         if (err != TRDP_NO_ERR)
         {
@@ -1775,11 +2469,13 @@ EXT_DECL TRDP_ERR_T tlc_process (
         /******************************************************
          Find packets which are pending/overdue
          ******************************************************/
-        trdp_pdHandleTimeOuts(appHandle);
+        TRDP_PROC_STAGE(appHandle, TRDP_STAGE_PD_TIMEOUT);
+        trdp_pdHandleTimeOuts(appHandle, now);
 
 #if MD_SUPPORT
 
-        err = trdp_mdSend(appHandle);
+        TRDP_PROC_STAGE(appHandle, TRDP_STAGE_MD_SEND);
+        err = trdp_mdSend(appHandle, now);
         if (err != TRDP_NO_ERR)
         {
             if (err == TRDP_IO_ERR)
@@ -1799,7 +2495,8 @@ EXT_DECL TRDP_ERR_T tlc_process (
         /******************************************************
          Find packets which are to be received
          ******************************************************/
-        err = trdp_pdCheckListenSocks(appHandle, pRfds, pCount);
+        TRDP_PROC_STAGE(appHandle, TRDP_STAGE_PD_RECEIVE);
+        err = trdp_pdCheckListenSocks(appHandle, pRfds, pCount, now);
         if (err != TRDP_NO_ERR)
         {
             /*  We do not break here */
@@ -1808,11 +2505,23 @@ EXT_DECL TRDP_ERR_T tlc_process (
 
 #if MD_SUPPORT
 
+        TRDP_PROC_STAGE(appHandle, TRDP_STAGE_MD_RECEIVE);
         trdp_mdCheckListenSocks(appHandle, pRfds, pCount);
 
-        trdp_mdCheckTimeouts(appHandle);
+        TRDP_PROC_STAGE(appHandle, TRDP_STAGE_MD_TIMEOUT);
+        trdp_mdCheckTimeouts(appHandle, now);
+
+#endif
+
+        TRDP_PROC_STAGE(appHandle, TRDP_STAGE_OTHER);
+        trdp_metricsCheckListenSocks(appHandle, pRfds, pCount, now);
+        trdp_historyCheck(appHandle, now);
 
+        TRDP_TRACE(appHandle, TRDP_TRACE_PROCESS_EXIT, 0u, 0u, result);
+#if TRDP_TRACE_SUPPORT
+        trdp_traceCheckDump(appHandle);
 #endif
+        TRDP_PROC_STAGE(appHandle, TRDP_STAGE_PASS);
 
         if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
         {
@@ -1963,8 +2672,8 @@ EXT_DECL TRDP_ERR_T tlp_request (
                 else
                 {
                     /*  Mark this element as a PD PULL Request.  Request will be sent on tlc_process time.    */
-                    vos_clearTime(&pReqElement->interval);
-                    vos_clearTime(&pReqElement->timeToGo);
+                    pReqElement->interval   = 0;
+                    pReqElement->timeToGo   = 0;
 
                     /*  Update the internal data */
                     pReqElement->addr.comId         = comId;
@@ -1976,6 +2685,12 @@ EXT_DECL TRDP_ERR_T tlp_request (
                     pReqElement->pktFlags =
                         (pktFlags == TRDP_FLAGS_DEFAULT) ? appHandle->pdDefault.flags : pktFlags;
                     pReqElement->magic = TRDP_MAGIC_PUB_HNDL_VALUE;
+                    pReqElement->qos =
+                        (pSendParam != NULL) ? pSendParam->qos : appHandle->pdDefault.sendParam.qos;
+                    if (pReqElement->qos >= TRDP_QOS_CLASSES)
+                    {
+                        pReqElement->qos = TRDP_QOS_CLASSES - 1u;
+                    }
                     /*  Find a possible redundant entry in one of the other sessions and sync
                         the sequence counter! curSeqCnt holds the last sent sequence counter,
                         therefore set the value initially to -1, it will be incremented when sending... */
@@ -1983,6 +2698,7 @@ EXT_DECL TRDP_ERR_T tlp_request (
                                                             TRDP_MSG_PR, pReqElement->addr.srcIpAddr) - 1;
                     /*    Enter this request into the send queue.    */
                     trdp_queueInsFirst(&appHandle->pSndQueue, pReqElement);
+                    appHandle->stats.pd.numPub++;
                 }
             }
         }
@@ -2011,10 +2727,9 @@ EXT_DECL TRDP_ERR_T tlp_request (
             pReqElement->privFlags |= TRDP_REQ_2B_SENT;
 
             /*    Set the current time and start time out of subscribed packet  */
-            if (timerisset(&pSubPD->interval))
+            if (pSubPD->interval != 0)
             {
-                vos_getTime(&pSubPD->timeToGo);
-                vos_addTime(&pSubPD->timeToGo, &pSubPD->interval);
+                pSubPD->timeToGo = vos_getTimeNs() + pSubPD->interval;
                 pSubPD->privFlags &= (unsigned)~TRDP_TIMED_OUT;   /* Reset time out flag (#151) */
             }
         }
@@ -2029,60 +2744,30 @@ EXT_DECL TRDP_ERR_T tlp_request (
 }
 
 /**********************************************************************************************************************/
-/** Prepare for receiving PD messages.
- *  Subscribe to a specific PD ComID and source IP.
+/** Queue a subscriber, the session must be locked.
  *
- *  @param[in]      appHandle           the handle returned by tlc_openSession
- *  @param[out]     pSubHandle          return a handle for this subscription
- *  @param[in]      pUserRef            user supplied value returned within the info structure
- *  @param[in]      pfCbFunction        Pointer to subscriber specific callback function, NULL to use default function
- *  @param[in]      comId               comId of packet to receive
- *  @param[in]      etbTopoCnt          ETB topocount to use, 0 if consist local communication
- *  @param[in]      opTrnTopoCnt        operational topocount, != 0 for orientation/direction sensitive communication
- *  @param[in]      srcIpAddr1          Source IP address, lower address in case of address range, set to 0 if not used
- *  @param[in]      srcIpAddr2          upper address in case of address range, set to 0 if not used
- *  @param[in]      pktFlags            OPTION:
- *                                      TRDP_FLAGS_DEFAULT, TRDP_FLAGS_NONE, TRDP_FLAGS_MARSHALL, TRDP_FLAGS_CALLBACK
- *  @param[in]      destIpAddr          IP address to join
- *  @param[in]      timeout             timeout (>= 10ms) in usec
- *  @param[in]      toBehavior          timeout behavior
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pDesc               subscriber parameters
+ *  @param[in,out]  pSockCache          socket of the previous subscriber of a batch, NULL: no batch
+ *  @param[in,out]  ppTail              last element of the receive queue, NULL: search it
+ *  @param[out]     pSubHandle          returned handle, set if the subscriber was queued
  *
  *  @retval         TRDP_NO_ERR         no error
- *  @retval         TRDP_PARAM_ERR      parameter error
  *  @retval         TRDP_MEM_ERR        could not reserve memory (out of memory)
- *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_NOSUB_ERR      already subscribed
  */
-EXT_DECL TRDP_ERR_T tlp_subscribe (
-    TRDP_APP_SESSION_T  appHandle,
-    TRDP_SUB_T          *pSubHandle,
-    const void          *pUserRef,
-    TRDP_PD_CALLBACK_T  pfCbFunction,
-    UINT32              comId,
-    UINT32              etbTopoCnt,
-    UINT32              opTrnTopoCnt,
-    TRDP_IP_ADDR_T      srcIpAddr1,
-    TRDP_IP_ADDR_T      srcIpAddr2,
-    TRDP_IP_ADDR_T      destIpAddr,
-    TRDP_FLAGS_T        pktFlags,
-    UINT32              timeout,
-    TRDP_TO_BEHAVIOR_T  toBehavior)
+static TRDP_ERR_T trdp_pdSubscribe (
+    TRDP_SESSION_PT         appHandle,
+    const TRDP_SUB_DESC_T   *pDesc,
+    TRDP_BATCH_SOCK_T       *pSockCache,
+    PD_ELE_T                * *ppTail,
+    TRDP_SUB_T              *pSubHandle)
 {
-    TRDP_TIME_T         now;
-    TRDP_ERR_T          ret = TRDP_NO_ERR;
+    TRDP_ERR_T          ret     = TRDP_NO_ERR;
+    UINT32              timeout = pDesc->timeout;
     TRDP_ADDRESSES_T    subHandle;
     INT32 lIndex;
 
-    /*    Check params    */
-    if (pSubHandle == NULL)
-    {
-        return TRDP_PARAM_ERR;
-    }
-
-    if (!trdp_isValidSession(appHandle))
-    {
-        return TRDP_NOINIT_ERR;
-    }
-
     if (timeout == 0u)
     {
         timeout = appHandle->pdDefault.timeout;
@@ -2092,32 +2777,23 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
         timeout = TRDP_TIMER_GRANULARITY;
     }
 
-    /*    Reserve mutual access    */
-    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
-    {
-        return TRDP_NOINIT_ERR;
-    }
-
     /*  Create an addressing item   */
-    subHandle.comId         = comId;
-    subHandle.srcIpAddr     = srcIpAddr1;
-    subHandle.srcIpAddr2    = srcIpAddr2;
-    subHandle.destIpAddr    = destIpAddr;
+    subHandle.comId         = pDesc->comId;
+    subHandle.srcIpAddr     = pDesc->srcIpAddr1;
+    subHandle.srcIpAddr2    = pDesc->srcIpAddr2;
+    subHandle.destIpAddr    = pDesc->destIpAddr;
     subHandle.opTrnTopoCnt  = 0u;            /* Do not compare topocounts  */
     subHandle.etbTopoCnt    = 0u;
 
-    if (vos_isMulticast(destIpAddr))
+    if (vos_isMulticast(pDesc->destIpAddr))
     {
-        subHandle.mcGroup = destIpAddr;
+        subHandle.mcGroup = pDesc->destIpAddr;
     }
     else
     {
         subHandle.mcGroup = 0u;
     }
 
-    /*    Get the current time    */
-    vos_getTime(&now);
-
     /*    Look for existing element    */
     if (trdp_queueFindSubAddr(appHandle->pRcvQueue, &subHandle) != NULL)
     {
@@ -2125,21 +2801,12 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
     }
     else
     {
-        subHandle.opTrnTopoCnt  = opTrnTopoCnt; /* Set topocounts now  */
-        subHandle.etbTopoCnt    = etbTopoCnt;
+        subHandle.opTrnTopoCnt  = pDesc->opTrnTopoCnt; /* Set topocounts now  */
+        subHandle.etbTopoCnt    = pDesc->etbTopoCnt;
 
         /*    Find a (new) socket    */
-        ret = trdp_requestSocket(appHandle->iface,
-                                 appHandle->pdDefault.port,
-                                 &appHandle->pdDefault.sendParam,
-                                 appHandle->realIP,
-                                 subHandle.mcGroup,
-                                 TRDP_SOCK_PD,
-                                 appHandle->option,
-                                 TRUE,
-                                 -1,
-                                 &lIndex,
-                                 0u);
+        ret = trdp_batchSocket(appHandle, pSockCache, &appHandle->pdDefault.sendParam, appHandle->realIP,
+                               subHandle.mcGroup, TRUE, &lIndex);
 
         if (ret == TRDP_NO_ERR)
         {
@@ -2168,9 +2835,9 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
                 else
                 {
                     /*    Initialize some fields    */
-                    if (vos_isMulticast(destIpAddr))
+                    if (vos_isMulticast(pDesc->destIpAddr))
                     {
-                        newPD->addr.mcGroup = destIpAddr;
+                        newPD->addr.mcGroup = pDesc->destIpAddr;
                         newPD->privFlags    |= TRDP_MC_JOINT;
                     }
                     else
@@ -2178,38 +2845,53 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
                         newPD->addr.mcGroup = 0u;
                     }
 
-                    newPD->addr.comId       = comId;
-                    newPD->addr.srcIpAddr   = srcIpAddr1;
-                    newPD->addr.srcIpAddr2  = srcIpAddr2;
-                    newPD->addr.destIpAddr  = destIpAddr;
-                    newPD->interval.tv_sec  = timeout / 1000000u;
-                    newPD->interval.tv_usec = timeout % 1000000u;
+                    newPD->addr.comId       = pDesc->comId;
+                    newPD->addr.srcIpAddr   = pDesc->srcIpAddr1;
+                    newPD->addr.srcIpAddr2  = pDesc->srcIpAddr2;
+                    newPD->addr.destIpAddr  = pDesc->destIpAddr;
+                    newPD->interval         = (VOS_TIME_NS_T) timeout * 1000;
                     newPD->toBehavior       =
-                        (toBehavior == TRDP_TO_DEFAULT) ? appHandle->pdDefault.toBehavior : toBehavior;
+                        (pDesc->toBehavior == TRDP_TO_DEFAULT) ? appHandle->pdDefault.toBehavior : pDesc->toBehavior;
                     newPD->grossSize    = TRDP_MAX_PD_PACKET_SIZE;
-                    newPD->pUserRef     = pUserRef;
+                    newPD->pUserRef     = pDesc->pUserRef;
                     newPD->socketIdx    = lIndex;
                     newPD->privFlags    |= TRDP_INVALID_DATA;
                     newPD->pktFlags     =
-                        (pktFlags == TRDP_FLAGS_DEFAULT) ? appHandle->pdDefault.flags : pktFlags;
+                        (pDesc->pktFlags == TRDP_FLAGS_DEFAULT) ? appHandle->pdDefault.flags : pDesc->pktFlags;
                     newPD->pfCbFunction =
-                        (pfCbFunction == NULL) ? appHandle->pdDefault.pfCbFunction : pfCbFunction;
+                        (pDesc->pfCbFunction == NULL) ? appHandle->pdDefault.pfCbFunction : pDesc->pfCbFunction;
                     newPD->pCachedDS    = NULL;
                     newPD->magic        = TRDP_MAGIC_SUB_HNDL_VALUE;
 
                     if (timeout == TRDP_TIMER_FOREVER)
                     {
-                        vos_clearTime(&newPD->timeToGo);
-                        vos_clearTime(&newPD->interval);
+                        newPD->timeToGo = 0;
+                        newPD->interval = 0;
                     }
                     else
                     {
-                        vos_getTime(&newPD->timeToGo);
-                        vos_addTime(&newPD->timeToGo, &newPD->interval);
+                        newPD->timeToGo = vos_getTimeNs() + newPD->interval;
                     }
 
                     /*  append this subscription to our receive queue */
-                    trdp_queueAppLast(&appHandle->pRcvQueue, newPD);
+                    if (ppTail == NULL)
+                    {
+                        trdp_queueAppLast(&appHandle->pRcvQueue, newPD);
+                    }
+                    else
+                    {
+                        newPD->pNext = NULL;
+                        if (*ppTail == NULL)
+                        {
+                            appHandle->pRcvQueue = newPD;
+                        }
+                        else
+                        {
+                            (*ppTail)->pNext = newPD;
+                        }
+                        *ppTail = newPD;
+                    }
+                    appHandle->stats.pd.numSubs++;
 
                     *pSubHandle = (TRDP_SUB_T) newPD;
                 }
@@ -2217,6 +2899,158 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
         } /*lint !e438 unused newPD */
     }
 
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Prepare for receiving PD messages.
+ *  Subscribe to a specific PD ComID and source IP.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pSubHandle          return a handle for this subscription
+ *  @param[in]      pUserRef            user supplied value returned within the info structure
+ *  @param[in]      pfCbFunction        Pointer to subscriber specific callback function, NULL to use default function
+ *  @param[in]      comId               comId of packet to receive
+ *  @param[in]      etbTopoCnt          ETB topocount to use, 0 if consist local communication
+ *  @param[in]      opTrnTopoCnt        operational topocount, != 0 for orientation/direction sensitive communication
+ *  @param[in]      srcIpAddr1          Source IP address, lower address in case of address range, set to 0 if not used
+ *  @param[in]      srcIpAddr2          upper address in case of address range, set to 0 if not used
+ *  @param[in]      pktFlags            OPTION:
+ *                                      TRDP_FLAGS_DEFAULT, TRDP_FLAGS_NONE, TRDP_FLAGS_MARSHALL, TRDP_FLAGS_CALLBACK
+ *  @param[in]      destIpAddr          IP address to join
+ *  @param[in]      timeout             timeout (>= 10ms) in usec
+ *  @param[in]      toBehavior          timeout behavior
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        could not reserve memory (out of memory)
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlp_subscribe (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          *pSubHandle,
+    const void          *pUserRef,
+    TRDP_PD_CALLBACK_T  pfCbFunction,
+    UINT32              comId,
+    UINT32              etbTopoCnt,
+    UINT32              opTrnTopoCnt,
+    TRDP_IP_ADDR_T      srcIpAddr1,
+    TRDP_IP_ADDR_T      srcIpAddr2,
+    TRDP_IP_ADDR_T      destIpAddr,
+    TRDP_FLAGS_T        pktFlags,
+    UINT32              timeout,
+    TRDP_TO_BEHAVIOR_T  toBehavior)
+{
+    TRDP_SUB_DESC_T desc;
+    TRDP_ERR_T      ret = TRDP_NO_ERR;
+
+    /*    Check params    */
+    if (pSubHandle == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    desc.pUserRef       = pUserRef;
+    desc.pfCbFunction   = pfCbFunction;
+    desc.comId          = comId;
+    desc.etbTopoCnt     = etbTopoCnt;
+    desc.opTrnTopoCnt   = opTrnTopoCnt;
+    desc.srcIpAddr1     = srcIpAddr1;
+    desc.srcIpAddr2     = srcIpAddr2;
+    desc.destIpAddr     = destIpAddr;
+    desc.pktFlags       = pktFlags;
+    desc.timeout        = timeout;
+    desc.toBehavior     = toBehavior;
+
+    /*    Reserve mutual access    */
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    ret = trdp_pdSubscribe(appHandle, &desc, NULL, NULL, pSubHandle);
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Prepare for receiving a batch of PD messages.
+ *  Equivalent to one tlp_subscribe per descriptor, but the session is locked once and consecutive subscriptions
+ *  to the same destination share a socket request and multicast join.
+ *  A failing descriptor does not stop the batch, its handle is set to NULL.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      count               number of descriptors
+ *  @param[in]      pDesc               array of subscriber descriptors
+ *  @param[out]     pSubHandle          array of count returned handles, NULL for failed entries
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         other               error of the first failed descriptor (see tlp_subscribe)
+ */
+EXT_DECL TRDP_ERR_T tlp_subscribeBatch (
+    TRDP_APP_SESSION_T      appHandle,
+    UINT32                  count,
+    const TRDP_SUB_DESC_T   *pDesc,
+    TRDP_SUB_T              *pSubHandle)
+{
+    TRDP_BATCH_SOCK_T   sockCache;
+    PD_ELE_T            *pTail;
+    TRDP_ERR_T          ret = TRDP_NO_ERR;
+    TRDP_ERR_T          err;
+    UINT32              idx;
+
+    if ((count != 0u) && ((pDesc == NULL) || (pSubHandle == NULL)))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    memset(&sockCache, 0, sizeof(sockCache));
+    sockCache.socketIdx = TRDP_INVALID_SOCKET_INDEX;
+
+    /*    Reserve mutual access    */
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    /*  The batch is appended behind the current end of the receive queue  */
+    for (pTail = appHandle->pRcvQueue; (pTail != NULL) && (pTail->pNext != NULL); pTail = pTail->pNext)
+    {
+        ;
+    }
+
+    for (idx = 0u; idx < count; idx++)
+    {
+        pSubHandle[idx] = NULL;
+        err = trdp_pdSubscribe(appHandle, &pDesc[idx], &sockCache, &pTail, &pSubHandle[idx]);
+        if (err != TRDP_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_WARNING, "tlp_subscribeBatch: comId %u from %s failed (Err: %d)\n",
+                         (unsigned int) pDesc[idx].comId, vos_ipDotted(pDesc[idx].srcIpAddr1), err);
+            if (ret == TRDP_NO_ERR)
+            {
+                ret = err;
+            }
+        }
+    }
+
     if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
     {
         vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
@@ -2267,6 +3101,7 @@ EXT_DECL TRDP_ERR_T tlp_unsubscribe (
         TRDP_IP_ADDR_T mcGroup = pElement->addr.mcGroup;
         /*    Remove from queue?    */
         trdp_queueDelElement(&appHandle->pRcvQueue, pElement);
+        appHandle->stats.pd.numSubs--;
         /*    if we subscribed to an MC-group, check if anyone else did too: */
         if (mcGroup != VOS_INADDR_ANY)
         {
@@ -2278,6 +3113,10 @@ EXT_DECL TRDP_ERR_T tlp_unsubscribe (
         {
             vos_memFree(pElement->pFrame);
         }
+        if (pElement->pLatency != NULL)
+        {
+            vos_memFree(pElement->pLatency);
+        }
         if (pElement->pSeqCntList != NULL)
         {
             vos_memFree(pElement->pSeqCntList);
@@ -2422,9 +3261,9 @@ EXT_DECL TRDP_ERR_T tlp_get (
     UINT8               *pData,
     UINT32              *pDataSize)
 {
-    PD_ELE_T    *pElement   = (PD_ELE_T *) subHandle;
-    TRDP_ERR_T  ret         = TRDP_NOSUB_ERR;
-    TRDP_TIME_T now;
+    PD_ELE_T        *pElement   = (PD_ELE_T *) subHandle;
+    TRDP_ERR_T      ret         = TRDP_NOSUB_ERR;
+    VOS_TIME_NS_T   now;
 
     if (pElement == NULL)
     {
@@ -2445,21 +3284,21 @@ EXT_DECL TRDP_ERR_T tlp_get (
     ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
     if (ret == TRDP_NO_ERR)
     {
+        /*    Get the current time    */
+        now = vos_getTimeNs();
+
         /*    Call the receive function if we are in non blocking mode    */
         if (!(appHandle->option & TRDP_OPTION_BLOCK))
         {
             /* read all you can get, return value is not interesting */
             do
             {}
-            while (trdp_pdReceive(appHandle, appHandle->iface[pElement->socketIdx].sock) == TRDP_NO_ERR);
+            while (trdp_pdReceive(appHandle, appHandle->iface[pElement->socketIdx].sock, now) == TRDP_NO_ERR);
         }
 
-        /*    Get the current time    */
-        vos_getTime(&now);
-
         /*    Check time out    */
-        if (timerisset(&pElement->interval) &&
-            timercmp(&pElement->timeToGo, &now, <))
+        if ((pElement->interval != 0) &&
+            (pElement->timeToGo < now))
         {
             /*    Packet is late    */
             if (pElement->toBehavior == TRDP_TO_SET_TO_ZERO &&
@@ -2942,6 +3781,25 @@ TRDP_ERR_T tlm_delListener (
                                    FALSE,
                                    mcGroup);
             }
+            /* sessions still open account their callbacks to the caller entry from now on */
+            {
+                MD_ELE_T *iterMD;
+
+                for (iterMD = appHandle->pMDRcvQueue; iterMD != NULL; iterMD = iterMD->pNext)
+                {
+                    if (iterMD->pListener == pDelete)
+                    {
+                        iterMD->pListener = NULL;
+                    }
+                }
+                for (iterMD = appHandle->pMDSndQueue; iterMD != NULL; iterMD = iterMD->pNext)
+                {
+                    if (iterMD->pListener == pDelete)
+                    {
+                        iterMD->pListener = NULL;
+                    }
+                }
+            }
             /* free memory space for element */
             vos_memFree(pDelete);
         }
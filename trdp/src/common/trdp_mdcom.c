@@ -19,6 +19,12 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: Callbacks timed only if TRDP_CB_TIMED (TRDP_OPTION_CALLBACK_STATS)
+ *      BL 2026-10-17: Execution time of every callback accounted to its listener (MD_ELE_T.pListener) or the caller
+ *      BL 2026-10-17: Callback execution times checked against the callback budget (TRDP_PROC_CALLBACK)
+ *      BL 2026-10-17: Event trace: MD rx, tx and state changes (trdp_mdFillStateElement takes the session)
+ *      BL 2026-10-17: MD send rate limited by a token bucket (trdp_mdRateRefill/trdp_mdRateCheck)
+ *      BL 2026-10-17: trdp_mdCheckTimeouts() takes the time of the processing pass
  *      BL 2018-11-07: Ticket #185 MD reply: Infinite timeout wrong handled
  *      BL 2018-11-07: Ticket #220 Message Data - Different behaviour UDP & TCP
  *      BL 2018-11-06: for-loops limited to sCurrentMaxSocketCnt instead VOS_MAX_SOCKET_CNT
@@ -65,6 +71,8 @@
 #include "trdp_if.h"
 #include "trdp_utils.h"
 #include "trdp_mdcom.h"
+#include "trdp_trace.h"
+#include "trdp_stats.h"
 
 
 /***********************************************************************************************************************
@@ -90,7 +98,8 @@ static const TRDP_MD_INFO_T cTrdp_md_info_default;
  *   Local Functions
  */
 static void         trdp_mdUpdatePacket (MD_ELE_T *pElement);
-static void         trdp_mdFillStateElement (const TRDP_MSG_T   msgType,
+static void         trdp_mdFillStateElement (TRDP_SESSION_PT    appHandle,
+                                             const TRDP_MSG_T   msgType,
                                              MD_ELE_T           *pMdElement);
 static void         trdp_mdManageSessionId (TRDP_UUID_T pSessionId,
                                             MD_ELE_T    *pMdElement);
@@ -163,17 +172,25 @@ static TRDP_ERR_T   trdp_mdConnectSocket (TRDP_APP_SESSION_T        appHandle,
                                           BOOL8                     newSession,
                                           MD_ELE_T                  *pSenderElement);
 
+static void         trdp_mdRateRefill (TRDP_SESSION_PT  appHandle,
+                                       VOS_TIME_NS_T    now);
+
+static BOOL8        trdp_mdRateCheck (TRDP_SESSION_PT   appHandle,
+                                      const MD_ELE_T    *pElement,
+                                      VOS_TIME_NS_T     now);
+
 /**********************************************************************************************************************/
 /** Set the statEle property to next state
  *  Prior transmission the next state for the MD_ELE_T has to be set.
  *  This is handled within this function.
  *
+ *  @param[in]      appHandle           session pointer (for the event trace)
  *  @param[in]      msgType             Type of MD message
  *  @param[out]     pMdElement          MD element taken from queue or newly allocated
  *
  *  @retval         none
  */
-static void trdp_mdFillStateElement (const TRDP_MSG_T msgType, MD_ELE_T *pMdElement)
+static void trdp_mdFillStateElement (TRDP_SESSION_PT appHandle, const TRDP_MSG_T msgType, MD_ELE_T *pMdElement)
 {
     switch (msgType)
     {
@@ -200,6 +217,7 @@ static void trdp_mdFillStateElement (const TRDP_MSG_T msgType, MD_ELE_T *pMdElem
            pMdElement->stateEle = TRDP_ST_TX_NOTIFY_ARM;
            break;
     }
+    TRDP_TRACE(appHandle, TRDP_TRACE_MD_STATE, pMdElement->addr.comId, pMdElement->curSeqCnt, pMdElement->stateEle);
 }
 
 
@@ -305,6 +323,8 @@ static void trdp_mdInvokeCallback (const MD_ELE_T           *pMdItem,
 {
     INT32 replyStatus = 0;
     TRDP_MD_INFO_T theMessage = cTrdp_md_info_default;
+    VOS_TIME_NS_T cbStart;
+    BOOL8         timed;
 
     if (pMdItem == NULL)
     {
@@ -351,6 +371,8 @@ static void trdp_mdInvokeCallback (const MD_ELE_T           *pMdItem,
     /* theMessage.pUserRef     = appHandle->mdDefault.pRefCon; */
     theMessage.resultCode = resultCode;
 
+    timed   = TRDP_CB_TIMED(appHandle);
+    cbStart = (timed == TRUE) ? vos_getTimeNs() : 0;
     if ((resultCode == TRDP_NO_ERR) && (pMdItem->pPacket != NULL))
     {
         theMessage.comId        = vos_ntohl(pMdItem->pPacket->frameHead.comId);
@@ -378,6 +400,13 @@ static void trdp_mdInvokeCallback (const MD_ELE_T           *pMdItem,
             (UINT8 *)NULL,
             0u);
     }
+    /*  The listener is looked up after the callback, it may have been deleted meanwhile  */
+    if (timed == TRUE)
+    {
+        trdp_cbAccount(appHandle,
+                       (pMdItem->pListener != NULL) ? &pMdItem->pListener->cbStats : &appHandle->mdCallerCb,
+                       theMessage.comId, vos_getTimeNs() - cbStart);
+    }
 }
 
 /**********************************************************************************************************************/
@@ -937,6 +966,83 @@ static TRDP_ERR_T trdp_mdCheck (TRDP_SESSION_PT appHandle,
     return err;
 }
 
+/**********************************************************************************************************************/
+/** Refill the MD token bucket
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      now             time of the processing pass
+ */
+static void trdp_mdRateRefill (TRDP_SESSION_PT appHandle, VOS_TIME_NS_T now)
+{
+    TRDP_ADMISSION_T    *pAdm = &appHandle->admission;
+    VOS_TIME_NS_T       elapsed;
+    INT64               add;
+
+    if (pAdm->mdRate == 0u)
+    {
+        return;
+    }
+    if ((pAdm->mdLastFill == 0) || (now < pAdm->mdLastFill))
+    {
+        pAdm->mdLastFill = now;
+        return;
+    }
+
+    elapsed = now - pAdm->mdLastFill;
+    add     = (elapsed / 1000000000) * (INT64) pAdm->mdRate +
+        ((elapsed % 1000000000) * (INT64) pAdm->mdRate) / 1000000000;
+
+    if (pAdm->mdCredit + add >= (INT64) pAdm->mdDepth)
+    {
+        pAdm->mdCredit      = (INT64) pAdm->mdDepth;
+        pAdm->mdLastFill    = now;
+    }
+    else
+    {
+        /*  Only account the time the added bytes stand for, the remainder is carried over  */
+        pAdm->mdCredit      += add;
+        pAdm->mdLastFill    += (add * 1000000000) / (INT64) pAdm->mdRate;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Check the MD token bucket before sending
+ *
+ *  A message may be sent if the bucket holds its gross size or is full (messages larger than the bucket).
+ *  If not, the time the bucket will allow it is remembered as wake up for the next processing pass.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pElement        message to send
+ *  @param[in]      now             time of the processing pass
+ *
+ *  @retval         TRUE            send now
+ *  @retval         FALSE           defer, keep the message armed
+ */
+static BOOL8 trdp_mdRateCheck (TRDP_SESSION_PT appHandle, const MD_ELE_T *pElement, VOS_TIME_NS_T now)
+{
+    TRDP_ADMISSION_T    *pAdm = &appHandle->admission;
+    INT64               needed;
+    VOS_TIME_NS_T       wakeUp;
+
+    if ((pAdm->mdRate == 0u) ||
+        (pAdm->mdCredit >= (INT64) pElement->grossSize) ||
+        (pAdm->mdCredit >= (INT64) pAdm->mdDepth))
+    {
+        return TRUE;
+    }
+
+    needed = ((INT64) pElement->grossSize < (INT64) pAdm->mdDepth) ?
+        (INT64) pElement->grossSize : (INT64) pAdm->mdDepth;
+    wakeUp = now + ((needed - pAdm->mdCredit) * 1000000000 + pAdm->mdRate - 1) / (INT64) pAdm->mdRate;
+
+    if ((pAdm->mdWakeUp == 0) || (wakeUp < pAdm->mdWakeUp))
+    {
+        pAdm->mdWakeUp = wakeUp;
+    }
+    pAdm->numMdDeferred++;
+    return FALSE;
+}
+
 /**********************************************************************************************************************/
 /** Update the header values
  *
@@ -1486,6 +1592,9 @@ static TRDP_ERR_T  trdp_mdRecvPacket (
     {
        case TRDP_NO_ERR:
            pElementStatistics->numRcv++;
+           TRDP_TRACE(appHandle, TRDP_TRACE_MD_RX, vos_ntohl(pElement->pPacket->frameHead.comId),
+                      vos_ntohl(pElement->pPacket->frameHead.sequenceCounter),
+                      vos_ntohs(pElement->pPacket->frameHead.msgType));
            break;
        case TRDP_CRC_ERR:
            pElementStatistics->numCrcErr++;
@@ -1698,6 +1807,7 @@ static TRDP_ERR_T trdp_mdHandleRequest (TRDP_SESSION_PT     appHandle,
             iterMD = appHandle->pMDRcvEle;
             iterMD->pUserRef = iterListener->pUserRef;
             iterMD->pfCbFunction        = iterListener->pfCbFunction;
+            iterMD->pListener           = iterListener;
             iterMD->stateEle            = state;
             iterMD->addr.etbTopoCnt     = iterListener->addr.etbTopoCnt;
             iterMD->addr.opTrnTopoCnt   = iterListener->addr.opTrnTopoCnt;
@@ -1849,7 +1959,7 @@ static TRDP_ERR_T trdp_mdSendME (TRDP_SESSION_PT appHandle, MD_HEADER_T *pH, INT
                                         pSenderElement);
             if ( errv == TRDP_NO_ERR )
             {
-                trdp_mdFillStateElement(TRDP_MSG_ME, pSenderElement);
+                trdp_mdFillStateElement(appHandle, TRDP_MSG_ME, pSenderElement);
 
                 memcpy(pSenderElement->sessionID, pH->sessionID, TRDP_SESS_ID_SIZE);
                 /*
@@ -2166,14 +2276,20 @@ void trdp_mdFreeSession (
  *  Call user's callback if needed
  *
  *  @param[in]      appHandle           session pointer
+ *  @param[in]      now                 time of the processing pass
  */
 TRDP_ERR_T  trdp_mdSend (
-    TRDP_SESSION_PT appHandle)
+    TRDP_SESSION_PT appHandle,
+    VOS_TIME_NS_T   now)
 {
     TRDP_ERR_T  result      = TRDP_NO_ERR;
     MD_ELE_T    *iterMD     = appHandle->pMDSndQueue;
     BOOL8       firstLoop   = TRUE;
 
+    /*  Rate limit: refill the token bucket once per pass, deferred messages recompute the wake up  */
+    trdp_mdRateRefill(appHandle, now);
+    appHandle->admission.mdWakeUp = 0;
+
     /*  Find the packet which has to be sent next:
      Note: We must also check the receive queue for pending replies! */
     do
@@ -2223,6 +2339,10 @@ TRDP_ERR_T  trdp_mdSend (
                 vos_printLogStr(VOS_LOG_ERROR, "Sending MD: Socket invalid!\n");
                 /* Try to send the other packets */
             }
+            else if (!trdp_mdRateCheck(appHandle, iterMD, now))
+            {
+                /*    Rate limited: the message stays armed and is sent in a later pass    */
+            }
             /*    Send the packet if it is not redundant    */
             else if (!(iterMD->privFlags & TRDP_REDUNDANT))
             {
@@ -2312,6 +2432,12 @@ TRDP_ERR_T  trdp_mdSend (
 
                     if (result == TRDP_NO_ERR)
                     {
+                        TRDP_TRACE(appHandle, TRDP_TRACE_MD_TX, iterMD->addr.comId,
+                                   vos_ntohl(iterMD->pPacket->frameHead.sequenceCounter), nextstate);
+                        if (appHandle->admission.mdRate != 0u)
+                        {
+                            appHandle->admission.mdCredit -= (INT64) iterMD->grossSize;
+                        }
                         if ((iterMD->pktFlags & TRDP_FLAGS_TCP) != 0)
                         {
                             appHandle->iface[iterMD->socketIdx].tcpParams.notSend = FALSE;
@@ -2564,6 +2690,13 @@ void trdp_mdCheckPending (
             }
         }
     }
+
+    /*  Wake up when the token bucket allows the next deferred message  */
+    if ((appHandle->admission.mdWakeUp != 0) &&
+        ((appHandle->nextJob == 0) || (appHandle->admission.mdWakeUp < appHandle->nextJob)))
+    {
+        appHandle->nextJob = appHandle->admission.mdWakeUp;
+    }
 }
 
 
@@ -2893,29 +3026,31 @@ void  trdp_mdCheckListenSocks (
  *  Call user's callback if needed
  *
  *  @param[in]      appHandle           session pointer
+ *  @param[in]      now                 current time (of this processing pass)
  */
 void  trdp_mdCheckTimeouts (
-    TRDP_SESSION_PT appHandle)
+    TRDP_SESSION_PT appHandle,
+    VOS_TIME_NS_T   now)
 {
     MD_ELE_T    *iterMD     = appHandle->pMDSndQueue;
     BOOL8       firstLoop   = TRUE;
     BOOL8       timeOut     = FALSE;
-    TRDP_TIME_T now;
+    TRDP_TIME_T tvNow;
 
     if (appHandle == NULL)
     {
         return;
     }
 
+    /* MD sessions and sockets keep their time outs as timeval */
+    VOS_NS_TO_TIME(now, &tvNow);
+
     /*  Find the sessions which needs action
      Note: We must also check the receive queue for pending replies! */
     do
     {
         TRDP_ERR_T resultCode = TRDP_UNKNOWN_ERR;
 
-        /* Update the current time always inside loop in case of application delays  */
-        vos_getTime(&now);
-
         /*  Switch to receive queue */
         if (NULL == iterMD && TRUE == firstLoop)
         {
@@ -2932,7 +3067,7 @@ void  trdp_mdCheckTimeouts (
         /* timeToGo is timeout value! */
         if (((iterMD->interval.tv_sec != TRDP_MD_INFINITE_TIME) ||
              (iterMD->interval.tv_usec != TRDP_MD_INFINITE_USEC_TIME)) &&
-            (0 > vos_cmpTime(&iterMD->timeToGo, &now)))     /* timeout overflow */
+            (0 > vos_cmpTime(&iterMD->timeToGo, &tvNow)))   /* timeout overflow */
         {
             timeOut = trdp_mdTimeOutStateHandler( iterMD, appHandle, &resultCode);
         }
@@ -2943,6 +3078,9 @@ void  trdp_mdCheckTimeouts (
             if (iterMD->pfCbFunction != NULL)
             {
                 trdp_mdInvokeCallback(iterMD, appHandle, resultCode);
+
+                /* Update the current time in case of application delays  */
+                vos_getTime(&tvNow);
             }
         }
 
@@ -2964,7 +3102,7 @@ void  trdp_mdCheckTimeouts (
                 && ((appHandle->iface[lIndex].tcpParams.connectionTimeout.tv_sec > 0)
                     || (appHandle->iface[lIndex].tcpParams.connectionTimeout.tv_usec > 0)))
             {
-                if (0 > vos_cmpTime(&appHandle->iface[lIndex].tcpParams.connectionTimeout, &now))
+                if (0 > vos_cmpTime(&appHandle->iface[lIndex].tcpParams.connectionTimeout, &tvNow))
                 {
                     vos_printLog(VOS_LOG_INFO, "The socket (Num = %d) TIMEOUT\n", (int) appHandle->iface[lIndex].sock);
                     appHandle->iface[lIndex].tcpParams.morituri = TRUE;
@@ -2984,7 +3122,7 @@ void  trdp_mdCheckTimeouts (
                 && (appHandle->iface[lIndex].rcvMostly == FALSE)
                 && (appHandle->iface[lIndex].tcpParams.sendNotOk == TRUE))
             {
-                if (0 > vos_cmpTime(&appHandle->iface[lIndex].tcpParams.sendingTimeout, &now))
+                if (0 > vos_cmpTime(&appHandle->iface[lIndex].tcpParams.sendingTimeout, &tvNow))
                 {
                     MD_ELE_T *iterMD_find = NULL;
 
@@ -3275,7 +3413,7 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T           msgType,
                 pSenderElement->numReplies      = 0u;
                 pSenderElement->pCachedDS       = NULL;
                 pSenderElement->morituri        = FALSE;
-                trdp_mdFillStateElement(msgType, pSenderElement);
+                trdp_mdFillStateElement(appHandle, msgType, pSenderElement);
                 trdp_mdManageSessionId(pSessionId, pSenderElement);
 
                 if ( msgType == TRDP_MSG_MQ )
@@ -3501,7 +3639,7 @@ TRDP_ERR_T trdp_mdCall (
                                     pSenderElement);
         if ( errv == TRDP_NO_ERR )
         {
-            trdp_mdFillStateElement(msgType, pSenderElement);
+            trdp_mdFillStateElement(appHandle, msgType, pSenderElement);
 
             trdp_mdManageSessionId((UINT8 *)pSessionId, pSenderElement);
 
@@ -3638,7 +3776,7 @@ TRDP_ERR_T trdp_mdConfirm (
 
             if ( TRDP_NO_ERR == errv )
             {
-                trdp_mdFillStateElement(TRDP_MSG_MC, pSenderElement);
+                trdp_mdFillStateElement(appHandle, TRDP_MSG_MC, pSenderElement);
 
                 vos_printLog(VOS_LOG_INFO, "Using %s MD session '%02x%02x%02x%02x%02x%02x%02x%02x'\n",
                              pSenderElement->pktFlags & TRDP_FLAGS_TCP ? "TCP" : "UDP",
@@ -16,6 +16,8 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: trdp_mdSend() takes the time of the processing pass (MD rate limit)
+ *      BL 2026-10-17: trdp_mdCheckTimeouts() takes the time of the processing pass
  *     AHW 2017-11-08: Ticket #179 Max. number of retries (part of sendParam) of a MD request needs to be checked
  *      BL 2014-07-14: Ticket #46: Protocol change: operational topocount needed
  *                     Ticket #47: Protocol change: no FCS for data part of telegrams
@@ -51,7 +53,8 @@ void        trdp_mdFreeSession (
     MD_ELE_T *pMDSession);
 
 TRDP_ERR_T  trdp_mdSend (
-    TRDP_SESSION_PT appHandle);
+    TRDP_SESSION_PT appHandle,
+    VOS_TIME_NS_T   now);
 
 void        trdp_mdCheckPending (
     TRDP_APP_SESSION_T  appHandle,
@@ -64,7 +67,8 @@ void trdp_mdCheckListenSocks (
     INT32           *pCount);
 
 void        trdp_mdCheckTimeouts (
-    TRDP_SESSION_PT appHandle);
+    TRDP_SESSION_PT appHandle,
+    VOS_TIME_NS_T   now);
 
 TRDP_ERR_T  trdp_mdCommonSend (
     const TRDP_MSG_T        msgType,
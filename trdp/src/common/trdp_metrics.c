@@ -0,0 +1,1102 @@
+/******************************************************************************/
+/**
+ * @file            trdp_metrics.c
+ *
+ * @brief           OpenMetrics exporter for TRDP statistics
+ *
+ * @details         TRDP_STATISTICS_T, publisher and subscription counters, memory pool usage and the latency
+ *                  histograms (TRDP_OPTION_LATENCY_STATS) are rendered in OpenMetrics text format.
+ *                  The text is returned by tlc_getMetrics() or served over HTTP (GET /metrics) from a listening
+ *                  socket opened by tlc_setMetricsPort(). The endpoint is part of the session's descriptor set
+ *                  and is served from tlc_process(), no extra thread is needed. The response is rendered in
+ *                  slices of TRDP_METRICS_SLICE publishers / subscriptions per pass to keep the session lock short,
+ *                  and is sent as far as the client takes it; the rest follows in later passes.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/*******************************************************************************
+ * INCLUDES
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include "trdp_metrics.h"
+#include "trdp_stats.h"
+#include "trdp_if_light.h"
+#include "trdp_if.h"
+#include "trdp_private.h"
+#include "vos_mem.h"
+#include "vos_sock.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+
+/*******************************************************************************
+ * DEFINES
+ */
+
+#define TRDP_METRICS_CONTENT_TYPE   "application/openmetrics-text; version=1.0.0; charset=utf-8"
+
+/*******************************************************************************
+ * TYPEDEFS
+ */
+
+/** Output buffer of the renderer, 'len' keeps counting beyond 'size' */
+typedef struct
+{
+    CHAR8   *pBuf;
+    UINT32  size;
+    UINT32  len;
+} TRDP_METRICS_OUT_T;
+
+struct TRDP_METRICS_FAMILY;
+
+/** Writes the samples of a publisher or subscription */
+typedef void (TRDP_METRICS_SAMPLE_T)(TRDP_METRICS_OUT_T *pOut, const struct TRDP_METRICS_FAMILY *pFamily,
+                                     const PD_ELE_T *pElement);
+
+/** Metric family with samples per publisher or subscription */
+typedef struct TRDP_METRICS_FAMILY
+{
+    const CHAR8             *pName;     /**< family name                                            */
+    const CHAR8             *pType;     /**< counter, gauge or histogram                            */
+    const CHAR8             *pHelp;     /**< description, NULL: continues the family above          */
+    BOOL8                   subs;       /**< TRUE: subscriptions, FALSE: publishers                 */
+    TRDP_METRICS_SAMPLE_T   *pSample;   /**< writes the samples of an element                       */
+} TRDP_METRICS_FAMILY_T;
+
+/******************************************************************************
+ *   Locals
+ */
+
+static const UINT32 cMemBlockSizes[VOS_MEM_NBLOCKSIZES] = VOS_MEM_BLOCKSIZES;
+
+static void trdp_metricsPrint (TRDP_METRICS_OUT_T *pOut, const CHAR8 *pFormat, ...);
+static void trdp_metricsIp (CHAR8 *pBuf, TRDP_IP_ADDR_T ip);
+static void trdp_metricsFamily (TRDP_METRICS_OUT_T *pOut, const CHAR8 *pName, const CHAR8 *pType,
+                                const CHAR8 *pHelp);
+static void trdp_metricsValue (TRDP_METRICS_OUT_T *pOut, const CHAR8 *pName, const CHAR8 *pType,
+                               const CHAR8 *pHelp, UINT32 value);
+static void trdp_metricsMd (TRDP_METRICS_OUT_T *pOut, const CHAR8 *pName, const CHAR8 *pType, const CHAR8 *pHelp,
+                            UINT32 udpValue, UINT32 tcpValue);
+static void trdp_metricsLabels (TRDP_METRICS_OUT_T *pOut, const PD_ELE_T *pElement);
+static void trdp_metricsHistogram (TRDP_METRICS_OUT_T *pOut, const CHAR8 *pName, const PD_ELE_T *pElement,
+                                   const CHAR8 *pRole, const TRDP_LAT_HIST_T *pHist);
+static void trdp_metricsCounter (TRDP_METRICS_OUT_T *pOut, const CHAR8 *pName, const PD_ELE_T *pElement,
+                                 UINT32 value);
+static TRDP_METRICS_SAMPLE_T    trdp_metricsRxTx;
+static TRDP_METRICS_SAMPLE_T    trdp_metricsPut;
+static TRDP_METRICS_SAMPLE_T    trdp_metricsMissed;
+static TRDP_METRICS_SAMPLE_T    trdp_metricsInterval;
+static TRDP_METRICS_SAMPLE_T    trdp_metricsTimedOut;
+static TRDP_METRICS_SAMPLE_T    trdp_metricsLatency;
+static TRDP_METRICS_SAMPLE_T    trdp_metricsCallback;
+static void trdp_metricsCounters (TRDP_SESSION_PT appHandle, TRDP_METRICS_OUT_T *pOut);
+static BOOL8 trdp_metricsRender (TRDP_SESSION_PT appHandle, TRDP_METRICS_OUT_T *pOut, UINT32 *pFamily,
+                                 UINT32 *pElement, UINT32 maxElements);
+static void trdp_metricsDropClient (TRDP_SESSION_PT appHandle);
+static BOOL8 trdp_metricsGrow (TRDP_METRICS_T *pMetrics, UINT32 needed);
+static void trdp_metricsServe (TRDP_SESSION_PT appHandle, VOS_TIME_NS_T now);
+static void trdp_metricsProgress (TRDP_SESSION_PT appHandle, VOS_TIME_NS_T now);
+
+/**********************************************************************************************************************/
+/** Append formatted text to the output buffer. The text is cut at the buffer end, but its length is counted.
+ *
+ *  @param[in,out]  pOut            output buffer
+ *  @param[in]      pFormat         printf format
+ */
+static void trdp_metricsPrint (
+    TRDP_METRICS_OUT_T  *pOut,
+    const CHAR8         *pFormat,
+    ...)
+{
+    va_list args;
+    int     n;
+    UINT32  room = (pOut->len < pOut->size) ? pOut->size - pOut->len : 0u;
+
+    va_start(args, pFormat);
+    n = vsnprintf((room > 0u) ? pOut->pBuf + pOut->len : NULL, room, pFormat, args);
+    va_end(args);
+    if (n > 0)
+    {
+        pOut->len += (UINT32) n;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Dotted notation of an IP address
+ *
+ *  @param[out]     pBuf            buffer of at least 16 characters
+ *  @param[in]      ip              IP address (host order)
+ */
+static void trdp_metricsIp (
+    CHAR8           *pBuf,
+    TRDP_IP_ADDR_T  ip)
+{
+    (void) vos_snprintf(pBuf, 16u, "%u.%u.%u.%u",
+                        (unsigned int) ((ip >> 24) & 0xFFu), (unsigned int) ((ip >> 16) & 0xFFu),
+                        (unsigned int) ((ip >> 8) & 0xFFu), (unsigned int) (ip & 0xFFu));
+}
+
+/**********************************************************************************************************************/
+/** Metric family header
+ *
+ *  @param[in,out]  pOut            output buffer
+ *  @param[in]      pName           family name (without _total)
+ *  @param[in]      pType           counter, gauge, histogram or info
+ *  @param[in]      pHelp           description
+ */
+static void trdp_metricsFamily (
+    TRDP_METRICS_OUT_T  *pOut,
+    const CHAR8         *pName,
+    const CHAR8         *pType,
+    const CHAR8         *pHelp)
+{
+    trdp_metricsPrint(pOut, "# TYPE %s %s\n# HELP %s %s\n", pName, pType, pName, pHelp);
+}
+
+/**********************************************************************************************************************/
+/** Metric family with a single sample
+ *
+ *  @param[in,out]  pOut            output buffer
+ *  @param[in]      pName           family name
+ *  @param[in]      pType           counter or gauge
+ *  @param[in]      pHelp           description
+ *  @param[in]      value           sample value
+ */
+static void trdp_metricsValue (
+    TRDP_METRICS_OUT_T  *pOut,
+    const CHAR8         *pName,
+    const CHAR8         *pType,
+    const CHAR8         *pHelp,
+    UINT32              value)
+{
+    trdp_metricsFamily(pOut, pName, pType, pHelp);
+    trdp_metricsPrint(pOut, "%s%s %u\n", pName, (pType[0] == 'c') ? "_total" : "", (unsigned int) value);
+}
+
+/**********************************************************************************************************************/
+/** Metric family with a sample per MD transport
+ *
+ *  @param[in,out]  pOut            output buffer
+ *  @param[in]      pName           family name
+ *  @param[in]      pType           counter or gauge
+ *  @param[in]      pHelp           description
+ *  @param[in]      udpValue        value of UDP MD
+ *  @param[in]      tcpValue        value of TCP MD
+ */
+static void trdp_metricsMd (
+    TRDP_METRICS_OUT_T  *pOut,
+    const CHAR8         *pName,
+    const CHAR8         *pType,
+    const CHAR8         *pHelp,
+    UINT32              udpValue,
+    UINT32              tcpValue)
+{
+    const CHAR8 *pSuffix = (pType[0] == 'c') ? "_total" : "";
+
+    trdp_metricsFamily(pOut, pName, pType, pHelp);
+    trdp_metricsPrint(pOut, "%s%s{transport=\"udp\"} %u\n%s%s{transport=\"tcp\"} %u\n",
+                      pName, pSuffix, (unsigned int) udpValue, pName, pSuffix, (unsigned int) tcpValue);
+}
+
+/**********************************************************************************************************************/
+/** Labels identifying a publisher or subscription, without the closing brace
+ *
+ *  @param[in,out]  pOut            output buffer
+ *  @param[in]      pElement        publisher or subscription
+ */
+static void trdp_metricsLabels (
+    TRDP_METRICS_OUT_T  *pOut,
+    const PD_ELE_T      *pElement)
+{
+    CHAR8 src[16];
+    CHAR8 dest[16];
+
+    trdp_metricsIp(src, pElement->addr.srcIpAddr);
+    trdp_metricsIp(dest, (pElement->addr.mcGroup != 0u) ? pElement->addr.mcGroup : pElement->addr.destIpAddr);
+    trdp_metricsPrint(pOut, "{comId=\"%u\",src=\"%s\",dest=\"%s\"",
+                      (unsigned int) pElement->addr.comId, src, dest);
+}
+
+/**********************************************************************************************************************/
+/** Latency histogram of a publisher or subscription, only buckets with samples are written
+ *
+ *  @param[in,out]  pOut            output buffer
+ *  @param[in]      pName           family name
+ *  @param[in]      pElement        publisher or subscription
+ *  @param[in]      pRole           "publisher" or "subscription"
+ *  @param[in]      pHist           histogram (ns)
+ */
+static void trdp_metricsHistogram (
+    TRDP_METRICS_OUT_T      *pOut,
+    const CHAR8             *pName,
+    const PD_ELE_T          *pElement,
+    const CHAR8             *pRole,
+    const TRDP_LAT_HIST_T   *pHist)
+{
+    UINT32 idx;
+    UINT32 cumulated = 0u;
+
+    for (idx = 0u; idx < TRDP_LAT_BUCKETS; idx++)
+    {
+        if (pHist->bucket[idx] != 0u)
+        {
+            cumulated += pHist->bucket[idx];
+            trdp_metricsPrint(pOut, "%s_bucket", pName);
+            trdp_metricsLabels(pOut, pElement);
+            trdp_metricsPrint(pOut, ",role=\"%s\",le=\"%.9f\"} %u\n",
+                              pRole, (double) trdp_latBucketLimit(idx) / 1e9, (unsigned int) cumulated);
+        }
+    }
+    trdp_metricsPrint(pOut, "%s_bucket", pName);
+    trdp_metricsLabels(pOut, pElement);
+    trdp_metricsPrint(pOut, ",role=\"%s\",le=\"+Inf\"} %u\n", pRole, (unsigned int) pHist->count);
+    trdp_metricsPrint(pOut, "%s_count", pName);
+    trdp_metricsLabels(pOut, pElement);
+    trdp_metricsPrint(pOut, ",role=\"%s\"} %u\n", pRole, (unsigned int) pHist->count);
+    trdp_metricsPrint(pOut, "%s_sum", pName);
+    trdp_metricsLabels(pOut, pElement);
+    trdp_metricsPrint(pOut, ",role=\"%s\"} %.9f\n", pRole, (double) pHist->sum / 1e9);
+}
+
+/**********************************************************************************************************************/
+/** Counter sample of a publisher or subscription
+ *
+ *  @param[in,out]  pOut            output buffer
+ *  @param[in]      pName           family name
+ *  @param[in]      pElement        publisher or subscription
+ *  @param[in]      value           sample value
+ */
+static void trdp_metricsCounter (
+    TRDP_METRICS_OUT_T  *pOut,
+    const CHAR8         *pName,
+    const PD_ELE_T      *pElement,
+    UINT32              value)
+{
+    trdp_metricsPrint(pOut, "%s_total", pName);
+    trdp_metricsLabels(pOut, pElement);
+    trdp_metricsPrint(pOut, "} %u\n", (unsigned int) value);
+}
+
+/**********************************************************************************************************************/
+/** Packets sent by a publisher or received by a subscription
+ *
+ *  @param[in,out]  pOut            output buffer
+ *  @param[in]      pFamily         family
+ *  @param[in]      pElement        publisher or subscription
+ */
+static void trdp_metricsRxTx (
+    TRDP_METRICS_OUT_T              *pOut,
+    const TRDP_METRICS_FAMILY_T     *pFamily,
+    const PD_ELE_T                  *pElement)
+{
+    trdp_metricsCounter(pOut, pFamily->pName, pElement, pElement->numRxTx);
+}
+
+/**********************************************************************************************************************/
+/** Data updates of a publisher
+ *
+ *  @param[in,out]  pOut            output buffer
+ *  @param[in]      pFamily         family
+ *  @param[in]      pElement        publisher or subscription
+ */
+static void trdp_metricsPut (
+    TRDP_METRICS_OUT_T              *pOut,
+    const TRDP_METRICS_FAMILY_T     *pFamily,
+    const PD_ELE_T                  *pElement)
+{
+    trdp_metricsCounter(pOut, pFamily->pName, pElement, pElement->updPkts);
+}
+
+/**********************************************************************************************************************/
+/** Packets missed by a subscription
+ *
+ *  @param[in,out]  pOut            output buffer
+ *  @param[in]      pFamily         family
+ *  @param[in]      pElement        publisher or subscription
+ */
+static void trdp_metricsMissed (
+    TRDP_METRICS_OUT_T              *pOut,
+    const TRDP_METRICS_FAMILY_T     *pFamily,
+    const PD_ELE_T                  *pElement)
+{
+    trdp_metricsCounter(pOut, pFamily->pName, pElement, pElement->numMissed);
+}
+
+/**********************************************************************************************************************/
+/** Cycle time of a publisher
+ *
+ *  @param[in,out]  pOut            output buffer
+ *  @param[in]      pFamily         family
+ *  @param[in]      pElement        publisher or subscription
+ */
+static void trdp_metricsInterval (
+    TRDP_METRICS_OUT_T              *pOut,
+    const TRDP_METRICS_FAMILY_T     *pFamily,
+    const PD_ELE_T                  *pElement)
+{
+    trdp_metricsPrint(pOut, "%s", pFamily->pName);
+    trdp_metricsLabels(pOut, pElement);
+    trdp_metricsPrint(pOut, "} %.6f\n", (double) pElement->interval / 1e9);
+}
+
+/**********************************************************************************************************************/
+/** Timeout state of a subscription
+ *
+ *  @param[in,out]  pOut            output buffer
+ *  @param[in]      pFamily         family
+ *  @param[in]      pElement        publisher or subscription
+ */
+static void trdp_metricsTimedOut (
+    TRDP_METRICS_OUT_T              *pOut,
+    const TRDP_METRICS_FAMILY_T     *pFamily,
+    const PD_ELE_T                  *pElement)
+{
+    trdp_metricsPrint(pOut, "%s", pFamily->pName);
+    trdp_metricsLabels(pOut, pElement);
+    trdp_metricsPrint(pOut, "} %d\n", (pElement->lastErr == TRDP_TIMEOUT_ERR) ? 1 : 0);
+}
+
+/**********************************************************************************************************************/
+/** Latency histogram (time in the stack) of a publisher or subscription
+ *
+ *  @param[in,out]  pOut            output buffer
+ *  @param[in]      pFamily         family
+ *  @param[in]      pElement        publisher or subscription
+ */
+static void trdp_metricsLatency (
+    TRDP_METRICS_OUT_T              *pOut,
+    const TRDP_METRICS_FAMILY_T     *pFamily,
+    const PD_ELE_T                  *pElement)
+{
+    if (pElement->pLatency != NULL)
+    {
+        trdp_metricsHistogram(pOut, pFamily->pName, pElement, (pFamily->subs == TRUE) ? "subscription" : "publisher",
+                              &pElement->pLatency->stack);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Callback histogram of a publisher or subscription
+ *
+ *  @param[in,out]  pOut            output buffer
+ *  @param[in]      pFamily         family
+ *  @param[in]      pElement        publisher or subscription
+ */
+static void trdp_metricsCallback (
+    TRDP_METRICS_OUT_T              *pOut,
+    const TRDP_METRICS_FAMILY_T     *pFamily,
+    const PD_ELE_T                  *pElement)
+{
+    if (pElement->pLatency != NULL)
+    {
+        trdp_metricsHistogram(pOut, pFamily->pName, pElement, (pFamily->subs == TRUE) ? "subscription" : "publisher",
+                              &pElement->pLatency->callback);
+    }
+}
+
+/** Families with a sample per publisher or subscription, in the order rendered.
+    Latency histograms (TRDP_OPTION_LATENCY_STATS): first time in the stack, then callbacks */
+static const TRDP_METRICS_FAMILY_T cMetricsFamilies[] =
+{
+    {"trdp_pd_publisher_sent", "counter", "Packets sent by a publisher", FALSE, trdp_metricsRxTx},
+    {"trdp_pd_publisher_put", "counter", "Data updates of a publisher", FALSE, trdp_metricsPut},
+    {"trdp_pd_publisher_interval_seconds", "gauge", "Cycle time of a publisher", FALSE, trdp_metricsInterval},
+    {"trdp_pd_subscription_received", "counter", "Packets received by a subscription", TRUE, trdp_metricsRxTx},
+    {"trdp_pd_subscription_missed", "counter", "Packets missed by a subscription", TRUE, trdp_metricsMissed},
+    {"trdp_pd_subscription_timed_out", "gauge", "1 if a subscription is timed out", TRUE, trdp_metricsTimedOut},
+    {"trdp_pd_latency_seconds", "histogram",
+     "Publisher: put until sent, subscription: socket ready until callback", FALSE, trdp_metricsLatency},
+    {"trdp_pd_latency_seconds", "histogram", NULL, TRUE, trdp_metricsLatency},
+    {"trdp_pd_callback_seconds", "histogram", "Execution time of the callback", FALSE, trdp_metricsCallback},
+    {"trdp_pd_callback_seconds", "histogram", NULL, TRUE, trdp_metricsCallback}
+};
+
+#define TRDP_METRICS_FAMILIES   ((UINT32) (sizeof(cMetricsFamilies) / sizeof(cMetricsFamilies[0])))
+#define TRDP_METRICS_DONE       (TRDP_METRICS_FAMILIES + 2u)    /**< counters, element families, EOF rendered  */
+
+/**********************************************************************************************************************/
+/** Render the session counters. Must be called with the session locked.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in,out]  pOut            output buffer
+ */
+static void trdp_metricsCounters (
+    TRDP_SESSION_PT     appHandle,
+    TRDP_METRICS_OUT_T  *pOut)
+{
+    const TRDP_STATISTICS_T *pStats = &appHandle->stats;
+    CHAR8                   host[TRDP_MAX_LABEL_LEN + 1u];
+    CHAR8                   ip[16];
+    UINT32                  idx;
+
+    trdp_UpdateStats(appHandle);
+
+    /*  The host name is no terminated string and is used as label value   */
+    memcpy(host, pStats->hostName, TRDP_MAX_LABEL_LEN);
+    host[TRDP_MAX_LABEL_LEN] = 0;
+    for (idx = 0u; host[idx] != 0; idx++)
+    {
+        if ((host[idx] == '"') || (host[idx] == '\\') || (host[idx] == '\n'))
+        {
+            host[idx] = '_';
+        }
+    }
+    trdp_metricsIp(ip, pStats->ownIpAddr);
+
+    trdp_metricsFamily(pOut, "trdp_session", "info", "TRDP session");
+    trdp_metricsPrint(pOut, "trdp_session_info{version=\"%s\",host=\"%s\",ip=\"%s\"} 1\n",
+                      tlc_getVersionString(), host, ip);
+    trdp_metricsValue(pOut, "trdp_uptime_seconds", "gauge", "Time since the session was opened",
+                      pStats->upTime);
+
+    /*  Memory  */
+    trdp_metricsValue(pOut, "trdp_mem_total_bytes", "gauge", "Size of the memory area", pStats->mem.total);
+    trdp_metricsValue(pOut, "trdp_mem_free_bytes", "gauge", "Free memory", pStats->mem.free);
+    trdp_metricsValue(pOut, "trdp_mem_min_free_bytes", "gauge", "Minimal free memory", pStats->mem.minFree);
+    trdp_metricsValue(pOut, "trdp_mem_allocated_blocks", "gauge", "Allocated memory blocks",
+                      pStats->mem.numAllocBlocks);
+    trdp_metricsValue(pOut, "trdp_mem_alloc_errors", "counter", "Memory allocation errors", pStats->mem.numAllocErr);
+    trdp_metricsValue(pOut, "trdp_mem_free_errors", "counter", "Memory free errors", pStats->mem.numFreeErr);
+    trdp_metricsFamily(pOut, "trdp_mem_pool_blocks", "gauge", "Preallocated blocks per block size");
+    for (idx = 0u; idx < VOS_MEM_NBLOCKSIZES; idx++)
+    {
+        trdp_metricsPrint(pOut, "trdp_mem_pool_blocks{size=\"%u\"} %u\n",
+                          (unsigned int) cMemBlockSizes[idx], (unsigned int) pStats->mem.blockSize[idx]);
+    }
+    trdp_metricsFamily(pOut, "trdp_mem_pool_used_blocks", "gauge", "Used blocks per block size");
+    for (idx = 0u; idx < VOS_MEM_NBLOCKSIZES; idx++)
+    {
+        trdp_metricsPrint(pOut, "trdp_mem_pool_used_blocks{size=\"%u\"} %u\n",
+                          (unsigned int) cMemBlockSizes[idx], (unsigned int) pStats->mem.usedBlockSize[idx]);
+    }
+
+    /*  Process data    */
+    trdp_metricsValue(pOut, "trdp_pd_subscriptions", "gauge", "Subscribed ComIds", pStats->pd.numSubs);
+    trdp_metricsValue(pOut, "trdp_pd_publishers", "gauge", "Published ComIds", pStats->pd.numPub);
+    trdp_metricsValue(pOut, "trdp_pd_received", "counter", "Received PD packets", pStats->pd.numRcv);
+    trdp_metricsValue(pOut, "trdp_pd_crc_errors", "counter", "Received PD packets with CRC error",
+                      pStats->pd.numCrcErr);
+    trdp_metricsValue(pOut, "trdp_pd_protocol_errors", "counter", "Received PD packets with protocol error",
+                      pStats->pd.numProtErr);
+    trdp_metricsValue(pOut, "trdp_pd_topo_errors", "counter", "Received PD packets with wrong topo count",
+                      pStats->pd.numTopoErr);
+    trdp_metricsValue(pOut, "trdp_pd_no_subscriber", "counter", "Received PD packets without subscription",
+                      pStats->pd.numNoSubs);
+    trdp_metricsValue(pOut, "trdp_pd_no_publisher", "counter", "Received PD pull requests without publisher",
+                      pStats->pd.numNoPub);
+    trdp_metricsValue(pOut, "trdp_pd_timeouts", "counter", "PD timeouts", pStats->pd.numTimeout);
+    trdp_metricsValue(pOut, "trdp_pd_sent", "counter", "Sent PD packets", pStats->pd.numSend);
+    trdp_metricsValue(pOut, "trdp_pd_missed", "counter", "Skipped PD packets (sequence counter)",
+                      pStats->pd.numMissed);
+    trdp_metricsValue(pOut, "trdp_pd_admission_rejected", "counter", "Publishers rejected by admission control",
+                      appHandle->admission.numRejected);
+
+    /*  Message data    */
+    trdp_metricsMd(pOut, "trdp_md_listeners", "gauge", "MD listeners",
+                   pStats->udpMd.numList, pStats->tcpMd.numList);
+    trdp_metricsMd(pOut, "trdp_md_received", "counter", "Received MD packets",
+                   pStats->udpMd.numRcv, pStats->tcpMd.numRcv);
+    trdp_metricsMd(pOut, "trdp_md_crc_errors", "counter", "Received MD packets with CRC error",
+                   pStats->udpMd.numCrcErr, pStats->tcpMd.numCrcErr);
+    trdp_metricsMd(pOut, "trdp_md_protocol_errors", "counter", "Received MD packets with protocol error",
+                   pStats->udpMd.numProtErr, pStats->tcpMd.numProtErr);
+    trdp_metricsMd(pOut, "trdp_md_topo_errors", "counter", "Received MD packets with wrong topo count",
+                   pStats->udpMd.numTopoErr, pStats->tcpMd.numTopoErr);
+    trdp_metricsMd(pOut, "trdp_md_no_listener", "counter", "Received MD packets without listener",
+                   pStats->udpMd.numNoListener, pStats->tcpMd.numNoListener);
+    trdp_metricsMd(pOut, "trdp_md_reply_timeouts", "counter", "MD reply timeouts",
+                   pStats->udpMd.numReplyTimeout, pStats->tcpMd.numReplyTimeout);
+    trdp_metricsMd(pOut, "trdp_md_confirm_timeouts", "counter", "MD confirm timeouts",
+                   pStats->udpMd.numConfirmTimeout, pStats->tcpMd.numConfirmTimeout);
+    trdp_metricsMd(pOut, "trdp_md_sent", "counter", "Sent MD packets",
+                   pStats->udpMd.numSend, pStats->tcpMd.numSend);
+    trdp_metricsValue(pOut, "trdp_md_rate_deferred", "counter", "MD sends deferred by the rate limit",
+                      appHandle->admission.numMdDeferred);
+}
+
+/**********************************************************************************************************************/
+/** Render the next slice of the metrics. Must be called with the session locked.
+ *  The session counters come first, then the element families and '# EOF'. At most maxElements publishers and
+ *  subscriptions are rendered per call, the next call continues behind the last element rendered.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in,out]  pOut            output buffer
+ *  @param[in,out]  pFamily         next family to render, 0 to start
+ *  @param[in,out]  pElement        next element of that family, 0 to start
+ *  @param[in]      maxElements     max. number of elements to render
+ *
+ *  @retval         TRUE            all metrics rendered
+ *  @retval         FALSE           more slices to render
+ */
+static BOOL8 trdp_metricsRender (
+    TRDP_SESSION_PT     appHandle,
+    TRDP_METRICS_OUT_T  *pOut,
+    UINT32              *pFamily,
+    UINT32              *pElement,
+    UINT32              maxElements)
+{
+    const TRDP_METRICS_FAMILY_T *pFam;
+    const PD_ELE_T              *iter;
+    UINT32                      idx;
+
+    while ((*pFamily < TRDP_METRICS_DONE) && (maxElements > 0u))
+    {
+        if (*pFamily == 0u)
+        {
+            trdp_metricsCounters(appHandle, pOut);
+        }
+        else if (*pFamily > TRDP_METRICS_FAMILIES)
+        {
+            trdp_metricsPrint(pOut, "# EOF\n");
+        }
+        else
+        {
+            pFam = &cMetricsFamilies[*pFamily - 1u];
+            if ((*pElement == 0u) && (pFam->pHelp != NULL))
+            {
+                trdp_metricsFamily(pOut, pFam->pName, pFam->pType, pFam->pHelp);
+            }
+
+            /*  The queue may have changed since the last slice, continue at the same position  */
+            iter = (pFam->subs == TRUE) ? appHandle->pRcvQueue : appHandle->pSndQueue;
+            for (idx = 0u; (idx < *pElement) && (iter != NULL); idx++)
+            {
+                iter = iter->pNext;
+            }
+            for (; (iter != NULL) && (maxElements > 0u); iter = iter->pNext)
+            {
+                pFam->pSample(pOut, pFam, iter);
+                (*pElement)++;
+                maxElements--;
+            }
+            if (iter != NULL)
+            {
+                break;
+            }
+            *pElement = 0u;
+        }
+        (*pFamily)++;
+    }
+    return (*pFamily >= TRDP_METRICS_DONE) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Close the client connection of the endpoint and discard its response
+ *
+ *  @param[in]      appHandle       session pointer
+ */
+static void trdp_metricsDropClient (
+    TRDP_SESSION_PT appHandle)
+{
+    TRDP_METRICS_T *pMetrics = &appHandle->metrics;
+
+    if (pMetrics->clientSock != VOS_INVALID_SOCKET)
+    {
+        (void) vos_sockClose(pMetrics->clientSock);
+        pMetrics->clientSock = VOS_INVALID_SOCKET;
+    }
+    if (pMetrics->pResponse != NULL)
+    {
+        vos_memFree(pMetrics->pResponse);
+        pMetrics->pResponse = NULL;
+    }
+    pMetrics->nextTry   = 0;
+    pMetrics->reqLen    = 0u;
+    memset(pMetrics->reqTail, 0, sizeof(pMetrics->reqTail));
+}
+
+/**********************************************************************************************************************/
+/** Enlarge the response buffer, the text rendered so far is kept
+ *
+ *  @param[in]      pMetrics        endpoint state
+ *  @param[in]      needed          min. size of the buffer
+ *
+ *  @retval         TRUE            buffer enlarged
+ *  @retval         FALSE           out of memory
+ */
+static BOOL8 trdp_metricsGrow (
+    TRDP_METRICS_T  *pMetrics,
+    UINT32          needed)
+{
+    UINT32  size = pMetrics->respSize;
+    CHAR8   *pNew;
+
+    while (size < needed)
+    {
+        size *= 2u;
+    }
+    pNew = (CHAR8 *) vos_memAlloc(size);
+    if (pNew == NULL)
+    {
+        return FALSE;
+    }
+    memcpy(pNew, pMetrics->pResponse, pMetrics->respLen);
+    vos_memFree(pMetrics->pResponse);
+    pMetrics->pResponse = pNew;
+    pMetrics->respSize  = size;
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Start the response to the complete request of the client.
+ *  The body is rendered behind TRDP_METRICS_HDR_SIZE bytes reserved for the HTTP header.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      now             current time (of this processing pass)
+ */
+static void trdp_metricsServe (
+    TRDP_SESSION_PT appHandle,
+    VOS_TIME_NS_T   now)
+{
+    TRDP_METRICS_T  *pMetrics   = &appHandle->metrics;
+    const CHAR8     *pPath      = pMetrics->request + 4;
+    BOOL8           found;
+
+    pMetrics->request[TRDP_METRICS_REQ_SIZE - 1u] = 0;
+    found = (strncmp(pMetrics->request, "GET ", 4u) == 0) &&
+            ((strncmp(pPath, "/metrics", 8u) == 0 && (pPath[8] == ' ' || pPath[8] == '?')) ||
+             (strncmp(pPath, "/ ", 2u) == 0));
+
+    pMetrics->status    = (found == TRUE) ? 200u : 404u;
+    pMetrics->respSize  = (found == TRUE) ? TRDP_METRICS_BUF_SIZE : TRDP_METRICS_HDR_SIZE;
+    pMetrics->pResponse = (CHAR8 *) vos_memAlloc(pMetrics->respSize);
+    if ((pMetrics->pResponse == NULL) && (found == TRUE))
+    {
+        pMetrics->status    = 503u;
+        pMetrics->respSize  = TRDP_METRICS_HDR_SIZE;
+        pMetrics->pResponse = (CHAR8 *) vos_memAlloc(pMetrics->respSize);
+    }
+    if (pMetrics->pResponse == NULL)
+    {
+        vos_printLogStr(VOS_LOG_WARNING, "Metrics response could not be allocated\n");
+        trdp_metricsDropClient(appHandle);
+        return;
+    }
+    pMetrics->respLen       = TRDP_METRICS_HDR_SIZE;
+    pMetrics->family        = (pMetrics->status == 200u) ? 0u : TRDP_METRICS_DONE;
+    pMetrics->element       = 0u;
+    pMetrics->clientTimeout = now + (VOS_TIME_NS_T) TRDP_METRICS_REQ_TIMEOUT * 1000;
+}
+
+/**********************************************************************************************************************/
+/** Render the next slice of the response or send as much of it as the client takes.
+ *  The connection is closed when the response is sent completely.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      now             current time (of this processing pass)
+ */
+static void trdp_metricsProgress (
+    TRDP_SESSION_PT appHandle,
+    VOS_TIME_NS_T   now)
+{
+    TRDP_METRICS_T      *pMetrics = &appHandle->metrics;
+    TRDP_METRICS_OUT_T  out;
+    CHAR8               header[TRDP_METRICS_HDR_SIZE];
+    UINT32              family;
+    UINT32              element;
+    UINT32              size;
+    BOOL8               done;
+    VOS_ERR_T           err;
+
+    if (pMetrics->family < TRDP_METRICS_DONE)
+    {
+        /*  Render one slice per pass, the session is not kept locked for the whole text  */
+        for (;; )
+        {
+            family      = pMetrics->family;
+            element     = pMetrics->element;
+            out.pBuf    = pMetrics->pResponse + TRDP_METRICS_HDR_SIZE;
+            out.size    = pMetrics->respSize - TRDP_METRICS_HDR_SIZE;
+            out.len     = pMetrics->respLen - TRDP_METRICS_HDR_SIZE;
+            done        = trdp_metricsRender(appHandle, &out, &family, &element, TRDP_METRICS_SLICE);
+            if (out.len < out.size)
+            {
+                pMetrics->family    = family;
+                pMetrics->element   = element;
+                pMetrics->respLen   = TRDP_METRICS_HDR_SIZE + out.len;
+                break;
+            }
+            /*  Did not fit, render the slice again into a larger buffer  */
+            if (trdp_metricsGrow(pMetrics, TRDP_METRICS_HDR_SIZE + out.len + 1u) == FALSE)
+            {
+                pMetrics->status    = 503u;
+                pMetrics->family    = TRDP_METRICS_DONE;
+                pMetrics->respLen   = TRDP_METRICS_HDR_SIZE;
+                done = TRUE;
+                break;
+            }
+        }
+        if (done == FALSE)
+        {
+            pMetrics->nextTry = now;
+            return;
+        }
+
+        /*  Put the header right in front of the body   */
+        if (pMetrics->status == 200u)
+        {
+            (void) vos_snprintf(header, sizeof(header),
+                                "HTTP/1.0 200 OK\r\nContent-Type: " TRDP_METRICS_CONTENT_TYPE
+                                "\r\nContent-Length: %u\r\nConnection: close\r\n\r\n",
+                                (unsigned int) (pMetrics->respLen - TRDP_METRICS_HDR_SIZE));
+        }
+        else
+        {
+            (void) vos_snprintf(header, sizeof(header),
+                                "HTTP/1.0 %s\r\nContent-Length: 0\r\nConnection: close\r\n\r\n",
+                                (pMetrics->status == 404u) ? "404 Not Found" : "503 Service Unavailable");
+        }
+        size = (UINT32) strlen(header);
+        pMetrics->respStart = TRDP_METRICS_HDR_SIZE - size;
+        memcpy(pMetrics->pResponse + pMetrics->respStart, header, size);
+        pMetrics->sent = pMetrics->respStart;
+    }
+
+    /*  Send what the client takes, the rest follows in later passes  */
+    size    = pMetrics->respLen - pMetrics->sent;
+    err     = vos_sockSendTCP(pMetrics->clientSock, (UINT8 *) pMetrics->pResponse + pMetrics->sent, &size);
+    pMetrics->sent += size;
+    if (size > 0u)
+    {
+        pMetrics->clientTimeout = now + (VOS_TIME_NS_T) TRDP_METRICS_REQ_TIMEOUT * 1000;
+    }
+    if (err == VOS_BLOCK_ERR)
+    {
+        pMetrics->nextTry = now + (VOS_TIME_NS_T) TRDP_METRICS_SEND_POLL * 1000;
+        return;
+    }
+    if ((err != VOS_NO_ERR) || (pMetrics->sent < pMetrics->respLen))
+    {
+        vos_printLogStr(VOS_LOG_WARNING, "Metrics response could not be sent completely\n");
+    }
+    else
+    {
+        pMetrics->numScrapes++;
+    }
+    trdp_metricsDropClient(appHandle);
+}
+
+/******************************************************************************
+ *   Globals
+ */
+
+/**********************************************************************************************************************/
+/** Initialize the endpoint state of a new session
+ *
+ *  @param[in]      appHandle       session pointer
+ */
+void trdp_metricsInit (
+    TRDP_SESSION_PT appHandle)
+{
+    appHandle->metrics.listenSock   = VOS_INVALID_SOCKET;
+    appHandle->metrics.clientSock   = VOS_INVALID_SOCKET;
+}
+
+/**********************************************************************************************************************/
+/** Close the endpoint
+ *
+ *  @param[in]      appHandle       session pointer
+ */
+void trdp_metricsClose (
+    TRDP_SESSION_PT appHandle)
+{
+    trdp_metricsDropClient(appHandle);
+    if (appHandle->metrics.listenSock != VOS_INVALID_SOCKET)
+    {
+        (void) vos_sockClose(appHandle->metrics.listenSock);
+        appHandle->metrics.listenSock = VOS_INVALID_SOCKET;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Add the endpoint sockets to the descriptor set, limit the interval while a request is outstanding
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in,out]  pFileDesc       pointer to set of ready descriptors
+ *  @param[in,out]  pNoDesc         pointer to number of ready descriptors
+ */
+void trdp_metricsCheckPending (
+    TRDP_SESSION_PT appHandle,
+    TRDP_FDS_T      *pFileDesc,
+    INT32           *pNoDesc)
+{
+    TRDP_METRICS_T  *pMetrics = &appHandle->metrics;
+    SOCKET          sock;
+
+    if (pMetrics->pResponse != NULL)
+    {
+        /*  Rendering or sending: the next pass is due at once or when the client may take more  */
+        if ((appHandle->nextJob == 0) || (pMetrics->nextTry < appHandle->nextJob))
+        {
+            appHandle->nextJob = pMetrics->nextTry;
+        }
+        return;
+    }
+
+    /*  Accept the next connection only when the current one is done   */
+    sock = (pMetrics->clientSock != VOS_INVALID_SOCKET) ? pMetrics->clientSock : pMetrics->listenSock;
+    if (sock == VOS_INVALID_SOCKET)
+    {
+        return;
+    }
+    FD_SET(sock, (fd_set *)pFileDesc);   /*lint !e573 !e505 signed/unsigned division in macro / Redundant left
+                                               argument to comma */
+    if (sock > *pNoDesc)
+    {
+        *pNoDesc = (INT32) sock;
+    }
+    if ((pMetrics->clientSock != VOS_INVALID_SOCKET) &&
+        ((appHandle->nextJob == 0) || (pMetrics->clientTimeout < appHandle->nextJob)))
+    {
+        appHandle->nextJob = pMetrics->clientTimeout;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Accept connections and read requests of the endpoint
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pRfds           pointer to set of ready descriptors
+ *  @param[in,out]  pCount          pointer to number of ready descriptors
+ *  @param[in]      now             current time (of this processing pass)
+ */
+void trdp_metricsCheckListenSocks (
+    TRDP_SESSION_PT appHandle,
+    TRDP_FDS_T      *pRfds,
+    INT32           *pCount,
+    VOS_TIME_NS_T   now)
+{
+    TRDP_METRICS_T *pMetrics = &appHandle->metrics;
+
+    if (pMetrics->listenSock == VOS_INVALID_SOCKET)
+    {
+        return;
+    }
+
+    /*  Drop a client which did not complete its request or stopped taking the response   */
+    if ((pMetrics->clientSock != VOS_INVALID_SOCKET) && (now >= pMetrics->clientTimeout))
+    {
+        vos_printLogStr(VOS_LOG_INFO, "Metrics request timed out\n");
+        trdp_metricsDropClient(appHandle);
+    }
+
+    /*  A response is continued in every pass, the client is not read meanwhile  */
+    if (pMetrics->pResponse != NULL)
+    {
+        trdp_metricsProgress(appHandle, now);
+        return;
+    }
+
+    if ((pRfds == NULL) || (pCount == NULL) || (*pCount <= 0))
+    {
+        return;
+    }
+
+    if (pMetrics->clientSock == VOS_INVALID_SOCKET)
+    {
+        if (FD_ISSET(pMetrics->listenSock, (fd_set *) pRfds))    /*lint !e573 !e505
+                                                                     signed/unsigned division in macro */
+        {
+            VOS_SOCK_OPT_T  opts;
+            SOCKET          sock    = VOS_INVALID_SOCKET;
+            UINT32          ipAddr  = 0u;
+            UINT16          port    = 0u;
+
+            (*pCount)--;
+            FD_CLR(pMetrics->listenSock, (fd_set *) pRfds);    /*lint !e502 !e573 !e505
+                                                                  signed/unsigned division in macro */
+            if ((vos_sockAccept(pMetrics->listenSock, &sock, &ipAddr, &port) != VOS_NO_ERR) ||
+                (sock == VOS_INVALID_SOCKET))
+            {
+                return;
+            }
+            /*  The request is read without blocking the processing   */
+            memset(&opts, 0, sizeof(opts));
+            opts.nonBlocking = TRUE;
+            if (vos_sockSetOptions(sock, &opts) != VOS_NO_ERR)
+            {
+                (void) vos_sockClose(sock);
+                return;
+            }
+            pMetrics->clientSock    = sock;
+            pMetrics->clientTimeout = now + (VOS_TIME_NS_T) TRDP_METRICS_REQ_TIMEOUT * 1000;
+            pMetrics->reqLen        = 0u;
+            memset(pMetrics->reqTail, 0, sizeof(pMetrics->reqTail));
+        }
+    }
+    else if (FD_ISSET(pMetrics->clientSock, (fd_set *) pRfds))    /*lint !e573 !e505
+                                                                      signed/unsigned division in macro */
+    {
+        UINT8       buffer[256];
+        UINT32      size    = sizeof(buffer);
+        UINT32      idx;
+        VOS_ERR_T   err;
+
+        (*pCount)--;
+        FD_CLR(pMetrics->clientSock, (fd_set *) pRfds);    /*lint !e502 !e573 !e505
+                                                              signed/unsigned division in macro */
+        err = vos_sockReceiveTCP(pMetrics->clientSock, buffer, &size);
+        if ((err != VOS_NO_ERR) || (size == 0u))
+        {
+            /*  Closed by the peer or error */
+            trdp_metricsDropClient(appHandle);
+            return;
+        }
+        /*  Keep the request line, look for the empty line ending the request header    */
+        for (idx = 0u; idx < size; idx++)
+        {
+            if (pMetrics->reqLen < TRDP_METRICS_REQ_SIZE - 1u)
+            {
+                pMetrics->request[pMetrics->reqLen++] = (CHAR8) buffer[idx];
+                pMetrics->request[pMetrics->reqLen] = 0;
+            }
+            memmove(pMetrics->reqTail, pMetrics->reqTail + 1, 3u);
+            pMetrics->reqTail[3] = (CHAR8) buffer[idx];
+            if (memcmp(pMetrics->reqTail, "\r\n\r\n", 4u) == 0)
+            {
+                trdp_metricsServe(appHandle, now);
+                if (pMetrics->pResponse != NULL)
+                {
+                    trdp_metricsProgress(appHandle, now);
+                }
+                return;
+            }
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Render the session statistics in OpenMetrics text format.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pBuf                buffer for the text (zero terminated)
+ *  @param[in,out]  pSize               In: size of the buffer, Out: length of the text;
+ *                                      if the buffer is too small: needed buffer size
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        buffer too small, text is truncated
+ */
+EXT_DECL TRDP_ERR_T tlc_getMetrics (
+    TRDP_APP_SESSION_T  appHandle,
+    CHAR8               *pBuf,
+    UINT32              *pSize)
+{
+    TRDP_METRICS_OUT_T  out;
+    UINT32              family  = 0u;
+    UINT32              element = 0u;
+    TRDP_ERR_T          err     = TRDP_NO_ERR;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if ((pBuf == NULL) || (pSize == NULL) || (*pSize == 0u))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    out.pBuf    = pBuf;
+    out.size    = *pSize;
+    out.len     = 0u;
+    (void) trdp_metricsRender(appHandle, &out, &family, &element, 0xFFFFFFFFu);
+
+    if (out.len >= out.size)
+    {
+        *pSize  = out.len + 1u;
+        err     = TRDP_MEM_ERR;
+    }
+    else
+    {
+        *pSize = out.len;
+    }
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Open or close the HTTP endpoint for the metrics.
+ *  The endpoint answers 'GET /metrics' and is served from tlc_process().
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      bindAddr            address to listen on, 0 = any
+ *  @param[in]      port                TCP port, 0 closes the endpoint
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_SOCK_ERR       socket could not be opened, bound or set to listen
+ */
+EXT_DECL TRDP_ERR_T tlc_setMetricsPort (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_IP_ADDR_T      bindAddr,
+    UINT16              port)
+{
+    TRDP_ERR_T      err = TRDP_NO_ERR;
+    VOS_SOCK_OPT_T  opts;
+    SOCKET          sock = VOS_INVALID_SOCKET;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    trdp_metricsClose(appHandle);
+
+    if (port != 0u)
+    {
+        memset(&opts, 0, sizeof(opts));
+        opts.reuseAddrPort  = TRUE;
+        opts.nonBlocking    = TRUE;
+
+        if ((vos_sockOpenTCP(&sock, &opts) != VOS_NO_ERR) ||
+            (vos_sockBind(sock, bindAddr, port) != VOS_NO_ERR) ||
+            (vos_sockListen(sock, 4u) != VOS_NO_ERR))
+        {
+            vos_printLog(VOS_LOG_ERROR, "Metrics endpoint on port %u could not be opened\n", (unsigned int) port);
+            if (sock != VOS_INVALID_SOCKET)
+            {
+                (void) vos_sockClose(sock);
+            }
+            err = TRDP_SOCK_ERR;
+        }
+        else
+        {
+            appHandle->metrics.listenSock = sock;
+            vos_printLog(VOS_LOG_INFO, "Metrics endpoint listening on port %u\n", (unsigned int) port);
+        }
+    }
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    return err;
+}
@@ -0,0 +1,43 @@
+/******************************************************************************/
+/**
+ * @file            trdp_metrics.h
+ *
+ * @brief           OpenMetrics exporter for TRDP statistics
+ *
+ * @details         Renders the session statistics in OpenMetrics text format and serves them
+ *                  from a minimal HTTP endpoint polled by tlc_process()
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+
+#ifndef TRDP_METRICS_H
+#define TRDP_METRICS_H
+
+/*******************************************************************************
+ * INCLUDES
+ */
+
+#include "trdp_if_light.h"
+#include "trdp_private.h"
+
+/*******************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+void    trdp_metricsInit (TRDP_SESSION_PT appHandle);
+void    trdp_metricsClose (TRDP_SESSION_PT appHandle);
+void    trdp_metricsCheckPending (TRDP_SESSION_PT appHandle, TRDP_FDS_T *pFileDesc, INT32 *pNoDesc);
+void    trdp_metricsCheckListenSocks (TRDP_SESSION_PT appHandle, TRDP_FDS_T *pRfds, INT32 *pCount,
+                                      VOS_TIME_NS_T now);
+
+#endif
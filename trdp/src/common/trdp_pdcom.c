@@ -16,6 +16,27 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: trdp_pdShapingLcm() exported for the offline analysis
+ *      BL 2026-10-17: trdp_pdPhaseOf(): raster position of unphased publishers, shaping moves only unphased ones
+ *      BL 2026-10-17: trdp_pdAdmit() takes the committed rates of a publisher batch (trdp_pdRatesInit/Add)
+ *      BL 2026-10-17: Statistics pull: lists answered on TRDP_SUBS_LIST_COMID, TRDP_PUB_LIST_COMID
+ *      BL 2026-10-17: A late packet counted as missed is deducted from the subscription and session counters
+ *      BL 2026-10-17: Callbacks timed and accounted only if TRDP_CB_TIMED (TRDP_OPTION_CALLBACK_STATS)
+ *      BL 2026-10-17: Committed bit rate accumulated per send socket, admission keyed on the socket bind address like shaping
+ *      BL 2026-10-17: trdp_pdShapingAddBatch(): hyperperiod and slot table rebuilt once per batch
+ *      BL 2026-10-17: Statistics pull answers the subscription and publisher lists if requested as reply ComId
+ *      BL 2026-10-17: Missed packets counted per source (no longer across senders and wrap-around)
+ *      BL 2026-10-17: Execution time of every callback accounted to its publisher or subscription (trdp_cbAccount)
+ *      BL 2026-10-17: trdp_pdCheckPending: requested (also pull-only) packets deferred by the send budget set nextJob
+ *      BL 2026-10-17: Callback execution times checked against the callback budget (TRDP_PROC_CALLBACK)
+ *      BL 2026-10-17: Session counters numMissed and numPub maintained incrementally
+ *      BL 2026-10-17: Event trace: PD rx, tx and timeouts
+ *      BL 2026-10-17: Latency histograms (put -> sent, socket ready -> callback, callback duration)
+ *      BL 2026-10-17: Admission control: committed PD bit rate per interface
+ *      BL 2026-10-17: Send pass ordered by QoS class and deadline, optional byte budget per window
+ *      BL 2026-10-17: Clock read once per pass, scheduler times in ns
+ *      BL 2026-10-17: Phased publishers: trdp_pdAlignToEpoch(), send times stay on epoch + k * interval + phase
+ *      BL 2026-10-17: trdp_pdDistribute() replaced by incremental slot based traffic shaping
  *      BL 2018-10-29: Ticket #217 PD Pull requests must be subscribed for
  *      BL 2018-08-07: Ticket #207 tlp_put() and variable dataSize
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
@@ -65,6 +86,7 @@
 #include "trdp_pdcom.h"
 #include "trdp_if.h"
 #include "trdp_stats.h"
+#include "trdp_trace.h"
 #include "vos_sock.h"
 #include "vos_mem.h"
 
@@ -282,151 +304,345 @@ TRDP_ERR_T trdp_pdGet (
 }
 
 /******************************************************************************/
-/** Send all due PD messages
+/** Deadline of a due packet within its QoS class
+ *
+ *  @param[in]      pPacket             publisher element
+ *
+ *  @retval         send time, 0 for immediate (requested) packets
+ */
+static VOS_TIME_NS_T trdp_pdDeadline (
+    const PD_ELE_T *pPacket)
+{
+    return (pPacket->privFlags & TRDP_REQ_2B_SENT) ? 0 : pPacket->timeToGo;
+}
+
+/******************************************************************************/
+/** Insert a due packet into the list of its QoS class, ordered by deadline
+ *
+ *  @param[in,out]  pDue                first due packet per QoS class
+ *  @param[in,out]  pLast               last due packet per QoS class
+ *  @param[in]      pPacket             publisher element
+ */
+static void trdp_pdDueInsert (
+    PD_ELE_T    *pDue[],
+    PD_ELE_T    *pLast[],
+    PD_ELE_T    *pPacket)
+{
+    const VOS_TIME_NS_T deadline    = trdp_pdDeadline(pPacket);
+    PD_ELE_T            **ppIter    = &pDue[pPacket->qos];
+
+    pPacket->pNextDue = NULL;
+
+    /*  Usually the packets come in deadline order, append them  */
+    if ((pLast[pPacket->qos] == NULL) || (trdp_pdDeadline(pLast[pPacket->qos]) <= deadline))
+    {
+        if (pLast[pPacket->qos] == NULL)
+        {
+            pDue[pPacket->qos] = pPacket;
+        }
+        else
+        {
+            pLast[pPacket->qos]->pNextDue = pPacket;
+        }
+        pLast[pPacket->qos] = pPacket;
+        return;
+    }
+
+    while ((*ppIter != NULL) && (trdp_pdDeadline(*ppIter) <= deadline))
+    {
+        ppIter = &(*ppIter)->pNextDue;
+    }
+    pPacket->pNextDue   = *ppIter;
+    *ppIter             = pPacket;
+}
+
+/******************************************************************************/
+/** Start a new budget window if the current one is over
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      now                 current time
+ */
+static void trdp_pdBudgetUpdate (
+    TRDP_SESSION_PT appHandle,
+    VOS_TIME_NS_T   now)
+{
+    TRDP_SEND_BUDGET_T  *pBudget = &appHandle->sendBudget;
+    VOS_TIME_NS_T       window;
+    VOS_TIME_NS_T       windows;
+
+    if ((pBudget->bytes == 0u) || (now < pBudget->windowEnd))
+    {
+        return;
+    }
+
+    /*  Windows are aligned to the cycle epoch like the phased publishers  */
+    window  = (VOS_TIME_NS_T) pBudget->window * 1000;
+    windows = now - appHandle->cycleEpoch;
+    windows = (windows >= 0) ? (windows / window + 1) : -((-windows) / window);
+    pBudget->windowEnd  = appHandle->cycleEpoch + windows * window;
+    pBudget->used       = 0u;
+    pBudget->exhausted  = FALSE;
+}
+
+/******************************************************************************/
+/** Check the budget for a packet to be sent, account it if it fits
  *
  *  @param[in]      appHandle           session pointer
+ *  @param[in]      pPacket             publisher element
  *
- *  @retval         TRDP_NO_ERR         no error
- *  @retval         TRDP_IO_ERR         socket I/O error
+ *  @retval         TRUE                packet has to wait for the next window
+ *  @retval         FALSE               packet can be sent
  */
-TRDP_ERR_T  trdp_pdSendQueued (
-    TRDP_SESSION_PT appHandle)
+static BOOL8 trdp_pdBudgetDefer (
+    TRDP_SESSION_PT appHandle,
+    const PD_ELE_T  *pPacket)
 {
-    PD_ELE_T    *iterPD = appHandle->pSndQueue;
-    TRDP_TIME_T now;
-    TRDP_ERR_T  err = TRDP_NO_ERR;
+    TRDP_SEND_BUDGET_T *pBudget = &appHandle->sendBudget;
 
-    vos_clearTime(&appHandle->nextJob);
+    if ((pBudget->bytes == 0u) ||
+        (pPacket->privFlags & (TRDP_INVALID_DATA | TRDP_REDUNDANT)))        /*  will not be sent anyway  */
+    {
+        return FALSE;
+    }
 
-    /*    Find the packet which has to be sent next:    */
-    while (iterPD != NULL)
+    /*  The first packet of a window always fits, even if it is larger than the budget  */
+    if ((pPacket->qos < pBudget->minQos) &&
+        (pBudget->used != 0u) &&
+        (pBudget->used + pPacket->grossSize > pBudget->bytes))
     {
-        /*    Get the current time    */
-        vos_getTime(&now);
+        pBudget->exhausted = TRUE;
+        pBudget->numDeferred++;
+        return TRUE;
+    }
+    pBudget->used += pPacket->grossSize;
+    return FALSE;
+}
 
-        /*  Is this a cyclic packet and
-         due to sent?
-         or is it a PD Request or a requested packet (PULL) ?
-         */
-        if ((timerisset(&iterPD->interval) &&                   /*  Request for immediate sending   */
-             !timercmp(&iterPD->timeToGo, &now, >)) ||
-            (iterPD->privFlags & TRDP_REQ_2B_SENT))
+/******************************************************************************/
+/** Send one due PD message and compute its next send time
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pPacket             publisher element, freed if it was a one shot PD request
+ *  @param[in,out]  pNow                current time, refreshed after sending
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_IO_ERR         socket I/O error
+ *  @retval         TRDP_TOPO_ERR       topo counts out of date
+ */
+static TRDP_ERR_T trdp_pdSendElement (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pPacket,
+    VOS_TIME_NS_T   *pNow)
+{
+    TRDP_ERR_T err = TRDP_NO_ERR;
+
+    /* send only if there is valid data */
+    if (!(pPacket->privFlags & TRDP_INVALID_DATA))
+    {
+        if ((pPacket->privFlags & TRDP_REQ_2B_SENT) &&
+            (pPacket->pFrame->frameHead.msgType == vos_htons(TRDP_MSG_PD)))       /*  PULL packet?  */
+        {
+            pPacket->pFrame->frameHead.msgType = vos_htons(TRDP_MSG_PP);
+        }
+        /*  Update the sequence counter and re-compute CRC    */
+        trdp_pdUpdate(pPacket);
+
+        /* Publisher check from Table A.5:
+           Actual topography counter values <-> Locally stored with publish */
+        if ( !trdp_validTopoCounters( appHandle->etbTopoCnt,
+                                      appHandle->opTrnTopoCnt,
+                                      vos_ntohl(pPacket->pFrame->frameHead.etbTopoCnt),
+                                      vos_ntohl(pPacket->pFrame->frameHead.opTrnTopoCnt)))
+        {
+            err = TRDP_TOPO_ERR;
+            vos_printLogStr(VOS_LOG_INFO, "Sending PD: TopoCount is out of date!\n");
+        }
+        /*    In case we're sending on an uninitialized publisher; should never happen. */
+        else if (pPacket->socketIdx == TRDP_INVALID_SOCKET_INDEX)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "Sending PD: Socket invalid!\n");
+            /* Try to send the other packets */
+        }
+        /*    Send the packet if it is not redundant    */
+        else if (!(pPacket->privFlags & TRDP_REDUNDANT))
         {
-            /* send only if there is valid data */
-            if (!(iterPD->privFlags & TRDP_INVALID_DATA))
+            TRDP_ERR_T  result;
+            BOOL8       latency = ((appHandle->option & TRDP_OPTION_LATENCY_STATS) != 0);
+
+            if (pPacket->pfCbFunction != NULL)
             {
-                if ((iterPD->privFlags & TRDP_REQ_2B_SENT) &&
-                    (iterPD->pFrame->frameHead.msgType == vos_htons(TRDP_MSG_PD)))       /*  PULL packet?  */
-                {
-                    iterPD->pFrame->frameHead.msgType = vos_htons(TRDP_MSG_PP);
-                }
-                /*  Update the sequence counter and re-compute CRC    */
-                trdp_pdUpdate(iterPD);
-
-                /* Publisher check from Table A.5:
-                   Actual topography counter values <-> Locally stored with publish */
-                if ( !trdp_validTopoCounters( appHandle->etbTopoCnt,
-                                              appHandle->opTrnTopoCnt,
-                                              vos_ntohl(iterPD->pFrame->frameHead.etbTopoCnt),
-                                              vos_ntohl(iterPD->pFrame->frameHead.opTrnTopoCnt)))
+                TRDP_PD_INFO_T  theMessage;
+                VOS_TIME_NS_T   cbStart = 0;
+                BOOL8           timed   = TRDP_CB_TIMED(appHandle);
+
+                theMessage.comId        = pPacket->addr.comId;
+                theMessage.srcIpAddr    = pPacket->addr.srcIpAddr;
+                theMessage.destIpAddr   = pPacket->addr.destIpAddr;
+                theMessage.etbTopoCnt   = vos_ntohl(pPacket->pFrame->frameHead.etbTopoCnt);
+                theMessage.opTrnTopoCnt = vos_ntohl(pPacket->pFrame->frameHead.opTrnTopoCnt);
+                theMessage.msgType      = (TRDP_MSG_T) vos_ntohs(pPacket->pFrame->frameHead.msgType);
+                theMessage.seqCount     = pPacket->curSeqCnt;
+                theMessage.protVersion  = vos_ntohs(pPacket->pFrame->frameHead.protocolVersion);
+                theMessage.replyComId   = vos_ntohl(pPacket->pFrame->frameHead.replyComId);
+                theMessage.replyIpAddr  = vos_ntohl(pPacket->pFrame->frameHead.replyIpAddress);
+                theMessage.pUserRef     = pPacket->pUserRef; /* User reference given with the local subscribe? */
+                theMessage.resultCode   = err;
+
+                if (timed == TRUE)
                 {
-                    err = TRDP_TOPO_ERR;
-                    vos_printLogStr(VOS_LOG_INFO, "Sending PD: TopoCount is out of date!\n");
+                    cbStart = vos_getTimeNs();
                 }
-                /*    In case we're sending on an uninitialized publisher; should never happen. */
-                else if (iterPD->socketIdx == TRDP_INVALID_SOCKET_INDEX)
+                pPacket->pfCbFunction(appHandle->pdDefault.pRefCon,
+                                               appHandle,
+                                               &theMessage,
+                                               pPacket->pFrame->data,
+                                               vos_ntohl(pPacket->pFrame->frameHead.datasetLength));
+                if (timed == TRUE)
                 {
-                    vos_printLogStr(VOS_LOG_ERROR, "Sending PD: Socket invalid!\n");
-                    /* Try to send the other packets */
-                }
-                /*    Send the packet if it is not redundant    */
-                else if (!(iterPD->privFlags & TRDP_REDUNDANT))
-                {
-                    TRDP_ERR_T result;
-                    if (iterPD->pfCbFunction != NULL)
-                    {
-                        TRDP_PD_INFO_T theMessage;
-                        theMessage.comId        = iterPD->addr.comId;
-                        theMessage.srcIpAddr    = iterPD->addr.srcIpAddr;
-                        theMessage.destIpAddr   = iterPD->addr.destIpAddr;
-                        theMessage.etbTopoCnt   = vos_ntohl(iterPD->pFrame->frameHead.etbTopoCnt);
-                        theMessage.opTrnTopoCnt = vos_ntohl(iterPD->pFrame->frameHead.opTrnTopoCnt);
-                        theMessage.msgType      = (TRDP_MSG_T) vos_ntohs(iterPD->pFrame->frameHead.msgType);
-                        theMessage.seqCount     = iterPD->curSeqCnt;
-                        theMessage.protVersion  = vos_ntohs(iterPD->pFrame->frameHead.protocolVersion);
-                        theMessage.replyComId   = vos_ntohl(iterPD->pFrame->frameHead.replyComId);
-                        theMessage.replyIpAddr  = vos_ntohl(iterPD->pFrame->frameHead.replyIpAddress);
-                        theMessage.pUserRef     = iterPD->pUserRef; /* User reference given with the local subscribe? */
-                        theMessage.resultCode   = err;
-
-                        iterPD->pfCbFunction(appHandle->pdDefault.pRefCon,
-                                                       appHandle,
-                                                       &theMessage,
-                                                       iterPD->pFrame->data,
-                                                       vos_ntohl(iterPD->pFrame->frameHead.datasetLength));
-                    }
-                    /* We pass the error to the application, but we keep on going    */
-                    result = trdp_pdSend(appHandle->iface[iterPD->socketIdx].sock, iterPD, appHandle->pdDefault.port);
-                    if (result == TRDP_NO_ERR)
+                    cbStart = vos_getTimeNs() - cbStart;
+                    if (latency == TRUE)
                     {
-                        appHandle->stats.pd.numSend++;
-                        iterPD->numRxTx++;
-                    }
-                    else
-                    {
-                        err = result;   /* pass last error to application  */
+                        trdp_pdRecordLatency(pPacket, TRUE, cbStart);
                     }
+                    trdp_cbAccount(appHandle, &pPacket->cbStats, pPacket->addr.comId, cbStart);
                 }
             }
+            /* We pass the error to the application, but we keep on going    */
+            result = trdp_pdSend(appHandle->iface[pPacket->socketIdx].sock, pPacket, appHandle->pdDefault.port);
 
-            if ((iterPD->privFlags & TRDP_REQ_2B_SENT) &&
-                (iterPD->pFrame->frameHead.msgType == vos_htons(TRDP_MSG_PP)))       /*  PULL packet?  */
-            {
-                /* Do not reset timer, but restore msgType */
-                iterPD->pFrame->frameHead.msgType = vos_htons(TRDP_MSG_PD);
-            }
-            else if (timerisset(&iterPD->interval))
+            /*  Sending (and the callback) took time, the following packets need the actual time  */
+            *pNow = vos_getTimeNs();
+            if (result == TRDP_NO_ERR)
             {
-                /*  Set timer if interval was set.
-                    In case of a requested cyclically PD packet, this will lead to one time jump (jitter) in the interval
-                */
-                vos_addTime(&iterPD->timeToGo, &iterPD->interval);
+                appHandle->stats.pd.numSend++;
+                pPacket->numRxTx++;
+                TRDP_TRACE(appHandle, TRDP_TRACE_PD_TX, pPacket->addr.comId,
+                           vos_ntohl(pPacket->pFrame->frameHead.sequenceCounter), pPacket->addr.destIpAddr);
 
-                if (vos_cmpTime(&iterPD->timeToGo, &now) <= 0)
+                /*  Age of the data put by the application  */
+                if (pPacket->putTime != 0)
                 {
-                    /* in case of a delay of more than one interval - avoid sending it in the next cycle again */
-                    iterPD->timeToGo = now;
-                    vos_addTime(&iterPD->timeToGo, &iterPD->interval);
+                    trdp_pdRecordLatency(pPacket, FALSE, *pNow - pPacket->putTime);
+                    pPacket->putTime = 0;
                 }
             }
+            else
+            {
+                err = result;   /* pass last error to application  */
+            }
+        }
+    }
+
+    if ((pPacket->privFlags & TRDP_REQ_2B_SENT) &&
+        (pPacket->pFrame->frameHead.msgType == vos_htons(TRDP_MSG_PP)))       /*  PULL packet?  */
+    {
+        /* Do not reset timer, but restore msgType */
+        pPacket->pFrame->frameHead.msgType = vos_htons(TRDP_MSG_PD);
+    }
+    else if (pPacket->interval != 0)
+    {
+        /*  Set timer if interval was set.
+            In case of a requested cyclically PD packet, this will lead to one time jump (jitter) in the interval
+        */
+        pPacket->timeToGo += pPacket->interval;
+
+        if (pPacket->timeToGo <= *pNow)
+        {
+            /* in case of a delay of more than one interval - avoid sending it in the next cycle again,
+               skip the missed cycles but keep the phase */
+            trdp_pdAlignToEpoch(appHandle, pPacket, *pNow);
+        }
+    }
+
+    /* Reset "immediate" flag for request or requested packet */
+    pPacket->privFlags = (TRDP_PRIV_FLAGS_T) (pPacket->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_REQ_2B_SENT);
+
+    /* remove one shot messages after they have been sent */
+    if (pPacket->pFrame->frameHead.msgType == vos_htons(TRDP_MSG_PR))    /* Ticket #172: remove element */
+    {
+        /* Decrease the socket ref */
+        trdp_releaseSocket(appHandle->iface, pPacket->socketIdx, 0u, FALSE, VOS_INADDR_ANY);
+        /* Remove current element */
+        trdp_queueDelElement(&appHandle->pSndQueue, pPacket);
+        appHandle->stats.pd.numPub--;
+        pPacket->magic = 0u;
+        if (pPacket->pSeqCntList != NULL)
+        {
+            vos_memFree(pPacket->pSeqCntList);
+        }
+        if (pPacket->pLatency != NULL)
+        {
+            vos_memFree(pPacket->pLatency);
+        }
+        vos_memFree(pPacket->pFrame);
+        vos_memFree(pPacket);
+    }
+    return err;
+}
+
+/******************************************************************************/
+/** Send all due PD messages
+ *  The due packets are sent by QoS class (highest first), within a class by deadline (earliest first).
+ *  If a send budget is set (tlc_setSendBudget), packets below its QoS class are deferred to the next
+ *  budget window once the window's bytes are used up.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      now                 current time (of this processing pass), refreshed after each send
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_IO_ERR         socket I/O error
+ */
+TRDP_ERR_T  trdp_pdSendQueued (
+    TRDP_SESSION_PT appHandle,
+    VOS_TIME_NS_T   now)
+{
+    PD_ELE_T    *pDue[TRDP_QOS_CLASSES];
+    PD_ELE_T    *pLast[TRDP_QOS_CLASSES];
+    PD_ELE_T    *iterPD;
+    PD_ELE_T    *pNextDue;
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+    TRDP_ERR_T  result;
+    INT32       qos;
+
+    appHandle->nextJob = 0;
+    memset(pDue, 0, sizeof(pDue));
+    memset(pLast, 0, sizeof(pLast));
+
+    trdp_pdBudgetUpdate(appHandle, now);
+
+    /*    Collect the packets to be sent now:    */
+    for (iterPD = appHandle->pSndQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        /*  Is this a cyclic packet and
+         due to sent?
+         or is it a PD Request or a requested packet (PULL) ?
+         */
+        if (((iterPD->interval != 0) &&                         /*  Request for immediate sending   */
+             (iterPD->timeToGo <= now)) ||
+            (iterPD->privFlags & TRDP_REQ_2B_SENT))
+        {
+            trdp_pdDueInsert(pDue, pLast, iterPD);
+        }
+    }
 
-            /* Reset "immediate" flag for request or requested packet */
-            iterPD->privFlags = (TRDP_PRIV_FLAGS_T) (iterPD->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_REQ_2B_SENT);
+    /*    Send them, most important first:    */
+    for (qos = (INT32) TRDP_QOS_CLASSES - 1; qos >= 0; qos--)
+    {
+        for (iterPD = pDue[qos]; iterPD != NULL; iterPD = pNextDue)
+        {
+            pNextDue = iterPD->pNextDue;        /* iterPD might be freed */
 
-            /* remove one shot messages after they have been sent */
-            if (iterPD->pFrame->frameHead.msgType == vos_htons(TRDP_MSG_PR))    /* Ticket #172: remove element */
+            if (trdp_pdBudgetDefer(appHandle, iterPD) == TRUE)
             {
-                PD_ELE_T *pTemp;
-                /* Decrease the socket ref */
-                trdp_releaseSocket(appHandle->iface, iterPD->socketIdx, 0u, FALSE, VOS_INADDR_ANY);
-                /* Save next element */
-                pTemp = iterPD->pNext;
-                /* Remove current element */
-                trdp_queueDelElement(&appHandle->pSndQueue, iterPD);
-                iterPD->magic = 0u;
-                if (iterPD->pSeqCntList != NULL)
-                {
-                    vos_memFree(iterPD->pSeqCntList);
-                }
-                vos_memFree(iterPD->pFrame);
-                vos_memFree(iterPD);
+                continue;                       /* keep it due, try again in the next window */
+            }
 
-                /* pre-set next element */
-                iterPD = pTemp;
-                continue;
+            result = trdp_pdSendElement(appHandle, iterPD, &now);
+            if (result != TRDP_NO_ERR)
+            {
+                err = result;   /* pass last error to application  */
             }
         }
-        iterPD = iterPD->pNext;
     }
     return err;
 }
@@ -441,6 +657,7 @@ TRDP_ERR_T  trdp_pdSendQueued (
  *
  *  @param[in]      appHandle           session pointer
  *  @param[in]      sock                the socket to read from
+ *  @param[in]      now                 current time (of this processing pass)
  *
  *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_PARAM_ERR      parameter error
@@ -451,7 +668,8 @@ TRDP_ERR_T  trdp_pdSendQueued (
  */
 TRDP_ERR_T  trdp_pdReceive (
     TRDP_SESSION_PT appHandle,
-    SOCKET          sock)
+    SOCKET          sock,
+    VOS_TIME_NS_T   now)
 {
     PD_HEADER_T         *pNewFrameHead      = &appHandle->pNewFrame->frameHead;
     PD_ELE_T            *pExistingElement   = NULL;
@@ -482,6 +700,8 @@ TRDP_ERR_T  trdp_pdReceive (
     {
        case TRDP_NO_ERR:
            appHandle->stats.pd.numRcv++;
+           TRDP_TRACE(appHandle, TRDP_TRACE_PD_RX, vos_ntohl(pNewFrameHead->comId),
+                      vos_ntohl(pNewFrameHead->sequenceCounter), subAddresses.srcIpAddr);
            break;
        case TRDP_CRC_ERR:
            appHandle->stats.pd.numCrcErr++;
@@ -534,6 +754,8 @@ TRDP_ERR_T  trdp_pdReceive (
                                    pExistingElement->addr.opTrnTopoCnt))
         {
             UINT32 newSeqCnt = vos_ntohl(pNewFrameHead->sequenceCounter);
+            INT32 numMissed;
+            int seqResult;
             /* Save the source IP address of the received packet */
             pExistingElement->lastSrcIP = subAddresses.srcIpAddr;
             /* Save the real destination of the received packet (own IP or MC group) */
@@ -547,10 +769,25 @@ TRDP_ERR_T  trdp_pdReceive (
             }
 
             /* find sender in our list */
-            switch (trdp_checkSequenceCounter(pExistingElement,
-                                              newSeqCnt,
-                                              subAddresses.srcIpAddr,
-                                              (TRDP_MSG_T) vos_ntohs(pNewFrameHead->msgType)))
+            seqResult = trdp_checkSequenceCounter(pExistingElement,
+                                                  newSeqCnt,
+                                                  subAddresses.srcIpAddr,
+                                                  (TRDP_MSG_T) vos_ntohs(pNewFrameHead->msgType),
+                                                  &numMissed);
+
+            /*  Gap in the sequence of this sender, or a late packet which was counted as missed   */
+            if (numMissed > 0)
+            {
+                pExistingElement->numMissed     += (UINT32) numMissed;
+                appHandle->stats.pd.numMissed   += (UINT32) numMissed;
+            }
+            else if (numMissed < 0)
+            {
+                pExistingElement->numMissed -= (pExistingElement->numMissed > 0u) ? 1u : 0u;
+                appHandle->stats.pd.numMissed -= (appHandle->stats.pd.numMissed > 0u) ? 1u : 0u;
+            }
+
+            switch (seqResult)
             {
                case 0:                      /* Sequence counter is valid (at least 1 higher than previous one) */
                    break;
@@ -562,15 +799,6 @@ TRDP_ERR_T  trdp_pdReceive (
                    return TRDP_NO_ERR;      /* Ignore packet, too old or duplicate */
             }
 
-            if ((newSeqCnt > 0u) && (newSeqCnt > (pExistingElement->curSeqCnt + 1u)))
-            {
-                pExistingElement->numMissed += newSeqCnt - pExistingElement->curSeqCnt - 1u;
-            }
-            else if (pExistingElement->curSeqCnt > newSeqCnt)
-            {
-                pExistingElement->numMissed += UINT32_MAX - pExistingElement->curSeqCnt + newSeqCnt;
-            }
-
             /* Store last received sequence counter here, too (pd_get et. al. may access it).   */
             pExistingElement->curSeqCnt = vos_ntohl(pNewFrameHead->sequenceCounter);
 
@@ -594,9 +822,8 @@ TRDP_ERR_T  trdp_pdReceive (
                 }
             }
 
-            /*  Get the current time and compute the next time this packet should be received.  */
-            vos_getTime(&pExistingElement->timeToGo);
-            vos_addTime(&pExistingElement->timeToGo, &pExistingElement->interval);
+            /*  Compute the next time this packet should be received.  */
+            pExistingElement->timeToGo = now + pExistingElement->interval;
 
             /*  Update some statistics  */
             pExistingElement->numRxTx++;
@@ -622,15 +849,29 @@ TRDP_ERR_T  trdp_pdReceive (
                 /*  Handle statistics request  */
                 if (vos_ntohl(pNewFrameHead->comId) == TRDP_STATISTICS_PULL_COMID)
                 {
-                    pPulledElement = trdp_queueFindComId(appHandle->pSndQueue, TRDP_GLOBAL_STATISTICS_COMID);
+                    UINT32 statsComId = vos_ntohl(pNewFrameHead->replyComId);
+
+                    /*  The subscription and publisher lists can be requested as reply ComId  */
+                    if ((statsComId != TRDP_SUBS_LIST_COMID) && (statsComId != TRDP_PUB_LIST_COMID))
+                    {
+                        statsComId = TRDP_GLOBAL_STATISTICS_COMID;
+                    }
+                    pPulledElement = trdp_queueFindComId(appHandle->pSndQueue, statsComId);
                     if (pPulledElement != NULL)
                     {
-                        pPulledElement->addr.comId      = TRDP_GLOBAL_STATISTICS_COMID;
+                        pPulledElement->addr.comId      = statsComId;
                         pPulledElement->addr.destIpAddr = vos_ntohl(pNewFrameHead->replyIpAddress);
 
                         trdp_pdInit(pPulledElement, TRDP_MSG_PP, appHandle->etbTopoCnt, appHandle->opTrnTopoCnt, 0u, 0u);
 
-                        trdp_pdPrepareStats(appHandle, pPulledElement);
+                        if (statsComId == TRDP_GLOBAL_STATISTICS_COMID)
+                        {
+                            trdp_pdPrepareStats(appHandle, pPulledElement);
+                        }
+                        else
+                        {
+                            trdp_pdPrepareListStats(appHandle, pPulledElement);
+                        }
                     }
                     else
                     {
@@ -667,7 +908,7 @@ TRDP_ERR_T  trdp_pdReceive (
                     /* trigger immediate sending of PD  */
                     pPulledElement->privFlags |= TRDP_REQ_2B_SENT;
 
-                    if (trdp_pdSendQueued(appHandle) != TRDP_NO_ERR)
+                    if (trdp_pdSendQueued(appHandle, now) != TRDP_NO_ERR)
                     {
                         /*  We do not break here, only report error */
                         vos_printLogStr(VOS_LOG_WARNING, "Error sending one or more PD packets\n");
@@ -708,11 +949,32 @@ TRDP_ERR_T  trdp_pdReceive (
             theMessage.pUserRef     = pExistingElement->pUserRef; /* User reference given with the local subscribe? */
             theMessage.resultCode   = err;
 
-            pExistingElement->pfCbFunction(appHandle->pdDefault.pRefCon,
-                                           appHandle,
-                                           &theMessage,
-                                           pExistingElement->pFrame->data,
-                                           vos_ntohl(pExistingElement->pFrame->frameHead.datasetLength));
+            {
+                BOOL8           latency = ((appHandle->option & TRDP_OPTION_LATENCY_STATS) != 0);
+                BOOL8           timed   = TRDP_CB_TIMED(appHandle);
+                VOS_TIME_NS_T   cbStart = (timed == TRUE) ? vos_getTimeNs() : 0;
+                VOS_TIME_NS_T   cbTime;
+
+                /*  Socket ready (start of the processing pass) until the callback and its execution time  */
+                if (latency == TRUE)
+                {
+                    trdp_pdRecordLatency(pExistingElement, FALSE, cbStart - now);
+                }
+                pExistingElement->pfCbFunction(appHandle->pdDefault.pRefCon,
+                                               appHandle,
+                                               &theMessage,
+                                               pExistingElement->pFrame->data,
+                                               vos_ntohl(pExistingElement->pFrame->frameHead.datasetLength));
+                if (timed == TRUE)
+                {
+                    cbTime = vos_getTimeNs() - cbStart;
+                    if (latency == TRUE)
+                    {
+                        trdp_pdRecordLatency(pExistingElement, TRUE, cbTime);
+                    }
+                    trdp_cbAccount(appHandle, &pExistingElement->cbStats, pExistingElement->addr.comId, cbTime);
+                }
+            }
         }
     }
     return err;
@@ -724,25 +986,27 @@ TRDP_ERR_T  trdp_pdReceive (
  *  @param[in]      appHandle           session pointer
  *  @param[in,out]  pFileDesc           pointer to set of ready descriptors
  *  @param[in,out]  pNoDesc             pointer to number of ready descriptors
+ *  @param[in]      now                 current time
  */
 void trdp_pdCheckPending (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_FDS_T          *pFileDesc,
-    INT32               *pNoDesc)
+    INT32               *pNoDesc,
+    VOS_TIME_NS_T       now)
 {
     PD_ELE_T *iterPD;
 
     /*    Walk over the registered PDs, find pending packets */
 
-    timerclear(&appHandle->nextJob);
+    appHandle->nextJob = 0;
 
     /*    Find the packet which has to be received next:    */
     for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
     {
         if ((!(iterPD->privFlags & TRDP_TIMED_OUT)) &&              /* Exempt already timed-out packet */
-            timerisset(&iterPD->interval) &&                        /* not PD PULL?                    */
-            (timercmp(&iterPD->timeToGo, &appHandle->nextJob, <) || /* earlier than current time-out?  */
-             !timerisset(&appHandle->nextJob)))                     /* or not set at all?              */
+            (iterPD->interval != 0) &&                              /* not PD PULL?                    */
+            ((iterPD->timeToGo < appHandle->nextJob) ||             /* earlier than current time-out?  */
+             (appHandle->nextJob == 0)))                            /* or not set at all?              */
         {
             appHandle->nextJob = iterPD->timeToGo;                  /* set new next time value from queue element */
         }
@@ -767,11 +1031,28 @@ void trdp_pdCheckPending (
     /*    Find packet in send queue which evntually has to be sent earlier:    */
     for (iterPD = appHandle->pSndQueue; iterPD != NULL; iterPD = iterPD->pNext)
     {
-        if (timerisset(&iterPD->interval) &&                        /* has a time out value?    */
-            (timercmp(&iterPD->timeToGo, &appHandle->nextJob, <) ||  /* earlier than current time-out? */
-             !timerisset(&appHandle->nextJob)))
+        VOS_TIME_NS_T   timeToGo    = iterPD->timeToGo;
+        BOOL8           requested   = ((iterPD->privFlags & TRDP_REQ_2B_SENT) != 0);
+
+        /*  A requested (pulled) packet still queued is due at once, also if it is pull-only (interval 0)  */
+        if (requested == TRUE)
         {
-            appHandle->nextJob = iterPD->timeToGo;                  /* set new next time value from queue element */
+            timeToGo = now;
+        }
+
+        /*  Packets deferred by the send budget wait for the next window  */
+        if ((appHandle->sendBudget.exhausted == TRUE) &&
+            (iterPD->qos < appHandle->sendBudget.minQos) &&
+            (timeToGo < appHandle->sendBudget.windowEnd))
+        {
+            timeToGo = appHandle->sendBudget.windowEnd;
+        }
+
+        if (((iterPD->interval != 0) || (requested == TRUE)) &&    /* has a time out value?    */
+            ((timeToGo < appHandle->nextJob) ||                     /* earlier than current time-out? */
+             (appHandle->nextJob == 0)))
+        {
+            appHandle->nextJob = timeToGo;                          /* set new next time value from queue element */
         }
     }
 }
@@ -780,33 +1061,35 @@ void trdp_pdCheckPending (
 /** Check for time outs
  *
  *  @param[in]      appHandle         application handle
+ *  @param[in]      now               current time (of this processing pass)
  */
 void trdp_pdHandleTimeOuts (
-    TRDP_SESSION_PT appHandle)
+    TRDP_SESSION_PT appHandle,
+    VOS_TIME_NS_T   now)
 {
     PD_ELE_T    *iterPD = NULL;
-    TRDP_TIME_T now;
-
-    /*    Update the current time    */
-    vos_getTime(&now);
 
     /*    Examine receive queue for late packets    */
     for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
     {
-        if (timerisset(&iterPD->interval) &&
-            timerisset(&iterPD->timeToGo) &&                        /*  Prevent timing out of PULLed data too early */
-            !timercmp(&iterPD->timeToGo, &now, >) &&                /*  late?   */
+        if ((iterPD->interval != 0) &&
+            (iterPD->timeToGo != 0) &&                              /*  Prevent timing out of PULLed data too early */
+            (iterPD->timeToGo <= now) &&                            /*  late?   */
             !(iterPD->privFlags & TRDP_TIMED_OUT) &&                /*  and not already flagged ?   */
             !(iterPD->addr.comId == TRDP_STATISTICS_PULL_COMID)) /*  Do not bother user with statistics timeout */
         {
             /*  Update some statistics  */
             appHandle->stats.pd.numTimeout++;
             iterPD->lastErr = TRDP_TIMEOUT_ERR;
+            TRDP_TRACE(appHandle, TRDP_TRACE_PD_TIMEOUT, iterPD->addr.comId, 0u, iterPD->addr.srcIpAddr);
 
             /* Packet is late! We inform the user about this:    */
             if (iterPD->pfCbFunction != NULL)
             {
-                TRDP_PD_INFO_T theMessage;
+                TRDP_PD_INFO_T  theMessage;
+                BOOL8           timed   = TRDP_CB_TIMED(appHandle);
+                VOS_TIME_NS_T   cbStart = (timed == TRUE) ? vos_getTimeNs() : 0;
+
                 memset(&theMessage, 0, sizeof(TRDP_PD_INFO_T));
                 theMessage.comId        = iterPD->addr.comId;
                 theMessage.srcIpAddr    = iterPD->addr.srcIpAddr;
@@ -837,14 +1120,15 @@ void trdp_pdHandleTimeOuts (
                                          NULL,
                                          iterPD->dataSize);
                 }
+                if (timed == TRUE)
+                {
+                    trdp_cbAccount(appHandle, &iterPD->cbStats, iterPD->addr.comId, vos_getTimeNs() - cbStart);
+                }
             }
 
             /*    Prevent repeated time out events    */
             iterPD->privFlags |= TRDP_TIMED_OUT;
         }
-
-        /*    Update the current time    */
-        vos_getTime(&now);
     }
 }
 
@@ -855,11 +1139,13 @@ void trdp_pdHandleTimeOuts (
  *  @param[in]      appHandle           session pointer
  *  @param[in]      pRfds               pointer to set of ready descriptors
  *  @param[in,out]  pCount              pointer to number of ready descriptors
+ *  @param[in]      now                 current time (of this processing pass)
  */
 TRDP_ERR_T   trdp_pdCheckListenSocks (
     TRDP_SESSION_PT appHandle,
     TRDP_FDS_T      *pRfds,
-    INT32           *pCount)
+    INT32           *pCount,
+    VOS_TIME_NS_T   now)
 {
     PD_ELE_T    *iterPD = NULL;
     TRDP_ERR_T  err;
@@ -890,7 +1176,7 @@ TRDP_ERR_T   trdp_pdCheckListenSocks (
                 do
                 {
                     /* Read as long as data is available */
-                    err = trdp_pdReceive(appHandle, appHandle->iface[iterPD->socketIdx].sock);
+                    err = trdp_pdReceive(appHandle, appHandle->iface[iterPD->socketIdx].sock, now);
 
                 }
                 while (err == TRDP_NO_ERR && nonBlocking);
@@ -1054,118 +1340,878 @@ TRDP_ERR_T  trdp_pdSend (
 }
 
 /******************************************************************************/
-/** Distribute send time of PD packets over time
+/** Compute the next release time of a cyclic publisher
  *
- *  The duration of PD packets on a 100MBit/s network ranges from 3us to 150us max.
- *  Because a cyclic thread scheduling below 5ms would put a too heavy load on the system, and
- *  PD packets cannot get larger than 1432 (+ UDP header), we will not account for differences in packet size.
- *  Another factor is the differences in intervals for different packets: We should only change the
- *  starting times of the packets within 1/2 the interval time. Otherwise a late addition of packets
- *  could lead to timeouts of already queued packets.
- *  Scheduling will be computed based on the smallest interval time.
+ *  The packet is released at cycleEpoch + phase + k * interval, the earliest such instant after now
+ *  is set as timeToGo. The epoch may lie in the future.
  *
- *  @param[in]      pSndQueue       pointer to send queue
- *
- *  @retval         TRDP_NO_ERR
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pPacket         publisher element
+ *  @param[in]      now             current time
  */
-TRDP_ERR_T  trdp_pdDistribute (
-    PD_ELE_T *pSndQueue)
+void trdp_pdAlignToEpoch (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pPacket,
+    VOS_TIME_NS_T   now)
 {
-    PD_ELE_T    *pPacket    = pSndQueue;
-    TRDP_TIME_T deltaTmax   = {1000u, 0}; /*    Preset to highest value    */
-    TRDP_TIME_T tNull       = {0u, 0};
-    TRDP_TIME_T temp        = {0u, 0};
-    TRDP_TIME_T nextTime2Go;
-    UINT32      noOfPackets = 0u;
-    UINT32      packetIndex = 0u;
+    VOS_TIME_NS_T   base;
+    VOS_TIME_NS_T   cycles;
 
-    if (pSndQueue == NULL)
+    if (pPacket->interval <= 0)
     {
-        return TRDP_PARAM_ERR;
+        return;
     }
 
-    /*  Do nothing if only one packet is pending */
-    if (pSndQueue->pNext == NULL)
+    base    = appHandle->cycleEpoch + ((VOS_TIME_NS_T) pPacket->phase * 1000) % pPacket->interval;
+    cycles  = now - base;
+
+    /* floor division, the difference is negative if the epoch is ahead */
+    cycles = (cycles >= 0) ? (cycles / pPacket->interval + 1) : -((-cycles) / pPacket->interval);
+    pPacket->timeToGo = base + cycles * pPacket->interval;
+}
+
+/******************************************************************************/
+/** Take the phase of a cyclic publisher from its next release time
+ *
+ *  Unphased publishers are released relative to their publish time. Their phase is set to
+ *  (timeToGo - cycleEpoch) mod interval, so skipping missed cycles keeps their timing.
+ *  Call it after setting timeToGo or the cycle epoch.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pPacket         publisher element
+ */
+void trdp_pdPhaseOf (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pPacket)
+{
+    VOS_TIME_NS_T offset;
+
+    if (pPacket->interval <= 0)
     {
-        return TRDP_NO_ERR;
+        return;
     }
 
-    /*
-        Find delta tmax - the maximum time for which we will distribute the packets and the number of packets
-        to send within that time. Equals the smallest interval of any PD.
-        Find the next packet send time, as well.
-    */
-
-    while (pPacket)
+    /* floor modulo, the epoch may lie in the future */
+    offset = (pPacket->timeToGo - appHandle->cycleEpoch) % pPacket->interval;
+    if (offset < 0)
     {
-        /*  Do not count PULL-only packets!  */
-        if ((pPacket->interval.tv_sec != 0u) ||
-            (pPacket->interval.tv_usec != 0))
-        {
-            if (vos_cmpTime(&deltaTmax, &pPacket->interval) > 0)
-            {
-                deltaTmax = pPacket->interval;
-            }
-            if (vos_cmpTime(&tNull, &pPacket->timeToGo) < 0)
-            {
-                tNull = pPacket->timeToGo;
-            }
-            noOfPackets++;
-        }
-        pPacket = pPacket->pNext;
+        offset += pPacket->interval;
     }
+    pPacket->phase = (UINT32) (offset / 1000);
+}
 
-    /*  Sanity check  */
-    if ((vos_cmpTime(&deltaTmax, &temp) == 0) ||
-        (noOfPackets == 0))
+/******************************************************************************/
+/** Update the committed bit rate accounted for a publisher
+ *
+ *  The rate of each cyclic publisher is kept in admission.pdRate of its send socket, the same interface
+ *  key (bind address of the socket) the traffic shaping tables use. Each frame is accounted with its
+ *  gross size plus TRDP_WIRE_OVERHEAD, PULL publishers are not counted.
+ *  Must be called after publishing, after a change of the packet size and before unpublishing.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pPacket         publisher element
+ *  @param[in]      add             TRUE: (re-)account the current size, FALSE: remove the publisher
+ */
+void trdp_pdRateAccount (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pPacket,
+    BOOL8           add)
+{
+    if ((appHandle == NULL) || (pPacket == NULL) ||
+        (pPacket->socketIdx < 0) || (pPacket->socketIdx >= VOS_MAX_SOCKET_CNT))
     {
-        vos_printLog(VOS_LOG_INFO, "trdp_pdDistribute: no minimal interval in %d packets found!\n", noOfPackets);
-        return TRDP_NO_ERR;     /* Ticket #14: Nothing to shape is not an error */
+        return;
     }
 
-    /*  This is the delta time we can jitter...   */
-    vos_divTime(&deltaTmax, noOfPackets);
+    appHandle->admission.pdRate[pPacket->socketIdx] -= pPacket->committedRate;
+    pPacket->committedRate = 0u;
+    if ((add == TRUE) && (pPacket->interval > 0))
+    {
+        pPacket->committedRate = ((UINT64) pPacket->grossSize + TRDP_WIRE_OVERHEAD) * 8000000000u /
+            (UINT64) pPacket->interval;
+    }
+    appHandle->admission.pdRate[pPacket->socketIdx] += pPacket->committedRate;
+}
 
-    vos_printLog(VOS_LOG_INFO,
-                 "trdp_pdDistribute: deltaTmax   = %ld.%06u\n",
-                 (long) deltaTmax.tv_sec,
-                 (unsigned int)deltaTmax.tv_usec);
-    vos_printLog(VOS_LOG_INFO,
-                 "trdp_pdDistribute: tNull       = %ld.%06u\n",
-                 (long) tNull.tv_sec,
-                 (unsigned int)tNull.tv_usec);
-    vos_printLog(VOS_LOG_INFO, "trdp_pdDistribute: noOfPackets = %d\n", noOfPackets);
+/******************************************************************************/
+/** Committed bit rate of the cyclic publishers of an interface
+ *
+ *  Sum of the rates accounted by trdp_pdRateAccount for the send sockets bound to the interface.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      srcIpAddr       interface (source IP of the publishers)
+ *
+ *  @retval         bit/s
+ */
+UINT64 trdp_pdCommittedRate (
+    TRDP_SESSION_PT appHandle,
+    TRDP_IP_ADDR_T  srcIpAddr)
+{
+    TRDP_IP_ADDR_T  ifAddr  = vos_determineBindAddr(srcIpAddr, 0u, FALSE);
+    UINT64          rate    = 0u;
+    INT32           idx;
 
-    for (packetIndex = 0, pPacket = pSndQueue; packetIndex < noOfPackets && pPacket != NULL; )
+    for (idx = 0; idx < VOS_MAX_SOCKET_CNT; idx++)
     {
-        /*  Ignore PULL-only packets!  */
-        if ((pPacket->interval.tv_sec != 0u) ||
-            (pPacket->interval.tv_usec != 0))
+        if ((appHandle->admission.pdRate[idx] != 0u) &&
+            (appHandle->iface[idx].bindAddr == ifAddr))
         {
-            nextTime2Go = tNull;
-            temp        = deltaTmax;
-            vos_mulTime(&temp, packetIndex);
+            rate += appHandle->admission.pdRate[idx];
+        }
+    }
+    return rate;
+}
 
-            vos_addTime(&nextTime2Go, &temp);
-            vos_mulTime(&temp, 2u);
+/******************************************************************************/
+/** Position of an interface in the committed rates of a batch
+ *
+ *  @param[in]      pRates          committed rates per interface
+ *  @param[in]      ifAddr          bind address of the interface
+ *
+ *  @retval         position, pRates->numIf if not found
+ */
+static UINT32 trdp_pdRatesIf (
+    const TRDP_IF_RATES_T   *pRates,
+    TRDP_IP_ADDR_T          ifAddr)
+{
+    UINT32 i;
 
-            if (vos_cmpTime(&temp, &pPacket->interval) > 0)
-            {
-                vos_printLog(VOS_LOG_INFO, "trdp_pdDistribute: packet [%d] with interval %lu.%06u could timeout...\n",
-                             packetIndex, (long) temp.tv_sec, (unsigned int)temp.tv_usec);
-                vos_printLogStr(VOS_LOG_INFO, "...no change in send time!\n");
-            }
-            else
-            {
-                pPacket->timeToGo = nextTime2Go;
-                vos_printLog(VOS_LOG_INFO, "trdp_pdDistribute: nextTime2Go[%d] = %lu.%06u\n",
-                             packetIndex, (unsigned long) nextTime2Go.tv_sec, (unsigned int)nextTime2Go.tv_usec);
+    for (i = 0u; i < pRates->numIf; i++)
+    {
+        if (pRates->ifAddr[i] == ifAddr)
+        {
+            break;
+        }
+    }
+    return i;
+}
 
-            }
-            packetIndex++;
+/******************************************************************************/
+/** Add a bit rate to an interface of the committed rates of a batch
+ *
+ *  @param[in,out]  pRates          committed rates per interface
+ *  @param[in]      ifAddr          bind address of the interface, appended if not yet listed
+ *  @param[in]      rate            bit/s
+ */
+static void trdp_pdRatesSum (
+    TRDP_IF_RATES_T *pRates,
+    TRDP_IP_ADDR_T  ifAddr,
+    UINT64          rate)
+{
+    UINT32 i = trdp_pdRatesIf(pRates, ifAddr);
+
+    if (i == pRates->numIf)
+    {
+        if (i >= VOS_MAX_SOCKET_CNT)
+        {
+            return;
         }
-        pPacket = pPacket->pNext;
+        pRates->ifAddr[i]   = ifAddr;
+        pRates->rate[i]     = 0u;
+        pRates->numIf++;
     }
+    pRates->rate[i] += rate;
+}
 
-    return TRDP_NO_ERR;
+/******************************************************************************/
+/** Committed bit rates of all interfaces, summed once for a batch of new publishers
+ *
+ *  trdp_pdAdmit then looks the interface up instead of summing the sockets for each publisher.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[out]     pRates          committed rates per interface
+ */
+void trdp_pdRatesInit (
+    TRDP_SESSION_PT appHandle,
+    TRDP_IF_RATES_T *pRates)
+{
+    INT32 idx;
+
+    pRates->numIf = 0u;
+    for (idx = 0; idx < VOS_MAX_SOCKET_CNT; idx++)
+    {
+        if (appHandle->admission.pdRate[idx] != 0u)
+        {
+            trdp_pdRatesSum(pRates, appHandle->iface[idx].bindAddr, appHandle->admission.pdRate[idx]);
+        }
+    }
+}
+
+/******************************************************************************/
+/** Add a new publisher of the batch to the committed bit rates
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in,out]  pRates          committed rates per interface
+ *  @param[in]      pPacket         publisher, accounted by trdp_pdRateAccount
+ */
+void trdp_pdRatesAdd (
+    TRDP_SESSION_PT appHandle,
+    TRDP_IF_RATES_T *pRates,
+    const PD_ELE_T  *pPacket)
+{
+    if ((pPacket->committedRate == 0u) ||
+        (pPacket->socketIdx < 0) || (pPacket->socketIdx >= VOS_MAX_SOCKET_CNT))
+    {
+        return;
+    }
+    trdp_pdRatesSum(pRates, appHandle->iface[pPacket->socketIdx].bindAddr, pPacket->committedRate);
+}
+
+/******************************************************************************/
+/** Admission control for a new cyclic publisher
+ *
+ *  Checks whether the committed bit rate of the interface would exceed the configured limit.
+ *  Depending on the session setting the publisher is rejected or only a warning is logged.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pRates          committed rates of a publisher batch, NULL: summed from the sockets
+ *  @param[in]      srcIpAddr       interface (source IP of the publisher)
+ *  @param[in]      grossSize       gross packet size of the publisher
+ *  @param[in]      interval        send interval in us, 0 for PULL publishers
+ *
+ *  @retval         TRDP_NO_ERR         admitted
+ *  @retval         TRDP_QUEUE_FULL_ERR bit rate limit exceeded
+ */
+TRDP_ERR_T trdp_pdAdmit (
+    TRDP_SESSION_PT         appHandle,
+    const TRDP_IF_RATES_T   *pRates,
+    TRDP_IP_ADDR_T          srcIpAddr,
+    UINT32                  grossSize,
+    UINT32                  interval)
+{
+    UINT64 rate = 0u;
+    UINT32 i;
+
+    if ((appHandle->admission.pdLimit == 0u) || (interval == 0u))
+    {
+        return TRDP_NO_ERR;
+    }
+
+    if (pRates == NULL)
+    {
+        rate = trdp_pdCommittedRate(appHandle, srcIpAddr);
+    }
+    else
+    {
+        i = trdp_pdRatesIf(pRates, vos_determineBindAddr(srcIpAddr, 0u, FALSE));
+        if (i < pRates->numIf)
+        {
+            rate = pRates->rate[i];
+        }
+    }
+    rate += ((UINT64) grossSize + TRDP_WIRE_OVERHEAD) * 8000000u / interval;
+
+    if (rate <= appHandle->admission.pdLimit)
+    {
+        return TRDP_NO_ERR;
+    }
+
+    if (appHandle->admission.pdReject == TRUE)
+    {
+        appHandle->admission.numRejected++;
+        vos_printLog(VOS_LOG_ERROR, "Publisher rejected: %s would commit %u of %u kbit/s\n",
+                     vos_ipDotted(srcIpAddr), (unsigned int) (rate / 1000u),
+                     (unsigned int) (appHandle->admission.pdLimit / 1000u));
+        return TRDP_QUEUE_FULL_ERR;
+    }
+
+    vos_printLog(VOS_LOG_WARNING, "Bit rate limit exceeded: %s commits %u of %u kbit/s\n",
+                 vos_ipDotted(srcIpAddr), (unsigned int) (rate / 1000u),
+                 (unsigned int) (appHandle->admission.pdLimit / 1000u));
+    return TRDP_NO_ERR;
+}
+
+/******************************************************************************/
+/** Greatest common divisor of two slot counts
+ *
+ *  @param[in]      a           first value
+ *  @param[in]      b           second value
+ *
+ *  @retval         gcd(a, b)
+ */
+static UINT32 trdp_pdShapingGcd (
+    UINT32  a,
+    UINT32  b)
+{
+    while (b != 0u)
+    {
+        UINT32 t = a % b;
+        a   = b;
+        b   = t;
+    }
+    return a;
+}
+
+/******************************************************************************/
+/** Least common multiple of two periods, limited to TRDP_SHAPING_MAX_SLOTS
+ *
+ *  If the limit is exceeded, the largest single period is kept (not exceeding the limit either).
+ *  Also used by the offline analysis (trdp-xmlanalyze) to get the same hyperperiod.
+ *
+ *  @param[in]      a           first period in slots, 0 if none
+ *  @param[in]      b           second period in slots
+ *
+ *  @retval         lcm(a, b)
+ */
+UINT32 trdp_pdShapingLcm (
+    UINT32  a,
+    UINT32  b)
+{
+    UINT64 lcm;
+
+    if (a == 0u)
+    {
+        return b;
+    }
+    lcm = (UINT64) a / trdp_pdShapingGcd(a, b) * b;
+    if (lcm > TRDP_SHAPING_MAX_SLOTS)
+    {
+        /* Keep the largest single period, but do not exceed the limit */
+        lcm = (a > b) ? a : b;
+        if (lcm > TRDP_SHAPING_MAX_SLOTS)
+        {
+            lcm = TRDP_SHAPING_MAX_SLOTS;
+        }
+    }
+    return (UINT32) lcm;
+}
+
+/******************************************************************************/
+/** Compute the hyperperiod (least common multiple of all periods) of an interface
+ *
+ *  The result is limited to TRDP_SHAPING_MAX_SLOTS. If the limit is exceeded, the table covers only part
+ *  of the true hyperperiod and the slot load of packets not fitting an integral number of times is
+ *  an approximation (their wrap-around is not accounted for).
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      ifAddr          interface to compute the hyperperiod for
+ *  @param[in]      period          additional period (of publishers to be placed) or 0
+ *
+ *  @retval         hyperperiod in slots, 0 if there is nothing to shape
+ */
+static UINT32 trdp_pdShapingHyperperiod (
+    TRDP_SESSION_PT appHandle,
+    TRDP_IP_ADDR_T  ifAddr,
+    UINT32          period)
+{
+    PD_ELE_T    *iterPD;
+    UINT32      noOfSlots = period;
+
+    for (iterPD = appHandle->pSndQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        if ((iterPD->shapingPeriod != 0u) &&
+            (appHandle->iface[iterPD->socketIdx].bindAddr == ifAddr))
+        {
+            noOfSlots = trdp_pdShapingLcm(noOfSlots, iterPD->shapingPeriod);
+        }
+    }
+    if (noOfSlots > TRDP_SHAPING_MAX_SLOTS)
+    {
+        noOfSlots = TRDP_SHAPING_MAX_SLOTS;
+    }
+    return noOfSlots;
+}
+
+/******************************************************************************/
+/** Add (or remove) the load of a publisher to (from) all its slots within the hyperperiod
+ *
+ *  @param[in]      pTable          slot table
+ *  @param[in]      offset          first slot
+ *  @param[in]      period          period in slots
+ *  @param[in]      size            bytes to add
+ *  @param[in]      add             TRUE to add, FALSE to subtract
+ */
+static void trdp_pdShapingAccount (
+    TRDP_SHAPING_T  *pTable,
+    UINT32          offset,
+    UINT32          period,
+    UINT32          size,
+    BOOL8           add)
+{
+    UINT32 slot;
+
+    for (slot = offset; slot < pTable->noOfSlots; slot += period)
+    {
+        if (add == TRUE)
+        {
+            pTable->pSlotLoad[slot] += size;
+        }
+        else
+        {
+            pTable->pSlotLoad[slot] = (pTable->pSlotLoad[slot] > size) ? pTable->pSlotLoad[slot] - size : 0u;
+        }
+    }
+}
+
+/******************************************************************************/
+/** Update the worst case burst of a slot table
+ *
+ *  @param[in]      pTable          slot table
+ */
+static void trdp_pdShapingPeak (
+    TRDP_SHAPING_T *pTable)
+{
+    UINT32 slot;
+
+    pTable->maxBurst = 0u;
+    for (slot = 0u; slot < pTable->noOfSlots; slot++)
+    {
+        if (pTable->pSlotLoad[slot] > pTable->maxBurst)
+        {
+            pTable->maxBurst = pTable->pSlotLoad[slot];
+        }
+    }
+    vos_printLog(VOS_LOG_INFO,
+                 "Traffic shaping %s: %u publishers, %u slots of %u us, worst case burst %u bytes\n",
+                 vos_ipDotted(pTable->ifAddr), pTable->noOfPub, pTable->noOfSlots,
+                 TRDP_SHAPING_SLOT_TIME, pTable->maxBurst);
+}
+
+/******************************************************************************/
+/** Re-create a slot table with a new hyperperiod
+ *
+ *  The already placed publishers keep their offsets, only the table is expanded or shrunk.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pTable          slot table
+ *  @param[in]      noOfSlots       new hyperperiod in slots
+ *
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_MEM_ERR
+ */
+static TRDP_ERR_T trdp_pdShapingRebuild (
+    TRDP_SESSION_PT appHandle,
+    TRDP_SHAPING_T  *pTable,
+    UINT32          noOfSlots)
+{
+    PD_ELE_T    *iterPD;
+    UINT32      *pSlotLoad = (UINT32 *) vos_memAlloc(noOfSlots * sizeof(UINT32));
+
+    if (pSlotLoad == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    if (pTable->pSlotLoad != NULL)
+    {
+        vos_memFree(pTable->pSlotLoad);
+    }
+    pTable->pSlotLoad   = pSlotLoad;
+    pTable->noOfSlots   = noOfSlots;
+
+    for (iterPD = appHandle->pSndQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        if ((iterPD->shapingPeriod != 0u) &&
+            (appHandle->iface[iterPD->socketIdx].bindAddr == pTable->ifAddr))
+        {
+            trdp_pdShapingAccount(pTable, iterPD->shapingOffset, iterPD->shapingPeriod, iterPD->shapedSize, TRUE);
+        }
+    }
+    return TRDP_NO_ERR;
+}
+
+/******************************************************************************/
+/** Period of a publisher in slots
+ *
+ *  @param[in]      pPacket         publisher element
+ *
+ *  @retval         period in slots, 0 if the publisher is not to be placed (PULL-only or already placed)
+ */
+static UINT32 trdp_pdShapingPeriod (
+    const PD_ELE_T *pPacket)
+{
+    UINT32 interval = (UINT32) (pPacket->interval / 1000);
+    UINT32 period;
+
+    /*  PULL-only packets are not sent cyclically  */
+    if ((interval == 0u) || (pPacket->shapingPeriod != 0u))
+    {
+        return 0u;
+    }
+
+    period = (interval + TRDP_SHAPING_SLOT_TIME / 2u) / TRDP_SHAPING_SLOT_TIME;
+    return (period == 0u) ? 1u : period;
+}
+
+/******************************************************************************/
+/** Find the slot table of an interface or claim a free one
+ *
+ *  A table is in use if it has slots or, while a batch is placed, a pending hyperperiod.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      ifAddr          interface address
+ *  @param[in]      pPending        pending hyperperiod per table (batch), NULL if none
+ *
+ *  @retval         index of the table, TRDP_SHAPING_MAX_IF if there is none left
+ */
+static UINT32 trdp_pdShapingTable (
+    TRDP_SESSION_PT appHandle,
+    TRDP_IP_ADDR_T  ifAddr,
+    const UINT32    *pPending)
+{
+    UINT32  idx;
+    UINT32  freeIdx = TRDP_SHAPING_MAX_IF;
+
+    for (idx = 0u; idx < TRDP_SHAPING_MAX_IF; idx++)
+    {
+        BOOL8 used = (appHandle->shaping[idx].noOfSlots != 0u) || ((pPending != NULL) && (pPending[idx] != 0u));
+
+        if (used && (appHandle->shaping[idx].ifAddr == ifAddr))
+        {
+            return idx;
+        }
+        if (!used && (freeIdx == TRDP_SHAPING_MAX_IF))
+        {
+            freeIdx = idx;
+        }
+    }
+    if (freeIdx == TRDP_SHAPING_MAX_IF)
+    {
+        vos_printLog(VOS_LOG_WARNING, "Traffic shaping: no slot table left for %s\n", vos_ipDotted(ifAddr));
+    }
+    else
+    {
+        /*  Slot 0 of all tables starts at the session cycle epoch  */
+        appHandle->shaping[freeIdx].ifAddr = ifAddr;
+    }
+    return freeIdx;
+}
+
+/******************************************************************************/
+/** Place a publisher into a slot table spanning its period
+ *
+ *  The offset within its period is chosen which minimises the peak load (in bytes) of all slots it will occupy.
+ *  A publisher with a given phase (TRDP_PHASED, 0 included) is not moved, it only occupies the slot of its
+ *  phase. The first send time of an unphased publisher is aligned to the chosen slot.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pTable          slot table
+ *  @param[in]      pPacket         publisher element
+ *  @param[in]      period          period of the publisher in slots
+ */
+static void trdp_pdShapingPlace (
+    TRDP_SESSION_PT appHandle,
+    TRDP_SHAPING_T  *pTable,
+    PD_ELE_T        *pPacket,
+    UINT32          period)
+{
+    UINT32  offset, slot;
+    UINT32  bestOffset  = 0u;
+    UINT32  bestLoad    = 0xFFFFFFFFu;
+
+    if ((pPacket->privFlags & TRDP_PHASED) != 0u)
+    {
+        /*  Phased packet: its slot is given  */
+        bestOffset = (pPacket->phase / TRDP_SHAPING_SLOT_TIME) % period;
+    }
+    else
+    {
+        /*  Search the offset with the smallest peak load over all slots this packet will use  */
+        for (offset = 0u; (offset < period) && (offset < pTable->noOfSlots); offset++)
+        {
+            UINT32 load = 0u;
+
+            for (slot = offset; slot < pTable->noOfSlots; slot += period)
+            {
+                if (pTable->pSlotLoad[slot] > load)
+                {
+                    load = pTable->pSlotLoad[slot];
+                }
+            }
+            if (load < bestLoad)
+            {
+                bestLoad    = load;
+                bestOffset  = offset;
+                if (load == 0u)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    pPacket->shapingOffset  = bestOffset;
+    pPacket->shapingPeriod  = period;
+    pPacket->shapedSize     = pPacket->grossSize;
+    trdp_pdShapingAccount(pTable, bestOffset, period, pPacket->shapedSize, TRUE);
+    pTable->noOfPub++;
+
+    /*  Next send time of an unphased packet: epoch + offset + k * interval  */
+    if ((pPacket->privFlags & TRDP_PHASED) == 0u)
+    {
+        pPacket->phase = bestOffset * TRDP_SHAPING_SLOT_TIME;
+        trdp_pdAlignToEpoch(appHandle, pPacket, vos_getTimeNs());
+    }
+}
+
+/******************************************************************************/
+/** Place a new publisher into the traffic shaping slot table of its interface
+ *
+ *  The slot table spans the hyperperiod of all published intervals on that interface. For the new
+ *  publisher the offset within its own period is chosen which minimises the peak load (in bytes) of
+ *  all slots it will occupy. Already placed publishers are never moved, so adding a telegram does not
+ *  disturb the timing of running ones. A publisher with a given phase is not moved either, it only
+ *  occupies the slot of its phase. The first send time of an unphased publisher is aligned to the chosen slot.
+ *  PULL-only publishers (interval 0) are not shaped.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pPacket         publisher element (already queued)
+ *
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_PARAM_ERR
+ *  @retval         TRDP_MEM_ERR
+ */
+TRDP_ERR_T  trdp_pdShapingAdd (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pPacket)
+{
+    TRDP_SHAPING_T  *pTable;
+    TRDP_IP_ADDR_T  ifAddr;
+    UINT32          period, noOfSlots, idx;
+    TRDP_ERR_T      err;
+
+    if ((appHandle == NULL) || (pPacket == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    period = trdp_pdShapingPeriod(pPacket);
+    if (period == 0u)
+    {
+        return TRDP_NO_ERR;
+    }
+
+    /*  Find the table of the interface or a free one  */
+    ifAddr  = appHandle->iface[pPacket->socketIdx].bindAddr;
+    idx     = trdp_pdShapingTable(appHandle, ifAddr, NULL);
+    if (idx == TRDP_SHAPING_MAX_IF)
+    {
+        return TRDP_NO_ERR;
+    }
+    pTable = &appHandle->shaping[idx];
+
+    noOfSlots = trdp_pdShapingHyperperiod(appHandle, ifAddr, period);
+    if (noOfSlots != pTable->noOfSlots)
+    {
+        err = trdp_pdShapingRebuild(appHandle, pTable, noOfSlots);
+        if (err != TRDP_NO_ERR)
+        {
+            return err;
+        }
+    }
+
+    trdp_pdShapingPlace(appHandle, pTable, pPacket, period);
+    trdp_pdShapingPeak(pTable);
+
+    return TRDP_NO_ERR;
+}
+
+/******************************************************************************/
+/** Place a batch of new publishers into the traffic shaping slot tables of their interfaces
+ *
+ *  Same placement as trdp_pdShapingAdd for each publisher in the order given, but the hyperperiod of
+ *  each table is computed and the table is rebuilt only once for the whole batch.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      ppPacket        array of publisher elements (already queued), NULL entries are skipped
+ *  @param[in]      count           number of entries
+ *
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_PARAM_ERR
+ *  @retval         TRDP_MEM_ERR
+ */
+TRDP_ERR_T  trdp_pdShapingAddBatch (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T *const *ppPacket,
+    UINT32          count)
+{
+    UINT32      pending[TRDP_SHAPING_MAX_IF];
+    UINT32      idx, noOfSlots, period, tableIdx;
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+
+    if ((appHandle == NULL) || ((ppPacket == NULL) && (count != 0u)))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    /*  Collect the periods of the batch per interface  */
+    memset(pending, 0, sizeof(pending));
+    for (idx = 0u; idx < count; idx++)
+    {
+        if ((ppPacket[idx] == NULL) || ((period = trdp_pdShapingPeriod(ppPacket[idx])) == 0u))
+        {
+            continue;
+        }
+        tableIdx = trdp_pdShapingTable(appHandle, appHandle->iface[ppPacket[idx]->socketIdx].bindAddr, pending);
+        if (tableIdx != TRDP_SHAPING_MAX_IF)
+        {
+            pending[tableIdx] = trdp_pdShapingLcm(pending[tableIdx], period);
+        }
+    }
+
+    /*  Resize each table once  */
+    for (tableIdx = 0u; tableIdx < TRDP_SHAPING_MAX_IF; tableIdx++)
+    {
+        TRDP_SHAPING_T *pTable = &appHandle->shaping[tableIdx];
+
+        if (pending[tableIdx] == 0u)
+        {
+            continue;
+        }
+        noOfSlots = trdp_pdShapingHyperperiod(appHandle, pTable->ifAddr, pending[tableIdx]);
+        if (noOfSlots != pTable->noOfSlots)
+        {
+            err = trdp_pdShapingRebuild(appHandle, pTable, noOfSlots);
+            if (err != TRDP_NO_ERR)
+            {
+                /*  Not placed, the packets of this interface are sent unshaped  */
+                pending[tableIdx] = 0u;
+            }
+        }
+    }
+
+    /*  Place the publishers in order  */
+    for (idx = 0u; idx < count; idx++)
+    {
+        if ((ppPacket[idx] == NULL) || ((period = trdp_pdShapingPeriod(ppPacket[idx])) == 0u))
+        {
+            continue;
+        }
+        for (tableIdx = 0u; tableIdx < TRDP_SHAPING_MAX_IF; tableIdx++)
+        {
+            if ((pending[tableIdx] != 0u) &&
+                (appHandle->shaping[tableIdx].ifAddr == appHandle->iface[ppPacket[idx]->socketIdx].bindAddr))
+            {
+                trdp_pdShapingPlace(appHandle, &appHandle->shaping[tableIdx], ppPacket[idx], period);
+                break;
+            }
+        }
+    }
+
+    for (tableIdx = 0u; tableIdx < TRDP_SHAPING_MAX_IF; tableIdx++)
+    {
+        if (pending[tableIdx] != 0u)
+        {
+            trdp_pdShapingPeak(&appHandle->shaping[tableIdx]);
+        }
+    }
+
+    return err;
+}
+
+/******************************************************************************/
+/** Remove a publisher from the traffic shaping slot table of its interface
+ *
+ *  The remaining publishers keep their slots, the hyperperiod may shrink.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pPacket         publisher element
+ *
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_PARAM_ERR
+ *  @retval         TRDP_MEM_ERR
+ */
+TRDP_ERR_T  trdp_pdShapingRemove (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pPacket)
+{
+    TRDP_IP_ADDR_T  ifAddr;
+    UINT32          idx, noOfSlots;
+
+    if ((appHandle == NULL) || (pPacket == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (pPacket->shapingPeriod == 0u)
+    {
+        return TRDP_NO_ERR;
+    }
+
+    ifAddr = appHandle->iface[pPacket->socketIdx].bindAddr;
+    for (idx = 0u; idx < TRDP_SHAPING_MAX_IF; idx++)
+    {
+        TRDP_SHAPING_T *pTable = &appHandle->shaping[idx];
+
+        if ((pTable->noOfSlots != 0u) && (pTable->ifAddr == ifAddr))
+        {
+            trdp_pdShapingAccount(pTable, pPacket->shapingOffset, pPacket->shapingPeriod, pPacket->shapedSize, FALSE);
+            pPacket->shapingPeriod = 0u;
+            pTable->noOfPub--;
+
+            if (pTable->noOfPub == 0u)
+            {
+                vos_memFree(pTable->pSlotLoad);
+                memset(pTable, 0, sizeof(TRDP_SHAPING_T));
+                return TRDP_NO_ERR;
+            }
+            noOfSlots = trdp_pdShapingHyperperiod(appHandle, ifAddr, 0u);
+            if (noOfSlots != pTable->noOfSlots)
+            {
+                if (trdp_pdShapingRebuild(appHandle, pTable, noOfSlots) != TRDP_NO_ERR)
+                {
+                    return TRDP_MEM_ERR;
+                }
+            }
+            trdp_pdShapingPeak(pTable);
+            break;
+        }
+    }
+    pPacket->shapingPeriod = 0u;
+    return TRDP_NO_ERR;
+}
+
+/******************************************************************************/
+/** Update the accounted size of a shaped publisher (e.g. on first tlp_put with data)
+ *
+ *  The publisher keeps its slot.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in]      pPacket         publisher element
+ */
+void trdp_pdShapingResize (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pPacket)
+{
+    TRDP_IP_ADDR_T  ifAddr;
+    UINT32          idx;
+
+    if ((appHandle == NULL) || (pPacket == NULL) ||
+        (pPacket->shapingPeriod == 0u) || (pPacket->shapedSize == pPacket->grossSize))
+    {
+        return;
+    }
+
+    ifAddr = appHandle->iface[pPacket->socketIdx].bindAddr;
+    for (idx = 0u; idx < TRDP_SHAPING_MAX_IF; idx++)
+    {
+        TRDP_SHAPING_T *pTable = &appHandle->shaping[idx];
+
+        if ((pTable->noOfSlots != 0u) && (pTable->ifAddr == ifAddr))
+        {
+            trdp_pdShapingAccount(pTable, pPacket->shapingOffset, pPacket->shapingPeriod, pPacket->shapedSize, FALSE);
+            pPacket->shapedSize = pPacket->grossSize;
+            trdp_pdShapingAccount(pTable, pPacket->shapingOffset, pPacket->shapingPeriod, pPacket->shapedSize, TRUE);
+            trdp_pdShapingPeak(pTable);
+            break;
+        }
+    }
+}
+
+/******************************************************************************/
+/** Release all traffic shaping tables of a session
+ *
+ *  @param[in]      appHandle       session pointer
+ */
+void trdp_pdShapingFree (
+    TRDP_SESSION_PT appHandle)
+{
+    UINT32 idx;
+
+    for (idx = 0u; idx < TRDP_SHAPING_MAX_IF; idx++)
+    {
+        if (appHandle->shaping[idx].pSlotLoad != NULL)
+        {
+            vos_memFree(appHandle->shaping[idx].pSlotLoad);
+        }
+        memset(&appHandle->shaping[idx], 0, sizeof(TRDP_SHAPING_T));
+    }
 }
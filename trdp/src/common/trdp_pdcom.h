@@ -16,6 +16,15 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: trdp_pdShapingLcm() exported
+ *      BL 2026-10-17: trdp_pdPhaseOf() added
+ *      BL 2026-10-17: TRDP_IF_RATES_T, trdp_pdRatesInit/Add(): committed rates per interface for a publisher batch
+ *      BL 2026-10-17: trdp_pdRateAccount() added, committed rate accumulated per send socket
+ *      BL 2026-10-17: trdp_pdShapingAddBatch() added
+ *      BL 2026-10-17: trdp_pdCommittedRate(), trdp_pdAdmit() added
+ *      BL 2026-10-17: Time of the processing pass passed in (ns)
+ *      BL 2026-10-17: trdp_pdAlignToEpoch() added
+ *      BL 2026-10-17: trdp_pdDistribute() replaced by trdp_pdShapingAdd/Remove/Resize/Free
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
  *      BL 2014-07-14: Ticket #46: Protocol change: operational topocount needed
  *                     Ticket #47: Protocol change: no FCS for data part of telegrams
@@ -40,6 +49,14 @@
  * TYPEDEFS
  */
 
+/** Committed PD bit rates per interface, summed once for a batch of publishers */
+typedef struct
+{
+    UINT32          numIf;                      /**< number of interfaces                       */
+    TRDP_IP_ADDR_T  ifAddr[VOS_MAX_SOCKET_CNT]; /**< bind address of the interface              */
+    UINT64          rate[VOS_MAX_SOCKET_CNT];   /**< committed bit rate of the interface        */
+} TRDP_IF_RATES_T;
+
 /*******************************************************************************
  * GLOBAL FUNCTIONS
  */
@@ -79,26 +96,86 @@ TRDP_ERR_T trdp_pdGet (
     UINT32              *pDataSize);
 
 TRDP_ERR_T  trdp_pdSendQueued (
-    TRDP_SESSION_PT appHandle);
+    TRDP_SESSION_PT appHandle,
+    VOS_TIME_NS_T   now);
 
 TRDP_ERR_T  trdp_pdReceive (
     TRDP_SESSION_PT pSessionHandle,
-    SOCKET           sock);
+    SOCKET           sock,
+    VOS_TIME_NS_T   now);
 
 void        trdp_pdCheckPending (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_FDS_T          *pFileDesc,
-    INT32               *pNoDesc);
+    INT32               *pNoDesc,
+    VOS_TIME_NS_T       now);
 
 void        trdp_pdHandleTimeOuts (
-    TRDP_SESSION_PT appHandle);
+    TRDP_SESSION_PT appHandle,
+    VOS_TIME_NS_T   now);
 
 TRDP_ERR_T  trdp_pdCheckListenSocks (
     TRDP_SESSION_PT appHandle,
     TRDP_FDS_T      *pRfds,
-    INT32           *pCount);
+    INT32           *pCount,
+    VOS_TIME_NS_T   now);
+
+void        trdp_pdAlignToEpoch (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pPacket,
+    VOS_TIME_NS_T   now);
+
+void        trdp_pdPhaseOf (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pPacket);
+
+void        trdp_pdRateAccount (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pPacket,
+    BOOL8           add);
+
+UINT64      trdp_pdCommittedRate (
+    TRDP_SESSION_PT appHandle,
+    TRDP_IP_ADDR_T  srcIpAddr);
+
+void        trdp_pdRatesInit (
+    TRDP_SESSION_PT appHandle,
+    TRDP_IF_RATES_T *pRates);
+
+void        trdp_pdRatesAdd (
+    TRDP_SESSION_PT appHandle,
+    TRDP_IF_RATES_T *pRates,
+    const PD_ELE_T  *pPacket);
+
+TRDP_ERR_T  trdp_pdAdmit (
+    TRDP_SESSION_PT         appHandle,
+    const TRDP_IF_RATES_T   *pRates,
+    TRDP_IP_ADDR_T          srcIpAddr,
+    UINT32                  grossSize,
+    UINT32                  interval);
+
+UINT32      trdp_pdShapingLcm (
+    UINT32  a,
+    UINT32  b);
+
+TRDP_ERR_T  trdp_pdShapingAdd (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pPacket);
 
-TRDP_ERR_T trdp_pdDistribute (
-    PD_ELE_T *pSndQueue);
+TRDP_ERR_T  trdp_pdShapingAddBatch (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T *const *ppPacket,
+    UINT32          count);
+
+TRDP_ERR_T  trdp_pdShapingRemove (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pPacket);
+
+void        trdp_pdShapingResize (
+    TRDP_SESSION_PT appHandle,
+    PD_ELE_T        *pPacket);
+
+void        trdp_pdShapingFree (
+    TRDP_SESSION_PT appHandle);
 
 #endif
@@ -16,6 +16,24 @@
  *      
  * $Id$
  *
+ *      BL 2026-10-17: TRDP_PHASED: publisher with a given phase (0 included), only those are moved by a new epoch
+ *      BL 2026-10-17: TRDP_SEQ_CNT_ENTRY_T.lost: late packets are deducted only if counted as lost
+ *      BL 2026-10-17: Metrics response rendered in slices and sent over several passes (TRDP_METRICS_SLICE)
+ *      BL 2026-10-17: traceUsers guards pTrace against tlc_setTrace() while a signal handler dumps it
+ *      BL 2026-10-17: Committed PD bit rate accumulated per send socket (admission.pdRate, committedRate)
+ *      BL 2026-10-17: Statistics history in shared memory (pHistory), TRDP_PROC_TIMING_T.passMax
+ *      BL 2026-10-17: Sequence tracking per source: receive window, loss bursts, reorder and duplicate counts
+ *      BL 2026-10-17: Callback accounting (TRDP_CB_STATS_T) per PD element and listener, MD_ELE_T.pListener
+ *      BL 2026-10-17: TRDP_PROCESS_TIMING, stage timing of tlc_process() (pTiming)
+ *      BL 2026-10-17: Metrics endpoint state (TRDP_METRICS_T)
+ *      BL 2026-10-17: TRDP_TRACE_SUPPORT, session event trace ring (pTrace)
+ *      BL 2026-10-17: Latency histograms per PD element (pLatency, putTime)
+ *      BL 2026-10-17: Admission control (committed PD bit rate per interface), MD token bucket
+ *      BL 2026-10-17: PD send order by QoS and deadline, send byte budget
+ *      BL 2026-10-17: PD scheduler times (interval, timeToGo, nextJob, cycleEpoch) in ns
+ *      BL 2026-10-17: Publisher phase, shapingEpoch -> cycleEpoch (common for all publishers)
+ *      BL 2026-10-17: TRDP_PRECISE_WAIT_GUARD, session preciseDeadline
+ *      BL 2026-10-17: Slot based traffic shaping (per interface hyperperiod slot table)
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
  *      BL 2017-11-28: Ticket #180 Filtering rules for DestinationURI does not follow the standard
  *      BL 2017-11-17: superfluous session->redID replaced by sndQueue->redId
@@ -62,9 +80,58 @@
 #define TRDP_MAGIC_SUB_HNDL_VALUE           0xBABECAFEu
 
 #define TRDP_SEQ_CNT_START_ARRAY_SIZE       64u                           /**< This should be enough for the start    */
+#define TRDP_SEQ_CNT_WINDOW                 32u                           /**< Late packets detected per source       */
 
 #define TRDP_IF_WAIT_FOR_READY              120u    /**< 120 seconds (120 tries each second to bind to an IP address) */
 
+#ifndef TRDP_SHAPING_SLOT_TIME
+#define TRDP_SHAPING_SLOT_TIME              1000u                         /**< width of a traffic shaping slot in us  */
+#endif
+
+#ifndef TRDP_SHAPING_MAX_SLOTS
+#define TRDP_SHAPING_MAX_SLOTS              10000u                        /**< max. hyperperiod in slots (10s)        */
+#endif
+
+#ifndef TRDP_SHAPING_MAX_IF
+#define TRDP_SHAPING_MAX_IF                 4u                            /**< max. interfaces shaped per session     */
+#endif
+
+#define TRDP_QOS_CLASSES                    8u            /**< QoS 0 (lowest) ... 7 (highest priority)     */
+
+#define TRDP_WIRE_OVERHEAD                  66u           /**< UDP, IPv4, Ethernet, FCS, preamble and gap per frame */
+
+#ifndef TRDP_PRECISE_WAIT_GUARD
+#define TRDP_PRECISE_WAIT_GUARD             200u          /**< spin time in us before due jobs (TRDP_OPTION_PRECISE_WAIT) */
+#endif
+
+/* Event trace ring (tlc_setTrace), can be compiled out by defining TRDP_TRACE_SUPPORT=0 */
+#ifndef TRDP_TRACE_SUPPORT
+#define TRDP_TRACE_SUPPORT                  1
+#endif
+
+#ifndef TRDP_METRICS_BUF_SIZE
+#define TRDP_METRICS_BUF_SIZE               32768u        /**< initial buffer for rendering the metrics text  */
+#endif
+
+#ifndef TRDP_METRICS_SLICE
+#define TRDP_METRICS_SLICE                  64u           /**< publishers / subscriptions rendered per pass   */
+#endif
+
+#define TRDP_METRICS_REQ_SIZE               128u          /**< bytes of an HTTP request kept (request line)   */
+#define TRDP_METRICS_REQ_TIMEOUT            1000000u      /**< time in us for a client to send its request or
+                                                               to take the next part of the response          */
+#define TRDP_METRICS_HDR_SIZE               160u          /**< room for the HTTP header of a response         */
+#define TRDP_METRICS_SEND_POLL              10000u        /**< retry in us of a response the client blocks    */
+
+/* Stage timing of tlc_process (tlc_setProcessTiming), can be compiled out by defining TRDP_PROCESS_TIMING=0 */
+#ifndef TRDP_PROCESS_TIMING
+#define TRDP_PROCESS_TIMING                 1
+#endif
+
+#ifndef TRDP_HISTORY_INTERVAL
+#define TRDP_HISTORY_INTERVAL               1000u         /**< sample interval of the statistics history in ms */
+#endif
+
 /***********************************************************************************************************************
  * TYPEDEFS
  */
@@ -103,6 +170,7 @@ typedef enum
 #define TRDP_PULL_SUB           0x10u       /**< if set, its a PULL subscription                        */
 #define TRDP_REDUNDANT          0x20u       /**< if set, packet should not be sent (redundant)          */
 #define TRDP_CHECK_COMID        0x40u       /**< if set, do filter comId (addListener)                  */
+#define TRDP_PHASED             0x80u       /**< if set, the publisher has a given phase                */
 
 typedef UINT8   TRDP_PRIV_FLAGS_T;
 
@@ -132,6 +200,14 @@ typedef struct
     UINT32          lastSeqCnt;                         /**< Sequence counter value for comId           */
     TRDP_IP_ADDR_T  srcIpAddr;                          /**< Source IP address                          */
     TRDP_MSG_T      msgType;                            /**< message type                               */
+    UINT32          window;                             /**< bit n: lastSeqCnt - n received, 0 = restart */
+    UINT32          lost;                               /**< bit n: lastSeqCnt - n counted as lost      */
+    UINT32          numRcv;                             /**< accepted packets                           */
+    UINT32          numLost;                            /**< missing sequence counters                  */
+    UINT32          numBursts;                          /**< gaps of one or more missing packets        */
+    UINT32          maxBurst;                           /**< longest gap                                */
+    UINT32          numReordered;                       /**< late packets counted as lost before        */
+    UINT32          numDuplicate;                       /**< packets received twice                     */
 } TRDP_SEQ_CNT_ENTRY_T;
 
 typedef struct
@@ -167,6 +243,15 @@ typedef struct TRDP_SOCKETS
     TRDP_IP_ADDR_T      mcGroups[VOS_MAX_MULTICAST_CNT]; /**< List of multicast addresses for this socket */
 } TRDP_SOCKETS_T;
 
+/** Execution time of the callbacks of one publisher, subscription or listener */
+typedef struct
+{
+    UINT32          numCalls;                   /**< number of callbacks                                    */
+    UINT32          numSlow;                    /**< number of callbacks above the callback threshold       */
+    UINT32          maxTime;                    /**< longest execution time in ns                           */
+    UINT64          totalTime;                  /**< sum of all execution times in ns                       */
+} TRDP_CB_STATS_T;
+
 #if (defined (WIN32) || defined (WIN64))
 #pragma pack(push, 1)
 #endif
@@ -229,6 +314,7 @@ typedef struct
 typedef struct PD_ELE
 {
     struct PD_ELE       *pNext;                 /**< pointer to next element or NULL                        */
+    struct PD_ELE       *pNextDue;              /**< send pass: next due packet of the same QoS class       */
     UINT32              magic;                  /**< prevent acces through dangeling pointer                */
     TRDP_ADDRESSES_T    addr;                   /**< handle of publisher/subscriber                         */
     TRDP_IP_ADDR_T      lastSrcIP;              /**< last source IP a subscribed packet was received from   */
@@ -237,6 +323,8 @@ typedef struct PD_ELE
     UINT32              curSeqCnt;              /**< the last sent or received sequence counter             */
     UINT32              curSeqCnt4Pull;         /**< the last sent sequence counter for PULL                */
     TRDP_SEQ_CNT_LIST_T*pSeqCntList;            /**< pointer to list of received sequence numbers per comId */
+    struct TRDP_LAT_STATS *pLatency;            /**< latency histograms, allocated on first sample          */
+    VOS_TIME_NS_T       putTime;                /**< time of the last tlp_put() not yet sent (latency)      */
     UINT32              numRxTx;                /**< Counter for received packets (statistics)              */
     UINT32              updPkts;                /**< Counter for updated packets (statistics)               */
     UINT32              getPkts;                /**< Counter for read packets (statistics)                  */
@@ -244,9 +332,9 @@ typedef struct PD_ELE
     TRDP_ERR_T          lastErr;                /**< Last error (timeout)                                   */
     TRDP_PRIV_FLAGS_T   privFlags;              /**< private flags                                          */
     TRDP_FLAGS_T        pktFlags;               /**< flags                                                  */
-    TRDP_TIME_T         interval;               /**< time out value for received packets or
-                                                     interval for packets to send (set from ms)             */
-    TRDP_TIME_T         timeToGo;               /**< next time this packet must be sent/rcv                 */
+    VOS_TIME_NS_T       interval;               /**< time out value for received packets or
+                                                     interval for packets to send (ns, 0 = PULL only)       */
+    VOS_TIME_NS_T       timeToGo;               /**< next time this packet must be sent/rcv (ns)            */
     TRDP_TO_BEHAVIOR_T  toBehavior;             /**< timeout behavior for packets                           */
     UINT32              dataSize;               /**< net data size                                          */
     UINT32              grossSize;              /**< complete packet size (header, data)                    */
@@ -255,9 +343,93 @@ typedef struct PD_ELE
     INT32               socketIdx;              /**< index into the socket list                             */
     const void          *pUserRef;              /**< from subscribe()                                       */
     TRDP_PD_CALLBACK_T  pfCbFunction;           /**< Pointer to PD callback function                        */
+    TRDP_CB_STATS_T     cbStats;                /**< execution time of pfCbFunction                         */
+    UINT32              phase;                  /**< send offset in us after cycle epoch + k * interval     */
+    UINT8               qos;                    /**< QoS class, higher values are sent first                */
+    UINT32              shapingOffset;          /**< traffic shaping: send slot within period               */
+    UINT32              shapingPeriod;          /**< traffic shaping: period in slots, 0 = not shaped       */
+    UINT32              shapedSize;             /**< traffic shaping: bytes accounted in the slot table     */
+    UINT64              committedRate;          /**< admission: bit/s accounted in admission.pdRate         */
     PD_PACKET_T         *pFrame;                /**< header ... data + FCS...                               */
 } PD_ELE_T, *TRDP_PUB_PT, *TRDP_SUB_PT;
 
+/** Latency histograms of a PD element (TRDP_OPTION_LATENCY_STATS) */
+typedef struct TRDP_LAT_STATS
+{
+    TRDP_LAT_HIST_T stack;                      /**< put -> sent, socket ready -> callback                  */
+    TRDP_LAT_HIST_T callback;                   /**< callback execution time                                */
+} TRDP_LAT_STATS_T;
+
+/** Byte budget of the PD send passes */
+typedef struct
+{
+    UINT32          bytes;                      /**< bytes to send per window, 0 = no budget                */
+    UINT32          window;                     /**< window length in us, aligned to the cycle epoch        */
+    UINT8           minQos;                     /**< packets with this QoS or higher are never deferred     */
+    BOOL8           exhausted;                  /**< lower QoS packets were deferred in this window         */
+    UINT32          used;                       /**< bytes sent in the current window                       */
+    VOS_TIME_NS_T   windowEnd;                  /**< end of the current window                              */
+    UINT32          numDeferred;                /**< number of deferred packets (statistics)                */
+} TRDP_SEND_BUDGET_T;
+
+/** Admission control of cyclic PD and rate limit of MD */
+typedef struct
+{
+    UINT32          pdLimit;                    /**< max. committed PD bit rate per interface, 0 = no limit */
+    BOOL8           pdReject;                   /**< reject publishers above the limit, else warn only      */
+    UINT32          mdRate;                     /**< MD token rate in bytes/s, 0 = no limit                 */
+    UINT32          mdDepth;                    /**< MD bucket depth (max. burst) in bytes                  */
+    INT64           mdCredit;                   /**< available MD bytes, negative after an oversized message */
+    VOS_TIME_NS_T   mdLastFill;                 /**< time the bucket was last refilled                      */
+    VOS_TIME_NS_T   mdWakeUp;                   /**< time a deferred MD can be sent, 0 = none deferred      */
+    UINT32          numRejected;                /**< number of rejected publishers (statistics)             */
+    UINT32          numMdDeferred;              /**< number of deferred MD sends (statistics)               */
+    UINT64          pdRate[VOS_MAX_SOCKET_CNT]; /**< committed PD bit rate per send socket (iface index)    */
+} TRDP_ADMISSION_T;
+
+/** Metrics HTTP endpoint (tlc_setMetricsPort), one client connection at a time */
+typedef struct
+{
+    SOCKET          listenSock;                 /**< listening socket, VOS_INVALID_SOCKET if off            */
+    SOCKET          clientSock;                 /**< accepted connection waiting for its request            */
+    VOS_TIME_NS_T   clientTimeout;              /**< connection is dropped if the request is incomplete     */
+    UINT32          reqLen;                     /**< bytes of the request kept in 'request'                 */
+    CHAR8           request[TRDP_METRICS_REQ_SIZE];     /**< start of the request (request line)            */
+    CHAR8           reqTail[4];                 /**< last four bytes received (end of header detection)     */
+    UINT32          numScrapes;                 /**< number of requests served                              */
+    CHAR8           *pResponse;                 /**< response rendered or sent, NULL while reading a request */
+    UINT32          respSize;                   /**< size of the response buffer                            */
+    UINT32          respStart;                  /**< offset of the HTTP header in the buffer                */
+    UINT32          respLen;                    /**< end of the response in the buffer                      */
+    UINT32          sent;                       /**< offset of the first byte not sent yet                  */
+    UINT32          family;                     /**< next metric family to render                           */
+    UINT32          element;                    /**< next publisher / subscription of that family           */
+    UINT32          status;                     /**< HTTP status of the response                            */
+    VOS_TIME_NS_T   nextTry;                    /**< time of the next pass needed for the response          */
+} TRDP_METRICS_T;
+
+/** Stage timing of tlc_process() and budget supervision (tlc_setProcessTiming) */
+typedef struct TRDP_PROC_TIMING
+{
+    TRDP_PROCESS_STATISTICS_T   stats;          /**< histograms and overruns returned to the application    */
+    UINT32                      stage;          /**< running stage, TRDP_PROC_STAGES outside of a pass      */
+    VOS_TIME_NS_T               passStart;      /**< start of the running pass                              */
+    VOS_TIME_NS_T               stageStart;     /**< start of the running stage                             */
+    UINT32                      slowStage;      /**< stage taking the most time in the running pass         */
+    VOS_TIME_NS_T               slowTime;       /**< time of that stage                                     */
+    UINT32                      passMax;        /**< longest pass in ns since the last history sample       */
+} TRDP_PROC_TIMING_T;
+
+/** Traffic shaping slot table of one interface */
+typedef struct
+{
+    TRDP_IP_ADDR_T  ifAddr;                     /**< interface (bind address) the table is valid for        */
+    UINT32          noOfSlots;                  /**< hyperperiod in slots, 0 = table unused                 */
+    UINT32          noOfPub;                    /**< number of publishers placed in this table              */
+    UINT32          maxBurst;                   /**< worst case load of a single slot in bytes              */
+    UINT32          *pSlotLoad;                 /**< bytes to be sent per slot (noOfSlots entries)          */
+} TRDP_SHAPING_T;
+
 #if MD_SUPPORT
 /** Queue element for MD listeners (UDP and TCP)   */
 typedef struct MD_LIS_ELE
@@ -272,6 +444,7 @@ typedef struct MD_LIS_ELE
     INT32               socketIdx;              /**< index into the socket list                             */
     TRDP_MD_CALLBACK_T  pfCbFunction;           /**< Pointer to MD callback function                        */
     UINT32              numSessions;            /**< Number of received packets of all sessions             */
+    TRDP_CB_STATS_T     cbStats;                /**< execution time of pfCbFunction                         */
 } MD_LIS_ELE_T;
 
 /** Tcp connection parameters    */
@@ -314,6 +487,7 @@ typedef struct MD_ELE
     TRDP_URI_USER_T     srcURI;                 /**< incoming MD source URI for reply                       */
     TRDP_MD_TCP_T       tcpParameters;          /**< Tcp connection parameters                              */
     TRDP_MD_CALLBACK_T  pfCbFunction;           /**< Pointer to MD callback function                        */
+    MD_LIS_ELE_T        *pListener;             /**< listener accepting this session, NULL for callers      */
     MD_PACKET_T         *pPacket;               /**< Packet header in network byte order                    */
                                                 /**< data ready to be sent (with CRCs)                      */
 } MD_ELE_T;
@@ -328,6 +502,7 @@ typedef struct
 #endif
 
 struct TAU_TTDB;
+struct TRDP_TRACE;
 
 /** Session/application variables store */
 typedef struct TRDP_SESSION
@@ -338,7 +513,7 @@ typedef struct TRDP_SESSION
     TRDP_IP_ADDR_T          virtualIP;          /**< Virtual IP address                                     */
     UINT32                  etbTopoCnt;         /**< current valid topocount or zero                        */
     UINT32                  opTrnTopoCnt;       /**< current valid topocount or zero                        */
-    TRDP_TIME_T             nextJob;            /**< Store for next select interval                         */
+    VOS_TIME_NS_T           nextJob;            /**< Store for next select interval (absolute, ns)          */
     TRDP_PRINT_DBG_T        pPrintDebugString;  /**< Pointer to function to print debug information         */
     TRDP_MARSHALL_CONFIG_T  marshall;           /**< Marshalling(unMarshalling configuration                */
     TRDP_PD_CONFIG_T        pdDefault;          /**< Default configuration for process data                 */
@@ -350,6 +525,17 @@ typedef struct TRDP_SESSION
     PD_PACKET_T             *pNewFrame;         /**< pointer to received PD frame                           */
     TRDP_TIME_T             initTime;           /**< initialization time of session                         */
     TRDP_STATISTICS_T       stats;              /**< statistics of this session                             */
+    VOS_TIME_NS_T           cycleEpoch;         /**< time base of phased publishers and slot 0 of shaping   */
+    TRDP_SHAPING_T          shaping[TRDP_SHAPING_MAX_IF];   /**< traffic shaping slot tables per interface  */
+    VOS_TIME_NS_T           preciseDeadline;    /**< absolute due time of next job (precise wait option)    */
+    TRDP_SEND_BUDGET_T      sendBudget;         /**< byte budget per window for low priority PD             */
+    TRDP_ADMISSION_T        admission;          /**< PD bit rate limit per interface, MD token bucket       */
+    struct TRDP_TRACE       *pTrace;            /**< event trace ring, NULL if tracing is off               */
+    UINT32                  traceUsers;         /**< tlc_dumpTraceFd() calls reading pTrace without the lock */
+    TRDP_METRICS_T          metrics;            /**< OpenMetrics HTTP endpoint                              */
+    TRDP_PROC_TIMING_T      *pTiming;           /**< stage timing of tlc_process, NULL if off               */
+    UINT32                  cbThreshold;        /**< callbacks taking longer (us) are counted as slow       */
+    struct TRDP_HISTORY     *pHistory;          /**< statistics history in shared memory, NULL if off       */
 #if MD_SUPPORT
     struct TAU_TTDB         *pTTDB;             /**< session related TTDB data                              */
     void                    *pUser;             /**< space for higher layer data                            */
@@ -360,6 +546,7 @@ typedef struct TRDP_SESSION
     MD_ELE_T                *pMDRcvQueue;       /**< pointer to first element of recv MD queue (replier)    */
     MD_ELE_T                *pMDRcvEle;         /**< pointer to received MD element                         */
     MD_ELE_T                *uncompletedTCP[VOS_MAX_SOCKET_CNT];     /**< uncompleted TCP messages buffer   */
+    TRDP_CB_STATS_T         mdCallerCb;         /**< execution time of callbacks of sessions without listener */
 #endif
 } TRDP_SESSION_T, *TRDP_SESSION_PT;
 
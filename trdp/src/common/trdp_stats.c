@@ -16,6 +16,17 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: trdp_pdPrepareListStats(): lists on the non-standard TRDP_SUBS_LIST_COMID, TRDP_PUB_LIST_COMID
+ *      BL 2026-10-17: Longest pass since the last history sample kept for the statistics history
+ *      BL 2026-10-17: trdp_pdPrepareListStats(): subscription and publisher lists on statistics pull
+ *      BL 2026-10-17: tlc_getSourceStatistics(): sequence analysis per sender of a subscription
+ *      BL 2026-10-17: Callback accounting: trdp_cbAccount(), tlc_setCallbackThreshold(), tlc_getCallbackStatistics()
+ *      BL 2026-10-17: Stage timing of tlc_process(): tlc_setProcessTiming(), tlc_getProcessStatistics()
+ *      BL 2026-10-17: Counters maintained incrementally, statistics copied under the session lock, tlc_getStatisticsSnapshot()
+ *      BL 2026-10-17: trdp_latBucketLimit() for the metrics exporter
+ *      BL 2026-10-17: Latency histograms: trdp_pdRecordLatency(), tlc_getLatencyStatistics()
+ *      BL 2026-10-17: PD interval is kept in ns
+ *      BL 2026-10-17: tlc_getShapingStatistics() added
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
  *      BL 2017-11-17: superfluous session->redID replaced by sndQueue->redId
  *      BL 2017-05-22: Ticket #122: Addendum for 64Bit compatibility (VOS_TIME_T -> VOS_TIMEVAL_T)
@@ -38,6 +49,7 @@
 #include "trdp_if.h"
 #include "trdp_private.h"
 #include "trdp_pdcom.h"
+#include "trdp_utils.h"
 #include "vos_mem.h"
 #include "vos_thread.h"
 
@@ -54,6 +66,97 @@
  */
 
 void trdp_UpdateStats (TRDP_APP_SESSION_T appHandle);
+static TRDP_ERR_T   trdp_copySubsStats (TRDP_APP_SESSION_T appHandle, UINT16 *pNumSubs,
+                                        TRDP_SUBS_STATISTICS_T *pStatistics);
+static TRDP_ERR_T   trdp_copyPubStats (TRDP_APP_SESSION_T appHandle, UINT16 *pNumPub,
+                                       TRDP_PUB_STATISTICS_T *pStatistics);
+static UINT32       trdp_latBucket (UINT32 value);
+static void         trdp_latAdd (TRDP_LAT_HIST_T *pHist, VOS_TIME_NS_T latency);
+static void         trdp_getCbStats (TRDP_CB_STATS_T *pCbStats, UINT32 comId, TRDP_IP_ADDR_T addr, UINT32 owner,
+                                     TRDP_CALLBACK_STATISTICS_T *pStatistics, BOOL8 reset);
+
+/**********************************************************************************************************************/
+/** Copy the subscription statistics. Must be called with the session locked.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  pNumSubs            In: The number of subscriptions requested
+ *                                      Out: Number of subscriptions returned
+ *  @param[out]     pStatistics         Pointer to an array with the subscription statistics information
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        there are more subscriptions than requested
+ */
+static TRDP_ERR_T trdp_copySubsStats (
+    TRDP_APP_SESSION_T      appHandle,
+    UINT16                  *pNumSubs,
+    TRDP_SUBS_STATISTICS_T  *pStatistics)
+{
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+    PD_ELE_T    *iter;
+    UINT16      lIndex;
+
+    /*  Loop over our subscriptions, but do not exceed user supplied buffers!    */
+    for (lIndex = 0, iter = appHandle->pRcvQueue; lIndex < *pNumSubs && iter != NULL; lIndex++, iter = iter->pNext)
+    {
+        pStatistics[lIndex].comId       = iter->addr.comId;     /* Subscribed ComId            */
+        pStatistics[lIndex].joinedAddr  = iter->addr.mcGroup;   /* Joined IP address           */
+        pStatistics[lIndex].filterAddr  = iter->addr.srcIpAddr; /* Filter IP address           */
+        pStatistics[lIndex].callBack    = (iter->pfCbFunction == NULL)? 0 : 1;      /* > 0 if call back function is used */
+        pStatistics[lIndex].userRef     = (iter->pUserRef == NULL) ? 0 : 1;         /* > 0 if user reference if used  */
+        pStatistics[lIndex].timeout     = (UINT32) (iter->interval / 1000);
+        /* Time-out value in us. 0 = No time-out supervision  */
+        pStatistics[lIndex].toBehav     = iter->toBehavior;     /* Behavior at time-out    */
+        pStatistics[lIndex].numRecv     = iter->numRxTx;        /* Number of packets received for this subscription.  */
+        pStatistics[lIndex].numMissed   = iter->numMissed;      /* Number of packets received for this subscription.  */
+        pStatistics[lIndex].status      = iter->lastErr;        /* Receive status information  */
+    }
+    if (lIndex >= *pNumSubs && iter != NULL)
+    {
+        err = TRDP_MEM_ERR;
+    }
+    *pNumSubs = lIndex;
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Copy the publisher statistics. Must be called with the session locked.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  pNumPub             Pointer to the number of publishers
+ *  @param[out]     pStatistics         Pointer to a list with the publish statistics information
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_MEM_ERR        there are more publishers than requested
+ */
+static TRDP_ERR_T trdp_copyPubStats (
+    TRDP_APP_SESSION_T      appHandle,
+    UINT16                  *pNumPub,
+    TRDP_PUB_STATISTICS_T   *pStatistics)
+{
+    TRDP_ERR_T  err = TRDP_NO_ERR;
+    PD_ELE_T    *iter;
+    UINT16      lIndex;
+
+    /*  Loop over our publishers, but do not exceed user supplied buffers!    */
+    for (lIndex = 0, iter = appHandle->pSndQueue; lIndex < *pNumPub && iter != NULL; lIndex++, iter = iter->pNext)
+    {
+        pStatistics[lIndex].comId       = iter->addr.comId;         /* Published ComId                                */
+        pStatistics[lIndex].destAddr    = iter->addr.destIpAddr;    /* IP address of destination for this publishing. */
+        pStatistics[lIndex].redId       = iter->redId;              /* Redundancy group id                            */
+        pStatistics[lIndex].redState    = (iter->privFlags & TRDP_REDUNDANT) ? 1 : 0; /* Redundancy state:
+                                                                                        1 = Follower
+                                                                                        0 = Leader                  */
+
+        pStatistics[lIndex].cycle = (UINT32) (iter->interval / 1000);
+        /* Interval/cycle in us. 0 = No time-out supervision */
+        pStatistics[lIndex].numSend = iter->numRxTx;            /* Number of packets sent for this publisher.       */
+        pStatistics[lIndex].numPut  = iter->updPkts;            /* Updated packets (via put)                        */
+    }
+    if (lIndex >= *pNumPub && iter != NULL)
+    {
+        err = TRDP_MEM_ERR;
+    }
+    *pNumPub = lIndex;
+    return err;
+}
 
 /******************************************************************************
  *   Globals
@@ -70,187 +173,1034 @@ void trdp_initStats (
 {
     const TRDP_VERSION_T *pVersion;
 
-    if (appHandle == NULL)
+    if (appHandle == NULL)
+    {
+        return;
+    }
+
+    memset(&appHandle->stats, 0, sizeof(TRDP_STATISTICS_T));
+
+    pVersion = tlc_getVersion();
+    appHandle->stats.version = (UINT32) pVersion->ver << 24 | (UINT32) pVersion->rel << 16 |
+        (UINT32) pVersion->upd << 8  | pVersion->evo;
+
+    if (appHandle->stats.hostName[0] == 0)
+    {
+        vos_strncpy(appHandle->stats.hostName, "unknown", TRDP_MAX_LABEL_LEN - 1);      /**< host name */
+    }
+    if (appHandle->stats.leaderName[0] == 0)
+    {
+        vos_strncpy(appHandle->stats.leaderName, "unknown", TRDP_MAX_LABEL_LEN - 1);    /**< leader host name */
+    }
+}
+
+/**********************************************************************************************************************/
+/** Reset statistics.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ */
+EXT_DECL TRDP_ERR_T tlc_resetStatistics (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TRDP_STATISTICS_T previous;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    previous = appHandle->stats;
+    memset(&appHandle->stats, 0, sizeof(TRDP_STATISTICS_T));
+
+    /*  Keep the uptime and the numbers maintained on (un)publish, (un)subscribe, join and (de)registration   */
+    appHandle->stats.upTime         = previous.upTime;
+    appHandle->stats.numJoin        = previous.numJoin;
+    appHandle->stats.pd.numSubs     = previous.pd.numSubs;
+    appHandle->stats.pd.numPub      = previous.pd.numPub;
+    appHandle->stats.udpMd.numList  = previous.udpMd.numList;
+    appHandle->stats.tcpMd.numList  = previous.tcpMd.numList;
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Return statistics.
+ *  Memory for statistics information must be provided by the user.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pStatistics         Pointer to statistics for this application session
+ *  @retval         TRDP_NO_ERR            no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ */
+EXT_DECL TRDP_ERR_T tlc_getStatistics (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_STATISTICS_T   *pStatistics)
+{
+    if (pStatistics == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    trdp_UpdateStats(appHandle);
+
+    *pStatistics = appHandle->stats;
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Return a consistent snapshot of the session, subscription and publisher statistics.
+ *  All values are copied in one pass while the session is locked.
+ *  Memory for statistics information must be provided by the user.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pStatistics         Pointer to statistics for this application session
+ *  @param[in,out]  pNumSubs            In: The number of subscriptions requested, NULL: none
+ *                                      Out: Number of subscriptions returned
+ *  @param[out]     pSubsStatistics     Pointer to an array with the subscription statistics information
+ *  @param[in,out]  pNumPub             In: The number of publishers requested, NULL: none
+ *                                      Out: Number of publishers returned
+ *  @param[out]     pPubStatistics      Pointer to an array with the publish statistics information
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        there are more subscriptions or publishers than requested
+ */
+EXT_DECL TRDP_ERR_T tlc_getStatisticsSnapshot (
+    TRDP_APP_SESSION_T      appHandle,
+    TRDP_STATISTICS_T       *pStatistics,
+    UINT16                  *pNumSubs,
+    TRDP_SUBS_STATISTICS_T  *pSubsStatistics,
+    UINT16                  *pNumPub,
+    TRDP_PUB_STATISTICS_T   *pPubStatistics)
+{
+    TRDP_ERR_T err = TRDP_NO_ERR;
+
+    if ((pStatistics == NULL) ||
+        ((pNumSubs != NULL) && (pSubsStatistics == NULL)) ||
+        ((pNumPub != NULL) && (pPubStatistics == NULL)))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    trdp_UpdateStats(appHandle);
+
+    *pStatistics = appHandle->stats;
+
+    if ((pNumSubs != NULL) && (trdp_copySubsStats(appHandle, pNumSubs, pSubsStatistics) != TRDP_NO_ERR))
+    {
+        err = TRDP_MEM_ERR;
+    }
+    if ((pNumPub != NULL) && (trdp_copyPubStats(appHandle, pNumPub, pPubStatistics) != TRDP_NO_ERR))
+    {
+        err = TRDP_MEM_ERR;
+    }
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Return PD subscription statistics.
+ *  Memory for statistics information must be provided by the user.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  pNumSubs            In: The number of subscriptions requested
+ *                                      Out: Number of subscriptions returned
+ *  @param[in,out]  pStatistics         Pointer to an array with the subscription statistics information
+ *  @retval         TRDP_NO_ERR            no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        there are more subscriptions than requested
+ */
+EXT_DECL TRDP_ERR_T tlc_getSubsStatistics (
+    TRDP_APP_SESSION_T      appHandle,
+    UINT16                  *pNumSubs,
+    TRDP_SUBS_STATISTICS_T  *pStatistics)
+{
+    TRDP_ERR_T err;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (pNumSubs == NULL || pStatistics == NULL || *pNumSubs == 0)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    err = trdp_copySubsStats(appHandle, pNumSubs, pStatistics);
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Return PD publish statistics.
+ *  Memory for statistics information must be provided by the user.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  pNumPub             Pointer to the number of publishers
+ *  @param[out]     pStatistics         Pointer to a list with the publish statistics information
+ *  @retval         TRDP_NO_ERR            no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR     there are more subscriptions than requested
+ */
+EXT_DECL TRDP_ERR_T tlc_getPubStatistics (
+    TRDP_APP_SESSION_T      appHandle,
+    UINT16                  *pNumPub,
+    TRDP_PUB_STATISTICS_T   *pStatistics)
+{
+    TRDP_ERR_T err;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (pNumPub == NULL || pStatistics == NULL || *pNumPub == 0)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    err = trdp_copyPubStats(appHandle, pNumPub, pStatistics);
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Return the sequence counter analysis of each sender of a subscription.
+ *  Memory for statistics information must be provided by the user.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           the handle returned by tlp_subscribe
+ *  @param[in,out]  pNumSrc             In: number of entries provided, Out: number of senders returned
+ *  @param[out]     pStatistics         Pointer to a list with the statistics per sender
+ *  @param[in]      reset               TRUE: clear the returned counters (the receive window is kept)
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_NOSUB_ERR      subscription handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        there are more senders than requested
+ */
+EXT_DECL TRDP_ERR_T tlc_getSourceStatistics (
+    TRDP_APP_SESSION_T          appHandle,
+    TRDP_SUB_T                  subHandle,
+    UINT16                      *pNumSrc,
+    TRDP_SOURCE_STATISTICS_T    *pStatistics,
+    BOOL8                       reset)
+{
+    TRDP_ERR_T              err     = TRDP_NO_ERR;
+    TRDP_SEQ_CNT_ENTRY_T    *pEntry;
+    UINT16                  lIndex  = 0u;
+    UINT64                  total;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if ((subHandle == NULL) || (subHandle->magic != TRDP_MAGIC_SUB_HNDL_VALUE))
+    {
+        return TRDP_NOSUB_ERR;
+    }
+
+    if (pNumSrc == NULL || pStatistics == NULL || *pNumSrc == 0)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (subHandle->pSeqCntList != NULL)
+    {
+        for (; lIndex < subHandle->pSeqCntList->curNoOfEntries; lIndex++)
+        {
+            if (lIndex >= *pNumSrc)
+            {
+                err = TRDP_MEM_ERR;
+                break;
+            }
+            pEntry = &subHandle->pSeqCntList->seq[lIndex];
+            total  = (UINT64) pEntry->numRcv + pEntry->numLost;
+            pStatistics[lIndex].srcIpAddr       = pEntry->srcIpAddr;
+            pStatistics[lIndex].msgType         = pEntry->msgType;
+            pStatistics[lIndex].lastSeqCnt      = pEntry->lastSeqCnt;
+            pStatistics[lIndex].numRcv          = pEntry->numRcv;
+            pStatistics[lIndex].numLost         = pEntry->numLost;
+            pStatistics[lIndex].lossRate        = (total == 0u) ? 0u :
+                                                  (UINT32) (((UINT64) pEntry->numLost * 1000000u) / total);
+            pStatistics[lIndex].numBursts       = pEntry->numBursts;
+            pStatistics[lIndex].maxBurst        = pEntry->maxBurst;
+            pStatistics[lIndex].numReordered    = pEntry->numReordered;
+            pStatistics[lIndex].numDuplicate    = pEntry->numDuplicate;
+            if (reset == TRUE)
+            {
+                pEntry->numRcv          = 0u;
+                pEntry->numLost         = 0u;
+                pEntry->numBursts       = 0u;
+                pEntry->maxBurst        = 0u;
+                pEntry->numReordered    = 0u;
+                pEntry->numDuplicate    = 0u;
+            }
+        }
+    }
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    *pNumSrc = lIndex;
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Return traffic shaping information per interface.
+ *  Memory for statistics information must be provided by the user.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  pNumIf              Pointer to the number of interfaces
+ *  @param[out]     pStatistics         Pointer to a list with the traffic shaping information
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_MEM_ERR        there are more interfaces than requested
+ */
+EXT_DECL TRDP_ERR_T tlc_getShapingStatistics (
+    TRDP_APP_SESSION_T          appHandle,
+    UINT16                      *pNumIf,
+    TRDP_SHAPING_STATISTICS_T   *pStatistics)
+{
+    TRDP_ERR_T  err     = TRDP_NO_ERR;
+    UINT16      lIndex  = 0u;
+    UINT32      idx;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (pNumIf == NULL || pStatistics == NULL || *pNumIf == 0)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    for (idx = 0u; idx < TRDP_SHAPING_MAX_IF; idx++)
+    {
+        if (appHandle->shaping[idx].noOfSlots == 0u)
+        {
+            continue;
+        }
+        if (lIndex >= *pNumIf)
+        {
+            err = TRDP_MEM_ERR;
+            break;
+        }
+        pStatistics[lIndex].ifAddr      = appHandle->shaping[idx].ifAddr;
+        pStatistics[lIndex].slotTime    = TRDP_SHAPING_SLOT_TIME;
+        pStatistics[lIndex].noOfSlots   = appHandle->shaping[idx].noOfSlots;
+        pStatistics[lIndex].numPub      = appHandle->shaping[idx].noOfPub;
+        pStatistics[lIndex].maxBurst    = appHandle->shaping[idx].maxBurst;
+        lIndex++;
+    }
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    *pNumIf = lIndex;
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Histogram bucket of a latency value (see TRDP_LAT_HIST_T)
+ *
+ *  @param[in]      value           latency in ns
+ *
+ *  @retval         bucket index
+ */
+static UINT32 trdp_latBucket (
+    UINT32 value)
+{
+    UINT32 msb = 31u;
+
+    if (value < 4u)
+    {
+        return value;
+    }
+    while ((value & (1u << msb)) == 0u)
+    {
+        msb--;
+    }
+    return 4u * (msb - 1u) + ((value >> (msb - 2u)) & 3u);
+}
+
+/**********************************************************************************************************************/
+/** Largest latency value counted in a histogram bucket (see TRDP_LAT_HIST_T)
+ *
+ *  @param[in]      idx             bucket index (< TRDP_LAT_BUCKETS)
+ *
+ *  @retval         upper bound in ns
+ */
+UINT32 trdp_latBucketLimit (
+    UINT32 idx)
+{
+    if (idx < 4u)
+    {
+        return idx;
+    }
+    return (UINT32) ((((UINT64) (idx % 4u) + 5u) << (idx / 4u - 1u)) - 1u);
+}
+
+/**********************************************************************************************************************/
+/** Add a sample to a latency histogram
+ *
+ *  @param[in,out]  pHist           histogram
+ *  @param[in]      latency         sample in ns
+ */
+static void trdp_latAdd (
+    TRDP_LAT_HIST_T *pHist,
+    VOS_TIME_NS_T   latency)
+{
+    UINT32 value = (latency < 0) ? 0u : ((latency > (VOS_TIME_NS_T) 0xFFFFFFFFu) ? 0xFFFFFFFFu : (UINT32) latency);
+
+    if ((pHist->count == 0u) || (value < pHist->min))
+    {
+        pHist->min = value;
+    }
+    if (value > pHist->max)
+    {
+        pHist->max = value;
+    }
+    pHist->count++;
+    pHist->sum += value;
+    pHist->bucket[trdp_latBucket(value)]++;
+}
+
+/**********************************************************************************************************************/
+/** Record a latency sample of a publisher or subscription.
+ *  The histograms are allocated with the first sample.
+ *
+ *  @param[in]      pPacket         publisher or subscription
+ *  @param[in]      callback        TRUE: callback execution time, FALSE: time spent in the stack
+ *  @param[in]      latency         sample in ns
+ */
+void trdp_pdRecordLatency (
+    PD_ELE_T        *pPacket,
+    BOOL8           callback,
+    VOS_TIME_NS_T   latency)
+{
+    if (pPacket->pLatency == NULL)
+    {
+        pPacket->pLatency = (TRDP_LAT_STATS_T *) vos_memAlloc(sizeof(TRDP_LAT_STATS_T));
+        if (pPacket->pLatency == NULL)
+        {
+            return;
+        }
+    }
+    trdp_latAdd((callback == TRUE) ? &pPacket->pLatency->callback : &pPacket->pLatency->stack, latency);
+}
+
+/**********************************************************************************************************************/
+/** Enter the next stage of a tlc_process() pass.
+ *  The time since the previous call is added to the histogram of the stage left.
+ *  TRDP_STAGE_PASS ends the pass and checks it against the pass budget.
+ *
+ *  @param[in]      appHandle       session pointer (stage timing switched on)
+ *  @param[in]      stage           stage entered, TRDP_STAGE_PASS at the end of the pass
+ */
+void trdp_procStage (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PROC_STAGE_T   stage)
+{
+    TRDP_PROC_TIMING_T  *pTiming    = appHandle->pTiming;
+    VOS_TIME_NS_T       now         = vos_getTimeNs();
+    VOS_TIME_NS_T       passTime;
+
+    if (pTiming->stage < (UINT32) TRDP_STAGE_PASS)
+    {
+        VOS_TIME_NS_T stageTime = now - pTiming->stageStart;
+
+        trdp_latAdd(&pTiming->stats.stage[pTiming->stage], stageTime);
+        if (stageTime > pTiming->slowTime)
+        {
+            pTiming->slowStage  = pTiming->stage;
+            pTiming->slowTime   = stageTime;
+        }
+    }
+    else
+    {
+        /*  First stage of a new pass   */
+        pTiming->passStart  = now;
+        pTiming->slowStage  = (UINT32) stage;
+        pTiming->slowTime   = 0;
+    }
+
+    if (stage != TRDP_STAGE_PASS)
+    {
+        pTiming->stage      = (UINT32) stage;
+        pTiming->stageStart = now;
+        return;
+    }
+
+    /*  End of the pass */
+    pTiming->stage  = TRDP_PROC_STAGES;
+    passTime        = now - pTiming->passStart;
+    trdp_latAdd(&pTiming->stats.stage[TRDP_STAGE_PASS], passTime);
+    if (passTime > (VOS_TIME_NS_T) pTiming->passMax)
+    {
+        pTiming->passMax = (passTime > (VOS_TIME_NS_T) 0xFFFFFFFFu) ? 0xFFFFFFFFu : (UINT32) passTime;
+    }
+    if ((pTiming->stats.passBudget != 0u) &&
+        (passTime > (VOS_TIME_NS_T) pTiming->stats.passBudget * 1000))
+    {
+        pTiming->stats.numPassOverruns++;
+        pTiming->stats.overrunTime      = (UINT32) passTime;
+        pTiming->stats.overrunStage     = pTiming->slowStage;
+        pTiming->stats.overrunStageTime = (UINT32) pTiming->slowTime;
+        vos_printLog(VOS_LOG_WARNING, "tlc_process() took %u us (budget %u us), stage %u: %u us\n",
+                     (unsigned int) (passTime / 1000), (unsigned int) pTiming->stats.passBudget,
+                     (unsigned int) pTiming->slowStage, (unsigned int) (pTiming->slowTime / 1000));
+    }
+}
+
+/**********************************************************************************************************************/
+/** Check the execution time of a callback against the callback budget.
+ *
+ *  @param[in]      appHandle       session pointer (stage timing switched on)
+ *  @param[in]      comId           ComId of the publisher, subscription or MD element
+ *  @param[in]      duration        execution time of the callback in ns
+ */
+void trdp_procCallback (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              comId,
+    VOS_TIME_NS_T       duration)
+{
+    TRDP_PROC_TIMING_T *pTiming = appHandle->pTiming;
+
+    if ((pTiming->stats.callbackBudget != 0u) &&
+        (duration > (VOS_TIME_NS_T) pTiming->stats.callbackBudget * 1000))
+    {
+        pTiming->stats.numCallbackOverruns++;
+        pTiming->stats.callbackComId    = comId;
+        pTiming->stats.callbackStage    = pTiming->stage;
+        pTiming->stats.callbackTime     = (duration > (VOS_TIME_NS_T) 0xFFFFFFFFu) ? 0xFFFFFFFFu : (UINT32) duration;
+        vos_printLog(VOS_LOG_WARNING, "Callback for comId %u took %u us (budget %u us)\n",
+                     (unsigned int) comId, (unsigned int) (duration / 1000),
+                     (unsigned int) pTiming->stats.callbackBudget);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Account the execution time of a callback to its publisher, subscription or listener.
+ *  Callbacks above the session's callback threshold are counted as slow and logged.
+ *  Must be called with the session locked.
+ *
+ *  @param[in]      appHandle       session pointer
+ *  @param[in,out]  pCbStats        accounting of the element owning the callback
+ *  @param[in]      comId           ComId of the publisher, subscription or MD element
+ *  @param[in]      duration        execution time of the callback in ns
+ */
+void trdp_cbAccount (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_CB_STATS_T     *pCbStats,
+    UINT32              comId,
+    VOS_TIME_NS_T       duration)
+{
+    UINT32 value = (duration > (VOS_TIME_NS_T) 0xFFFFFFFFu) ? 0xFFFFFFFFu : (UINT32) duration;
+
+    pCbStats->numCalls++;
+    pCbStats->totalTime += value;
+    if (value > pCbStats->maxTime)
+    {
+        pCbStats->maxTime = value;
+    }
+    if ((appHandle->cbThreshold != 0u) &&
+        (duration > (VOS_TIME_NS_T) appHandle->cbThreshold * 1000))
+    {
+        pCbStats->numSlow++;
+        vos_printLog(VOS_LOG_WARNING, "Slow callback for comId %u: %u us (threshold %u us)\n",
+                     (unsigned int) comId, (unsigned int) (duration / 1000),
+                     (unsigned int) appHandle->cbThreshold);
+    }
+    TRDP_PROC_CALLBACK(appHandle, comId, duration);
+}
+
+/**********************************************************************************************************************/
+/** Set the threshold above which a callback is counted as slow.
+ *  The execution time of every timed PD and MD callback (TRDP_CB_TIMED) is accounted to its publisher,
+ *  subscription or listener, see tlc_getCallbackStatistics().
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      threshold           threshold in us, 0 = no slow callback detection
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_setCallbackThreshold (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              threshold)
+{
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    appHandle->cbThreshold = threshold;
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Switch the stage timing of tlc_process() on or off and set the budgets supervised.
+ *  Each stage of a pass is timed with the system clock and accumulated into a histogram.
+ *  A pass exceeding passBudget records the stage that took the most time, a callback exceeding callbackBudget
+ *  records its ComId and the calling stage. Switching on again keeps the accumulated values.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      enable              TRUE: time the stages, FALSE: switch off and discard the values
+ *  @param[in]      passBudget          budget of a pass in us, 0 = not supervised
+ *  @param[in]      callbackBudget      budget of a callback in us, 0 = not supervised
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      stage timing is not compiled in (TRDP_PROCESS_TIMING == 0)
+ *  @retval         TRDP_MEM_ERR        out of memory
+ */
+EXT_DECL TRDP_ERR_T tlc_setProcessTiming (
+    TRDP_APP_SESSION_T  appHandle,
+    BOOL8               enable,
+    UINT32              passBudget,
+    UINT32              callbackBudget)
+{
+    TRDP_ERR_T err = TRDP_NO_ERR;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+#if !TRDP_PROCESS_TIMING
+    if (enable == TRUE)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Stage timing not supported (TRDP_PROCESS_TIMING == 0)\n");
+        return TRDP_PARAM_ERR;
+    }
+#endif
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (enable == FALSE)
     {
-        return;
+        if (appHandle->pTiming != NULL)
+        {
+            vos_memFree(appHandle->pTiming);
+            appHandle->pTiming = NULL;
+        }
     }
-
-    memset(&appHandle->stats, 0, sizeof(TRDP_STATISTICS_T));
-
-    pVersion = tlc_getVersion();
-    appHandle->stats.version = (UINT32) pVersion->ver << 24 | (UINT32) pVersion->rel << 16 |
-        (UINT32) pVersion->upd << 8  | pVersion->evo;
-
-    if (appHandle->stats.hostName[0] == 0)
+    else
     {
-        vos_strncpy(appHandle->stats.hostName, "unknown", TRDP_MAX_LABEL_LEN - 1);      /**< host name */
+        if (appHandle->pTiming == NULL)
+        {
+            appHandle->pTiming = (TRDP_PROC_TIMING_T *) vos_memAlloc(sizeof(TRDP_PROC_TIMING_T));
+            if (appHandle->pTiming != NULL)
+            {
+                appHandle->pTiming->stage = TRDP_PROC_STAGES;
+            }
+        }
+        if (appHandle->pTiming == NULL)
+        {
+            err = TRDP_MEM_ERR;
+        }
+        else
+        {
+            appHandle->pTiming->stats.passBudget        = passBudget;
+            appHandle->pTiming->stats.callbackBudget    = callbackBudget;
+        }
     }
-    if (appHandle->stats.leaderName[0] == 0)
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
     {
-        vos_strncpy(appHandle->stats.leaderName, "unknown", TRDP_MAX_LABEL_LEN - 1);    /**< leader host name */
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
     }
+    return err;
 }
 
 /**********************************************************************************************************************/
-/** Reset statistics.
+/** Return the stage timing of tlc_process() and the budget overruns.
  *
  *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pStatistics         Pointer to the timing statistics
+ *  @param[in]      reset               TRUE: clear histograms and overruns after copying (budgets are kept)
+ *
  *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_NOINIT_ERR     handle invalid
- *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_PARAM_ERR      parameter error or stage timing is off
  */
-EXT_DECL TRDP_ERR_T tlc_resetStatistics (
-    TRDP_APP_SESSION_T appHandle)
+EXT_DECL TRDP_ERR_T tlc_getProcessStatistics (
+    TRDP_APP_SESSION_T          appHandle,
+    TRDP_PROCESS_STATISTICS_T   *pStatistics,
+    BOOL8                       reset)
 {
-    TIMEDATE32 tempTime;
+    TRDP_ERR_T err = TRDP_PARAM_ERR;
 
+    if (pStatistics == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
     if (!trdp_isValidSession(appHandle))
     {
         return TRDP_NOINIT_ERR;
     }
 
-    tempTime = appHandle->stats.upTime;
-    memset(&appHandle->stats, 0, sizeof(TRDP_STATISTICS_T));
-    appHandle->stats.upTime = tempTime;
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
 
-    return TRDP_NO_ERR;
+    if (appHandle->pTiming != NULL)
+    {
+        *pStatistics = appHandle->pTiming->stats;
+        if (reset == TRUE)
+        {
+            UINT32  passBudget      = appHandle->pTiming->stats.passBudget;
+            UINT32  callbackBudget  = appHandle->pTiming->stats.callbackBudget;
+
+            memset(&appHandle->pTiming->stats, 0, sizeof(TRDP_PROCESS_STATISTICS_T));
+            appHandle->pTiming->stats.passBudget        = passBudget;
+            appHandle->pTiming->stats.callbackBudget    = callbackBudget;
+        }
+        err = TRDP_NO_ERR;
+    }
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    return err;
 }
 
 /**********************************************************************************************************************/
-/** Return statistics.
- *  Memory for statistics information must be provided by the user.
+/** Copy the latency statistics of one element
  *
- *  @param[in]      appHandle           the handle returned by tlc_openSession
- *  @param[out]     pStatistics         Pointer to statistics for this application session
- *  @retval         TRDP_NO_ERR            no error
- *  @retval         TRDP_NOINIT_ERR     handle invalid
- *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @param[in,out]  pPacket         publisher or subscription
+ *  @param[in]      publisher       TRUE for publishers
+ *  @param[out]     pStatistics     entry to fill
+ *  @param[in]      reset           clear the histograms after copying
  */
-EXT_DECL TRDP_ERR_T tlc_getStatistics (
-    TRDP_APP_SESSION_T  appHandle,
-    TRDP_STATISTICS_T   *pStatistics)
+static void trdp_getLatency (
+    PD_ELE_T                    *pPacket,
+    BOOL8                       publisher,
+    TRDP_LATENCY_STATISTICS_T   *pStatistics,
+    BOOL8                       reset)
 {
-    if (pStatistics == NULL)
+    pStatistics->comId      = pPacket->addr.comId;
+    pStatistics->addr       = (publisher == TRUE) ? pPacket->addr.destIpAddr : pPacket->addr.mcGroup;
+    pStatistics->publisher  = publisher;
+    if (pPacket->pLatency == NULL)
     {
-        return TRDP_PARAM_ERR;
+        memset(&pStatistics->stack, 0, sizeof(TRDP_LAT_HIST_T));
+        memset(&pStatistics->callback, 0, sizeof(TRDP_LAT_HIST_T));
+        return;
     }
-    if (!trdp_isValidSession(appHandle))
+    pStatistics->stack      = pPacket->pLatency->stack;
+    pStatistics->callback   = pPacket->pLatency->callback;
+    if (reset == TRUE)
     {
-        return TRDP_NOINIT_ERR;
+        memset(pPacket->pLatency, 0, sizeof(TRDP_LAT_STATS_T));
     }
-
-    trdp_UpdateStats(appHandle);
-
-    *pStatistics = appHandle->stats;
-
-    return TRDP_NO_ERR;
 }
 
 /**********************************************************************************************************************/
-/** Return PD subscription statistics.
+/** Return latency histograms of publishers and subscriptions.
  *  Memory for statistics information must be provided by the user.
  *
  *  @param[in]      appHandle           the handle returned by tlc_openSession
- *  @param[in,out]  pNumSubs            In: The number of subscriptions requested
- *                                      Out: Number of subscriptions returned
- *  @param[in,out]  pStatistics         Pointer to an array with the subscription statistics information
- *  @retval         TRDP_NO_ERR            no error
+ *  @param[in,out]  pNum                Pointer to the number of entries
+ *  @param[out]     pStatistics         Pointer to a list with the latency statistics
+ *  @param[in]      reset               TRUE: clear the returned histograms
+ *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_NOINIT_ERR     handle invalid
  *  @retval         TRDP_PARAM_ERR      parameter error
- *  @retval         TRDP_MEM_ERR        there are more subscriptions than requested
+ *  @retval         TRDP_MEM_ERR        there are more entries than requested
  */
-EXT_DECL TRDP_ERR_T tlc_getSubsStatistics (
-    TRDP_APP_SESSION_T      appHandle,
-    UINT16                  *pNumSubs,
-    TRDP_SUBS_STATISTICS_T  *pStatistics)
+EXT_DECL TRDP_ERR_T tlc_getLatencyStatistics (
+    TRDP_APP_SESSION_T          appHandle,
+    UINT16                      *pNum,
+    TRDP_LATENCY_STATISTICS_T   *pStatistics,
+    BOOL8                       reset)
 {
-    TRDP_ERR_T  err = TRDP_NO_ERR;
+    TRDP_ERR_T  err     = TRDP_NO_ERR;
     PD_ELE_T    *iter;
-    UINT16      lIndex;
+    UINT16      lIndex  = 0u;
 
     if (!trdp_isValidSession(appHandle))
     {
         return TRDP_NOINIT_ERR;
     }
 
-    if (pNumSubs == NULL || pStatistics == NULL || *pNumSubs == 0)
+    if (pNum == NULL || pStatistics == NULL || *pNum == 0)
     {
         return TRDP_PARAM_ERR;
     }
-    /*  Loop over our subscriptions, but do not exceed user supplied buffers!    */
-    for (lIndex = 0, iter = appHandle->pRcvQueue; lIndex < *pNumSubs && iter != NULL; lIndex++, iter = iter->pNext)
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
     {
-        pStatistics[lIndex].comId       = iter->addr.comId;     /* Subscribed ComId            */
-        pStatistics[lIndex].joinedAddr  = iter->addr.mcGroup;   /* Joined IP address           */
-        pStatistics[lIndex].filterAddr  = iter->addr.srcIpAddr; /* Filter IP address           */
-        pStatistics[lIndex].callBack    = (iter->pfCbFunction == NULL)? 0 : 1;      /* > 0 if call back function is used */
-        pStatistics[lIndex].userRef     = (iter->pUserRef == NULL) ? 0 : 1;         /* > 0 if user reference if used  */
-        pStatistics[lIndex].timeout     = (UINT32) iter->interval.tv_usec + (UINT32) iter->interval.tv_sec * 1000000;
-        /* Time-out value in us. 0 = No time-out supervision  */
-        pStatistics[lIndex].toBehav     = iter->toBehavior;     /* Behavior at time-out    */
-        pStatistics[lIndex].numRecv     = iter->numRxTx;        /* Number of packets received for this subscription.  */
-        pStatistics[lIndex].numMissed   = iter->numMissed;      /* Number of packets received for this subscription.  */
-        pStatistics[lIndex].status      = iter->lastErr;        /* Receive status information  */
+        return TRDP_NOINIT_ERR;
     }
-    if (lIndex >= *pNumSubs && iter != NULL)
+
+    for (iter = appHandle->pSndQueue; (iter != NULL) && (lIndex < *pNum); iter = iter->pNext)
+    {
+        trdp_getLatency(iter, TRUE, &pStatistics[lIndex++], reset);
+    }
+    for (iter = (iter == NULL) ? appHandle->pRcvQueue : iter; (iter != NULL) && (lIndex < *pNum); iter = iter->pNext)
+    {
+        trdp_getLatency(iter, FALSE, &pStatistics[lIndex++], reset);
+    }
+    if (iter != NULL)
     {
         err = TRDP_MEM_ERR;
     }
-    *pNumSubs = lIndex;
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    *pNum = lIndex;
     return err;
 }
 
 /**********************************************************************************************************************/
-/** Return PD publish statistics.
+/** Approximate percentile of a latency histogram.
+ *
+ *  @param[in]      pHist               histogram
+ *  @param[in]      permille            percentile in 1/1000 (e.g. 990 for p99)
+ *
+ *  @retval         upper bound in ns of the bucket containing the percentile, 0 if the histogram is empty
+ */
+EXT_DECL UINT32 tlc_getLatencyPercentile (
+    const TRDP_LAT_HIST_T   *pHist,
+    UINT32                  permille)
+{
+    UINT64  rank;
+    UINT64  seen = 0u;
+    UINT32  idx;
+
+    if ((pHist == NULL) || (pHist->count == 0u))
+    {
+        return 0u;
+    }
+    rank = ((UINT64) pHist->count * ((permille > 1000u) ? 1000u : permille) + 999u) / 1000u;
+    rank = (rank == 0u) ? 1u : rank;
+
+    for (idx = 0u; idx < TRDP_LAT_BUCKETS; idx++)
+    {
+        seen += pHist->bucket[idx];
+        if (seen >= rank)
+        {
+            break;
+        }
+    }
+    if (idx >= TRDP_LAT_BUCKETS)
+    {
+        return pHist->max;
+    }
+    /*  Upper bound of the bucket, but never above the largest sample  */
+    return (trdp_latBucketLimit(idx) > pHist->max) ? pHist->max : trdp_latBucketLimit(idx);
+}
+
+/**********************************************************************************************************************/
+/** Copy the callback accounting of one element
+ *
+ *  @param[in,out]  pCbStats        accounting of the element
+ *  @param[in]      comId           ComId of the element
+ *  @param[in]      addr            destination or joined address of the element
+ *  @param[in]      owner           TRDP_CB_PUBLISHER, TRDP_CB_SUBSCRIPTION, TRDP_CB_LISTENER or TRDP_CB_CALLER
+ *  @param[out]     pStatistics     entry to fill
+ *  @param[in]      reset           clear the accounting after copying
+ */
+static void trdp_getCbStats (
+    TRDP_CB_STATS_T             *pCbStats,
+    UINT32                      comId,
+    TRDP_IP_ADDR_T              addr,
+    UINT32                      owner,
+    TRDP_CALLBACK_STATISTICS_T  *pStatistics,
+    BOOL8                       reset)
+{
+    pStatistics->comId      = comId;
+    pStatistics->addr       = addr;
+    pStatistics->owner      = owner;
+    pStatistics->numCalls   = pCbStats->numCalls;
+    pStatistics->numSlow    = pCbStats->numSlow;
+    pStatistics->maxTime    = pCbStats->maxTime;
+    pStatistics->totalTime  = pCbStats->totalTime;
+    if (reset == TRUE)
+    {
+        memset(pCbStats, 0, sizeof(TRDP_CB_STATS_T));
+    }
+}
+
+/**********************************************************************************************************************/
+/** Return the callback execution times of publishers, subscriptions and MD listeners.
+ *  The list holds the publishers, the subscriptions, the listeners and one entry (TRDP_CB_CALLER) for the
+ *  callbacks of MD sessions started by the application, in this order.
  *  Memory for statistics information must be provided by the user.
  *
  *  @param[in]      appHandle           the handle returned by tlc_openSession
- *  @param[in,out]  pNumPub             Pointer to the number of publishers
- *  @param[out]     pStatistics         Pointer to a list with the publish statistics information
- *  @retval         TRDP_NO_ERR            no error
+ *  @param[in,out]  pNum                Pointer to the number of entries
+ *  @param[out]     pStatistics         Pointer to a list with the callback statistics
+ *  @param[in]      reset               TRUE: clear the returned values
+ *  @retval         TRDP_NO_ERR         no error
  *  @retval         TRDP_NOINIT_ERR     handle invalid
  *  @retval         TRDP_PARAM_ERR      parameter error
- *  @retval         TRDP_MEM_ERR     there are more subscriptions than requested
+ *  @retval         TRDP_MEM_ERR        there are more entries than requested
  */
-EXT_DECL TRDP_ERR_T tlc_getPubStatistics (
-    TRDP_APP_SESSION_T      appHandle,
-    UINT16                  *pNumPub,
-    TRDP_PUB_STATISTICS_T   *pStatistics)
+EXT_DECL TRDP_ERR_T tlc_getCallbackStatistics (
+    TRDP_APP_SESSION_T          appHandle,
+    UINT16                      *pNum,
+    TRDP_CALLBACK_STATISTICS_T  *pStatistics,
+    BOOL8                       reset)
 {
-    TRDP_ERR_T  err = TRDP_NO_ERR;
+    TRDP_ERR_T  err     = TRDP_NO_ERR;
     PD_ELE_T    *iter;
-    UINT16      lIndex;
+    UINT16      lIndex  = 0u;
 
     if (!trdp_isValidSession(appHandle))
     {
         return TRDP_NOINIT_ERR;
     }
 
-    if (pNumPub == NULL || pStatistics == NULL || *pNumPub == 0)
+    if (pNum == NULL || pStatistics == NULL || *pNum == 0)
     {
         return TRDP_PARAM_ERR;
     }
 
-    /*  Loop over our subscriptions, but do not exceed user supplied buffers!    */
-    for (lIndex = 0, iter = appHandle->pSndQueue; lIndex < *pNumPub && iter != NULL; lIndex++, iter = iter->pNext)
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
     {
-        pStatistics[lIndex].comId       = iter->addr.comId;         /* Published ComId                                */
-        pStatistics[lIndex].destAddr    = iter->addr.destIpAddr;    /* IP address of destination for this publishing. */
-        pStatistics[lIndex].redId       = iter->redId;              /* Redundancy group id                            */
-        pStatistics[lIndex].redState    = (iter->privFlags & TRDP_REDUNDANT) ? 1 : 0; /* Redundancy state:
-                                                                                        1 = Follower
-                                                                                        0 = Leader                  */
+        return TRDP_NOINIT_ERR;
+    }
 
-        pStatistics[lIndex].cycle = (UINT32) iter->interval.tv_usec + (UINT32)iter->interval.tv_sec * 1000000;
-        /* Interval/cycle in us. 0 = No time-out supervision */
-        pStatistics[lIndex].numSend = iter->numRxTx;            /* Number of packets sent for this publisher.       */
-        pStatistics[lIndex].numPut  = iter->updPkts;            /* Updated packets (via put)                        */
+    for (iter = appHandle->pSndQueue; (iter != NULL) && (lIndex < *pNum); iter = iter->pNext)
+    {
+        trdp_getCbStats(&iter->cbStats, iter->addr.comId, iter->addr.destIpAddr, TRDP_CB_PUBLISHER,
+                        &pStatistics[lIndex++], reset);
     }
-    if (lIndex >= *pNumPub && iter != NULL)
+    for (iter = (iter == NULL) ? appHandle->pRcvQueue : iter; (iter != NULL) && (lIndex < *pNum); iter = iter->pNext)
+    {
+        trdp_getCbStats(&iter->cbStats, iter->addr.comId, iter->addr.mcGroup, TRDP_CB_SUBSCRIPTION,
+                        &pStatistics[lIndex++], reset);
+    }
+    if (iter != NULL)
     {
         err = TRDP_MEM_ERR;
     }
-    *pNumPub = lIndex;
+#if MD_SUPPORT
+    else
+    {
+        MD_LIS_ELE_T *iterLis;
+
+        for (iterLis = appHandle->pMDListenQueue; (iterLis != NULL) && (lIndex < *pNum); iterLis = iterLis->pNext)
+        {
+            trdp_getCbStats(&iterLis->cbStats, iterLis->addr.comId, iterLis->addr.mcGroup, TRDP_CB_LISTENER,
+                            &pStatistics[lIndex++], reset);
+        }
+        if ((iterLis != NULL) || (lIndex >= *pNum))
+        {
+            err = TRDP_MEM_ERR;
+        }
+        else
+        {
+            trdp_getCbStats(&appHandle->mdCallerCb, 0u, 0u, TRDP_CB_CALLER, &pStatistics[lIndex++], reset);
+        }
+    }
+#endif
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
+    *pNum = lIndex;
     return err;
 }
 
@@ -272,7 +1222,7 @@ EXT_DECL TRDP_ERR_T tlc_getUdpListStatistics (
     UINT16                  *pNumList,
     TRDP_LIST_STATISTICS_T  *pStatistics)
 {
-    MD_LIS_ELE_T    *pIter = ((TRDP_SESSION_T *)appHandle)->pMDListenQueue;
+    MD_LIS_ELE_T    *pIter;
     UINT16          lIndex;
     if (!trdp_isValidSession(appHandle))
     {
@@ -284,6 +1234,12 @@ EXT_DECL TRDP_ERR_T tlc_getUdpListStatistics (
         return TRDP_PARAM_ERR;
     }
 
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    pIter = appHandle->pMDListenQueue;
     for (lIndex = 0; (lIndex < *pNumList) && (pIter != NULL); pIter = pIter->pNext) /*lint !e443: clause irregularity OK */
     {
         if ((pIter->pktFlags & TRDP_FLAGS_TCP) == 0)
@@ -298,6 +1254,11 @@ EXT_DECL TRDP_ERR_T tlc_getUdpListStatistics (
             lIndex++;
         }
     }
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
     *pNumList = lIndex;
     return TRDP_NO_ERR;
 }
@@ -320,7 +1281,7 @@ EXT_DECL TRDP_ERR_T tlc_getTcpListStatistics (
     UINT16                  *pNumList,
     TRDP_LIST_STATISTICS_T  *pStatistics)
 {
-    MD_LIS_ELE_T    *pIter = ((TRDP_SESSION_T *)appHandle)->pMDListenQueue;
+    MD_LIS_ELE_T    *pIter;
     UINT16          lIndex;
     if (!trdp_isValidSession(appHandle))
     {
@@ -332,6 +1293,12 @@ EXT_DECL TRDP_ERR_T tlc_getTcpListStatistics (
         return TRDP_PARAM_ERR;
     }
 
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    pIter = appHandle->pMDListenQueue;
     for (lIndex = 0; lIndex < *pNumList && pIter != NULL; pIter = pIter->pNext) /*lint !e443: clause irregularity OK */
     {
         if ((pIter->pktFlags & TRDP_FLAGS_TCP) != 0)
@@ -346,6 +1313,11 @@ EXT_DECL TRDP_ERR_T tlc_getTcpListStatistics (
             lIndex++;
         }
     }
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
     *pNumList = lIndex;
     return TRDP_NO_ERR;
 }
@@ -375,6 +1347,16 @@ EXT_DECL TRDP_ERR_T tlc_getRedStatistics (
         return TRDP_NOINIT_ERR;
     }
 
+    if ((pNumRed == NULL) || (pStatistics == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
     /*    Search the redundancy flag for every PD  */
     for (lIndex = 0, iterPD = appHandle->pSndQueue; lIndex < *pNumRed && NULL != iterPD; iterPD = iterPD->pNext)
     {
@@ -394,6 +1376,11 @@ EXT_DECL TRDP_ERR_T tlc_getRedStatistics (
         }
     }
 
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
     *pNumRed = lIndex;
     return TRDP_NO_ERR;
 }
@@ -429,6 +1416,11 @@ EXT_DECL TRDP_ERR_T tlc_getJoinStatistics (
         return TRDP_PARAM_ERR;
     }
 
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
     /*  Loop over our subscriptions, but do not exceed user supplied buffers!    */
     for (lIndex = 0, iter = appHandle->pRcvQueue; lIndex < *pNumJoin && iter != NULL; lIndex++, iter = iter->pNext)
     {
@@ -440,21 +1432,24 @@ EXT_DECL TRDP_ERR_T tlc_getJoinStatistics (
         err = TRDP_MEM_ERR;
     }
 
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+
     *pNumJoin = lIndex;
 
     return err;
 }
 
 /**********************************************************************************************************************/
-/** Update the statistics
+/** Update the time and memory statistics. Must be called with the session locked.
  *
  *  @param[in]      appHandle           the handle returned by tlc_openSession
  */
 void    trdp_UpdateStats (
     TRDP_APP_SESSION_T appHandle)
 {
-    PD_ELE_T        *iter;
-    UINT16          lIndex, llIndex;
     VOS_ERR_T       ret;
     VOS_TIMEVAL_T   temp, temp2;
     TIMEDATE32      diff;
@@ -487,37 +1482,7 @@ void    trdp_UpdateStats (
         vos_printLog(VOS_LOG_ERROR, "vos_memCount() failed (Err: %d)\n", ret);
     }
 
-    appHandle->stats.pd.numMissed = 0u;
-
-    /*  Count our subscriptions */
-    for (lIndex = 0u, iter = appHandle->pRcvQueue; iter != NULL; lIndex++, iter = iter->pNext)
-    {
-        appHandle->stats.pd.numMissed += iter->numMissed;
-    }
-
-    appHandle->stats.pd.numSubs = lIndex;
-
-    /*  Count our publishers */
-    for (lIndex = 0u, iter = appHandle->pSndQueue; iter != NULL; lIndex++, iter = iter->pNext)
-    {
-        ;
-    }
-
-    appHandle->stats.pd.numPub = lIndex;
-
-    /*  Count our joins */
-    appHandle->stats.numJoin = 0u;
-    for (lIndex = 0u; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
-    {
-        for (llIndex = 0u; llIndex < VOS_MAX_MULTICAST_CNT; llIndex++)
-        {
-            if (appHandle->iface[lIndex].mcGroups[llIndex] != 0u)
-            {
-                appHandle->stats.numJoin++;
-            }
-        }
-    }
-
+    /*  numSubs, numPub, numJoin and numMissed are maintained where they change */
 }
 
 /**********************************************************************************************************************/
@@ -620,3 +1585,88 @@ void    trdp_pdPrepareStats (
     /* mark the data as valid */
     pPacket->privFlags = (TRDP_PRIV_FLAGS_T) (pPacket->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_INVALID_DATA);
 }
+
+/**********************************************************************************************************************/
+/** Fill the subscription or publisher list into a statistics reply.
+ *  The list head is followed by as many entries and dataset sizes as fit into one PD telegram.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  pPacket             publisher of TRDP_SUBS_LIST_COMID or TRDP_PUB_LIST_COMID
+ *
+ *  @retval         none
+ */
+void    trdp_pdPrepareListStats (
+    TRDP_APP_SESSION_T  appHandle,
+    PD_ELE_T            *pPacket)
+{
+    TRDP_STATISTICS_LIST_T  *pHead;
+    UINT32                  *pSize;
+    PD_ELE_T                *iter;
+    UINT16                  numEntries;
+    UINT16                  numTotal;
+    UINT16                  lIndex;
+
+    if (pPacket == NULL || appHandle == NULL)
+    {
+        return;
+    }
+
+    pHead = (TRDP_STATISTICS_LIST_T *) pPacket->pFrame->data;
+
+    if (pPacket->addr.comId == TRDP_SUBS_LIST_COMID)
+    {
+        TRDP_SUBS_STATISTICS_T *pData = (TRDP_SUBS_STATISTICS_T *) (pHead + 1);
+
+        numEntries = (UINT16) ((TRDP_MAX_PD_DATA_SIZE - sizeof(TRDP_STATISTICS_LIST_T)) /
+                               (sizeof(TRDP_SUBS_STATISTICS_T) + sizeof(UINT32)));
+        numTotal    = (UINT16) appHandle->stats.pd.numSubs;
+        (void) trdp_copySubsStats(appHandle, &numEntries, pData);
+        pSize       = (UINT32 *) &pData[numEntries];
+        iter        = appHandle->pRcvQueue;
+        for (lIndex = 0u; lIndex < numEntries; lIndex++, iter = iter->pNext)
+        {
+            pData[lIndex].comId         = vos_htonl(pData[lIndex].comId);
+            pData[lIndex].joinedAddr    = vos_htonl(pData[lIndex].joinedAddr);
+            pData[lIndex].filterAddr    = vos_htonl(pData[lIndex].filterAddr);
+            pData[lIndex].callBack      = vos_htonl(pData[lIndex].callBack);
+            pData[lIndex].userRef       = vos_htonl(pData[lIndex].userRef);
+            pData[lIndex].timeout       = vos_htonl(pData[lIndex].timeout);
+            pData[lIndex].status        = (TRDP_ERR_T) vos_htonl((UINT32) pData[lIndex].status);
+            pData[lIndex].toBehav       = vos_htonl(pData[lIndex].toBehav);
+            pData[lIndex].numRecv       = vos_htonl(pData[lIndex].numRecv);
+            pData[lIndex].numMissed     = vos_htonl(pData[lIndex].numMissed);
+            pSize[lIndex]               = vos_htonl(iter->dataSize);
+        }
+    }
+    else
+    {
+        TRDP_PUB_STATISTICS_T *pData = (TRDP_PUB_STATISTICS_T *) (pHead + 1);
+
+        numEntries = (UINT16) ((TRDP_MAX_PD_DATA_SIZE - sizeof(TRDP_STATISTICS_LIST_T)) /
+                               (sizeof(TRDP_PUB_STATISTICS_T) + sizeof(UINT32)));
+        numTotal    = (UINT16) appHandle->stats.pd.numPub;
+        (void) trdp_copyPubStats(appHandle, &numEntries, pData);
+        pSize       = (UINT32 *) &pData[numEntries];
+        iter        = appHandle->pSndQueue;
+        for (lIndex = 0u; lIndex < numEntries; lIndex++, iter = iter->pNext)
+        {
+            pData[lIndex].comId     = vos_htonl(pData[lIndex].comId);
+            pData[lIndex].destAddr  = vos_htonl(pData[lIndex].destAddr);
+            pData[lIndex].cycle     = vos_htonl(pData[lIndex].cycle);
+            pData[lIndex].redId     = vos_htonl(pData[lIndex].redId);
+            pData[lIndex].redState  = vos_htonl(pData[lIndex].redState);
+            pData[lIndex].numPut    = vos_htonl(pData[lIndex].numPut);
+            pData[lIndex].numSend   = vos_htonl(pData[lIndex].numSend);
+            pSize[lIndex]           = vos_htonl(iter->dataSize);
+        }
+    }
+    pHead->numTotal     = vos_htons(numTotal);
+    pHead->numEntries   = vos_htons(numEntries);
+
+    pPacket->dataSize   = (UINT32) ((UINT8 *) &pSize[numEntries] - pPacket->pFrame->data);
+    pPacket->grossSize  = trdp_packetSizePD(pPacket->dataSize);
+    pPacket->pFrame->frameHead.datasetLength = vos_htonl(pPacket->dataSize);
+
+    /* mark the data as valid */
+    pPacket->privFlags = (TRDP_PRIV_FLAGS_T) (pPacket->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_INVALID_DATA);
+}
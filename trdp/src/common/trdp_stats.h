@@ -16,6 +16,12 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: TRDP_CB_TIMED: callbacks timed only if the execution time is needed
+ *      BL 2026-10-17: trdp_pdPrepareListStats() added
+ *      BL 2026-10-17: trdp_cbAccount() added, TRDP_PROC_TIMED removed
+ *      BL 2026-10-17: Stage timing of tlc_process(): TRDP_PROC_STAGE, TRDP_PROC_CALLBACK
+ *      BL 2026-10-17: trdp_latBucketLimit(), trdp_UpdateStats() exported
+ *      BL 2026-10-17: trdp_pdRecordLatency() added
  */
 
 
@@ -34,6 +40,37 @@
  * DEFINES
  */
 
+/** Stage timing of tlc_process() (tlc_setProcessTiming). Must be used with the session locked. */
+#if TRDP_PROCESS_TIMING
+#define TRDP_PROC_STAGE(appHandle, stage)                                   \
+    do {                                                                    \
+        if ((appHandle)->pTiming != NULL)                                   \
+        {                                                                   \
+            trdp_procStage((appHandle), (stage));                           \
+        }                                                                   \
+    } while (0)
+#define TRDP_PROC_CALLBACK(appHandle, comId, duration)                      \
+    do {                                                                    \
+        if ((appHandle)->pTiming != NULL)                                   \
+        {                                                                   \
+            trdp_procCallback((appHandle), (comId), (duration));            \
+        }                                                                   \
+    } while (0)
+#else
+#define TRDP_PROC_STAGE(appHandle, stage)
+#define TRDP_PROC_CALLBACK(appHandle, comId, duration)
+#endif
+
+/** Callbacks are timed (two clock reads each) only if callback or latency statistics or the stage timing
+    need the execution time */
+#if TRDP_PROCESS_TIMING
+#define TRDP_CB_TIMED(appHandle)                                                                    \
+    ((((appHandle)->option & (TRDP_OPTION_CALLBACK_STATS | TRDP_OPTION_LATENCY_STATS)) != 0) ||   \
+     ((appHandle)->pTiming != NULL))
+#else
+#define TRDP_CB_TIMED(appHandle)                                                                    \
+    (((appHandle)->option & (TRDP_OPTION_CALLBACK_STATS | TRDP_OPTION_LATENCY_STATS)) != 0)
+#endif
 
 /*******************************************************************************
  * TYPEDEFS
@@ -46,6 +83,14 @@
 
 void    trdp_initStats(TRDP_APP_SESSION_T appHandle);
 void    trdp_pdPrepareStats (TRDP_APP_SESSION_T appHandle, PD_ELE_T *pPacket);
+void    trdp_pdPrepareListStats (TRDP_APP_SESSION_T appHandle, PD_ELE_T *pPacket);
+void    trdp_pdRecordLatency (PD_ELE_T *pPacket, BOOL8 callback, VOS_TIME_NS_T latency);
+UINT32  trdp_latBucketLimit (UINT32 idx);
+void    trdp_UpdateStats (TRDP_APP_SESSION_T appHandle);
+void    trdp_procStage (TRDP_APP_SESSION_T appHandle, TRDP_PROC_STAGE_T stage);
+void    trdp_procCallback (TRDP_APP_SESSION_T appHandle, UINT32 comId, VOS_TIME_NS_T duration);
+void    trdp_cbAccount (TRDP_APP_SESSION_T appHandle, TRDP_CB_STATS_T *pCbStats, UINT32 comId,
+                        VOS_TIME_NS_T duration);
 
 
 #endif
@@ -0,0 +1,502 @@
+/******************************************************************************/
+/**
+ * @file            trdp_trace.c
+ *
+ * @brief           Event trace ring for TRDP communication
+ *
+ * @details         Packet rx/tx, timeouts, MD state changes, socket open/close and the tlc_process() passes
+ *                  are recorded as 24 byte records into a ring buffer allocated by tlc_setTrace().
+ *                  The dump file (TRDP_TRACE_HEADER_T followed by the records, oldest first) can be converted
+ *                  to Chrome trace / Perfetto JSON by trdp-trace2json.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/*******************************************************************************
+ * INCLUDES
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#if (defined (WIN32) || defined (WIN64))
+#include <io.h>
+#include <intrin.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "trdp_trace.h"
+#include "trdp_if_light.h"
+#include "trdp_if.h"
+#include "trdp_private.h"
+#include "vos_mem.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+
+/******************************************************************************
+ *   Defines
+ */
+
+/** pTrace and traceUsers are accessed lock-free by tlc_dumpTraceFd() and tlc_requestTraceDump(),
+    both may run in a signal handler. Sequentially consistent, the reader count is raised before the
+    pointer is read and the pointer is cleared before the count is checked by trdp_traceFree(). */
+#if (defined (WIN32) || defined (WIN64))
+#define TRACE_PTR_LOAD(pp)          ((TRDP_TRACE_T *) _InterlockedCompareExchangePointer((void *volatile *) (pp), \
+                                                                                         NULL, NULL))
+#define TRACE_PTR_STORE(pp, v)      ((void) _InterlockedExchangePointer((void *volatile *) (pp), (v)))
+#define TRACE_PTR_XCHG(pp, v)       ((TRDP_TRACE_T *) _InterlockedExchangePointer((void *volatile *) (pp), (v)))
+#define TRACE_USERS_INC(p)          ((void) _InterlockedIncrement((volatile long *) (p)))
+#define TRACE_USERS_DEC(p)          ((void) _InterlockedDecrement((volatile long *) (p)))
+#define TRACE_USERS_LOAD(p)         ((UINT32) _InterlockedOr((volatile long *) (p), 0))
+#define TRACE_WRITE(fd, p, n)       _write((fd), (p), (unsigned int) (n))
+#else
+#define TRACE_PTR_LOAD(pp)          __atomic_load_n((pp), __ATOMIC_SEQ_CST)
+#define TRACE_PTR_STORE(pp, v)      __atomic_store_n((pp), (v), __ATOMIC_SEQ_CST)
+#define TRACE_PTR_XCHG(pp, v)       __atomic_exchange_n((pp), (v), __ATOMIC_SEQ_CST)
+#define TRACE_USERS_INC(p)          ((void) __atomic_add_fetch((p), 1u, __ATOMIC_SEQ_CST))
+#define TRACE_USERS_DEC(p)          ((void) __atomic_sub_fetch((p), 1u, __ATOMIC_SEQ_CST))
+#define TRACE_USERS_LOAD(p)         __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define TRACE_WRITE(fd, p, n)       write((fd), (p), (size_t) (n))
+#endif
+
+/******************************************************************************
+ *   Locals
+ */
+
+static UINT32       trdp_traceHeader (TRDP_SESSION_PT appHandle, const TRDP_TRACE_T *pTrace,
+                                      TRDP_TRACE_HEADER_T *pHeader, UINT32 *pFirst);
+static BOOL8        trdp_traceWrite (INT32 fd, const void *pData, UINT32 size);
+static TRDP_ERR_T   trdp_traceDump (TRDP_SESSION_PT appHandle, const CHAR8 *pFileName);
+
+/**********************************************************************************************************************/
+/** Fill the dump header and locate the oldest record.
+ *  The ring is read once into locals, a record being written concurrently may be torn but the indices stay in range.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pTrace              trace ring of the session
+ *  @param[out]     pHeader             dump header
+ *  @param[out]     pFirst              index of the oldest record
+ *
+ *  @retval         number of records to dump
+ */
+static UINT32 trdp_traceHeader (
+    TRDP_SESSION_PT     appHandle,
+    const TRDP_TRACE_T  *pTrace,
+    TRDP_TRACE_HEADER_T *pHeader,
+    UINT32              *pFirst)
+{
+    UINT32  size    = pTrace->size;
+    UINT32  next    = pTrace->next;
+    UINT32  count   = pTrace->count;
+
+    if (next >= size)
+    {
+        next = 0u;
+    }
+    if (count > size)
+    {
+        count = size;
+    }
+
+    memset(pHeader, 0, sizeof(TRDP_TRACE_HEADER_T));
+    memcpy(pHeader->magic, TRDP_TRACE_MAGIC, sizeof(TRDP_TRACE_MAGIC));
+    pHeader->version    = TRDP_TRACE_VERSION;
+    pHeader->recSize    = (UINT32) sizeof(TRDP_TRACE_REC_T);
+    pHeader->noOfRecs   = count;
+    pHeader->numLost    = pTrace->numLost;
+    pHeader->ownIpAddr  = appHandle->realIP;
+
+    /*  The oldest record is 'count' records behind the write position  */
+    *pFirst = (next + size - count) % size;
+    return count;
+}
+
+/**********************************************************************************************************************/
+/** Write a block to a file descriptor, continue after partial writes and interrupts.
+ *  Async-signal-safe.
+ *
+ *  @param[in]      fd                  file descriptor
+ *  @param[in]      pData               data
+ *  @param[in]      size                number of bytes
+ *
+ *  @retval         TRUE                all bytes written
+ *  @retval         FALSE               write failed
+ */
+static BOOL8 trdp_traceWrite (
+    INT32       fd,
+    const void  *pData,
+    UINT32      size)
+{
+    const UINT8 *pByte = (const UINT8 *) pData;
+
+    while (size > 0u)
+    {
+        long written = (long) TRACE_WRITE(fd, pByte, size);
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return FALSE;
+        }
+        if (written == 0)
+        {
+            return FALSE;
+        }
+        pByte   += written;
+        size    -= (UINT32) written;
+    }
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Write the ring to a file, oldest record first.
+ *  Must be called with the session locked.
+ *
+ *  @param[in]      appHandle           session pointer
+ *  @param[in]      pFileName           name of the dump file
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_IO_ERR         file could not be written
+ */
+static TRDP_ERR_T trdp_traceDump (
+    TRDP_SESSION_PT appHandle,
+    const CHAR8     *pFileName)
+{
+    TRDP_TRACE_T        *pTrace = appHandle->pTrace;
+    TRDP_TRACE_HEADER_T header;
+    UINT32              first;
+    UINT32              count;
+    UINT32              tail;
+    FILE                *fp;
+    TRDP_ERR_T          err = TRDP_NO_ERR;
+
+    /* Note: MS says use of fopen is unsecure. Dumps are written on demand for post-mortem analysis only */
+    fp = fopen(pFileName, "wb");
+    if (fp == NULL)
+    {
+        vos_printLog(VOS_LOG_ERROR, "Cannot open trace dump file %s\n", pFileName);
+        return TRDP_IO_ERR;
+    }
+
+    count   = trdp_traceHeader(appHandle, pTrace, &header, &first);
+    tail    = (first + count > pTrace->size) ? pTrace->size - first : count;
+
+    if ((fwrite(&header, sizeof(header), 1u, fp) != 1u) ||
+        (fwrite(&pTrace->rec[first], sizeof(TRDP_TRACE_REC_T), tail, fp) != tail) ||
+        (fwrite(&pTrace->rec[0], sizeof(TRDP_TRACE_REC_T), count - tail, fp) != count - tail))
+    {
+        vos_printLog(VOS_LOG_ERROR, "Writing trace dump file %s failed\n", pFileName);
+        err = TRDP_IO_ERR;
+    }
+    else
+    {
+        vos_printLog(VOS_LOG_INFO, "%u trace records dumped to %s (%u lost)\n",
+                     (unsigned int) count, pFileName, (unsigned int) header.numLost);
+    }
+    (void) fclose(fp);
+    return err;
+}
+
+/******************************************************************************
+ *   Globals
+ */
+
+/**********************************************************************************************************************/
+/** Append an event to the ring, the oldest record is overwritten if the ring is full.
+ *  Must be called with the session locked (use the TRDP_TRACE macro).
+ *
+ *  @param[in]      pTrace              trace ring of the session
+ *  @param[in]      event               event type
+ *  @param[in]      comId               ComId or 0
+ *  @param[in]      seqCnt              sequence counter or socket index
+ *  @param[in]      arg                 event specific argument
+ */
+void trdp_traceRecord (
+    TRDP_TRACE_T        *pTrace,
+    TRDP_TRACE_EVENT_T  event,
+    UINT32              comId,
+    UINT32              seqCnt,
+    UINT32              arg)
+{
+    TRDP_TRACE_REC_T *pRec = &pTrace->rec[pTrace->next];
+
+    pRec->time      = vos_getTimeNs();
+    pRec->comId     = comId;
+    pRec->seqCnt    = seqCnt;
+    pRec->arg       = arg;
+    pRec->event     = (UINT16) event;
+    pRec->reserved  = 0u;
+
+    if (++pTrace->next >= pTrace->size)
+    {
+        pTrace->next = 0u;
+    }
+    if (pTrace->count < pTrace->size)
+    {
+        pTrace->count++;
+    }
+    else
+    {
+        pTrace->numLost++;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Record the opening or closing of a socket of the socket pool.
+ *  The socket pool does not know its session, it is looked up in the session queue.
+ *
+ *  @param[in]      iface               socket pool of a session
+ *  @param[in]      event               TRDP_TRACE_SOCK_OPEN or TRDP_TRACE_SOCK_CLOSE
+ *  @param[in]      index               index into the socket pool
+ */
+void trdp_traceSocket (
+    const TRDP_SOCKETS_T    iface[],
+    TRDP_TRACE_EVENT_T      event,
+    INT32                   index)
+{
+    TRDP_SESSION_PT pSession;
+
+    for (pSession = (TRDP_SESSION_PT) trdp_sessionQueue(); pSession != NULL; pSession = pSession->pNext)
+    {
+        if (pSession->iface == iface)
+        {
+            TRDP_TRACE(pSession, event, 0u, index, iface[index].sock);
+            break;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Write the dump requested by tlc_requestTraceDump().
+ *  Called at the end of a processing pass with the session locked.
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_traceCheckDump (
+    TRDP_SESSION_PT appHandle)
+{
+    if ((appHandle->pTrace != NULL) &&
+        (appHandle->pTrace->dumpRequest != 0u))
+    {
+        appHandle->pTrace->dumpRequest = 0u;
+        (void) trdp_traceDump(appHandle, appHandle->pTrace->fileName);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Free the trace ring of a session.
+ *  The ring is detached first, then freed as soon as no tlc_dumpTraceFd() call is reading it any more.
+ *  Must be called with the session locked.
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void trdp_traceFree (
+    TRDP_SESSION_PT appHandle)
+{
+    TRDP_TRACE_T *pTrace = TRACE_PTR_XCHG(&appHandle->pTrace, NULL);
+
+    if (pTrace != NULL)
+    {
+        /*  A signal handler interrupting this thread has finished before we get here,
+            dumps running on other threads are waited for  */
+        while (TRACE_USERS_LOAD(&appHandle->traceUsers) != 0u)
+        {
+            vos_threadDelay(1000u);
+        }
+        vos_memFree(pTrace);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Switch event tracing on or off.
+ *  The ring is allocated once; when it is full, the oldest events are overwritten.
+ *  Calling it again with a different size discards the recorded events.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      noOfEvents          size of the ring in records (24 bytes each), 0 switches tracing off
+ *  @param[in]      pDumpFileName       file for dumps requested by tlc_requestTraceDump(),
+ *                                      NULL: TRDP_TRACE_DEFAULT_FILE
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      tracing is not compiled in (TRDP_TRACE_SUPPORT == 0)
+ *  @retval         TRDP_MEM_ERR        ring could not be allocated
+ */
+EXT_DECL TRDP_ERR_T tlc_setTrace (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              noOfEvents,
+    const CHAR8         *pDumpFileName)
+{
+    TRDP_ERR_T      err = TRDP_NO_ERR;
+    TRDP_TRACE_T    *pTrace;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+#if !TRDP_TRACE_SUPPORT
+    if (noOfEvents != 0u)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Event trace not supported (TRDP_TRACE_SUPPORT == 0)\n");
+        return TRDP_PARAM_ERR;
+    }
+#endif
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    trdp_traceFree(appHandle);
+
+    if (noOfEvents != 0u)
+    {
+        pTrace = (TRDP_TRACE_T *) vos_memAlloc(sizeof(TRDP_TRACE_T) +
+                                               (noOfEvents - 1u) * sizeof(TRDP_TRACE_REC_T));
+        if (pTrace == NULL)
+        {
+            vos_printLog(VOS_LOG_ERROR, "Cannot allocate trace ring for %u events\n", (unsigned int) noOfEvents);
+            err = TRDP_MEM_ERR;
+        }
+        else
+        {
+            memset(pTrace, 0, sizeof(TRDP_TRACE_T));
+            pTrace->size = noOfEvents;
+            vos_strncpy(pTrace->fileName,
+                        (pDumpFileName != NULL) ? pDumpFileName : TRDP_TRACE_DEFAULT_FILE,
+                        TRDP_MAX_FILE_NAME_LEN);
+            TRACE_PTR_STORE(&appHandle->pTrace, pTrace);
+        }
+    }
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Dump the recorded events to a file.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pFileName           name of the dump file, NULL: file given to tlc_setTrace()
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      tracing is off
+ *  @retval         TRDP_IO_ERR         file could not be written
+ */
+EXT_DECL TRDP_ERR_T tlc_dumpTrace (
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pFileName)
+{
+    TRDP_ERR_T err = TRDP_PARAM_ERR;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (appHandle->pTrace != NULL)
+    {
+        err = trdp_traceDump(appHandle, (pFileName != NULL) ? pFileName : appHandle->pTrace->fileName);
+    }
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Dump the recorded events to a file descriptor opened in advance.
+ *  The header and the raw records are written with write() only; the function neither locks, allocates nor logs
+ *  and may be called from a signal handler, also while another thread is recording or calling tlc_setTrace().
+ *  Records written concurrently by the processing thread may be torn.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession, must stay open
+ *  @param[in]      fd                  file descriptor, e.g. from open(..., O_WRONLY | O_CREAT | O_TRUNC)
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      handle NULL or tracing is off
+ *  @retval         TRDP_IO_ERR         write failed
+ */
+EXT_DECL TRDP_ERR_T tlc_dumpTraceFd (
+    TRDP_APP_SESSION_T  appHandle,
+    INT32               fd)
+{
+    TRDP_TRACE_T        *pTrace;
+    TRDP_TRACE_HEADER_T header;
+    UINT32              first;
+    UINT32              count;
+    UINT32              tail;
+    int                 savedErrno  = errno;
+    TRDP_ERR_T          err         = TRDP_PARAM_ERR;
+
+    if (appHandle == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    TRACE_USERS_INC(&appHandle->traceUsers);
+    pTrace = TRACE_PTR_LOAD(&appHandle->pTrace);
+    if (pTrace != NULL)
+    {
+        count   = trdp_traceHeader(appHandle, pTrace, &header, &first);
+        tail    = (first + count > pTrace->size) ? pTrace->size - first : count;
+        err     = (trdp_traceWrite(fd, &header, (UINT32) sizeof(header)) &&
+                   trdp_traceWrite(fd, &pTrace->rec[first], tail * (UINT32) sizeof(TRDP_TRACE_REC_T)) &&
+                   trdp_traceWrite(fd, &pTrace->rec[0], (count - tail) * (UINT32) sizeof(TRDP_TRACE_REC_T)))
+                  ? TRDP_NO_ERR : TRDP_IO_ERR;
+    }
+    TRACE_USERS_DEC(&appHandle->traceUsers);
+
+    errno = savedErrno;
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Request a dump of the recorded events.
+ *  The dump is written to the file given to tlc_setTrace() at the end of the next tlc_process() pass.
+ *  This function neither locks nor allocates and may be called from a signal handler.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ */
+EXT_DECL void tlc_requestTraceDump (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TRDP_TRACE_T *pTrace;
+
+    if (appHandle != NULL)
+    {
+        TRACE_USERS_INC(&appHandle->traceUsers);
+        pTrace = TRACE_PTR_LOAD(&appHandle->pTrace);
+        if (pTrace != NULL)
+        {
+            pTrace->dumpRequest = 1u;
+        }
+        TRACE_USERS_DEC(&appHandle->traceUsers);
+    }
+}
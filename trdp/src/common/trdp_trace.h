@@ -0,0 +1,80 @@
+/******************************************************************************/
+/**
+ * @file            trdp_trace.h
+ *
+ * @brief           Event trace ring for TRDP communication
+ *
+ * @details         Compact binary events of a session are written into a preallocated ring buffer.
+ *                  The ring can be dumped to a file on demand or on request from a signal handler, or written
+ *                  to a file descriptor opened in advance directly from a signal handler.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+
+#ifndef TRDP_TRACE_H
+#define TRDP_TRACE_H
+
+/*******************************************************************************
+ * INCLUDES
+ */
+
+#include "trdp_if_light.h"
+#include "trdp_private.h"
+
+/*******************************************************************************
+ * DEFINES
+ */
+
+#ifndef TRDP_TRACE_DEFAULT_FILE
+#define TRDP_TRACE_DEFAULT_FILE     "trdp_trace.bin"    /**< dump file if none was given to tlc_setTrace() */
+#endif
+
+/** Record an event if tracing is switched on for the session. Must be called with the session locked. */
+#if TRDP_TRACE_SUPPORT
+#define TRDP_TRACE(appHandle, event, comId, seqCnt, arg)                                     \
+    do {                                                                                    \
+        if ((appHandle)->pTrace != NULL)                                                    \
+        {                                                                                   \
+            trdp_traceRecord((appHandle)->pTrace, (event), (UINT32)(comId), (UINT32)(seqCnt), (UINT32)(arg));   \
+        }                                                                                   \
+    } while (0)
+#else
+#define TRDP_TRACE(appHandle, event, comId, seqCnt, arg)
+#endif
+
+/*******************************************************************************
+ * TYPEDEFS
+ */
+
+/** Trace ring of a session */
+typedef struct TRDP_TRACE
+{
+    UINT32              size;           /**< number of records in the ring                      */
+    UINT32              next;           /**< index of the record to be written next             */
+    UINT32              count;          /**< number of valid records                            */
+    UINT32              numLost;        /**< number of records overwritten                      */
+    volatile UINT8      dumpRequest;    /**< set by tlc_requestTraceDump()                      */
+    TRDP_FILE_NAME_T    fileName;       /**< dump file for requested dumps                      */
+    TRDP_TRACE_REC_T    rec[1];         /**< the ring, allocated with 'size' records            */
+} TRDP_TRACE_T;
+
+/*******************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+void    trdp_traceRecord (TRDP_TRACE_T *pTrace, TRDP_TRACE_EVENT_T event, UINT32 comId, UINT32 seqCnt, UINT32 arg);
+void    trdp_traceSocket (const TRDP_SOCKETS_T iface[], TRDP_TRACE_EVENT_T event, INT32 index);
+void    trdp_traceCheckDump (TRDP_SESSION_PT appHandle);
+void    trdp_traceFree (TRDP_SESSION_PT appHandle);
+
+#endif
@@ -16,6 +16,11 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: trdp_pubIndex*(): publishers of all sessions by comId, one pass per publisher batch
+ *      BL 2026-10-17: trdp_checkSequenceCounter(): serial number arithmetic, late packets deducted only if counted lost
+ *      BL 2026-10-17: trdp_checkSequenceCounter(): receive window, loss bursts, reorder and duplicates per source
+ *      BL 2026-10-17: Number of joins of a session maintained on join/leave (trdp_countJoins)
+ *      BL 2026-10-17: Event trace: socket open/close
  *      BL 2018-11-06: for-loops limited to sCurrentMaxSocketCnt instead VOS_MAX_SOCKET_CNT
  *      BL 2018-11-06: Ticket #219: PD Sequence Counter is not synched correctly
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
@@ -44,11 +49,14 @@
 
 #include "trdp_if.h"
 #include "trdp_utils.h"
+#include "trdp_trace.h"
 
 /***********************************************************************************************************************
  * DEFINES
  */
 
+#define TRDP_PUB_INDEX_MIN_SLOTS    16u     /**< Minimal size of the publisher index hash table */
+
 /***********************************************************************************************************************
  * TYPEDEFS
  */
@@ -68,6 +76,8 @@ static BOOL8    trdp_SockAddJoin (TRDP_IP_ADDR_T    mcList[VOS_MAX_MULTICAST_CNT
                                   TRDP_IP_ADDR_T    mcGroup);
 static BOOL8    trdp_SockDelJoin (TRDP_IP_ADDR_T    mcList[VOS_MAX_MULTICAST_CNT],
                                   TRDP_IP_ADDR_T    mcGroup);
+static void     trdp_countJoins (const TRDP_SOCKETS_T iface[], INT32 delta);
+static UINT32   *trdp_pubIndexSlot (const TRDP_PUB_INDEX_T *pIndex, UINT32 comId);
 
 /**********************************************************************************************************************/
 /** Debug socket usage output
@@ -174,6 +184,29 @@ static BOOL8 trdp_SockDelJoin (
     return FALSE;
 }
 
+/**********************************************************************************************************************/
+/** Update the number of joined multicast groups in the statistics of the session owning the socket pool.
+ *  The socket pool does not know its session, it is looked up in the session queue.
+ *
+ *  @param[in]      iface           socket pool of a session
+ *  @param[in]      delta           number of groups joined (> 0) or left (< 0)
+ */
+static void trdp_countJoins (
+    const TRDP_SOCKETS_T    iface[],
+    INT32                   delta)
+{
+    TRDP_SESSION_PT pSession;
+
+    for (pSession = (TRDP_SESSION_PT) trdp_sessionQueue(); pSession != NULL; pSession = pSession->pNext)
+    {
+        if (pSession->iface == iface)
+        {
+            pSession->stats.numJoin = (UINT32) ((INT32) pSession->stats.numJoin + delta);
+            break;
+        }
+    }
+}
+
 
 /***********************************************************************************************************************
  *   Globals
@@ -758,6 +791,7 @@ TRDP_ERR_T  trdp_requestSocket (
                         }
                         continue;   /* No, socket cannot join more MC groups */
                     }
+                    trdp_countJoins(iface, 1);
                 }
             }
 
@@ -868,6 +902,9 @@ TRDP_ERR_T  trdp_requestSocket (
                {
                    iface[lIndex].usage = 1;
                    *pIndex = lIndex;
+#if TRDP_TRACE_SUPPORT
+                   trdp_traceSocket(iface, TRDP_TRACE_SOCK_OPEN, lIndex);
+#endif
 
                    if (rcvMostly)
                    {
@@ -904,6 +941,10 @@ TRDP_ERR_T  trdp_requestSocket (
                                {
                                    vos_printLogStr(VOS_LOG_ERROR, "trdp_SockAddJoin() failed!\n");
                                }
+                               else
+                               {
+                                   trdp_countJoins(iface, 1);
+                               }
                            }
                        }
                    }
@@ -938,6 +979,9 @@ TRDP_ERR_T  trdp_requestSocket (
                {
                    iface[lIndex].usage = 1;
                    *pIndex = lIndex;
+#if TRDP_TRACE_SUPPORT
+                   trdp_traceSocket(iface, TRDP_TRACE_SOCK_OPEN, lIndex);
+#endif
                }
 
                break;
@@ -1000,6 +1044,9 @@ void  trdp_releaseSocket (
             if (iface[lIndex].tcpParams.morituri == TRUE)
             {
                 vos_printLog(VOS_LOG_INFO, "The socket (Num = %d) will be closed\n", (int) iface[lIndex].sock);
+#if TRDP_TRACE_SUPPORT
+                trdp_traceSocket(iface, TRDP_TRACE_SOCK_CLOSE, lIndex);
+#endif
 
                 err = (TRDP_ERR_T) vos_sockClose(iface[lIndex].sock);
                 if (err != TRDP_NO_ERR)
@@ -1045,6 +1092,27 @@ void  trdp_releaseSocket (
                 iface[lIndex].usage <= 0)
             {
                 /* Close that socket, nobody uses it anymore */
+#if TRDP_TRACE_SUPPORT
+                trdp_traceSocket(iface, TRDP_TRACE_SOCK_CLOSE, lIndex);
+#endif
+                /* Closing leaves all MC groups of the socket */
+                {
+                    INT32 noOfJoins = 0;
+                    INT32 mcIndex;
+
+                    for (mcIndex = 0; mcIndex < VOS_MAX_MULTICAST_CNT; mcIndex++)
+                    {
+                        if (iface[lIndex].mcGroups[mcIndex] != 0u)
+                        {
+                            noOfJoins++;
+                        }
+                    }
+                    if (noOfJoins != 0)
+                    {
+                        trdp_countJoins(iface, -noOfJoins);
+                        memset(iface[lIndex].mcGroups, 0, sizeof(iface[lIndex].mcGroups));
+                    }
+                }
                 err = (TRDP_ERR_T) vos_sockClose(iface[lIndex].sock);
                 if (err != TRDP_NO_ERR)
                 {
@@ -1066,6 +1134,7 @@ void  trdp_releaseSocket (
                 }
                 else    /* and unjoin MC group */
                 {
+                   trdp_countJoins(iface, -1);
                    if (vos_sockLeaveMC(iface[lIndex].sock, mcGroupUsed, iface[lIndex].bindAddr) != VOS_NO_ERR)
                    {
                       vos_printLogStr(VOS_LOG_WARNING, "trdp_sockLeaveMC() failed!\n");
@@ -1170,9 +1239,233 @@ UINT32  trdp_getSeqCnt (
     return 0;   /*    Not found, initial value is zero    */
 }
 
+/**********************************************************************************************************************/
+/** Find the slot of a comId in the publisher index, or the free slot it goes into.
+ *
+ *  @param[in]      pIndex          publisher index
+ *  @param[in]      comId           comId
+ *
+ *  @retval         pointer to the slot
+ */
+static UINT32 *trdp_pubIndexSlot (
+    const TRDP_PUB_INDEX_T  *pIndex,
+    UINT32                  comId)
+{
+    UINT32 pos = comId * 0x9E3779B1u;
+
+    pos = (pos ^ (pos >> 16u)) & pIndex->mask;
+    while ((pIndex->pSlot[pos] != 0u) && (pIndex->pNode[pIndex->pSlot[pos] - 1u].addr.comId != comId))
+    {
+        pos = (pos + 1u) & pIndex->mask;
+    }
+    return &pIndex->pSlot[pos];
+}
+
+/**********************************************************************************************************************/
+/** Index the publishers of all sessions by comId.
+ *  Replaces the searches of trdp_queueFindPubAddr and trdp_getSeqCnt through the send queues for a batch of new
+ *  publishers of a session. The session must be locked, the send queues of the other sessions are read once,
+ *  their sequence counters are taken at this time.
+ *
+ *  @param[out]     pIndex          publisher index, to be released by trdp_pubIndexFree
+ *  @param[in]      appHandle       publishing session
+ *  @param[in]      count           maximum number of publishers added by trdp_pubIndexAdd
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+TRDP_ERR_T trdp_pubIndexInit (
+    TRDP_PUB_INDEX_T    *pIndex,
+    TRDP_SESSION_PT     appHandle,
+    UINT32              count)
+{
+    TRDP_SESSION_PT pSession;
+    PD_ELE_T        *pSendElement;
+    TRDP_PUB_NODE_T *pNode;
+    UINT32          *pSlot;
+    UINT32          slots       = TRDP_PUB_INDEX_MIN_SLOTS;
+    UINT32          sessionNo   = 0u;
+    UINT32          first, prev, next;
+    UINT32          i;
+
+    memset(pIndex, 0, sizeof(TRDP_PUB_INDEX_T));
+
+    for (pSession = (TRDP_SESSION_PT) trdp_sessionQueue(); pSession != NULL; pSession = pSession->pNext)
+    {
+        for (pSendElement = pSession->pSndQueue; pSendElement != NULL; pSendElement = pSendElement->pNext)
+        {
+            pIndex->maxNodes++;
+        }
+    }
+    pIndex->maxNodes += count;
+    while (slots < 2u * pIndex->maxNodes)
+    {
+        slots <<= 1u;
+    }
+
+    pIndex->pSlot = (UINT32 *) vos_memAlloc(slots * sizeof(UINT32) + pIndex->maxNodes * sizeof(TRDP_PUB_NODE_T));
+    if (pIndex->pSlot == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+    pIndex->pNode   = (TRDP_PUB_NODE_T *) &pIndex->pSlot[slots];
+    pIndex->mask    = slots - 1u;
+
+    /*  Chain the publishers in reverse search order (sessions, then queue), the chains are turned below  */
+    for (pSession = (TRDP_SESSION_PT) trdp_sessionQueue(); pSession != NULL; pSession = pSession->pNext)
+    {
+        if (pSession == appHandle)
+        {
+            pIndex->sessionNo = sessionNo;
+        }
+        for (pSendElement = pSession->pSndQueue;
+             (pSendElement != NULL) && (pIndex->numNodes < pIndex->maxNodes);
+             pSendElement = pSendElement->pNext)
+        {
+            pNode               = &pIndex->pNode[pIndex->numNodes++];
+            pNode->addr         = pSendElement->addr;
+            pNode->pElement     = (pSession == appHandle) ? pSendElement : NULL;
+            pNode->seqCnt       = pSendElement->curSeqCnt;
+            pNode->sessionNo    = sessionNo;
+            pSlot               = trdp_pubIndexSlot(pIndex, pNode->addr.comId);
+            pNode->next         = *pSlot;
+            *pSlot              = pIndex->numNodes;
+        }
+        sessionNo++;
+    }
+
+    for (i = 0u; i < slots; i++)
+    {
+        prev = 0u;
+        for (first = pIndex->pSlot[i]; first != 0u; first = next)
+        {
+            next                            = pIndex->pNode[first - 1u].next;
+            pIndex->pNode[first - 1u].next  = prev;
+            prev                            = first;
+        }
+        pIndex->pSlot[i] = prev;
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Release a publisher index.
+ *
+ *  @param[in]      pIndex          publisher index
+ */
+void trdp_pubIndexFree (
+    TRDP_PUB_INDEX_T *pIndex)
+{
+    if (pIndex->pSlot != NULL)
+    {
+        vos_memFree(pIndex->pSlot);
+    }
+    memset(pIndex, 0, sizeof(TRDP_PUB_INDEX_T));
+}
+
+/**********************************************************************************************************************/
+/** Add a new publisher of the indexed session, it was inserted at the front of the send queue.
+ *
+ *  @param[in]      pIndex          publisher index
+ *  @param[in]      pElement        new publisher
+ */
+void trdp_pubIndexAdd (
+    TRDP_PUB_INDEX_T    *pIndex,
+    PD_ELE_T            *pElement)
+{
+    TRDP_PUB_NODE_T *pNode;
+    UINT32          *pSlot;
+    UINT32          *pPrev;
+
+    if (pIndex->numNodes >= pIndex->maxNodes)
+    {
+        return;
+    }
+    pNode               = &pIndex->pNode[pIndex->numNodes++];
+    pNode->addr         = pElement->addr;
+    pNode->pElement     = pElement;
+    pNode->sessionNo    = pIndex->sessionNo;
+
+    /*  Before the publishers of the session, behind those of the sessions searched before  */
+    pSlot = trdp_pubIndexSlot(pIndex, pElement->addr.comId);
+    pPrev = pSlot;
+    while ((*pPrev != 0u) && (pIndex->pNode[*pPrev - 1u].sessionNo < pIndex->sessionNo))
+    {
+        pPrev = &pIndex->pNode[*pPrev - 1u].next;
+    }
+    pNode->next = *pPrev;
+    *pPrev      = pIndex->numNodes;
+}
+
+/**********************************************************************************************************************/
+/** Publisher index: return the publisher of the indexed session with same comId and IP addresses
+ *  (see trdp_queueFindPubAddr).
+ *
+ *  @param[in]      pIndex          publisher index
+ *  @param[in]      pAddr           Pub handle (Address, ComID, srcIP & dest IP) to search for
+ *
+ *  @retval         != NULL         pointer to PD element
+ *  @retval         NULL            No PD element found
+ */
+PD_ELE_T *trdp_pubIndexFindAddr (
+    const TRDP_PUB_INDEX_T  *pIndex,
+    const TRDP_ADDRESSES_T  *pAddr)
+{
+    UINT32 node;
+
+    for (node = *trdp_pubIndexSlot(pIndex, pAddr->comId); node != 0u; node = pIndex->pNode[node - 1u].next)
+    {
+        const TRDP_PUB_NODE_T *pNode = &pIndex->pNode[node - 1u];
+
+        /*  We match if src/dst/mc address is zero or matches */
+        if ((pNode->pElement != NULL)
+            && ((pNode->addr.srcIpAddr == 0) || (pNode->addr.srcIpAddr == pAddr->srcIpAddr))
+            && ((pNode->addr.destIpAddr == 0) || (pNode->addr.destIpAddr == pAddr->destIpAddr))
+            && ((pNode->addr.mcGroup == 0) || (pNode->addr.mcGroup == pAddr->mcGroup)))
+        {
+            return pNode->pElement;
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Publisher index: get the initial sequence counter of a PD publisher (see trdp_getSeqCnt).
+ *
+ *  @param[in]      pIndex          publisher index
+ *  @param[in]      comId           comID to look for
+ *  @param[in]      srcIpAddr       Source IP address
+ *
+ *  @retval         return the sequence number
+ */
+UINT32 trdp_pubIndexSeqCnt (
+    const TRDP_PUB_INDEX_T  *pIndex,
+    UINT32                  comId,
+    TRDP_IP_ADDR_T          srcIpAddr)
+{
+    UINT32 node;
+
+    if (0 == comId)
+    {
+        return 0;
+    }
+
+    for (node = *trdp_pubIndexSlot(pIndex, comId); node != 0u; node = pIndex->pNode[node - 1u].next)
+    {
+        const TRDP_PUB_NODE_T *pNode = &pIndex->pNode[node - 1u];
+
+        if ((srcIpAddr == 0) || (pNode->addr.srcIpAddr == srcIpAddr))
+        {
+            return (pNode->pElement != NULL) ? pNode->pElement->curSeqCnt : pNode->seqCnt;
+        }
+    }
+    return 0;   /*    Not found, initial value is zero    */
+}
+
 /**********************************************************************************************************************/
 /** remove the sequence counter for the comID/source IP.
  *  The sequence counter should be reset if there was a packet time out.
+ *  The loss statistics of the source are kept.
  *
  *
  *  @param[in]      pElement            subscription element
@@ -1199,7 +1492,8 @@ void trdp_resetSequenceCounter (
         if ((srcIP == pElement->pSeqCntList->seq[l_index].srcIpAddr) &&
             (msgType == pElement->pSeqCntList->seq[l_index].msgType))
         {
-            pElement->pSeqCntList->seq[l_index].lastSeqCnt = 0;
+            pElement->pSeqCntList->seq[l_index].lastSeqCnt  = 0;
+            pElement->pSeqCntList->seq[l_index].window      = 0;
         }
     }
 }
@@ -1209,11 +1503,18 @@ void trdp_resetSequenceCounter (
  *  If the comID/srcIP is not found, update it and return 0 -
  *  else if already received, return 1
  *  On memory error, return -1
+ *  Sequence counters are compared in serial number arithmetic, the counter may wrap.
+ *  The last TRDP_SEQ_CNT_WINDOW sequence counters of each source are kept in two bitmaps, received and
+ *  counted as lost, to tell late (reordered) packets from duplicates; gaps are counted as loss bursts.
+ *  After a reset only packets newer than the first one received are tracked, older ones are ignored
+ *  without being counted.
  *
  *  @param[in]      pElement            subscription element
  *  @param[in]      sequenceCounter     sequence counter to check
  *  @param[in]      srcIP               Source IP address
  *  @param[in]      msgType             type of the message
+ *  @param[out]     pMissed             change of the missed packets: the gap before this packet,
+ *                                      -1 for a late packet counted as missed before, else 0
  *
  *  @retval         0 - no duplicate
  *                  1 - duplicate or old sequence counter
@@ -1224,15 +1525,18 @@ int trdp_checkSequenceCounter (
     PD_ELE_T        *pElement,
     UINT32          sequenceCounter,
     TRDP_IP_ADDR_T  srcIP,
-    TRDP_MSG_T      msgType)
+    TRDP_MSG_T      msgType,
+    INT32           *pMissed)
 {
     int l_index;
+    TRDP_SEQ_CNT_ENTRY_T *pEntry;
 
-    if (pElement == NULL)
+    if ((pElement == NULL) || (pMissed == NULL))
     {
         vos_printLogStr(VOS_LOG_DBG, "Parameter error\n");
         return -1;
     }
+    *pMissed = 0;
 
     if (pElement->pSeqCntList == NULL)
     {
@@ -1250,34 +1554,80 @@ int trdp_checkSequenceCounter (
     /* Loop over entries */
     for (l_index = 0; l_index < pElement->pSeqCntList->curNoOfEntries; ++l_index)
     {
-        if ((srcIP == pElement->pSeqCntList->seq[l_index].srcIpAddr) &&
-            (msgType == pElement->pSeqCntList->seq[l_index].msgType))
+        pEntry = &pElement->pSeqCntList->seq[l_index];
+        if ((srcIP == pEntry->srcIpAddr) &&
+            (msgType == pEntry->msgType))
         {
+            INT32   delta = (INT32) (sequenceCounter - pEntry->lastSeqCnt);
+            UINT32  distance;
+
             /*        Is this packet a duplicate?    */
-            if ((pElement->pSeqCntList->seq[l_index].lastSeqCnt == 0) ||    /* first time after timeout */
-                (sequenceCounter > pElement->pSeqCntList->seq[l_index].lastSeqCnt))
+            if (pEntry->window == 0u)                                   /* first time after timeout */
+            {
+                pEntry->window  = 1u;
+                pEntry->lost    = 0u;
+            }
+            else if (delta > 0)
             {
-                /*
-                 vos_printLog(VOS_LOG_DBG,
-                 "Rcv sequence: %u    last seq: %u\n",
-                 sequenceCounter,
-                 pElement->pSeqCntList->seq[l_index].lastSeqCnt);
-                 vos_printLog(VOS_LOG_DBG, "-> new PD data found (SrcIp: %s comId %u)\n", vos_ipDotted(
-                 srcIP), pElement->addr.comId);
-                 */
-                pElement->pSeqCntList->seq[l_index].lastSeqCnt = sequenceCounter;
-                return 0;
+                distance = (UINT32) delta;
+                if (distance > 1u)
+                {
+                    *pMissed = (distance - 1u < 0x7FFFFFFFu) ? (INT32) (distance - 1u) : 0x7FFFFFFF;
+                    pEntry->numLost += distance - 1u;
+                    pEntry->numBursts++;
+                    if (distance - 1u > pEntry->maxBurst)
+                    {
+                        pEntry->maxBurst = distance - 1u;
+                    }
+                }
+                if (distance < TRDP_SEQ_CNT_WINDOW)
+                {
+                    /*  Bits 1 .. distance - 1 are the gap  */
+                    pEntry->window  = (pEntry->window << distance) | 1u;
+                    pEntry->lost    = (pEntry->lost << distance) | (((1u << distance) - 1u) & ~1u);
+                }
+                else
+                {
+                    pEntry->window  = 1u;
+                    pEntry->lost    = ~1u;
+                }
             }
             else
             {
+                distance = (UINT32) (pEntry->lastSeqCnt - sequenceCounter);
+                if ((distance < TRDP_SEQ_CNT_WINDOW) && ((pEntry->lost & (1u << distance)) != 0u))
+                {
+                    /*  Counted as lost before, arrived late  */
+                    pEntry->window  |= 1u << distance;
+                    pEntry->lost    &= ~(1u << distance);
+                    pEntry->numLost = (pEntry->numLost > 0u) ? pEntry->numLost - 1u : 0u;
+                    pEntry->numReordered++;
+                    *pMissed = -1;
+                }
+                else if ((distance < TRDP_SEQ_CNT_WINDOW) && ((pEntry->window & (1u << distance)) != 0u))
+                {
+                    pEntry->numDuplicate++;
+                }
+                /*  else: older than the window or sent before a reset, nothing known about it  */
                 vos_printLog(VOS_LOG_DBG,
                              "Rcv sequence: %u    last seq: %u\n",
                              sequenceCounter,
-                             pElement->pSeqCntList->seq[l_index].lastSeqCnt);
+                             pEntry->lastSeqCnt);
                 vos_printLog(VOS_LOG_DBG, "-> duplicated PD data ignored (SrcIp: %s comId %u)\n", vos_ipDotted(
                                  srcIP), pElement->addr.comId);
                 return 1;
             }
+            /*
+             vos_printLog(VOS_LOG_DBG,
+             "Rcv sequence: %u    last seq: %u\n",
+             sequenceCounter,
+             pEntry->lastSeqCnt);
+             vos_printLog(VOS_LOG_DBG, "-> new PD data found (SrcIp: %s comId %u)\n", vos_ipDotted(
+             srcIP), pElement->addr.comId);
+             */
+            pEntry->lastSeqCnt = sequenceCounter;
+            pEntry->numRcv++;
+            return 0;
         }
     }
 
@@ -1301,9 +1651,13 @@ int trdp_checkSequenceCounter (
         pElement->pSeqCntList = newList;
         pElement->pSeqCntList->maxNoOfEntries = newSize;
     }
-    pElement->pSeqCntList->seq[pElement->pSeqCntList->curNoOfEntries].lastSeqCnt    = sequenceCounter;
-    pElement->pSeqCntList->seq[pElement->pSeqCntList->curNoOfEntries].srcIpAddr     = srcIP;
-    pElement->pSeqCntList->seq[pElement->pSeqCntList->curNoOfEntries].msgType       = msgType;
+    pEntry = &pElement->pSeqCntList->seq[pElement->pSeqCntList->curNoOfEntries];
+    memset(pEntry, 0, sizeof(TRDP_SEQ_CNT_ENTRY_T));
+    pEntry->lastSeqCnt  = sequenceCounter;
+    pEntry->srcIpAddr   = srcIP;
+    pEntry->msgType     = msgType;
+    pEntry->window      = 1u;
+    pEntry->numRcv      = 1u;
     pElement->pSeqCntList->curNoOfEntries++;
     vos_printLog(VOS_LOG_DBG, "Rcv sequence: %u\n", sequenceCounter);
     vos_printLog(VOS_LOG_DBG, "*** new sequence entry (SrcIp: %s comId %u)\n", vos_ipDotted(
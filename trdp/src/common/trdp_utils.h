@@ -16,6 +16,9 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: TRDP_PUB_INDEX_T, publishers of all sessions by comId for tlp_publishBatch
+ *      BL 2026-10-17: trdp_checkSequenceCounter() returns -1 for a late packet counted as missed
+ *      BL 2026-10-17: trdp_checkSequenceCounter() returns the gap per source
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
  *      BL 2017-11-28: Ticket #180 Filtering rules for DestinationURI does not follow the standard
  *      BL 2017-11-15: Ticket #1   Unjoin on unsubscribe/delListener (finally ;-)
@@ -47,6 +50,28 @@
  * TYPEDEFS
  */
 
+/** Publisher of a send queue in TRDP_PUB_INDEX_T */
+typedef struct
+{
+    TRDP_ADDRESSES_T    addr;           /**< comId and addresses of the publisher                       */
+    PD_ELE_T            *pElement;      /**< publisher of the indexed session, NULL: other session      */
+    UINT32              seqCnt;         /**< sequence counter of a publisher of another session         */
+    UINT32              sessionNo;      /**< position of its session in the session queue               */
+    UINT32              next;           /**< next publisher with the comId (number + 1), 0 if none      */
+} TRDP_PUB_NODE_T;
+
+/** Publishers of all sessions by comId, built once per batch instead of searching the send queues for each
+    new publisher. The publishers of a comId are chained in the search order of trdp_getSeqCnt. */
+typedef struct
+{
+    UINT32              sessionNo;      /**< position of the indexed (locked) session                   */
+    UINT32              numNodes;       /**< number of used nodes                                       */
+    UINT32              maxNodes;       /**< number of allocated nodes                                  */
+    TRDP_PUB_NODE_T     *pNode;         /**< publishers                                                 */
+    UINT32              mask;           /**< number of slots - 1                                        */
+    UINT32              *pSlot;         /**< first publisher of a comId (number + 1), 0 if empty        */
+} TRDP_PUB_INDEX_T;
+
 /*******************************************************************************
  * GLOBAL FUNCTIONS
  */
@@ -254,6 +279,27 @@ UINT32 trdp_getSeqCnt (
     TRDP_MSG_T      msgType,
     TRDP_IP_ADDR_T  srcIP);
 
+TRDP_ERR_T  trdp_pubIndexInit (
+    TRDP_PUB_INDEX_T    *pIndex,
+    TRDP_SESSION_PT     appHandle,
+    UINT32              count);
+
+void        trdp_pubIndexFree (
+    TRDP_PUB_INDEX_T    *pIndex);
+
+void        trdp_pubIndexAdd (
+    TRDP_PUB_INDEX_T    *pIndex,
+    PD_ELE_T            *pElement);
+
+PD_ELE_T    *trdp_pubIndexFindAddr (
+    const TRDP_PUB_INDEX_T  *pIndex,
+    const TRDP_ADDRESSES_T  *pAddr);
+
+UINT32      trdp_pubIndexSeqCnt (
+    const TRDP_PUB_INDEX_T  *pIndex,
+    UINT32                  comId,
+    TRDP_IP_ADDR_T          srcIpAddr);
+
 
 /**********************************************************************************************************************/
 /** check and update the sequence counter for the comID/source IP.
@@ -265,9 +311,11 @@ UINT32 trdp_getSeqCnt (
  *  @param[in]      sequenceCounter     sequence counter to check
  *  @param[in]      srcIP               Source IP address
  *  @param[in]      msgType             type of the message
+ *  @param[out]     pMissed             change of the missed packets: the gap before this packet,
+ *                                      -1 for a late packet counted as missed before, else 0
  *
  *  @retval         0 - no duplicate
- *                  1 - duplicate sequence counter
+ *                  1 - duplicate or old sequence counter
  *                 -1 - memory error
  */
 
@@ -275,7 +323,8 @@ int trdp_checkSequenceCounter (
     PD_ELE_T        *pElement,
     UINT32          sequenceCounter,
     TRDP_IP_ADDR_T  srcIP,
-    TRDP_MSG_T      msgType);
+    TRDP_MSG_T      msgType,
+    INT32           *pMissed);
 
 
 /**********************************************************************************************************************/
@@ -16,6 +16,7 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: Tokenizer on a mapped buffer, element index for seek and count
  *      SB 2018-11-07: Ticket #221 readXmlDatasets failed 
  *      BL 2016-07-06: Ticket #122 64Bit compatibility (+ compiler warnings)
  *      BL 2016-02-24: missing include (thanks to Robert)
@@ -31,12 +32,21 @@
 #include <string.h>
 #include <sys/types.h>
 
+#ifdef POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 #include "trdp_xml.h"
 
 /***********************************************************************************************************************
  * DEFINES
  */
 
+#define XML_INITIAL_ELEMENTS    256u    /* initial size of the element index */
+
 /***********************************************************************************************************************
  * TYPEDEFS
  */
@@ -45,13 +55,6 @@
 *  LOCAL FUNCTIONS
 */
 
-/***********************************************************************************************************************
-NAME:       trdp_XMLNextToken
-ABSTRACT:   Returns next XML token.
-            Skips occurences of whitespace and <!...> and <?...>
-RETURNS:    TOK_OPEN ("<"), TOK_CLOSE (">"), TOK_OPEN_END = ("</"),
-            TOK_CLOSE_EMPTY = ("/>"), TOK_EQUAL = ("="), TOK_ID, TOK_EOF
-*/
 /**********************************************************************************************************************/
 /** Return next XML token.
  *    Skips occurences of whitespace and <!...> and <?...>
@@ -65,30 +68,30 @@ RETURNS:    TOK_OPEN ("<"), TOK_CLOSE (">"), TOK_OPEN_END = ("</"),
 static XML_TOKEN_T trdp_XMLNextToken (
     XML_HANDLE_T *pXML)
 {
-    int     ch = 0;
-    char    *p;
+    const unsigned char *pBuf = (const unsigned char *) pXML->pBuffer;
+    const UINT32        size  = pXML->size;
+    int                 ch;
+    char                *p;
 
     for (;;)
     {
         /* Skip whitespace */
-        while (!feof(pXML->infile) && (ch = fgetc(pXML->infile)) <= ' ') /*lint !e160 Lint objects a GNU warning
-                                                                           suppression macro - OK */
-        {
-            ;
-        }
-
-        /* Check for EOF */
-        if (feof(pXML->infile)) /*lint !e611 Lint for VxWorks gets lost in macro defintions*/
+        do
         {
-            return TOK_EOF;
+            if (pXML->pos >= size)
+            {
+                return TOK_EOF;
+            }
+            ch = pBuf[pXML->pos++];
         }
+        while (ch <= ' ');
 
         /* Handle quoted identifiers */
         if (ch == '"')
         {
             p = pXML->tokenValue;
-            while (!feof(pXML->infile) && (ch = fgetc(pXML->infile)) != '"') /*lint !e160 Lint objects a GNU warning
-                                                                               suppression macro - OK */
+            pXML->idOffset = pXML->pos;
+            while ((pXML->pos < size) && ((ch = pBuf[pXML->pos++]) != '"'))
             {
                 if (p < (pXML->tokenValue + MAX_TOK_LEN - 1))
                 {
@@ -96,78 +99,71 @@ static XML_TOKEN_T trdp_XMLNextToken (
                 }
             }
 
-            *(p++) = 0;
+            *p = 0;
+            pXML->idLen = (UINT32) (p - pXML->tokenValue);
             return TOK_ID;
         }
         else if (ch == '<')
         {
             /* Tag start character */
-            ch = fgetc(pXML->infile);    /*lint !e160 Lint objects a GNU warning suppression macro - OK */
+            if (pXML->pos >= size)
+            {
+                return TOK_OPEN;
+            }
+            ch = pBuf[pXML->pos++];
 
             if (ch == '?') /* Skip processing instruction */
             {
-                while (!feof(pXML->infile) && (ch = fgetc(pXML->infile))) /*lint !e160 Lint objects a GNU warning
-                                                                            suppression macro - OK */
+                while (pXML->pos < size)
                 {
-                    if (ch == '?')
+                    if ((pBuf[pXML->pos++] == '?') && (pXML->pos < size) && (pBuf[pXML->pos] == '>'))
                     {
-                        if ((ch = fgetc(pXML->infile)) == '>')
-                        {
-                            break;
-                        }
-                        else
-                        {
-                            (void) ungetc(ch, pXML->infile);
-                        }
+                        pXML->pos++;
+                        break;
                     }
                 }
             }
             else if (ch == '!')
             {
+                BOOL8 closed = FALSE;
+
                 /* Is it a comment? */
-                if (!feof(pXML->infile) && (ch = fgetc(pXML->infile)))
+                if ((pXML->pos + 1u < size) && (pBuf[pXML->pos] == '-') && (pBuf[pXML->pos + 1u] == '-'))
                 {
-                    if (ch == '-')
+                    int endTagCnt = 0;
+
+                    pXML->pos += 2u;
+                    while (pXML->pos < size)
                     {
-                        if ((ch = fgetc(pXML->infile) == '-'))
+                        ch = pBuf[pXML->pos++];
+                        if (ch == '-')
                         {
-                            int endTagCnt = 0;
-                            while (!feof(pXML->infile) && (ch = fgetc(pXML->infile))) /*lint !e160 Lint objects a GNU
-                                                                                        warning suppression macro - OK
-                                                                                        */
-                            {
-                                if (ch == '-')
-                                {
-                                    endTagCnt++;
-                                }
-                                else if (ch == '>' && endTagCnt == 2)
-                                {
-                                    endTagCnt = 0;
-                                    break;
-                                }
-                                else
-                                {
-                                    endTagCnt = 0;
-                                }
-                            }
-                            /* Exit on unexpected end-of-file */
-                            if (endTagCnt != 2 && feof(pXML->infile))
-                            {
-                                pXML->error = TRDP_XML_PARSER_ERR;
-                                return TOK_EOF;
-                            }
+                            endTagCnt++;
+                        }
+                        else if (ch == '>' && endTagCnt == 2)
+                        {
+                            closed = TRUE;
+                            break;
+                        }
+                        else
+                        {
+                            endTagCnt = 0;
                         }
                     }
-                    else
+                }
+                else
+                {
+                    while (pXML->pos < size)
                     {
-                        while (!feof(pXML->infile) && (ch = fgetc(pXML->infile)) != '>')
+                        if (pBuf[pXML->pos++] == '>')
                         {
-                            ;
+                            closed = TRUE;
+                            break;
                         }
                     }
                 }
                 /* Exit on unexpected end-of-file */
-                if (feof(pXML->infile))
+                if (closed == FALSE)
                 {
                     pXML->error = TRDP_XML_PARSER_ERR;
                     return TOK_EOF;
@@ -179,21 +175,17 @@ static XML_TOKEN_T trdp_XMLNextToken (
             }
             else
             {
-                (void) ungetc(ch, pXML->infile);
+                pXML->pos--;
                 return TOK_OPEN;
             }
         }
         else if (ch == '/')
         {
-            ch = fgetc(pXML->infile); /*lint !e160 Lint objects a GNU warning suppression macro - OK */
-            if (ch == '>')
+            if ((pXML->pos < size) && (pBuf[pXML->pos] == '>'))
             {
+                pXML->pos++;
                 return TOK_CLOSE_EMPTY;
             }
-            else
-            {
-                (void) ungetc(ch, pXML->infile);
-            }
         }
         else if (ch == '>')
         {
@@ -206,28 +198,29 @@ static XML_TOKEN_T trdp_XMLNextToken (
         else
         {
             /* Unquoted identifier */
-            p       = pXML->tokenValue;
-            *(p++)  = (char) ch;
-            while ((!feof(pXML->infile)) &&
-                   ((ch = fgetc(pXML->infile)) != '<') /*lint !e160 Lint objects a GNU warning suppression macro - OK */
-                   && (ch != '>')
-                   && (ch != '=')
-                   && (ch != '/')
-                   && (ch > ' '))
+            p               = pXML->tokenValue;
+            pXML->idOffset  = pXML->pos - 1u;
+            *(p++)          = (char) ch;
+            while (pXML->pos < size)
             {
+                ch = pBuf[pXML->pos];
+                if ((ch == '<') || (ch == '>') || (ch == '=') || (ch == '/'))
+                {
+                    break;
+                }
+                pXML->pos++;
+                if (ch <= ' ')
+                {
+                    break;
+                }
                 if (p < (pXML->tokenValue + MAX_TOK_LEN - 1u))
                 {
                     *(p++) = (char) ch;
                 }
             }
 
-            *(p++) = 0;
-
-            if ((ch == '<') || (ch == '>') || (ch == '=') || (ch == '/'))
-            {
-                (void) ungetc(ch, pXML->infile);
-            }
-
+            *p = 0;
+            pXML->idLen = (UINT32) (p - pXML->tokenValue);
             return TOK_ID;
         }
     }
@@ -250,6 +243,7 @@ static XML_TOKEN_T trdp_XMLNextTokenHl (
     XML_TOKEN_T token;
 
     token = trdp_XMLNextToken(pXML);
+    pXML->pendingClose = FALSE;
 
     if (token == TOK_OPEN)
     {
@@ -260,6 +254,13 @@ static XML_TOKEN_T trdp_XMLNextTokenHl (
         {
             vos_strncpy(pXML->tokenTag, pXML->tokenValue, MAX_TAG_LEN);
             token = TOK_START_TAG;  /* TOK_OPEN + TOK_ID */
+
+            /* Keep the element index in step */
+            if ((pXML->curElement < pXML->noOfElements) &&
+                (pXML->pElement[pXML->curElement].tagOffset == pXML->idOffset))
+            {
+                pXML->curElement++;
+            }
         }
         else
         {
@@ -275,6 +276,7 @@ static XML_TOKEN_T trdp_XMLNextTokenHl (
         {
             vos_strncpy(pXML->tokenTag, pXML->tokenValue, MAX_TAG_LEN);
             token = TOK_END_TAG; /* TOK_OPEN_END + TOK_ID + TOK_CLOSE */
+            pXML->pendingClose = TRUE;
         }
         else
         {
@@ -294,25 +296,359 @@ static XML_TOKEN_T trdp_XMLNextTokenHl (
     return token;
 }
 
+/**********************************************************************************************************************/
+/** Hash of a tag name (FNV-1a).
+ *
+ *  @param[in]      pName       Tag name
+ *  @param[in]      len         Length of the name
+ *
+ *  @retval         hash value
+ */
+static UINT32 trdp_XMLHash (
+    const char  *pName,
+    UINT32      len)
+{
+    UINT32 hash = 2166136261u;
+
+    while (len-- > 0u)
+    {
+        hash ^= (UINT32) (unsigned char) *pName++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**********************************************************************************************************************/
+/** Build the element index in one pass over the buffer.
+ *
+ *  @param[in]      pXML        Pointer to local data
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory
+ */
+static TRDP_ERR_T trdp_XMLBuildIndex (
+    XML_HANDLE_T *pXML)
+{
+    XML_TOKEN_T     token;
+    XML_ELEMENT_T   *pElem;
+    UINT32          open    = XML_NO_ELEMENT;
+    int             depth   = 0;
+
+    pXML->pos = 0u;
+    while ((token = trdp_XMLNextToken(pXML)) != TOK_EOF)
+    {
+        if (token == TOK_OPEN)
+        {
+            depth++;
+            if (trdp_XMLNextToken(pXML) != TOK_ID)
+            {
+                break;      /* < should always be followed by a tag id */
+            }
+            if (pXML->noOfElements == pXML->maxElements)
+            {
+                /* The index can exceed the largest block of the VOS memory pool, it is held on the heap */
+                UINT32          newMax  = (pXML->maxElements == 0u) ? XML_INITIAL_ELEMENTS : 2u * pXML->maxElements;
+                XML_ELEMENT_T   *pNew   = (XML_ELEMENT_T *) realloc(pXML->pElement, newMax * sizeof(XML_ELEMENT_T));
+                if (pNew == NULL)
+                {
+                    return TRDP_MEM_ERR;
+                }
+                pXML->pElement      = pNew;
+                pXML->maxElements   = newMax;
+            }
+            pElem               = &pXML->pElement[pXML->noOfElements];
+            pElem->tagOffset    = pXML->idOffset;
+            pElem->tagLen       = (UINT16) pXML->idLen;
+            pElem->attrOffset   = pXML->pos;
+            pElem->hash         = trdp_XMLHash(pXML->pBuffer + pXML->idOffset, pXML->idLen);
+            pElem->depth        = (UINT16) depth;
+            pElem->parent       = open;
+            pElem->next         = XML_NO_ELEMENT;
+            pElem->endOffset    = pXML->size;
+            open = pXML->noOfElements++;
+        }
+        else if ((token == TOK_OPEN_END) || (token == TOK_CLOSE_EMPTY))
+        {
+            depth--;
+            if ((token == TOK_OPEN_END) && (trdp_XMLNextToken(pXML) != TOK_ID))
+            {
+                break;      /* </ should always be followed by a tag id */
+            }
+            if (open != XML_NO_ELEMENT)
+            {
+                pXML->pElement[open].next       = pXML->noOfElements;
+                pXML->pElement[open].endOffset  = pXML->pos;
+                open = pXML->pElement[open].parent;
+            }
+        }
+        /* else attributes and content, ignore */
+    }
+
+    /* Elements left open end with the file */
+    while (open != XML_NO_ELEMENT)
+    {
+        pXML->pElement[open].next = pXML->noOfElements;
+        open = pXML->pElement[open].parent;
+    }
+    pXML->pos = 0u;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Pass the end tag which leads out of the seek level.
+ *    Like the token reader, stop behind the tag name of the end tag.
+ *
+ *  @param[in]      pXML        Pointer to local data
+ *  @param[in]      depth       Tag depth behind the end tag
+ *
+ *  @retval         -2          no more tags on this depth
+ */
+static int trdp_XMLPassEndTag (
+    XML_HANDLE_T    *pXML,
+    int             depth)
+{
+    UINT32 open = (pXML->curElement > 0u) ? pXML->curElement - 1u : XML_NO_ELEMENT;
+
+    while ((open != XML_NO_ELEMENT) && ((int) pXML->pElement[open].depth > depth + 1))
+    {
+        open = pXML->pElement[open].parent;
+    }
+    if (open != XML_NO_ELEMENT)
+    {
+        pXML->pos           = pXML->pElement[open].endOffset;
+        pXML->pendingClose  = ((pXML->pos > 0u) && (pXML->pBuffer[pXML->pos - 1u] != '>')) ? TRUE : FALSE;
+    }
+    pXML->tagDepth = depth;
+    return -2;
+}
+
+/**********************************************************************************************************************/
+/** Advance to the next start tag on the seek depth, using the element index.
+ *    Behaves like reading token by token: end tags between the current position and the next start tag
+ *    are passed implicitly, subtrees deeper than the seek depth are jumped over.
+ *
+ *  @param[in]      pXML        Pointer to local data
+ *
+ *  @retval         0           found, the element is pXML->curElement - 1
+ *  @retval         -1          end of file
+ *  @retval         -2          no more tags on this depth
+ */
+static int trdp_XMLNextElement (
+    XML_HANDLE_T *pXML)
+{
+    const int           seek    = pXML->tagDepthSeek;
+    UINT32              e       = pXML->curElement;
+    const XML_ELEMENT_T *pElem;
+    int                 depth;
+
+    /* Already outside of the seek level: as with the token reader, the next token decides */
+    if (pXML->tagDepth < seek - 1)
+    {
+        XML_TOKEN_T token = trdp_XMLNextTokenHl(pXML);
+
+        if (token == TOK_EOF)
+        {
+            return -1;
+        }
+        else if (pXML->tagDepth < seek - 1)
+        {
+            return -2;
+        }
+        else if ((token == TOK_START_TAG) && (pXML->tagDepth == seek))
+        {
+            return 0;
+        }
+        e = pXML->curElement;
+    }
+    pXML->pendingClose = FALSE;
+
+    for (;;)
+    {
+        if (e >= pXML->noOfElements)
+        {
+            /* Only end tags are left, they lead out of the seek level, if there is one */
+            pXML->curElement = e;
+            if ((pXML->tagDepth > 0) && (seek > 1))
+            {
+                return trdp_XMLPassEndTag(pXML, (pXML->tagDepth >= seek - 1) ? seek - 2 : pXML->tagDepth - 1);
+            }
+            pXML->tagDepth  = 0;
+            pXML->pos       = pXML->size;
+            return -1;
+        }
+
+        pElem   = &pXML->pElement[e];
+        depth   = (int) pElem->depth;
+
+        if ((pXML->tagDepth >= depth) && (depth < seek))
+        {
+            /* The end tags in front of the element lead out of the seek level */
+            pXML->curElement = e;
+            return trdp_XMLPassEndTag(pXML, (pXML->tagDepth >= seek - 1) ? seek - 2 : pXML->tagDepth - 1);
+        }
+
+        /* Pass the start tag */
+        pXML->curElement    = e + 1u;
+        pXML->tagDepth      = depth;
+        pXML->pos           = pElem->attrOffset;
+
+        if (depth == seek)
+        {
+            return 0;
+        }
+        else if (depth < seek - 1)
+        {
+            return -2;
+        }
+        else if (depth > seek)
+        {
+            /* Jump behind the enclosing subtree one level below the seek depth */
+            while (((int) pElem->depth > seek + 1) && (pElem->parent != XML_NO_ELEMENT))
+            {
+                pElem = &pXML->pElement[pElem->parent];
+            }
+            e = pElem->next;
+            pXML->tagDepth = (int) pElem->depth - 1;
+        }
+        else
+        {
+            e++;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Check the tag name of an indexed element.
+ *
+ *  @param[in]      pXML        Pointer to local data
+ *  @param[in]      element     Index of the element
+ *  @param[in]      tag         Tag name
+ *  @param[in]      len         Length of tag
+ *  @param[in]      hash        Hash of tag
+ *
+ *  @retval         TRUE        names are equal
+ */
+static BOOL8 trdp_XMLIsTag (
+    const XML_HANDLE_T  *pXML,
+    UINT32              element,
+    const char          *tag,
+    UINT32              len,
+    UINT32              hash)
+{
+    const XML_ELEMENT_T *pElem = &pXML->pElement[element];
+
+    return ((pElem->hash == hash) && (pElem->tagLen == len) &&
+            (memcmp(pXML->pBuffer + pElem->tagOffset, tag, len) == 0)) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Copy the tag name of an indexed element to pXML->tokenTag.
+ *
+ *  @param[in]      pXML        Pointer to local data
+ *  @param[in]      element     Index of the element
+ *
+ *  @retval         none
+ */
+static void trdp_XMLSetTag (
+    XML_HANDLE_T    *pXML,
+    UINT32          element)
+{
+    const XML_ELEMENT_T *pElem  = &pXML->pElement[element];
+    UINT32              len     = (pElem->tagLen < MAX_TAG_LEN) ? pElem->tagLen : MAX_TAG_LEN;
+
+    memcpy(pXML->tokenTag, pXML->pBuffer + pElem->tagOffset, len);
+    pXML->tokenTag[len] = 0;
+}
+
 /*******************************************************************************
 *  GLOBAL FUNCTIONS
 */
 
 /**********************************************************************************************************************/
 /** Opens the XML parsing.
+ *    The file is mapped (or read, if mapping is not available) into memory and indexed.
  *
  *  @param[in]      pXML        Pointer to local data
  *  @param[in]      file        Pathname of XML file
  *
- *  @retval         none
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_IO_ERR     file could not be read
+ *  @retval         TRDP_MEM_ERR    out of memory
  */
 TRDP_ERR_T trdp_XMLOpen (
     XML_HANDLE_T    *pXML,
     const char      *file)
 {
-    if ((pXML->infile = fopen(file, "r+b")) == NULL)
+    TRDP_ERR_T err;
+
+    memset(pXML, 0, sizeof(XML_HANDLE_T));
+
+#ifdef POSIX
     {
-        return TRDP_IO_ERR;
+        struct stat fileStat;
+        int         fd = open(file, O_RDONLY);
+
+        if (fd == -1)
+        {
+            return TRDP_IO_ERR;
+        }
+        if ((fstat(fd, &fileStat) == -1) || (fileStat.st_size > (off_t) 0x7FFFFFFF))
+        {
+            (void) close(fd);
+            return TRDP_IO_ERR;
+        }
+        pXML->size = (UINT32) fileStat.st_size;
+        if (pXML->size > 0u)
+        {
+            void *pMap = mmap(NULL, pXML->size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (pMap == MAP_FAILED)
+            {
+                (void) close(fd);
+                return TRDP_IO_ERR;
+            }
+            pXML->pBuffer   = (const char *) pMap;
+            pXML->mapped    = TRUE;
+        }
+        (void) close(fd);
+    }
+#else
+    {
+        FILE    *infile = fopen(file, "rb");
+        long    size;
+        char    *pBuffer;
+
+        if (infile == NULL)
+        {
+            return TRDP_IO_ERR;
+        }
+        if ((fseek(infile, 0, SEEK_END) != 0) || ((size = ftell(infile)) < 0) || (fseek(infile, 0, SEEK_SET) != 0))
+        {
+            (void) fclose(infile);
+            return TRDP_IO_ERR;
+        }
+        pBuffer = (char *) malloc((size_t) size + 1u);
+        if (pBuffer == NULL)
+        {
+            (void) fclose(infile);
+            return TRDP_MEM_ERR;
+        }
+        if (fread(pBuffer, 1u, (size_t) size, infile) != (size_t) size)
+        {
+            free(pBuffer);
+            (void) fclose(infile);
+            return TRDP_IO_ERR;
+        }
+        (void) fclose(infile);
+        pXML->pBuffer   = pBuffer;
+        pXML->size      = (UINT32) size;
+    }
+#endif
+
+    err = trdp_XMLBuildIndex(pXML);
+    if (err != TRDP_NO_ERR)
+    {
+        trdp_XMLClose(pXML);
+        return err;
     }
 
     pXML->tagDepth      = 0;
@@ -331,16 +667,15 @@ TRDP_ERR_T trdp_XMLOpen (
 void trdp_XMLRewind (
     XML_HANDLE_T *pXML)
 {
-    if (pXML->infile == NULL)
+    if ((pXML->pBuffer == NULL) && (pXML->size > 0u))
     {
         pXML->error = TRDP_XML_PARSER_ERR;
     }
-    else if (fseek(pXML->infile, 0, SEEK_SET) == -1)
-    {
-        pXML->error = TRDP_IO_ERR;
-    }
     else
     {
+        pXML->pos           = 0u;
+        pXML->curElement    = 0u;
+        pXML->pendingClose  = FALSE;
         pXML->tagDepth      = 0;
         pXML->tagDepthSeek  = 0;
         pXML->error         = TRDP_NO_ERR;
@@ -357,7 +692,25 @@ void trdp_XMLRewind (
 void trdp_XMLClose (
     XML_HANDLE_T *pXML)
 {
-    fclose(pXML->infile);
+    if (pXML->pBuffer != NULL)
+    {
+#ifdef POSIX
+        if (pXML->mapped == TRUE)
+        {
+            (void) munmap((void *) pXML->pBuffer, pXML->size);
+        }
+        else
+#endif
+        {
+            free((void *) pXML->pBuffer);
+        }
+    }
+    free(pXML->pElement);
+    pXML->pBuffer       = NULL;
+    pXML->size          = 0u;
+    pXML->pElement      = NULL;
+    pXML->noOfElements  = 0u;
+    pXML->maxElements   = 0u;
 }
 
 /**********************************************************************************************************************/
@@ -376,28 +729,12 @@ int trdp_XMLSeekStartTagAny (
     char            *tag,
     int             maxlen)
 {
-    XML_TOKEN_T token;
-    int         ret = 99;
+    int ret = trdp_XMLNextElement(pXML);
 
-    while (ret == 99)
+    if (ret == 0)
     {
-        token = trdp_XMLNextTokenHl(pXML);
-
-        if (token == TOK_EOF)
-        {
-            ret = -1;            /* End of file, interrupt */
-        }
-        else if (pXML->tagDepth < (pXML->tagDepthSeek - 1))
-        {
-            ret = -2;            /* No more tokens on this depth, interrupt */
-        }
-        else if ((pXML->tagDepth == pXML->tagDepthSeek) && (token == TOK_START_TAG))
-        {
-            /* We are on the correct depth and have found a start tag */
-            vos_strncpy(tag, pXML->tokenTag, (UINT32) maxlen);
-            ret = 0;
-        }
-        /* else ignore */
+        trdp_XMLSetTag(pXML, pXML->curElement - 1u);
+        vos_strncpy(tag, pXML->tokenTag, (UINT32) maxlen);
     }
 
     return ret;
@@ -416,14 +753,20 @@ int trdp_XMLSeekStartTag (
     XML_HANDLE_T    *pXML,
     const char      *tag)
 {
-    int     ret;
-    char    buf[MAX_TAG_LEN + 1];
+    int             ret;
+    const UINT32    len     = (UINT32) strlen(tag);
+    const UINT32    hash    = trdp_XMLHash(tag, len);
+
     do
     {
-        ret = trdp_XMLSeekStartTagAny(pXML, buf, sizeof(buf));
+        ret = trdp_XMLNextElement(pXML);
     }
-    while ((ret == 0) && (strcmp(buf, tag) != 0));
+    while ((ret == 0) && (trdp_XMLIsTag(pXML, pXML->curElement - 1u, tag, len, hash) == FALSE));
 
+    if (ret == 0)
+    {
+        trdp_XMLSetTag(pXML, pXML->curElement - 1u);
+    }
     return ret;
 }
 
@@ -440,25 +783,26 @@ int trdp_XMLCountStartTag (
     XML_HANDLE_T    *pXML,
     const char      *tag)
 {
-    int             ret;
-    char            buf[MAX_TAG_LEN + 1u];
-    int             count = 0;
-
-    XML_HANDLE_T    safe        = *pXML;
-    off_t           last_read   = ftell(pXML->infile);
-
-    do
+    const UINT32    len         = (UINT32) strlen(tag);
+    const UINT32    hash        = trdp_XMLHash(tag, len);
+    const UINT32    curElement  = pXML->curElement;
+    const UINT32    pos         = pXML->pos;
+    const int       tagDepth    = pXML->tagDepth;
+    const BOOL8     pending     = pXML->pendingClose;
+    int             count       = 0;
+
+    while (trdp_XMLNextElement(pXML) == 0)
     {
-        ret = trdp_XMLSeekStartTagAny(pXML, buf, sizeof(buf));
-        if (ret == 0 && strcmp(buf, tag) == 0)
+        if (trdp_XMLIsTag(pXML, pXML->curElement - 1u, tag, len, hash) == TRUE)
         {
             count++;
         }
     }
-    while (ret == 0);
 
-    *pXML = safe;
-    fseek(pXML->infile, (long) last_read, SEEK_SET);
+    pXML->curElement    = curElement;
+    pXML->pos           = pos;
+    pXML->tagDepth      = tagDepth;
+    pXML->pendingClose  = pending;
     return count;
 }
 
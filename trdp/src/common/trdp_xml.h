@@ -4,7 +4,9 @@
  *
  * @brief           Simple XML parser
  *
- * @details
+ * @details         The file is mapped (or read) into memory once and indexed in a single pass:
+ *                  Seeking and counting start tags jumps through the element index instead of
+ *                  re-tokenizing the file.
  *
  * @note            Project: TCNOpen TRDP prototype stack
  *
@@ -16,6 +18,7 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: Tokenizer on a mapped buffer, element index for seek and count
  *      BL 2016-02-11: Ticket #102: Replacing libxml2
  *
  */
@@ -65,14 +68,39 @@ typedef enum
     TOK_ATTRIBUTE       /* "<" character    */
 } XML_TOKEN_T;
 
+/* Start tag of the element index, in document order */
+typedef struct XML_ELEMENT
+{
+    UINT32  tagOffset;          /* offset of the tag name in the buffer */
+    UINT32  attrOffset;         /* offset behind the tag name, where the attributes start */
+    UINT32  hash;               /* hash of the tag name */
+    UINT32  parent;             /* index of the enclosing element, XML_NO_ELEMENT for the root */
+    UINT32  next;               /* index of the first element behind this element's subtree */
+    UINT32  endOffset;          /* offset behind the end tag name or "/>" */
+    UINT16  tagLen;             /* length of the tag name */
+    UINT16  depth;              /* tag depth of the element, 1 for the root */
+} XML_ELEMENT_T;
+
+#define XML_NO_ELEMENT  0xFFFFFFFFu
+
 typedef struct XML_HANDLE
 {
-    FILE    *infile;
-    char    tokenValue[MAX_TOK_LEN];
-    int     tagDepth;
-    int     tagDepthSeek;
-    char    tokenTag[MAX_TAG_LEN + 1];
-    int     error;
+    const char      *pBuffer;       /* file contents */
+    UINT32          size;           /* size of the file */
+    UINT32          pos;            /* read position of the tokenizer */
+    BOOL8           mapped;         /* TRUE if pBuffer is mapped, FALSE if allocated */
+    XML_ELEMENT_T   *pElement;      /* element index */
+    UINT32          noOfElements;   /* number of indexed elements */
+    UINT32          maxElements;    /* allocated size of the index */
+    UINT32          curElement;     /* next element not yet passed */
+    BOOL8           pendingClose;   /* ">" of a passed end tag not yet read */
+    UINT32          idOffset;       /* buffer offset of the last identifier */
+    UINT32          idLen;          /* length of the last identifier */
+    char            tokenValue[MAX_TOK_LEN];
+    int             tagDepth;
+    int             tagDepthSeek;
+    char            tokenTag[MAX_TAG_LEN + 1];
+    int             error;
 } XML_HANDLE_T, *TRDP_XML_HANDLE_T;
 
 /*******************************************************************************
@@ -17,6 +17,7 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: vos_memLockAll() added
  *      BL 2017-05-08: Compiler warnings, doxygen comment errors
  */
 
@@ -173,6 +174,19 @@ EXT_DECL VOS_ERR_T vos_memCount(
     UINT32 blockSize[VOS_MEM_NBLOCKSIZES],
     UINT32 usedBlockSize[VOS_MEM_NBLOCKSIZES]);
 
+/**********************************************************************************************************************/
+/** Lock all current and future pages of the process into RAM.
+ *  Prevents page faults in time critical threads (e.g. the communication thread). Should be called once after
+ *  vos_memInit() and before the real-time threads are started.
+ *
+ *  @retval         VOS_NO_ERR          no error
+ *  @retval         VOS_MEM_ERR         memory could not be locked (e.g. missing privileges or RLIMIT_MEMLOCK)
+ *  @retval         VOS_INIT_ERR        not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_memLockAll (
+    void);
+
 /**********************************************************************************************************************/
 /*  Sorting/Searching                                                                                                 */
 /**********************************************************************************************************************/
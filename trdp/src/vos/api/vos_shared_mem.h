@@ -16,6 +16,7 @@
  *
  * $Id: vos_mem.h 282 2013-01-11 07:08:44Z 97029 $
  *
+ *      BL 2026-10-17: vos_sharedOpen() keeps the content of an existing area
  */
 
 #ifndef VOS_SHARED_MEM_H
@@ -63,6 +64,7 @@ typedef struct VOS_SHRD *VOS_SHRD_T;
 /** Create a shared memory area or attach to existing one.
  *  The first call with the a specified key will create a shared memory area with the supplied size and will return
  *  a handle and a pointer to that area. If the area already exists, the area will be opened.
+ *  A created area is cleared, the content of an opened area is kept.
  *    This function is not available in each target implementation.
  *
  *  @param[in]      pKey            Unique identifier (file name)
@@ -70,6 +72,7 @@ typedef struct VOS_SHRD *VOS_SHRD_T;
  *  @param[out]     ppMemoryArea    Pointer to pointer to memory area
  *  @param[in,out]  pSize           Pointer to size of area to allocate, on return actual size after attach
  *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter error
  *  @retval         VOS_MEM_ERR     no memory available
  */
 
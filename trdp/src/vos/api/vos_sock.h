@@ -16,6 +16,7 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: vos_selectTimeSource() added
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
  *      BL 2018-03-06: 64Bit endian swap added
  *      BL 2017-05-22: Ticket #122: Addendum for 64Bit compatibility (VOS_TIME_T -> VOS_TIMEVAL_T)
@@ -298,6 +299,27 @@ EXT_DECL INT32 vos_select (
     VOS_FDS_T       *pErrorFD,
     VOS_TIMEVAL_T   *pTimeOut);
 
+/**********************************************************************************************************************/
+/** select function on the time source set by vos_setTimeSource().
+ *  Polls the sockets and waits on the time source in between, until a socket is ready or the time out
+ *  elapsed in the time of the time source. Called by vos_select() for non-zero time outs.
+ *
+ *  @param[in]      highDesc          max. socket descriptor + 1
+ *  @param[in,out]  pReadableFD       pointer to readable socket set
+ *  @param[in,out]  pWriteableFD      pointer to writeable socket set
+ *  @param[in,out]  pErrorFD          pointer to error socket set
+ *  @param[in]      pTimeOut          pointer to time out value, NULL to wait forever
+ *
+ *  @retval         number of ready file descriptors
+ */
+
+EXT_DECL INT32 vos_selectTimeSource (
+    SOCKET          highDesc,
+    VOS_FDS_T       *pReadableFD,
+    VOS_FDS_T       *pWriteableFD,
+    VOS_FDS_T       *pErrorFD,
+    VOS_TIMEVAL_T   *pTimeOut);
+
 /*    Sockets    */
 
 /**********************************************************************************************************************/
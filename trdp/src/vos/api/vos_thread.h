@@ -16,6 +16,11 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: Pluggable time source, simulated clock
+ *      BL 2026-10-17: vos_getTimeNs(), VOS_TIME_TO_NS/VOS_NS_TO_TIME
+ *      BL 2026-10-17: vos_threadDelayUntil() (sleep, then spin)
+ *      BL 2026-10-17: Real-time thread attributes (affinity, SCHED_DEADLINE, stack prefault)
+ *      BL 2026-10-17: Drift free cyclic threads, vos_threadGetCycleStats()
  *      BL 2017-05-22: Ticket #122: Addendum for 64Bit compatibility (VOS_TIME_T -> VOS_TIMEVAL_T)
  */
 
@@ -54,6 +59,14 @@ extern "C" {
 /** Timeout value to wait forever for a semaphore */
 #define VOS_SEMA_WAIT_FOREVER  0xFFFFFFFFU
 
+/** Wake-up time of a time source wait without time out */
+#define VOS_TIME_NS_FOREVER     ((VOS_TIME_NS_T) 0x7FFFFFFFFFFFFFFFLL)
+
+/** Number of waiting threads the simulated clock prepares for, more are added on demand */
+#ifndef VOS_SIM_MAX_WAITERS
+#define VOS_SIM_MAX_WAITERS     64u
+#endif
+
 #if (defined(WIN32) || defined(WIN64))
 #include <winsock2.h>
 #else
@@ -96,6 +109,14 @@ extern "C" {
 #endif
 #endif
 
+/** Conversion between VOS_TIMEVAL_T and VOS_TIME_NS_T    */
+#define VOS_TIME_TO_NS(pTime)   ((VOS_TIME_NS_T) (pTime)->tv_sec * 1000000000 + (VOS_TIME_NS_T) (pTime)->tv_usec * 1000)
+#define VOS_NS_TO_TIME(ns, pTime)                                               \
+    do {                                                                        \
+        (pTime)->tv_sec     = (UINT32) ((ns) / 1000000000);                     \
+        (pTime)->tv_usec    = (INT32) (((ns) % 1000000000) / 1000);             \
+    } while (0)
+
 
 /***********************************************************************************************************************
  * TYPEDEFS
@@ -106,7 +127,8 @@ typedef enum
 {
     VOS_THREAD_POLICY_OTHER = 0,        /*  Default for the target system    */
     VOS_THREAD_POLICY_FIFO,             /*  First come, first serve          */
-    VOS_THREAD_POLICY_RR                /*  Round robin                      */
+    VOS_THREAD_POLICY_RR,               /*  Round robin                      */
+    VOS_THREAD_POLICY_DEADLINE = 6      /*  Earliest deadline first (Linux SCHED_DEADLINE, vos_threadSetAttr only) */
 } VOS_THREAD_POLICY_T;
 
 /** Thread priority range from 1 (highest) to 255 (lowest), 0 default of the target system    */
@@ -132,6 +154,62 @@ typedef struct VOS_SEMA *VOS_SEMA_T;
 /** Hidden thread handle definition    */
 typedef void *VOS_THREAD_T;
 
+/** Timing statistics of a cyclic thread (all times in us)    */
+typedef struct
+{
+    UINT32  interval;                   /**< cycle time                                             */
+    UINT32  cycles;                     /**< number of completed cycles                             */
+    UINT32  overruns;                   /**< number of times the thread function missed its cycle   */
+    UINT32  skipped;                    /**< number of release times skipped due to overruns        */
+    UINT32  lastLateness;               /**< wake-up delay after the last release time              */
+    UINT32  maxLateness;                /**< maximum wake-up delay                                  */
+    UINT32  avgLateness;                /**< average wake-up delay                                  */
+} VOS_THREAD_CYC_STATS_T;
+
+/** Real-time attributes of a thread, applied by vos_threadSetAttr()    */
+typedef struct
+{
+    UINT64                  cpuMask;    /**< CPUs the thread may run on (bit n = CPU n), 0 = no change      */
+    VOS_THREAD_POLICY_T     policy;     /**< scheduling policy, OTHER = no change                           */
+    VOS_THREAD_PRIORITY_T   priority;   /**< priority for FIFO and RR                                       */
+    UINT32                  runtime;    /**< DEADLINE: execution time budget per period in us               */
+    UINT32                  deadline;   /**< DEADLINE: relative deadline in us                              */
+    UINT32                  period;     /**< DEADLINE: period in us                                         */
+    UINT32                  prefaultStack;  /**< stack bytes to touch in advance (avoid page faults), 0 = none,
+                                                 must be well below the stack size of the thread              */
+} VOS_THREAD_ATTR_T;
+
+
+/** Why a thread waits on the time source    */
+typedef enum
+{
+    VOS_TIME_WAIT_DELAY     = 0,        /**< vos_threadDelay/DelayUntil: return at the wake-up time             */
+    VOS_TIME_WAIT_POLL      = 1,        /**< vos_select: return at the wake-up time or to re-poll the sockets    */
+    VOS_TIME_WAIT_REPOLL    = 2         /**< vos_select: as POLL, the previous poll found nothing                */
+} VOS_TIME_WAIT_T;
+
+/** Time source: returns the current time in ns    */
+typedef VOS_TIME_NS_T (*VOS_TIME_GET_FUNC_T)(
+    void *pRefCon);
+
+/** Time source: blocks the calling thread until wakeUp (absolute, ns) or, for POLL/REPOLL, until it should
+    check its sockets again    */
+typedef void (*VOS_TIME_WAIT_FUNC_T)(
+    void            *pRefCon,
+    VOS_TIME_NS_T   wakeUp,
+    VOS_TIME_WAIT_T reason);
+
+/** Replacement for the OS clock, see vos_setTimeSource()    */
+typedef struct
+{
+    VOS_TIME_GET_FUNC_T     pfGetTime;  /**< current time                                                    */
+    VOS_TIME_WAIT_FUNC_T    pfWait;     /**< used by vos_threadDelay, vos_threadDelayUntil and vos_select    */
+    void                    *pRefCon;   /**< passed to both functions                                        */
+} VOS_TIME_SOURCE_T;
+
+/** The active time source, NULL for the OS clock    */
+extern const VOS_TIME_SOURCE_T *gPVosTimeSource;
+
 
 /***********************************************************************************************************************
  * PROTOTYPES
@@ -172,7 +250,8 @@ EXT_DECL void vos_threadTerm (
  *  @param[in]      pName             Pointer to name of the thread (optional)
  *  @param[in]      policy            Scheduling policy (FIFO, Round Robin or other)
  *  @param[in]      priority          Scheduling priority (1...255 (highest), default 0)
- *  @param[in]      interval          Interval for cyclic threads in us (optional)
+ *  @param[in]      interval          Interval for cyclic threads in us (optional), if set pFunction is called
+ *                                    once per interval (see vos_cyclicThread)
  *  @param[in]      stackSize         Minimum stacksize, default 0: 16kB
  *  @param[in]      pFunction         Pointer to the thread function
  *  @param[in]      pArguments        Pointer to the thread function parameters
@@ -196,6 +275,7 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
 /**********************************************************************************************************************/
 /** Cyclic thread functions.
  *  Wrapper for cyclic threads. The thread function will be called cyclically with interval.
+ *  Release times are absolute and keep their phase; missed cycles are skipped and counted.
  *
  *  @param[in]      interval        Interval for cyclic threads in us (incl. runtime)
  *  @param[in]      pFunction       Pointer to the thread function
@@ -208,6 +288,57 @@ EXT_DECL void vos_cyclicThread (
     VOS_THREAD_FUNC_T   pFunction,
     void                *pArguments);
 
+/**********************************************************************************************************************/
+/** Get the timing statistics of a cyclic thread.
+ *
+ *  @param[in]      thread          Thread handle (or NULL if current thread)
+ *  @param[out]     pStats          Pointer to statistics to be filled in
+ *  @param[in]      reset           Clear the counters after reading
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_NOINIT_ERR  not a cyclic thread
+ */
+
+EXT_DECL VOS_ERR_T vos_threadGetCycleStats (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_CYC_STATS_T  *pStats,
+    BOOL8                   reset);
+
+/**********************************************************************************************************************/
+/** Set the CPU affinity of a thread.
+ *  Used to pin communication threads to isolated cores.
+ *
+ *  @param[in]      thread          Thread handle (or NULL if current thread)
+ *  @param[in]      cpuMask         CPUs the thread may run on (bit n = CPU n)
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   mask empty or invalid
+ *  @retval         VOS_THREAD_ERR  affinity could not be set
+ *  @retval         VOS_INIT_ERR    not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetAffinity (
+    VOS_THREAD_T    thread,
+    UINT64          cpuMask);
+
+/**********************************************************************************************************************/
+/** Apply real-time attributes to the calling thread.
+ *  Should be called at the beginning of the thread function. Sets the CPU affinity, the scheduling policy
+ *  (FIFO/RR with priority or DEADLINE with runtime/deadline/period) and prefaults the stack.
+ *  Usually combined with vos_memLockAll().
+ *
+ *  @param[in]      pAttr           Pointer to the attributes
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_THREAD_ERR  attributes could not be set (e.g. missing privileges)
+ *  @retval         VOS_INIT_ERR    not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetAttr (
+    const VOS_THREAD_ATTR_T *pAttr);
+
 /**********************************************************************************************************************/
 /** Terminate a thread.
  *  This call will terminate the thread with the given threadId and release all resources. Depending on the
@@ -256,6 +387,22 @@ EXT_DECL VOS_ERR_T vos_threadIsActive (
 EXT_DECL VOS_ERR_T vos_threadDelay (
     UINT32 delay);
 
+/**********************************************************************************************************************/
+/** Delay the execution of the current thread until an absolute point in time.
+ *  The thread sleeps until guardTime us before the wanted time and then busy-waits on the (monotonic) clock
+ *  to compensate the wake-up latency of the scheduler. A larger guard band gives better precision for more
+ *  CPU load; 0 disables spinning.
+ *
+ *  @param[in]      pTime             Absolute wake-up time (as returned by vos_getTime)
+ *  @param[in]      guardTime         Time in us to spin before pTime
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ */
+
+EXT_DECL VOS_ERR_T vos_threadDelayUntil (
+    const VOS_TIMEVAL_T *pTime,
+    UINT32              guardTime);
+
 /**********************************************************************************************************************/
 /** Return thread handle of calling task
  *
@@ -277,6 +424,71 @@ EXT_DECL VOS_ERR_T vos_threadSelf (
 EXT_DECL void vos_getTime (
     VOS_TIMEVAL_T *pTime);
 
+/**********************************************************************************************************************/
+/** Return the current (monotonic) time in ns
+ *  Same time base as vos_getTime, without the timeval conversion
+ *
+ *  @retval         current time in ns
+ */
+
+EXT_DECL VOS_TIME_NS_T vos_getTimeNs (
+    void);
+
+/**********************************************************************************************************************/
+/** Replace the OS clock.
+ *  vos_getTime, vos_getTimeNs, vos_threadDelay, vos_threadDelayUntil and the time out of vos_select use the given
+ *  time source from now on. Time outs of semaphores, mutexes and cyclic threads stay on the OS clock.
+ *  The time source should be set before any session is opened, it is not switched atomically.
+ *
+ *  @param[in]      pSource           Pointer to the time source (must stay valid), NULL restores the OS clock
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     function pointer missing
+ */
+
+EXT_DECL VOS_ERR_T vos_setTimeSource (
+    const VOS_TIME_SOURCE_T *pSource);
+
+/**********************************************************************************************************************/
+/** Start the simulated clock and install it as time source.
+ *  The clock stands still while any participant runs. When all participants wait (vos_threadDelay,
+ *  vos_threadDelayUntil or vos_select with time out), it jumps to the earliest wake-up time and releases
+ *  the threads due at that time. Threads blocked in vos_select re-poll their sockets whenever another
+ *  participant has run, so telegrams sent in simulated time t are received in t.
+ *  A single threaded test harness (one participant) therefore runs as fast as the CPU allows, with
+ *  reproducible timing.
+ *
+ *  @param[in]      startTime         Initial time of the clock in ns
+ *  @param[in]      participants      Number of threads to be waited for before the clock advances
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     no participants
+ *  @retval         VOS_INUSE_ERR     simulated clock already running
+ *  @retval         VOS_MUTEX_ERR     no mutex available
+ */
+
+EXT_DECL VOS_ERR_T vos_simClockStart (
+    VOS_TIME_NS_T   startTime,
+    UINT32          participants);
+
+/**********************************************************************************************************************/
+/** Stop the simulated clock and restore the OS clock.
+ *  All threads still waiting on the simulated clock are released.
+ */
+
+EXT_DECL void vos_simClockStop (
+    void);
+
+/**********************************************************************************************************************/
+/** Change the number of participants of the simulated clock.
+ *  To be called by a thread joining (+1) or leaving (-1) the simulation.
+ *
+ *  @param[in]      delta             number of threads joining (> 0) or leaving (< 0)
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_INIT_ERR      simulated clock not running
+ */
+
+EXT_DECL VOS_ERR_T vos_simClockJoin (
+    INT32 delta);
+
 
 /**********************************************************************************************************************/
 /** Get a time-stamp string.
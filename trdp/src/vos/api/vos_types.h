@@ -16,6 +16,7 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: VOS_TIME_NS_T added
  *      BL 2018-06-25: Ticket #202: vos_mutexTrylock return value
  *      BL 2018-05-03: no inline if < C99
  *      BL 2017-11-17: Undone: Ticket #169 Encapsulate declaration of packed structures within a macro
@@ -237,6 +238,11 @@ typedef struct
  */
 typedef struct timeval VOS_TIMEVAL_T;
 
+/** Monotonic time in nanoseconds.
+ *      Used internally for scheduling: compared, added and subtracted as plain integers
+ */
+typedef INT64 VOS_TIME_NS_T;
+
 #ifndef TIMEDATE32
 #define TIMEDATE32  UINT32
 #endif
@@ -16,6 +16,8 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: Binary log: wall-clock time stamps and string argument limit documented
+ *      BL 2026-10-17: Runtime log level checked before formatting, binary log mode (vos_logBinary)
  *     AHW 2018-11-28: Doxygen comment errors
  *      BL 2017-05-08: Compiler warnings, doxygen comment errors
  *      BL 2017-02-08: Ticket #142: Compiler warnings / MISRA-C 2012 issues
@@ -45,6 +47,8 @@ extern "C" {
 
 extern VOS_PRINT_DBG_T gPDebugFunction;
 extern void *gRefCon;
+extern VOS_LOG_T gVosLogLevel;
+extern BOOL8 gVosLogBinary;
 
 /** String size definitions for the debug output functions */
 #define VOS_MAX_PRNT_STR_SIZE   256u         /**< Max. size of the debug/error string of debug function */
@@ -70,39 +74,72 @@ extern void *gRefCon;
     snprintf(str, size, format, ## args)    /*lint !e586 logging output needed */
 #endif
 
+/** Log mode: formatted immediately or recorded raw and formatted by a background thread */
+typedef enum
+{
+    VOS_LOG_MODE_TEXT   = 0,    /**< format in the calling thread (default)                     */
+    VOS_LOG_MODE_BINARY = 1     /**< store format + raw arguments in a ring, drain in background */
+} VOS_LOG_MODE_T;
+
+#ifndef VOS_LOG_RING_SIZE
+#define VOS_LOG_RING_SIZE       512u         /**< Records in the binary log ring (power of 2) */
+#endif
+#ifndef VOS_LOG_DRAIN_INTERVAL
+#define VOS_LOG_DRAIN_INTERVAL  10000u       /**< Drain cycle of the binary log thread in us */
+#endif
+
+/** Log level gate: messages above the runtime level are dropped before any formatting */
+#define vos_logEnabled(level)   ((gPDebugFunction != NULL) && ((level) <= gVosLogLevel))
+
 /** Debug output macro without formatting options */
-#define vos_printLogStr(level, string)  {if (gPDebugFunction != NULL)         \
-                                         {gPDebugFunction(gRefCon,            \
-                                                          (level),            \
-                                                          vos_getTimeStamp(), \
-                                                          (__FILE__),         \
-                                                          (UINT16)(__LINE__), \
-                                                          (string)); }}
+#define vos_printLogStr(level, string)  {if (vos_logEnabled(level))                              \
+                                         {if (gVosLogBinary)                                     \
+                                          {vos_logBinary((level), (__FILE__), (UINT16)(__LINE__), \
+                                                         "%s", (string)); }                      \
+                                          else                                                   \
+                                          {gPDebugFunction(gRefCon,                              \
+                                                           (level),                              \
+                                                           vos_getTimeStamp(),                   \
+                                                           (__FILE__),                           \
+                                                           (UINT16)(__LINE__),                   \
+                                                           (string)); }}}
 
 /** Debug output macro with formatting options */
 #if (defined (WIN32) || defined (WIN64))
-    #define vos_printLog(level, format, ...)                                   \
-    {if (gPDebugFunction != NULL)                                              \
-     {   char str[VOS_MAX_PRNT_STR_SIZE];                                      \
-         (void) _snprintf_s(str, sizeof(str), _TRUNCATE, format, __VA_ARGS__); \
-         vos_printLogStr(level, str);                                          \
-     }                                                                         \
+    #define vos_printLog(level, format, ...)                                            \
+    {if (vos_logEnabled(level))                                                         \
+     {   if (gVosLogBinary)                                                             \
+         {vos_logBinary((level), (__FILE__), (UINT16)(__LINE__), format, __VA_ARGS__); } \
+         else                                                                           \
+         {   char str[VOS_MAX_PRNT_STR_SIZE];                                           \
+             (void) _snprintf_s(str, sizeof(str), _TRUNCATE, format, __VA_ARGS__);      \
+             vos_printLogStr(level, str);                                               \
+         }                                                                              \
+     }                                                                                  \
     }
 #elif defined(__clang__)
-    #define vos_printLog(level, format, ...)                    \
-    {if (gPDebugFunction != NULL)                               \
-     {   char str[VOS_MAX_PRNT_STR_SIZE];                       \
-         (void)snprintf(str, sizeof(str), format, __VA_ARGS__); \
-         vos_printLogStr(level, str);                           \
-     }                                                          \
+    #define vos_printLog(level, format, ...)                                            \
+    {if (vos_logEnabled(level))                                                         \
+     {   if (gVosLogBinary)                                                             \
+         {vos_logBinary((level), (__FILE__), (UINT16)(__LINE__), format, __VA_ARGS__); } \
+         else                                                                           \
+         {   char str[VOS_MAX_PRNT_STR_SIZE];                                           \
+             (void)snprintf(str, sizeof(str), format, __VA_ARGS__);                     \
+             vos_printLogStr(level, str);                                               \
+         }                                                                              \
+     }                                                                                  \
     }
 #else
-    #define vos_printLog(level, format, args ...)            \
-    {if (gPDebugFunction != NULL)                            \
-     {   char str[VOS_MAX_PRNT_STR_SIZE];                    \
-         (void) snprintf(str, sizeof(str), format, ## args); \
-         vos_printLogStr(level, str);                        \
-     }                                                       \
+    #define vos_printLog(level, format, args ...)                                       \
+    {if (vos_logEnabled(level))                                                         \
+     {   if (gVosLogBinary)                                                             \
+         {vos_logBinary((level), (__FILE__), (UINT16)(__LINE__), format, ## args); }    \
+         else                                                                           \
+         {   char str[VOS_MAX_PRNT_STR_SIZE];                                           \
+             (void) snprintf(str, sizeof(str), format, ## args);                        \
+             vos_printLogStr(level, str);                                               \
+         }                                                                              \
+     }                                                                                  \
     }
 #endif
 
@@ -218,6 +255,59 @@ EXT_DECL VOS_ERR_T vos_init (
 
 EXT_DECL void vos_terminate (void);
 
+/**********************************************************************************************************************/
+/** Set the runtime log level.
+ *  Messages of a category above maxLevel are dropped by the log macros before their arguments are evaluated
+ *  or formatted. Default is VOS_LOG_USR (everything is passed to the debug function).
+ *
+ *  @param[in]        maxLevel          highest category to output (VOS_LOG_ERROR ... VOS_LOG_USR)
+ */
+
+EXT_DECL void vos_setLogLevel (
+    VOS_LOG_T maxLevel);
+
+/**********************************************************************************************************************/
+/** Select text or binary logging.
+ *  In binary mode the log macros only store the format pointer, time, source position and the raw arguments
+ *  (strings are copied) in a lock-free ring. A background thread formats the records and calls the debug
+ *  function. If the ring is full, records are dropped and counted; the loss is reported with the next drain.
+ *  Time stamps are wall-clock, converted from vos_getTimeNs() with the offset taken when switching to binary mode
+ *  (later clock steps are not followed). The string arguments of a message share 128 bytes, longer ones are cut
+ *  and end in "..."; as in text mode, the formatted message is limited to VOS_MAX_PRNT_STR_SIZE.
+ *
+ *  @param[in]        mode              VOS_LOG_MODE_TEXT or VOS_LOG_MODE_BINARY
+ *  @retval           VOS_NO_ERR        no error
+ *  @retval           VOS_MEM_ERR       ring could not be allocated
+ *  @retval           VOS_THREAD_ERR    drain thread could not be started
+ */
+
+EXT_DECL VOS_ERR_T vos_setLogMode (
+    VOS_LOG_MODE_T mode);
+
+/**********************************************************************************************************************/
+/** Output all pending binary log records in the calling thread.
+ *
+ */
+
+EXT_DECL void vos_logFlush (void);
+
+/**********************************************************************************************************************/
+/** Record a log message in the binary ring (used by the log macros).
+ *
+ *  @param[in]        level             log category
+ *  @param[in]        pFile             source file (string literal)
+ *  @param[in]        line              source line
+ *  @param[in]        pFormat           printf format (string literal, serves as format ID)
+ *  @param[in]        ...               arguments
+ */
+
+EXT_DECL void vos_logBinary (
+    VOS_LOG_T   level,
+    const CHAR8 *pFile,
+    UINT16      line,
+    const CHAR8 *pFormat,
+    ...);
+
 /**********************************************************************************************************************/
 /** Return a human readable version representation.
  *    Return string in the form 'v.r.u.b'
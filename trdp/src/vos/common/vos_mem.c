@@ -18,6 +18,7 @@
  * $Id$
  *
  * Changes:
+ *      BL 2026-10-17: vos_memLockAll() added
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
  *      BL 2016-07-06: Ticket #122 64Bit compatibility (+ compiler warnings)
  *      BL 2016-02-10: Debug print: tabs before size output
@@ -45,6 +46,7 @@
 #include <strings.h>
 #include <unistd.h>
 #include <pthread.h>
+#include <sys/mman.h>
 #endif
 
 #ifdef ESP32
@@ -638,6 +640,30 @@ EXT_DECL VOS_ERR_T vos_memCount (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Lock all current and future pages of the process into RAM.
+ *
+ *  @retval         VOS_NO_ERR          no error
+ *  @retval         VOS_MEM_ERR         memory could not be locked (e.g. missing privileges or RLIMIT_MEMLOCK)
+ *  @retval         VOS_INIT_ERR        not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_memLockAll (
+    void)
+{
+#if defined(POSIX) && defined(MCL_FUTURE)
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+    {
+        vos_printLog(VOS_LOG_ERROR, "mlockall() failed (Err: %d)\n", errno);
+        return VOS_MEM_ERR;
+    }
+    return VOS_NO_ERR;
+#else
+    vos_printLogStr(VOS_LOG_WARNING, "vos_memLockAll() not supported on this target\n");
+    return VOS_INIT_ERR;
+#endif
+}
+
 
 /**********************************************************************************************************************/
 /** Sort an array.
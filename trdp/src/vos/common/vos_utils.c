@@ -17,6 +17,10 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: Binary log: wall-clock time stamps (offset taken in vos_setLogMode), cut strings end in "..."
+ *      BL 2026-10-17: Simulated clock: waiter slots added on demand instead of returning at once (busy spin)
+ *      BL 2026-10-17: Runtime log level, binary log ring drained by a background thread
+ *      BL 2026-10-17: Pluggable time source and simulated clock
  *      BL 2017-05-08: Compiler warnings
  *      BL 2017-02-27: #142 Compiler warnings / MISRA-C 2012 issues
  *      BL 2016-08-17: parentheses added (compiler warning)
@@ -32,6 +36,8 @@
  */
 
 #include <string.h>
+#include <stdarg.h>
+#include <time.h>
 
 #include "vos_utils.h"
 #include "vos_sock.h"
@@ -50,12 +56,37 @@
 
 #define NO_OF_ERROR_STRINGS  52u
 
+#define VOS_LOG_MAX_ARGS    8u      /**< arguments stored per binary log record                 */
+#define VOS_LOG_STR_SIZE    128u    /**< bytes per record for copied string arguments           */
+#define VOS_LOG_STR_CUT     "..."   /**< marks a string argument cut to VOS_LOG_STR_SIZE        */
+#define VOS_LOG_SPEC_SIZE   32u     /**< max. size of a single conversion specification         */
+
+/** Lock-free ring: the producers claim records by CAS on the head, the consumer is serialized by a mutex */
+#if (defined (WIN32) || defined (WIN64))
+#include <intrin.h>
+#define VOS_ATOMIC_LOAD(p)          ((UINT32) _InterlockedOr((volatile long *) (p), 0))
+#define VOS_ATOMIC_STORE(p, v)      ((void) _InterlockedExchange((volatile long *) (p), (long) (v)))
+#define VOS_ATOMIC_CAS(p, o, n)     ((UINT32) _InterlockedCompareExchange((volatile long *) (p), (long) (n), \
+                                                                          (long) (o)) == (o))
+#define VOS_ATOMIC_INC(p)           ((void) _InterlockedIncrement((volatile long *) (p)))
+#define VOS_ATOMIC_XCHG(p, v)       ((UINT32) _InterlockedExchange((volatile long *) (p), (long) (v)))
+#else
+#define VOS_ATOMIC_LOAD(p)          __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define VOS_ATOMIC_STORE(p, v)      __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define VOS_ATOMIC_CAS(p, o, n)     __sync_bool_compare_and_swap((p), (o), (n))
+#define VOS_ATOMIC_INC(p)           ((void) __sync_fetch_and_add((p), 1u))
+#define VOS_ATOMIC_XCHG(p, v)       __atomic_exchange_n((p), (v), __ATOMIC_ACQ_REL)
+#endif
+
 /***********************************************************************************************************************
  * GLOBALS
  */
 
 VOS_PRINT_DBG_T gPDebugFunction = NULL;
 void *gRefCon = NULL;
+const VOS_TIME_SOURCE_T *gPVosTimeSource = NULL;
+VOS_LOG_T gVosLogLevel = VOS_LOG_USR;
+BOOL8 gVosLogBinary = FALSE;
 
 /***********************************************************************************************************************
  *  LOCALS
@@ -63,6 +94,76 @@ void *gRefCon = NULL;
 
 static const VOS_VERSION_T vosVersion = {VOS_VERSION, VOS_RELEASE, VOS_UPDATE, VOS_EVOLUTION};
 
+/** A thread blocked on the simulated clock    */
+typedef struct VOS_SIM_WAITER
+{
+    VOS_SEMA_T      sema;           /**< released by the clock                                      */
+    VOS_TIME_NS_T   wakeUp;         /**< absolute wake-up time                                      */
+    VOS_TIME_WAIT_T reason;         /**< delay or socket poll                                       */
+    BOOL8           waiting;        /**< blocked, counted in noOfWaiting                            */
+    BOOL8           inUse;          /**< slot taken until the thread consumed its release           */
+    struct VOS_SIM_WAITER *pNext;   /**< next slot                                                  */
+} VOS_SIM_WAITER_T;
+
+/** State of the simulated clock    */
+typedef struct
+{
+    VOS_MUTEX_T         mutex;
+    VOS_TIME_NS_T       now;            /**< current simulated time                                 */
+    UINT32              participants;   /**< threads to wait for before the clock may advance       */
+    UINT32              noOfWaiting;    /**< threads currently blocked                              */
+    BOOL8               activity;       /**< a participant ran since the pollers checked their sockets */
+    BOOL8               running;
+    VOS_SIM_WAITER_T    *pWaiter;       /**< slots, VOS_SIM_MAX_WAITERS prepared, more added on demand */
+} VOS_SIM_CLOCK_T;
+
+static VOS_SIM_CLOCK_T sSimClock;
+
+static VOS_TIME_NS_T    vos_simGetTime (void *pRefCon);
+static void             vos_simWait (void *pRefCon, VOS_TIME_NS_T wakeUp, VOS_TIME_WAIT_T reason);
+
+static const VOS_TIME_SOURCE_T cSimTimeSource = {vos_simGetTime, vos_simWait, &sSimClock};
+
+/** Raw argument of a binary log record */
+typedef union
+{
+    INT64       i;              /**< integer conversions, '*' width and precision               */
+    double      d;              /**< floating point conversions                                 */
+    const void  *p;             /**< %p                                                         */
+    UINT32      strOfs;         /**< %s: offset of the copied string in str[]                   */
+} VOS_LOG_ARG_T;
+
+/** Binary log record */
+typedef struct
+{
+    volatile UINT32 seq;                        /**< ring sequence: pos = free, pos + 1 = filled        */
+    VOS_LOG_T       level;
+    UINT16          line;
+    UINT8           noOfArgs;
+    const CHAR8     *pFormat;                   /**< format string literal, serves as format ID         */
+    const CHAR8     *pFile;
+    VOS_TIME_NS_T   time;
+    VOS_LOG_ARG_T   arg[VOS_LOG_MAX_ARGS];
+    CHAR8           str[VOS_LOG_STR_SIZE];      /**< copies of the string arguments                     */
+} VOS_LOG_REC_T;
+
+/** State of the binary log */
+typedef struct
+{
+    VOS_LOG_REC_T   *pRing;                     /**< VOS_LOG_RING_SIZE records                          */
+    volatile UINT32 head;                       /**< next record to claim (producers)                   */
+    UINT32          tail;                       /**< next record to output (consumer)                   */
+    volatile UINT32 numDropped;                 /**< records lost because the ring was full             */
+    VOS_MUTEX_T     mutex;                      /**< serializes the consumers                           */
+    VOS_SEMA_T      wake;                       /**< wakes the drain thread early (stop)                */
+    VOS_SEMA_T      done;                       /**< given by the drain thread when it exits            */
+    VOS_THREAD_T    thread;
+    volatile BOOL8  running;
+    VOS_TIME_NS_T   wallOffset;                 /**< wall-clock minus vos_getTimeNs() at the mode switch */
+} VOS_LOG_RING_T;
+
+static VOS_LOG_RING_T sLog;
+
 /** Table of CRC-32s of all single-byte values according to IEEE802.3 / IEC 61375-2-3 A.3
  *  The FCS-32 generator polynomial:
  *  x**0 + x**1 + x**2 + x**4 + x**5 + x**7 + x**8 + x**10 + x**11 + x**12 + x**16
@@ -417,6 +518,554 @@ static VOS_ERR_T vos_initRuntimeConsts (void)
 #endif
 }
 
+/***********************************************************************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Add a waiter slot to the simulated clock (mutex must be held)
+ *
+ *  @param[in]      pClock          simulated clock
+ *  @retval         new slot or NULL if out of memory or semaphores
+ */
+static VOS_SIM_WAITER_T *vos_simAddWaiter (
+    VOS_SIM_CLOCK_T *pClock)
+{
+    VOS_SIM_WAITER_T *pWaiter = (VOS_SIM_WAITER_T *) vos_memAlloc(sizeof(VOS_SIM_WAITER_T));
+
+    if (pWaiter == NULL)
+    {
+        return NULL;
+    }
+    if (vos_semaCreate(&pWaiter->sema, VOS_SEMA_EMPTY) != VOS_NO_ERR)
+    {
+        vos_memFree(pWaiter);
+        return NULL;
+    }
+    pWaiter->pNext  = pClock->pWaiter;
+    pClock->pWaiter = pWaiter;
+    return pWaiter;
+}
+
+/**********************************************************************************************************************/
+/** Release a waiting thread of the simulated clock (mutex must be held)
+ *
+ *  @param[in]      pClock          simulated clock
+ *  @param[in]      pWaiter         waiting thread
+ */
+static void vos_simRelease (
+    VOS_SIM_CLOCK_T     *pClock,
+    VOS_SIM_WAITER_T    *pWaiter)
+{
+    pWaiter->waiting = FALSE;
+    pClock->noOfWaiting--;
+    vos_semaGive(pWaiter->sema);
+}
+
+/**********************************************************************************************************************/
+/** Advance the simulated clock if all participants are waiting (mutex must be held)
+ *  If some participant ran since the last poll, the socket pollers are released first to check for telegrams
+ *  sent at the current time. Otherwise the clock jumps to the earliest wake-up time.
+ *
+ *  @param[in]      pClock          simulated clock
+ */
+static void vos_simSchedule (
+    VOS_SIM_CLOCK_T *pClock)
+{
+    VOS_TIME_NS_T   next = VOS_TIME_NS_FOREVER;
+    UINT32          released = 0u;
+    VOS_SIM_WAITER_T *pW;
+
+    if ((pClock->noOfWaiting == 0u) || (pClock->noOfWaiting < pClock->participants))
+    {
+        return;
+    }
+
+    if (pClock->activity == TRUE)
+    {
+        pClock->activity = FALSE;
+        for (pW = pClock->pWaiter; pW != NULL; pW = pW->pNext)
+        {
+            if ((pW->waiting == TRUE) && (pW->reason != VOS_TIME_WAIT_DELAY))
+            {
+                vos_simRelease(pClock, pW);
+                released++;
+            }
+        }
+        if (released > 0u)
+        {
+            return;
+        }
+    }
+
+    for (pW = pClock->pWaiter; pW != NULL; pW = pW->pNext)
+    {
+        if ((pW->waiting == TRUE) && (pW->wakeUp < next))
+        {
+            next = pW->wakeUp;
+        }
+    }
+
+    if (next == VOS_TIME_NS_FOREVER)
+    {
+        vos_printLogStr(VOS_LOG_WARNING, "simulated clock: all participants wait forever\n");
+        return;
+    }
+
+    if (next > pClock->now)
+    {
+        pClock->now = next;
+    }
+
+    for (pW = pClock->pWaiter; pW != NULL; pW = pW->pNext)
+    {
+        if ((pW->waiting == TRUE) && (pW->wakeUp <= pClock->now))
+        {
+            vos_simRelease(pClock, pW);
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Time source function of the simulated clock: current time
+ *
+ *  @param[in]      pRefCon         simulated clock
+ *  @retval         current simulated time in ns
+ */
+static VOS_TIME_NS_T vos_simGetTime (
+    void *pRefCon)
+{
+    VOS_SIM_CLOCK_T *pClock = (VOS_SIM_CLOCK_T *) pRefCon;
+    VOS_TIME_NS_T   now;
+
+    (void) vos_mutexLock(pClock->mutex);
+    now = pClock->now;
+    (void) vos_mutexUnlock(pClock->mutex);
+    return now;
+}
+
+/**********************************************************************************************************************/
+/** Time source function of the simulated clock: block until released by vos_simSchedule()
+ *
+ *  @param[in]      pRefCon         simulated clock
+ *  @param[in]      wakeUp          absolute wake-up time in ns
+ *  @param[in]      reason          delay or socket poll
+ */
+static void vos_simWait (
+    void            *pRefCon,
+    VOS_TIME_NS_T   wakeUp,
+    VOS_TIME_WAIT_T reason)
+{
+    VOS_SIM_CLOCK_T     *pClock     = (VOS_SIM_CLOCK_T *) pRefCon;
+    VOS_SIM_WAITER_T    *pWaiter    = NULL;
+    VOS_SIM_WAITER_T    *pW;
+
+    (void) vos_mutexLock(pClock->mutex);
+
+    /*  Anything but a fruitless re-poll may have sent something  */
+    if (reason != VOS_TIME_WAIT_REPOLL)
+    {
+        pClock->activity = TRUE;
+    }
+
+    if ((pClock->running == TRUE) && (wakeUp > pClock->now))
+    {
+        for (pW = pClock->pWaiter; pW != NULL; pW = pW->pNext)
+        {
+            if (pW->inUse == FALSE)
+            {
+                pWaiter = pW;
+                break;
+            }
+        }
+        if (pWaiter == NULL)
+        {
+            /*  More threads than prepared slots: add one, the caller blocks like the others  */
+            pWaiter = vos_simAddWaiter(pClock);
+        }
+        if (pWaiter == NULL)
+        {
+            /*  Returning at once would let the caller spin on the clock, fail loudly instead  */
+            vos_printLogStr(VOS_LOG_ERROR, "simulated clock: no memory for a waiting thread, clock stopped\n");
+            pClock->running = FALSE;
+            if (gPVosTimeSource == &cSimTimeSource)
+            {
+                gPVosTimeSource = NULL;
+            }
+            for (pW = pClock->pWaiter; pW != NULL; pW = pW->pNext)
+            {
+                if (pW->waiting == TRUE)
+                {
+                    vos_simRelease(pClock, pW);
+                }
+            }
+        }
+        else
+        {
+            pWaiter->wakeUp     = wakeUp;
+            pWaiter->reason     = reason;
+            pWaiter->waiting    = TRUE;
+            pWaiter->inUse      = TRUE;
+            pClock->noOfWaiting++;
+            vos_simSchedule(pClock);
+        }
+    }
+    (void) vos_mutexUnlock(pClock->mutex);
+
+    if (pWaiter != NULL)
+    {
+        (void) vos_semaTake(pWaiter->sema, VOS_SEMA_WAIT_FOREVER);
+
+        (void) vos_mutexLock(pClock->mutex);
+        pWaiter->inUse = FALSE;
+        (void) vos_mutexUnlock(pClock->mutex);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Skip flags, width and precision of a conversion specification, fetch '*' arguments
+ *
+ *  @param[in]      pSpec           points behind the '%'
+ *  @param[in,out]  pArgs           argument list (capture) or NULL (output)
+ *  @param[in,out]  pRec            record (capture: '*' values are stored)
+ *  @param[in,out]  pNoOfArgs       number of stored arguments
+ *
+ *  @retval         pointer to the length modifier
+ */
+static const CHAR8 *vos_logSkipWidth (
+    const CHAR8     *pSpec,
+    va_list         *pArgs,
+    VOS_LOG_REC_T   *pRec,
+    UINT8           *pNoOfArgs)
+{
+    while ((*pSpec != '\0') && (strchr("-+ #0'", *pSpec) != NULL))
+    {
+        pSpec++;
+    }
+    while ((*pSpec != '\0') && (strchr("*.0123456789", *pSpec) != NULL))
+    {
+        if ((*pSpec == '*') && (pArgs != NULL) && (*pNoOfArgs < VOS_LOG_MAX_ARGS))
+        {
+            pRec->arg[(*pNoOfArgs)++].i = va_arg(*pArgs, int);
+        }
+        pSpec++;
+    }
+    return pSpec;
+}
+
+/**********************************************************************************************************************/
+/** Store the raw arguments of a log message according to its format
+ *
+ *  @param[in,out]  pRec            record to fill
+ *  @param[in,out]  pArgs           argument list
+ */
+static void vos_logCapture (
+    VOS_LOG_REC_T   *pRec,
+    va_list         *pArgs)
+{
+    const CHAR8 *pFmt   = pRec->pFormat;
+    UINT32      strUsed = 0u;
+    UINT8       n       = 0u;
+
+    while ((*pFmt != '\0') && (n < VOS_LOG_MAX_ARGS))
+    {
+        UINT32  longs   = 0u;
+        BOOL8   bigL    = FALSE;
+
+        if (*pFmt++ != '%')
+        {
+            continue;
+        }
+        if (*pFmt == '%')
+        {
+            pFmt++;
+            continue;
+        }
+        pFmt = vos_logSkipWidth(pFmt, pArgs, pRec, &n);
+        while ((*pFmt != '\0') && (strchr("hlLqjzt", *pFmt) != NULL))
+        {
+            longs   += (*pFmt == 'l') ? 1u : (((*pFmt == 'q') || (*pFmt == 'j')) ? 2u : 0u);
+            longs   += ((*pFmt == 'z') || (*pFmt == 't')) ? ((sizeof(size_t) > sizeof(long)) ? 2u : 1u) : 0u;
+            bigL    |= (*pFmt == 'L');
+            pFmt++;
+        }
+        if (n >= VOS_LOG_MAX_ARGS)
+        {
+            break;
+        }
+        switch (*pFmt)
+        {
+            case 'd':
+            case 'i':
+                pRec->arg[n++].i = (longs >= 2u) ? (INT64) va_arg(*pArgs, long long) :
+                    ((longs == 1u) ? (INT64) va_arg(*pArgs, long) : (INT64) va_arg(*pArgs, int));
+                break;
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+            case 'c':
+                pRec->arg[n++].i = (longs >= 2u) ? (INT64) va_arg(*pArgs, unsigned long long) :
+                    ((longs == 1u) ? (INT64) va_arg(*pArgs, unsigned long) : (INT64) va_arg(*pArgs, unsigned int));
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A':
+                pRec->arg[n++].d = (bigL) ? (double) va_arg(*pArgs, long double) : va_arg(*pArgs, double);
+                break;
+            case 'p':
+                pRec->arg[n++].p = va_arg(*pArgs, void *);
+                break;
+            case 's':
+            {
+                const CHAR8 *pStr   = va_arg(*pArgs, const CHAR8 *);
+                UINT32      len     = 0u;
+
+                if (pStr == NULL)
+                {
+                    pStr = "(null)";
+                }
+                /*  Copy as much as fits, the strings of a record share str[]  */
+                while ((pStr[len] != '\0') && (strUsed + len + 1u < VOS_LOG_STR_SIZE))
+                {
+                    pRec->str[strUsed + len] = pStr[len];
+                    len++;
+                }
+                pRec->str[(strUsed + len < VOS_LOG_STR_SIZE) ? strUsed + len : VOS_LOG_STR_SIZE - 1u] = '\0';
+                if ((pStr[len] != '\0') && (len >= sizeof(VOS_LOG_STR_CUT) - 1u))
+                {
+                    /*  Mark the cut  */
+                    memcpy(&pRec->str[strUsed + len - (sizeof(VOS_LOG_STR_CUT) - 1u)], VOS_LOG_STR_CUT,
+                           sizeof(VOS_LOG_STR_CUT) - 1u);
+                }
+                pRec->arg[n++].strOfs = (strUsed < VOS_LOG_STR_SIZE) ? strUsed : VOS_LOG_STR_SIZE - 1u;
+                strUsed += len + 1u;
+                break;
+            }
+            default:
+                /*  %n or unknown conversion: stop here, the rest of the format is output literally  */
+                pRec->noOfArgs = n;
+                return;
+        }
+        pFmt++;
+    }
+    pRec->noOfArgs = n;
+}
+
+/**********************************************************************************************************************/
+/** Format a binary log record
+ *
+ *  Each conversion specification is printed separately with its stored argument; integer conversions are
+ *  printed as long long, the length modifiers of the format are replaced.
+ *
+ *  @param[in]      pRec            record
+ *  @param[out]     pOut            output buffer
+ *  @param[in]      size            size of the output buffer
+ */
+static void vos_logFormat (
+    const VOS_LOG_REC_T *pRec,
+    CHAR8               *pOut,
+    UINT32              size)
+{
+    const CHAR8 *pFmt   = pRec->pFormat;
+    UINT32      used    = 0u;
+    UINT8       n       = 0u;
+
+    while ((*pFmt != '\0') && (used + 1u < size))
+    {
+        CHAR8       spec[VOS_LOG_SPEC_SIZE];
+        UINT32      specLen = 0u;
+        const CHAR8 *pStart;
+        int         len     = 0;
+
+        if ((*pFmt != '%') || (pFmt[1] == '%'))
+        {
+            pOut[used++] = *pFmt;
+            pFmt += (*pFmt == '%') ? 2 : 1;
+            continue;
+        }
+
+        /*  Rebuild the specification, '*' is replaced by the stored value  */
+        pStart = pFmt++;
+        spec[specLen++] = '%';
+        while ((*pFmt != '\0') && (strchr("-+ #0'*.0123456789", *pFmt) != NULL) && (specLen < VOS_LOG_SPEC_SIZE - 24u))
+        {
+            if (*pFmt == '*')
+            {
+                specLen += (UINT32) vos_snprintf(&spec[specLen], VOS_LOG_SPEC_SIZE - specLen, "%d",
+                                                 (n < pRec->noOfArgs) ? (int) pRec->arg[n].i : 0);
+                n++;
+            }
+            else
+            {
+                spec[specLen++] = *pFmt;
+            }
+            pFmt++;
+        }
+        while ((*pFmt != '\0') && (strchr("hlLqjzt", *pFmt) != NULL))
+        {
+            pFmt++;
+        }
+        if ((*pFmt == '\0') || (n >= pRec->noOfArgs))
+        {
+            /*  Arguments not recorded: output the rest literally  */
+            len = vos_snprintf(&pOut[used], size - used, "%s", pStart);
+            used = (len < 0) ? used : used + (UINT32) len;
+            break;
+        }
+
+        switch (*pFmt)
+        {
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+                spec[specLen++] = 'l';
+                spec[specLen++] = 'l';
+                spec[specLen++] = *pFmt;
+                spec[specLen]   = '\0';
+                if ((*pFmt == 'd') || (*pFmt == 'i'))
+                {
+                    len = vos_snprintf(&pOut[used], size - used, spec, (long long) pRec->arg[n].i);
+                }
+                else
+                {
+                    len = vos_snprintf(&pOut[used], size - used, spec, (unsigned long long) pRec->arg[n].i);
+                }
+                break;
+            case 'c':
+                spec[specLen++] = 'c';
+                spec[specLen]   = '\0';
+                len = vos_snprintf(&pOut[used], size - used, spec, (int) pRec->arg[n].i);
+                break;
+            case 'p':
+                spec[specLen++] = 'p';
+                spec[specLen]   = '\0';
+                len = vos_snprintf(&pOut[used], size - used, spec, pRec->arg[n].p);
+                break;
+            case 's':
+                spec[specLen++] = 's';
+                spec[specLen]   = '\0';
+                len = vos_snprintf(&pOut[used], size - used, spec, &pRec->str[pRec->arg[n].strOfs]);
+                break;
+            default:
+                spec[specLen++] = *pFmt;
+                spec[specLen]   = '\0';
+                len = vos_snprintf(&pOut[used], size - used, spec, pRec->arg[n].d);
+                break;
+        }
+        n++;
+        pFmt++;
+        if (len > 0)
+        {
+            used += (UINT32) len;
+        }
+    }
+    used = (used < size) ? used : size - 1u;
+    pOut[used] = '\0';
+}
+
+/**********************************************************************************************************************/
+/** Current wall-clock time in ns since the epoch (C11 timespec_get, else second resolution)
+ *
+ *  @retval         wall-clock time
+ */
+static VOS_TIME_NS_T vos_logWallClock (void)
+{
+#ifdef TIME_UTC
+    struct timespec ts;
+
+    if (timespec_get(&ts, TIME_UTC) == TIME_UTC)
+    {
+        return (VOS_TIME_NS_T) ts.tv_sec * 1000000000 + ts.tv_nsec;
+    }
+#endif
+    return (VOS_TIME_NS_T) time(NULL) * 1000000000;
+}
+
+/**********************************************************************************************************************/
+/** Output the pending binary log records
+ *
+ *  Must only be called with sLog.mutex held (single consumer).
+ */
+static void vos_logDrain (void)
+{
+    CHAR8           msg[VOS_MAX_PRNT_STR_SIZE];
+    CHAR8           timeStamp[32];
+    UINT32          dropped;
+
+    for (;; )
+    {
+        VOS_LOG_REC_T   *pRec = &sLog.pRing[sLog.tail & (VOS_LOG_RING_SIZE - 1u)];
+        VOS_TIME_NS_T   wallTime;
+        time_t          sec;
+        struct tm       *pTm;
+
+        if (VOS_ATOMIC_LOAD(&pRec->seq) != sLog.tail + 1u)
+        {
+            break;          /* empty or the producer is still writing */
+        }
+
+        wallTime    = pRec->time + sLog.wallOffset;
+        sec         = (time_t) (wallTime / 1000000000);
+        pTm         = localtime(&sec);
+        timeStamp[0] = '\0';
+        if (pTm != NULL)
+        {
+            (void) vos_snprintf(timeStamp, sizeof(timeStamp), "%04d%02d%02d-%02d:%02d:%02d.%03ld ",
+                                pTm->tm_year + 1900, pTm->tm_mon + 1, pTm->tm_mday,
+                                pTm->tm_hour, pTm->tm_min, pTm->tm_sec,
+                                (long) ((wallTime % 1000000000) / 1000000));
+        }
+        vos_logFormat(pRec, msg, sizeof(msg));
+
+        if (gPDebugFunction != NULL)
+        {
+            gPDebugFunction(gRefCon, pRec->level, timeStamp, pRec->pFile, pRec->line, msg);
+        }
+
+        /*  Hand the record back to the producers for the next round  */
+        VOS_ATOMIC_STORE(&pRec->seq, sLog.tail + VOS_LOG_RING_SIZE);
+        sLog.tail++;
+    }
+
+    dropped = VOS_ATOMIC_XCHG(&sLog.numDropped, 0u);
+    if ((dropped != 0u) && (gPDebugFunction != NULL))
+    {
+        (void) vos_snprintf(msg, sizeof(msg), "%u log messages lost (ring full)\n", (unsigned int) dropped);
+        gPDebugFunction(gRefCon, VOS_LOG_WARNING, vos_getTimeStamp(), __FILE__, (UINT16) __LINE__, msg);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Background thread of the binary log
+ *
+ *  @param[in]      pArg            not used
+ */
+static void vos_logThread (
+    void *pArg)
+{
+    (void) pArg;
+
+    while (sLog.running)
+    {
+        (void) vos_semaTake(sLog.wake, VOS_LOG_DRAIN_INTERVAL);
+        if (vos_mutexLock(sLog.mutex) == VOS_NO_ERR)
+        {
+            vos_logDrain();
+            (void) vos_mutexUnlock(sLog.mutex);
+        }
+    }
+    vos_semaGive(sLog.done);
+}
+
 /***********************************************************************************************************************
  * GLOBAL FUNCTIONS
  */
@@ -458,6 +1107,15 @@ VOS_ERR_T vos_init (
  */
 EXT_DECL void vos_terminate (void)
 {
+    (void) vos_setLogMode(VOS_LOG_MODE_TEXT);
+    if (sLog.pRing != NULL)
+    {
+        vos_mutexDelete(sLog.mutex);
+        vos_semaDelete(sLog.wake);
+        vos_semaDelete(sLog.done);
+        vos_memFree(sLog.pRing);
+        memset(&sLog, 0, sizeof(sLog));
+    }
     vos_sockTerm();
     vos_threadTerm();
     vos_memDelete(NULL);
@@ -565,3 +1223,398 @@ EXT_DECL const CHAR8 *vos_getErrorString (VOS_ERR_T error)
 #endif
     return buf;
 }
+
+/**********************************************************************************************************************/
+/** Replace the OS clock.
+ *
+ *  @param[in]      pSource           Pointer to the time source (must stay valid), NULL restores the OS clock
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     function pointer missing
+ */
+EXT_DECL VOS_ERR_T vos_setTimeSource (
+    const VOS_TIME_SOURCE_T *pSource)
+{
+    if ((pSource != NULL) &&
+        ((pSource->pfGetTime == NULL) || (pSource->pfWait == NULL)))
+    {
+        return VOS_PARAM_ERR;
+    }
+    gPVosTimeSource = pSource;
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Start the simulated clock and install it as time source.
+ *  Mutex and semaphores are kept after vos_simClockStop(), threads may still be leaving the clock.
+ *
+ *  @param[in]      startTime         Initial time of the clock in ns
+ *  @param[in]      participants      Number of threads to be waited for before the clock advances
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     no participants
+ *  @retval         VOS_INUSE_ERR     simulated clock already running
+ *  @retval         VOS_MUTEX_ERR     no mutex available
+ */
+EXT_DECL VOS_ERR_T vos_simClockStart (
+    VOS_TIME_NS_T   startTime,
+    UINT32          participants)
+{
+    VOS_SIM_CLOCK_T *pClock = &sSimClock;
+    VOS_ERR_T       err;
+    VOS_SIM_WAITER_T *pW;
+    UINT32          i = 0u;
+
+    if (participants == 0u)
+    {
+        return VOS_PARAM_ERR;
+    }
+    if (pClock->mutex == NULL)
+    {
+        err = vos_mutexCreate(&pClock->mutex);
+        if (err != VOS_NO_ERR)
+        {
+            return VOS_MUTEX_ERR;
+        }
+    }
+    (void) vos_mutexLock(pClock->mutex);
+    if (pClock->running == TRUE)
+    {
+        (void) vos_mutexUnlock(pClock->mutex);
+        return VOS_INUSE_ERR;
+    }
+    /*  Prepare the slots (kept from an earlier run), more are added by vos_simWait on demand  */
+    for (pW = pClock->pWaiter; pW != NULL; pW = pW->pNext)
+    {
+        i++;
+    }
+    for (; i < VOS_SIM_MAX_WAITERS; i++)
+    {
+        if (vos_simAddWaiter(pClock) == NULL)
+        {
+            (void) vos_mutexUnlock(pClock->mutex);
+            return VOS_SEMA_ERR;
+        }
+    }
+    pClock->now             = startTime;
+    pClock->participants    = participants;
+    pClock->noOfWaiting     = 0u;
+    pClock->activity        = FALSE;
+    pClock->running         = TRUE;
+    gPVosTimeSource         = &cSimTimeSource;
+    (void) vos_mutexUnlock(pClock->mutex);
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Stop the simulated clock and restore the OS clock.
+ */
+EXT_DECL void vos_simClockStop (
+    void)
+{
+    VOS_SIM_CLOCK_T *pClock = &sSimClock;
+    VOS_SIM_WAITER_T *pW;
+
+    if (pClock->mutex == NULL)
+    {
+        return;
+    }
+    (void) vos_mutexLock(pClock->mutex);
+    if (gPVosTimeSource == &cSimTimeSource)
+    {
+        gPVosTimeSource = NULL;
+    }
+    pClock->running = FALSE;
+    for (pW = pClock->pWaiter; pW != NULL; pW = pW->pNext)
+    {
+        if (pW->waiting == TRUE)
+        {
+            vos_simRelease(pClock, pW);
+        }
+    }
+    (void) vos_mutexUnlock(pClock->mutex);
+}
+
+/**********************************************************************************************************************/
+/** Change the number of participants of the simulated clock.
+ *
+ *  @param[in]      delta             number of threads joining (> 0) or leaving (< 0)
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_INIT_ERR      simulated clock not running
+ */
+EXT_DECL VOS_ERR_T vos_simClockJoin (
+    INT32 delta)
+{
+    VOS_SIM_CLOCK_T *pClock = &sSimClock;
+    VOS_ERR_T       err     = VOS_NO_ERR;
+
+    if (pClock->mutex == NULL)
+    {
+        return VOS_INIT_ERR;
+    }
+    (void) vos_mutexLock(pClock->mutex);
+    if (pClock->running == FALSE)
+    {
+        err = VOS_INIT_ERR;
+    }
+    else
+    {
+        if ((delta < 0) && ((UINT32) -delta > pClock->participants))
+        {
+            pClock->participants = 0u;
+        }
+        else
+        {
+            pClock->participants = (UINT32) ((INT32) pClock->participants + delta);
+        }
+        /*  The leaving thread might have been the last one the clock waited for  */
+        vos_simSchedule(pClock);
+    }
+    (void) vos_mutexUnlock(pClock->mutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** select function on the time source set by vos_setTimeSource().
+ *
+ *  @param[in]      highDesc          max. socket descriptor + 1
+ *  @param[in,out]  pReadableFD       pointer to readable socket set
+ *  @param[in,out]  pWriteableFD      pointer to writeable socket set
+ *  @param[in,out]  pErrorFD          pointer to error socket set
+ *  @param[in]      pTimeOut          pointer to time out value, NULL to wait forever
+ *
+ *  @retval         number of ready file descriptors
+ */
+EXT_DECL INT32 vos_selectTimeSource (
+    SOCKET          highDesc,
+    VOS_FDS_T       *pReadableFD,
+    VOS_FDS_T       *pWriteableFD,
+    VOS_FDS_T       *pErrorFD,
+    VOS_TIMEVAL_T   *pTimeOut)
+{
+    const VOS_TIME_SOURCE_T *pSource = gPVosTimeSource;
+    VOS_FDS_T               readFDs, writeFDs, errorFDs;
+    VOS_TIMEVAL_T           noWait;
+    VOS_TIME_NS_T           wakeUp  = VOS_TIME_NS_FOREVER;
+    VOS_TIME_WAIT_T         reason  = VOS_TIME_WAIT_POLL;
+    INT32                   ret;
+
+    if (pSource == NULL)
+    {
+        return vos_select(highDesc, pReadableFD, pWriteableFD, pErrorFD, pTimeOut);
+    }
+    if (pTimeOut != NULL)
+    {
+        wakeUp = pSource->pfGetTime(pSource->pRefCon) + VOS_TIME_TO_NS(pTimeOut);
+    }
+
+    for (;; )
+    {
+        /*  A zero time out is not redirected, vos_select() just polls  */
+        if (pReadableFD != NULL)
+        {
+            readFDs = *pReadableFD;
+        }
+        if (pWriteableFD != NULL)
+        {
+            writeFDs = *pWriteableFD;
+        }
+        if (pErrorFD != NULL)
+        {
+            errorFDs = *pErrorFD;
+        }
+        vos_clearTime(&noWait);
+        ret = vos_select(highDesc,
+                         (pReadableFD != NULL) ? &readFDs : NULL,
+                         (pWriteableFD != NULL) ? &writeFDs : NULL,
+                         (pErrorFD != NULL) ? &errorFDs : NULL,
+                         &noWait);
+
+        if ((ret != 0) ||
+            (gPVosTimeSource != pSource) ||
+            (pSource->pfGetTime(pSource->pRefCon) >= wakeUp))
+        {
+            break;
+        }
+        pSource->pfWait(pSource->pRefCon, wakeUp, reason);
+        reason = VOS_TIME_WAIT_REPOLL;
+    }
+
+    if (pReadableFD != NULL)
+    {
+        *pReadableFD = readFDs;
+    }
+    if (pWriteableFD != NULL)
+    {
+        *pWriteableFD = writeFDs;
+    }
+    if (pErrorFD != NULL)
+    {
+        *pErrorFD = errorFDs;
+    }
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Set the runtime log level.
+ *
+ *  @param[in]        maxLevel          highest category to output (VOS_LOG_ERROR ... VOS_LOG_USR)
+ */
+EXT_DECL void vos_setLogLevel (
+    VOS_LOG_T maxLevel)
+{
+    gVosLogLevel = maxLevel;
+}
+
+/**********************************************************************************************************************/
+/** Select text or binary logging.
+ *  The ring and its synchronization objects are created with the first switch to binary mode and kept
+ *  until vos_terminate(), so that late loggers never write to freed memory.
+ *  The offset of the wall-clock to vos_getTimeNs() is taken with each switch to binary mode.
+ *
+ *  @param[in]        mode              VOS_LOG_MODE_TEXT or VOS_LOG_MODE_BINARY
+ *  @retval           VOS_NO_ERR        no error
+ *  @retval           VOS_MEM_ERR       ring could not be allocated
+ *  @retval           VOS_THREAD_ERR    drain thread could not be started
+ */
+EXT_DECL VOS_ERR_T vos_setLogMode (
+    VOS_LOG_MODE_T mode)
+{
+    VOS_ERR_T   err;
+    UINT32      i;
+
+    if (mode == VOS_LOG_MODE_TEXT)
+    {
+        if (sLog.running)
+        {
+            gVosLogBinary   = FALSE;
+            sLog.running    = FALSE;
+            vos_semaGive(sLog.wake);
+            (void) vos_semaTake(sLog.done, VOS_SEMA_WAIT_FOREVER);
+            vos_logFlush();
+        }
+        return VOS_NO_ERR;
+    }
+
+    if (sLog.running)
+    {
+        return VOS_NO_ERR;
+    }
+
+    if (sLog.pRing == NULL)
+    {
+        sLog.pRing = (VOS_LOG_REC_T *) vos_memAlloc(VOS_LOG_RING_SIZE * sizeof(VOS_LOG_REC_T));
+        if (sLog.pRing == NULL)
+        {
+            return VOS_MEM_ERR;
+        }
+        for (i = 0u; i < VOS_LOG_RING_SIZE; i++)
+        {
+            sLog.pRing[i].seq = i;
+        }
+        sLog.head   = 0u;
+        sLog.tail   = 0u;
+        if ((vos_mutexCreate(&sLog.mutex) != VOS_NO_ERR) ||
+            (vos_semaCreate(&sLog.wake, VOS_SEMA_EMPTY) != VOS_NO_ERR) ||
+            (vos_semaCreate(&sLog.done, VOS_SEMA_EMPTY) != VOS_NO_ERR))
+        {
+            vos_memFree(sLog.pRing);
+            sLog.pRing = NULL;
+            return VOS_MEM_ERR;
+        }
+    }
+
+    /*  Records keep the cheap monotonic time, the drain converts it to wall-clock  */
+    sLog.wallOffset = vos_logWallClock() - vos_getTimeNs();
+
+    sLog.running = TRUE;
+    err = vos_threadCreate(&sLog.thread, "vosLog", VOS_THREAD_POLICY_OTHER, 0, 0u, 0u, vos_logThread, NULL);
+    if (err != VOS_NO_ERR)
+    {
+        sLog.running = FALSE;
+        return VOS_THREAD_ERR;
+    }
+    gVosLogBinary = TRUE;
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Output all pending binary log records in the calling thread.
+ *
+ */
+EXT_DECL void vos_logFlush (void)
+{
+    if ((sLog.pRing != NULL) &&
+        (vos_mutexLock(sLog.mutex) == VOS_NO_ERR))
+    {
+        vos_logDrain();
+        (void) vos_mutexUnlock(sLog.mutex);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Record a log message in the binary ring.
+ *  Lock-free for any number of producers: a record is claimed by advancing the head with CAS, filled and
+ *  released by setting its sequence. No formatting takes place here.
+ *  The string arguments of a record share VOS_LOG_STR_SIZE bytes, a string that does not fit is cut and
+ *  ends in "...".
+ *
+ *  @param[in]        level             log category
+ *  @param[in]        pFile             source file (string literal)
+ *  @param[in]        line              source line
+ *  @param[in]        pFormat           printf format (string literal, serves as format ID)
+ *  @param[in]        ...               arguments
+ */
+EXT_DECL void vos_logBinary (
+    VOS_LOG_T   level,
+    const CHAR8 *pFile,
+    UINT16      line,
+    const CHAR8 *pFormat,
+    ...)
+{
+    VOS_LOG_REC_T   *pRec;
+    UINT32          pos;
+    va_list         args;
+
+    if (sLog.pRing == NULL)
+    {
+        return;
+    }
+
+    pos = VOS_ATOMIC_LOAD(&sLog.head);
+    for (;; )
+    {
+        INT32 diff;
+
+        pRec    = &sLog.pRing[pos & (VOS_LOG_RING_SIZE - 1u)];
+        diff    = (INT32) (VOS_ATOMIC_LOAD(&pRec->seq) - pos);
+        if (diff == 0)
+        {
+            if (VOS_ATOMIC_CAS(&sLog.head, pos, pos + 1u))
+            {
+                break;
+            }
+            pos = VOS_ATOMIC_LOAD(&sLog.head);
+        }
+        else if (diff < 0)
+        {
+            /*  Ring full, the drain thread is behind  */
+            VOS_ATOMIC_INC(&sLog.numDropped);
+            return;
+        }
+        else
+        {
+            pos = VOS_ATOMIC_LOAD(&sLog.head);
+        }
+    }
+
+    pRec->level     = level;
+    pRec->line      = line;
+    pRec->pFile     = pFile;
+    pRec->pFormat   = pFormat;
+    pRec->time      = vos_getTimeNs();
+
+    va_start(args, pFormat);
+    vos_logCapture(pRec, &args);
+    va_end(args);
+
+    VOS_ATOMIC_STORE(&pRec->seq, pos + 1u);
+}
@@ -16,6 +16,7 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: vos_select() waits on the time source if one is set
  *      BL 2018-11-26: Ticket #208: Mapping corrected after complaint (Bit 2 was set for prio 2 & 4)
  *      BL 2018-07-13: Ticket #208: VOS socket options: QoS/ToS field priority handling needs update
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
@@ -169,6 +170,11 @@ EXT_DECL INT32 vos_select (
     VOS_FDS_T       *pErrorFD,
     VOS_TIMEVAL_T   *pTimeOut)
 {
+    if ((gPVosTimeSource != NULL) &&
+        ((pTimeOut == NULL) || (pTimeOut->tv_sec != 0) || (pTimeOut->tv_usec != 0)))
+    {
+        return vos_selectTimeSource(highDesc, pReadableFD, pWriteableFD, pErrorFD, pTimeOut);
+    }
     return select(highDesc, (fd_set *) pReadableFD, (fd_set *) pWriteableFD,
                   (fd_set *) pErrorFD, (struct timeval *) pTimeOut);
 }
@@ -16,6 +16,11 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: Time source hooks in vos_getTime(Ns), vos_threadDelay(Until)
+ *      BL 2026-10-17: vos_getTimeNs()
+ *      BL 2026-10-17: vos_threadDelayUntil() (sleep, then spin)
+ *      BL 2026-10-17: vos_threadSetAffinity(), vos_threadSetAttr() stubs
+ *      BL 2026-10-17: vos_threadGetCycleStats() stub
  *      BL 2018-06-25: Ticket #202: vos_mutexTrylock return value
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
  */
@@ -150,6 +155,68 @@ EXT_DECL void vos_cyclicThread (
     }
 }
 
+/**********************************************************************************************************************/
+/** Get the timing statistics of a cyclic thread.
+ *  Not supported on this target, cyclic threads do not collect statistics.
+ *
+ *  @param[in]      thread          Thread handle (or NULL if current thread)
+ *  @param[out]     pStats          Pointer to statistics to be filled in
+ *  @param[in]      reset           Clear the counters after reading
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_NOINIT_ERR  not a cyclic thread
+ */
+
+EXT_DECL VOS_ERR_T vos_threadGetCycleStats (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_CYC_STATS_T  *pStats,
+    BOOL8                   reset)
+{
+    (void) thread;
+    (void) reset;
+    if (pStats == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    return VOS_NOINIT_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Set the CPU affinity of a thread.
+ *  Not supported on this target.
+ *
+ *  @param[in]      thread          Thread handle (or NULL if current thread)
+ *  @param[in]      cpuMask         CPUs the thread may run on (bit n = CPU n)
+ *  @retval         VOS_INIT_ERR    not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetAffinity (
+    VOS_THREAD_T    thread,
+    UINT64          cpuMask)
+{
+    (void) thread;
+    (void) cpuMask;
+    return VOS_INIT_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Apply real-time attributes to the calling thread.
+ *  Not supported on this target.
+ *
+ *  @param[in]      pAttr           Pointer to the attributes
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_INIT_ERR    not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetAttr (
+    const VOS_THREAD_ATTR_T *pAttr)
+{
+    if (pAttr == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    return VOS_INIT_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Initialize the thread library.
  *  Must be called once before any other call
@@ -445,10 +512,69 @@ EXT_DECL VOS_ERR_T vos_threadDelay (
         return VOS_NO_ERR;
     }
 
+    if (gPVosTimeSource != NULL)
+    {
+        const VOS_TIME_SOURCE_T *pSource = gPVosTimeSource;
+
+        pSource->pfWait(pSource->pRefCon, pSource->pfGetTime(pSource->pRefCon) + (VOS_TIME_NS_T) delay * 1000,
+                        VOS_TIME_WAIT_DELAY);
+        return VOS_NO_ERR;
+    }
+
     vTaskDelay(delay);
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Delay the execution of the current thread until an absolute point in time.
+ *  Sleeps until guardTime us before the wanted time, then spins.
+ *
+ *  @param[in]      pTime             Absolute wake-up time (as returned by vos_getTime)
+ *  @param[in]      guardTime         Time in us to spin before pTime
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ */
+
+EXT_DECL VOS_ERR_T vos_threadDelayUntil (
+    const VOS_TIMEVAL_T *pTime,
+    UINT32              guardTime)
+{
+    VOS_TIMEVAL_T   now;
+    INT64           wakeUp;
+    INT64           current;
+
+    if (pTime == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    if (gPVosTimeSource != NULL)
+    {
+        /* no scheduler latency to compensate */
+        gPVosTimeSource->pfWait(gPVosTimeSource->pRefCon, VOS_TIME_TO_NS(pTime), VOS_TIME_WAIT_DELAY);
+        return VOS_NO_ERR;
+    }
+
+    vos_getTime(&now);
+    wakeUp  = (INT64) pTime->tv_sec * 1000000 + pTime->tv_usec - (INT64) guardTime;
+    current = (INT64) now.tv_sec * 1000000 + now.tv_usec;
+
+    /* coarse part: sleep until the guard band begins */
+    if (wakeUp - current >= 1)
+    {
+        (void) vos_threadDelay((UINT32) (wakeUp - current));
+    }
+
+    /* fine part: spin on the clock */
+    do
+    {
+        vos_getTime(&now);
+    }
+    while (vos_cmpTime(&now, pTime) < 0);
+
+    return VOS_NO_ERR;
+}
+
 
 /**********************************************************************************************************************/
 /** Return the current time in sec and us
@@ -466,6 +592,12 @@ EXT_DECL void vos_getTime (
     {
         vos_printLogStr(VOS_LOG_ERROR, "ERROR NULL pointer\n");
     }
+    else if (gPVosTimeSource != NULL)
+    {
+        VOS_TIME_NS_T now = gPVosTimeSource->pfGetTime(gPVosTimeSource->pRefCon);
+
+        VOS_NS_TO_TIME(now, pTime);
+    }
     else
     {
 #ifndef CLOCK_MONOTONIC
@@ -492,6 +624,32 @@ EXT_DECL void vos_getTime (
     }
 }
 
+/**********************************************************************************************************************/
+/** Return the current (monotonic) time in ns
+ *
+ *  @retval         current time in ns
+ */
+
+EXT_DECL VOS_TIME_NS_T vos_getTimeNs (
+    void)
+{
+    if (gPVosTimeSource != NULL)
+    {
+        return gPVosTimeSource->pfGetTime(gPVosTimeSource->pRefCon);
+    }
+#ifndef CLOCK_MONOTONIC
+    struct timeval myTime;
+
+    (void)gettimeofday(&myTime, NULL);
+    return (VOS_TIME_NS_T) myTime.tv_sec * 1000000000 + (VOS_TIME_NS_T) myTime.tv_usec * 1000;
+#else
+    struct timespec currentTime;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &currentTime);
+    return (VOS_TIME_NS_T) currentTime.tv_sec * 1000000000 + (VOS_TIME_NS_T) currentTime.tv_nsec;
+#endif
+}
+
 /**********************************************************************************************************************/
 /** Get a time-stamp string.
  *  Get a time-stamp string for debugging in the form "yyyymmdd-hh:mm:ss.ms"
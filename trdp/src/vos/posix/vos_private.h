@@ -16,6 +16,7 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: VOS_SHRD keeps size and creator of the area
  */
 
 #ifndef VOS_PRIVATE_H
@@ -57,6 +58,8 @@ struct VOS_SHRD
 {
     INT32   fd;                     /* File descriptor */
     CHAR8   *sharedMemoryName;      /* shared memory Name */
+    UINT32  size;                   /* size of the mapped area */
+    BOOL8   created;                /* TRUE if created (and to be removed) by this handle */
 };
 
 VOS_ERR_T   vos_mutexLocalCreate (struct VOS_MUTEX *pMutex);
@@ -16,6 +16,7 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: Attaching keeps the content, only the creator clears and removes the area, name and size kept
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
  *      BL 2018-05-03: Ticket #193 Unused parameter warnings
  *      BL 2016-07-06: Ticket #122 64Bit compatibility (+ compiler warnings)
@@ -74,6 +75,7 @@
 /** Create a shared memory area or attach to existing one.
  *  The first call with the a specified key will create a shared memory area with the supplied size and will return
  *  a handle and a pointer to that area. If the area already exists, the area will be attached.
+ *  A created area is cleared, the content of an attached area is kept (e.g. left behind by a crashed process).
  *    This function is not available in each target implementation.
  *
  *  @param[in]      pKey               Unique identifier (file name)
@@ -81,6 +83,7 @@
  *  @param[out]     ppMemoryArea       Pointer to pointer to memory area
  *  @param[in,out]  pSize              Pointer to size of area to allocate, on return actual size after attach
  *  @retval         VOS_NO_ERR         no error
+ *  @retval         VOS_PARAM_ERR      parameter error
  *  @retval         VOS_MEM_ERR        no memory available
  */
 EXT_DECL VOS_ERR_T vos_sharedOpen (
@@ -89,55 +92,86 @@ EXT_DECL VOS_ERR_T vos_sharedOpen (
     UINT8       * *ppMemoryArea,
     UINT32      *pSize)
 {
-    VOS_ERR_T       ret         = VOS_MEM_ERR;
     mode_t          PERMISSION  = 0666;      /* Shared Memory permission is rw-rw-rw- */
-    static INT32    fd;                      /* Shared Memory file descriptor */
+    INT32           fd;                      /* Shared Memory file descriptor */
+    BOOL8           created     = TRUE;
     struct    stat  sharedMemoryStat;        /* Shared Memory Stat */
+    UINT8           *pArea;
+    UINT32          keyLen;
 
-    /* Shared Memory Open */
-    fd = shm_open(pKey, O_CREAT | O_RDWR, PERMISSION);
+    if ((pKey == NULL) || (pHandle == NULL) || (ppMemoryArea == NULL) || (pSize == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    /* Shared Memory Open, attach if it exists already */
+    fd = shm_open(pKey, O_CREAT | O_EXCL | O_RDWR, PERMISSION);
+    if ((fd == -1) && (errno == EEXIST))
+    {
+        created = FALSE;
+        fd      = shm_open(pKey, O_RDWR, PERMISSION);
+    }
     if (fd == -1)
     {
         vos_printLogStr(VOS_LOG_ERROR, "Shared Memory Create failed\n");
-        return ret;
+        return VOS_MEM_ERR;
     }
-    /* Shared Memory acquire */
-    if (ftruncate(fd, (off_t )*pSize) == -1)
+    /* Get Shared Memory Stats */
+    if (fstat(fd, &sharedMemoryStat) == -1)
     {
-        vos_printLogStr(VOS_LOG_ERROR, "Shared Memory Acquire failed\n");
-        return ret;
+        sharedMemoryStat.st_size = 0;
     }
-    /* Get Shared Memory Stats */
-    (void) fstat(fd, &sharedMemoryStat);
-    if (sharedMemoryStat.st_size != (off_t )*pSize)
+    /* Shared Memory acquire: a new (or empty) area gets the requested size, an existing one keeps its size */
+    if (sharedMemoryStat.st_size == 0)
+    {
+        created = TRUE;
+        if (ftruncate(fd, (off_t )*pSize) == -1)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "Shared Memory Acquire failed\n");
+            (void) close(fd);
+            return VOS_MEM_ERR;
+        }
+        sharedMemoryStat.st_size = (off_t) *pSize;
+    }
+    if (sharedMemoryStat.st_size == 0)
     {
         vos_printLogStr(VOS_LOG_ERROR, "Shared Memory Size failed\n");
-        return ret;
+        (void) close(fd);
+        return VOS_MEM_ERR;
     }
 
     /* Mapping Shared Memory */
-    *ppMemoryArea = (UINT8*) mmap(NULL, (size_t) sharedMemoryStat.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
-    if (*ppMemoryArea == MAP_FAILED)
+    pArea = (UINT8 *) mmap(NULL, (size_t) sharedMemoryStat.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (pArea == MAP_FAILED)
     {
         vos_printLogStr(VOS_LOG_ERROR, "Shared Memory memory-mapping failed\n");
-        return ret;
+        (void) close(fd);
+        return VOS_MEM_ERR;
     }
-    /* Initialize Shared Memory */
-    memset(*ppMemoryArea, 0, sharedMemoryStat.st_size);
     /* Handle */
-    *pHandle = (VOS_SHRD_T) vos_memAlloc(sizeof (struct VOS_SHRD));
+    keyLen      = (UINT32) strlen(pKey) + 1u;
+    *pHandle    = (VOS_SHRD_T) vos_memAlloc(sizeof (struct VOS_SHRD) + keyLen);
     if (*pHandle == NULL)
     {
         vos_printLogStr(VOS_LOG_ERROR, "Shared Memory Handle create failed\n");
-        return ret;
+        (void) munmap(pArea, (size_t) sharedMemoryStat.st_size);
+        (void) close(fd);
+        return VOS_MEM_ERR;
     }
-    else
+    (*pHandle)->fd                  = fd;
+    (*pHandle)->size                = (UINT32) sharedMemoryStat.st_size;
+    (*pHandle)->created             = created;
+    (*pHandle)->sharedMemoryName    = (CHAR8 *) (*pHandle + 1);
+    memcpy((*pHandle)->sharedMemoryName, pKey, keyLen);
+
+    /* Initialize Shared Memory we created */
+    if (created == TRUE)
     {
-        (*pHandle)->fd = fd;
+        memset(pArea, 0, (size_t) sharedMemoryStat.st_size);
     }
-
-    ret = VOS_NO_ERR;
-    return ret;
+    *ppMemoryArea   = pArea;
+    *pSize          = (UINT32) sharedMemoryStat.st_size;
+    return VOS_NO_ERR;
 }
 
 /**********************************************************************************************************************/
@@ -149,6 +183,7 @@ EXT_DECL VOS_ERR_T vos_sharedOpen (
  *  @param[in]      handle             Returned handle
  *  @param[in]      pMemoryArea        Pointer to memory area
  *  @retval         VOS_NO_ERR         no error
+ *  @retval         VOS_PARAM_ERR      parameter error
  *  @retval         VOS_MEM_ERR        no memory available
  */
 
@@ -156,17 +191,27 @@ EXT_DECL VOS_ERR_T vos_sharedClose (
     VOS_SHRD_T  handle,
     const UINT8 *pMemoryArea)
 {
-    pMemoryArea = pMemoryArea;
+    VOS_ERR_T ret = VOS_NO_ERR;
 
+    if (handle == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    if ((pMemoryArea != NULL) && (munmap((void *) pMemoryArea, (size_t) handle->size) == -1))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Shared Memory unmap failed\n");
+        ret = VOS_MEM_ERR;
+    }
     if (close(handle->fd) == -1)
     {
         vos_printLogStr(VOS_LOG_ERROR, "Shared Memory file close failed\n");
-        return VOS_MEM_ERR;
+        ret = VOS_MEM_ERR;
     }
-    if (shm_unlink(handle->sharedMemoryName) == -1)
+    if ((handle->created == TRUE) && (shm_unlink(handle->sharedMemoryName) == -1))
     {
         vos_printLogStr(VOS_LOG_ERROR, "Shared Memory unLink failed\n");
-        return VOS_MEM_ERR;
+        ret = VOS_MEM_ERR;
     }
-    return VOS_NO_ERR;
+    vos_memFree(handle);
+    return ret;
 }
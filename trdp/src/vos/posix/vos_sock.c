@@ -16,6 +16,8 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: TCP send without SIGPIPE (MSG_NOSIGNAL, SO_NOSIGPIPE on BSD)
+ *      BL 2026-10-17: vos_select() waits on the time source if one is set
  *      BL 2018-11-26: Ticket #208: Mapping corrected after complaint (Bit 2 was set for prio 2 & 4)
  *      BL 2018-07-13: Ticket #208: VOS socket options: QoS/ToS field priority handling needs update
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
@@ -81,6 +83,13 @@ const CHAR8 *cDefaultIface = "en0";
 const CHAR8 *cDefaultIface = "eth0";
 #endif
 
+/* A connection reset by the peer must not raise SIGPIPE: MSG_NOSIGNAL per send, or SO_NOSIGPIPE per socket (BSD) */
+#ifdef MSG_NOSIGNAL
+#define VOS_SEND_FLAGS  MSG_NOSIGNAL
+#else
+#define VOS_SEND_FLAGS  0
+#endif
+
 /***********************************************************************************************************************
  *  LOCALS
  */
@@ -96,6 +105,29 @@ struct ifreq    gIfr;
 BOOL8       vos_getMacAddress (UINT8        *pMacAddr,
                                const char   *pIfName);
 VOS_ERR_T   vos_sockSetBuffer (SOCKET sock);
+static void vos_sockNoSigPipe (int sock);
+
+/**********************************************************************************************************************/
+/** Suppress SIGPIPE on a TCP socket where send() has no MSG_NOSIGNAL.
+ *
+ *  @param[in]          sock       socket descriptor
+ */
+static void vos_sockNoSigPipe (
+    int sock)
+{
+#if !defined(MSG_NOSIGNAL) && defined(SO_NOSIGPIPE)
+    int sockOptValue = 1;
+
+    if (setsockopt(sock, SOL_SOCKET, SO_NOSIGPIPE, &sockOptValue, sizeof(sockOptValue)) == -1)
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_WARNING, "setsockopt() SO_NOSIGPIPE failed (Err: %s)\n", buff);
+    }
+#else
+    (void) sock;
+#endif
+}
 
 /**********************************************************************************************************************/
 /** Get the MAC address for a named interface.
@@ -395,6 +427,11 @@ EXT_DECL INT32 vos_select (
     VOS_FDS_T       *pErrorFD,
     VOS_TIMEVAL_T   *pTimeOut)
 {
+    if ((gPVosTimeSource != NULL) &&
+        ((pTimeOut == NULL) || (pTimeOut->tv_sec != 0) || (pTimeOut->tv_usec != 0)))
+    {
+        return vos_selectTimeSource(highDesc, pReadableFD, pWriteableFD, pErrorFD, pTimeOut);
+    }
     return select(highDesc, (fd_set *) pReadableFD, (fd_set *) pWriteableFD,
                   (fd_set *) pErrorFD, (struct timeval *) pTimeOut);
 }
@@ -684,6 +721,7 @@ EXT_DECL VOS_ERR_T vos_sockOpenTCP (
         close(sock);
         return VOS_SOCK_ERR;
     }
+    vos_sockNoSigPipe(sock);
 
     *pSock = (SOCKET) sock;
 
@@ -1419,6 +1457,7 @@ EXT_DECL VOS_ERR_T vos_sockAccept (
             *pIPAddress = vos_htonl(srcAddress.sin_addr.s_addr);
             *pPort      = vos_htons(srcAddress.sin_port);
             *pSock      = connFd;
+            vos_sockNoSigPipe(connFd);
             break;         /* success */
         }
     }
@@ -1518,7 +1557,7 @@ EXT_DECL VOS_ERR_T vos_sockSendTCP (
     /* Keep on sending until we got rid of all data or we received an unrecoverable error */
     do
     {
-        sendSize = write(sock, pBuffer, bufferSize);
+        sendSize = send(sock, pBuffer, bufferSize, VOS_SEND_FLAGS);
         if (sendSize >= 0)
         {
             bufferSize  -= (size_t) sendSize;
@@ -16,6 +16,12 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: Cyclic thread context registers the created thread only, attributes destroyed on errors
+ *      BL 2026-10-17: Time source hooks in vos_getTime(Ns), vos_threadDelay(Until)
+ *      BL 2026-10-17: vos_getTimeNs()
+ *      BL 2026-10-17: vos_threadDelayUntil() (sleep, then spin)
+ *      BL 2026-10-17: vos_threadSetAffinity(), vos_threadSetAttr()
+ *      BL 2026-10-17: Cyclic threads with absolute release times (clock_nanosleep), cycle statistics
  *      BL 2018-06-25: Ticket #202: vos_mutexTrylock return value
  *      BL 2018-05-03: Ticket #194: Platform independent format specifiers in vos_printLog
  *      BL 2018-04-18: Ticket #195: Invalid thread handle (SEGFAULT)
@@ -36,6 +42,8 @@
  */
 
 #include <stdint.h>
+#include <string.h>
+#include <time.h>
 #include <unistd.h>
 #include <errno.h>
 #include <sys/time.h>
@@ -43,6 +51,9 @@
 #include <pthread.h>
 #include <semaphore.h>
 #include <sched.h>
+#ifdef __linux
+#include <sys/syscall.h>
+#endif
 
 #ifdef __APPLE__
 #include <uuid/uuid.h>
@@ -69,9 +80,47 @@ const UINT32    cMutextMagic        = 0x1234FEDCu;
 
 int             vosThreadInitialised = FALSE;
 
+#ifndef VOS_MAX_CYCLIC_THREADS
+#define VOS_MAX_CYCLIC_THREADS  16u         /**< max. number of concurrently running cyclic threads */
+#endif
+
+#ifndef VOS_PREFAULT_CHUNK
+#define VOS_PREFAULT_CHUNK      4096u       /**< stack prefault granularity (page size)             */
+#endif
+
+#define VOS_SCHED_DEADLINE      6           /**< Linux SCHED_DEADLINE policy                        */
+
+/** Parameters for the Linux sched_setattr() system call (not all C libraries provide a wrapper)    */
+typedef struct
+{
+    UINT32  size;
+    UINT32  sched_policy;
+    UINT64  sched_flags;
+    INT32   sched_nice;
+    UINT32  sched_priority;
+    UINT64  sched_runtime;
+    UINT64  sched_deadline;
+    UINT64  sched_period;
+} VOS_SCHED_ATTR_T;
+
+/** Context of a cyclic thread    */
+typedef struct
+{
+    BOOL8                   inUse;          /**< entry is used                              */
+    BOOL8                   hasThread;      /**< thread is known (set once it is created)   */
+    pthread_t               thread;         /**< thread running the cycle                   */
+    VOS_THREAD_FUNC_T       pFunction;      /**< thread function called each cycle          */
+    void                    *pArguments;    /**< arguments for the thread function          */
+    UINT64                  sumLateness;    /**< for the average lateness in us             */
+    VOS_THREAD_CYC_STATS_T  stats;          /**< cycle statistics                           */
+} VOS_CYCLIC_THREAD_T;
+
 /***********************************************************************************************************************
  *  LOCALS
  */
+
+static VOS_CYCLIC_THREAD_T  sCyclicThreads[VOS_MAX_CYCLIC_THREADS];
+static pthread_mutex_t      sCyclicMutex = PTHREAD_MUTEX_INITIALIZER;
 #ifdef __APPLE__
 static int sem_timedwait (sem_t *sem, const struct timespec *abs_timeout)
 {
@@ -134,6 +183,9 @@ int sem_init (sem_t *pSema, int flags, unsigned int mode)
 /**********************************************************************************************************************/
 /** Cyclic thread functions.
  *  Wrapper for cyclic threads. The thread function will be called cyclically with interval.
+ *  The release times are absolute (start time + n * interval on the monotonic clock), so the period does not
+ *  drift with the execution time of the thread function or the wake-up latency. If a cycle is missed, the
+ *  thread skips to the next release time in phase; overruns, skipped cycles and lateness are recorded.
  *
  *  @param[in]      interval        Interval for cyclic threads in us (incl. runtime)
  *  @param[in]      pFunction       Pointer to the thread function
@@ -144,65 +196,248 @@ int sem_init (sem_t *pSema, int flags, unsigned int mode)
 #define NSECS_PER_USEC  1000u
 #define USECS_PER_MSEC  1000u
 #define MSECS_PER_SEC   1000u
+#define NSECS_PER_SEC   1000000000
+
+/** Release a cyclic thread context, also called if the thread gets cancelled
+ *
+ *  @param[in]      pArg            Pointer to the context
+ */
+static void vos_cyclicThreadCleanup (
+    void *pArg)
+{
+    VOS_CYCLIC_THREAD_T *pCtx = (VOS_CYCLIC_THREAD_T *) pArg;
 
-/* This define holds the max amount os seconds to get stored in 32bit holding micro seconds        */
-/* It is the result when using the common time struct with tv_sec and tv_usec as on a 32 bit value */
-/* so far 0..999999 gets used for the tv_usec field as per definition, then 0xFFF0BDC0 usec        */
-/* are remaining to represent the seconds, which in turn give 0x10C5 seconds or in decimal 4293    */
-#define MAXSEC_FOR_USECPRESENTATION  4293
+    (void) pthread_mutex_lock(&sCyclicMutex);
+    pCtx->inUse = FALSE;
+    (void) pthread_mutex_unlock(&sCyclicMutex);
+}
 
-EXT_DECL void vos_cyclicThread (
+/** Reserve a context for a cyclic thread
+ *
+ *  @param[in]      pThread         Pointer to the thread running the cycle, NULL if it is not yet created
+ *  @param[in]      interval        Interval for cyclic threads in us
+ *  @param[in]      pFunction       Pointer to the thread function
+ *  @param[in]      pArguments      Pointer to the thread function parameters
+ *  @retval         pointer to the context or NULL if the table is full
+ */
+static VOS_CYCLIC_THREAD_T *vos_cyclicThreadAlloc (
+    const pthread_t     *pThread,
     UINT32              interval,
     VOS_THREAD_FUNC_T   pFunction,
     void                *pArguments)
 {
-    VOS_TIMEVAL_T   priorCall;
-    VOS_TIMEVAL_T   afterCall;
-    UINT32          execTime;
-    UINT32          waitingTime;
-    for (;; )
+    VOS_CYCLIC_THREAD_T *pCtx = NULL;
+    UINT32 i;
+
+    (void) pthread_mutex_lock(&sCyclicMutex);
+    for (i = 0u; i < VOS_MAX_CYCLIC_THREADS; i++)
     {
-        vos_getTime(&priorCall);  /* get initial time */
-        pFunction(pArguments);    /* perform thread function */
-        vos_getTime(&afterCall);  /* get time after function ghas returned */
-        /* subtract in the pattern after - prior to get the runtime of function() */
-        vos_subTime(&afterCall, &priorCall);
-        /* afterCall holds now the time difference within a structure not compatible with interval */
-        /* check if UINT32 fits to hold the waiting time value */
-        if (afterCall.tv_sec <= MAXSEC_FOR_USECPRESENTATION)
+        if (sCyclicThreads[i].inUse == FALSE)
         {
-            /*           sec to usec conversion value normalized from 0 .. 999999*/
-            execTime =
-                ((UINT32) ((UINT32)afterCall.tv_sec * MSECS_PER_SEC * USECS_PER_MSEC) + (UINT32)afterCall.tv_usec);
-            if (execTime > interval)
+            pCtx = &sCyclicThreads[i];
+            memset(pCtx, 0, sizeof(VOS_CYCLIC_THREAD_T));
+            pCtx->inUse             = TRUE;
+            if (pThread != NULL)
             {
-                /*severe error: cyclic task time violated*/
-                waitingTime = 0U;
-                /* Log the runtime violation */
-                vos_printLog(VOS_LOG_ERROR,
-                             "cyclic thread with interval %u usec was running  %u usec\n",
-                             (unsigned int)interval, (unsigned int)execTime);
+                pCtx->hasThread = TRUE;
+                pCtx->thread    = *pThread;
             }
-            else
+            pCtx->pFunction         = pFunction;
+            pCtx->pArguments        = pArguments;
+            pCtx->stats.interval    = interval;
+            break;
+        }
+    }
+    (void) pthread_mutex_unlock(&sCyclicMutex);
+    return pCtx;
+}
+
+/** Run the thread function cyclically with absolute release times
+ *
+ *  @param[in]      pCtx            Pointer to the context of this thread
+ */
+static void vos_cyclicThreadRun (
+    VOS_CYCLIC_THREAD_T *pCtx)
+{
+    const INT64     intervalNs = (INT64) pCtx->stats.interval * NSECS_PER_USEC;
+    struct timespec release;
+    struct timespec now;
+    INT64           lateNs;
+    UINT32          lateness;
+
+    (void) clock_gettime(CLOCK_MONOTONIC, &release);
+
+    for (;; )
+    {
+        pCtx->pFunction(pCtx->pArguments);  /* perform thread function */
+
+        /* next release time in phase */
+        release.tv_nsec += (long) (intervalNs % NSECS_PER_SEC);
+        release.tv_sec  += (time_t) (intervalNs / NSECS_PER_SEC);
+        if (release.tv_nsec >= NSECS_PER_SEC)
+        {
+            release.tv_nsec -= NSECS_PER_SEC;
+            release.tv_sec++;
+        }
+
+        (void) clock_gettime(CLOCK_MONOTONIC, &now);
+        lateNs = ((INT64) now.tv_sec - (INT64) release.tv_sec) * NSECS_PER_SEC + (now.tv_nsec - release.tv_nsec);
+        if (lateNs > 0)
+        {
+            /* severe error: cyclic task time violated, skip the missed release times to stay in phase */
+            UINT32 skipped = (UINT32) (lateNs / intervalNs) + 1u;
+            INT64  advance = (INT64) skipped * intervalNs;
+
+            release.tv_nsec += (long) (advance % NSECS_PER_SEC);
+            release.tv_sec  += (time_t) (advance / NSECS_PER_SEC);
+            if (release.tv_nsec >= NSECS_PER_SEC)
             {
-                waitingTime = interval - execTime;
+                release.tv_nsec -= NSECS_PER_SEC;
+                release.tv_sec++;
             }
+            (void) pthread_mutex_lock(&sCyclicMutex);
+            pCtx->stats.overruns++;
+            pCtx->stats.skipped += skipped;
+            (void) pthread_mutex_unlock(&sCyclicMutex);
+            vos_printLog(VOS_LOG_ERROR,
+                         "cyclic thread with interval %u usec overran by %u usec, %u cycle(s) skipped\n",
+                         (unsigned int)pCtx->stats.interval, (unsigned int)(lateNs / NSECS_PER_USEC),
+                         (unsigned int)skipped);
         }
-        else
+
+#ifdef __APPLE__
+        /* no clock_nanosleep(): wait relative to the absolute release time */
         {
-            /* seems a very critical overflow has happened - or simply a misconfiguration */
-            /* as a rough first guess use zero waiting time here */
-            waitingTime = 0U;
-            /* Have this value range violation logged */
-            vos_printLog(VOS_LOG_ERROR,
-                         "cyclic thread with interval %u usec exceeded time out by running %ld sec\n",
-                         (unsigned int)interval, (long)afterCall.tv_sec);
+            struct timespec wait;
+            lateNs = ((INT64) release.tv_sec - (INT64) now.tv_sec) * NSECS_PER_SEC
+                + (release.tv_nsec - now.tv_nsec);
+            wait.tv_sec     = (time_t) (lateNs / NSECS_PER_SEC);
+            wait.tv_nsec    = (long) (lateNs % NSECS_PER_SEC);
+            (void) nanosleep(&wait, NULL);
+        }
+#else
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &release, NULL) == EINTR)
+        {
+            ;
+        }
+#endif
+        /* how late did we wake up? */
+        (void) clock_gettime(CLOCK_MONOTONIC, &now);
+        lateNs = ((INT64) now.tv_sec - (INT64) release.tv_sec) * NSECS_PER_SEC + (now.tv_nsec - release.tv_nsec);
+        lateness = (lateNs > 0) ? (UINT32) (lateNs / NSECS_PER_USEC) : 0u;
+
+        (void) pthread_mutex_lock(&sCyclicMutex);
+        pCtx->stats.cycles++;
+        pCtx->stats.lastLateness = lateness;
+        if (lateness > pCtx->stats.maxLateness)
+        {
+            pCtx->stats.maxLateness = lateness;
         }
-        (void) vos_threadDelay(waitingTime);
+        pCtx->sumLateness += lateness;
+        (void) pthread_mutex_unlock(&sCyclicMutex);
+
         pthread_testcancel();
     }
 }
 
+/** Thread entry for cyclic threads created by vos_threadCreate()
+ *
+ *  @param[in]      pArg            Pointer to the context of this thread
+ *  @retval         NULL
+ */
+static void *vos_cyclicThreadEntry (
+    void *pArg)
+{
+    VOS_CYCLIC_THREAD_T *pCtx = (VOS_CYCLIC_THREAD_T *) pArg;
+
+    (void) pthread_mutex_lock(&sCyclicMutex);
+    pCtx->hasThread = TRUE;
+    pCtx->thread    = pthread_self();
+    (void) pthread_mutex_unlock(&sCyclicMutex);
+
+    pthread_cleanup_push(vos_cyclicThreadCleanup, pCtx);
+    vos_cyclicThreadRun(pCtx);
+    pthread_cleanup_pop(1);
+    return NULL;
+}
+
+EXT_DECL void vos_cyclicThread (
+    UINT32              interval,
+    VOS_THREAD_FUNC_T   pFunction,
+    void                *pArguments)
+{
+    VOS_CYCLIC_THREAD_T *pCtx;
+    pthread_t           self = pthread_self();
+
+    if ((interval == 0u) || (pFunction == NULL))
+    {
+        return;
+    }
+
+    pCtx = vos_cyclicThreadAlloc(&self, interval, pFunction, pArguments);
+    if (pCtx == NULL)
+    {
+        vos_printLog(VOS_LOG_ERROR, "cyclic thread: more than %u cyclic threads\n", VOS_MAX_CYCLIC_THREADS);
+        return;
+    }
+
+    pthread_cleanup_push(vos_cyclicThreadCleanup, pCtx);
+    vos_cyclicThreadRun(pCtx);
+    pthread_cleanup_pop(1);
+}
+
+/**********************************************************************************************************************/
+/** Get the timing statistics of a cyclic thread.
+ *
+ *  @param[in]      thread          Thread handle (or NULL if current thread)
+ *  @param[out]     pStats          Pointer to statistics to be filled in
+ *  @param[in]      reset           Clear the counters after reading
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_NOINIT_ERR  not a cyclic thread
+ */
+
+EXT_DECL VOS_ERR_T vos_threadGetCycleStats (
+    VOS_THREAD_T            thread,
+    VOS_THREAD_CYC_STATS_T  *pStats,
+    BOOL8                   reset)
+{
+    VOS_ERR_T   err = VOS_NOINIT_ERR;
+    pthread_t   hThread = (thread == NULL) ? pthread_self() : (pthread_t) thread;
+    UINT32      i;
+
+    if (pStats == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    (void) pthread_mutex_lock(&sCyclicMutex);
+    for (i = 0u; i < VOS_MAX_CYCLIC_THREADS; i++)
+    {
+        VOS_CYCLIC_THREAD_T *pCtx = &sCyclicThreads[i];
+
+        if ((pCtx->inUse == TRUE) && (pCtx->hasThread == TRUE) && pthread_equal(pCtx->thread, hThread))
+        {
+            *pStats = pCtx->stats;
+            pStats->avgLateness = (pCtx->stats.cycles != 0u) ?
+                (UINT32) (pCtx->sumLateness / pCtx->stats.cycles) : 0u;
+            if (reset == TRUE)
+            {
+                pCtx->stats.cycles          = 0u;
+                pCtx->stats.overruns        = 0u;
+                pCtx->stats.skipped         = 0u;
+                pCtx->stats.lastLateness    = 0u;
+                pCtx->stats.maxLateness     = 0u;
+                pCtx->sumLateness           = 0u;
+            }
+            err = VOS_NO_ERR;
+            break;
+        }
+    }
+    (void) pthread_mutex_unlock(&sCyclicMutex);
+    return err;
+}
+
 /**********************************************************************************************************************/
 /** Initialize the thread library.
  *  Must be called once before any other call
@@ -240,7 +475,8 @@ EXT_DECL void vos_threadTerm (void)
  *  @param[in]      pName           Pointer to name of the thread (optional)
  *  @param[in]      policy          Scheduling policy (FIFO, Round Robin or other)
  *  @param[in]      priority        Scheduling priority (1...255 (highest), default 0)
- *  @param[in]      interval        Interval for cyclic threads in us (optional)
+ *  @param[in]      interval        Interval for cyclic threads in us (optional), if set pFunction is called
+ *                                  once per interval (see vos_cyclicThread)
  *  @param[in]      stackSize       Minimum stacksize, default 0: 16kB
  *  @param[in]      pFunction       Pointer to the thread function
  *  @param[in]      pArguments      Pointer to the thread function parameters
@@ -264,6 +500,7 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
     pthread_t           hThread;
     pthread_attr_t      threadAttrib;
     struct sched_param  schedParam;  /* scheduling priority */
+    VOS_CYCLIC_THREAD_T *pCyclic = NULL;
     int         retCode;
 
     if (!vosThreadInitialised)
@@ -277,13 +514,10 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
     }
 
     *pThread = NULL;
-    
-    if (interval > 0u)
+
+    if (pFunction == NULL)
     {
-        vos_printLog(VOS_LOG_ERROR,
-                     "%s cyclic threads not implemented yet\n",
-                     pName);
-        return VOS_INIT_ERR;
+        return VOS_PARAM_ERR;
     }
 
     /* Initialize thread attributes to default values */
@@ -377,19 +611,54 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
         return VOS_THREAD_ERR;
     }
 
+    /* Cyclic threads are started via a wrapper calling pFunction every interval us */
+    if (interval > 0u)
+    {
+        pCyclic = vos_cyclicThreadAlloc(NULL, interval, pFunction, pArguments);
+        if (pCyclic == NULL)
+        {
+            vos_printLog(VOS_LOG_ERROR,
+                         "%s more than %u cyclic threads\n",
+                         pName, VOS_MAX_CYCLIC_THREADS);
+            (void) pthread_attr_destroy(&threadAttrib);
+            return VOS_THREAD_ERR;
+        }
+    }
+
     /* Create the thread */
-    retCode = pthread_create(&hThread, &threadAttrib, (void *(*)(
-                                                           void *))pFunction,
-                             pArguments);
+    if (pCyclic != NULL)
+    {
+        retCode = pthread_create(&hThread, &threadAttrib, vos_cyclicThreadEntry, pCyclic);
+    }
+    else
+    {
+        retCode = pthread_create(&hThread, &threadAttrib, (void *(*)(
+                                                               void *))pFunction,
+                                 pArguments);
+    }
     if (retCode != 0)
     {
+        if (pCyclic != NULL)
+        {
+            vos_cyclicThreadCleanup(pCyclic);
+        }
         vos_printLog(VOS_LOG_ERROR,
                      "%s pthread_create() failed (Err:%d)\n",
                      pName,
                      (int)retCode );
+        (void) pthread_attr_destroy(&threadAttrib);
         return VOS_THREAD_ERR;
     }
 
+    if (pCyclic != NULL)
+    {
+        /* register the created thread, it may not have run yet */
+        (void) pthread_mutex_lock(&sCyclicMutex);
+        pCyclic->hasThread  = TRUE;
+        pCyclic->thread     = hThread;
+        (void) pthread_mutex_unlock(&sCyclicMutex);
+    }
+
     *pThread = (VOS_THREAD_T) hThread;
 
     /* Destroy thread attributes */
@@ -475,6 +744,167 @@ EXT_DECL VOS_ERR_T vos_threadSelf (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Set the CPU affinity of a thread.
+ *
+ *  @param[in]      thread          Thread handle (or NULL if current thread)
+ *  @param[in]      cpuMask         CPUs the thread may run on (bit n = CPU n)
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   mask empty or invalid
+ *  @retval         VOS_THREAD_ERR  affinity could not be set
+ *  @retval         VOS_INIT_ERR    not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetAffinity (
+    VOS_THREAD_T    thread,
+    UINT64          cpuMask)
+{
+#ifdef __linux
+    cpu_set_t   cpuSet;
+    pthread_t   hThread = (thread == NULL) ? pthread_self() : (pthread_t) thread;
+    UINT32      cpu;
+    int         retCode;
+
+    if (cpuMask == 0u)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    CPU_ZERO(&cpuSet);
+    for (cpu = 0u; (cpu < 64u) && (cpu < CPU_SETSIZE); cpu++)
+    {
+        if (cpuMask & ((UINT64) 1u << cpu))
+        {
+            CPU_SET(cpu, &cpuSet);
+        }
+    }
+
+    retCode = pthread_setaffinity_np(hThread, sizeof(cpuSet), &cpuSet);
+    if (retCode != 0)
+    {
+        vos_printLog(VOS_LOG_ERROR,
+                     "pthread_setaffinity_np(0x%llx) failed (Err:%d)\n",
+                     (unsigned long long) cpuMask,
+                     (int)retCode );
+        return VOS_THREAD_ERR;
+    }
+    return VOS_NO_ERR;
+#else
+    (void) thread;
+    (void) cpuMask;
+    vos_printLogStr(VOS_LOG_WARNING, "vos_threadSetAffinity() not supported on this target\n");
+    return VOS_INIT_ERR;
+#endif
+}
+
+/** Touch the stack in chunks so that its pages are mapped before they are needed
+ *
+ *  @param[in]      size            number of bytes still to touch
+ */
+static void vos_threadPrefaultStack (
+    UINT32 size)
+{
+    volatile UINT8 chunk[VOS_PREFAULT_CHUNK];
+
+    memset((void *) chunk, 0, sizeof(chunk));
+    if (size > sizeof(chunk))
+    {
+        vos_threadPrefaultStack(size - (UINT32) sizeof(chunk));
+    }
+    chunk[0] = chunk[sizeof(chunk) - 1u];   /* keep the frame alive across the call */
+}
+
+/**********************************************************************************************************************/
+/** Apply real-time attributes to the calling thread.
+ *
+ *  @param[in]      pAttr           Pointer to the attributes
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_THREAD_ERR  attributes could not be set (e.g. missing privileges)
+ *  @retval         VOS_INIT_ERR    not supported on this target
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetAttr (
+    const VOS_THREAD_ATTR_T *pAttr)
+{
+    VOS_ERR_T   err = VOS_NO_ERR;
+    int         retCode;
+
+    if (pAttr == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    if (pAttr->cpuMask != 0u)
+    {
+        err = vos_threadSetAffinity(NULL, pAttr->cpuMask);
+        if (err != VOS_NO_ERR)
+        {
+            return err;
+        }
+    }
+
+    switch (pAttr->policy)
+    {
+        case VOS_THREAD_POLICY_OTHER:
+            break;
+        case VOS_THREAD_POLICY_FIFO:
+        case VOS_THREAD_POLICY_RR:
+        {
+            struct sched_param schedParam;
+
+            schedParam.sched_priority = pAttr->priority;
+            retCode = pthread_setschedparam(pthread_self(), (int) pAttr->policy, &schedParam);
+            if (retCode != 0)
+            {
+                vos_printLog(VOS_LOG_ERROR,
+                             "pthread_setschedparam(%d, %d) failed (Err:%d)\n",
+                             (int)pAttr->policy,
+                             (int)pAttr->priority,
+                             (int)retCode );
+                return VOS_THREAD_ERR;
+            }
+            break;
+        }
+        case VOS_THREAD_POLICY_DEADLINE:
+        {
+#if defined(__linux) && defined(SYS_sched_setattr)
+            VOS_SCHED_ATTR_T schedAttr;
+
+            if ((pAttr->runtime == 0u) ||
+                (pAttr->runtime > pAttr->deadline) ||
+                (pAttr->deadline > pAttr->period))
+            {
+                return VOS_PARAM_ERR;
+            }
+            memset(&schedAttr, 0, sizeof(schedAttr));
+            schedAttr.size          = sizeof(schedAttr);
+            schedAttr.sched_policy  = VOS_SCHED_DEADLINE;
+            schedAttr.sched_runtime = (UINT64) pAttr->runtime * NSECS_PER_USEC;
+            schedAttr.sched_deadline    = (UINT64) pAttr->deadline * NSECS_PER_USEC;
+            schedAttr.sched_period      = (UINT64) pAttr->period * NSECS_PER_USEC;
+            if (syscall(SYS_sched_setattr, 0, &schedAttr, 0u) != 0)
+            {
+                vos_printLog(VOS_LOG_ERROR, "sched_setattr(SCHED_DEADLINE) failed (Err:%d)\n", errno);
+                return VOS_THREAD_ERR;
+            }
+            break;
+#else
+            vos_printLogStr(VOS_LOG_WARNING, "SCHED_DEADLINE not supported on this target\n");
+            return VOS_INIT_ERR;
+#endif
+        }
+        default:
+            return VOS_PARAM_ERR;
+    }
+
+    if (pAttr->prefaultStack != 0u)
+    {
+        vos_threadPrefaultStack(pAttr->prefaultStack);
+    }
+    return err;
+}
+
 /**********************************************************************************************************************/
 /*  Timers                                                                                                            */
 /**********************************************************************************************************************/
@@ -508,6 +938,15 @@ EXT_DECL VOS_ERR_T vos_threadDelay (
         return VOS_NO_ERR;
     }
 
+    if (gPVosTimeSource != NULL)
+    {
+        const VOS_TIME_SOURCE_T *pSource = gPVosTimeSource;
+
+        pSource->pfWait(pSource->pRefCon, pSource->pfGetTime(pSource->pRefCon) + (VOS_TIME_NS_T) delay * 1000,
+                        VOS_TIME_WAIT_DELAY);
+        return VOS_NO_ERR;
+    }
+
     wanted_delay.tv_sec     = delay / 1000000u;
     wanted_delay.tv_nsec    = (delay % 1000000) * 1000;
     do
@@ -524,6 +963,68 @@ EXT_DECL VOS_ERR_T vos_threadDelay (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Delay the execution of the current thread until an absolute point in time.
+ *  Sleeps with clock_nanosleep(TIMER_ABSTIME) until guardTime us before the wanted time, then spins.
+ *
+ *  @param[in]      pTime             Absolute wake-up time (as returned by vos_getTime)
+ *  @param[in]      guardTime         Time in us to spin before pTime
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ */
+
+EXT_DECL VOS_ERR_T vos_threadDelayUntil (
+    const VOS_TIMEVAL_T *pTime,
+    UINT32              guardTime)
+{
+    VOS_TIMEVAL_T   now;
+    INT64           wakeUp;
+    INT64           current;
+
+    if (pTime == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    if (gPVosTimeSource != NULL)
+    {
+        /* no scheduler latency to compensate */
+        gPVosTimeSource->pfWait(gPVosTimeSource->pRefCon, VOS_TIME_TO_NS(pTime), VOS_TIME_WAIT_DELAY);
+        return VOS_NO_ERR;
+    }
+
+    vos_getTime(&now);
+    wakeUp  = (INT64) pTime->tv_sec * 1000000 + pTime->tv_usec - (INT64) guardTime;
+    current = (INT64) now.tv_sec * 1000000 + now.tv_usec;
+
+    /* coarse part: sleep until the guard band begins */
+    if (wakeUp > current)
+    {
+#if defined(CLOCK_MONOTONIC) && !defined(__APPLE__)
+        struct timespec wakeUpTime;
+
+        wakeUpTime.tv_sec   = (time_t) (wakeUp / 1000000);
+        wakeUpTime.tv_nsec  = (long) (wakeUp % 1000000) * (long) NSECS_PER_USEC;
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeUpTime, NULL) == EINTR)
+        {
+            ;
+        }
+#else
+        (void) vos_threadDelay((UINT32) (wakeUp - current));
+#endif
+    }
+
+    /* fine part: spin on the clock */
+    do
+    {
+        vos_getTime(&now);
+    }
+    while (vos_cmpTime(&now, pTime) < 0);
+
+    pthread_testcancel();
+    return VOS_NO_ERR;
+}
+
 
 /**********************************************************************************************************************/
 /** Return the current time in sec and us
@@ -541,6 +1042,12 @@ EXT_DECL void vos_getTime (
     {
         vos_printLogStr(VOS_LOG_ERROR, "ERROR NULL pointer\n");
     }
+    else if (gPVosTimeSource != NULL)
+    {
+        VOS_TIME_NS_T now = gPVosTimeSource->pfGetTime(gPVosTimeSource->pRefCon);
+
+        VOS_NS_TO_TIME(now, pTime);
+    }
     else
     {
 #ifndef CLOCK_MONOTONIC
@@ -567,6 +1074,32 @@ EXT_DECL void vos_getTime (
     }
 }
 
+/**********************************************************************************************************************/
+/** Return the current (monotonic) time in ns
+ *
+ *  @retval         current time in ns
+ */
+
+EXT_DECL VOS_TIME_NS_T vos_getTimeNs (
+    void)
+{
+    if (gPVosTimeSource != NULL)
+    {
+        return gPVosTimeSource->pfGetTime(gPVosTimeSource->pRefCon);
+    }
+#ifndef CLOCK_MONOTONIC
+    struct timeval myTime;
+
+    (void)gettimeofday(&myTime, NULL);
+    return (VOS_TIME_NS_T) myTime.tv_sec * 1000000000 + (VOS_TIME_NS_T) myTime.tv_usec * 1000;
+#else
+    struct timespec currentTime;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &currentTime);
+    return (VOS_TIME_NS_T) currentTime.tv_sec * 1000000000 + (VOS_TIME_NS_T) currentTime.tv_nsec;
+#endif
+}
+
 /**********************************************************************************************************************/
 /** Get a time-stamp string.
  *  Get a time-stamp string for debugging in the form "yyyymmdd-hh:mm:ss.ms"
@@ -17,6 +17,7 @@
  *
  * $Id$*
  *
+ *      BL 2026-10-17: vos_select() waits on the time source if one is set
  *      BL 2018-11-26: Ticket #208: Mapping corrected after complaint (Bit 2 was set for prio 2 & 4)
  *      SB 2018-07-20: Ticket #209: vos_getInterfaces returning incorrect "name" and "linkState" on windows (requires
  *                                  at least windows vista now).
@@ -494,6 +495,11 @@ EXT_DECL INT32 vos_select (
     VOS_FDS_T       *pErrorFD,
     VOS_TIMEVAL_T   *pTimeOut)
 {
+    if ((gPVosTimeSource != NULL) &&
+        ((pTimeOut == NULL) || (pTimeOut->tv_sec != 0) || (pTimeOut->tv_usec != 0)))
+    {
+        return vos_selectTimeSource(highDesc, pReadableFD, pWriteableFD, pErrorFD, pTimeOut);
+    }
     return select((int)highDesc, (fd_set *) pReadableFD, (fd_set *) pWriteableFD,
                   (fd_set *) pErrorFD, (struct timeval *) pTimeOut);
 }
@@ -14,6 +14,15 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: Binary log test: wall-clock time stamps, cut string arguments
+ *      BL 2026-10-17: Simulated clock test with more waiting threads than prepared slots
+ *      BL 2026-10-17: Thread attribute test runs in a thread of its own (affinity of the test program kept)
+ *      BL 2026-10-17: Shared memory test added
+ *      BL 2026-10-17: Log level and binary log test added
+ *      BL 2026-10-17: Simulated clock test added
+ *      BL 2026-10-17: Precise delay test added
+ *      BL 2026-10-17: Thread attribute test added
+ *      BL 2026-10-17: Cyclic thread test added
  *      BL 2017-05-22: Ticket #122: Addendum for 64Bit compatibility (VOS_TIME_T -> VOS_TIMEVAL_T)
  */
 
@@ -46,6 +55,7 @@
 #include "vos_sock.h"
 #include "vos_utils.h"
 #include "vos_mem.h"
+#include "vos_shared_mem.h"
 
 int testTimeCompare()
 {
@@ -300,6 +310,435 @@ int testInterfaces()
     return 0; /* all time tests succeeded */
 }
 
+static volatile UINT32 sCycleCount = 0;
+
+static void cyclicFunction(void *pArg)
+{
+    sCycleCount++;
+}
+
+int testCyclicThread()
+{
+    VOS_THREAD_T            thread;
+    VOS_THREAD_CYC_STATS_T  stats;
+
+    if (vos_threadInit() != VOS_NO_ERR)
+    {
+        return 1;
+    }
+    if (vos_threadCreate(&thread, "cyclic", VOS_THREAD_POLICY_OTHER, 0, 10000, 0, cyclicFunction, NULL) != VOS_NO_ERR)
+    {
+        printf("Could not create cyclic thread\n");
+        return 1;
+    }
+
+    (void) vos_threadDelay(205000);
+
+    if (vos_threadGetCycleStats(thread, &stats, FALSE) != VOS_NO_ERR)
+    {
+        printf("No cycle statistics for cyclic thread\n");
+        return 1;
+    }
+    (void) vos_threadTerminate(thread);
+
+    printf("cyclic thread: %u calls, %u cycles, %u overruns, %u skipped, lateness avg %u us max %u us\n",
+           sCycleCount, stats.cycles, stats.overruns, stats.skipped, stats.avgLateness, stats.maxLateness);
+
+    /* 10ms cadence over 205ms: 20 cycles plus the initial call */
+    if ((stats.interval != 10000) || (sCycleCount < 15) || (sCycleCount > 22))
+    {
+        return 1;
+    }
+    return 0;
+}
+
+static volatile int sThreadAttrResult = -1;
+
+/* Pins itself to CPU 0: run in a thread of its own, the test program keeps its affinity */
+static void threadAttrFunction(void *pArg)
+{
+    VOS_THREAD_ATTR_T attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.cpuMask        = 0x1;      /* CPU 0 is always there */
+    attr.prefaultStack  = 64 * 1024;
+
+    if (vos_threadSetAttr(&attr) != VOS_NO_ERR)
+    {
+        printf("Could not set thread attributes\n");
+        sThreadAttrResult = 1;
+    }
+    else if (vos_threadSetAffinity(NULL, 0) != VOS_PARAM_ERR)
+    {
+        sThreadAttrResult = 1;
+    }
+    else
+    {
+        sThreadAttrResult = 0;
+    }
+}
+
+int testThreadAttr()
+{
+    VOS_THREAD_T    thread;
+    int             i;
+
+    /* the stack must be larger than the prefaulted part */
+    if (vos_threadCreate(&thread, "attr", VOS_THREAD_POLICY_OTHER, 0, 0, 256 * 1024, threadAttrFunction, NULL)
+        != VOS_NO_ERR)
+    {
+        printf("Could not create thread\n");
+        return 1;
+    }
+    for (i = 0; (i < 100) && (sThreadAttrResult < 0); i++)
+    {
+        (void) vos_threadDelay(10000);
+    }
+    return (sThreadAttrResult == 0) ? 0 : 1;
+}
+
+int testDelayUntil()
+{
+    VOS_TIMEVAL_T deadline;
+    VOS_TIMEVAL_T now;
+    VOS_TIMEVAL_T late;
+    VOS_TIMEVAL_T wait = {0, 2000};
+
+    if (vos_threadDelayUntil(NULL, 0) != VOS_PARAM_ERR)
+    {
+        return 1;
+    }
+
+    vos_getTime(&deadline);
+    vos_addTime(&deadline, &wait);
+    if (vos_threadDelayUntil(&deadline, 200) != VOS_NO_ERR)
+    {
+        return 1;
+    }
+    vos_getTime(&now);
+
+    /* never early; the spin part should not be off by more than a scheduler tick */
+    if (vos_cmpTime(&now, &deadline) < 0)
+    {
+        printf("vos_threadDelayUntil woke up early\n");
+        return 1;
+    }
+    late = now;
+    vos_subTime(&late, &deadline);
+    printf("vos_threadDelayUntil: %d us late\n", late.tv_usec);
+    if ((late.tv_sec != 0) || (late.tv_usec > 10000))
+    {
+        return 1;
+    }
+    return 0;
+}
+
+int testTimeNs()
+{
+    VOS_TIMEVAL_T   tv;
+    VOS_TIME_NS_T   before;
+    VOS_TIME_NS_T   after;
+
+    before = vos_getTimeNs();
+    vos_getTime(&tv);
+    after = vos_getTimeNs();
+
+    /* same time base as vos_getTime(), microsecond resolution of the timeval lost */
+    if ((before > after) ||
+        (VOS_TIME_TO_NS(&tv) < before - 1000) ||
+        (VOS_TIME_TO_NS(&tv) > after))
+    {
+        return 1;
+    }
+
+    VOS_NS_TO_TIME(after, &tv);
+    if (VOS_TIME_TO_NS(&tv) != after - (after % 1000))
+    {
+        return 1;
+    }
+    return 0;
+}
+
+static VOS_TIME_NS_T   sSimWakeUp[3];
+static volatile int     sSimDone;
+
+static void simWorker (void *pArg)
+{
+    int i;
+
+    for (i = 0; i < 3; i++)
+    {
+        (void) vos_threadDelay(3000);
+        sSimWakeUp[i] = vos_getTimeNs();
+    }
+    sSimDone = 1;
+    (void) vos_simClockJoin(-1);
+}
+
+int testSimClock()
+{
+    const VOS_TIME_NS_T start = (VOS_TIME_NS_T) 1000 * 1000000000;
+    VOS_TIMEVAL_T       timeOut = {2, 0};
+    VOS_TIMEVAL_T       tv;
+    VOS_THREAD_T        thread;
+    VOS_TIME_NS_T       realStart = vos_getTimeNs();
+    int                 i;
+
+    /* one participant: the clock jumps to every wake-up time */
+    if (vos_simClockStart(start, 1) != VOS_NO_ERR)
+    {
+        return 1;
+    }
+    (void) vos_threadDelay(5000000);
+    if (vos_getTimeNs() != start + (VOS_TIME_NS_T) 5000000000LL)
+    {
+        printf("simulated delay: %lld\n", (long long) (vos_getTimeNs() - start));
+        vos_simClockStop();
+        return 1;
+    }
+    (void) vos_select(0, NULL, NULL, NULL, &timeOut);
+    vos_getTime(&tv);
+    if ((tv.tv_sec != 1007) || (tv.tv_usec != 0))
+    {
+        vos_simClockStop();
+        return 1;
+    }
+
+    /* two participants: worker wakes at +3, +6, +9ms, main steps in 1ms */
+    (void) vos_simClockJoin(1);
+    sSimDone = 0;
+    if (vos_threadCreate(&thread, "simWorker", VOS_THREAD_POLICY_OTHER, 0, 0, 0, simWorker, NULL) != VOS_NO_ERR)
+    {
+        vos_simClockStop();
+        return 1;
+    }
+    for (i = 0; (i < 100) && (sSimDone == 0); i++)
+    {
+        (void) vos_threadDelay(1000);
+    }
+    vos_simClockStop();
+
+    for (i = 0; i < 3; i++)
+    {
+        if (sSimWakeUp[i] != start + (VOS_TIME_NS_T) 7000000000LL + (VOS_TIME_NS_T) (i + 1) * 3000000)
+        {
+            printf("simulated worker wake-up %d: %lld\n", i, (long long) (sSimWakeUp[i] - start));
+            return 1;
+        }
+    }
+
+    /* back on the OS clock, and much faster than the simulated 7s */
+    if ((vos_getTimeNs() < realStart) || (vos_getTimeNs() - realStart > (VOS_TIME_NS_T) 2000000000LL))
+    {
+        return 1;
+    }
+    return 0;
+}
+
+#define SIM_MANY_WORKERS    (VOS_SIM_MAX_WAITERS + 8)
+
+static VOS_TIME_NS_T    sSimManyWakeUp[SIM_MANY_WORKERS];
+
+static void simManyWorker (void *pArg)
+{
+    int idx = (int) (size_t) pArg;
+
+    (void) vos_threadDelay((UINT32) (idx + 1) * 1000);
+    sSimManyWakeUp[idx] = vos_getTimeNs();
+    (void) vos_simClockJoin(-1);
+}
+
+/* more waiting threads than prepared slots: all of them block and wake up in time */
+int testSimClockWaiters()
+{
+    const VOS_TIME_NS_T start = (VOS_TIME_NS_T) 2000 * 1000000000;
+    VOS_THREAD_T        thread;
+    int                 i;
+
+    memset(sSimManyWakeUp, 0, sizeof(sSimManyWakeUp));
+    if (vos_simClockStart(start, SIM_MANY_WORKERS + 1) != VOS_NO_ERR)
+    {
+        return 1;
+    }
+    for (i = 0; i < SIM_MANY_WORKERS; i++)
+    {
+        if (vos_threadCreate(&thread, "simMany", VOS_THREAD_POLICY_OTHER, 0, 0, 0, simManyWorker,
+                             (void *) (size_t) i) != VOS_NO_ERR)
+        {
+            vos_simClockStop();
+            return 1;
+        }
+    }
+    /* the last worker wakes at +SIM_MANY_WORKERS ms */
+    for (i = 0; i <= SIM_MANY_WORKERS; i++)
+    {
+        (void) vos_threadDelay(1000);
+    }
+    vos_simClockStop();
+
+    for (i = 0; i < SIM_MANY_WORKERS; i++)
+    {
+        if (sSimManyWakeUp[i] != start + (VOS_TIME_NS_T) (i + 1) * 1000000)
+        {
+            printf("simulated worker %d of %d wake-up: %lld\n", i, SIM_MANY_WORKERS,
+                   (long long) (sSimManyWakeUp[i] - start));
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static char     sLogLine[8][VOS_MAX_PRNT_STR_SIZE];
+static char     sLogTime[8][32];
+static int      sLogCount;
+static int      sLogEvaluated;
+
+static void logCapture (void *pRefCon, VOS_LOG_T category, const CHAR8 *pTime, const CHAR8 *pFile,
+                        UINT16 line, const CHAR8 *pMsgStr)
+{
+    (void) pRefCon; (void) category; (void) pFile; (void) line;
+    if (sLogCount < 8)
+    {
+        strncpy(sLogLine[sLogCount], pMsgStr, VOS_MAX_PRNT_STR_SIZE - 1);
+        strncpy(sLogTime[sLogCount], pTime, sizeof(sLogTime[0]) - 1);
+        sLogCount++;
+    }
+}
+
+static int logArg (void)
+{
+    sLogEvaluated++;
+    return 42;
+}
+
+int testLog()
+{
+    static const char *cExpected[] = {"int -7 uint 4000000000 hex 0x1f", "str <eth0> ptr? 1 pad [  42]",
+                                      "ll -1234567890123 float 2.50 100%", "plain string"};
+    char    name[8] = "eth0";
+    char    longName[200];
+    char    today[16];
+    int     i;
+    int     result = 0;
+
+    (void) vos_init(NULL, logCapture);
+
+    /* level gate: filtered messages are neither formatted nor are their arguments evaluated */
+    vos_setLogLevel(VOS_LOG_WARNING);
+    sLogCount = sLogEvaluated = 0;
+    vos_printLog(VOS_LOG_DBG, "debug %d\n", logArg());
+    vos_printLog(VOS_LOG_WARNING, "warning %d", logArg());
+    if ((sLogCount != 1) || (sLogEvaluated != 1) || (strcmp(sLogLine[0], "warning 42") != 0))
+    {
+        result = 1;
+    }
+    vos_setLogLevel(VOS_LOG_USR);
+
+    /* binary mode: raw arguments are recorded, formatting happens when drained */
+    if ((result == 0) && (vos_setLogMode(VOS_LOG_MODE_BINARY) == VOS_NO_ERR))
+    {
+        sLogCount = 0;
+        vos_printLog(VOS_LOG_INFO, "int %d uint %u hex 0x%x", -7, 4000000000u, 31u);
+        vos_printLog(VOS_LOG_INFO, "str <%s> ptr? %d pad [%*d]", name, (int) (name != NULL), 4, logArg());
+        strcpy(name, "XXXX");                       /* the string was copied */
+        vos_printLog(VOS_LOG_INFO, "ll %lld float %.2f 100%%", -1234567890123LL, 2.5);
+        vos_printLogStr(VOS_LOG_INFO, "plain string");
+        memset(longName, 'a', sizeof(longName) - 1);
+        longName[sizeof(longName) - 1] = '\0';
+        vos_printLog(VOS_LOG_INFO, "%s", longName);
+        (void) vos_setLogMode(VOS_LOG_MODE_TEXT);
+
+        for (i = 0; i < 4; i++)
+        {
+            if ((sLogCount != 5) || (strcmp(sLogLine[i], cExpected[i]) != 0))
+            {
+                printf("binary log %d: '%s'\n", i, (i < sLogCount) ? sLogLine[i] : "");
+                result = 1;
+            }
+        }
+        /* a string argument longer than a record holds is cut and marked */
+        if ((sLogCount == 5) &&
+            ((strlen(sLogLine[4]) >= strlen(longName)) ||
+             (strcmp(&sLogLine[4][strlen(sLogLine[4]) - 3], "...") != 0)))
+        {
+            printf("binary log cut string: '%s'\n", sLogLine[4]);
+            result = 1;
+        }
+        /* time stamps are wall-clock: same date as the text mode stamp */
+        strncpy(today, vos_getTimeStamp(), 9);
+        today[9] = '\0';
+        if (strncmp(sLogTime[0], today, 9) != 0)
+        {
+            printf("binary log time stamp '%s', expected date %s\n", sLogTime[0], today);
+            result = 1;
+        }
+    }
+    else
+    {
+        result = 1;
+    }
+
+    (void) vos_init(NULL, NULL);
+    return result;
+}
+
+int testSharedMem()
+{
+#if POSIX
+    const CHAR8 *pKey       = "/trdp_vostest_shm";
+    VOS_SHRD_T  handle1     = NULL;
+    VOS_SHRD_T  handle2     = NULL;
+    UINT8       *pArea1     = NULL;
+    UINT8       *pArea2     = NULL;
+    UINT32      size        = 4096u;
+    UINT32      i;
+
+    /* a created area is cleared */
+    if ((vos_sharedOpen(pKey, &handle1, &pArea1, &size) != VOS_NO_ERR) || (size != 4096u))
+    {
+        return 1;
+    }
+    for (i = 0u; i < size; i++)
+    {
+        if (pArea1[i] != 0u)
+        {
+            return 1;
+        }
+    }
+    memcpy(pArea1, "TRDP", 4u);
+
+    /* attaching keeps the content and the size of the existing area */
+    size = 64u;
+    if ((vos_sharedOpen(pKey, &handle2, &pArea2, &size) != VOS_NO_ERR) ||
+        (size != 4096u) ||
+        (memcmp(pArea2, "TRDP", 4u) != 0))
+    {
+        return 1;
+    }
+    pArea2[4] = 'x';
+    if ((pArea1[4] != 'x') ||
+        (vos_sharedClose(handle2, pArea2) != VOS_NO_ERR))
+    {
+        return 1;
+    }
+
+    /* the creator removes the area */
+    if (vos_sharedClose(handle1, pArea1) != VOS_NO_ERR)
+    {
+        return 1;
+    }
+    size = 64u;
+    if ((vos_sharedOpen(pKey, &handle1, &pArea1, &size) != VOS_NO_ERR) ||
+        (size != 64u) ||
+        (pArea1[0] != 0u) ||
+        (vos_sharedClose(handle1, pArea1) != VOS_NO_ERR))
+    {
+        return 1;
+    }
+#endif
+    return 0;
+}
+
 int main(int argc, char *argv[])
 {
     printf("Starting tests\n");
@@ -339,6 +778,54 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    if(testCyclicThread())
+    {
+        printf("Cyclic thread testing failed\n");
+        return 1;
+    }
+
+    if(testThreadAttr())
+    {
+        printf("Thread attribute testing failed\n");
+        return 1;
+    }
+
+    if(testDelayUntil())
+    {
+        printf("Precise delay testing failed\n");
+        return 1;
+    }
+
+    if(testTimeNs())
+    {
+        printf("Nanosecond time testing failed\n");
+        return 1;
+    }
+
+    if(testSimClock())
+    {
+        printf("Simulated clock testing failed\n");
+        return 1;
+    }
+
+    if(testSimClockWaiters())
+    {
+        printf("Simulated clock with many waiting threads failed\n");
+        return 1;
+    }
+
+    if(testLog())
+    {
+        printf("Log testing failed\n");
+        return 1;
+    }
+
+    if(testSharedMem())
+    {
+        printf("Shared memory testing failed\n");
+        return 1;
+    }
+
     printf("All tests successfully finished.\n");
     return 0;
 }
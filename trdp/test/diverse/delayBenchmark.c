@@ -0,0 +1,420 @@
+/**********************************************************************************************************************/
+/**
+ * @file            delayBenchmark.c
+ *
+ * @brief           Wake-up error of vos_threadDelay() vs. vos_threadDelayUntil()
+ *
+ * @details         Waits n times for a cyclic deadline and records how late the thread actually resumed,
+ *                  once with a plain (relative) vos_threadDelay(), once with vos_threadDelayUntil() without and
+ *                  with a spin guard band. The error distribution is printed as histogram.
+ *                  Then a TRDP session on the loopback interface publishes one telegram at the cycle time and the
+ *                  deviation of the send intervals from the cycle is recorded (tlc_getInterval, select,
+ *                  tlc_process), without and with TRDP_OPTION_PRECISE_WAIT.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined (POSIX)
+#include <unistd.h>
+#elif (defined (WIN32) || defined (WIN64))
+#include "getopt.h"
+#endif
+#include "vos_types.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+#include "vos_sock.h"
+#include "trdp_if_light.h"
+
+/***********************************************************************************************************************
+ * DEFINITIONS
+ */
+#define APP_VERSION         "1.0"
+
+#define DEFAULT_SAMPLES     1000u
+#define DEFAULT_CYCLE       1000u           /* in us */
+#define DEFAULT_GUARD       200u            /* in us */
+
+#define NO_OF_BUCKETS       9u
+
+#define BENCH_COMID         1000u
+#define BENCH_IP            0x7F000001u     /* loopback */
+#define BENCH_MIN_INTERVAL  10000u          /* shortest publisher interval in us (TRDP_TIMER_GRANULARITY) */
+
+typedef enum
+{
+    BENCH_DELAY,                            /* vos_threadDelay(deadline - now)          */
+    BENCH_DELAY_UNTIL,                      /* vos_threadDelayUntil(deadline, 0)        */
+    BENCH_DELAY_UNTIL_GUARD,                /* vos_threadDelayUntil(deadline, guard)    */
+    BENCH_PROCESS,                          /* tlc_process send jitter                  */
+    BENCH_PROCESS_PRECISE                   /* same with TRDP_OPTION_PRECISE_WAIT       */
+} BENCH_MODE_T;
+
+typedef struct
+{
+    UINT32  bucket[NO_OF_BUCKETS];
+    UINT32  *pSample;
+    UINT32  count;
+    UINT32  max;
+    UINT64  sum;
+} BENCH_RESULT_T;
+
+static const UINT32 cBucketLimit[NO_OF_BUCKETS - 1u] = {1u, 5u, 10u, 20u, 50u, 100u, 200u, 500u};
+
+/* State of the send callback during a tlc_process run */
+static BENCH_RESULT_T   *sProcessResult = NULL;
+static VOS_TIMEVAL_T    sLastSend;
+static UINT32           sProcessCycle;
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+static void usage (const char *appName);
+static int  compareUINT32 (const void *pA, const void *pB);
+static void addSample (BENCH_RESULT_T *pResult, UINT32 late);
+static void runBench (BENCH_MODE_T mode, UINT32 samples, UINT32 cycle, UINT32 guard, BENCH_RESULT_T *pResult);
+static int  runProcessBench (TRDP_OPTION_T option, UINT32 samples, UINT32 cycle, BENCH_RESULT_T *pResult);
+static void printResult (const char *pTitle, BENCH_RESULT_T *pResult);
+
+/**********************************************************************************************************************/
+/** Print usage
+ *
+ *  @param[in]      appName         program name
+ */
+static void usage (const char *appName)
+{
+    printf("%s: Version %s\t(%s - %s)\n", appName, APP_VERSION, __DATE__, __TIME__);
+    printf("Usage of %s\n", appName);
+    printf("Measure the wake-up error of vos_threadDelay() vs. vos_threadDelayUntil()\n"
+           "and the send jitter of tlc_process() without and with TRDP_OPTION_PRECISE_WAIT\n"
+           "(publisher interval: cycle time, at least %u us).\n"
+           "Arguments are:\n"
+           "-n number of samples per run (default %u)\n"
+           "-c cycle time in us (default %u)\n"
+           "-g guard band in us (default %u)\n"
+           "-h print usage\n",
+           BENCH_MIN_INTERVAL, DEFAULT_SAMPLES, DEFAULT_CYCLE, DEFAULT_GUARD);
+}
+
+/**********************************************************************************************************************/
+/** qsort helper
+ */
+static int compareUINT32 (const void *pA, const void *pB)
+{
+    UINT32 a = *(const UINT32 *) pA;
+    UINT32 b = *(const UINT32 *) pB;
+
+    return (a > b) - (a < b);
+}
+
+/**********************************************************************************************************************/
+/** Wait for samples deadlines with the given method and collect the lateness
+ *
+ *  @param[in]      mode            delay method
+ *  @param[in]      samples         number of deadlines to wait for
+ *  @param[in]      cycle           distance of the deadlines in us
+ *  @param[in]      guard           guard band in us (BENCH_DELAY_UNTIL_GUARD only)
+ *  @param[out]     pResult         collected samples and histogram
+ */
+static void runBench (
+    BENCH_MODE_T    mode,
+    UINT32          samples,
+    UINT32          cycle,
+    UINT32          guard,
+    BENCH_RESULT_T  *pResult)
+{
+    VOS_TIMEVAL_T   deadline;
+    VOS_TIMEVAL_T   interval    = {0u, 0};
+    VOS_TIMEVAL_T   now;
+    VOS_TIMEVAL_T   diff;
+    UINT32          i;
+    UINT32          late;
+
+    interval.tv_sec     = cycle / 1000000u;
+    interval.tv_usec    = (INT32) (cycle % 1000000u);
+
+    vos_getTime(&deadline);
+    for (i = 0u; i < samples; i++)
+    {
+        vos_addTime(&deadline, &interval);
+        vos_getTime(&now);
+
+        switch (mode)
+        {
+            case BENCH_DELAY:
+                if (vos_cmpTime(&now, &deadline) < 0)
+                {
+                    diff = deadline;
+                    vos_subTime(&diff, &now);
+                    (void) vos_threadDelay((UINT32) diff.tv_sec * 1000000u + (UINT32) diff.tv_usec);
+                }
+                break;
+            case BENCH_DELAY_UNTIL:
+                (void) vos_threadDelayUntil(&deadline, 0u);
+                break;
+            case BENCH_DELAY_UNTIL_GUARD:
+                (void) vos_threadDelayUntil(&deadline, guard);
+                break;
+            default:
+                break;
+        }
+
+        vos_getTime(&now);
+        late = 0u;
+        if (vos_cmpTime(&now, &deadline) > 0)
+        {
+            diff = now;
+            vos_subTime(&diff, &deadline);
+            late = (UINT32) diff.tv_sec * 1000000u + (UINT32) diff.tv_usec;
+        }
+
+        /* re-sync if we missed a whole cycle, do not count the catch-up */
+        if (late >= cycle)
+        {
+            deadline = now;
+        }
+
+        addSample(pResult, late);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Count one sample
+ *
+ *  @param[in,out]  pResult         collected samples and histogram
+ *  @param[in]      late            error in us
+ */
+static void addSample (
+    BENCH_RESULT_T  *pResult,
+    UINT32          late)
+{
+    UINT32 j;
+
+    for (j = 0u; (j < NO_OF_BUCKETS - 1u) && (late >= cBucketLimit[j]); j++)
+    {
+        ;
+    }
+    pResult->bucket[j]++;
+    pResult->pSample[pResult->count++] = late;
+    pResult->sum += late;
+    if (late > pResult->max)
+    {
+        pResult->max = late;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Pre-send callback: record the deviation of the send interval from the cycle
+ */
+static void sendCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    VOS_TIMEVAL_T   now;
+    VOS_TIMEVAL_T   diff;
+    UINT32          interval;
+
+    vos_getTime(&now);
+    if ((sProcessResult != NULL) && ((sLastSend.tv_sec != 0u) || (sLastSend.tv_usec != 0)))
+    {
+        diff = now;
+        vos_subTime(&diff, &sLastSend);
+        interval = (UINT32) diff.tv_sec * 1000000u + (UINT32) diff.tv_usec;
+        addSample(sProcessResult, (interval > sProcessCycle) ? interval - sProcessCycle : sProcessCycle - interval);
+    }
+    sLastSend = now;
+}
+
+/**********************************************************************************************************************/
+/** Publish one telegram on the loopback interface and run the TRDP processing loop until samples send intervals
+ *  were recorded
+ *
+ *  @param[in]      option          session options (TRDP_OPTION_PRECISE_WAIT or none)
+ *  @param[in]      samples         number of send intervals to record
+ *  @param[in]      cycle           publisher interval in us
+ *  @param[out]     pResult         collected samples and histogram
+ *
+ *  @retval         0        no error
+ *  @retval         1        session could not be opened
+ */
+static int runProcessBench (
+    TRDP_OPTION_T   option,
+    UINT32          samples,
+    UINT32          cycle,
+    BENCH_RESULT_T  *pResult)
+{
+    TRDP_PROCESS_CONFIG_T   processConfig   = {"delayBench", "", 0u, 0u, TRDP_OPTION_NONE};
+    TRDP_APP_SESSION_T      appHandle       = NULL;
+    TRDP_PUB_T              pubHandle       = NULL;
+    UINT8                   data[16];
+
+    if (cycle < BENCH_MIN_INTERVAL)
+    {
+        cycle = BENCH_MIN_INTERVAL;
+    }
+    printf("\ntlc_process run: publisher interval %u us\n", (unsigned int) cycle);
+
+    processConfig.cycleTime = cycle;
+    processConfig.options   = option;
+    memset(data, 0, sizeof(data));
+    memset(&sLastSend, 0, sizeof(sLastSend));
+    sProcessCycle = cycle;
+
+    if ((tlc_openSession(&appHandle, BENCH_IP, 0u, NULL, NULL, NULL, &processConfig) != TRDP_NO_ERR) ||
+        (tlp_publish(appHandle, &pubHandle, NULL, sendCallback, BENCH_COMID, 0u, 0u, 0u, BENCH_IP, cycle, 0u,
+                     TRDP_FLAGS_NONE, NULL, data, sizeof(data)) != TRDP_NO_ERR))
+    {
+        printf("TRDP session on the loopback interface not available\n");
+        (void) tlc_closeSession(appHandle);
+        return 1;
+    }
+
+    sProcessResult = pResult;
+    while (pResult->count < samples)
+    {
+        TRDP_FDS_T      rfds;
+        TRDP_TIME_T     tv;
+        INT32           noDesc = 0;
+        INT32           rv;
+
+        FD_ZERO(&rfds);
+        (void) tlc_getInterval(appHandle, &tv, &rfds, &noDesc);
+        rv = vos_select(noDesc + 1, &rfds, NULL, NULL, &tv);
+        (void) tlc_process(appHandle, &rfds, &rv);
+    }
+    sProcessResult = NULL;
+
+    (void) tlp_unpublish(appHandle, pubHandle);
+    (void) tlc_closeSession(appHandle);
+    return 0;
+}
+
+/**********************************************************************************************************************/
+/** Print histogram and percentiles of one run
+ *
+ *  @param[in]      pTitle          name of the run
+ *  @param[in]      pResult         collected samples
+ */
+static void printResult (
+    const char      *pTitle,
+    BENCH_RESULT_T  *pResult)
+{
+    UINT32 j;
+
+    if (pResult->count == 0u)
+    {
+        return;
+    }
+    qsort(pResult->pSample, pResult->count, sizeof(UINT32), compareUINT32);
+
+    printf("\n%s\n", pTitle);
+    printf("  mean %6u us   p50 %6u us   p99 %6u us   max %6u us\n",
+           (unsigned int) (pResult->sum / pResult->count),
+           (unsigned int) pResult->pSample[pResult->count / 2u],
+           (unsigned int) pResult->pSample[(pResult->count * 99u) / 100u],
+           (unsigned int) pResult->max);
+    for (j = 0u; j < NO_OF_BUCKETS; j++)
+    {
+        if (j < NO_OF_BUCKETS - 1u)
+        {
+            printf("  < %4u us: %8u\n", (unsigned int) cBucketLimit[j], (unsigned int) pResult->bucket[j]);
+        }
+        else
+        {
+            printf("  >=%4u us: %8u\n", (unsigned int) cBucketLimit[j - 1u], (unsigned int) pResult->bucket[j]);
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char *argv[])
+{
+    static const char   *cTitle[] = {"vos_threadDelay (relative sleep):",
+                                     "vos_threadDelayUntil, no guard (absolute sleep):",
+                                     "vos_threadDelayUntil with guard band (sleep, then spin):",
+                                     "tlc_process send jitter:",
+                                     "tlc_process send jitter, TRDP_OPTION_PRECISE_WAIT:"};
+    BENCH_RESULT_T      result;
+    UINT32              samples = DEFAULT_SAMPLES;
+    UINT32              cycle   = DEFAULT_CYCLE;
+    UINT32              guard   = DEFAULT_GUARD;
+    int                 ch;
+    int                 mode;
+
+    while ((ch = getopt(argc, argv, "n:c:g:h?")) != -1)
+    {
+        switch (ch)
+        {
+            case 'n':
+                samples = (UINT32) strtoul(optarg, NULL, 10);
+                break;
+            case 'c':
+                cycle = (UINT32) strtoul(optarg, NULL, 10);
+                break;
+            case 'g':
+                guard = (UINT32) strtoul(optarg, NULL, 10);
+                break;
+            case 'h':
+            case '?':
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if ((samples == 0u) || (cycle == 0u) || (tlc_init(NULL, NULL, NULL) != TRDP_NO_ERR))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    printf("%u samples, cycle %u us, guard %u us\n", (unsigned int) samples, (unsigned int) cycle,
+           (unsigned int) guard);
+
+    for (mode = BENCH_DELAY; mode <= BENCH_PROCESS_PRECISE; mode++)
+    {
+        memset(&result, 0, sizeof(result));
+        result.pSample = (UINT32 *) malloc(samples * sizeof(UINT32));
+        if (result.pSample == NULL)
+        {
+            printf("Out of memory\n");
+            return 1;
+        }
+        if (mode < BENCH_PROCESS)
+        {
+            runBench((BENCH_MODE_T) mode, samples, cycle, guard, &result);
+            printResult(cTitle[mode], &result);
+        }
+        else if (runProcessBench((mode == BENCH_PROCESS) ? TRDP_OPTION_NONE : TRDP_OPTION_PRECISE_WAIT,
+                                 samples, cycle, &result) == 0)
+        {
+            printResult(cTitle[mode], &result);
+        }
+        free(result.pSample);
+    }
+
+    (void) tlc_terminate();
+    return 0;
+}
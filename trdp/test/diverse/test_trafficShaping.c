@@ -14,6 +14,7 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: Print resulting slot table load per interface
  *      BL 2017-06-30: Compiler warnings, local prototypes added
  *      BL 2017-05-22: Ticket #122: Addendum for 64Bit compatibility (VOS_TIME_T -> VOS_TIMEVAL_T)
  */
@@ -32,6 +33,7 @@
 #endif
 #include "trdp_if_light.h"
 #include "vos_thread.h"
+#include "vos_sock.h"
 
 /***********************************************************************************************************************
  * DEFINITIONS
@@ -275,6 +277,22 @@ int main (int argc, char *argv[])
             return 1;
         }
     }
+
+    /*    Show the resulting worst case burst per interface    */
+    {
+        TRDP_SHAPING_STATISTICS_T   shapingStats[4];
+        UINT16                      numIf = 4;
+
+        if (tlc_getShapingStatistics(appHandle, &numIf, shapingStats) == TRDP_NO_ERR)
+        {
+            for (i = 0; i < numIf; i++)
+            {
+                printf("%s: %u publishers, %u slots of %u us, worst case burst %u bytes\n",
+                       vos_ipDotted(shapingStats[i].ifAddr), shapingStats[i].numPub,
+                       shapingStats[i].noOfSlots, shapingStats[i].slotTime, shapingStats[i].maxBurst);
+            }
+        }
+    }
     
     
     /*
@@ -0,0 +1,245 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp-history.c
+ *
+ * @brief           Reader for the TRDP statistics history
+ *
+ * @details         Maps the shared memory area written by tlc_openHistory() and prints the samples, oldest first,
+ *                  as CSV: PD and MD rates, memory, tlc_process() cycle times and latencies per interval.
+ *                  The writing process is not disturbed; the area can also be read after it crashed.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ *      BL 2026-10-17: Samples copied between acquire loads of the sequence number instead of volatile
+ *
+ */
+
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "trdp_types.h"
+#include "vos_shared_mem.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define APP_VERSION         "1.0"
+
+/* Access to the sequence numbers shared with the writer (seqlock), see trdp_history.c */
+#if (defined (WIN32) || defined (WIN64))
+#include <intrin.h>
+#define HISTORY_LOAD(p)             ((UINT32) _InterlockedOr((volatile long *) (p), 0))
+#define HISTORY_FENCE_ACQUIRE()     ((void) 0)
+#else
+#define HISTORY_LOAD(p)             __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define HISTORY_FENCE_ACQUIRE()     __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#endif
+
+/***********************************************************************************************************************
+ * Prototypes
+ */
+void    usage (const char *appName);
+BOOL8   readSample (const TRDP_HISTORY_SAMPLE_T *pRing, UINT32 noOfSamples, UINT32 number,
+                    TRDP_HISTORY_SAMPLE_T *pSample);
+void    printSample (const TRDP_HISTORY_SAMPLE_T *pCur, const TRDP_HISTORY_SAMPLE_T *pPrev);
+
+/**********************************************************************************************************************/
+/** Print a sensible usage message
+ *
+ *  @param[in]      appName         program name
+ */
+void usage (const char *appName)
+{
+    printf("Usage of %s\n", appName);
+    printf("Print the statistics history of a TRDP session (tlc_openHistory) as CSV.\n"
+           "Arguments are:\n"
+           "<key> [<count>]   name of the shared memory area, number of newest samples (default: all)\n"
+           "Version %s\n", APP_VERSION);
+}
+
+/**********************************************************************************************************************/
+/** Copy a sample out of the ring, the writer does not wait for us
+ *
+ *  @param[in]      pRing           first sample of the ring
+ *  @param[in]      noOfSamples     size of the ring
+ *  @param[in]      number          number of the sample (1 = first written)
+ *  @param[out]     pSample         copy
+ *
+ *  @retval         TRUE            consistent copy
+ *  @retval         FALSE           sample was overwritten meanwhile
+ */
+BOOL8 readSample (
+    const TRDP_HISTORY_SAMPLE_T *pRing,
+    UINT32                      noOfSamples,
+    UINT32                      number,
+    TRDP_HISTORY_SAMPLE_T       *pSample)
+{
+    const TRDP_HISTORY_SAMPLE_T *pSlot = &pRing[(number - 1u) % noOfSamples];
+
+    if (HISTORY_LOAD(&pSlot->seq) != number)
+    {
+        return FALSE;
+    }
+    memcpy(pSample, pSlot, sizeof(TRDP_HISTORY_SAMPLE_T));
+    /*  The copy must be complete before the sequence number is checked again   */
+    HISTORY_FENCE_ACQUIRE();
+    pSample->seq = number;
+    return (HISTORY_LOAD(&pSlot->seq) == number) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Print the rates between two samples
+ *
+ *  @param[in]      pCur            sample
+ *  @param[in]      pPrev           previous sample or NULL (rates unknown)
+ */
+void printSample (
+    const TRDP_HISTORY_SAMPLE_T *pCur,
+    const TRDP_HISTORY_SAMPLE_T *pPrev)
+{
+    char        timeStr[32];
+    time_t      sec = (time_t) pCur->wallTime;
+    struct tm   *pTm = localtime(&sec);
+    double      dt;
+    UINT32      passes;
+    UINT32      latencies;
+
+    if ((pTm == NULL) || (strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", pTm) == 0u))
+    {
+        (void) snprintf(timeStr, sizeof(timeStr), "%u", (unsigned int) pCur->wallTime);
+    }
+    printf("%s,%u,", timeStr, (unsigned int) pCur->upTime);
+
+    /*  No rates for the first sample and after a restart of the writer    */
+    if ((pPrev == NULL) || (pCur->upTime < pPrev->upTime))
+    {
+        printf(",,,,,,,,,%u,%u,%u,,,,,,\n", (unsigned int) pCur->memFree, (unsigned int) pCur->memMinFree,
+               (unsigned int) pCur->memNumAllocErr);
+        return;
+    }
+    dt = (double) (pCur->timeSec - pPrev->timeSec) + ((double) pCur->timeUsec - (double) pPrev->timeUsec) / 1e6;
+    if (dt <= 0.0)
+    {
+        dt = 1.0;
+    }
+    passes      = pCur->numPasses - pPrev->numPasses;
+    latencies   = pCur->numLatency - pPrev->numLatency;
+
+    printf("%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%u,%u,%u,%.1f,%.1f,%.1f,%u,%u,%.1f\n",
+           (pCur->pdNumRcv - pPrev->pdNumRcv) / dt,
+           (pCur->pdNumSend - pPrev->pdNumSend) / dt,
+           (pCur->pdNumMissed - pPrev->pdNumMissed) / dt,
+           (pCur->pdNumTimeout - pPrev->pdNumTimeout) / dt,
+           ((pCur->pdNumCrcErr - pPrev->pdNumCrcErr) + (pCur->pdNumProtErr - pPrev->pdNumProtErr) +
+            (pCur->pdNumTopoErr - pPrev->pdNumTopoErr)) / dt,
+           (pCur->mdNumRcv - pPrev->mdNumRcv) / dt,
+           (pCur->mdNumSend - pPrev->mdNumSend) / dt,
+           (pCur->mdNumErr - pPrev->mdNumErr) / dt,
+           ((pCur->mdNumReplyTimeout - pPrev->mdNumReplyTimeout) +
+            (pCur->mdNumConfirmTimeout - pPrev->mdNumConfirmTimeout)) / dt,
+           (unsigned int) pCur->memFree,
+           (unsigned int) pCur->memMinFree,
+           (unsigned int) pCur->memNumAllocErr,
+           passes / dt,
+           (passes == 0u) ? 0.0 : (double) (pCur->passTime - pPrev->passTime) / passes / 1000.0,
+           pCur->passMax / 1000.0,
+           (unsigned int) ((pCur->numPassOverruns - pPrev->numPassOverruns) +
+                           (pCur->numCallbackOverruns - pPrev->numCallbackOverruns)),
+           (unsigned int) (pCur->numSlowCallbacks - pPrev->numSlowCallbacks),
+           (latencies == 0u) ? 0.0 : (double) (pCur->latencySum - pPrev->latencySum) / latencies / 1000.0);
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char *argv[])
+{
+    VOS_SHRD_T                  handle  = NULL;
+    UINT8                       *pArea  = NULL;
+    UINT32                      size    = sizeof(TRDP_HISTORY_HEADER_T);
+    const TRDP_HISTORY_HEADER_T *pHeader;
+    const TRDP_HISTORY_SAMPLE_T *pRing;
+    TRDP_HISTORY_SAMPLE_T       cur;
+    TRDP_HISTORY_SAMPLE_T       prev;
+    BOOL8                       havePrev = FALSE;
+    UINT32                      numWritten;
+    UINT32                      first;
+    UINT32                      count   = 0u;
+    UINT32                      i;
+
+    if (argc < 2)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+    if (argc > 2)
+    {
+        count = (UINT32) strtoul(argv[2], NULL, 10);
+    }
+
+    if (vos_sharedOpen(argv[1], &handle, &pArea, &size) != VOS_NO_ERR)
+    {
+        fprintf(stderr, "Cannot open %s\n", argv[1]);
+        return 1;
+    }
+    pHeader = (const TRDP_HISTORY_HEADER_T *) pArea;
+    if ((size < sizeof(TRDP_HISTORY_HEADER_T)) ||
+        (memcmp(pHeader->magic, TRDP_HISTORY_MAGIC, sizeof(TRDP_HISTORY_MAGIC)) != 0) ||
+        (pHeader->version != TRDP_HISTORY_VERSION) ||
+        (pHeader->headerSize != sizeof(TRDP_HISTORY_HEADER_T)) ||
+        (pHeader->sampleSize != sizeof(TRDP_HISTORY_SAMPLE_T)) ||
+        (pHeader->noOfSamples == 0u) ||
+        (size < pHeader->headerSize + pHeader->noOfSamples * pHeader->sampleSize))
+    {
+        fprintf(stderr, "%s is no statistics history of this version / byte order\n", argv[1]);
+        (void) vos_sharedClose(handle, pArea);
+        return 1;
+    }
+    pRing = (const TRDP_HISTORY_SAMPLE_T *) (pArea + pHeader->headerSize);
+
+    /*  The newest sample is numWritten, the oldest still in the ring noOfSamples before    */
+    numWritten  = HISTORY_LOAD(&pHeader->numWritten);
+    first       = (numWritten > pHeader->noOfSamples) ? numWritten - pHeader->noOfSamples + 1u : 1u;
+    if ((count != 0u) && (numWritten - first + 1u > count))
+    {
+        first = numWritten - count + 1u;
+    }
+
+    printf("# %u samples of %u ms, ring of %u\n", (unsigned int) (numWritten - first + 1u),
+           (unsigned int) pHeader->interval, (unsigned int) pHeader->noOfSamples);
+    printf("time,uptime,pd_rx/s,pd_tx/s,pd_missed/s,pd_timeout/s,pd_err/s,md_rx/s,md_tx/s,md_err/s,md_timeout/s,"
+           "mem_free,mem_min_free,mem_alloc_err,passes/s,pass_mean_us,pass_max_us,overruns,slow_callbacks,"
+           "latency_mean_us\n");
+    for (i = first; (i <= numWritten) && (i != 0u); i++)
+    {
+        if (readSample(pRing, pHeader->noOfSamples, i, &cur) == FALSE)
+        {
+            havePrev = FALSE;   /*  overwritten while we read   */
+            continue;
+        }
+        printSample(&cur, (havePrev == TRUE) ? &prev : NULL);
+        prev        = cur;
+        havePrev    = TRUE;
+    }
+
+    (void) vos_sharedClose(handle, pArea);
+    return 0;
+}
@@ -0,0 +1,867 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp-top.c
+ *
+ * @brief           Live monitor of the PD traffic of one or more TRDP devices
+ *
+ * @details         Pulls the global statistics and the subscription and publisher lists
+ *                  (TRDP_STATISTICS_PULL_COMID) of the given devices once per refresh interval and displays
+ *                  packet and byte rates, loss, time-outs and rate jitter per ComId, sorted by any column.
+ *                  Only three small PD pull requests per device and interval are sent.
+ *                  The lists are answered only by devices which called tlc_publishListStatistics().
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2013. All rights reserved.
+ *
+ * $Id$
+ *
+ *      BL 2026-10-17: Lists pulled with TRDP_SUBS_LIST_COMID, TRDP_PUB_LIST_COMID
+ *      BL 2026-10-17: Created
+ *
+ */
+
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#if defined (POSIX)
+#include <unistd.h>
+#include <termios.h>
+#include <sys/select.h>
+#elif (defined (WIN32) || defined (WIN64))
+#include "getopt.h"
+#endif
+
+#include "trdp_if_light.h"
+#include "trdp_types.h"
+#include "vos_thread.h"
+#include "vos_sock.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+#define APP_VERSION         "0.0.0.1"
+
+#define MAX_NODES           16u                 /* devices to monitor                                   */
+#define MAX_ROWS            1024u               /* publishers and subscriptions of all devices          */
+#define PD_HEADER_SIZE      40u                 /* TRDP PD header including FCS, added to the byte rate */
+#define REPLY_TIMEOUT       10000000u           /* supervision of the replies in us                     */
+#define JITTER_WEIGHT       0.25                /* weight of the newest sample in the jitter average    */
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/* Sort columns (keys in brackets) */
+typedef enum
+{
+    SORT_NODE,      /* [n] */
+    SORT_DIR,       /* [d] */
+    SORT_COMID,     /* [c] */
+    SORT_SIZE,      /* [s] */
+    SORT_RATE,      /* [r] */
+    SORT_BYTES,     /* [b] */
+    SORT_LOSS,      /* [l] */
+    SORT_TIMEOUT,   /* [t] */
+    SORT_JITTER     /* [j] */
+} SORT_T;
+
+/* One monitored device */
+typedef struct
+{
+    TRDP_IP_ADDR_T      ipAddr;         /* device address                                       */
+    UINT32              numAsked;       /* pulls sent                                           */
+    UINT32              numAnswers;     /* global statistics received                           */
+    UINT32              listGen[2];     /* generation of the subscription / publisher list      */
+    UINT16              listTotal[2];   /* entries on the device (may be more than received)    */
+    BOOL8               valid;          /* prev holds a sample                                  */
+    TRDP_STATISTICS_T   cur;            /* last global statistics (host order where used)       */
+    TRDP_STATISTICS_T   prev;           /* previous global statistics                           */
+    VOS_TIME_NS_T       curTime;        /* receive time of cur                                  */
+    VOS_TIME_NS_T       prevTime;       /* receive time of prev                                 */
+} NODE_T;
+
+/* One publisher (dir = 1) or subscription (dir = 0) of a device */
+typedef struct
+{
+    UINT32          node;               /* index into gNodes                                    */
+    UINT32          dir;                /* 0: subscription, 1: publisher                        */
+    UINT32          gen;                /* list generation this row was last seen in            */
+    UINT32          comId;
+    TRDP_IP_ADDR_T  addr;               /* joined address (subscription) or destination         */
+    UINT32          size;               /* dataset size                                         */
+    UINT32          count;              /* received / sent packets                              */
+    UINT32          missed;             /* missed packets (subscriptions)                       */
+    TRDP_ERR_T      status;             /* receive status (subscriptions)                       */
+    VOS_TIME_NS_T   time;               /* time of the sample                                   */
+    BOOL8           valid;              /* rates are computed                                   */
+    double          rate;               /* packets/s                                            */
+    double          bytes;              /* bytes/s                                              */
+    double          loss;               /* % of packets lost in the last interval               */
+    UINT32          timeouts;           /* time-outs observed                                   */
+    double          jitter;             /* average change of the packet rate in %               */
+} ROW_T;
+
+/***********************************************************************************************************************
+ * Locals
+ */
+static NODE_T   gNodes[MAX_NODES];
+static UINT32   gNumNodes   = 0u;
+static ROW_T    gRows[MAX_ROWS];
+static UINT32   gNumRows    = 0u;
+static SORT_T   gSort       = SORT_RATE;
+static BOOL8    gDescending = TRUE;
+static BOOL8    gBatch      = FALSE;
+static volatile BOOL8 gKeepOnRunning = TRUE;
+#if defined (POSIX)
+static BOOL8            gRawMode = FALSE;
+static struct termios   gOldTerm;
+#endif
+
+/***********************************************************************************************************************
+ * Prototypes
+ */
+void    myPDcallBack (void                  *pRefCon,
+                      TRDP_APP_SESSION_T    appHandle,
+                      const TRDP_PD_INFO_T  *pMsg,
+                      UINT8                 *pData,
+                      UINT32                dataSize);
+void    dbgOut (void           *pRefCon,
+                TRDP_LOG_T     category,
+                const CHAR8    *pTime,
+                const CHAR8    *pFile,
+                UINT16         LineNumber,
+                const CHAR8    *pMsgStr);
+void    usage (const char *appName);
+
+static NODE_T   *findNode (TRDP_IP_ADDR_T ipAddr);
+static ROW_T    *findRow (UINT32 node, UINT32 dir, UINT32 comId, TRDP_IP_ADDR_T addr);
+static void     updateRow (ROW_T *pRow, UINT32 count, UINT32 missed, TRDP_ERR_T status, UINT32 size,
+                           VOS_TIME_NS_T now);
+static void     storeGlobal (NODE_T *pNode, const TRDP_STATISTICS_T *pData, VOS_TIME_NS_T now);
+static void     storeList (NODE_T *pNode, UINT32 dir, const UINT8 *pData, UINT32 dataSize, VOS_TIME_NS_T now);
+static int      compareRows (const void *pA, const void *pB);
+static void     display (void);
+static void     handleKey (int key);
+static void     rawMode (BOOL8 on);
+static void     sigHandler (int sig);
+
+/**********************************************************************************************************************/
+/* Print a sensible usage message */
+void usage (const char *appName)
+{
+    printf("%s: Version %s\t(%s - %s)\n", appName, APP_VERSION, __DATE__, __TIME__);
+    printf("Usage of %s\n", appName);
+    printf("This tool continuously displays the PD traffic of one or more TRDP devices.\n"
+           "Arguments are:\n"
+           "-o own IP address in dotted decimal\n"
+           "-r reply IP address in dotted decimal (default: own IP address)\n"
+           "-t target IP address in dotted decimal (repeat for up to %u devices)\n"
+           "-i refresh interval in s (default 1)\n"
+           "-s sort column: n(ode) d(ir) c(omId) s(ize) r(ate) b(ytes) l(oss) t(imeouts) j(itter) (default r)\n"
+           "-n number of refreshes, 0 = until 'q' or Ctrl-C (default 0)\n"
+           "-b batch mode: no screen control, no keyboard input\n"
+           "-v print version and quit\n"
+           "While running, the sort column keys select the column, pressing a key twice reverses the order.\n",
+           MAX_NODES);
+}
+
+/**********************************************************************************************************************/
+/** callback routine for TRDP logging/error output
+ *
+ *  @param[in]      pRefCon         user supplied context pointer
+ *  @param[in]      category        Log category (Error, Warning, Info etc.)
+ *  @param[in]      pTime           pointer to NULL-terminated string of time stamp
+ *  @param[in]      pFile           pointer to NULL-terminated string of source module
+ *  @param[in]      LineNumber      line
+ *  @param[in]      pMsgStr         pointer to NULL-terminated string
+ *  @retval         none
+ */
+void dbgOut (
+    void        *pRefCon,
+    TRDP_LOG_T  category,
+    const CHAR8 *pTime,
+    const CHAR8 *pFile,
+    UINT16      LineNumber,
+    const CHAR8 *pMsgStr)
+{
+    const char *catStr[] = {"**Error:", "Warning:", "   Info:", "  Debug:", "   User:"};
+    if (category == VOS_LOG_ERROR)
+    {
+        fprintf(stderr, "%s %s %s:%d %s",
+                pTime,
+                catStr[category],
+                pFile,
+                LineNumber,
+                pMsgStr);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Find a monitored device by its address
+ *
+ *  @param[in]      ipAddr          source address of a reply
+ *  @retval         device or NULL
+ */
+static NODE_T *findNode (
+    TRDP_IP_ADDR_T ipAddr)
+{
+    UINT32 i;
+
+    for (i = 0u; i < gNumNodes; i++)
+    {
+        if (gNodes[i].ipAddr == ipAddr)
+        {
+            return &gNodes[i];
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Find or create the row of a publisher or subscription
+ *
+ *  @retval         row or NULL if the table is full
+ */
+static ROW_T *findRow (
+    UINT32          node,
+    UINT32          dir,
+    UINT32          comId,
+    TRDP_IP_ADDR_T  addr)
+{
+    UINT32 i;
+
+    for (i = 0u; i < gNumRows; i++)
+    {
+        if ((gRows[i].node == node) && (gRows[i].dir == dir) &&
+            (gRows[i].comId == comId) && (gRows[i].addr == addr))
+        {
+            return &gRows[i];
+        }
+    }
+    if (gNumRows >= MAX_ROWS)
+    {
+        return NULL;
+    }
+    memset(&gRows[gNumRows], 0, sizeof(ROW_T));
+    gRows[gNumRows].node    = node;
+    gRows[gNumRows].dir     = dir;
+    gRows[gNumRows].comId   = comId;
+    gRows[gNumRows].addr    = addr;
+    return &gRows[gNumRows++];
+}
+
+/**********************************************************************************************************************/
+/** Compute the rates of a row from a new sample
+ */
+static void updateRow (
+    ROW_T           *pRow,
+    UINT32          count,
+    UINT32          missed,
+    TRDP_ERR_T      status,
+    UINT32          size,
+    VOS_TIME_NS_T   now)
+{
+    if (pRow->time != 0)
+    {
+        double  dt      = (double) (now - pRow->time) / 1e9;
+        UINT32  dCount  = count - pRow->count;
+        UINT32  dMissed = missed - pRow->missed;
+        double  rate;
+
+        if ((dt <= 0.0) || (count < pRow->count))
+        {
+            /*  Restarted device or duplicate sample: start over  */
+            pRow->valid = FALSE;
+        }
+        else
+        {
+            rate = (double) dCount / dt;
+            if ((pRow->valid == TRUE) && (pRow->rate > 0.0))
+            {
+                double change = 100.0 * ((rate > pRow->rate) ? rate - pRow->rate : pRow->rate - rate) / pRow->rate;
+                pRow->jitter = (1.0 - JITTER_WEIGHT) * pRow->jitter + JITTER_WEIGHT * change;
+            }
+            pRow->rate  = rate;
+            pRow->bytes = rate * (double) (size + PD_HEADER_SIZE);
+            pRow->loss  = ((dCount + dMissed) == 0u) ? 0.0 : 100.0 * (double) dMissed / (double) (dCount + dMissed);
+            pRow->valid = TRUE;
+        }
+    }
+    if ((status == TRDP_TIMEOUT_ERR) && (pRow->status != TRDP_TIMEOUT_ERR))
+    {
+        pRow->timeouts++;
+    }
+    pRow->count     = count;
+    pRow->missed    = missed;
+    pRow->status    = status;
+    pRow->size      = size;
+    pRow->time      = now;
+}
+
+/**********************************************************************************************************************/
+/** Keep the global statistics of a device (converted to host order)
+ */
+static void storeGlobal (
+    NODE_T                  *pNode,
+    const TRDP_STATISTICS_T *pData,
+    VOS_TIME_NS_T           now)
+{
+    pNode->prev     = pNode->cur;
+    pNode->prevTime = pNode->curTime;
+    pNode->valid    = (pNode->curTime != 0) ? TRUE : FALSE;
+
+    pNode->cur = *pData;
+    pNode->cur.upTime           = vos_ntohl(pData->upTime);
+    pNode->cur.mem.total        = vos_ntohl(pData->mem.total);
+    pNode->cur.mem.free         = vos_ntohl(pData->mem.free);
+    pNode->cur.pd.numSubs       = vos_ntohl(pData->pd.numSubs);
+    pNode->cur.pd.numPub        = vos_ntohl(pData->pd.numPub);
+    pNode->cur.pd.numRcv        = vos_ntohl(pData->pd.numRcv);
+    pNode->cur.pd.numSend       = vos_ntohl(pData->pd.numSend);
+    pNode->cur.pd.numMissed     = vos_ntohl(pData->pd.numMissed);
+    pNode->cur.pd.numTimeout    = vos_ntohl(pData->pd.numTimeout);
+    pNode->cur.pd.numCrcErr     = vos_ntohl(pData->pd.numCrcErr);
+    pNode->cur.pd.numNoSubs     = vos_ntohl(pData->pd.numNoSubs);
+    pNode->cur.hostName[TRDP_MAX_LABEL_LEN - 1] = 0;
+    pNode->curTime  = now;
+    pNode->numAnswers++;
+}
+
+/**********************************************************************************************************************/
+/** Update the rows from a subscription (dir = 0) or publisher (dir = 1) list
+ */
+static void storeList (
+    NODE_T          *pNode,
+    UINT32          dir,
+    const UINT8     *pData,
+    UINT32          dataSize,
+    VOS_TIME_NS_T   now)
+{
+    TRDP_STATISTICS_LIST_T  head;
+    UINT32                  entrySize   = (dir == 0u) ? sizeof(TRDP_SUBS_STATISTICS_T) : sizeof(TRDP_PUB_STATISTICS_T);
+    UINT32                  node        = (UINT32) (pNode - gNodes);
+    UINT32                  i;
+    UINT32                  size;
+
+    if (dataSize < sizeof(head))
+    {
+        return;
+    }
+    memcpy(&head, pData, sizeof(head));
+    head.numTotal   = vos_ntohs(head.numTotal);
+    head.numEntries = vos_ntohs(head.numEntries);
+    if (sizeof(head) + (UINT32) head.numEntries * (entrySize + sizeof(UINT32)) > dataSize)
+    {
+        return;     /*  not a list as expected  */
+    }
+    pNode->listGen[dir]++;
+    pNode->listTotal[dir] = head.numTotal;
+
+    for (i = 0u; i < head.numEntries; i++)
+    {
+        const UINT8 *pEntry = pData + sizeof(head) + i * entrySize;
+        ROW_T       *pRow;
+
+        memcpy(&size, pData + sizeof(head) + head.numEntries * entrySize + i * sizeof(UINT32), sizeof(UINT32));
+        size = vos_ntohl(size);
+        if (dir == 0u)
+        {
+            TRDP_SUBS_STATISTICS_T sub;
+
+            memcpy(&sub, pEntry, sizeof(sub));
+            pRow = findRow(node, dir, vos_ntohl(sub.comId), vos_ntohl(sub.joinedAddr));
+            if (pRow != NULL)
+            {
+                updateRow(pRow, vos_ntohl(sub.numRecv), vos_ntohl(sub.numMissed),
+                          (TRDP_ERR_T) (INT32) vos_ntohl((UINT32) sub.status), size, now);
+            }
+        }
+        else
+        {
+            TRDP_PUB_STATISTICS_T pub;
+
+            memcpy(&pub, pEntry, sizeof(pub));
+            pRow = findRow(node, dir, vos_ntohl(pub.comId), vos_ntohl(pub.destAddr));
+            if (pRow != NULL)
+            {
+                updateRow(pRow, vos_ntohl(pub.numSend), 0u, TRDP_NO_ERR, size, now);
+            }
+        }
+        if (pRow != NULL)
+        {
+            pRow->gen = pNode->listGen[dir];
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** callback routine for receiving the statistics replies
+ *
+ *  @param[in]      pRefCon         user supplied context pointer
+ *  @param[in]      appHandle       session handle
+ *  @param[in]      pMsg            pointer to header/packet infos
+ *  @param[in]      pData           pointer to data block
+ *  @param[in]      dataSize        pointer to data size
+ *  @retval         none
+ */
+void myPDcallBack (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    NODE_T *pNode = findNode(pMsg->srcIpAddr);
+
+    if ((pMsg->resultCode != TRDP_NO_ERR) || (pNode == NULL) || (pData == NULL))
+    {
+        return;
+    }
+
+    switch (pMsg->comId)
+    {
+       case TRDP_GLOBAL_STATISTICS_COMID:
+           if (dataSize >= sizeof(TRDP_STATISTICS_T))
+           {
+               storeGlobal(pNode, (const TRDP_STATISTICS_T *) pData, vos_getTimeNs());
+           }
+           break;
+       case TRDP_SUBS_LIST_COMID:
+           storeList(pNode, 0u, pData, dataSize, vos_getTimeNs());
+           break;
+       case TRDP_PUB_LIST_COMID:
+           storeList(pNode, 1u, pData, dataSize, vos_getTimeNs());
+           break;
+       default:
+           break;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Order of the rows for the selected column
+ */
+static int compareRows (
+    const void  *pA,
+    const void  *pB)
+{
+    const ROW_T *a = (const ROW_T *) pA;
+    const ROW_T *b = (const ROW_T *) pB;
+    double      diff;
+
+    switch (gSort)
+    {
+       case SORT_NODE:     diff = (double) a->node - (double) b->node;          break;
+       case SORT_DIR:      diff = (double) a->dir - (double) b->dir;            break;
+       case SORT_COMID:    diff = (double) a->comId - (double) b->comId;        break;
+       case SORT_SIZE:     diff = (double) a->size - (double) b->size;          break;
+       case SORT_BYTES:    diff = a->bytes - b->bytes;                          break;
+       case SORT_LOSS:     diff = a->loss - b->loss;                            break;
+       case SORT_TIMEOUT:  diff = (double) a->timeouts - (double) b->timeouts;  break;
+       case SORT_JITTER:   diff = a->jitter - b->jitter;                        break;
+       case SORT_RATE:
+       default:            diff = a->rate - b->rate;                            break;
+    }
+    if (diff == 0.0)
+    {
+        /*  Stable order: device, ComId  */
+        diff = (a->node != b->node) ? (double) a->node - (double) b->node : (double) a->comId - (double) b->comId;
+        return (diff < 0.0) ? -1 : (diff > 0.0) ? 1 : 0;
+    }
+    if (gDescending == TRUE)
+    {
+        diff = -diff;
+    }
+    return (diff < 0.0) ? -1 : 1;
+}
+
+/**********************************************************************************************************************/
+/** Print the device summaries and the sorted rows
+ */
+static void display (void)
+{
+    static const char   *cols = "ndcsrbltj";
+    UINT32              i;
+    UINT32              numShown = 0u;
+
+    /*  Drop rows which are no longer in the lists of their device  */
+    for (i = 0u; i < gNumRows; )
+    {
+        if (gRows[i].gen != gNodes[gRows[i].node].listGen[gRows[i].dir])
+        {
+            gRows[i] = gRows[--gNumRows];
+        }
+        else
+        {
+            i++;
+        }
+    }
+    qsort(gRows, gNumRows, sizeof(ROW_T), compareRows);
+
+    if (gBatch == FALSE)
+    {
+        printf("\033[H\033[J");
+    }
+    printf("trdp-top %s - %u device(s), sorted by [%c]%s%s", APP_VERSION, gNumNodes, cols[gSort],
+           (gDescending == TRUE) ? " descending" : " ascending",
+           (gBatch == FALSE) ? ", keys: n d c s r b l t j, q = quit\r\n" : "\n");
+    printf("%-15s %-16s %8s %9s %9s %8s %8s %8s %9s %7s\r\n",
+           "DEVICE", "HOST", "UPTIME", "RX/s", "TX/s", "MISS/s", "TO/s", "CRC/s", "MEMFREE", "REPLIES");
+    for (i = 0u; i < gNumNodes; i++)
+    {
+        NODE_T  *pNode  = &gNodes[i];
+        double  dt      = (pNode->valid == TRUE) ? (double) (pNode->curTime - pNode->prevTime) / 1e9 : 0.0;
+
+        if (pNode->numAnswers == 0u)
+        {
+            printf("%-15s %-16s no reply (%u requests)\r\n", vos_ipDotted(pNode->ipAddr), "-", pNode->numAsked);
+            continue;
+        }
+        if (dt <= 0.0)
+        {
+            dt = 1e99;  /*  no rates yet  */
+        }
+        printf("%-15s %-16.16s %8u %9.1f %9.1f %8.1f %8.1f %8.1f %9u %3u/%-3u\r\n",
+               vos_ipDotted(pNode->ipAddr), pNode->cur.hostName, pNode->cur.upTime,
+               (double) (pNode->cur.pd.numRcv - pNode->prev.pd.numRcv) / dt,
+               (double) (pNode->cur.pd.numSend - pNode->prev.pd.numSend) / dt,
+               (double) (pNode->cur.pd.numMissed - pNode->prev.pd.numMissed) / dt,
+               (double) (pNode->cur.pd.numTimeout - pNode->prev.pd.numTimeout) / dt,
+               (double) (pNode->cur.pd.numCrcErr - pNode->prev.pd.numCrcErr) / dt,
+               pNode->cur.mem.free, pNode->numAnswers % 1000u, pNode->numAsked % 1000u);
+        if ((pNode->listTotal[0] > 0u) || (pNode->listTotal[1] > 0u))
+        {
+            printf("%-15s %u subscriptions, %u publishers\r\n", "", pNode->listTotal[0], pNode->listTotal[1]);
+        }
+    }
+
+    printf("\r\n%-15s %-3s %10s %-15s %6s %9s %11s %7s %5s %7s %s\r\n",
+           "DEVICE", "DIR", "COMID", "ADDRESS", "SIZE", "PKT/s", "BYTE/s", "LOSS%", "TO", "JITTER%", "STATE");
+    for (i = 0u; i < gNumRows; i++)
+    {
+        ROW_T *pRow = &gRows[i];
+
+        printf("%-15s %-3s %10u %-15s %6u ",
+               vos_ipDotted(gNodes[pRow->node].ipAddr), (pRow->dir == 0u) ? "SUB" : "PUB",
+               pRow->comId, vos_ipDotted(pRow->addr), pRow->size);
+        if (pRow->valid == TRUE)
+        {
+            printf("%9.1f %11.0f %7.2f ", pRow->rate, pRow->bytes, pRow->loss);
+        }
+        else
+        {
+            printf("%9s %11s %7s ", "-", "-", "-");
+        }
+        printf("%5u %7.1f %s\r\n", pRow->timeouts, pRow->jitter,
+               (pRow->status == TRDP_TIMEOUT_ERR) ? "TIMEOUT" : (pRow->status == TRDP_NO_ERR) ? "ok" : "error");
+        numShown++;
+    }
+    if (numShown == 0u)
+    {
+        printf("(waiting for replies)\r\n");
+    }
+    fflush(stdout);
+}
+
+/**********************************************************************************************************************/
+/** Select the sort column, reverse the order if it is already selected
+ */
+static void handleKey (
+    int key)
+{
+    static const char   *cols = "ndcsrbltj";
+    const char          *pCol;
+
+    if ((key == 'q') || (key == 'Q'))
+    {
+        gKeepOnRunning = FALSE;
+        return;
+    }
+    pCol = (key != 0) ? strchr(cols, key) : NULL;
+    if (pCol != NULL)
+    {
+        SORT_T sort = (SORT_T) (pCol - cols);
+
+        gDescending = (sort == gSort) ? !gDescending : TRUE;
+        gSort       = sort;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Switch the terminal to single key input and back
+ */
+static void rawMode (
+    BOOL8 on)
+{
+#if defined (POSIX)
+    if ((on == TRUE) && (gRawMode == FALSE) && isatty(STDIN_FILENO))
+    {
+        struct termios raw;
+
+        if (tcgetattr(STDIN_FILENO, &gOldTerm) == 0)
+        {
+            raw = gOldTerm;
+            raw.c_lflag &= ~(ICANON | ECHO);
+            raw.c_cc[VMIN]  = 0;
+            raw.c_cc[VTIME] = 0;
+            gRawMode = (tcsetattr(STDIN_FILENO, TCSANOW, &raw) == 0) ? TRUE : FALSE;
+        }
+    }
+    else if ((on == FALSE) && (gRawMode == TRUE))
+    {
+        (void) tcsetattr(STDIN_FILENO, TCSANOW, &gOldTerm);
+        gRawMode = FALSE;
+    }
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Leave the main loop on Ctrl-C
+ */
+static void sigHandler (
+    int sig)
+{
+    (void) sig;
+    gKeepOnRunning = FALSE;
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char * *argv)
+{
+    TRDP_APP_SESSION_T      appHandle;  /*    Our identifier to the library instance    */
+    TRDP_SUB_T              subHandle[3];
+    const UINT32            statsComId[3] = {TRDP_GLOBAL_STATISTICS_COMID,
+                                             TRDP_SUBS_LIST_COMID,
+                                             TRDP_PUB_LIST_COMID};
+    TRDP_PD_CONFIG_T        pdConfiguration = {myPDcallBack, NULL, {0, 0, 0},
+                                               (TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB), REPLY_TIMEOUT,
+                                               TRDP_TO_KEEP_LAST_VALUE, 0};
+    TRDP_PROCESS_CONFIG_T   processConfig   = {"trdp-top", "", 0, 0, TRDP_OPTION_BLOCK};
+    unsigned int            ip[4];
+    UINT32                  replyIP     = 0u;
+    UINT32                  ownIP       = 0u;
+    UINT32                  interval    = 1u;
+    UINT32                  numRefresh  = 0u;
+    UINT32                  refreshes   = 0u;
+    VOS_TIME_NS_T           nextPull;
+    UINT32                  i, k;
+    int                     ch;
+
+    if (argc <= 1)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    while ((ch = getopt(argc, argv, "o:r:t:i:s:n:bh?v")) != -1)
+    {
+        switch (ch)
+        {
+           case 'o':
+           case 'r':
+           case 't':
+           {    /*  read ip    */
+               UINT32 addr;
+
+               if (sscanf(optarg, "%u.%u.%u.%u",
+                          &ip[3], &ip[2], &ip[1], &ip[0]) < 4)
+               {
+                   usage(argv[0]);
+                   exit(1);
+               }
+               addr = (ip[3] << 24) | (ip[2] << 16) | (ip[1] << 8) | ip[0];
+               if (ch == 'o')
+               {
+                   ownIP = addr;
+               }
+               else if (ch == 'r')
+               {
+                   replyIP = addr;
+               }
+               else if (gNumNodes < MAX_NODES)
+               {
+                   gNodes[gNumNodes++].ipAddr = addr;
+               }
+               break;
+           }
+           case 'i':
+               interval = (UINT32) strtoul(optarg, NULL, 10);
+               interval = (interval == 0u) ? 1u : interval;
+               break;
+           case 's':
+               handleKey(optarg[0]);
+               gDescending = TRUE;
+               break;
+           case 'n':
+               numRefresh = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           case 'b':
+               gBatch = TRUE;
+               break;
+           case 'v':    /*  version */
+               printf("%s: Version %s\t(%s - %s)\n",
+                      argv[0], APP_VERSION, __DATE__, __TIME__);
+               exit(0);
+               break;
+           case 'h':
+           case '?':
+           default:
+               usage(argv[0]);
+               return 1;
+        }
+    }
+
+    if (gNumNodes == 0u)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+    if (replyIP == 0u)
+    {
+        replyIP = ownIP;
+    }
+
+    if (tlc_init(dbgOut, NULL, NULL) != TRDP_NO_ERR)
+    {
+        printf("Initialization error\n");
+        return 1;
+    }
+
+    if (tlc_openSession(&appHandle,
+                        ownIP,
+                        0,                          /* use default IP addresses */
+                        NULL,                       /* no Marshalling    */
+                        &pdConfiguration, NULL,     /* system defaults for PD and MD    */
+                        &processConfig) != TRDP_NO_ERR)
+    {
+        printf("Initialization error\n");
+        return 1;
+    }
+
+    /*    Subscribe to the replies of all devices    */
+    for (k = 0u; k < 3u; k++)
+    {
+        if (tlp_subscribe(appHandle, &subHandle[k], NULL, myPDcallBack, statsComId[k], 0u, 0u,
+                          VOS_INADDR_ANY, VOS_INADDR_ANY, replyIP, TRDP_FLAGS_DEFAULT,
+                          REPLY_TIMEOUT, TRDP_TO_KEEP_LAST_VALUE) != TRDP_NO_ERR)
+        {
+            printf("prep pd receive error\n");
+            tlc_terminate();
+            return 1;
+        }
+    }
+
+    (void) signal(SIGINT, sigHandler);
+    if (gBatch == FALSE)
+    {
+        rawMode(TRUE);
+    }
+
+    nextPull = vos_getTimeNs();
+
+    /*
+        Enter the main processing loop.
+     */
+    while (gKeepOnRunning)
+    {
+        TRDP_FDS_T      rfds;
+        INT32           noOfDesc = 0;
+        TRDP_TIME_T     tv;
+        TRDP_TIME_T     max_tv;
+        VOS_TIME_NS_T   now     = vos_getTimeNs();
+        BOOL8           pulled  = FALSE;
+        int             rv;
+
+        if (now >= nextPull)
+        {
+            if (refreshes > 0u)
+            {
+                display();
+                if ((numRefresh != 0u) && (refreshes >= numRefresh))
+                {
+                    break;
+                }
+            }
+            /*    Pull the statistics of all devices, the replies are shown with the next refresh    */
+            for (i = 0u; i < gNumNodes; i++)
+            {
+                for (k = 0u; k < 3u; k++)
+                {
+                    (void) tlp_request(appHandle, subHandle[k], TRDP_STATISTICS_PULL_COMID, 0u, 0u, 0u,
+                                       gNodes[i].ipAddr, 0u, TRDP_FLAGS_NONE, NULL, NULL, 0u,
+                                       statsComId[k], replyIP);
+                    /*  Send each request before queueing the next one, they share the sequence counter  */
+                    (void) tlc_process(appHandle, NULL, NULL);
+                }
+                gNodes[i].numAsked++;
+            }
+            refreshes++;
+            nextPull += (VOS_TIME_NS_T) interval * 1000000000;
+            now     = vos_getTimeNs();
+            pulled  = TRUE;
+        }
+
+        FD_ZERO(&rfds);
+        tlc_getInterval(appHandle, &tv, &rfds, &noOfDesc);
+
+        /*  Send the requests right away, wake up for the next pull at the latest  */
+        max_tv.tv_sec   = (pulled == TRUE) ? 0 : (long) ((nextPull - now) / 1000000000);
+        max_tv.tv_usec  = (pulled == TRUE) ? 0 : (long) (((nextPull - now) % 1000000000) / 1000);
+        if (vos_cmpTime(&tv, &max_tv) > 0)
+        {
+            tv = max_tv;
+        }
+#if defined (POSIX)
+        if (gRawMode == TRUE)
+        {
+            FD_SET(STDIN_FILENO, &rfds);
+        }
+#endif
+
+        rv = vos_select(noOfDesc + 1, &rfds, NULL, NULL, &tv);
+
+#if defined (POSIX)
+        if ((gRawMode == TRUE) && (rv > 0) && FD_ISSET(STDIN_FILENO, &rfds))
+        {
+            char key;
+
+            if (read(STDIN_FILENO, &key, 1) == 1)
+            {
+                handleKey(key);
+                display();
+            }
+            FD_CLR(STDIN_FILENO, &rfds);
+            rv--;
+        }
+#endif
+        (void) tlc_process(appHandle, &rfds, &rv);
+    }   /*    Bottom of while-loop    */
+
+    rawMode(FALSE);
+
+    /*
+     *    We always clean up behind us!
+     */
+    for (k = 0u; k < 3u; k++)
+    {
+        (void) tlp_unsubscribe(appHandle, subHandle[k]);
+    }
+    tlc_terminate();
+
+    return 0;
+}
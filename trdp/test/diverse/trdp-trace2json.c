@@ -0,0 +1,228 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp-trace2json.c
+ *
+ * @brief           Converter for TRDP event trace dumps
+ *
+ * @details         Reads a dump written by tlc_dumpTrace() / tlc_requestTraceDump() and writes it as
+ *                  Chrome trace event JSON, which can be loaded into chrome://tracing or ui.perfetto.dev.
+ *                  tlc_process() passes become slices, all other events instants on a PD, MD and socket track.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright Bombardier Transportation Inc. or its subsidiaries and others, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "trdp_types.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define APP_VERSION         "1.0"
+
+/* Tracks (thread ids) of the timeline */
+#define TRACK_PROCESS       1
+#define TRACK_PD            2
+#define TRACK_MD            3
+#define TRACK_SOCKET        4
+
+/***********************************************************************************************************************
+ * Prototypes
+ */
+void    usage (const char *appName);
+void    printTrack (FILE *out, int tid, const char *pName);
+void    printIp (char *pBuf, UINT32 ip);
+void    printRecord (FILE *out, const TRDP_TRACE_REC_T *pRec, INT64 start);
+
+/**********************************************************************************************************************/
+/** Print a sensible usage message
+ *
+ *  @param[in]      appName         program name
+ */
+void usage (const char *appName)
+{
+    printf("Usage of %s\n", appName);
+    printf("Convert a TRDP event trace dump to Chrome trace / Perfetto JSON.\n"
+           "Arguments are:\n"
+           "<dump file> [<json file>]   (default output: stdout)\n"
+           "Version %s\n", APP_VERSION);
+}
+
+/**********************************************************************************************************************/
+/** Name a track of the timeline
+ *
+ *  @param[in]      out             output file
+ *  @param[in]      tid             track
+ *  @param[in]      pName           name to display
+ */
+void printTrack (FILE *out, int tid, const char *pName)
+{
+    fprintf(out, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}},\n",
+            tid, pName);
+}
+
+/**********************************************************************************************************************/
+/** Dotted notation of an IP address
+ *
+ *  @param[out]     pBuf            buffer of at least 16 characters
+ *  @param[in]      ip              IP address (host order)
+ */
+void printIp (char *pBuf, UINT32 ip)
+{
+    sprintf(pBuf, "%u.%u.%u.%u", (ip >> 24) & 0xFFu, (ip >> 16) & 0xFFu, (ip >> 8) & 0xFFu, ip & 0xFFu);
+}
+
+/**********************************************************************************************************************/
+/** Write one record as trace event
+ *
+ *  @param[in]      out             output file
+ *  @param[in]      pRec            trace record
+ *  @param[in]      start           time stamp of the first record in ns
+ */
+void printRecord (FILE *out, const TRDP_TRACE_REC_T *pRec, INT64 start)
+{
+    double  ts = (double) (pRec->time - start) / 1000.0;
+    char    ip[16];
+
+    switch (pRec->event)
+    {
+       case TRDP_TRACE_PROCESS_ENTER:
+           fprintf(out, "{\"name\":\"tlc_process\",\"ph\":\"B\",\"ts\":%.3f,\"pid\":1,\"tid\":%d}",
+                   ts, TRACK_PROCESS);
+           break;
+       case TRDP_TRACE_PROCESS_EXIT:
+           fprintf(out, "{\"name\":\"tlc_process\",\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":%d,"
+                   "\"args\":{\"result\":%d}}",
+                   ts, TRACK_PROCESS, (int) pRec->arg);
+           break;
+       case TRDP_TRACE_PD_RX:
+       case TRDP_TRACE_PD_TX:
+       case TRDP_TRACE_PD_TIMEOUT:
+           printIp(ip, pRec->arg);
+           fprintf(out, "{\"name\":\"%s %u\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%d,"
+                   "\"args\":{\"comId\":%u,\"seqCnt\":%u,\"%s\":\"%s\"}}",
+                   (pRec->event == TRDP_TRACE_PD_RX) ? "PD rx" :
+                   (pRec->event == TRDP_TRACE_PD_TX) ? "PD tx" : "PD timeout",
+                   pRec->comId, ts, TRACK_PD, pRec->comId, pRec->seqCnt,
+                   (pRec->event == TRDP_TRACE_PD_TX) ? "dest" : "src", ip);
+           break;
+       case TRDP_TRACE_MD_RX:
+       case TRDP_TRACE_MD_TX:
+       case TRDP_TRACE_MD_STATE:
+           fprintf(out, "{\"name\":\"%s %u\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%d,"
+                   "\"args\":{\"comId\":%u,\"seqCnt\":%u,\"%s\":%u}}",
+                   (pRec->event == TRDP_TRACE_MD_RX) ? "MD rx" :
+                   (pRec->event == TRDP_TRACE_MD_TX) ? "MD tx" : "MD state",
+                   pRec->comId, ts, TRACK_MD, pRec->comId, pRec->seqCnt,
+                   (pRec->event == TRDP_TRACE_MD_RX) ? "msgType" : "state", pRec->arg);
+           break;
+       case TRDP_TRACE_SOCK_OPEN:
+       case TRDP_TRACE_SOCK_CLOSE:
+           fprintf(out, "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%d,"
+                   "\"args\":{\"index\":%u,\"socket\":%u}}",
+                   (pRec->event == TRDP_TRACE_SOCK_OPEN) ? "socket open" : "socket close",
+                   ts, TRACK_SOCKET, pRec->seqCnt, pRec->arg);
+           break;
+       default:
+           fprintf(out, "{\"name\":\"event %u\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":1,\"tid\":%d}",
+                   (unsigned int) pRec->event, ts, TRACK_PROCESS);
+           break;
+    }
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char *argv[])
+{
+    TRDP_TRACE_HEADER_T header;
+    TRDP_TRACE_REC_T    rec;
+    INT64               start   = 0;
+    UINT32              i;
+    FILE                *in;
+    FILE                *out    = stdout;
+    char                ip[16];
+
+    if (argc < 2)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    in = fopen(argv[1], "rb");
+    if (in == NULL)
+    {
+        fprintf(stderr, "Cannot open %s\n", argv[1]);
+        return 1;
+    }
+    if ((fread(&header, sizeof(header), 1u, in) != 1u) ||
+        (memcmp(header.magic, TRDP_TRACE_MAGIC, sizeof(TRDP_TRACE_MAGIC)) != 0) ||
+        (header.version != TRDP_TRACE_VERSION) ||
+        (header.recSize != sizeof(TRDP_TRACE_REC_T)))
+    {
+        fprintf(stderr, "%s is no trace dump of this version / byte order\n", argv[1]);
+        fclose(in);
+        return 1;
+    }
+    if (argc > 2)
+    {
+        out = fopen(argv[2], "w");
+        if (out == NULL)
+        {
+            fprintf(stderr, "Cannot open %s\n", argv[2]);
+            fclose(in);
+            return 1;
+        }
+    }
+
+    printIp(ip, header.ownIpAddr);
+    fprintf(out, "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"lost\":%u},\"traceEvents\":[\n", header.numLost);
+    fprintf(out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"TRDP %s\"}},\n", ip);
+    printTrack(out, TRACK_PROCESS, "tlc_process");
+    printTrack(out, TRACK_PD, "PD");
+    printTrack(out, TRACK_MD, "MD");
+    printTrack(out, TRACK_SOCKET, "Sockets");
+
+    for (i = 0u; i < header.noOfRecs; i++)
+    {
+        if (fread(&rec, sizeof(rec), 1u, in) != 1u)
+        {
+            fprintf(stderr, "Dump truncated after %u of %u records\n", i, header.noOfRecs);
+            break;
+        }
+        if (i == 0u)
+        {
+            start = rec.time;
+        }
+        printRecord(out, &rec, start);
+        fprintf(out, (i + 1u < header.noOfRecs) ? ",\n" : "\n");
+    }
+    /* Empty or truncated dump: the last line written ends with a ',' */
+    fprintf(out, "%s]}\n", ((i < header.noOfRecs) || (header.noOfRecs == 0u)) ? "{}" : "");
+
+    fclose(in);
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+    return 0;
+}
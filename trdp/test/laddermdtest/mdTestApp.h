@@ -176,6 +176,20 @@ extern "C" {
 
 #define TLC_PROCESS_CYCLE_TIME		10000			/* default MD tlc_process cycle time for tlm_delListener wait */
 
+/* Real-time settings of the MD worker thread (MDReceiveManager, runs tlc_process) */
+#ifndef MD_APP_COM_CPU_MASK
+#define MD_APP_COM_CPU_MASK			0				/* CPUs to pin the MD worker thread to, 0: no pinning */
+#endif
+#ifndef MD_APP_COM_PRIORITY
+#define MD_APP_COM_PRIORITY			0				/* SCHED_FIFO priority of the MD worker thread, 0: default policy */
+#endif
+#ifndef MD_APP_COM_PREFAULT_STACK
+#define MD_APP_COM_PREFAULT_STACK		0				/* Stack bytes to prefault in the MD worker thread */
+#endif
+#ifndef MD_APP_LOCK_MEMORY
+#define MD_APP_LOCK_MEMORY			0				/* 1: lock all pages into RAM (mlockall) */
+#endif
+
 #define REPLIERS_UNKNOWN				0				/* Repliiers unknown kind */
 
 /***********************************************************************************************************************
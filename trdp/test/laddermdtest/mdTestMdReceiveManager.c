@@ -16,6 +16,7 @@
  *
  * $Id:$
  *
+ *      BL 2026-10-17: MDReceiveManager applies the real-time attributes MD_APP_COM_* (CPU, SCHED_FIFO, stack)
  *      BL 2017-05-22: Ticket #122: Addendum for 64Bit compatibility (VOS_TIME_T -> VOS_TIMEVAL_T)
  *
  */
@@ -146,6 +147,33 @@ void dbgOut (
 VOS_THREAD_FUNC_T MDReceiveManager(MD_RECEIVE_MANAGER_THREAD_PARAMETER *pMdReceiveManagerThreadParameter)
 {
 	int err = 0;
+	VOS_THREAD_ATTR_T mdThreadAttr;
+
+	/* Isolate the MD worker thread from the application load */
+	memset(&mdThreadAttr, 0, sizeof(mdThreadAttr));
+	mdThreadAttr.cpuMask = MD_APP_COM_CPU_MASK;
+	if (MD_APP_COM_PRIORITY != 0)
+	{
+		mdThreadAttr.policy = VOS_THREAD_POLICY_FIFO;
+		mdThreadAttr.priority = MD_APP_COM_PRIORITY;
+	}
+	mdThreadAttr.prefaultStack = MD_APP_COM_PREFAULT_STACK;
+	if ((mdThreadAttr.cpuMask != 0)
+		|| (mdThreadAttr.policy != VOS_THREAD_POLICY_OTHER)
+		|| (mdThreadAttr.prefaultStack != 0))
+	{
+		if (vos_threadSetAttr(&mdThreadAttr) != VOS_NO_ERR)
+		{
+			printf("MDReceiveManager: real-time attributes not applied\n");
+		}
+	}
+	if (MD_APP_LOCK_MEMORY != 0)
+	{
+		if (vos_memLockAll() != VOS_NO_ERR)
+		{
+			printf("MDReceiveManager: memory could not be locked\n");
+		}
+	}
 
 	/* TRDP Initialize */
 	err = trdp_initialize();
@@ -18,6 +18,26 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: test30: pull request repeated until the list is received
+ *      BL 2026-10-17: test34, test35: publisher phases, re-alignment on a new epoch, phase 0 with traffic shaping
+ *      BL 2026-10-17: test20: publishers explicitly phased at 0, unphased ones start one interval after publishing
+ *      BL 2026-10-17: test33: configuration reloads while another thread puts and gets marshalled telegrams
+ *      BL 2026-10-17: test17, test21: second batch against queued publishers, batch above the bit rate limit
+ *      BL 2026-10-17: test32: configuration image detects an edited XML file of same size and modification time
+ *      BL 2026-10-17: test31: statistics history, opening, sample writing and continuing an existing ring
+ *      BL 2026-10-17: test30: list statistics published on request only, pulled on the non-standard ComIds
+ *      BL 2026-10-17: test29: sequence counter check (in order, gap, late, duplicate, wrap, reset), table driven
+ *      BL 2026-10-17: test28: metrics endpoint, response in slices to a slow client, no SIGPIPE on reset
+ *      BL 2026-10-17: test27: trace dump from a signal handler (tlc_dumpTraceFd)
+ *      BL 2026-10-17: test25, test26: callback accounting per element, only with TRDP_OPTION_CALLBACK_STATS
+ *      BL 2026-10-17: test24: stage timing of tlc_process(), pass and callback overruns
+ *      BL 2026-10-17: test23: incrementally maintained statistics counters against a recount
+ *      BL 2026-10-17: test22: latency histograms and percentiles
+ *      BL 2026-10-17: test21: publish rejected by the PD bit rate limit, notifications deferred by the MD rate limit
+ *      BL 2026-10-17: test20: send order by QoS, send budget defers to the next window
+ *      BL 2026-10-17: test19: traffic shaping slot spreading, PREPARE_OPT for sessions with options
+ *      BL 2026-10-17: test18: configuration hot reload (tau_cfg_session)
+ *      BL 2026-10-17: test17: batch publish & subscribe, processing loop runs on threadRun (start-up race)
  *      BL 2018-03-06: Ticket #101 Optional callback function on PD send
  */
 
@@ -31,12 +51,23 @@
 
 #if defined (POSIX)
 #include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/select.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
 #elif (defined (WIN32) || defined (WIN64))
 #include "getopt.h"
 #endif
 
 #include "trdp_if_light.h"
+#include "trdp_utils.h"
+#include "tau_cfg_session.h"
+#include "tau_marshall.h"
+#include "vos_shared_mem.h"
 #include "vos_sock.h"
 #include "vos_utils.h"
 
@@ -65,6 +96,8 @@ typedef struct
 
 TRDP_THREAD_SESSION_T   gSession1 = {NULL, 0x0A000264u, 0, 0};
 TRDP_THREAD_SESSION_T   gSession2 = {NULL, 0x0A000265u, 0, 0};
+TRDP_OPTION_T           gOption = TRDP_OPTION_NONE;     /* options of the sessions opened by the next PREPARE */
+INT32                   gLoopMinWait = 5000;            /* min. select timeout of the processing loop in us  */
 
 /* Data buffers to play with (Content is borrowed from Douglas Adams, "The Hitchhiker's Guide to the Galaxy") */
 static uint8_t          dataBuffer1[64 * 1024] =
@@ -262,6 +295,13 @@ static uint8_t          dataBuffer3[64] =
         }                                                                       \
     }
 
+/**********************************************************************************************************************/
+/*  Macro to initialize the library and open two sessions with options                                                */
+/**********************************************************************************************************************/
+#define PREPARE_OPT(a, b, opt)                                                  \
+    gOption = (opt);                                                            \
+    PREPARE(a, b)
+
 /**********************************************************************************************************************/
 /*  Macro to initialize the library and open one session                                                              */
 /**********************************************************************************************************************/
@@ -388,14 +428,17 @@ static void trdp_loop (void *pArg)
     /*
         Enter the main processing loop.
      */
-    while (pSession->threadId)
+    while (pSession->threadRun)
     {
         TRDP_FDS_T  rfds;
         INT32       noDesc;
         INT32       rv;
         TRDP_TIME_T tv;
         TRDP_TIME_T max_tv  = {0u, 20000};
-        TRDP_TIME_T min_tv  = {0u, 5000};
+        TRDP_TIME_T min_tv;
+
+        min_tv.tv_sec   = 0;
+        min_tv.tv_usec  = gLoopMinWait;
 
         /*
          Prepare the file descriptor set for the select call.
@@ -482,8 +525,11 @@ static TRDP_APP_SESSION_T test_init (
     TRDP_THREAD_SESSION_T   *pSession,
     const char              *name)
 {
-    TRDP_ERR_T err = TRDP_NO_ERR;
-    pSession->appHandle = NULL;
+    TRDP_ERR_T              err = TRDP_NO_ERR;
+    TRDP_PROCESS_CONFIG_T   processConfig = {"test", "", 0u, 0u, TRDP_OPTION_NONE};
+
+    pSession->appHandle     = NULL;
+    processConfig.options   = gOption;
 
     if (dbgout != NULL)
     {
@@ -492,12 +538,15 @@ static TRDP_APP_SESSION_T test_init (
     }
     if (err == TRDP_NO_ERR)                 /* We ignore double init here */
     {
-        tlc_openSession(&pSession->appHandle, pSession->ifaceIP, 0u, NULL, NULL, NULL, NULL);
+        tlc_openSession(&pSession->appHandle, pSession->ifaceIP, 0u, NULL, NULL, NULL,
+                        (gOption != TRDP_OPTION_NONE) ? &processConfig : NULL);
         /* On error the handle will be NULL... */
     }
 
     if (err == TRDP_NO_ERR)
     {
+        /* threadId is set only after the thread started, the loop must not depend on it */
+        pSession->threadRun = 1;
         (void) vos_threadCreate(&pSession->threadId, name, VOS_THREAD_POLICY_OTHER, 0u, 0u, 0u,
                                 trdp_loop, pSession);
     }
@@ -526,6 +575,8 @@ static void test_deinit (
         vos_threadTerminate(pSession2->threadId);
         vos_threadDelay(100000);
     }
+    gOption = TRDP_OPTION_NONE;
+    gLoopMinWait = 5000;
     tlc_terminate();
 }
 
@@ -2079,7 +2130,2575 @@ static int test16 ()
 }
 
 
+/**********************************************************************************************************************/
+/** test17 Batch publish and subscribe
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test17 ()
+{
+    PREPARE("Batch publish & subscribe", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+#define TEST17_NO_OF_TELEGRAMS  100u
+#define TEST17_COMID            17000u
+#define TEST17_INTERVAL         100000u
+#define TEST17_TIMEOUT          (TEST17_INTERVAL * 3)
+#define TEST17_DATA             "Hello Batch!"
+#define TEST17_DATA_LEN         16u
+
+        TRDP_PUB_DESC_T pubDesc[TEST17_NO_OF_TELEGRAMS + 1u];
+        TRDP_SUB_DESC_T subDesc[TEST17_NO_OF_TELEGRAMS];
+        TRDP_PUB_T      pubHandle[TEST17_NO_OF_TELEGRAMS + 1u];
+        TRDP_SUB_T      subHandle[TEST17_NO_OF_TELEGRAMS];
+        unsigned int    i, received = 0u;
+
+        memset(pubDesc, 0, sizeof(pubDesc));
+        memset(subDesc, 0, sizeof(subDesc));
+
+        for (i = 0; i < TEST17_NO_OF_TELEGRAMS; i++)
+        {
+            pubDesc[i].comId        = TEST17_COMID + i;
+            pubDesc[i].destIpAddr   = gSession2.ifaceIP;
+            pubDesc[i].interval     = TEST17_INTERVAL;
+            pubDesc[i].pktFlags     = TRDP_FLAGS_DEFAULT;
+            pubDesc[i].pData        = (const UINT8 *) TEST17_DATA;
+            pubDesc[i].dataSize     = TEST17_DATA_LEN;
+
+            subDesc[i].comId        = TEST17_COMID + i;
+            subDesc[i].srcIpAddr1   = gSession1.ifaceIP;
+            subDesc[i].pktFlags     = TRDP_FLAGS_NONE;
+            subDesc[i].timeout      = TEST17_TIMEOUT;
+            subDesc[i].toBehavior   = TRDP_TO_DEFAULT;
+        }
+
+        /*  The last entry duplicates the first one: it must fail without stopping the batch  */
+        pubDesc[TEST17_NO_OF_TELEGRAMS] = pubDesc[0];
+
+        err = tlp_publishBatch(gSession1.appHandle, TEST17_NO_OF_TELEGRAMS + 1u, pubDesc, pubHandle);
+        if (err != TRDP_NOPUB_ERR)
+        {
+            FAILED("tlp_publishBatch did not report the duplicate");
+        }
+        if (pubHandle[TEST17_NO_OF_TELEGRAMS] != NULL)
+        {
+            FAILED("tlp_publishBatch returned a handle for the duplicate");
+        }
+
+        err = tlp_subscribeBatch(gSession2.appHandle, TEST17_NO_OF_TELEGRAMS, subDesc, subHandle);
+        IF_ERROR("tlp_subscribeBatch");
+
+        for (i = 0; i < TEST17_NO_OF_TELEGRAMS; i++)
+        {
+            if ((pubHandle[i] == NULL) || (subHandle[i] == NULL))
+            {
+                FAILED("Batch handle missing");
+            }
+        }
+
+        fprintf(gFp, "\nInitialized %u publishers & subscribers!\n", i);
+
+        /*    Wait for the first cycles    */
+        vos_threadDelay(TEST17_INTERVAL * 3);
+
+        for (i = 0; i < TEST17_NO_OF_TELEGRAMS; i++)
+        {
+            char            data2[1432u];
+            UINT32          dataSize2 = sizeof(data2);
+            TRDP_PD_INFO_T  pdInfo;
+
+            err = tlp_get(gSession2.appHandle, subHandle[i], &pdInfo, (UINT8 *) data2, &dataSize2);
+            if ((err == TRDP_NO_ERR) && (pdInfo.comId == TEST17_COMID + i) && (memcmp(data2, TEST17_DATA, 12u) == 0))
+            {
+                received++;
+            }
+        }
+
+        fprintf(gFp, "%u of %u telegrams received\n", received, TEST17_NO_OF_TELEGRAMS);
+        if (received != TEST17_NO_OF_TELEGRAMS)
+        {
+            FAILED("Not all batch telegrams received");
+        }
+
+        /*  A second batch: a queued publisher and a duplicate inside the batch are found in its comId index,
+            the same comId to another destination is a new publisher (pull only, not sent)  */
+        pubDesc[0]              = pubDesc[1];
+        pubDesc[1].destIpAddr   = gSession2.ifaceIP + 1u;
+        pubDesc[1].interval     = 0u;
+        pubDesc[2]              = pubDesc[1];
+
+        err = tlp_publishBatch(gSession1.appHandle, 3u, pubDesc, pubHandle);
+        if (err != TRDP_NOPUB_ERR)
+        {
+            FAILED("Second tlp_publishBatch did not report the duplicates");
+        }
+        if ((pubHandle[0] != NULL) || (pubHandle[1] == NULL) || (pubHandle[2] != NULL))
+        {
+            FAILED("Second tlp_publishBatch: wrong handles");
+        }
+        err = tlp_unpublish(gSession1.appHandle, pubHandle[1]);
+        IF_ERROR("tlp_unpublish");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+
+
+/**********************************************************************************************************************/
+/** Write the configuration of test18: telegrams published on the first interface and subscribed on the second one
+ *
+ *  @param[in]      pFileName       file to write
+ *  @param[in]      pTlg            telegrams: comId, cycle in us, 0-terminated
+ *  @param[in]      marshall        TRUE: telegrams marshalled
+ *
+ *  @retval         0        no error
+ *  @retval         1        file not writable
+ */
+static int test18_writeConfig (
+    const char      *pFileName,
+    const UINT32    *pTlg,
+    BOOL8           marshall)
+{
+    FILE            *fp;
+    char            ip1[16], ip2[16];
+    unsigned int    i, k;
+
+    vos_strncpy(ip1, vos_ipDotted(gSession1.ifaceIP), sizeof(ip1) - 1u);
+    vos_strncpy(ip2, vos_ipDotted(gSession2.ifaceIP), sizeof(ip2) - 1u);
+
+    fp = fopen(pFileName, "w");
+    if (fp == NULL)
+    {
+        return 1;
+    }
+    fprintf(fp, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<device host-name=\"test18\" type=\"dummy\">\n");
+    fprintf(fp, "<device-configuration memory-size=\"0\"/>\n<bus-interface-list>\n");
+    for (k = 0u; k < 2u; k++)
+    {
+        fprintf(fp, "<bus-interface network-id=\"%u\" name=\"if%u\">\n", k + 1u, k + 1u);
+        fprintf(fp, "<trdp-process blocking=\"no\" cycle-time=\"10000\"/>\n");
+        fprintf(fp, "<pd-com-parameter port=\"17224\" qos=\"5\" ttl=\"64\" timeout-value=\"1000000\"/>\n");
+        for (i = 0u; pTlg[i] != 0u; i += 2u)
+        {
+            fprintf(fp, "<telegram com-id=\"%u\" data-set-id=\"1001\" com-parameter-id=\"1\" type=\"%s\">\n",
+                    pTlg[i], (k == 0u) ? "source" : "sink");
+            fprintf(fp, "<pd-parameter cycle=\"%u\" timeout=\"300000\" validity-behavior=\"keep\"%s/>\n",
+                    pTlg[i + 1u], (marshall == TRUE) ? " marshall=\"on\"" : "");
+            if (k == 0u)
+            {
+                fprintf(fp, "<destination id=\"1\" uri=\"%s\"/>\n", ip2);
+            }
+            else
+            {
+                fprintf(fp, "<source id=\"1\" uri1=\"%s\"/>\n", ip1);
+            }
+            fprintf(fp, "</telegram>\n");
+        }
+        fprintf(fp, "</bus-interface>\n");
+    }
+    fprintf(fp, "</bus-interface-list>\n<com-parameter-list>\n<com-parameter id=\"1\" qos=\"5\" ttl=\"64\"/>\n"
+            "</com-parameter-list>\n<data-set-list>\n<data-set name=\"ds1001\" id=\"1001\">\n"
+            "<element name=\"text\" type=\"CHAR8\" array-size=\"16\"/>\n</data-set>\n</data-set-list>\n</device>\n");
+    fclose(fp);
+    return 0;
+}
+
+/**********************************************************************************************************************/
+/** Send and get the telegrams of test18
+ *
+ *  @param[in]      cfgSession      configured telegrams
+ *  @param[in]      comId           first comId
+ *  @param[in]      num             number of comIds
+ *  @param[out]     pSeqCnt         received sequence counters, 0xFFFFFFFF if nothing received
+ */
+static void test18_exchange (
+    TAU_CFG_SESSION_T   cfgSession,
+    UINT32              comId,
+    UINT32              num,
+    UINT32              *pSeqCnt)
+{
+    UINT32 i, cycle;
+
+    for (cycle = 0u; cycle < 5u; cycle++)
+    {
+        for (i = 0u; i < num; i++)
+        {
+            TRDP_PUB_T pubHandle = tau_getCfgPubHandle(cfgSession, gSession1.appHandle, comId + i,
+                                                       gSession2.ifaceIP);
+            if (pubHandle != NULL)
+            {
+                (void) tlp_put(gSession1.appHandle, pubHandle, (const UINT8 *) "Hello Reload!", 16u);
+            }
+        }
+        vos_threadDelay(50000u);
+    }
+    for (i = 0u; i < num; i++)
+    {
+        char            data[64u];
+        UINT32          dataSize    = sizeof(data);
+        TRDP_PD_INFO_T  pdInfo;
+        TRDP_SUB_T      subHandle   = tau_getCfgSubHandle(cfgSession, gSession2.appHandle, comId + i, 0u);
+
+        pSeqCnt[i] = 0xFFFFFFFFu;
+        if ((subHandle != NULL) &&
+            (tlp_get(gSession2.appHandle, subHandle, &pdInfo, (UINT8 *) data, &dataSize) == TRDP_NO_ERR) &&
+            (memcmp(data, "Hello Reload!", 13u) == 0))
+        {
+            pSeqCnt[i] = pdInfo.seqCount;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** test18 Configuration hot reload
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test18 ()
+{
+    PREPARE("Configuration hot reload", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+#define TEST18_COMID        18001u
+#define TEST18_FILE_A       "test18_a.xml"
+#define TEST18_FILE_B       "test18_b.xml"
+
+        /*  B: 18001 unchanged, 18002 other cycle, 18003 removed, 18004 added  */
+        const UINT32        tlgA[]  = {18001u, 50000u, 18002u, 50000u, 18003u, 50000u, 0u};
+        const UINT32        tlgB[]  = {18001u, 50000u, 18002u, 100000u, 18004u, 50000u, 0u};
+        TRDP_APP_SESSION_T  appHandle[2];
+        TAU_CFG_SESSION_T   cfgSession  = NULL;
+        TRDP_XML_CONFIG_T   config;
+        TAU_CFG_DIFF_T      diff;
+        TRDP_PUB_T          pubHandle;
+        TRDP_SUB_T          subHandle;
+        UINT32              seqA[4], seqB[4];
+
+        if ((test18_writeConfig(TEST18_FILE_A, tlgA, FALSE) != 0) || (test18_writeConfig(TEST18_FILE_B, tlgB, FALSE) != 0))
+        {
+            FAILED("Configuration not writable");
+        }
+        err = tau_loadConfig(TEST18_FILE_A, NULL, &config);
+        IF_ERROR("tau_loadConfig");
+
+        appHandle[0]    = gSession1.appHandle;
+        appHandle[1]    = gSession2.appHandle;
+        err = tau_openCfgSession(&cfgSession, &config, 2u, appHandle, NULL, NULL, NULL, TRUE);
+        IF_ERROR("tau_openCfgSession");
+
+        test18_exchange(cfgSession, TEST18_COMID, 3u, seqA);
+        fprintf(gFp, "A: received seqCnt %u %u %u\n", seqA[0], seqA[1], seqA[2]);
+        if ((seqA[0] == 0xFFFFFFFFu) || (seqA[1] == 0xFFFFFFFFu) || (seqA[2] == 0xFFFFFFFFu))
+        {
+            tau_closeCfgSession(cfgSession);
+            FAILED("Configured telegrams not received");
+        }
+
+        pubHandle = tau_getCfgPubHandle(cfgSession, gSession1.appHandle, TEST18_COMID, gSession2.ifaceIP);
+        subHandle = tau_getCfgSubHandle(cfgSession, gSession2.appHandle, TEST18_COMID, gSession1.ifaceIP);
+
+        err = tau_reloadConfig(cfgSession, TEST18_FILE_B, NULL, &diff);
+        fprintf(gFp, "Reload: publishers +%u -%u ~%u =%u, subscribers +%u -%u ~%u =%u\n",
+                diff.pub.added, diff.pub.removed, diff.pub.modified, diff.pub.kept,
+                diff.sub.added, diff.sub.removed, diff.sub.modified, diff.sub.kept);
+        if ((err != TRDP_NO_ERR) ||
+            (diff.pub.added != 1u) || (diff.pub.removed != 1u) || (diff.pub.modified != 1u) || (diff.pub.kept != 1u) ||
+            (diff.sub.added != 1u) || (diff.sub.removed != 1u) || (diff.sub.modified != 0u) || (diff.sub.kept != 2u))
+        {
+            tau_closeCfgSession(cfgSession);
+            FAILED("Wrong difference applied");
+        }
+        if ((pubHandle != tau_getCfgPubHandle(cfgSession, gSession1.appHandle, TEST18_COMID, gSession2.ifaceIP)) ||
+            (subHandle != tau_getCfgSubHandle(cfgSession, gSession2.appHandle, TEST18_COMID, gSession1.ifaceIP)) ||
+            (tau_getCfgSubHandle(cfgSession, gSession2.appHandle, TEST18_COMID + 2u, 0u) != NULL))
+        {
+            tau_closeCfgSession(cfgSession);
+            FAILED("Handles not kept or not removed");
+        }
+
+        /*  The unchanged publisher keeps counting, the re-created one starts again  */
+        test18_exchange(cfgSession, TEST18_COMID, 4u, seqB);
+        fprintf(gFp, "B: received seqCnt %u %u %d %u\n", seqB[0], seqB[1], (int) seqB[2], seqB[3]);
+        if ((seqB[0] == 0xFFFFFFFFu) || (seqB[0] <= seqA[0]) || (seqB[1] == 0xFFFFFFFFu) || (seqB[1] >= seqA[1]) ||
+            (seqB[3] == 0xFFFFFFFFu))
+        {
+            tau_closeCfgSession(cfgSession);
+            FAILED("Reloaded telegrams not received");
+        }
+
+        tau_closeCfgSession(cfgSession);
+        (void) remove(TEST18_FILE_A);
+        (void) remove(TEST18_FILE_B);
+        err = TRDP_NO_ERR;
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** Traffic shaping: publishers of different intervals are spread over the slots of the hyperperiod
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test19 ()
+{
+    PREPARE_OPT("Traffic shaping", "test", TRDP_OPTION_TRAFFIC_SHAPING); /* allocates appHandle1, appHandle2,
+                                                                             failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+#define TEST19_COMID            19000u
+#define TEST19_NO_PER_INTERVAL  10u
+#define TEST19_DATA             "Hello Shaping!"
+#define TEST19_DATA_LEN         16u
+
+        /*  10 publishers each at 10ms, 20ms and 40ms: 17.5 telegrams per 1ms slot on average, 30 unshaped  */
+        const UINT32                interval[]  = {10000u, 20000u, 40000u};
+        TRDP_PUB_T                  pubHandle[3u][TEST19_NO_PER_INTERVAL];
+        TRDP_SHAPING_STATISTICS_T   shaping[2u];
+        UINT16                      numIf;
+        UINT32                      grossSize = 0u;
+        unsigned int                i, j;
+
+        memset(pubHandle, 0, sizeof(pubHandle));
+
+        for (i = 0u; i < 3u; i++)
+        {
+            for (j = 0u; j < TEST19_NO_PER_INTERVAL; j++)
+            {
+                err = tlp_publish(gSession1.appHandle, &pubHandle[i][j], NULL, NULL,
+                                  TEST19_COMID + i * TEST19_NO_PER_INTERVAL + j, 0u, 0u,
+                                  0u, gSession2.ifaceIP, interval[i], 0u, TRDP_FLAGS_NONE, NULL,
+                                  (const UINT8 *) TEST19_DATA, TEST19_DATA_LEN);
+                IF_ERROR("tlp_publish");
+
+                if (grossSize == 0u)
+                {
+                    /*  The burst of a single publisher is its size on the wire  */
+                    numIf   = 2u;
+                    err     = tlc_getShapingStatistics(gSession1.appHandle, &numIf, shaping);
+                    IF_ERROR("tlc_getShapingStatistics");
+                    if (numIf != 1u)
+                    {
+                        FAILED("No traffic shaping table");
+                    }
+                    grossSize = shaping[0].maxBurst;
+                }
+            }
+        }
+
+        numIf   = 2u;
+        err     = tlc_getShapingStatistics(gSession1.appHandle, &numIf, shaping);
+        IF_ERROR("tlc_getShapingStatistics");
+        fprintf(gFp, "%u publishers, %u slots of %u us, worst case burst %u bytes (one telegram %u bytes)\n",
+                shaping[0].numPub, shaping[0].noOfSlots, shaping[0].slotTime, shaping[0].maxBurst, grossSize);
+
+        if ((numIf != 1u) || (shaping[0].ifAddr != gSession1.ifaceIP) || (shaping[0].numPub != 30u))
+        {
+            FAILED("Wrong traffic shaping table");
+        }
+        if ((shaping[0].slotTime != 1000u) || (shaping[0].noOfSlots != 40u))
+        {
+            FAILED("Wrong hyperperiod");
+        }
+        /*  Evenly spread: at most two telegrams per slot instead of 30  */
+        if ((grossSize == 0u) || (shaping[0].maxBurst > 2u * grossSize))
+        {
+            FAILED("Publishers not spread over the slots");
+        }
+
+        /*  Removing the 40ms publishers halves the hyperperiod, unpublish succeeds in any case  */
+        for (j = 0u; j < TEST19_NO_PER_INTERVAL; j++)
+        {
+            err = tlp_unpublish(gSession1.appHandle, pubHandle[2u][j]);
+            IF_ERROR("tlp_unpublish");
+            pubHandle[2u][j] = NULL;
+        }
+
+        numIf   = 2u;
+        err     = tlc_getShapingStatistics(gSession1.appHandle, &numIf, shaping);
+        IF_ERROR("tlc_getShapingStatistics");
+        if ((shaping[0].numPub != 20u) || (shaping[0].noOfSlots != 20u) ||
+            (shaping[0].maxBurst > 2u * grossSize))
+        {
+            FAILED("Wrong traffic shaping table after unpublish");
+        }
+
+        for (i = 0u; i < 2u; i++)
+        {
+            for (j = 0u; j < TEST19_NO_PER_INTERVAL; j++)
+            {
+                err = tlp_unpublish(gSession1.appHandle, pubHandle[i][j]);
+                IF_ERROR("tlp_unpublish");
+            }
+        }
+
+        numIf   = 2u;
+        err     = tlc_getShapingStatistics(gSession1.appHandle, &numIf, shaping);
+        IF_ERROR("tlc_getShapingStatistics");
+        if (numIf != 0u)
+        {
+            FAILED("Traffic shaping table not released");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** Pre-send callback of test20: record comId and send time
+ */
+#define TEST20_MAX_RECORDS  64
+
+static volatile int     gTest20Count = 0;
+static UINT32           gTest20ComId[TEST20_MAX_RECORDS];
+static VOS_TIME_NS_T    gTest20Time[TEST20_MAX_RECORDS];
+
+static void test20SendCallBack (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    int idx = gTest20Count;
+
+    if (idx < TEST20_MAX_RECORDS)
+    {
+        gTest20ComId[idx]   = pMsg->comId;
+        gTest20Time[idx]    = vos_getTimeNs();
+        gTest20Count        = idx + 1;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Send order by QoS class and send budget
+ *
+ *  Three publishers with the same interval and phase are due in the same pass. They must be sent highest QoS first.
+ *  With a budget of one packet per window, the two below minQos go out in the following windows, one per window.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test20 ()
+{
+    PREPARE("Send order by QoS, send budget", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+#define TEST20_COMID        20000u
+#define TEST20_INTERVAL     100000u
+#define TEST20_WINDOW       20000u
+#define TEST20_DATA         "Hello QoS!"
+#define TEST20_DATA_LEN     16u
+
+        /*  published in this order, expected to be sent in reverse QoS order: 20002, 20003, 20001  */
+        const UINT8         qos[3]  = {2u, 7u, 5u};
+        const UINT32        order[3] = {TEST20_COMID + 2u, TEST20_COMID + 3u, TEST20_COMID + 1u};
+        TRDP_PUB_T          pubHandle[3];
+        TRDP_SEND_PARAM_T   sendParam;
+        VOS_TIME_NS_T       gap;
+        int                 i, first;
+
+        for (i = 0; i < 3; i++)
+        {
+            memset(&sendParam, 0, sizeof(sendParam));
+            sendParam.qos       = qos[i];
+            sendParam.ttl       = 64u;
+            sendParam.phased    = TRUE;             /* same phase: due in the same pass */
+            err = tlp_publish(gSession1.appHandle, &pubHandle[i], NULL, test20SendCallBack,
+                              TEST20_COMID + 1u + (UINT32) i, 0u, 0u, 0u, gSession2.ifaceIP, TEST20_INTERVAL, 0u,
+                              TRDP_FLAGS_CALLBACK, &sendParam, (const UINT8 *) TEST20_DATA, TEST20_DATA_LEN);
+            IF_ERROR("tlp_publish");
+        }
+
+        /*  No budget: each cycle is one pass, highest QoS first  */
+        vos_threadDelay(TEST20_INTERVAL * 2u + TEST20_INTERVAL / 2u);
+        if (gTest20Count < 6)
+        {
+            FAILED("Too few telegrams sent");
+        }
+        for (i = 0; i < 6; i++)
+        {
+            if (gTest20ComId[i] != order[i % 3])
+            {
+                fprintf(gFp, "send %d: comId %u, expected %u\n", i, gTest20ComId[i], order[i % 3]);
+                FAILED("Wrong send order");
+            }
+        }
+
+        /*  One packet per window, QoS 6 and higher never deferred  */
+        err = tlc_setSendBudget(gSession1.appHandle, 1u, TEST20_WINDOW, 6u);
+        IF_ERROR("tlc_setSendBudget");
+        vos_threadDelay(TEST20_INTERVAL);
+        gTest20Count = TEST20_MAX_RECORDS;          /* stop recording */
+        vos_threadDelay(TEST20_WINDOW);
+        gTest20Count = 0;
+        vos_threadDelay(TEST20_INTERVAL * 2u);
+
+        /*  Find the start of a complete cycle  */
+        for (first = 0; (first < gTest20Count - 2) && (gTest20ComId[first] != order[0]); first++)
+        {
+            ;
+        }
+        if (first >= gTest20Count - 2)
+        {
+            FAILED("No complete cycle with budget recorded");
+        }
+        for (i = 0; i < 3; i++)
+        {
+            if (gTest20ComId[first + i] != order[i])
+            {
+                fprintf(gFp, "budget send %d: comId %u, expected %u\n", i, gTest20ComId[first + i], order[i]);
+                FAILED("Wrong send order with budget");
+            }
+        }
+        for (i = 1; i < 3; i++)
+        {
+            gap = gTest20Time[first + i] - gTest20Time[first + i - 1];
+            fprintf(gFp, "comId %u sent %lld us after comId %u\n", gTest20ComId[first + i],
+                    (long long) (gap / 1000), gTest20ComId[first + i - 1]);
+            /*  deferred to the next window, not later  */
+            if ((gap < (VOS_TIME_NS_T) TEST20_WINDOW * 1000 / 2) ||
+                (gap > (VOS_TIME_NS_T) TEST20_WINDOW * 1000 * 3 / 2))
+            {
+                FAILED("Deferred telegram not sent in the next window");
+            }
+        }
+
+        err = tlc_setSendBudget(gSession1.appHandle, 0u, TEST20_WINDOW, 6u);
+        IF_ERROR("tlc_setSendBudget");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** Listener callback of test21: record the receive time of the notifications
+ */
+#define TEST21_MAX_RECORDS  16
+
+static volatile int     gTest21Count = 0;
+static VOS_TIME_NS_T    gTest21Time[TEST21_MAX_RECORDS];
+
+static void test21CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    int idx = gTest21Count;
+
+    if ((pMsg->msgType == TRDP_MSG_MN) && (idx < TEST21_MAX_RECORDS))
+    {
+        gTest21Time[idx]    = vos_getTimeNs();
+        gTest21Count        = idx + 1;
+    }
+}
+
+/**********************************************************************************************************************/
+/** PD bit rate limit and MD rate limit
+ *
+ *  With a limit of two and a half publishers the third publish is rejected and the committed rate stays at two,
+ *  after an unpublish it is admitted again.
+ *  Notifications sent in one go leave one per token bucket refill when the MD rate is limited.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test21 ()
+{
+    PREPARE("PD bit rate limit, MD rate limit", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
 
+    {
+#define TEST21_COMID        21000u
+#define TEST21_INTERVAL     10000u
+#define TEST21_DATA_LEN     100u
+        /*  (PD header + data + UDP/IP/Ethernet overhead) * 8 bit per interval   */
+#define TEST21_PD_RATE      ((40u + TEST21_DATA_LEN + 66u) * 8u * (1000000u / TEST21_INTERVAL))
+#define TEST21_MD_COMID     21100u
+#define TEST21_MD_DATA_LEN  84u
+        /*  MD header + data = 200 bytes per notification, 100ms each at 2000 bytes/s   */
+#define TEST21_MD_SIZE      (116u + TEST21_MD_DATA_LEN)
+#define TEST21_MD_RATE      2000u
+#define TEST21_MD_COUNT     4
+
+        TRDP_PUB_T  pubHandle[3];
+        TRDP_LIS_T  listenHandle;
+        UINT8       data[TEST21_DATA_LEN];
+        UINT32      bitRate;
+        INT64       spread, expected;
+        int         i;
+
+        memset(data, 0x55, sizeof(data));
+
+        err = tlc_setBandwidthLimit(gSession1.appHandle, TEST21_PD_RATE * 5u / 2u, TRUE);
+        IF_ERROR("tlc_setBandwidthLimit");
+
+        for (i = 0; i < 2; i++)
+        {
+            err = tlp_publish(gSession1.appHandle, &pubHandle[i], NULL, NULL, TEST21_COMID + (UINT32) i, 0u, 0u,
+                              0u, gSession2.ifaceIP, TEST21_INTERVAL, 0u, TRDP_FLAGS_NONE, NULL,
+                              data, TEST21_DATA_LEN);
+            IF_ERROR("tlp_publish");
+        }
+        err = tlc_getCommittedBitRate(gSession1.appHandle, 0u, &bitRate);
+        IF_ERROR("tlc_getCommittedBitRate");
+        fprintf(gFp, "committed %u bit/s, expected %u\n", bitRate, 2u * TEST21_PD_RATE);
+        if (bitRate != 2u * TEST21_PD_RATE)
+        {
+            FAILED("Wrong committed bit rate");
+        }
+
+        /*  The third one exceeds the limit  */
+        err = tlp_publish(gSession1.appHandle, &pubHandle[2], NULL, NULL, TEST21_COMID + 2u, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST21_INTERVAL, 0u, TRDP_FLAGS_NONE, NULL,
+                          data, TEST21_DATA_LEN);
+        if (err != TRDP_QUEUE_FULL_ERR)
+        {
+            FAILED("Publisher above the bit rate limit not rejected");
+        }
+        err = tlc_getCommittedBitRate(gSession1.appHandle, gSession1.ifaceIP, &bitRate);
+        IF_ERROR("tlc_getCommittedBitRate");
+        if (bitRate != 2u * TEST21_PD_RATE)
+        {
+            FAILED("Rejected publisher accounted");
+        }
+
+        /*  Room for it after an unpublish  */
+        err = tlp_unpublish(gSession1.appHandle, pubHandle[0]);
+        IF_ERROR("tlp_unpublish");
+        err = tlp_publish(gSession1.appHandle, &pubHandle[2], NULL, NULL, TEST21_COMID + 2u, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST21_INTERVAL, 0u, TRDP_FLAGS_NONE, NULL,
+                          data, TEST21_DATA_LEN);
+        IF_ERROR("tlp_publish after unpublish");
+
+        err = tlp_unpublish(gSession1.appHandle, pubHandle[1]);
+        IF_ERROR("tlp_unpublish");
+        err = tlp_unpublish(gSession1.appHandle, pubHandle[2]);
+        IF_ERROR("tlp_unpublish");
+        err = tlc_getCommittedBitRate(gSession1.appHandle, 0u, &bitRate);
+        IF_ERROR("tlc_getCommittedBitRate");
+        if (bitRate != 0u)
+        {
+            FAILED("Committed bit rate not released");
+        }
+
+        /*  The same in one batch: the rates of the batch publishers are accumulated for the admission  */
+        {
+            TRDP_PUB_DESC_T pubDesc[3];
+
+            memset(pubDesc, 0, sizeof(pubDesc));
+            for (i = 0; i < 3; i++)
+            {
+                pubDesc[i].comId        = TEST21_COMID + (UINT32) i;
+                pubDesc[i].destIpAddr   = gSession2.ifaceIP;
+                pubDesc[i].interval     = TEST21_INTERVAL;
+                pubDesc[i].pktFlags     = TRDP_FLAGS_NONE;
+                pubDesc[i].pData        = data;
+                pubDesc[i].dataSize     = TEST21_DATA_LEN;
+            }
+            err = tlp_publishBatch(gSession1.appHandle, 3u, pubDesc, pubHandle);
+            if ((err != TRDP_QUEUE_FULL_ERR) || (pubHandle[0] == NULL) || (pubHandle[1] == NULL) ||
+                (pubHandle[2] != NULL))
+            {
+                FAILED("Batch publisher above the bit rate limit not rejected");
+            }
+            err = tlc_getCommittedBitRate(gSession1.appHandle, 0u, &bitRate);
+            IF_ERROR("tlc_getCommittedBitRate");
+            if (bitRate != 2u * TEST21_PD_RATE)
+            {
+                FAILED("Wrong committed bit rate after the batch");
+            }
+            for (i = 0; i < 2; i++)
+            {
+                err = tlp_unpublish(gSession1.appHandle, pubHandle[i]);
+                IF_ERROR("tlp_unpublish");
+            }
+        }
+
+        /*  MD: a burst of notifications is spread by the token bucket  */
+        err = tlm_addListener(gSession2.appHandle, &listenHandle, NULL, test21CBFunction, TRUE,
+                              TEST21_MD_COMID, 0u, 0u, 0u, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK,
+                              NULL, NULL);
+        IF_ERROR("tlm_addListener");
+
+        err = tlc_setMdRateLimit(gSession1.appHandle, TEST21_MD_RATE, TEST21_MD_SIZE);
+        IF_ERROR("tlc_setMdRateLimit");
+
+        for (i = 0; i < TEST21_MD_COUNT; i++)
+        {
+            err = tlm_notify(gSession1.appHandle, NULL, NULL, TEST21_MD_COMID, 0u, 0u, 0u,
+                             gSession2.ifaceIP, TRDP_FLAGS_NONE, NULL, data, TEST21_MD_DATA_LEN, NULL, NULL);
+            IF_ERROR("tlm_notify");
+        }
+
+        vos_threadDelay(1000000u);
+        if (gTest21Count != TEST21_MD_COUNT)
+        {
+            fprintf(gFp, "%d of %d notifications received\n", gTest21Count, TEST21_MD_COUNT);
+            FAILED("Deferred notifications lost");
+        }
+        spread      = gTest21Time[TEST21_MD_COUNT - 1] - gTest21Time[0];
+        expected    = (INT64) (TEST21_MD_COUNT - 1) * TEST21_MD_SIZE * 1000000000 / TEST21_MD_RATE;
+        fprintf(gFp, "notifications spread over %lld ms, expected %lld ms\n",
+                (long long) (spread / 1000000), (long long) (expected / 1000000));
+        if ((spread < expected * 3 / 4) || (spread > expected * 3 / 2))
+        {
+            FAILED("Notifications not spread by the MD rate limit");
+        }
+
+        err = tlc_setMdRateLimit(gSession1.appHandle, 0u, 0u);
+        IF_ERROR("tlc_setMdRateLimit");
+        err = tlm_delListener(gSession2.appHandle, listenHandle);
+        IF_ERROR("tlm_delListener");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** Callbacks of test22: the pre-send callback takes at least TEST22_CB_TIME
+ */
+#define TEST22_CB_TIME  1000000
+
+static void test22SendCallBack (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    VOS_TIME_NS_T start = vos_getTimeNs();
+
+    while (vos_getTimeNs() - start < TEST22_CB_TIME)
+    {
+        ;
+    }
+}
+
+static void test22RcvCallBack (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+}
+
+/**********************************************************************************************************************/
+/** Find the latency entry of a comId
+ */
+static const TRDP_LATENCY_STATISTICS_T *test22Find (
+    const TRDP_LATENCY_STATISTICS_T *pStats,
+    UINT16                          num,
+    UINT32                          comId,
+    BOOL8                           publisher)
+{
+    UINT16 i;
+
+    for (i = 0u; i < num; i++)
+    {
+        if ((pStats[i].comId == comId) && (pStats[i].publisher == publisher))
+        {
+            return &pStats[i];
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Latency histograms and percentiles
+ *
+ *  The percentiles of a histogram filled by hand are checked against the bucket limits. The pre-send callback of a
+ *  publisher busy-waits, its callback histogram must not report less; the subscription records its
+ *  receive latencies. Reading with reset clears the histograms.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test22 ()
+{
+    PREPARE_OPT("Latency histograms", "test", TRDP_OPTION_LATENCY_STATS); /* allocates appHandle1, appHandle2,
+                                                                             failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+#define TEST22_COMID        22000u
+#define TEST22_INTERVAL     10000u
+#define TEST22_DATA         "Hello Latency!"
+#define TEST22_DATA_LEN     16u
+#define TEST22_MAX_STATS    8u
+
+        TRDP_PUB_T                      pubHandle;
+        TRDP_SUB_T                      subHandle;
+        TRDP_LAT_HIST_T                 hist;
+        TRDP_LATENCY_STATISTICS_T       stats[TEST22_MAX_STATS];
+        const TRDP_LATENCY_STATISTICS_T *pEntry;
+        UINT16                          num;
+        UINT32                          p50, p99;
+
+        /*  90 samples of 1000ns (bucket 35, 896...1023ns), 10 of 1ms (bucket 75, up to 1048575ns)  */
+        memset(&hist, 0, sizeof(hist));
+        hist.count      = 100u;
+        hist.min        = 1000u;
+        hist.max        = 1000000u;
+        hist.bucket[35] = 90u;
+        hist.bucket[75] = 10u;
+        if ((tlc_getLatencyPercentile(&hist, 500u) != 1023u) ||
+            (tlc_getLatencyPercentile(&hist, 900u) != 1023u) ||
+            (tlc_getLatencyPercentile(&hist, 910u) != 1000000u) ||      /* bucket limit capped by max */
+            (tlc_getLatencyPercentile(&hist, 1000u) != 1000000u))
+        {
+            FAILED("Wrong percentile of a known histogram");
+        }
+        hist.count = 0u;
+        if (tlc_getLatencyPercentile(&hist, 500u) != 0u)
+        {
+            FAILED("Percentile of an empty histogram");
+        }
+
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, test22RcvCallBack, TEST22_COMID, 0u, 0u,
+                            0u, 0u, 0u, TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB, TEST22_INTERVAL * 10u,
+                            TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, test22SendCallBack, TEST22_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST22_INTERVAL, 0u, TRDP_FLAGS_CALLBACK, NULL,
+                          (const UINT8 *) TEST22_DATA, TEST22_DATA_LEN);
+        IF_ERROR("tlp_publish");
+
+        vos_threadDelay(TEST22_INTERVAL * 50u);
+
+        num = TEST22_MAX_STATS;
+        err = tlc_getLatencyStatistics(gSession1.appHandle, &num, stats, TRUE);
+        IF_ERROR("tlc_getLatencyStatistics");
+        pEntry = test22Find(stats, num, TEST22_COMID, TRUE);
+        if (pEntry == NULL)
+        {
+            FAILED("No latency entry of the publisher");
+        }
+        p50 = tlc_getLatencyPercentile(&pEntry->callback, 500u);
+        p99 = tlc_getLatencyPercentile(&pEntry->callback, 990u);
+        fprintf(gFp, "pre-send callback: %u samples, min %u ns, p50 %u ns, p99 %u ns, max %u ns\n",
+                pEntry->callback.count, pEntry->callback.min, p50, p99, pEntry->callback.max);
+        if ((pEntry->callback.count < 25u) || (pEntry->stack.count == 0u))
+        {
+            FAILED("Too few publisher latencies recorded");
+        }
+        if ((pEntry->callback.min < TEST22_CB_TIME) || (p50 < pEntry->callback.min) || (p99 < p50) ||
+            (p99 > pEntry->callback.max) ||
+            (pEntry->callback.sum < (UINT64) pEntry->callback.count * TEST22_CB_TIME))
+        {
+            FAILED("Callback latencies below the callback time or percentiles out of order");
+        }
+
+        num = TEST22_MAX_STATS;
+        err = tlc_getLatencyStatistics(gSession2.appHandle, &num, stats, FALSE);
+        IF_ERROR("tlc_getLatencyStatistics");
+        pEntry = test22Find(stats, num, TEST22_COMID, FALSE);
+        if ((pEntry == NULL) || (pEntry->stack.count < 25u))
+        {
+            FAILED("Too few subscription latencies recorded");
+        }
+        p50 = tlc_getLatencyPercentile(&pEntry->stack, 500u);
+        fprintf(gFp, "receive: %u samples, min %u ns, p50 %u ns, max %u ns\n",
+                pEntry->stack.count, pEntry->stack.min, p50, pEntry->stack.max);
+        if ((p50 < pEntry->stack.min) || (p50 > pEntry->stack.max))
+        {
+            FAILED("Receive percentile out of range");
+        }
+
+        /*  The publisher histograms were reset by the first read  */
+        num = TEST22_MAX_STATS;
+        err = tlc_getLatencyStatistics(gSession1.appHandle, &num, stats, FALSE);
+        IF_ERROR("tlc_getLatencyStatistics");
+        pEntry = test22Find(stats, num, TEST22_COMID, TRUE);
+        if ((pEntry == NULL) || (pEntry->callback.count > 3u))
+        {
+            FAILED("Publisher histograms not reset on read");
+        }
+
+        err = tlp_unpublish(gSession1.appHandle, pubHandle);
+        IF_ERROR("tlp_unpublish");
+        err = tlp_unsubscribe(gSession2.appHandle, subHandle);
+        IF_ERROR("tlp_unsubscribe");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** Compare the session counters with a recount from the publisher, subscription and join lists
+ *
+ *  @param[in]      appHandle       session
+ *  @param[in]      pWhen           step of the test for the output
+ *
+ *  @retval         0        counters match
+ *  @retval         1        mismatch or error
+ */
+#define TEST23_MAX_ENTRIES  64u
+
+static int test23Recount (
+    TRDP_APP_SESSION_T  appHandle,
+    const char          *pWhen)
+{
+    TRDP_STATISTICS_T       stats;
+    TRDP_PUB_STATISTICS_T   pubStats[TEST23_MAX_ENTRIES];
+    TRDP_SUBS_STATISTICS_T  subsStats[TEST23_MAX_ENTRIES];
+    UINT32                  joined[TEST23_MAX_ENTRIES];
+    UINT16                  numPub  = TEST23_MAX_ENTRIES;
+    UINT16                  numSubs = TEST23_MAX_ENTRIES;
+    UINT16                  numJoin = TEST23_MAX_ENTRIES;
+    UINT32                  numGroups = 0u;
+    UINT16                  i, j;
+
+    if ((tlc_getStatistics(appHandle, &stats) != TRDP_NO_ERR) ||
+        (tlc_getPubStatistics(appHandle, &numPub, pubStats) != TRDP_NO_ERR) ||
+        (tlc_getSubsStatistics(appHandle, &numSubs, subsStats) != TRDP_NO_ERR) ||
+        (tlc_getJoinStatistics(appHandle, &numJoin, joined) != TRDP_NO_ERR))
+    {
+        fprintf(gFp, "%s: statistics not read\n", pWhen);
+        return 1;
+    }
+
+    /*  Distinct multicast groups of the subscriptions (one receive socket per session here)  */
+    for (i = 0u; i < numJoin; i++)
+    {
+        for (j = 0u; (j < i) && (joined[j] != joined[i]); j++)
+        {
+            ;
+        }
+        if ((joined[i] != 0u) && (j == i))
+        {
+            numGroups++;
+        }
+    }
+
+    fprintf(gFp, "%s: numPub %u/%u, numSubs %u/%u, numJoin %u/%u (counter/recount)\n", pWhen,
+            stats.pd.numPub, numPub, stats.pd.numSubs, numSubs, stats.numJoin, numGroups);
+    return ((stats.pd.numPub != numPub) || (stats.pd.numSubs != numSubs) || (stats.numJoin != numGroups)) ? 1 : 0;
+}
+
+/**********************************************************************************************************************/
+/** Incrementally maintained statistics counters
+ *
+ *  numPub, numSubs and numJoin are compared with a full recount after publishing, subscribing to unicast and
+ *  multicast, removing some of them and after tlc_resetStatistics(), which keeps these counters.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test23 ()
+{
+    PREPARE("Statistics counters", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+#define TEST23_COMID        23000u
+#define TEST23_INTERVAL     100000u
+#define TEST23_NO_PUB       5u
+#define TEST23_NO_SUB       4u
+#define TEST23_DATA         "Hello Counters!"
+#define TEST23_DATA_LEN     16u
+
+        /*  unicast, two subscriptions to one group, another group  */
+        const TRDP_IP_ADDR_T    subDest[TEST23_NO_SUB] = {0u, gDestMC, gDestMC, gDestMC + 1u};
+        TRDP_PUB_T              pubHandle[TEST23_NO_PUB];
+        TRDP_SUB_T              subHandle[TEST23_NO_SUB];
+        TRDP_STATISTICS_T       stats;
+        unsigned int            i;
+
+        for (i = 0u; i < TEST23_NO_PUB; i++)
+        {
+            /*  the last one is PULL only  */
+            err = tlp_publish(gSession1.appHandle, &pubHandle[i], NULL, NULL, TEST23_COMID + i, 0u, 0u,
+                              0u, gSession2.ifaceIP, (i == TEST23_NO_PUB - 1u) ? 0u : TEST23_INTERVAL, 0u,
+                              TRDP_FLAGS_NONE, NULL, (const UINT8 *) TEST23_DATA, TEST23_DATA_LEN);
+            IF_ERROR("tlp_publish");
+        }
+        for (i = 0u; i < TEST23_NO_SUB; i++)
+        {
+            err = tlp_subscribe(gSession2.appHandle, &subHandle[i], NULL, NULL, TEST23_COMID + i, 0u, 0u,
+                                0u, 0u, subDest[i], TRDP_FLAGS_NONE, TEST23_INTERVAL * 3u, TRDP_TO_DEFAULT);
+            IF_ERROR("tlp_subscribe");
+        }
+        vos_threadDelay(TEST23_INTERVAL * 2u);
+
+        if ((test23Recount(gSession1.appHandle, "published") != 0) ||
+            (test23Recount(gSession2.appHandle, "subscribed") != 0))
+        {
+            FAILED("Counters differ from the recount");
+        }
+
+        /*  Remove some: a cyclic and the PULL publisher, one of the two subscriptions to gDestMC and the last group  */
+        err = tlp_unpublish(gSession1.appHandle, pubHandle[0]);
+        IF_ERROR("tlp_unpublish");
+        err = tlp_unpublish(gSession1.appHandle, pubHandle[TEST23_NO_PUB - 1u]);
+        IF_ERROR("tlp_unpublish");
+        err = tlp_unsubscribe(gSession2.appHandle, subHandle[1]);
+        IF_ERROR("tlp_unsubscribe");
+        err = tlp_unsubscribe(gSession2.appHandle, subHandle[3]);
+        IF_ERROR("tlp_unsubscribe");
+
+        if ((test23Recount(gSession1.appHandle, "unpublished") != 0) ||
+            (test23Recount(gSession2.appHandle, "unsubscribed") != 0))
+        {
+            FAILED("Counters differ from the recount after removal");
+        }
+
+        /*  A reset clears the traffic counters, but keeps the numbers of publishers, subscriptions and joins  */
+        err = tlc_resetStatistics(gSession2.appHandle);
+        IF_ERROR("tlc_resetStatistics");
+        err = tlc_getStatistics(gSession2.appHandle, &stats);
+        IF_ERROR("tlc_getStatistics");
+        if (stats.pd.numRcv > 2u)
+        {
+            FAILED("Receive counter not reset");
+        }
+        if (test23Recount(gSession2.appHandle, "reset") != 0)
+        {
+            FAILED("Counters differ from the recount after reset");
+        }
+
+        for (i = 1u; i < TEST23_NO_PUB - 1u; i++)
+        {
+            err = tlp_unpublish(gSession1.appHandle, pubHandle[i]);
+            IF_ERROR("tlp_unpublish");
+        }
+        err = tlp_unsubscribe(gSession2.appHandle, subHandle[0]);
+        IF_ERROR("tlp_unsubscribe");
+        err = tlp_unsubscribe(gSession2.appHandle, subHandle[2]);
+        IF_ERROR("tlp_unsubscribe");
+
+        if ((test23Recount(gSession1.appHandle, "all unpublished") != 0) ||
+            (test23Recount(gSession2.appHandle, "all unsubscribed") != 0))
+        {
+            FAILED("Counters differ from the recount at the end");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** Stage timing of tlc_process() and overrun detection
+ *
+ *  The pre-send callback of test22 busy-waits 1ms, above the pass and the callback budget of 500us. Every pass
+ *  sending the telegram must be counted as overrun, blamed on the PD send stage, and the callback must be
+ *  reported with its ComId.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test24 ()
+{
+    PREPARE("Stage timing, overruns", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+#define TEST24_COMID        24000u
+#define TEST24_INTERVAL     50000u
+#define TEST24_BUDGET       500u
+#define TEST24_CYCLES       10u
+#define TEST24_DATA         "Hello Timing!"
+#define TEST24_DATA_LEN     16u
+
+        TRDP_PUB_T                  pubHandle;
+        TRDP_PROCESS_STATISTICS_T   procStats;
+        UINT32                      i, numStaged = 0u;
+
+        err = tlc_setProcessTiming(gSession1.appHandle, TRUE, TEST24_BUDGET, TEST24_BUDGET);
+        IF_ERROR("tlc_setProcessTiming");
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, test22SendCallBack, TEST24_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST24_INTERVAL, 0u, TRDP_FLAGS_CALLBACK, NULL,
+                          (const UINT8 *) TEST24_DATA, TEST24_DATA_LEN);
+        IF_ERROR("tlp_publish");
+
+        vos_threadDelay(TEST24_INTERVAL * TEST24_CYCLES);
+
+        err = tlc_getProcessStatistics(gSession1.appHandle, &procStats, TRUE);
+        IF_ERROR("tlc_getProcessStatistics");
+        fprintf(gFp, "passes %u, p50 %u ns, max %u ns; overruns: %u passes (last %u ns, stage %u %u ns), "
+                "%u callbacks (last comId %u, stage %u, %u ns)\n",
+                procStats.stage[TRDP_STAGE_PASS].count,
+                tlc_getLatencyPercentile(&procStats.stage[TRDP_STAGE_PASS], 500u),
+                procStats.stage[TRDP_STAGE_PASS].max, procStats.numPassOverruns, procStats.overrunTime,
+                procStats.overrunStage, procStats.overrunStageTime, procStats.numCallbackOverruns,
+                procStats.callbackComId, procStats.callbackStage, procStats.callbackTime);
+
+        /*  every pass runs every stage  */
+        for (i = 0u; i < TRDP_STAGE_PASS; i++)
+        {
+            if (procStats.stage[i].count > numStaged)
+            {
+                numStaged = procStats.stage[i].count;
+            }
+        }
+        if ((procStats.stage[TRDP_STAGE_PASS].count == 0u) ||
+            (procStats.stage[TRDP_STAGE_PASS].count != numStaged) ||
+            (procStats.stage[TRDP_STAGE_PD_SEND].max < TEST22_CB_TIME) ||
+            (procStats.stage[TRDP_STAGE_PASS].max < procStats.stage[TRDP_STAGE_PD_SEND].max))
+        {
+            FAILED("Stage times not recorded");
+        }
+        if ((procStats.passBudget != TEST24_BUDGET) ||
+            (procStats.numPassOverruns < TEST24_CYCLES - 2u) ||
+            (procStats.overrunStage != TRDP_STAGE_PD_SEND) ||
+            (procStats.overrunStageTime < TEST22_CB_TIME) ||
+            (procStats.overrunTime < procStats.overrunStageTime))
+        {
+            FAILED("Pass overruns not detected or blamed on the wrong stage");
+        }
+        if ((procStats.numCallbackOverruns < TEST24_CYCLES - 2u) ||
+            (procStats.callbackComId != TEST24_COMID) ||
+            (procStats.callbackStage != TRDP_STAGE_PD_SEND) ||
+            (procStats.callbackTime < TEST22_CB_TIME))
+        {
+            FAILED("Callback overruns not detected");
+        }
+
+        /*  Reset on read  */
+        err = tlc_getProcessStatistics(gSession1.appHandle, &procStats, FALSE);
+        IF_ERROR("tlc_getProcessStatistics");
+        if (procStats.numPassOverruns > 1u)
+        {
+            FAILED("Overruns not reset");
+        }
+
+        err = tlp_unpublish(gSession1.appHandle, pubHandle);
+        IF_ERROR("tlp_unpublish");
+
+        err = tlc_setProcessTiming(gSession1.appHandle, FALSE, 0u, 0u);
+        IF_ERROR("tlc_setProcessTiming");
+        if (tlc_getProcessStatistics(gSession1.appHandle, &procStats, FALSE) != TRDP_PARAM_ERR)
+        {
+            FAILED("Timing statistics returned while off");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** Find the callback accounting of a comId
+ */
+static const TRDP_CALLBACK_STATISTICS_T *test25Find (
+    const TRDP_CALLBACK_STATISTICS_T    *pStats,
+    UINT16                              num,
+    UINT32                              comId,
+    UINT32                              owner)
+{
+    UINT16 i;
+
+    for (i = 0u; i < num; i++)
+    {
+        if ((pStats[i].comId == comId) && (pStats[i].owner == owner))
+        {
+            return &pStats[i];
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Callback accounting per publisher, subscription and listener
+ *
+ *  With TRDP_OPTION_CALLBACK_STATS the pre-send callback of test22 (1ms) is accounted to its publisher and counted
+ *  as slow, the receive callbacks to the subscription and the notifications to the listener. Another publisher
+ *  opened without the option is not timed.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test25 ()
+{
+    PREPARE_OPT("Callback accounting", "test", TRDP_OPTION_CALLBACK_STATS); /* allocates appHandle1, appHandle2,
+                                                                               failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+#define TEST25_COMID        25000u
+#define TEST25_MD_COMID     25100u
+#define TEST25_INTERVAL     20000u
+#define TEST25_CYCLES       20u
+#define TEST25_NOTIFY       5
+#define TEST25_DATA         "Hello Callback!"
+#define TEST25_DATA_LEN     16u
+#define TEST25_MAX_STATS    16u
+
+        TRDP_PUB_T                          pubHandle;
+        TRDP_SUB_T                          subHandle;
+        TRDP_LIS_T                          listenHandle;
+        TRDP_CALLBACK_STATISTICS_T          cbStats[TEST25_MAX_STATS];
+        const TRDP_CALLBACK_STATISTICS_T    *pEntry;
+        UINT16                              num;
+        int                                 i;
+
+        err = tlc_setCallbackThreshold(gSession1.appHandle, TEST22_CB_TIME / 2000u);
+        IF_ERROR("tlc_setCallbackThreshold");
+        err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, test22RcvCallBack, TEST25_COMID, 0u, 0u,
+                            0u, 0u, 0u, TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB, TEST25_INTERVAL * 10u,
+                            TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        err = tlm_addListener(gSession2.appHandle, &listenHandle, NULL, test21CBFunction, TRUE,
+                              TEST25_MD_COMID, 0u, 0u, 0u, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK,
+                              NULL, NULL);
+        IF_ERROR("tlm_addListener");
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, test22SendCallBack, TEST25_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST25_INTERVAL, 0u, TRDP_FLAGS_CALLBACK, NULL,
+                          (const UINT8 *) TEST25_DATA, TEST25_DATA_LEN);
+        IF_ERROR("tlp_publish");
+        for (i = 0; i < TEST25_NOTIFY; i++)
+        {
+            err = tlm_notify(gSession1.appHandle, NULL, NULL, TEST25_MD_COMID, 0u, 0u, 0u,
+                             gSession2.ifaceIP, TRDP_FLAGS_NONE, NULL, (const UINT8 *) TEST25_DATA,
+                             TEST25_DATA_LEN, NULL, NULL);
+            IF_ERROR("tlm_notify");
+        }
+
+        vos_threadDelay(TEST25_INTERVAL * TEST25_CYCLES);
+
+        num = TEST25_MAX_STATS;
+        err = tlc_getCallbackStatistics(gSession1.appHandle, &num, cbStats, FALSE);
+        IF_ERROR("tlc_getCallbackStatistics");
+        pEntry = test25Find(cbStats, num, TEST25_COMID, TRDP_CB_PUBLISHER);
+        if (pEntry == NULL)
+        {
+            FAILED("No callback accounting of the publisher");
+        }
+        fprintf(gFp, "publisher: %u calls, %u slow, max %u ns, total %llu ns\n", pEntry->numCalls, pEntry->numSlow,
+                pEntry->maxTime, (unsigned long long) pEntry->totalTime);
+        if ((pEntry->numCalls < TEST25_CYCLES - 2u) || (pEntry->numSlow != pEntry->numCalls) ||
+            (pEntry->maxTime < TEST22_CB_TIME) ||
+            (pEntry->totalTime < (UINT64) pEntry->numCalls * TEST22_CB_TIME))
+        {
+            FAILED("Pre-send callbacks not accounted to the publisher");
+        }
+
+        num = TEST25_MAX_STATS;
+        err = tlc_getCallbackStatistics(gSession2.appHandle, &num, cbStats, TRUE);
+        IF_ERROR("tlc_getCallbackStatistics");
+        pEntry = test25Find(cbStats, num, TEST25_COMID, TRDP_CB_SUBSCRIPTION);
+        if ((pEntry == NULL) || (pEntry->numCalls < TEST25_CYCLES - 2u) || (pEntry->numSlow != 0u))
+        {
+            FAILED("Receive callbacks not accounted to the subscription");
+        }
+        pEntry = test25Find(cbStats, num, TEST25_MD_COMID, TRDP_CB_LISTENER);
+        if ((pEntry == NULL) || (pEntry->numCalls != TEST25_NOTIFY))
+        {
+            FAILED("Notifications not accounted to the listener");
+        }
+
+        /*  Reset on read  */
+        num = TEST25_MAX_STATS;
+        err = tlc_getCallbackStatistics(gSession2.appHandle, &num, cbStats, FALSE);
+        IF_ERROR("tlc_getCallbackStatistics");
+        pEntry = test25Find(cbStats, num, TEST25_MD_COMID, TRDP_CB_LISTENER);
+        if ((pEntry == NULL) || (pEntry->numCalls != 0u))
+        {
+            FAILED("Listener accounting not reset");
+        }
+
+        err = tlp_unpublish(gSession1.appHandle, pubHandle);
+        IF_ERROR("tlp_unpublish");
+        err = tlp_unsubscribe(gSession2.appHandle, subHandle);
+        IF_ERROR("tlp_unsubscribe");
+        err = tlm_delListener(gSession2.appHandle, listenHandle);
+        IF_ERROR("tlm_delListener");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** Callbacks are not timed without TRDP_OPTION_CALLBACK_STATS
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test26 ()
+{
+    PREPARE("Callback accounting off", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T                          pubHandle;
+        TRDP_CALLBACK_STATISTICS_T          cbStats[TEST25_MAX_STATS];
+        const TRDP_CALLBACK_STATISTICS_T    *pEntry;
+        UINT16                              num;
+
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, test20SendCallBack, TEST25_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST25_INTERVAL, 0u, TRDP_FLAGS_CALLBACK, NULL,
+                          (const UINT8 *) TEST25_DATA, TEST25_DATA_LEN);
+        IF_ERROR("tlp_publish");
+        gTest20Count = 0;
+
+        vos_threadDelay(TEST25_INTERVAL * 5u);
+
+        num = TEST25_MAX_STATS;
+        err = tlc_getCallbackStatistics(gSession1.appHandle, &num, cbStats, FALSE);
+        IF_ERROR("tlc_getCallbackStatistics");
+        pEntry = test25Find(cbStats, num, TEST25_COMID, TRDP_CB_PUBLISHER);
+        if ((gTest20Count == 0) || (pEntry == NULL) || (pEntry->numCalls != 0u))
+        {
+            FAILED("Callbacks timed without TRDP_OPTION_CALLBACK_STATS");
+        }
+
+        err = tlp_unpublish(gSession1.appHandle, pubHandle);
+        IF_ERROR("tlp_unpublish");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+#define TEST27_COMID        27000u
+#define TEST27_INTERVAL     10000u
+#define TEST27_CYCLES       30u
+#define TEST27_EVENTS       32u
+#define TEST27_FILE         "trdp_test27.bin"
+#define TEST27_DATA         "Hello Trace!"
+#define TEST27_DATA_LEN     13u
+
+static TRDP_APP_SESSION_T   gTest27Session;
+static int                  gTest27Fd;
+static volatile TRDP_ERR_T  gTest27Err;
+
+#if defined (POSIX)
+static void test27Signal (int sig)
+{
+    (void) sig;
+    gTest27Err = tlc_dumpTraceFd(gTest27Session, gTest27Fd);
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Trace dump from a signal handler into a descriptor opened in advance
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test27 ()
+{
+    PREPARE("Trace dump from a signal handler", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+#if defined (POSIX)
+    {
+        TRDP_PUB_T          pubHandle;
+        TRDP_TRACE_HEADER_T header;
+        FILE                *fp;
+        long                fileSize;
+
+        err = tlc_setTrace(gSession1.appHandle, TEST27_EVENTS, NULL);
+        IF_ERROR("tlc_setTrace");
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST27_COMID, 0u, 0u,
+                          0u, gSession2.ifaceIP, TEST27_INTERVAL, 0u, TRDP_FLAGS_NONE, NULL,
+                          (const UINT8 *) TEST27_DATA, TEST27_DATA_LEN);
+        IF_ERROR("tlp_publish");
+
+        vos_threadDelay(TEST27_INTERVAL * TEST27_CYCLES);
+
+        /*  Dump while the processing thread keeps recording  */
+        gTest27Session  = gSession1.appHandle;
+        gTest27Fd       = open(TEST27_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (gTest27Fd < 0)
+        {
+            FAILED("Cannot open the dump file");
+        }
+        gTest27Err = TRDP_UNKNOWN_ERR;
+        (void) signal(SIGUSR1, test27Signal);
+        (void) raise(SIGUSR1);
+        (void) signal(SIGUSR1, SIG_DFL);
+        (void) close(gTest27Fd);
+        if (gTest27Err != TRDP_NO_ERR)
+        {
+            FAILED("tlc_dumpTraceFd failed in the signal handler");
+        }
+
+        fp = fopen(TEST27_FILE, "rb");
+        if ((fp == NULL) || (fread(&header, sizeof(header), 1u, fp) != 1u))
+        {
+            FAILED("Cannot read the dump file");
+        }
+        (void) fseek(fp, 0, SEEK_END);
+        fileSize = ftell(fp);
+        (void) fclose(fp);
+        fprintf(gFp, "%u records, %u lost, %ld bytes\n", header.noOfRecs, header.numLost, fileSize);
+        if ((memcmp(header.magic, TRDP_TRACE_MAGIC, sizeof(TRDP_TRACE_MAGIC)) != 0) ||
+            (header.recSize != sizeof(TRDP_TRACE_REC_T)) ||
+            (header.noOfRecs != TEST27_EVENTS) || (header.numLost == 0u) ||
+            (fileSize != (long) (sizeof(header) + header.noOfRecs * header.recSize)))
+        {
+            FAILED("Dump does not hold the wrapped ring");
+        }
+
+        /*  The ring is detached when tracing is switched off  */
+        err = tlc_setTrace(gSession1.appHandle, 0u, NULL);
+        IF_ERROR("tlc_setTrace");
+        gTest27Fd = open(TEST27_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        err = tlc_dumpTraceFd(gSession1.appHandle, gTest27Fd);
+        (void) close(gTest27Fd);
+        (void) unlink(TEST27_FILE);
+        if (err != TRDP_PARAM_ERR)
+        {
+            FAILED("Dump without a trace ring");
+        }
+        err = TRDP_NO_ERR;
+
+        err = tlp_unpublish(gSession1.appHandle, pubHandle);
+        IF_ERROR("tlp_unpublish");
+    }
+#endif
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+#define TEST28_COMID        28000u
+#define TEST28_PUBS         1000u
+#define TEST28_INTERVAL     1000000u
+#define TEST28_PORT         47280u
+#define TEST28_RESP_SIZE    (1024u * 1024u)
+#define TEST28_MIN_SIZE     32768u      /* more than the initial render buffer of the endpoint */
+#define TEST28_REQUEST      "GET /metrics HTTP/1.0\r\n\r\n"
+
+#if defined (POSIX)
+/**********************************************************************************************************************/
+/** Connect to the metrics endpoint and send the request
+ *
+ *  @param[in]      rcvBuf          receive buffer size of the client, 0: default
+ *
+ *  @retval         socket, -1 on error
+ */
+static int test28Request (int rcvBuf)
+{
+    struct sockaddr_in  addr;
+    int                 sock = socket(AF_INET, SOCK_STREAM, 0);
+
+    if (sock < 0)
+    {
+        return -1;
+    }
+    if (rcvBuf != 0)
+    {
+        (void) setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &rcvBuf, sizeof(rcvBuf));
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family         = AF_INET;
+    addr.sin_port           = htons(TEST28_PORT);
+    addr.sin_addr.s_addr    = htonl(gSession1.ifaceIP);
+    if ((connect(sock, (struct sockaddr *) &addr, sizeof(addr)) != 0) ||
+        (send(sock, TEST28_REQUEST, strlen(TEST28_REQUEST), 0) != (ssize_t) strlen(TEST28_REQUEST)))
+    {
+        (void) close(sock);
+        return -1;
+    }
+    return sock;
+}
+
+/**********************************************************************************************************************/
+/** Read the response in small pieces until the server closes the connection
+ *
+ *  @param[in]      sock            connected socket
+ *  @param[out]     pBuf            response, zero terminated
+ *  @param[in]      size            size of the buffer
+ *
+ *  @retval         length of the response
+ */
+static UINT32 test28Read (int sock, char *pBuf, UINT32 size)
+{
+    UINT32  len = 0u;
+    ssize_t n;
+
+    do
+    {
+        n = recv(sock, pBuf + len, (size - len - 1u < 1024u) ? size - len - 1u : 1024u, 0);
+        if (n > 0)
+        {
+            len += (UINT32) n;
+        }
+        vos_threadDelay(1000u);
+    }
+    while ((n > 0) && (len < size - 1u));
+    pBuf[len] = 0;
+    return len;
+}
+
+/**********************************************************************************************************************/
+/** Count the occurrences of a string
+ *
+ *  @retval         number found
+ */
+static UINT32 test28Count (const char *pText, const char *pPattern)
+{
+    UINT32 count = 0u;
+
+    while ((pText = strstr(pText, pPattern)) != NULL)
+    {
+        count++;
+        pText++;
+    }
+    return count;
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Metrics endpoint: a response larger than the client takes at once, rendered in slices
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test28 ()
+{
+    PREPARE("Metrics endpoint", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+#if defined (POSIX)
+    {
+        TRDP_PUB_T      pubHandle[TEST28_PUBS];
+        char            *pResp = (char *) malloc(TEST28_RESP_SIZE);
+        const char      *pBody;
+        const char      *pLength;
+        char            pattern[64];
+        unsigned int    contentLength = 0u;
+        UINT32          len;
+        UINT32          i;
+        int             sock;
+
+        if (pResp == NULL)
+        {
+            FAILED("Out of memory");
+        }
+        for (i = 0u; i < TEST28_PUBS; i++)
+        {
+            err = tlp_publish(gSession1.appHandle, &pubHandle[i], NULL, NULL, TEST28_COMID + i, 0u, 0u,
+                              0u, gSession2.ifaceIP, TEST28_INTERVAL, 0u, TRDP_FLAGS_NONE, NULL,
+                              (const UINT8 *) "Hello Metrics!", 15u);
+            IF_ERROR("tlp_publish");
+        }
+        err = tlc_setMetricsPort(gSession1.appHandle, 0u, TEST28_PORT);
+        IF_ERROR("tlc_setMetricsPort");
+
+        /*  The client does not read at first, the server has to continue the response later  */
+        sock = test28Request(4096);
+        if (sock < 0)
+        {
+            FAILED("Cannot connect to the metrics endpoint");
+        }
+        vos_threadDelay(300000u);
+        len = test28Read(sock, pResp, TEST28_RESP_SIZE);
+        (void) close(sock);
+
+        pBody   = strstr(pResp, "\r\n\r\n");
+        pLength = strstr(pResp, "Content-Length: ");
+        if ((strncmp(pResp, "HTTP/1.0 200 OK\r\n", 17u) != 0) || (pBody == NULL) || (pLength == NULL) ||
+            (sscanf(pLength + 16, "%u", &contentLength) != 1))
+        {
+            FAILED("No valid response header");
+        }
+        pBody += 4;
+        fprintf(gFp, "response: %u bytes, content length %u\n", len, contentLength);
+        if ((contentLength != (unsigned int) (len - (UINT32) (pBody - pResp))) ||
+            (contentLength <= TEST28_MIN_SIZE) ||
+            (strcmp(pResp + len - 6u, "# EOF\n") != 0))
+        {
+            FAILED("Response incomplete");
+        }
+        if ((test28Count(pBody, "trdp_pd_publisher_sent_total{comId=\"28") != TEST28_PUBS) ||
+            (test28Count(pBody, "trdp_pd_publisher_interval_seconds{comId=\"28") != TEST28_PUBS) ||
+            (test28Count(pBody, "# TYPE trdp_pd_publisher_put counter") != 1u) ||
+            (test28Count(pBody, "# TYPE trdp_pd_latency_seconds histogram") != 1u))
+        {
+            FAILED("Families not rendered completely");
+        }
+        (void) snprintf(pattern, sizeof(pattern), "trdp_pd_publisher_put_total{comId=\"%u\"",
+                        (unsigned int) (TEST28_COMID + TEST28_PUBS - 1u));
+        if (strstr(pBody, pattern) == NULL)
+        {
+            FAILED("Last publisher missing");
+        }
+
+        /*  A client leaving in the middle of the response must not raise SIGPIPE: after its FIN and the reset
+            for the unread data the next send of the endpoint fails with EPIPE  */
+        sock = test28Request(4096);
+        if (sock < 0)
+        {
+            FAILED("Cannot connect to the metrics endpoint");
+        }
+        (void) shutdown(sock, SHUT_WR);
+        vos_threadDelay(300000u);
+        (void) close(sock);
+        vos_threadDelay(300000u);
+
+        sock = test28Request(0);
+        if (sock < 0)
+        {
+            FAILED("Endpoint gone after a closed connection");
+        }
+        len = test28Read(sock, pResp, TEST28_RESP_SIZE);
+        (void) close(sock);
+        if ((len == 0u) || (strcmp(pResp + len - 6u, "# EOF\n") != 0))
+        {
+            FAILED("No response after a closed connection");
+        }
+        free(pResp);
+
+        err = tlc_setMetricsPort(gSession1.appHandle, 0u, 0u);
+        IF_ERROR("tlc_setMetricsPort");
+        for (i = 0u; i < TEST28_PUBS; i++)
+        {
+            err = tlp_unpublish(gSession1.appHandle, pubHandle[i]);
+            IF_ERROR("tlp_unpublish");
+        }
+    }
+#endif
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+#define TEST29_SRC_IP   0x0A000201u
+#define TEST29_RESET    0xFFFFFFFFu     /* step: reset the sequence counter (timeout), not used as counter */
+
+typedef struct
+{
+    UINT32  seq;            /* received sequence counter or TEST29_RESET        */
+    int     result;         /* expected return value                            */
+    INT32   missed;         /* expected change of the missed packets            */
+    UINT32  numLost;        /* expected counters of the source after the step   */
+    UINT32  numReordered;
+    UINT32  numDuplicate;
+} TEST29_STEP_T;
+
+typedef struct
+{
+    const char          *pName;
+    UINT32              noOfSteps;
+    const TEST29_STEP_T *pSteps;
+} TEST29_CASE_T;
+
+static const TEST29_STEP_T  cTest29InOrder[] = {{1u, 0, 0, 0u, 0u, 0u}, {2u, 0, 0, 0u, 0u, 0u}, {3u, 0, 0, 0u, 0u, 0u}};
+static const TEST29_STEP_T  cTest29Gap[] = {{1u, 0, 0, 0u, 0u, 0u}, {4u, 0, 2, 2u, 0u, 0u}, {5u, 0, 0, 2u, 0u, 0u}};
+static const TEST29_STEP_T  cTest29Late[] =
+{
+    {1u, 0, 0, 0u, 0u, 0u}, {4u, 0, 2, 2u, 0u, 0u}, {2u, 1, -1, 1u, 1u, 0u}, {3u, 1, -1, 0u, 2u, 0u},
+    {3u, 1, 0, 0u, 2u, 1u}
+};
+static const TEST29_STEP_T  cTest29Duplicate[] =
+{
+    {5u, 0, 0, 0u, 0u, 0u}, {5u, 1, 0, 0u, 0u, 1u}, {6u, 0, 0, 0u, 0u, 1u}, {5u, 1, 0, 0u, 0u, 2u}
+};
+static const TEST29_STEP_T  cTest29Wrap[] =
+{
+    {0xFFFFFFFDu, 0, 0, 0u, 0u, 0u}, {0xFFFFFFFEu, 0, 0, 0u, 0u, 0u}, {1u, 0, 2, 2u, 0u, 0u},
+    {0u, 1, -1, 1u, 1u, 0u}, {0xFFFFFFFEu, 1, 0, 1u, 1u, 1u}, {2u, 0, 0, 1u, 1u, 1u}
+};
+static const TEST29_STEP_T  cTest29Reset[] =
+{
+    {10u, 0, 0, 0u, 0u, 0u}, {12u, 0, 1, 1u, 0u, 0u}, {TEST29_RESET, 0, 0, 1u, 0u, 0u}, {20u, 0, 0, 1u, 0u, 0u},
+    {15u, 1, 0, 1u, 0u, 0u}, {19u, 1, 0, 1u, 0u, 0u}, {11u, 1, 0, 1u, 0u, 0u}
+};
+static const TEST29_STEP_T  cTest29Old[] =
+{
+    {100u, 0, 0, 0u, 0u, 0u}, {200u, 0, 99, 99u, 0u, 0u}, {150u, 1, 0, 99u, 0u, 0u}, {199u, 1, -1, 98u, 1u, 0u}
+};
+
+#define TEST29_CASE(name, steps)    {name, sizeof(steps) / sizeof(steps[0]), steps}
+
+static const TEST29_CASE_T  cTest29Cases[] =
+{
+    TEST29_CASE("in order", cTest29InOrder),
+    TEST29_CASE("gap", cTest29Gap),
+    TEST29_CASE("late", cTest29Late),
+    TEST29_CASE("duplicate", cTest29Duplicate),
+    TEST29_CASE("wrap", cTest29Wrap),
+    TEST29_CASE("reset", cTest29Reset),
+    TEST29_CASE("older than the window", cTest29Old)
+};
+
+/**********************************************************************************************************************/
+/** Sequence counter check of a subscription: in order, gap, late, duplicate, wrap, reset
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test29 ()
+{
+    PREPARE("Sequence counter check", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        PD_ELE_T                    element;
+        const TRDP_SEQ_CNT_ENTRY_T  *pEntry;
+        const TEST29_STEP_T         *pStep;
+        UINT32                      caseNo;
+        UINT32                      stepNo;
+        INT32                       missed;
+        int                         result;
+
+        for (caseNo = 0u; caseNo < sizeof(cTest29Cases) / sizeof(cTest29Cases[0]); caseNo++)
+        {
+            memset(&element, 0, sizeof(element));
+            for (stepNo = 0u; stepNo < cTest29Cases[caseNo].noOfSteps; stepNo++)
+            {
+                pStep = &cTest29Cases[caseNo].pSteps[stepNo];
+                if (pStep->seq == TEST29_RESET)
+                {
+                    trdp_resetSequenceCounter(&element, TEST29_SRC_IP, TRDP_MSG_PD);
+                    result  = 0;
+                    missed  = 0;
+                }
+                else
+                {
+                    result = trdp_checkSequenceCounter(&element, pStep->seq, TEST29_SRC_IP, TRDP_MSG_PD, &missed);
+                }
+                pEntry = &element.pSeqCntList->seq[0];
+                if ((result != pStep->result) || (missed != pStep->missed) ||
+                    (pEntry->numLost != pStep->numLost) || (pEntry->numReordered != pStep->numReordered) ||
+                    (pEntry->numDuplicate != pStep->numDuplicate))
+                {
+                    fprintf(gFp, "%s, step %u (seq %u): result %d, missed %d, lost %u, reordered %u, duplicate %u\n",
+                            cTest29Cases[caseNo].pName, stepNo, pStep->seq, result, missed, pEntry->numLost,
+                            pEntry->numReordered, pEntry->numDuplicate);
+                    vos_memFree(element.pSeqCntList);
+                    FAILED("Sequence counter check");
+                }
+            }
+            vos_memFree(element.pSeqCntList);
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** List statistics: not published by default, pulled after tlc_publishListStatistics()
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test30 ()
+{
+    PREPARE("List statistics on request", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+#define TEST30_COMID        30001u
+#define TEST30_PUBS         5u
+        TRDP_STATISTICS_T       stats;
+        TRDP_PUB_STATISTICS_T   pubStats[TEST30_PUBS + 3u];
+        TRDP_PUB_T              pubHandle;
+        TRDP_SUB_T              subHandle;
+        TRDP_PD_INFO_T          pdInfo;
+        UINT8                   buffer[TRDP_MAX_PD_DATA_SIZE];
+        UINT32                  dataSize = 0u;
+        const TRDP_STATISTICS_LIST_T    *pHead = (const TRDP_STATISTICS_LIST_T *) buffer;
+        const TRDP_PUB_STATISTICS_T     *pEntry = (const TRDP_PUB_STATISTICS_T *) (pHead + 1);
+        UINT16                  numPub = TEST30_PUBS + 3u;
+        UINT16                  numFound = 0u;
+        UINT32                  i;
+        int                     counter;
+
+        /*  A new session publishes the global statistics only  */
+        err = tlc_getStatistics(appHandle1, &stats);
+        IF_ERROR("tlc_getStatistics");
+        if (stats.pd.numPub != 1u)
+        {
+            fprintf(gFp, "numPub %u after tlc_openSession\n", stats.pd.numPub);
+            FAILED("List statistics published by default");
+        }
+
+        for (i = 0u; i < TEST30_PUBS; i++)
+        {
+            err = tlp_publish(appHandle1, &pubHandle, NULL, NULL, TEST30_COMID + i, 0u, 0u, 0u,
+                              gSession2.ifaceIP, 0u, 0u, TRDP_FLAGS_NONE, NULL, NULL, 16u);
+            IF_ERROR("tlp_publish");
+        }
+
+        /*  Opt in, a second call has no effect  */
+        err = tlc_publishListStatistics(appHandle1);
+        IF_ERROR("tlc_publishListStatistics");
+        err = tlc_publishListStatistics(appHandle1);
+        IF_ERROR("tlc_publishListStatistics (again)");
+        err = tlc_getPubStatistics(appHandle1, &numPub, pubStats);
+        IF_ERROR("tlc_getPubStatistics");
+        for (i = 0u; i < numPub; i++)
+        {
+            if ((pubStats[i].comId == TRDP_SUBS_STATISTICS_COMID) || (pubStats[i].comId == TRDP_PUB_STATISTICS_COMID))
+            {
+                FAILED("Standard list ComId published");
+            }
+        }
+        if (numPub != TEST30_PUBS + 3u)
+        {
+            fprintf(gFp, "numPub %u after tlc_publishListStatistics\n", numPub);
+            FAILED("List statistics not published once");
+        }
+
+        /*  Pull the publisher list of session 1  */
+        err = tlp_subscribe(appHandle2, &subHandle, NULL, NULL, TRDP_PUB_LIST_COMID, 0u, 0u,
+                            gSession1.ifaceIP, 0u, 0u, TRDP_FLAGS_NONE, 0u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+
+        /*  The request is repeated until the reply is there, a request sent too early may be lost  */
+        for (counter = 0; counter < 100; counter++)
+        {
+            if ((counter % 10) == 0)
+            {
+                err = tlp_request(appHandle2, subHandle, TRDP_STATISTICS_PULL_COMID, 0u, 0u, gSession2.ifaceIP,
+                                  gSession1.ifaceIP, 0u, TRDP_FLAGS_NONE, NULL, NULL, 0u,
+                                  TRDP_PUB_LIST_COMID, gSession2.ifaceIP);
+                IF_ERROR("tlp_request");
+            }
+            vos_threadDelay(20000u);
+            dataSize    = sizeof(buffer);
+            err         = tlp_get(appHandle2, subHandle, &pdInfo, buffer, &dataSize);
+            if (err == TRDP_NO_ERR)
+            {
+                break;
+            }
+        }
+        IF_ERROR("tlp_get");
+
+        if ((vos_ntohs(pHead->numTotal) != TEST30_PUBS + 3u) || (vos_ntohs(pHead->numEntries) != TEST30_PUBS + 3u) ||
+            (dataSize != sizeof(TRDP_STATISTICS_LIST_T) + (TEST30_PUBS + 3u) * (sizeof(TRDP_PUB_STATISTICS_T) + 4u)))
+        {
+            fprintf(gFp, "List: total %u, entries %u, size %u\n", vos_ntohs(pHead->numTotal),
+                    vos_ntohs(pHead->numEntries), dataSize);
+            FAILED("Publisher list");
+        }
+        for (i = 0u; i < TEST30_PUBS + 3u; i++)
+        {
+            if ((vos_ntohl(pEntry[i].comId) >= TEST30_COMID) && (vos_ntohl(pEntry[i].comId) < TEST30_COMID + TEST30_PUBS))
+            {
+                numFound++;
+            }
+        }
+        if (numFound != TEST30_PUBS)
+        {
+            FAILED("Publishers missing in the list");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** Wait for history samples written by the session's tlc_process()
+ *
+ *  @param[in]      pHeader         mapped history area
+ *  @param[in]      minimum         number of samples to wait for
+ *
+ *  @retval         numWritten      (less than minimum after 5 s)
+ */
+#if defined (POSIX)
+static UINT32 test31Wait (
+    TRDP_HISTORY_HEADER_T   *pHeader,
+    UINT32                  minimum)
+{
+    UINT32  numWritten = 0u;
+    int     counter;
+
+    for (counter = 0; counter < 50; counter++)
+    {
+        numWritten = __atomic_load_n(&pHeader->numWritten, __ATOMIC_ACQUIRE);
+        if (numWritten >= minimum)
+        {
+            break;
+        }
+        vos_threadDelay(100000u);
+    }
+    return numWritten;
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Statistics history: opening, sample writing, continuing an existing ring
+ *
+ *  The area is created by the test, so it outlives tlc_closeHistory() like one left behind by a crashed process.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test31 ()
+{
+    PREPARE("Statistics history", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+#if defined (POSIX)
+    {
+#define TEST31_KEY          "/trdp-test31"
+#define TEST31_SAMPLES      4u
+#define TEST31_COMID        31001u
+        TRDP_HISTORY_HEADER_T   *pHeader;
+        TRDP_HISTORY_SAMPLE_T   *pRing;
+        TRDP_PUB_T              pubHandle;
+        UINT8                   data[16] = {0};
+        VOS_SHRD_T              handle  = NULL;
+        UINT8                   *pArea  = NULL;
+        UINT32                  size    = (UINT32) (sizeof(TRDP_HISTORY_HEADER_T) +
+                                                    TEST31_SAMPLES * sizeof(TRDP_HISTORY_SAMPLE_T));
+        UINT32                  numWritten;
+        UINT32                  numClosed;
+        UINT32                  n;
+
+        if ((tlc_openHistory(appHandle1, NULL, TEST31_SAMPLES) != TRDP_PARAM_ERR) ||
+            (tlc_openHistory(appHandle1, TEST31_KEY, 0u) != TRDP_PARAM_ERR))
+        {
+            FAILED("tlc_openHistory parameter check");
+        }
+
+        (void) shm_unlink(TEST31_KEY);                  /* left over from an aborted run */
+        if (vos_sharedOpen(TEST31_KEY, &handle, &pArea, &size) != VOS_NO_ERR)
+        {
+            FAILED("vos_sharedOpen");
+        }
+        pHeader = (TRDP_HISTORY_HEADER_T *) pArea;
+        pRing   = (TRDP_HISTORY_SAMPLE_T *) (pArea + sizeof(TRDP_HISTORY_HEADER_T));
+
+        err = tlp_publish(appHandle1, &pubHandle, NULL, NULL, TEST31_COMID, 0u, 0u, 0u, gSession2.ifaceIP,
+                          100000u, 0u, TRDP_FLAGS_NONE, NULL, data, sizeof(data));
+        IF_ERROR("tlp_publish");
+
+        /*  A new (zeroed) area is initialized and written once per TRDP_HISTORY_INTERVAL  */
+        err = tlc_openHistory(appHandle1, TEST31_KEY, TEST31_SAMPLES);
+        IF_ERROR("tlc_openHistory");
+        if ((memcmp(pHeader->magic, TRDP_HISTORY_MAGIC, sizeof(TRDP_HISTORY_MAGIC)) != 0) ||
+            (pHeader->version != TRDP_HISTORY_VERSION) || (pHeader->noOfSamples != TEST31_SAMPLES) ||
+            (pHeader->sampleSize != sizeof(TRDP_HISTORY_SAMPLE_T)) || (pHeader->ownIpAddr != gSession1.ifaceIP))
+        {
+            FAILED("History header");
+        }
+        numWritten = test31Wait(pHeader, 3u);
+        if (numWritten < 3u)
+        {
+            fprintf(gFp, "%u samples written\n", numWritten);
+            FAILED("History not written");
+        }
+        for (n = numWritten - 2u; n <= numWritten; n++)
+        {
+            if ((pRing[(n - 1u) % TEST31_SAMPLES].seq != n) || (pRing[(n - 1u) % TEST31_SAMPLES].wallTime == 0u))
+            {
+                fprintf(gFp, "slot %u: seq %u, expected %u\n", (n - 1u) % TEST31_SAMPLES,
+                        pRing[(n - 1u) % TEST31_SAMPLES].seq, n);
+                FAILED("History sample");
+            }
+        }
+        if (pRing[(numWritten - 1u) % TEST31_SAMPLES].pdNumSend <= pRing[(numWritten - 3u) % TEST31_SAMPLES].pdNumSend)
+        {
+            FAILED("Sent PD not counted in the history");
+        }
+
+        /*  Nothing is written after closing, the area stays (not created by the session)  */
+        err = tlc_closeHistory(appHandle1);
+        IF_ERROR("tlc_closeHistory");
+        numClosed = __atomic_load_n(&pHeader->numWritten, __ATOMIC_ACQUIRE);
+        vos_threadDelay((TRDP_HISTORY_INTERVAL + 200u) * 1000u);
+        if (__atomic_load_n(&pHeader->numWritten, __ATOMIC_ACQUIRE) != numClosed)
+        {
+            FAILED("History written after tlc_closeHistory");
+        }
+
+        /*  A different layout is refused, the same one is continued  */
+        if (tlc_openHistory(appHandle1, TEST31_KEY, TEST31_SAMPLES + 1u) != TRDP_PARAM_ERR)
+        {
+            FAILED("History with a different size accepted");
+        }
+        err = tlc_openHistory(appHandle1, TEST31_KEY, TEST31_SAMPLES);
+        IF_ERROR("tlc_openHistory (continue)");
+        numWritten = test31Wait(pHeader, numClosed + 2u);
+        if (numWritten < numClosed + 2u)
+        {
+            fprintf(gFp, "%u samples written, %u before\n", numWritten, numClosed);
+            FAILED("History not continued");
+        }
+        for (n = numClosed; n <= numClosed + 2u; n++)
+        {
+            if (pRing[(n - 1u) % TEST31_SAMPLES].seq != n)
+            {
+                fprintf(gFp, "slot %u: seq %u, expected %u\n", (n - 1u) % TEST31_SAMPLES,
+                        pRing[(n - 1u) % TEST31_SAMPLES].seq, n);
+                FAILED("Continued history sample");
+            }
+        }
+        if (pRing[(numClosed + 1u) % TEST31_SAMPLES].pdNumSend < pRing[(numClosed - 1u) % TEST31_SAMPLES].pdNumSend)
+        {
+            FAILED("Continued history not monotonic");
+        }
+
+        (void) tlc_closeHistory(appHandle1);
+        (void) vos_sharedClose(handle, pArea);
+    }
+#endif
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** Configuration image: a changed XML file is detected even with the same size and modification time
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test32 ()
+{
+    PREPARE("Configuration image stamp", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+#if defined (POSIX)
+    {
+#define TEST32_FILE         "test32.xml"
+#define TEST32_IMAGE        "test32.img"
+        /*  Same length of the XML text, only a cycle time differs  */
+        const UINT32        tlgA[]  = {32001u, 50000u, 32002u, 50000u, 0u};
+        const UINT32        tlgB[]  = {32001u, 50000u, 32002u, 60000u, 0u};
+        TRDP_XML_CONFIG_T   config;
+        struct stat         stampA;
+        struct stat         stampB;
+        struct timespec     times[2];
+
+        if ((test18_writeConfig(TEST32_FILE, tlgA, FALSE) != 0) || (stat(TEST32_FILE, &stampA) != 0))
+        {
+            FAILED("Configuration not writable");
+        }
+        err = tau_readXmlConfig(TEST32_FILE, &config);
+        IF_ERROR("tau_readXmlConfig");
+        err = tau_writeConfigImage(&config, TEST32_FILE, TEST32_IMAGE);
+        tau_freeConfig(&config);
+        IF_ERROR("tau_writeConfigImage");
+
+        err = tau_loadConfig(TEST32_FILE, TEST32_IMAGE, &config);
+        IF_ERROR("tau_loadConfig");
+        if (config.pImage == NULL)
+        {
+            tau_freeConfig(&config);
+            FAILED("Up to date image not used");
+        }
+        tau_freeConfig(&config);
+
+        /*  Edit the file and restore its modification time  */
+        times[0]    = stampA.st_atim;
+        times[1]    = stampA.st_mtim;
+        if ((test18_writeConfig(TEST32_FILE, tlgB, FALSE) != 0) || (utimensat(AT_FDCWD, TEST32_FILE, times, 0) != 0) ||
+            (stat(TEST32_FILE, &stampB) != 0))
+        {
+            FAILED("Configuration not writable");
+        }
+        if ((stampB.st_size != stampA.st_size) || (stampB.st_mtim.tv_sec != stampA.st_mtim.tv_sec) ||
+            (stampB.st_mtim.tv_nsec != stampA.st_mtim.tv_nsec))
+        {
+            FAILED("Stamp of the edited file not restored");
+        }
+        err = tau_loadConfig(TEST32_FILE, TEST32_IMAGE, &config);
+        IF_ERROR("tau_loadConfig (edited)");
+        if (config.pImage != NULL)
+        {
+            tau_freeConfig(&config);
+            FAILED("Stale image used");
+        }
+        tau_freeConfig(&config);
+
+        (void) remove(TEST32_FILE);
+        (void) remove(TEST32_IMAGE);
+    }
+#endif
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** Put and get the kept telegram of test33 until stopped
+ */
+static volatile int         gTest33Run;
+static volatile int         gTest33Done;
+static volatile UINT32      gTest33Count;
+static TRDP_PUB_T           gTest33Pub;
+static TRDP_SUB_T           gTest33Sub;
+
+static void test33_putGet (void *pArg)
+{
+    (void) pArg;
+
+    while (gTest33Run)
+    {
+        char            data[64u];
+        UINT32          dataSize = sizeof(data);
+        TRDP_PD_INFO_T  pdInfo;
+
+        if (tlp_put(gSession1.appHandle, gTest33Pub, (const UINT8 *) "Hello Reload!", 16u) == TRDP_NO_ERR)
+        {
+            gTest33Count++;
+        }
+        (void) tlp_get(gSession2.appHandle, gTest33Sub, &pdInfo, (UINT8 *) data, &dataSize);
+        vos_threadDelay(200u);
+    }
+    gTest33Done = 1;
+}
+
+/**********************************************************************************************************************/
+/** test33 Configuration reload while another thread marshalls: the marshalling tables are switched with the
+ *  sessions locked
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test33 ()
+{
+    PREPARE("Configuration reload while marshalling", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+#define TEST33_COMID        33001u
+#define TEST33_FILE_A       "test33_a.xml"
+#define TEST33_FILE_B       "test33_b.xml"
+#define TEST33_RELOADS      20
+
+        /*  33001 is kept by every reload, 33002 and 33003 change places  */
+        const UINT32            tlgA[]      = {33001u, 50000u, 33002u, 50000u, 0u};
+        const UINT32            tlgB[]      = {33001u, 50000u, 33003u, 50000u, 0u};
+        TRDP_MARSHALL_CONFIG_T  marshall    = {tau_marshall, tau_unmarshall, NULL};
+        TRDP_APP_SESSION_T      appHandle[2];
+        TAU_CFG_SESSION_T       cfgSession  = NULL;
+        TRDP_XML_CONFIG_T       config;
+        VOS_THREAD_T            threadId    = NULL;
+        void                    *pRefCon    = NULL;
+        UINT32                  seqCnt;
+        int                     i;
+
+        if ((test18_writeConfig(TEST33_FILE_A, tlgA, TRUE) != 0) ||
+            (test18_writeConfig(TEST33_FILE_B, tlgB, TRUE) != 0))
+        {
+            FAILED("Configuration not writable");
+        }
+        err = tau_loadConfig(TEST33_FILE_A, NULL, &config);
+        IF_ERROR("tau_loadConfig");
+        err = tau_initMarshall(&pRefCon, config.numComId, config.pComIdDsIdMap, config.numDataset,
+                               config.apDataset);
+        IF_ERROR("tau_initMarshall");
+        err = tlc_configSession(gSession1.appHandle, &marshall, NULL, NULL, NULL);
+        IF_ERROR("tlc_configSession");
+        err = tlc_configSession(gSession2.appHandle, &marshall, NULL, NULL, NULL);
+        IF_ERROR("tlc_configSession");
+
+        appHandle[0]    = gSession1.appHandle;
+        appHandle[1]    = gSession2.appHandle;
+        err = tau_openCfgSession(&cfgSession, &config, 2u, appHandle, NULL, NULL, NULL, TRUE);
+        IF_ERROR("tau_openCfgSession");
+
+        gTest33Pub  = tau_getCfgPubHandle(cfgSession, gSession1.appHandle, TEST33_COMID, gSession2.ifaceIP);
+        gTest33Sub  = tau_getCfgSubHandle(cfgSession, gSession2.appHandle, TEST33_COMID, gSession1.ifaceIP);
+        if ((gTest33Pub == NULL) || (gTest33Sub == NULL))
+        {
+            tau_closeCfgSession(cfgSession);
+            FAILED("Configured telegram missing");
+        }
+
+        gTest33Run      = 1;
+        gTest33Done     = 0;
+        gTest33Count    = 0u;
+        if (vos_threadCreate(&threadId, "test33", VOS_THREAD_POLICY_OTHER, 0u, 0u, 0u, test33_putGet,
+                             NULL) != VOS_NO_ERR)
+        {
+            tau_closeCfgSession(cfgSession);
+            FAILED("Thread not started");
+        }
+
+        for (i = 0; i < TEST33_RELOADS; i++)
+        {
+            err = tau_reloadConfig(cfgSession, ((i & 1) == 0) ? TEST33_FILE_B : TEST33_FILE_A, NULL, NULL);
+            if ((err != TRDP_NO_ERR) ||
+                (gTest33Pub != tau_getCfgPubHandle(cfgSession, gSession1.appHandle, TEST33_COMID,
+                                                   gSession2.ifaceIP)))
+            {
+                break;
+            }
+            vos_threadDelay(10000u);
+        }
+
+        gTest33Run = 0;
+        while (gTest33Done == 0)
+        {
+            vos_threadDelay(1000u);
+        }
+        fprintf(gFp, "%d reloads, %u puts meanwhile\n", i, (unsigned int) gTest33Count);
+        if ((i != TEST33_RELOADS) || (gTest33Count == 0u))
+        {
+            tau_closeCfgSession(cfgSession);
+            FAILED("Reload failed or kept publisher lost");
+        }
+
+        /*  The kept telegram is still marshalled with the datasets of the last configuration  */
+        test18_exchange(cfgSession, TEST33_COMID, 1u, &seqCnt);
+        tau_closeCfgSession(cfgSession);
+        (void) remove(TEST33_FILE_A);
+        (void) remove(TEST33_FILE_B);
+        if (seqCnt == 0xFFFFFFFFu)
+        {
+            FAILED("Telegram not received after the reloads");
+        }
+        err = TRDP_NO_ERR;
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** Receive callback of test34 and test35: record comId and receive time
+ */
+#define TEST34_MAX_RECORDS  256
+
+static volatile int     gTest34Count = 0;
+static UINT32           gTest34ComId[TEST34_MAX_RECORDS];
+static VOS_TIME_NS_T    gTest34Time[TEST34_MAX_RECORDS];
+
+static void test34PDcallBack (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    int idx = gTest34Count;
+
+    if ((pMsg->resultCode == TRDP_NO_ERR) && (idx < TEST34_MAX_RECORDS))
+    {
+        gTest34ComId[idx]   = pMsg->comId;
+        gTest34Time[idx]    = vos_getTimeNs();
+        gTest34Count        = idx + 1;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Record the receive times for a while, older records are dropped
+ */
+static void test34Record (
+    UINT32 duration)
+{
+    gTest34Count = TEST34_MAX_RECORDS;          /* stop recording */
+    vos_threadDelay(20000u);
+    gTest34Count = 0;
+    vos_threadDelay(duration);
+    gTest34Count = TEST34_MAX_RECORDS;
+    vos_threadDelay(20000u);
+}
+
+/**********************************************************************************************************************/
+/** Smallest receive offset of a comId within its interval, relative to the epoch
+ *
+ *  Packets are never sent before their time, the smallest offset is the send instant plus the shortest latency.
+ *
+ *  @param[in]      comId           comId
+ *  @param[in]      epoch           cycle epoch in ns
+ *  @param[in]      interval        interval in us
+ *  @param[out]     pFirst          receive time of the first record, may be NULL
+ *
+ *  @retval         offset in us, 0xFFFFFFFF if nothing was received
+ */
+static UINT32 test34Offset (
+    UINT32          comId,
+    VOS_TIME_NS_T   epoch,
+    UINT32          interval,
+    VOS_TIME_NS_T   *pFirst)
+{
+    UINT32  minOffset = 0xFFFFFFFFu;
+    int     i;
+
+    for (i = 0; (i < gTest34Count) && (i < TEST34_MAX_RECORDS); i++)
+    {
+        VOS_TIME_NS_T   offset;
+
+        if (gTest34ComId[i] != comId)
+        {
+            continue;
+        }
+        if ((pFirst != NULL) && (minOffset == 0xFFFFFFFFu))
+        {
+            *pFirst = gTest34Time[i];
+        }
+        offset = (gTest34Time[i] - epoch) % ((VOS_TIME_NS_T) interval * 1000);
+        if (offset < 0)
+        {
+            offset += (VOS_TIME_NS_T) interval * 1000;
+        }
+        if ((UINT32) (offset / 1000) < minOffset)
+        {
+            minOffset = (UINT32) (offset / 1000);
+        }
+    }
+    return minOffset;
+}
+
+/**********************************************************************************************************************/
+/** Publisher phases
+ *
+ *  Two publishers phased at 500us and 2000us in a 10ms cycle are received at these offsets after the epoch, and
+ *  at the same offsets after a new epoch 5ms later. An unphased publisher is first sent one interval after
+ *  publishing and keeps its send times on the new epoch.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test34 ()
+{
+    gLoopMinWait = 100;                         /* send on time, not on the next 5ms wake-up */
+    PREPARE("Publisher phases", "test"); /* allocates appHandle1, appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+#define TEST34_COMID        34000u
+#define TEST34_INTERVAL     10000u
+#define TEST34_SHIFT        5000u
+#define TEST34_DATA         "Hello Phase!"
+#define TEST34_DATA_LEN     16u
+
+        const UINT32        phase[2]    = {500u, 2000u};
+        const TRDP_TIME_T   shift       = {0, TEST34_SHIFT};
+        TRDP_PUB_T          pubHandle;
+        TRDP_SUB_T          subHandle;
+        TRDP_SEND_PARAM_T   sendParam;
+        TRDP_TIME_T         epoch;
+        VOS_TIME_NS_T       epochNs, published, first;
+        UINT32              offset, unphased, diff;
+        int                 i;
+
+        for (i = 1; i <= 3; i++)
+        {
+            err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, test34PDcallBack,
+                                TEST34_COMID + (UINT32) i, 0u, 0u, 0u, 0u, 0u,
+                                TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB, TEST34_INTERVAL * 10,
+                                TRDP_TO_DEFAULT);
+            IF_ERROR("tlp_subscribe");
+        }
+
+        vos_getTime(&epoch);
+        err = tlc_setCycleEpoch(gSession1.appHandle, &epoch);
+        IF_ERROR("tlc_setCycleEpoch");
+        epochNs = VOS_TIME_TO_NS(&epoch);
+
+        for (i = 0; i < 2; i++)
+        {
+            memset(&sendParam, 0, sizeof(sendParam));
+            sendParam.qos       = 5u;
+            sendParam.ttl       = 64u;
+            sendParam.phased    = TRUE;
+            sendParam.phase     = phase[i];
+            err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST34_COMID + 1u + (UINT32) i,
+                              0u, 0u, 0u, gSession2.ifaceIP, TEST34_INTERVAL, 0u, TRDP_FLAGS_NONE, &sendParam,
+                              (const UINT8 *) TEST34_DATA, TEST34_DATA_LEN);
+            IF_ERROR("tlp_publish");
+        }
+
+        /*  Unphased, a quarter interval off the raster  */
+        vos_threadDelay(TEST34_INTERVAL + TEST34_INTERVAL / 4u);
+        gTest34Count = 0;
+        published = vos_getTimeNs();
+        err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST34_COMID + 3u,
+                          0u, 0u, 0u, gSession2.ifaceIP, TEST34_INTERVAL, 0u, TRDP_FLAGS_NONE, NULL,
+                          (const UINT8 *) TEST34_DATA, TEST34_DATA_LEN);
+        IF_ERROR("tlp_publish");
+        vos_threadDelay(TEST34_INTERVAL * 3u);
+
+        first = 0;
+        (void) test34Offset(TEST34_COMID + 3u, epochNs, TEST34_INTERVAL, &first);
+        fprintf(gFp, "unphased: first received %lld us after publishing\n", (long long) ((first - published) / 1000));
+        if ((first == 0) || (first - published < (VOS_TIME_NS_T) TEST34_INTERVAL * 1000 * 9 / 10))
+        {
+            FAILED("Unphased publisher not sent one interval after publishing");
+        }
+
+        test34Record(TEST34_INTERVAL * 30u);
+        for (i = 0; i < 2; i++)
+        {
+            offset = test34Offset(TEST34_COMID + 1u + (UINT32) i, epochNs, TEST34_INTERVAL, NULL);
+            fprintf(gFp, "phase %u us: received at %u us\n", phase[i], offset);
+            if ((offset < phase[i]) || (offset >= phase[i] + 1000u))
+            {
+                FAILED("Phased publisher not received at its phase");
+            }
+        }
+        unphased = test34Offset(TEST34_COMID + 3u, epochNs, TEST34_INTERVAL, NULL);
+        fprintf(gFp, "unphased: received at %u us\n", unphased);
+        if (unphased == 0xFFFFFFFFu)
+        {
+            FAILED("Unphased publisher not received");
+        }
+
+        /*  New epoch: the phased publishers follow it, the unphased one keeps its raster  */
+        vos_addTime(&epoch, &shift);
+        err = tlc_setCycleEpoch(gSession1.appHandle, &epoch);
+        IF_ERROR("tlc_setCycleEpoch");
+
+        test34Record(TEST34_INTERVAL * 30u);
+        for (i = 0; i < 2; i++)
+        {
+            offset = test34Offset(TEST34_COMID + 1u + (UINT32) i, VOS_TIME_TO_NS(&epoch), TEST34_INTERVAL, NULL);
+            fprintf(gFp, "new epoch, phase %u us: received at %u us\n", phase[i], offset);
+            if ((offset < phase[i]) || (offset >= phase[i] + 1000u))
+            {
+                FAILED("Phased publisher not re-aligned to the new epoch");
+            }
+        }
+        offset = test34Offset(TEST34_COMID + 3u, epochNs, TEST34_INTERVAL, NULL);
+        diff = (offset > unphased) ? offset - unphased : unphased - offset;
+        fprintf(gFp, "new epoch, unphased: received at %u us of the old epoch\n", offset);
+        if ((offset == 0xFFFFFFFFu) || ((diff > 1000u) && (diff < TEST34_INTERVAL - 1000u)))
+        {
+            FAILED("Unphased publisher moved by the new epoch");
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** Phase 0 with traffic shaping
+ *
+ *  The first unphased publisher gets slot 0 of the shaping table. A publisher phased at 0 is not moved away
+ *  from it, a second unphased one is. The shaped and phased publishers follow a new epoch.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+static int test35 ()
+{
+    gLoopMinWait = 100;                         /* send on time, not on the next 5ms wake-up */
+    PREPARE_OPT("Phase 0 with traffic shaping", "test", TRDP_OPTION_TRAFFIC_SHAPING); /* allocates appHandle1,
+                                                                                          appHandle2, failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+#define TEST35_COMID        35000u
+
+        /*  unphased, phase 0, unphased  */
+        const BOOL8         phased[3]   = {FALSE, TRUE, FALSE};
+        const TRDP_TIME_T   shift       = {0, TEST34_SHIFT};
+        TRDP_PUB_T          pubHandle;
+        TRDP_SUB_T          subHandle;
+        TRDP_SEND_PARAM_T   sendParam;
+        TRDP_TIME_T         epoch;
+        UINT32              offset[3];
+        int                 i, pass;
+
+        for (i = 1; i <= 3; i++)
+        {
+            err = tlp_subscribe(gSession2.appHandle, &subHandle, NULL, test34PDcallBack,
+                                TEST35_COMID + (UINT32) i, 0u, 0u, 0u, 0u, 0u,
+                                TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB, TEST34_INTERVAL * 10,
+                                TRDP_TO_DEFAULT);
+            IF_ERROR("tlp_subscribe");
+        }
+
+        vos_getTime(&epoch);
+        err = tlc_setCycleEpoch(gSession1.appHandle, &epoch);
+        IF_ERROR("tlc_setCycleEpoch");
+
+        for (i = 0; i < 3; i++)
+        {
+            memset(&sendParam, 0, sizeof(sendParam));
+            sendParam.qos       = 5u;
+            sendParam.ttl       = 64u;
+            sendParam.phased    = phased[i];
+            err = tlp_publish(gSession1.appHandle, &pubHandle, NULL, NULL, TEST35_COMID + 1u + (UINT32) i,
+                              0u, 0u, 0u, gSession2.ifaceIP, TEST34_INTERVAL, 0u, TRDP_FLAGS_NONE, &sendParam,
+                              (const UINT8 *) TEST34_DATA, TEST34_DATA_LEN);
+            IF_ERROR("tlp_publish");
+        }
+
+        for (pass = 0; pass < 2; pass++)
+        {
+            if (pass == 1)
+            {
+                vos_addTime(&epoch, &shift);
+                err = tlc_setCycleEpoch(gSession1.appHandle, &epoch);
+                IF_ERROR("tlc_setCycleEpoch");
+            }
+            test34Record(TEST34_INTERVAL * 30u);
+            for (i = 0; i < 3; i++)
+            {
+                offset[i] = test34Offset(TEST35_COMID + 1u + (UINT32) i, VOS_TIME_TO_NS(&epoch), TEST34_INTERVAL,
+                                         NULL);
+                fprintf(gFp, "epoch %d, comId %u: received at %u us\n", pass, TEST35_COMID + 1u + (UINT32) i,
+                        offset[i]);
+            }
+            if ((offset[0] >= 1000u) || (offset[1] >= 1000u))
+            {
+                FAILED("Publisher at phase 0 moved by traffic shaping");
+            }
+            if ((offset[2] < 1000u) || (offset[2] >= TEST34_INTERVAL))
+            {
+                FAILED("Unphased publisher not placed into a free slot");
+            }
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
 
 /**********************************************************************************************************************/
 /* This array holds pointers to the m-th test (m = 1 will execute test1...)                                           */
@@ -2103,6 +4722,25 @@ test_func_t *testArray[] =
     test14,  /* Publish & Subscribe, Callback */
     test15, /* MD Request - Reply / Reuse of TCP connection */
     test16, /* MD Request - Reply / UDP */
+    test17, /* Batch publish & subscribe */
+    test18, /* Configuration hot reload */
+    test19, /* Traffic shaping */
+    test20, /* Send order by QoS, send budget */
+    test21, /* PD bit rate limit, MD rate limit */
+    test22, /* Latency histograms */
+    test23, /* Statistics counters */
+    test24, /* Stage timing, overruns */
+    test25, /* Callback accounting */
+    test26, /* Callback accounting off */
+    test27, /* Trace dump from a signal handler */
+    test28, /* Metrics endpoint */
+    test29, /* Sequence counter check */
+    test30, /* List statistics on request */
+    test31, /* Statistics history */
+    test32, /* Configuration image stamp */
+    test33, /* Configuration reload while marshalling */
+    test34, /* Publisher phases, new cycle epoch */
+    test35, /* Phase 0 with traffic shaping */
     NULL
 };
 
@@ -0,0 +1,635 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp-xmlanalyze.c
+ *
+ * @brief           Offline bandwidth and schedule analysis of TRDP XML configurations
+ *
+ * @details         Reads one or more device configuration files, computes the gross frame size of every published
+ *                  PD telegram from its dataset definition and simulates the send schedule of each interface over
+ *                  the hyperperiod in traffic shaping slots (TRDP_SHAPING_SLOT_TIME). The schedule is evaluated
+ *                  twice: as configured (phase only) and with the traffic shaping placement of the stack.
+ *                  Reports average utilisation, peak slot load, a slot load histogram and the shaping headroom.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#if defined (POSIX)
+#include <unistd.h>
+#elif (defined (WIN32) || defined (WIN64))
+#include "getopt.h"
+#endif
+#include "tau_xml.h"
+#include "trdp_utils.h"
+#include "trdp_pdcom.h"
+#include "vos_sock.h"
+#include "vos_mem.h"
+
+/***********************************************************************************************************************
+ * DEFINITIONS
+ */
+#define APP_VERSION         "1.0"
+
+#define DEFAULT_LINK_SPEED  100u        /* Mbit/s                                                               */
+#define ETH_OVERHEAD        66u         /* UDP 8 + IPv4 20 + Ethernet 14 + FCS 4 + preamble 8 + inter frame gap 12 */
+#define MAX_DS_NESTING      8u          /* recursion limit for nested datasets                                  */
+#define NO_OF_BUCKETS       7u
+
+/*  One cyclic telegram (per destination) on an interface */
+typedef struct
+{
+    UINT32  comId;
+    UINT32  destId;
+    UINT32  cycle;                      /* in us                                                            */
+    UINT32  phase;                      /* configured phase in us                                           */
+    BOOL8   phased;                     /* phase attribute given (0 included)                               */
+    UINT32  dataSize;                   /* marshalled dataset size                                          */
+    UINT32  frameSize;                  /* TRDP packet size (trdp_packetSizePD)                             */
+    UINT32  wireSize;                   /* bytes occupied on the link                                       */
+    UINT32  period;                     /* cycle in slots                                                   */
+    UINT32  shapedOffset;               /* slot chosen by the shaping emulation                             */
+    BOOL8   varSize;                    /* dataset contains variable arrays, size is a lower bound          */
+} ANA_TLG_T;
+
+/*  Slot load histogram, in percent of the slot capacity  */
+static const UINT32 cBucketLimit[NO_OF_BUCKETS - 1u] = {1u, 10u, 25u, 50u, 75u, 101u};
+static const char   *cBucketName[NO_OF_BUCKETS]     = {"idle", "< 10%", "< 25%", "< 50%", "< 75%", "<=100%", "> 100%"};
+
+/*  Dataset configuration of the current file  */
+static UINT32                   numComId        = 0u;
+static TRDP_COMID_DSID_MAP_T    *pComIdDsIdMap  = NULL;
+static UINT32                   numDataset      = 0u;
+static apTRDP_DATASET_T         apDataset       = NULL;
+
+static UINT32                   linkSpeed       = DEFAULT_LINK_SPEED;
+static BOOL8                    verbose         = FALSE;
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+static void             usage (const char *appName);
+static TRDP_DATASET_T   *findDataset (UINT32 datasetId);
+static UINT32           datasetSize (const TRDP_DATASET_T *pDataset, UINT32 depth, BOOL8 *pVarSize);
+static UINT32           hyperperiod (const ANA_TLG_T *pTlg, UINT32 numTlg);
+static void             placeShaped (ANA_TLG_T *pTlg, UINT32 numTlg, UINT32 *pLoad, UINT32 noOfSlots);
+static void             fillSchedule (const ANA_TLG_T *pTlg, UINT32 numTlg, BOOL8 shaped, UINT32 *pLoad,
+                                      UINT32 noOfSlots);
+static void             evaluate (const UINT32 *pLoad, UINT32 noOfSlots, UINT32 slotCapacity, UINT32 *pBucket,
+                                  UINT32 *pPeak);
+static int              analyzeInterface (TRDP_XML_DOC_HANDLE_T *pDocHnd, const TRDP_IF_CONFIG_T *pIfConfig);
+static int              analyzeFile (const char *pFileName);
+
+/**********************************************************************************************************************/
+/** Print usage
+ *
+ *  @param[in]      appName         program name
+ */
+static void usage (const char *appName)
+{
+    printf("%s: Version %s\t(%s - %s)\n", appName, APP_VERSION, __DATE__, __TIME__);
+    printf("Usage of %s\n", appName);
+    printf("Offline bandwidth and schedule analysis of TRDP device configurations.\n"
+           "Arguments are:\n"
+           "-l link speed in Mbit/s (default %u)\n"
+           "-v list every telegram\n"
+           "-h print usage\n"
+           "<xmlfile> ... one or more device configuration files\n",
+           DEFAULT_LINK_SPEED);
+}
+
+/**********************************************************************************************************************/
+/** Find a dataset definition by its id
+ *
+ *  @param[in]      datasetId       dataset to look for
+ *
+ *  @retval         pointer to dataset or NULL
+ */
+static TRDP_DATASET_T *findDataset (
+    UINT32 datasetId)
+{
+    UINT32 i;
+
+    for (i = 0u; i < numDataset; i++)
+    {
+        if (apDataset[i]->id == datasetId)
+        {
+            return apDataset[i];
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Compute the marshalled (wire) size of a dataset
+ *
+ *  Elements are packed on the wire. Arrays of variable size (TRDP_VAR_SIZE) are counted with zero
+ *  elements and flagged, the result is a lower bound then.
+ *
+ *  @param[in]      pDataset        dataset definition
+ *  @param[in]      depth           nesting level
+ *  @param[out]     pVarSize        set to TRUE if a variable array was found
+ *
+ *  @retval         size in bytes
+ */
+static UINT32 datasetSize (
+    const TRDP_DATASET_T    *pDataset,
+    UINT32                  depth,
+    BOOL8                   *pVarSize)
+{
+    static const UINT32 cSizes[TRDP_TIMEDATE64 + 1u] = {0u, 1u, 1u, 2u, 1u, 2u, 4u, 8u, 1u, 2u, 4u, 8u, 4u, 8u,
+                                                        4u, 6u, 8u};
+    UINT32  size = 0u;
+    UINT32  i;
+
+    if ((pDataset == NULL) || (depth > MAX_DS_NESTING))
+    {
+        return 0u;
+    }
+
+    for (i = 0u; i < pDataset->numElement; i++)
+    {
+        const TRDP_DATASET_ELEMENT_T    *pElement   = &pDataset->pElement[i];
+        UINT32                          count       = pElement->size;
+        UINT32                          elemSize    = 0u;
+
+        if (count == TRDP_VAR_SIZE)
+        {
+            *pVarSize = TRUE;
+            continue;
+        }
+        if (pElement->type <= TRDP_TIMEDATE64)
+        {
+            elemSize = cSizes[pElement->type];
+        }
+        else if (pElement->type > TRDP_TYPE_MAX)
+        {
+            elemSize = datasetSize(findDataset(pElement->type), depth + 1u, pVarSize);
+        }
+        size += count * elemSize;
+    }
+    return size;
+}
+
+/**********************************************************************************************************************/
+/** Hyperperiod (least common multiple of all periods) in slots, as computed by the stack
+ *
+ *  The periods are folded with trdp_pdShapingLcm() in publishing order, like tlp_publishBatch() does for the
+ *  telegrams of an interface. Above TRDP_SHAPING_MAX_SLOTS the largest period is kept and folding continues.
+ *
+ *  @param[in]      pTlg            telegrams
+ *  @param[in]      numTlg          number of telegrams
+ *
+ *  @retval         number of slots
+ */
+static UINT32 hyperperiod (
+    const ANA_TLG_T *pTlg,
+    UINT32          numTlg)
+{
+    UINT32  noOfSlots = 0u;
+    UINT32  i;
+
+    for (i = 0u; i < numTlg; i++)
+    {
+        noOfSlots = trdp_pdShapingLcm(noOfSlots, pTlg[i].period);
+    }
+    for (i = 0u; i < numTlg; i++)
+    {
+        if ((noOfSlots % pTlg[i].period) != 0u)
+        {
+            printf("  Hyperperiod exceeds %u slots, schedule is truncated\n", TRDP_SHAPING_MAX_SLOTS);
+            break;
+        }
+    }
+    return noOfSlots;
+}
+
+/**********************************************************************************************************************/
+/** Emulate the slot placement of trdp_pdShapingAdd() in publishing order
+ *
+ *  Phased telegrams keep the slot of their phase, the others get the offset with the smallest peak load.
+ *
+ *  @param[in,out]  pTlg            telegrams, shapedOffset is set
+ *  @param[in]      numTlg          number of telegrams
+ *  @param[in]      pLoad           slot table (zeroed, noOfSlots entries)
+ *  @param[in]      noOfSlots       hyperperiod in slots
+ */
+static void placeShaped (
+    ANA_TLG_T   *pTlg,
+    UINT32      numTlg,
+    UINT32      *pLoad,
+    UINT32      noOfSlots)
+{
+    UINT32 i, offset, slot;
+
+    for (i = 0u; i < numTlg; i++)
+    {
+        UINT32  bestOffset  = 0u;
+        UINT32  bestLoad    = 0xFFFFFFFFu;
+
+        if (pTlg[i].phased == TRUE)
+        {
+            bestOffset = (pTlg[i].phase / TRDP_SHAPING_SLOT_TIME) % pTlg[i].period;
+        }
+        else
+        {
+            for (offset = 0u; offset < pTlg[i].period; offset++)
+            {
+                UINT32 load = 0u;
+
+                for (slot = offset; slot < noOfSlots; slot += pTlg[i].period)
+                {
+                    if (pLoad[slot] > load)
+                    {
+                        load = pLoad[slot];
+                    }
+                }
+                if (load < bestLoad)
+                {
+                    bestLoad    = load;
+                    bestOffset  = offset;
+                    if (load == 0u)
+                    {
+                        break;
+                    }
+                }
+            }
+        }
+        pTlg[i].shapedOffset = bestOffset;
+        for (slot = bestOffset; slot < noOfSlots; slot += pTlg[i].period)
+        {
+            pLoad[slot] += pTlg[i].wireSize;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Fill the slot table with the send instants of all telegrams
+ *
+ *  @param[in]      pTlg            telegrams
+ *  @param[in]      numTlg          number of telegrams
+ *  @param[in]      shaped          use the shaping offset instead of the configured phase
+ *  @param[out]     pLoad           slot table (noOfSlots entries)
+ *  @param[in]      noOfSlots       hyperperiod in slots
+ */
+static void fillSchedule (
+    const ANA_TLG_T *pTlg,
+    UINT32          numTlg,
+    BOOL8           shaped,
+    UINT32          *pLoad,
+    UINT32          noOfSlots)
+{
+    UINT32 i;
+
+    memset(pLoad, 0, noOfSlots * sizeof(UINT32));
+    for (i = 0u; i < numTlg; i++)
+    {
+        UINT64 t;
+        UINT64 hyper = (UINT64) noOfSlots * TRDP_SHAPING_SLOT_TIME;
+
+        if (shaped == TRUE)
+        {
+            t = (UINT64) pTlg[i].shapedOffset * TRDP_SHAPING_SLOT_TIME;
+        }
+        else
+        {
+            t = pTlg[i].phase % pTlg[i].cycle;
+        }
+        /*  the true cycle is used here, not the rounded period  */
+        for (; t < hyper; t += pTlg[i].cycle)
+        {
+            pLoad[t / TRDP_SHAPING_SLOT_TIME] += pTlg[i].wireSize;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Build the slot load histogram
+ *
+ *  @param[in]      pLoad           slot table
+ *  @param[in]      noOfSlots       hyperperiod in slots
+ *  @param[in]      slotCapacity    bytes the link can carry per slot
+ *  @param[out]     pBucket         histogram (NO_OF_BUCKETS entries)
+ *  @param[out]     pPeak           highest slot load in bytes
+ */
+static void evaluate (
+    const UINT32    *pLoad,
+    UINT32          noOfSlots,
+    UINT32          slotCapacity,
+    UINT32          *pBucket,
+    UINT32          *pPeak)
+{
+    UINT32 slot, j;
+
+    memset(pBucket, 0, NO_OF_BUCKETS * sizeof(UINT32));
+    *pPeak = 0u;
+    for (slot = 0u; slot < noOfSlots; slot++)
+    {
+        UINT32 percent = (UINT32) (((UINT64) pLoad[slot] * 100u + slotCapacity - 1u) / slotCapacity);
+
+        for (j = 0u; (j < NO_OF_BUCKETS - 1u) && (percent >= cBucketLimit[j]); j++)
+        {
+            ;
+        }
+        pBucket[j]++;
+        if (pLoad[slot] > *pPeak)
+        {
+            *pPeak = pLoad[slot];
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Analyze the published telegrams of one interface
+ *
+ *  @param[in]      pDocHnd         parsed XML document
+ *  @param[in]      pIfConfig       interface to analyze
+ *
+ *  @retval         0               the schedule fits the link
+ *  @retval         1               overload or error
+ */
+static int analyzeInterface (
+    TRDP_XML_DOC_HANDLE_T   *pDocHnd,
+    const TRDP_IF_CONFIG_T  *pIfConfig)
+{
+    TRDP_PROCESS_CONFIG_T   processConfig;
+    TRDP_PD_CONFIG_T        pdConfig;
+    TRDP_MD_CONFIG_T        mdConfig;
+    UINT32                  numExchgPar = 0u;
+    TRDP_EXCHG_PAR_T        *pExchgPar  = NULL;
+    ANA_TLG_T               *pTlg       = NULL;
+    UINT32                  *pLoad      = NULL;
+    UINT32                  numTlg      = 0u;
+    UINT32                  bucket[2][NO_OF_BUCKETS];
+    UINT32                  peak[2];
+    UINT32                  slotCapacity, noOfSlots;
+    UINT64                  bitsPerSec  = 0u;
+    BOOL8                   varSize     = FALSE;
+    UINT32                  i, j;
+    int                     ret = 0;
+
+    if (tau_readXmlInterfaceConfig(pDocHnd, pIfConfig->ifName, &processConfig, &pdConfig, &mdConfig,
+                                   &numExchgPar, &pExchgPar) != TRDP_NO_ERR)
+    {
+        printf("Failed to read telegrams of interface %s\n", pIfConfig->ifName);
+        return 1;
+    }
+
+    /*  Collect the cyclic PD telegrams, one per destination  */
+    for (i = 0u; i < numExchgPar; i++)
+    {
+        numTlg += pExchgPar[i].destCnt;
+    }
+    if (numTlg != 0u)
+    {
+        pTlg = (ANA_TLG_T *) vos_memAlloc(numTlg * sizeof(ANA_TLG_T));
+        if (pTlg == NULL)
+        {
+            tau_freeTelegrams(numExchgPar, pExchgPar);
+            return 1;
+        }
+    }
+    numTlg = 0u;
+    for (i = 0u; i < numExchgPar; i++)
+    {
+        TRDP_DATASET_T  *pDataset   = findDataset(pExchgPar[i].datasetId);
+        UINT32          cycle       = (pExchgPar[i].pPdPar != NULL) ? pExchgPar[i].pPdPar->cycle : 0u;
+        BOOL8           isVar       = FALSE;
+        UINT32          dataSize;
+
+        if ((pExchgPar[i].pMdPar != NULL) || (cycle == 0u))
+        {
+            continue;                                           /* MD or PULL only */
+        }
+        if (pDataset == NULL)
+        {
+            printf("  ComId %u: unknown dataset %u, ignored\n", pExchgPar[i].comId, pExchgPar[i].datasetId);
+            continue;
+        }
+        dataSize = datasetSize(pDataset, 0u, &isVar);
+
+        for (j = 0u; j < pExchgPar[i].destCnt; j++)
+        {
+            ANA_TLG_T *pCur = &pTlg[numTlg++];
+
+            pCur->comId     = pExchgPar[i].comId;
+            pCur->destId    = pExchgPar[i].pDest[j].id;
+            pCur->cycle     = cycle;
+            pCur->phase     = pExchgPar[i].pPdPar->phase % cycle;
+            pCur->phased    = pExchgPar[i].pPdPar->phased;
+            pCur->dataSize  = dataSize;
+            pCur->frameSize = trdp_packetSizePD(dataSize);
+            pCur->wireSize  = pCur->frameSize + ETH_OVERHEAD;
+            pCur->period    = (cycle + TRDP_SHAPING_SLOT_TIME / 2u) / TRDP_SHAPING_SLOT_TIME;
+            pCur->varSize   = isVar;
+            if (pCur->period == 0u)
+            {
+                pCur->period = 1u;
+            }
+            bitsPerSec  += (UINT64) pCur->wireSize * 8u * 1000000u / cycle;
+            varSize     |= isVar;
+        }
+    }
+    tau_freeTelegrams(numExchgPar, pExchgPar);
+
+    printf("\nInterface %s (%s), link %u Mbit/s, %u cyclic telegrams\n",
+           pIfConfig->ifName, vos_ipDotted(pIfConfig->hostIp), linkSpeed, numTlg);
+    if (numTlg == 0u)
+    {
+        return 0;
+    }
+
+    slotCapacity    = (UINT32) ((UINT64) linkSpeed * TRDP_SHAPING_SLOT_TIME / 8u);
+    noOfSlots       = hyperperiod(pTlg, numTlg);
+    pLoad           = (UINT32 *) vos_memAlloc(noOfSlots * sizeof(UINT32));
+    if (pLoad == NULL)
+    {
+        vos_memFree(pTlg);
+        return 1;
+    }
+
+    /*  Shaped placement first, it is needed for the telegram list  */
+    placeShaped(pTlg, numTlg, pLoad, noOfSlots);
+
+    if (verbose == TRUE)
+    {
+        printf("  %10s %8s %10s %10s %8s %8s %8s %12s\n",
+               "ComId", "DestId", "Cycle[us]", "Phase[us]", "Data[B]", "Frame[B]", "Wire[B]", "Load[kbit/s]");
+        for (i = 0u; i < numTlg; i++)
+        {
+            printf("  %10u %8u %10u %10u %7u%c %8u %8u %12.1f\n",
+                   pTlg[i].comId, pTlg[i].destId, pTlg[i].cycle,
+                   (pTlg[i].phased == TRUE) ? pTlg[i].phase : pTlg[i].shapedOffset * TRDP_SHAPING_SLOT_TIME,
+                   pTlg[i].dataSize, (pTlg[i].varSize == TRUE) ? '*' : ' ',
+                   pTlg[i].frameSize, pTlg[i].wireSize,
+                   (double) pTlg[i].wireSize * 8.0 * 1000.0 / (double) pTlg[i].cycle);
+        }
+    }
+
+    fillSchedule(pTlg, numTlg, FALSE, pLoad, noOfSlots);
+    evaluate(pLoad, noOfSlots, slotCapacity, bucket[0], &peak[0]);
+    fillSchedule(pTlg, numTlg, TRUE, pLoad, noOfSlots);
+    evaluate(pLoad, noOfSlots, slotCapacity, bucket[1], &peak[1]);
+
+    printf("  Hyperperiod:      %u slots of %u us, slot capacity %u bytes\n",
+           noOfSlots, TRDP_SHAPING_SLOT_TIME, slotCapacity);
+    printf("  Average load:     %.1f kbit/s (%.2f %% of link)\n",
+           (double) bitsPerSec / 1000.0, (double) bitsPerSec / ((double) linkSpeed * 10000.0));
+    printf("  %-18s %12s %12s\n", "", "configured", "shaped");
+    printf("  %-18s %12u %12u\n", "Peak slot [B]:", peak[0], peak[1]);
+    printf("  %-18s %11.1f%% %11.1f%%\n", "Peak slot [%]:",
+           (double) peak[0] * 100.0 / slotCapacity, (double) peak[1] * 100.0 / slotCapacity);
+    printf("  Slot load histogram (%% of slot capacity):\n");
+    for (j = 0u; j < NO_OF_BUCKETS; j++)
+    {
+        printf("    %-16s %12u %12u\n", cBucketName[j], bucket[0][j], bucket[1][j]);
+    }
+    if (peak[1] <= slotCapacity)
+    {
+        printf("  Shaping headroom: %u bytes per slot (%.1f %%)\n",
+               slotCapacity - peak[1], (double) (slotCapacity - peak[1]) * 100.0 / slotCapacity);
+    }
+    if (varSize == TRUE)
+    {
+        printf("  (*) variable sized dataset, computed with empty arrays (lower bound)\n");
+    }
+
+    if (bitsPerSec > (UINT64) linkSpeed * 1000000u)
+    {
+        printf("  Result: OVERLOAD - average load exceeds the link\n");
+        ret = 1;
+    }
+    else if (peak[1] > slotCapacity)
+    {
+        printf("  Result: OVERLOAD - a shaping slot carries more than the link can send within %u us\n",
+               TRDP_SHAPING_SLOT_TIME);
+        ret = 1;
+    }
+    else if (peak[0] > slotCapacity)
+    {
+        printf("  Result: fits only with traffic shaping (TRDP_OPTION_TRAFFIC_SHAPING)\n");
+    }
+    else
+    {
+        printf("  Result: fits\n");
+    }
+
+    vos_memFree(pLoad);
+    vos_memFree(pTlg);
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** Analyze all interfaces of a device configuration
+ *
+ *  @param[in]      pFileName       XML file
+ *
+ *  @retval         0               all interfaces fit
+ *  @retval         1               overload or error
+ */
+static int analyzeFile (
+    const char *pFileName)
+{
+    TRDP_XML_DOC_HANDLE_T   docHnd;
+    TRDP_MEM_CONFIG_T       memConfig;
+    TRDP_DBG_CONFIG_T       dbgConfig;
+    UINT32                  numComPar   = 0u;
+    TRDP_COM_PAR_T          *pComPar    = NULL;
+    UINT32                  numIfConfig = 0u;
+    TRDP_IF_CONFIG_T        *pIfConfig  = NULL;
+    UINT32                  i;
+    int                     ret = 0;
+
+    printf("\n%s\n", pFileName);
+    if (tau_prepareXmlDoc(pFileName, &docHnd) != TRDP_NO_ERR)
+    {
+        printf("Failed to prepare XML document\n");
+        return 1;
+    }
+    if ((tau_readXmlDeviceConfig(&docHnd, &memConfig, &dbgConfig, &numComPar, &pComPar,
+                                 &numIfConfig, &pIfConfig) != TRDP_NO_ERR) ||
+        (tau_readXmlDatasetConfig(&docHnd, &numComId, &pComIdDsIdMap, &numDataset, &apDataset) != TRDP_NO_ERR))
+    {
+        printf("Failed to parse configuration\n");
+        tau_freeXmlDoc(&docHnd);
+        return 1;
+    }
+
+    for (i = 0u; i < numIfConfig; i++)
+    {
+        ret |= analyzeInterface(&docHnd, &pIfConfig[i]);
+    }
+
+    tau_freeXmlDatasetConfig(numComId, pComIdDsIdMap, numDataset, apDataset);
+    numComId    = 0u;
+    numDataset  = 0u;
+    if (pComPar != NULL)
+    {
+        vos_memFree(pComPar);
+    }
+    if (pIfConfig != NULL)
+    {
+        vos_memFree(pIfConfig);
+    }
+    tau_freeXmlDoc(&docHnd);
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        all configurations fit
+ *  @retval         1        overload or error
+ */
+int main (int argc, char *argv[])
+{
+    int ch;
+    int ret = 0;
+
+    while ((ch = getopt(argc, argv, "l:vh?")) != -1)
+    {
+        switch (ch)
+        {
+            case 'l':
+                linkSpeed = (UINT32) strtoul(optarg, NULL, 10);
+                break;
+            case 'v':
+                verbose = TRUE;
+                break;
+            case 'h':
+            case '?':
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if ((optind >= argc) || (linkSpeed == 0u))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    /*  Use the heap, configuration files may be large  */
+    if (vos_memInit(NULL, 0u, NULL) != VOS_NO_ERR)
+    {
+        return 1;
+    }
+
+    for (; optind < argc; optind++)
+    {
+        ret |= analyzeFile(argv[optind]);
+    }
+
+    vos_memDelete(NULL);
+    return ret;
+}
@@ -0,0 +1,319 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp-xmlcache.c
+ *
+ * @brief           Precompile an XML configuration into a binary configuration image
+ *
+ * @details         Reads the complete configuration of an XML file (tau_readXmlConfig) and writes it as binary
+ *                  image (tau_writeConfigImage), which tau_loadConfig maps at startup instead of parsing the XML.
+ *                  With -c the image is loaded through tau_loadConfig, compared with the XML file and the
+ *                  load times of both are reported.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#if defined (POSIX)
+#include <unistd.h>
+#elif (defined (WIN32) || defined (WIN64))
+#include "getopt.h"
+#endif
+#include "tau_xml_cache.h"
+#include "vos_mem.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINITIONS
+ */
+#define APP_VERSION     "1.0"
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+static void     usage (const char *appName);
+static BOOL8    sameString (const CHAR8 *pA, const CHAR8 *pB);
+static BOOL8    sameBlock (const void *pA, const void *pB, UINT32 size);
+static BOOL8    sameTelegram (const TRDP_EXCHG_PAR_T *pA, const TRDP_EXCHG_PAR_T *pB);
+static BOOL8    sameConfig (const TRDP_XML_CONFIG_T *pA, const TRDP_XML_CONFIG_T *pB);
+static UINT32   elapsedUs (VOS_TIME_NS_T start);
+static int      checkImage (const char *pXmlFileName, const char *pImageFileName);
+
+/**********************************************************************************************************************/
+/** Print a sensible usage message
+ *
+ *  @param[in]      appName         program name
+ */
+static void usage (const char *appName)
+{
+    printf("Usage of %s\n", appName);
+    printf("Precompile an XML configuration into a binary configuration image for tau_loadConfig.\n"
+           "Arguments are:\n"
+           "-c     load the image like an application would, compare it with the XML file and time both\n"
+           "<xml file> <image file>\n"
+           "Version %s\n", APP_VERSION);
+}
+
+/*  Compare strings, both may be NULL   */
+static BOOL8 sameString (const CHAR8 *pA, const CHAR8 *pB)
+{
+    if ((pA == NULL) || (pB == NULL))
+    {
+        return (pA == pB) ? TRUE : FALSE;
+    }
+    return (strcmp(pA, pB) == 0) ? TRUE : FALSE;
+}
+
+/*  Compare blocks without pointers, both may be NULL   */
+static BOOL8 sameBlock (const void *pA, const void *pB, UINT32 size)
+{
+    if ((pA == NULL) || (pB == NULL))
+    {
+        return (pA == pB) ? TRUE : FALSE;
+    }
+    return (memcmp(pA, pB, size) == 0) ? TRUE : FALSE;
+}
+
+/*  Compare two telegram configurations    */
+static BOOL8 sameTelegram (const TRDP_EXCHG_PAR_T *pA, const TRDP_EXCHG_PAR_T *pB)
+{
+    UINT32 i;
+
+    if ((pA->comId != pB->comId) || (pA->datasetId != pB->datasetId) || (pA->comParId != pB->comParId) ||
+        (pA->destCnt != pB->destCnt) || (pA->srcCnt != pB->srcCnt) || (pA->type != pB->type) ||
+        (pA->create != pB->create) ||
+        !sameBlock(pA->pMdPar, pB->pMdPar, sizeof(TRDP_MD_PAR_T)) ||
+        !sameBlock(pA->pPdPar, pB->pPdPar, sizeof(TRDP_PD_PAR_T)))
+    {
+        return FALSE;
+    }
+    for (i = 0u; i < pA->destCnt; i++)
+    {
+        if ((pA->pDest[i].id != pB->pDest[i].id) ||
+            !sameBlock(pA->pDest[i].pSdtPar, pB->pDest[i].pSdtPar, sizeof(TRDP_SDT_PAR_T)) ||
+            !sameString((const CHAR8 *) pA->pDest[i].pUriUser, (const CHAR8 *) pB->pDest[i].pUriUser) ||
+            !sameString((const CHAR8 *) pA->pDest[i].pUriHost, (const CHAR8 *) pB->pDest[i].pUriHost))
+        {
+            return FALSE;
+        }
+    }
+    for (i = 0u; i < pA->srcCnt; i++)
+    {
+        if ((pA->pSrc[i].id != pB->pSrc[i].id) ||
+            !sameBlock(pA->pSrc[i].pSdtPar, pB->pSrc[i].pSdtPar, sizeof(TRDP_SDT_PAR_T)) ||
+            !sameString((const CHAR8 *) pA->pSrc[i].pUriUser, (const CHAR8 *) pB->pSrc[i].pUriUser) ||
+            !sameString((const CHAR8 *) pA->pSrc[i].pUriHost1, (const CHAR8 *) pB->pSrc[i].pUriHost1) ||
+            !sameString((const CHAR8 *) pA->pSrc[i].pUriHost2, (const CHAR8 *) pB->pSrc[i].pUriHost2))
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/*  Compare two complete configurations    */
+static BOOL8 sameConfig (const TRDP_XML_CONFIG_T *pA, const TRDP_XML_CONFIG_T *pB)
+{
+    UINT32 i, j;
+
+    if ((pA->memConfig.size != pB->memConfig.size) ||
+        (memcmp(pA->memConfig.prealloc, pB->memConfig.prealloc, sizeof(pA->memConfig.prealloc)) != 0) ||
+        (memcmp(&pA->dbgConfig, &pB->dbgConfig, sizeof(TRDP_DBG_CONFIG_T)) != 0) ||
+        (pA->numComPar != pB->numComPar) || (pA->numIfConfig != pB->numIfConfig) ||
+        (pA->numComId != pB->numComId) || (pA->numDataset != pB->numDataset) ||
+        !sameBlock(pA->pComPar, pB->pComPar, pA->numComPar * sizeof(TRDP_COM_PAR_T)) ||
+        !sameBlock(pA->pIfConfig, pB->pIfConfig, pA->numIfConfig * sizeof(TRDP_IF_CONFIG_T)) ||
+        !sameBlock(pA->pComIdDsIdMap, pB->pComIdDsIdMap, pA->numComId * sizeof(TRDP_COMID_DSID_MAP_T)))
+    {
+        return FALSE;
+    }
+    for (i = 0u; i < pA->numIfConfig; i++)
+    {
+        const TRDP_XML_IF_SETTINGS_T    *pIfA   = &pA->pIfSettings[i];
+        const TRDP_XML_IF_SETTINGS_T    *pIfB   = &pB->pIfSettings[i];
+
+        if ((memcmp(&pIfA->processConfig, &pIfB->processConfig, sizeof(TRDP_PROCESS_CONFIG_T)) != 0) ||
+            (memcmp(&pIfA->pdConfig, &pIfB->pdConfig, sizeof(TRDP_PD_CONFIG_T)) != 0) ||
+            (memcmp(&pIfA->mdConfig, &pIfB->mdConfig, sizeof(TRDP_MD_CONFIG_T)) != 0) ||
+            (pIfA->numExchgPar != pIfB->numExchgPar))
+        {
+            return FALSE;
+        }
+        for (j = 0u; j < pIfA->numExchgPar; j++)
+        {
+            if (!sameTelegram(&pIfA->pExchgPar[j], &pIfB->pExchgPar[j]))
+            {
+                return FALSE;
+            }
+        }
+    }
+    for (i = 0u; i < pA->numDataset; i++)
+    {
+        const TRDP_DATASET_T    *pDsA   = pA->apDataset[i];
+        const TRDP_DATASET_T    *pDsB   = pB->apDataset[i];
+
+        if ((pDsA->id != pDsB->id) || (pDsA->numElement != pDsB->numElement))
+        {
+            return FALSE;
+        }
+        for (j = 0u; j < pDsA->numElement; j++)
+        {
+            if ((pDsA->pElement[j].type != pDsB->pElement[j].type) ||
+                (pDsA->pElement[j].size != pDsB->pElement[j].size) ||
+                (pDsA->pElement[j].scale != pDsB->pElement[j].scale) ||
+                (pDsA->pElement[j].offset != pDsB->pElement[j].offset) ||
+                !sameString(pDsA->pElement[j].name, pDsB->pElement[j].name) ||
+                !sameString(pDsA->pElement[j].unit, pDsB->pElement[j].unit))
+            {
+                return FALSE;
+            }
+        }
+    }
+    return TRUE;
+}
+
+/*  Microseconds since start    */
+static UINT32 elapsedUs (VOS_TIME_NS_T start)
+{
+    return (UINT32) ((vos_getTimeNs() - start) / 1000);
+}
+
+/**********************************************************************************************************************/
+/** Load the image as an application would and compare it with the XML file
+ *
+ *  @retval         0        image up to date and equal
+ *  @retval         1        some error
+ */
+static int checkImage (const char *pXmlFileName, const char *pImageFileName)
+{
+    TRDP_XML_CONFIG_T   fromImage;
+    TRDP_XML_CONFIG_T   fromXml;
+    VOS_TIME_NS_T       start;
+    UINT32              imageTime, xmlTime;
+    int                 ret = 1;
+
+    start = vos_getTimeNs();
+    if (tau_loadConfig(pXmlFileName, pImageFileName, &fromImage) != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "Cannot load configuration\n");
+        return 1;
+    }
+    imageTime = elapsedUs(start);
+
+    start = vos_getTimeNs();
+    if (tau_readXmlConfig(pXmlFileName, &fromXml) != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "Cannot read %s\n", pXmlFileName);
+        tau_freeConfig(&fromImage);
+        return 1;
+    }
+    xmlTime = elapsedUs(start);
+
+    if (fromImage.pImage == NULL)
+    {
+        printf("%s is missing or stale, tau_loadConfig fell back to XML\n", pImageFileName);
+    }
+    else if (sameConfig(&fromImage, &fromXml) == FALSE)
+    {
+        printf("%s differs from %s\n", pImageFileName, pXmlFileName);
+    }
+    else
+    {
+        printf("%s is up to date (%u bytes)\n", pImageFileName, (unsigned int) fromImage.imageSize);
+        ret = 0;
+    }
+    printf("load time: image %u us, XML %u us\n", (unsigned int) imageTime, (unsigned int) xmlTime);
+
+    tau_freeConfig(&fromImage);
+    tau_freeConfig(&fromXml);
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char *argv[])
+{
+    TRDP_XML_CONFIG_T   config;
+    TRDP_ERR_T          err;
+    BOOL8               check = FALSE;
+    UINT32              i, numTelegrams = 0u;
+    int                 ch;
+    int                 ret;
+
+    while ((ch = getopt(argc, argv, "ch?")) != -1)
+    {
+        switch (ch)
+        {
+            case 'c':
+                check = TRUE;
+                break;
+            case 'h':
+            case '?':
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (optind + 2 != argc)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    /*  Use the heap, configuration files may be large  */
+    if (vos_memInit(NULL, 0u, NULL) != VOS_NO_ERR)
+    {
+        return 1;
+    }
+
+    if (check == TRUE)
+    {
+        ret = checkImage(argv[optind], argv[optind + 1]);
+        vos_memDelete(NULL);
+        return ret;
+    }
+
+    err = tau_readXmlConfig(argv[optind], &config);
+    if (err != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "Cannot read %s (%d)\n", argv[optind], err);
+        vos_memDelete(NULL);
+        return 1;
+    }
+    for (i = 0u; i < config.numIfConfig; i++)
+    {
+        numTelegrams += config.pIfSettings[i].numExchgPar;
+    }
+
+    err = tau_writeConfigImage(&config, argv[optind], argv[optind + 1]);
+    if (err != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "Cannot write %s (%d)\n", argv[optind + 1], err);
+        ret = 1;
+    }
+    else
+    {
+        printf("%s: %u interfaces, %u telegrams, %u datasets\n", argv[optind + 1],
+               (unsigned int) config.numIfConfig, (unsigned int) numTelegrams, (unsigned int) config.numDataset);
+        ret = 0;
+    }
+
+    tau_freeConfig(&config);
+    vos_memDelete(NULL);
+    return ret;
+}
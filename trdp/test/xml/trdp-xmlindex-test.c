@@ -0,0 +1,476 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp-xmlindex-test.c
+ *
+ * @brief           Differential test of the configuration index
+ *
+ * @details         Builds the index (tau_initConfigIndex) of each given XML configuration and of a generated one
+ *                  with many duplicated comIds, dataset ids and interface names, and compares every tau_find*
+ *                  lookup with a linear search through the configuration arrays. Keys that are not configured
+ *                  are probed, too. Exits with 1 on the first configuration with a difference.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "tau_cfg_index.h"
+#include "vos_mem.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINITIONS
+ */
+#define APP_VERSION     "1.0"
+
+#define GEN_NUM_IF      4u          /* generated interfaces, the last one repeats the name of the first */
+#define GEN_NUM_TLG     1500u       /* generated telegrams per interface                                 */
+#define GEN_NUM_DS      300u        /* generated datasets (every 7th NULL)                               */
+#define GEN_NUM_MAP     2000u       /* generated comId mappings                                          */
+#define GEN_COMIDS      200u        /* range of the generated comIds, gives many duplicates             */
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Probed keys */
+typedef struct
+{
+    UINT32  num;
+    UINT32  *pKey;
+} KEYS_T;
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+static void                 usage (const char *appName);
+static BOOL8                keysAdd (KEYS_T *pKeys, UINT32 key);
+static INT32                linFindInterface (const TRDP_XML_CONFIG_T *pConfig, const CHAR8 *pIfName);
+static TRDP_EXCHG_PAR_T     *linFindExchgPar (const TRDP_XML_CONFIG_T *pConfig, const CHAR8 *pIfName, UINT32 comId,
+                                              const TRDP_EXCHG_PAR_T *pPrev);
+static TRDP_DATASET_T       *linFindDataset (const TRDP_XML_CONFIG_T *pConfig, UINT32 datasetId);
+static TRDP_DATASET_T       *linFindComIdDataset (const TRDP_XML_CONFIG_T *pConfig, UINT32 comId);
+static UINT32               checkTelegrams (TAU_CFG_INDEX_T index, const TRDP_XML_CONFIG_T *pConfig,
+                                            const CHAR8 *pIfName, UINT32 comId, UINT32 *pLookups);
+static int                  checkConfig (const char *pName, const TRDP_XML_CONFIG_T *pConfig);
+static int                  checkGenerated (void);
+
+/**********************************************************************************************************************/
+/** Print a sensible usage message
+ *
+ *  @param[in]      appName         program name
+ */
+static void usage (const char *appName)
+{
+    printf("Usage of %s\n", appName);
+    printf("Compare the lookups of the configuration index with a linear search.\n"
+           "Arguments are:\n"
+           "<cfgFileName> ...   XML configurations, a generated one with duplicated keys is always checked\n"
+           "Version %s\n", APP_VERSION);
+}
+
+/**********************************************************************************************************************/
+/** Add a key to probe, and its neighbour (most likely not configured)
+ *
+ *  @param[in,out]  pKeys           keys
+ *  @param[in]      key             key
+ *
+ *  @retval         FALSE           out of memory
+ */
+static BOOL8 keysAdd (KEYS_T *pKeys, UINT32 key)
+{
+    UINT32 *pNew = (UINT32 *) realloc(pKeys->pKey, (pKeys->num + 2u) * sizeof(UINT32));
+
+    if (pNew == NULL)
+    {
+        return FALSE;
+    }
+    pKeys->pKey                 = pNew;
+    pKeys->pKey[pKeys->num++]   = key;
+    pKeys->pKey[pKeys->num++]   = key + 1u;
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Linear search: first interface of the name
+ *
+ *  @retval         position in pIfConfig, -1 if not configured
+ */
+static INT32 linFindInterface (const TRDP_XML_CONFIG_T *pConfig, const CHAR8 *pIfName)
+{
+    UINT32 i;
+
+    for (i = 0u; i < pConfig->numIfConfig; i++)
+    {
+        if (strncmp(pConfig->pIfConfig[i].ifName, pIfName, TRDP_MAX_LABEL_LEN) == 0)
+        {
+            return (INT32) i;
+        }
+    }
+    return -1;
+}
+
+/**********************************************************************************************************************/
+/** Linear search: next telegram of a comId on the (first) interface of the name, in configuration order
+ *
+ *  @retval         exchange parameters, NULL if there are no (more)
+ */
+static TRDP_EXCHG_PAR_T *linFindExchgPar (
+    const TRDP_XML_CONFIG_T *pConfig,
+    const CHAR8             *pIfName,
+    UINT32                  comId,
+    const TRDP_EXCHG_PAR_T  *pPrev)
+{
+    INT32                   ifIndex = linFindInterface(pConfig, pIfName);
+    const TRDP_XML_IF_SETTINGS_T  *pIf;
+    UINT32                  i = 0u;
+
+    if ((ifIndex < 0) || (pConfig->pIfSettings == NULL))
+    {
+        return NULL;
+    }
+    pIf = &pConfig->pIfSettings[ifIndex];
+    if (pPrev != NULL)
+    {
+        if ((pPrev < pIf->pExchgPar) || (pPrev >= pIf->pExchgPar + pIf->numExchgPar) || (pPrev->comId != comId))
+        {
+            return NULL;
+        }
+        i = (UINT32) (pPrev - pIf->pExchgPar) + 1u;
+    }
+    for (; (pIf->pExchgPar != NULL) && (i < pIf->numExchgPar); i++)
+    {
+        if (pIf->pExchgPar[i].comId == comId)
+        {
+            return &pIf->pExchgPar[i];
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Linear search: first dataset of the id
+ *
+ *  @retval         dataset, NULL if not configured
+ */
+static TRDP_DATASET_T *linFindDataset (const TRDP_XML_CONFIG_T *pConfig, UINT32 datasetId)
+{
+    UINT32 i;
+
+    for (i = 0u; (pConfig->apDataset != NULL) && (i < pConfig->numDataset); i++)
+    {
+        if ((pConfig->apDataset[i] != NULL) && (pConfig->apDataset[i]->id == datasetId))
+        {
+            return pConfig->apDataset[i];
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Linear search: dataset of the first mapping of the comId
+ *
+ *  @retval         dataset, NULL if comId or dataset not configured
+ */
+static TRDP_DATASET_T *linFindComIdDataset (const TRDP_XML_CONFIG_T *pConfig, UINT32 comId)
+{
+    UINT32 i;
+
+    for (i = 0u; (pConfig->pComIdDsIdMap != NULL) && (i < pConfig->numComId); i++)
+    {
+        if (pConfig->pComIdDsIdMap[i].comId == comId)
+        {
+            return linFindDataset(pConfig, pConfig->pComIdDsIdMap[i].datasetId);
+        }
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/** Compare all telegrams, destinations and sources of a comId on an interface
+ *
+ *  @param[in,out]  pLookups        number of lookups done
+ *
+ *  @retval         number of differences
+ */
+static UINT32 checkTelegrams (
+    TAU_CFG_INDEX_T         index,
+    const TRDP_XML_CONFIG_T *pConfig,
+    const CHAR8             *pIfName,
+    UINT32                  comId,
+    UINT32                  *pLookups)
+{
+    const TRDP_EXCHG_PAR_T  *pIdx   = NULL;
+    const TRDP_EXCHG_PAR_T  *pLin   = NULL;
+    const TRDP_EXCHG_PAR_T  *pFirst = linFindExchgPar(pConfig, pIfName, comId, NULL);
+    TRDP_DEST_T             *pDest;
+    TRDP_SRC_T              *pSrc;
+    UINT32                  cnt;
+    UINT32                  diff    = 0u;
+    TRDP_ERR_T              expected;
+    TRDP_ERR_T              err;
+
+    do
+    {
+        pIdx    = tau_findExchgPar(index, pIfName, comId, pIdx);
+        pLin    = linFindExchgPar(pConfig, pIfName, comId, pLin);
+        (*pLookups)++;
+        if (pIdx != pLin)
+        {
+            printf("  tau_findExchgPar(%s, %u): %p, linear %p\n", pIfName, comId, (const void *) pIdx,
+                   (const void *) pLin);
+            diff++;
+            break;
+        }
+    }
+    while (pIdx != NULL);
+
+    expected = (linFindInterface(pConfig, pIfName) < 0) ? TRDP_PARAM_ERR :
+               (pFirst == NULL) ? TRDP_COMID_ERR : TRDP_NO_ERR;
+
+    err = tau_findDestinations(index, pIfName, comId, &cnt, &pDest);
+    (*pLookups)++;
+    if ((err != expected) ||
+        ((err == TRDP_NO_ERR) && ((cnt != pFirst->destCnt) || (pDest != pFirst->pDest))))
+    {
+        printf("  tau_findDestinations(%s, %u): %d, expected %d\n", pIfName, comId, err, expected);
+        diff++;
+    }
+    err = tau_findSources(index, pIfName, comId, &cnt, &pSrc);
+    (*pLookups)++;
+    if ((err != expected) ||
+        ((err == TRDP_NO_ERR) && ((cnt != pFirst->srcCnt) || (pSrc != pFirst->pSrc))))
+    {
+        printf("  tau_findSources(%s, %u): %d, expected %d\n", pIfName, comId, err, expected);
+        diff++;
+    }
+    return diff;
+}
+
+/**********************************************************************************************************************/
+/** Compare all lookups of a configuration
+ *
+ *  @retval         0        no difference
+ *  @retval         1        differences or error
+ */
+static int checkConfig (const char *pName, const TRDP_XML_CONFIG_T *pConfig)
+{
+    TAU_CFG_INDEX_T index;
+    KEYS_T          comIds  = {0u, NULL};
+    KEYS_T          dsIds   = {0u, NULL};
+    BOOL8           ok      = TRUE;
+    UINT32          lookups = 0u;
+    UINT32          diff    = 0u;
+    UINT32          ifIndex;
+    UINT32          i, j;
+    INT32           expected;
+
+    if (tau_initConfigIndex(pConfig, &index) != TRDP_NO_ERR)
+    {
+        printf("%s: no index\n", pName);
+        return 1;
+    }
+
+    /*  All configured keys, their neighbours and the extremes   */
+    ok = keysAdd(&comIds, 0u) && keysAdd(&comIds, 0xFFFFFFFEu) && keysAdd(&dsIds, 0u) && keysAdd(&dsIds, 0xFFFFFFFEu);
+    for (i = 0u; ok && (pConfig->pIfSettings != NULL) && (i < pConfig->numIfConfig); i++)
+    {
+        for (j = 0u; ok && (pConfig->pIfSettings[i].pExchgPar != NULL) && (j < pConfig->pIfSettings[i].numExchgPar);
+             j++)
+        {
+            ok = keysAdd(&comIds, pConfig->pIfSettings[i].pExchgPar[j].comId);
+        }
+    }
+    for (i = 0u; ok && (pConfig->pComIdDsIdMap != NULL) && (i < pConfig->numComId); i++)
+    {
+        ok = keysAdd(&comIds, pConfig->pComIdDsIdMap[i].comId) &&
+             keysAdd(&dsIds, pConfig->pComIdDsIdMap[i].datasetId);
+    }
+    for (i = 0u; ok && (pConfig->apDataset != NULL) && (i < pConfig->numDataset); i++)
+    {
+        ok = (pConfig->apDataset[i] == NULL) || keysAdd(&dsIds, pConfig->apDataset[i]->id);
+    }
+    if (!ok)
+    {
+        printf("%s: out of memory\n", pName);
+        diff++;
+    }
+
+    /*  Interfaces (and one that is not configured) and their telegrams   */
+    for (i = 0u; ok && (i <= pConfig->numIfConfig); i++)
+    {
+        const CHAR8 *pIfName = (i < pConfig->numIfConfig) ? pConfig->pIfConfig[i].ifName : "noSuchIf";
+
+        expected = linFindInterface(pConfig, pIfName);
+        lookups++;
+        if (tau_findInterface(index, pIfName, &ifIndex) != TRDP_NO_ERR)
+        {
+            ifIndex = 0xFFFFFFFFu;
+        }
+        if (ifIndex != (UINT32) expected)
+        {
+            printf("  tau_findInterface(%s): %d, linear %d\n", pIfName, (int) ifIndex, (int) expected);
+            diff++;
+        }
+        for (j = 0u; j < comIds.num; j++)
+        {
+            diff += checkTelegrams(index, pConfig, pIfName, comIds.pKey[j], &lookups);
+        }
+    }
+
+    /*  Datasets and the ComId DatasetId mapping  */
+    for (j = 0u; ok && (j < dsIds.num); j++)
+    {
+        lookups++;
+        if (tau_findDataset(index, dsIds.pKey[j]) != linFindDataset(pConfig, dsIds.pKey[j]))
+        {
+            printf("  tau_findDataset(%u) differs\n", dsIds.pKey[j]);
+            diff++;
+        }
+    }
+    for (j = 0u; ok && (j < comIds.num); j++)
+    {
+        lookups++;
+        if (tau_findComIdDataset(index, comIds.pKey[j]) != linFindComIdDataset(pConfig, comIds.pKey[j]))
+        {
+            printf("  tau_findComIdDataset(%u) differs\n", comIds.pKey[j]);
+            diff++;
+        }
+    }
+
+    printf("%s: %u interfaces, %u datasets, %u mappings, %u lookups, %u differences\n", pName,
+           pConfig->numIfConfig, pConfig->numDataset, pConfig->numComId, lookups, diff);
+
+    free(comIds.pKey);
+    free(dsIds.pKey);
+    tau_freeConfigIndex(index);
+    return (diff == 0u) ? 0 : 1;
+}
+
+/**********************************************************************************************************************/
+/** Check a generated configuration: few distinct comIds on many telegrams, duplicated dataset ids and
+ *  interface names, unknown and missing datasets
+ *
+ *  @retval         0        no difference
+ *  @retval         1        differences or error
+ */
+static int checkGenerated (void)
+{
+    TRDP_XML_CONFIG_T       config;
+    TRDP_IF_CONFIG_T        ifConfig[GEN_NUM_IF];
+    TRDP_XML_IF_SETTINGS_T  ifSettings[GEN_NUM_IF];
+    TRDP_EXCHG_PAR_T        *pExchgPar  = (TRDP_EXCHG_PAR_T *) calloc(GEN_NUM_IF * GEN_NUM_TLG,
+                                                                       sizeof(TRDP_EXCHG_PAR_T));
+    TRDP_DEST_T             *pDest      = (TRDP_DEST_T *) calloc(GEN_NUM_IF * GEN_NUM_TLG, sizeof(TRDP_DEST_T));
+    TRDP_DATASET_T          *pDataset   = (TRDP_DATASET_T *) calloc(GEN_NUM_DS, sizeof(TRDP_DATASET_T));
+    pTRDP_DATASET_T         apDataset[GEN_NUM_DS];
+    TRDP_COMID_DSID_MAP_T   map[GEN_NUM_MAP];
+    UINT32                  seed = 12345u;
+    UINT32                  i, j;
+    int                     ret = 1;
+
+    if ((pExchgPar != NULL) && (pDest != NULL) && (pDataset != NULL))
+    {
+        memset(&config, 0, sizeof(config));
+        memset(ifConfig, 0, sizeof(ifConfig));
+        memset(ifSettings, 0, sizeof(ifSettings));
+
+        for (i = 0u; i < GEN_NUM_IF; i++)
+        {
+            (void) snprintf(ifConfig[i].ifName, sizeof(ifConfig[i].ifName), "eth%u", i % (GEN_NUM_IF - 1u));
+            ifSettings[i].numExchgPar   = GEN_NUM_TLG;
+            ifSettings[i].pExchgPar     = &pExchgPar[i * GEN_NUM_TLG];
+            for (j = 0u; j < GEN_NUM_TLG; j++)
+            {
+                seed = seed * 1103515245u + 12345u;
+                ifSettings[i].pExchgPar[j].comId    = 1000u + (seed >> 16) % GEN_COMIDS;
+                ifSettings[i].pExchgPar[j].destCnt  = 1u;
+                ifSettings[i].pExchgPar[j].pDest    = &pDest[i * GEN_NUM_TLG + j];
+            }
+        }
+        for (i = 0u; i < GEN_NUM_DS; i++)
+        {
+            seed            = seed * 1103515245u + 12345u;
+            pDataset[i].id  = 1000u + (seed >> 16) % (GEN_NUM_DS / 2u);
+            apDataset[i]    = ((i % 7u) == 6u) ? NULL : &pDataset[i];
+        }
+        for (i = 0u; i < GEN_NUM_MAP; i++)
+        {
+            seed                = seed * 1103515245u + 12345u;
+            map[i].comId        = 1000u + (seed >> 16) % (2u * GEN_COMIDS);
+            map[i].datasetId    = 1000u + (seed >> 8) % GEN_NUM_DS;
+        }
+
+        config.numIfConfig      = GEN_NUM_IF;
+        config.pIfConfig        = ifConfig;
+        config.pIfSettings      = ifSettings;
+        config.numDataset       = GEN_NUM_DS;
+        config.apDataset        = apDataset;
+        config.numComId         = GEN_NUM_MAP;
+        config.pComIdDsIdMap    = map;
+
+        ret = checkConfig("generated", &config);
+    }
+    free(pExchgPar);
+    free(pDest);
+    free(pDataset);
+    return ret;
+}
+
+/**********************************************************************************************************************/
+/** main entry
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+int main (int argc, char *argv[])
+{
+    TRDP_XML_CONFIG_T   config;
+    TRDP_ERR_T          err;
+    int                 i;
+    int                 ret = 0;
+
+    if ((argc > 1) && (argv[1][0] == '-'))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    /*  Use the heap, configuration files may be large  */
+    if (vos_memInit(NULL, 0u, NULL) != VOS_NO_ERR)
+    {
+        return 1;
+    }
+
+    for (i = 1; (ret == 0) && (i < argc); i++)
+    {
+        err = tau_readXmlConfig(argv[i], &config);
+        if (err != TRDP_NO_ERR)
+        {
+            printf("Cannot read %s (%d)\n", argv[i], err);
+            ret = 1;
+        }
+        else
+        {
+            ret = checkConfig(argv[i], &config);
+            tau_freeConfig(&config);
+        }
+    }
+    if (ret == 0)
+    {
+        ret = checkGenerated();
+    }
+
+    vos_memDelete(NULL);
+    return ret;
+}
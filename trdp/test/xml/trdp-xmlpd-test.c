@@ -16,6 +16,10 @@
  *
  * $Id$
  *
+ *      BL 2026-10-17: Pass phased flag
+ *      BL 2026-10-17: Telegrams of an interface published and subscribed as one batch
+ *      BL 2026-10-17: Datasets looked up through the configuration index
+ *      BL 2026-10-17: Pass configured publisher phase
  *      BL 2018-03-06: Ticket #101 Optional callback function on PD send
  *      BL 2017-11-28: Ticket #180 Filtering rules for DestinationURI does not follow the standard
  *      BL 2017-05-22: Ticket #122: Addendum for 64Bit compatibility (VOS_TIME_T -> VOS_TIMEVAL_T)
@@ -33,6 +37,7 @@
 #include "vos_sock.h"
 #include "vos_thread.h"
 #include "tau_xml.h"
+#include "tau_cfg_index.h"
 #include "tau_marshall.h"
 #include "trdp_if_light.h"
 
@@ -66,6 +71,7 @@ UINT32                  numComId = 0u;
 TRDP_COMID_DSID_MAP_T  *pComIdDsIdMap = NULL;
 UINT32                  numDataset = 0u;
 apTRDP_DATASET_T        apDataset = NULL;
+TAU_CFG_INDEX_T         cfgIndex = NULL;
 
 /*  Session configurations  */
 typedef struct
@@ -94,6 +100,7 @@ typedef struct
 {
     TRDP_APP_SESSION_T  sessionhandle;
     TRDP_PUB_T          pubHandle;
+    TRDP_SEND_PARAM_T   sendParam;
     DATASET_T           dataset;
     pTRDP_DATASET_T     pDatasetDesc;
     TRDP_IF_CONFIG_T   *pIfConfig;
@@ -103,6 +110,9 @@ typedef struct
 /*  Arrray of published telegram descriptors - only numPubTelegrams elements actually used  */
 PUBLISHED_TLG_T     aPubTelegrams[MAX_PUB_TELEGRAMS];
 UINT32              numPubTelegrams = 0u;
+/*  Publisher descriptors and handles for tlp_publishBatch - same index as aPubTelegrams  */
+TRDP_PUB_DESC_T     aPubDesc[MAX_PUB_TELEGRAMS];
+TRDP_PUB_T          aPubHandle[MAX_PUB_TELEGRAMS];
 
 /*  Subscribed telegrams    */
 typedef struct
@@ -121,6 +131,9 @@ typedef struct
 /*  Arrray of subscribed telegram descriptors - only numSubTelegrams elements actually used  */
 SUBSCRIBED_TLG_T    aSubTelegrams[MAX_SUB_TELEGRAMS];
 UINT32              numSubTelegrams = 0u;
+/*  Subscriber descriptors and handles for tlp_subscribeBatch - same index as aSubTelegrams  */
+TRDP_SUB_DESC_T     aSubDesc[MAX_SUB_TELEGRAMS];
+TRDP_SUB_T          aSubHandle[MAX_SUB_TELEGRAMS];
 
 /*  Global counter and system time - used to fill datasets*/
 UINT64                  globCounter = 0u;
@@ -304,6 +317,8 @@ static const char * getResultString(TRDP_ERR_T ret)
 static void freeParameters()
 {
     /*  Free allocated memory   */
+    tau_freeConfigIndex(cfgIndex);
+    cfgIndex = NULL;
     if (pComPar)
     {
         free(pComPar);
@@ -558,6 +573,7 @@ static TRDP_ERR_T printDataset(pTRDP_DATASET_T pDatasetDesc, DATASET_T * pDatase
 static TRDP_ERR_T initMarshalling(const TRDP_XML_DOC_HANDLE_T * pDocHnd)
 {
     TRDP_ERR_T result;
+    TRDP_XML_CONFIG_T config;
 
     /*  Read dataset configuration  */
     result = tau_readXmlDatasetConfig(pDocHnd, 
@@ -569,6 +585,19 @@ static TRDP_ERR_T initMarshalling(const TRDP_XML_DOC_HANDLE_T * pDocHnd)
         return result;
     }
 
+    /*  Index datasets for the telegram configuration   */
+    memset(&config, 0, sizeof(config));
+    config.numComId = numComId;
+    config.pComIdDsIdMap = pComIdDsIdMap;
+    config.numDataset = numDataset;
+    config.apDataset = apDataset;
+    result = tau_initConfigIndex(&config, &cfgIndex);
+    if (result != TRDP_NO_ERR)
+    {
+        printf("Failed to index dataset configuration: %s\n", getResultString(result));
+        return result;
+    }
+
     /*  Initialize marshalling  */
     result = tau_initMarshall(&marshallCfg.pRefCon, numComId, pComIdDsIdMap, numDataset, apDataset);
     if (result != TRDP_NO_ERR)
@@ -586,14 +615,16 @@ static TRDP_ERR_T initMarshalling(const TRDP_XML_DOC_HANDLE_T * pDocHnd)
 }
 
 /*********************************************************************************************************************/
-/** Publish telegram for each configured destination.
- *  Reference to each published telegram is stored in array of published telegrams
+/** Prepare a publisher descriptor for each configured destination.
+ *  Reference to each published telegram is stored in array of published telegrams,
+ *  the telegrams are published by configureTelegrams
  */
 static TRDP_ERR_T publishTelegram(UINT32 ifcIdx, TRDP_EXCHG_PAR_T * pExchgPar)
 {
     UINT32 i;
     TRDP_DATASET_T * pDatasetDesc = NULL;
     TRDP_SEND_PARAM_T *pSendParam = NULL;
+    TRDP_SEND_PARAM_T sendParam;
     UINT32 interval = 0;
     TRDP_FLAGS_T flags;
     UINT32 redId = 0;
@@ -602,9 +633,7 @@ static TRDP_ERR_T publishTelegram(UINT32 ifcIdx, TRDP_EXCHG_PAR_T * pExchgPar)
     TRDP_ERR_T result;
 
     /*  Find dataset for the telegram   */
-    for (i = 0; i < numDataset; i++)
-        if (apDataset[i]->id == pExchgPar->datasetId)
-            pDatasetDesc = apDataset[i];
+    pDatasetDesc = tau_findDataset(cfgIndex, pExchgPar->datasetId);
     if (!pDatasetDesc)
     {
         printf("Unknown datasetId %u for comID %u\n", pExchgPar->datasetId, pExchgPar->comId);
@@ -632,6 +661,12 @@ static TRDP_ERR_T publishTelegram(UINT32 ifcIdx, TRDP_EXCHG_PAR_T * pExchgPar)
         interval = pExchgPar->pPdPar->cycle;
         flags = pExchgPar->pPdPar->flags;
         redId = pExchgPar->pPdPar->redundant;
+
+        /*  Phase is telegram specific, the rest comes from the com-parameter  */
+        sendParam = *pSendParam;
+        sendParam.phase = pExchgPar->pPdPar->phase;
+        sendParam.phased = pExchgPar->pPdPar->phased;
+        pSendParam = &sendParam;
     }
     else
     {
@@ -690,29 +725,27 @@ static TRDP_ERR_T publishTelegram(UINT32 ifcIdx, TRDP_EXCHG_PAR_T * pExchgPar)
                 *pBuf++ = j & 0xFF;
             }
         }
-        /*  Publish the telegram    */
-        result = tlp_publish(
-            pPubTlg->sessionhandle, &pPubTlg->pubHandle, NULL, NULL,
-            pExchgPar->comId, 
-            0, 0, 0, destIP, interval, redId, flags, pSendParam, 
-            (UINT8 *)pPubTlg->dataset.buffer, pPubTlg->dataset.size);
-        if (result != TRDP_NO_ERR)
-        {
-            printf("tlp_publish for comID %u, destID %u failed: %s\n", 
-                pExchgPar->comId, pExchgPar->pDest[i].id, getResultString(result));
-            return result;
-        }
-        printf("Published telegram: If index %u, ComId %u, DestId %u\n",
-            ifcIdx, pExchgPar->comId, pExchgPar->pDest[i].id);
+        /*  Queue the telegram for tlp_publishBatch    */
+        pPubTlg->sendParam = *pSendParam;
+        memset(&aPubDesc[numPubTelegrams - 1], 0, sizeof(TRDP_PUB_DESC_T));
+        aPubDesc[numPubTelegrams - 1].comId         = pExchgPar->comId;
+        aPubDesc[numPubTelegrams - 1].destIpAddr    = destIP;
+        aPubDesc[numPubTelegrams - 1].interval      = interval;
+        aPubDesc[numPubTelegrams - 1].redId         = redId;
+        aPubDesc[numPubTelegrams - 1].pktFlags      = flags;
+        aPubDesc[numPubTelegrams - 1].pSendParam    = &pPubTlg->sendParam;
+        aPubDesc[numPubTelegrams - 1].pData         = (UINT8 *)pPubTlg->dataset.buffer;
+        aPubDesc[numPubTelegrams - 1].dataSize      = pPubTlg->dataset.size;
     }
 
     return TRDP_NO_ERR;
 }
 
 /*********************************************************************************************************************/
-/** Subscribe telegram for each configured source
+/** Prepare a subscriber descriptor for each configured source
  *  If destination with MC address is also configured this MC address is used in the subscribe (for join]
- *  Reference to each subscribed telegram is stored in array of subscribed telegrams
+ *  Reference to each subscribed telegram is stored in array of subscribed telegrams,
+ *  the telegrams are subscribed by configureTelegrams
  */
 static TRDP_ERR_T subscribeTelegram(UINT32 ifcIdx, TRDP_EXCHG_PAR_T * pExchgPar)
 {
@@ -728,9 +761,7 @@ static TRDP_ERR_T subscribeTelegram(UINT32 ifcIdx, TRDP_EXCHG_PAR_T * pExchgPar)
     TRDP_ERR_T result;
 
     /*  Find dataset for the telegram   */
-    for (i = 0; i < numDataset; i++)
-        if (apDataset[i]->id == pExchgPar->datasetId)
-            pDatasetDesc = apDataset[i];
+    pDatasetDesc = tau_findDataset(cfgIndex, pExchgPar->datasetId);
     if (!pDatasetDesc)
     {
         printf("Unknown datasetId %u for comID %u\n", pExchgPar->datasetId, pExchgPar->comId);
@@ -815,18 +846,15 @@ static TRDP_ERR_T subscribeTelegram(UINT32 ifcIdx, TRDP_EXCHG_PAR_T * pExchgPar)
             }
         }
 
-        /*  Subscribe the telegram    */
-        result = tlp_subscribe(
-            pSubTlg->sessionhandle, &pSubTlg->subHandle, pSubTlg, NULL, pExchgPar->comId, 
-            0, 0, srcIP1, 0, destMCIP, flags, timeout, toBehav);
-        if (result != TRDP_NO_ERR)
-        {
-            printf("tlp_subscribe for comID %u, srcID %u failed: %s\n", 
-                pExchgPar->comId, pExchgPar->pSrc[i].id, getResultString(result));
-            return result;
-        }
-        printf("Subscribed telegram: If index %u, ComId %u, SrcId %u\n",
-            ifcIdx, pExchgPar->comId, pExchgPar->pSrc[i].id);
+        /*  Queue the telegram for tlp_subscribeBatch    */
+        memset(&aSubDesc[numSubTelegrams - 1], 0, sizeof(TRDP_SUB_DESC_T));
+        aSubDesc[numSubTelegrams - 1].pUserRef      = pSubTlg;
+        aSubDesc[numSubTelegrams - 1].comId         = pExchgPar->comId;
+        aSubDesc[numSubTelegrams - 1].srcIpAddr1    = srcIP1;
+        aSubDesc[numSubTelegrams - 1].destIpAddr    = destMCIP;
+        aSubDesc[numSubTelegrams - 1].pktFlags      = flags;
+        aSubDesc[numSubTelegrams - 1].timeout       = timeout;
+        aSubDesc[numSubTelegrams - 1].toBehavior    = toBehav;
     }
 
     return TRDP_NO_ERR;
@@ -838,6 +866,8 @@ static TRDP_ERR_T subscribeTelegram(UINT32 ifcIdx, TRDP_EXCHG_PAR_T * pExchgPar)
 static TRDP_ERR_T configureTelegrams(UINT32 ifcIdx, UINT32 numExchgPar, TRDP_EXCHG_PAR_T *pExchgPar)
 {
     UINT32 tlgIdx;
+    UINT32 firstPub = numPubTelegrams;
+    UINT32 firstSub = numSubTelegrams;
     TRDP_ERR_T  result;
 
     printf("Configuring telegrams for interface %s...\n", pIfConfig[ifcIdx].ifName);
@@ -867,6 +897,53 @@ static TRDP_ERR_T configureTelegrams(UINT32 ifcIdx, UINT32 numExchgPar, TRDP_EXC
         }
     }
 
+    /*  Publish and subscribe all telegrams of the interface at once   */
+    result = tlp_publishBatch(aSessionCfg[ifcIdx].sessionhandle, numPubTelegrams - firstPub,
+        &aPubDesc[firstPub], &aPubHandle[firstPub]);
+    for (tlgIdx = firstPub; tlgIdx < numPubTelegrams; tlgIdx++)
+    {
+        aPubTelegrams[tlgIdx].pubHandle = aPubHandle[tlgIdx];
+        if (aPubHandle[tlgIdx] == NULL)
+        {
+            printf("tlp_publish for comID %u, destID %u failed\n",
+                aPubTelegrams[tlgIdx].comID, aPubTelegrams[tlgIdx].dstID);
+        }
+        else
+        {
+            printf("Published telegram: If index %u, ComId %u, DestId %u\n",
+                ifcIdx, aPubTelegrams[tlgIdx].comID, aPubTelegrams[tlgIdx].dstID);
+        }
+    }
+    if (result != TRDP_NO_ERR)
+    {
+        printf("Failed to publish telegrams for interface %s: %s\n", pIfConfig[ifcIdx].ifName,
+            getResultString(result));
+        return result;
+    }
+
+    result = tlp_subscribeBatch(aSessionCfg[ifcIdx].sessionhandle, numSubTelegrams - firstSub,
+        &aSubDesc[firstSub], &aSubHandle[firstSub]);
+    for (tlgIdx = firstSub; tlgIdx < numSubTelegrams; tlgIdx++)
+    {
+        aSubTelegrams[tlgIdx].subHandle = aSubHandle[tlgIdx];
+        if (aSubHandle[tlgIdx] == NULL)
+        {
+            printf("tlp_subscribe for comID %u, srcID %u failed\n",
+                aSubTelegrams[tlgIdx].comID, aSubTelegrams[tlgIdx].srcID);
+        }
+        else
+        {
+            printf("Subscribed telegram: If index %u, ComId %u, SrcId %u\n",
+                ifcIdx, aSubTelegrams[tlgIdx].comID, aSubTelegrams[tlgIdx].srcID);
+        }
+    }
+    if (result != TRDP_NO_ERR)
+    {
+        printf("Failed to subscribe telegrams for interface %s: %s\n", pIfConfig[ifcIdx].ifName,
+            getResultString(result));
+        return result;
+    }
+
     printf("Telegrams for interface %s configured\n", pIfConfig[ifcIdx].ifName);
 
     return TRDP_NO_ERR;